@@ -0,0 +1,598 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <algorithm>
+#include <filesystem>
+#include "../src/constants.h"
+#include "../src/propagator.h"
+#include "../src/dynamics.h"
+#include "../src/orbital_elements.h"
+#include "../src/batch_elements.h"
+#include "../src/batch_propagator.h"
+#include "../src/gpu_batch_propagator.h"
+#include "../src/mission_propagation.h"
+#include "../src/trajectory_sink.h"
+
+// Defined in mission_batch.cpp
+MissionConfig loadConfigFromYAML(const std::string& filename);
+
+// ===========================================================================
+// ALLOCATION COUNTING
+// ===========================================================================
+// Every global operator new goes through here, so a benchmark can report how
+// many heap allocations one mission (or one micro-op) costs.
+
+static std::atomic<long> g_allocations{0};
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+// ===========================================================================
+// BENCHMARK HARNESS
+// ===========================================================================
+
+/// Opaque accumulator so benchmarked results are never optimized away
+static volatile double g_sink = 0;
+
+struct MicroResult {
+    std::string name;
+    long iterations;
+    double ns_per_op;
+    double allocations_per_op;
+};
+
+struct MacroResult {
+    std::string name;
+    std::string integrator;
+    double timestep_s;
+    long runs;
+    long steps;                  // integrator steps of one mission (accepted + rejected)
+    double ms_per_mission;
+    double ns_per_step;
+    double steps_per_s;
+    double allocations_per_mission;
+};
+
+struct BackendResult {
+    std::string name;
+    std::string backend;         // MissionConfig::batch_backend
+    long missions;
+    long steps;                  // accepted steps of the whole batch
+    double ms_per_batch;
+    double missions_per_s;
+    double ns_per_step;
+};
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/// Timing repetitions per benchmark; the fastest one is reported, which
+/// filters out interference from the rest of the machine
+constexpr int REPETITIONS = 5;
+
+/// Run body(batch) in batches until min_time has elapsed
+/// body performs `batch` operations per call. The time is split into
+/// REPETITIONS blocks and the fastest block gives the time per op.
+template <typename Body>
+MicroResult runMicro(const std::string& name, double min_time, long batch, Body body) {
+    body(batch);  // Warm-up (caches, branch predictors, lazy init)
+    
+    long iterations = 0;
+    double best_ns = 0;
+    long allocations_before = g_allocations.load();
+    for (int rep = 0; rep < REPETITIONS; ++rep) {
+        long block_iterations = 0;
+        Clock::time_point start = Clock::now();
+        double elapsed = 0;
+        do {
+            body(batch);
+            block_iterations += batch;
+            elapsed = secondsSince(start);
+        } while (elapsed < min_time / REPETITIONS);
+        
+        double ns = elapsed * 1e9 / block_iterations;
+        best_ns = (rep == 0) ? ns : std::min(best_ns, ns);
+        iterations += block_iterations;
+    }
+    long allocations = g_allocations.load() - allocations_before;
+    
+    MicroResult result;
+    result.name = name;
+    result.iterations = iterations;
+    result.ns_per_op = best_ns;
+    result.allocations_per_op = static_cast<double>(allocations) / iterations;
+    return result;
+}
+
+// ===========================================================================
+// MICRO-BENCHMARKS
+// ===========================================================================
+
+std::vector<MicroResult> runMicroBenchmarks(double min_time, const std::string& filter) {
+    std::vector<MicroResult> results;
+    auto wanted = [&filter](const std::string& name) {
+        return filter.empty() || name.find(filter) != std::string::npos;
+    };
+    
+    // A spread of heliocentric states between Venus and Jupiter
+    std::vector<MissionState> states;
+    for (int i = 0; i < 64; ++i) {
+        double r = 1.0e8 + 1.0e7 * i;
+        double angle = 0.1 * i;
+        double v = std::sqrt(MU_SUN / r) * (1.0 + 0.002 * i);
+        states.push_back(MissionState(r * std::cos(angle), r * std::sin(angle), 0,
+                                      -v * std::sin(angle), v * std::cos(angle), 0.01,
+                                      10000.0 - 50.0 * i));
+    }
+    
+    if (wanted("computeAcceleration")) {
+        results.push_back(runMicro("computeAcceleration", min_time, 1024, [&](long n) {
+            double a[3];
+            double sum = 0;
+            for (long k = 0; k < n; ++k) {
+                computeAcceleration(states[k & 63], 1000, MU_SUN, a, 1);
+                sum += a[0];
+            }
+            g_sink = g_sink + sum;
+        }));
+    }
+    
+    if (wanted("RK4Propagator::step")) {
+        RK4Propagator rk4;
+        results.push_back(runMicro("RK4Propagator::step", min_time, 1024, [&](long n) {
+            // Restart from a fresh state each batch so mass never runs out
+            MissionState state = states[0];
+            for (long k = 0; k < n; ++k) {
+                rk4.step(state, 1000.0, 1000, 2750, MU_SUN, G0, 1);
+            }
+            g_sink = g_sink + state.r[0];
+        }));
+    }
+    
+    // 64-lane SoA step, with per-lane thrust arrays and with the lanes
+    // flagged as High-Power Hall (constant-folded preset kernels)
+    for (int preset : {-1, static_cast<int>(ThrusterPreset::HIGH_POWER_HALL)}) {
+        std::string name = preset < 0 ? "BatchRK4 step (lanes)"
+                                      : "BatchRK4 step (preset)";
+        if (!wanted(name)) {
+            continue;
+        }
+        BatchState lanes;
+        lanes.resize(states.size());
+        for (std::size_t i = 0; i < states.size(); ++i) {
+            lanes.setLane(i, states[i], 1000, 2750);
+        }
+        lanes.preset = preset;
+        BatchState batch = lanes;
+        BatchRK4Propagator batch_rk4;
+        results.push_back(runMicro(name, min_time, 64, [&](long n) {
+            batch = lanes;  // Same sizes, so no allocation
+            for (long k = 0; k < n; ++k) {
+                batch_rk4.step(batch, 1000.0, MU_SUN, G0, 1);
+            }
+            g_sink = g_sink + batch.x[0];
+        }));
+    }
+    
+    if (wanted("computeOrbitalElements")) {
+        results.push_back(runMicro("computeOrbitalElements", min_time, 1024, [&](long n) {
+            double sum = 0;
+            for (long k = 0; k < n; ++k) {
+                const MissionState& s = states[k & 63];
+                OrbitalElements elements = computeOrbitalElements(s.r, s.v, MU_SUN);
+                sum += elements.r_a;
+            }
+            g_sink = g_sink + sum;
+        }));
+    }
+    
+    if (wanted("computeOrbitalElementsBatch")) {
+        // The same 64 states tiled into 1024-row columns
+        std::vector<double> columns[6];
+        for (long k = 0; k < 1024; ++k) {
+            const MissionState& s = states[k & 63];
+            for (int c = 0; c < 3; ++c) {
+                columns[c].push_back(s.r[c]);
+                columns[3 + c].push_back(s.v[c]);
+            }
+        }
+        StateColumns soa;
+        soa.count = 1024;
+        soa.x = columns[0].data();
+        soa.y = columns[1].data();
+        soa.z = columns[2].data();
+        soa.vx = columns[3].data();
+        soa.vy = columns[4].data();
+        soa.vz = columns[5].data();
+        ElementArrays elements;
+        results.push_back(runMicro("computeOrbitalElementsBatch", min_time, 1024, [&](long) {
+            computeOrbitalElementsBatch(soa, MU_SUN, elements);
+            g_sink = g_sink + elements.r_a[1023];
+        }));
+    }
+    
+    if (wanted("computeApsides")) {
+        results.push_back(runMicro("computeApsides", min_time, 1024, [&](long n) {
+            double sum = 0;
+            for (long k = 0; k < n; ++k) {
+                const MissionState& s = states[k & 63];
+                sum += computeApsides(s.r, s.v, MU_SUN).r_a;
+            }
+            g_sink = g_sink + sum;
+        }));
+    }
+    
+    if (wanted("solveKeplersEquation")) {
+        results.push_back(runMicro("solveKeplersEquation", min_time, 1024, [&](long n) {
+            double sum = 0;
+            for (long k = 0; k < n; ++k) {
+                double M = 0.1 + 6.0 * (k & 255) / 256.0;
+                double e = 0.05 + 0.9 * (k & 15) / 16.0;
+                sum += solveKeplersEquation(M, e);
+            }
+            g_sink = g_sink + sum;
+        }));
+    }
+    
+    return results;
+}
+
+// ===========================================================================
+// MACRO-BENCHMARKS
+// ===========================================================================
+
+/// Every mission config (*.yaml) in config_dir, sorted by name
+std::vector<std::string> listConfigs(const std::string& config_dir) {
+    std::vector<std::string> configs;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(config_dir, ec)) {
+        if (entry.path().extension() == ".yaml") {
+            configs.push_back(entry.path().string());
+        }
+    }
+    if (ec) {
+        std::cerr << "Error: Cannot read config directory " << config_dir << "\n";
+    }
+    std::sort(configs.begin(), configs.end());
+    return configs;
+}
+
+std::vector<MacroResult> runMacroBenchmarks(const std::string& config_dir, double min_time,
+                                            const std::string& filter) {
+    std::vector<MacroResult> results;
+    
+    for (const std::string& path : listConfigs(config_dir)) {
+        std::string name = std::filesystem::path(path).stem().string();
+        if (!filter.empty() && name.find(filter) == std::string::npos) {
+            continue;
+        }
+        
+        MissionConfig config = loadConfigFromYAML(path);
+        double r_dep = getOrbitalRadius(config.departure_body);
+        double r_arr = getOrbitalRadius(config.arrival_body);
+        
+        // Trajectory output is excluded: this measures the propagation loop
+        NullTrajectorySink sink;
+        PropagationResult prop_result;
+        // At least REPETITIONS runs and min_time in total; fastest run counts
+        long runs = 0;
+        double best = 0;
+        double total = 0;
+        long allocations_before = g_allocations.load();
+        while (runs < REPETITIONS || total < min_time) {
+            Clock::time_point start = Clock::now();
+            prop_result = propagateMission(config, r_dep, r_arr, sink);
+            double elapsed = secondsSince(start);
+            best = (runs == 0) ? elapsed : std::min(best, elapsed);
+            total += elapsed;
+            runs++;
+        }
+        long allocations = g_allocations.load() - allocations_before;
+        
+        MacroResult result;
+        result.name = name;
+        result.integrator = config.integrator;
+        result.timestep_s = config.timestep_s;
+        result.runs = runs;
+        result.steps = prop_result.accepted_steps + prop_result.rejected_steps;
+        result.ms_per_mission = best * 1e3;
+        result.ns_per_step = result.steps > 0 ? best * 1e9 / result.steps : 0;
+        result.steps_per_s = best > 0 ? result.steps / best : 0;
+        result.allocations_per_mission = static_cast<double>(allocations) / runs;
+        results.push_back(result);
+        
+        std::cout << ("  " + name + " done\n") << std::flush;
+    }
+    
+    return results;
+}
+
+// ===========================================================================
+// BATCH BACKEND BENCHMARKS
+// ===========================================================================
+
+/// One Earth-Mars batch through each propagateMissionBatch backend
+/// Thrust, ISP and mass differ per lane, so the SoA kernels take the
+/// per-lane path. "gpu" is included only when a device is available.
+std::vector<BackendResult> runBackendBenchmarks(long missions, double min_time,
+                                                const std::string& filter) {
+    std::vector<BackendResult> results;
+    double r_dep = getOrbitalRadius(CelestialBody::EARTH);
+    double r_arr = getOrbitalRadius(CelestialBody::MARS);
+    
+    std::vector<MissionConfig> configs(missions);
+    for (long i = 0; i < missions; ++i) {
+        double f = static_cast<double>(i) / std::max<long>(missions - 1, 1);
+        configs[i].spacecraft.thrust_mN = 300 + 700 * f;
+        configs[i].spacecraft.isp_s = 1800 + 2400 * f;
+        configs[i].spacecraft.initial_mass_kg = 12000 - 6000 * f;
+        configs[i].timestep_s = 20000;
+        configs[i].max_flight_time_s = 1.577e9;
+    }
+    
+    std::vector<std::string> backends = {"cpu", "lanes"};
+    if (gpuBatchAvailable()) {
+        backends.push_back("gpu");
+    }
+    for (const std::string& backend : backends) {
+        std::string name = "batch backend " + backend;
+        if (!filter.empty() && name.find(filter) == std::string::npos) {
+            continue;
+        }
+        for (MissionConfig& config : configs) {
+            config.batch_backend = backend;
+        }
+        
+        std::vector<PropagationResult> batch;
+        long runs = 0;
+        double best = 0;
+        double total = 0;
+        while (runs < REPETITIONS || total < min_time) {
+            Clock::time_point start = Clock::now();
+            batch = propagateMissionBatch(configs, r_dep, r_arr);
+            double elapsed = secondsSince(start);
+            best = (runs == 0) ? elapsed : std::min(best, elapsed);
+            total += elapsed;
+            runs++;
+        }
+        
+        BackendResult result;
+        result.name = name;
+        result.backend = backend;
+        result.missions = missions;
+        result.steps = 0;
+        for (const PropagationResult& lane : batch) {
+            result.steps += lane.accepted_steps;
+        }
+        result.ms_per_batch = best * 1e3;
+        result.missions_per_s = best > 0 ? missions / best : 0;
+        result.ns_per_step = result.steps > 0 ? best * 1e9 / result.steps : 0;
+        results.push_back(result);
+    }
+    
+    return results;
+}
+
+// ===========================================================================
+// REPORTING
+// ===========================================================================
+
+void printReport(const std::vector<MicroResult>& micro, const std::vector<MacroResult>& macro,
+                 const std::vector<BackendResult>& backends) {
+    if (!micro.empty()) {
+        std::cout << "\nMicro-benchmarks:\n";
+        std::cout << std::left << std::setw(26) << "  Benchmark" << std::right
+                  << std::setw(12) << "ns/op" << std::setw(16) << "ops/s"
+                  << std::setw(12) << "allocs/op" << "\n";
+        for (const MicroResult& r : micro) {
+            std::cout << "  " << std::left << std::setw(24) << r.name << std::right
+                      << std::fixed << std::setprecision(2) << std::setw(12) << r.ns_per_op
+                      << std::scientific << std::setprecision(3) << std::setw(16)
+                      << 1e9 / r.ns_per_op
+                      << std::fixed << std::setprecision(2) << std::setw(12)
+                      << r.allocations_per_op << "\n";
+        }
+    }
+    
+    if (!macro.empty()) {
+        std::cout << "\nMission benchmarks (propagateMission, no trajectory output):\n";
+        std::cout << std::left << std::setw(32) << "  Config" << std::right
+                  << std::setw(8) << "method" << std::setw(10) << "steps"
+                  << std::setw(12) << "ms/mission" << std::setw(10) << "ns/step"
+                  << std::setw(14) << "steps/s" << std::setw(10) << "allocs" << "\n";
+        for (const MacroResult& r : macro) {
+            std::cout << "  " << std::left << std::setw(30) << r.name << std::right
+                      << std::setw(8) << r.integrator << std::setw(10) << r.steps
+                      << std::fixed << std::setprecision(2) << std::setw(12) << r.ms_per_mission
+                      << std::setprecision(1) << std::setw(10) << r.ns_per_step
+                      << std::scientific << std::setprecision(3) << std::setw(14) << r.steps_per_s
+                      << std::fixed << std::setprecision(0) << std::setw(10)
+                      << r.allocations_per_mission << "\n";
+        }
+    }
+    
+    if (!backends.empty()) {
+        std::cout << "\nBatch backends (propagateMissionBatch, " << backends[0].missions
+                  << " Earth-Mars missions; gpu: " << gpuBatchDescription() << "):\n";
+        std::cout << std::left << std::setw(26) << "  Backend" << std::right
+                  << std::setw(12) << "ms/batch" << std::setw(14) << "missions/s"
+                  << std::setw(10) << "ns/step" << std::setw(10) << "speedup" << "\n";
+        for (const BackendResult& r : backends) {
+            std::cout << "  " << std::left << std::setw(24) << r.name << std::right
+                      << std::fixed << std::setprecision(2) << std::setw(12) << r.ms_per_batch
+                      << std::setprecision(0) << std::setw(14) << r.missions_per_s
+                      << std::setprecision(1) << std::setw(10) << r.ns_per_step
+                      << std::setprecision(2) << std::setw(9)
+                      << backends[0].ms_per_batch / r.ms_per_batch << "x\n";
+        }
+    }
+}
+
+std::string jsonString(const std::string& s) {
+    std::string out = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+        }
+        out += c;
+    }
+    return out + "\"";
+}
+
+/// Write results as JSON (one benchmark per line, for easy diffing)
+bool writeJson(const std::string& filename, const std::vector<MicroResult>& micro,
+               const std::vector<MacroResult>& macro, const std::vector<BackendResult>& backends,
+               double min_time) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open " << filename << " for writing\n";
+        return false;
+    }
+    
+    file << std::setprecision(10);
+    file << "{\n";
+    file << "  \"suite\": \"bench_propagation\",\n";
+    file << "  \"format_version\": 1,\n";
+    file << "  \"compiler\": " << jsonString(__VERSION__) << ",\n";
+    file << "  \"min_time_s\": " << min_time << ",\n";
+    
+    file << "  \"micro\": [\n";
+    for (size_t i = 0; i < micro.size(); ++i) {
+        const MicroResult& r = micro[i];
+        file << "    {\"name\": " << jsonString(r.name)
+             << ", \"iterations\": " << r.iterations
+             << ", \"ns_per_op\": " << r.ns_per_op
+             << ", \"ops_per_s\": " << 1e9 / r.ns_per_op
+             << ", \"allocations_per_op\": " << r.allocations_per_op << "}"
+             << (i + 1 < micro.size() ? "," : "") << "\n";
+    }
+    file << "  ],\n";
+    
+    file << "  \"macro\": [\n";
+    for (size_t i = 0; i < macro.size(); ++i) {
+        const MacroResult& r = macro[i];
+        file << "    {\"name\": " << jsonString(r.name)
+             << ", \"integrator\": " << jsonString(r.integrator)
+             << ", \"timestep_s\": " << r.timestep_s
+             << ", \"runs\": " << r.runs
+             << ", \"steps\": " << r.steps
+             << ", \"ms_per_mission\": " << r.ms_per_mission
+             << ", \"ns_per_step\": " << r.ns_per_step
+             << ", \"steps_per_s\": " << r.steps_per_s
+             << ", \"allocations_per_mission\": " << r.allocations_per_mission << "}"
+             << (i + 1 < macro.size() ? "," : "") << "\n";
+    }
+    file << "  ],\n";
+    
+    file << "  \"backends\": [\n";
+    for (size_t i = 0; i < backends.size(); ++i) {
+        const BackendResult& r = backends[i];
+        file << "    {\"name\": " << jsonString(r.name)
+             << ", \"backend\": " << jsonString(r.backend)
+             << ", \"missions\": " << r.missions
+             << ", \"steps\": " << r.steps
+             << ", \"ms_per_batch\": " << r.ms_per_batch
+             << ", \"missions_per_s\": " << r.missions_per_s
+             << ", \"ns_per_step\": " << r.ns_per_step << "}"
+             << (i + 1 < backends.size() ? "," : "") << "\n";
+    }
+    file << "  ]\n";
+    file << "}\n";
+    
+    return file.good();
+}
+
+// ===========================================================================
+// MAIN
+// ===========================================================================
+
+void printUsage() {
+    std::cout << "Usage: bench_propagation [--json <file>] [--config-dir <dir>]\n"
+              << "                         [--min-time <s>] [--filter <name>]\n"
+              << "                         [--backend-missions <N>]\n"
+              << "                         [--micro-only | --macro-only]\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::string json_file;
+    std::string config_dir = "../config";
+    std::string filter;
+    double min_time = 0.5;
+    long backend_missions = 256;
+    bool run_micro = true;
+    bool run_macro = true;
+    
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--json" && has_value) {
+            json_file = argv[++i];
+        } else if (arg == "--config-dir" && has_value) {
+            config_dir = argv[++i];
+        } else if (arg == "--filter" && has_value) {
+            filter = argv[++i];
+        } else if (arg == "--min-time" && has_value) {
+            min_time = std::atof(argv[++i]);
+        } else if (arg == "--backend-missions" && has_value) {
+            backend_missions = std::max(1L, std::atol(argv[++i]));
+        } else if (arg == "--micro-only") {
+            run_macro = false;
+        } else if (arg == "--macro-only") {
+            run_micro = false;
+        } else {
+            printUsage();
+            return (arg == "--help" || arg == "-h") ? 0 : 1;
+        }
+    }
+    
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "PROPAGATION BENCHMARK SUITE\n";
+    std::cout << "=====================================================\n";
+    
+    std::vector<MicroResult> micro;
+    std::vector<MacroResult> macro;
+    std::vector<BackendResult> backends;
+    if (run_micro) {
+        micro = runMicroBenchmarks(min_time, filter);
+    }
+    if (run_macro) {
+        std::cout << "\nRunning missions from " << config_dir << "...\n";
+        macro = runMacroBenchmarks(config_dir, min_time, filter);
+        backends = runBackendBenchmarks(backend_missions, min_time, filter);
+    }
+    
+    printReport(micro, macro, backends);
+    
+    if (!json_file.empty()) {
+        if (!writeJson(json_file, micro, macro, backends, min_time)) {
+            return 1;
+        }
+        std::cout << "\nResults saved to: " << json_file << "\n";
+    }
+    std::cout << "=====================================================\n\n";
+    
+    return 0;
+}
@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <chrono>
+#include "async_sink.h"
+
+namespace {
+
+/// Steps a sink hands over per turn, so one busy mission cannot starve the others
+constexpr std::size_t STEPS_PER_TURN = 1024;
+
+/// Poll interval while either side waits; also bounds a missed wake-up
+constexpr std::chrono::microseconds WAIT_INTERVAL(50);
+constexpr std::chrono::milliseconds IDLE_INTERVAL(1);
+
+}  // namespace
+
+// ===========================================================================
+// WRITER THREAD IMPLEMENTATION
+// ===========================================================================
+
+TrajectoryWriterThread::TrajectoryWriterThread()
+    : thread(&TrajectoryWriterThread::run, this) {}
+
+TrajectoryWriterThread::~TrajectoryWriterThread() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex);
+        stopping = true;
+    }
+    wake_cv.notify_all();
+    thread.join();
+}
+
+void TrajectoryWriterThread::wake() {
+    if (sleeping.load()) {
+        std::lock_guard<std::mutex> lock(wake_mutex);
+        wake_cv.notify_one();
+    }
+}
+
+void TrajectoryWriterThread::attach(AsyncTrajectorySink* sink) {
+    std::lock_guard<std::mutex> lock(sinks_mutex);
+    sinks.push_back(sink);
+}
+
+void TrajectoryWriterThread::detach(AsyncTrajectorySink* sink) {
+    // Waits for a turn in progress, so the sink is never serviced afterwards
+    std::lock_guard<std::mutex> lock(sinks_mutex);
+    sinks.erase(std::remove(sinks.begin(), sinks.end(), sink), sinks.end());
+}
+
+void TrajectoryWriterThread::run() {
+    while (true) {
+        bool worked = false;
+        {
+            std::lock_guard<std::mutex> lock(sinks_mutex);
+            for (AsyncTrajectorySink* sink : sinks) {
+                worked = sink->drain(STEPS_PER_TURN) || worked;
+            }
+        }
+        if (worked) {
+            continue;
+        }
+        
+        std::unique_lock<std::mutex> lock(wake_mutex);
+        if (stopping) {
+            return;  // Sinks are gone (they detach before the thread stops)
+        }
+        sleeping.store(true);
+        wake_cv.wait_for(lock, IDLE_INTERVAL);
+        sleeping.store(false);
+    }
+}
+
+// ===========================================================================
+// ASYNC SINK IMPLEMENTATION
+// ===========================================================================
+
+AsyncTrajectorySink::AsyncTrajectorySink(TrajectorySink& downstream,
+                                         TrajectoryWriterThread& writer,
+                                         std::size_t buffer_bytes)
+    : downstream(downstream), writer(writer), ring(buffer_bytes / sizeof(QueuedStep)) {
+    writer.attach(this);
+}
+
+AsyncTrajectorySink::~AsyncTrajectorySink() {
+    waitUntilEmpty();
+    writer.detach(this);
+}
+
+void AsyncTrajectorySink::push(const QueuedStep& queued) {
+    while (!ring.tryPush(queued)) {
+        // Backpressure: the writer is behind, so wait instead of buffering more
+        backpressure_waits++;
+        writer.wake();
+        std::this_thread::sleep_for(WAIT_INTERVAL);
+    }
+    writer.wake();
+}
+
+void AsyncTrajectorySink::waitUntilEmpty() {
+    while (!ring.empty()) {
+        writer.wake();
+        std::this_thread::sleep_for(WAIT_INTERVAL);
+    }
+}
+
+void AsyncTrajectorySink::record(long step, const MissionState& state,
+                                 const OrbitalElements& elements) {
+    push(QueuedStep{step, false, state, elements});
+}
+
+void AsyncTrajectorySink::finish(long step, const MissionState& final_state,
+                                 const OrbitalElements& elements) {
+    push(QueuedStep{step, true, final_state, elements});
+    waitUntilEmpty();
+    finished = true;
+}
+
+bool AsyncTrajectorySink::drain(std::size_t max_steps) {
+    std::size_t handled = 0;
+    while (handled < max_steps) {
+        QueuedStep* queued = ring.front();
+        if (!queued) {
+            break;
+        }
+        if (queued->is_finish) {
+            downstream.finish(queued->step, queued->state, queued->elements);
+        } else if (downstream.wantsStep(queued->step)) {
+            downstream.record(queued->step, queued->state, queued->elements);
+        }
+        ring.pop();  // Releases the slot only once the step is written
+        handled++;
+    }
+    return handled > 0;
+}
+
+bool AsyncTrajectorySink::saveCheckpoint(SinkCheckpoint& checkpoint) {
+    // With the queue empty the writer thread no longer touches downstream,
+    // and the ring's acquire/release ordering makes its writes visible here
+    waitUntilEmpty();
+    return downstream.saveCheckpoint(checkpoint);
+}
+
+bool AsyncTrajectorySink::restoreCheckpoint(SinkCheckpoint& checkpoint) {
+    waitUntilEmpty();
+    return downstream.restoreCheckpoint(checkpoint);
+}
@@ -0,0 +1,125 @@
+#ifndef ASYNC_SINK_H
+#define ASYNC_SINK_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "propagator.h"
+#include "orbital_elements.h"
+#include "trajectory_sink.h"
+#include "spsc_ring.h"
+
+// ===========================================================================
+// ASYNCHRONOUS TRAJECTORY OUTPUT
+// ===========================================================================
+// Moves trajectory formatting and file I/O off the propagation thread:
+//
+//   propagation thread --record--> AsyncTrajectorySink --SPSC ring-->
+//       TrajectoryWriterThread --record/finish--> wrapped sink (CSV, binary, ...)
+//
+// The ring is sized from a memory budget. When it is full, the propagation
+// thread waits for the writer (backpressure) instead of growing the queue,
+// so memory stays bounded however slow the disk is.
+//
+// One TrajectoryWriterThread can serve several sinks, so a parallel batch
+// can share a single I/O thread between all of its missions.
+//
+// Decimate in front of the async sink (Decimating -> Async -> Csv): the
+// wrapped sink's wantsStep is only consulted on the writer thread.
+// ===========================================================================
+
+class AsyncTrajectorySink;
+
+/// I/O thread that drains the rings of every attached AsyncTrajectorySink
+/// Sinks attach themselves on construction and detach on destruction; all
+/// of them must be destroyed before the writer thread.
+class TrajectoryWriterThread {
+public:
+    TrajectoryWriterThread();
+    ~TrajectoryWriterThread();
+    
+    TrajectoryWriterThread(const TrajectoryWriterThread&) = delete;
+    TrajectoryWriterThread& operator=(const TrajectoryWriterThread&) = delete;
+    
+    /// Wake the thread if it is waiting for work
+    void wake();
+
+private:
+    friend class AsyncTrajectorySink;
+    
+    void attach(AsyncTrajectorySink* sink);
+    void detach(AsyncTrajectorySink* sink);
+    void run();
+    
+    std::mutex sinks_mutex;                 // Held while the thread services sinks
+    std::vector<AsyncTrajectorySink*> sinks;
+    
+    std::mutex wake_mutex;
+    std::condition_variable wake_cv;
+    std::atomic<bool> sleeping{false};
+    bool stopping = false;                  // Guarded by wake_mutex
+    std::thread thread;
+};
+
+/// Queues steps for a wrapped sink that runs on a TrajectoryWriterThread
+class AsyncTrajectorySink : public TrajectorySink {
+public:
+    static constexpr std::size_t DEFAULT_BUFFER_BYTES = 4 << 20;
+    
+    /// buffer_bytes bounds the queued steps (about 150 bytes each)
+    AsyncTrajectorySink(TrajectorySink& downstream, TrajectoryWriterThread& writer,
+                        std::size_t buffer_bytes = DEFAULT_BUFFER_BYTES);
+    
+    /// Waits until every queued step has been written
+    ~AsyncTrajectorySink() override;
+    
+    AsyncTrajectorySink(const AsyncTrajectorySink&) = delete;
+    AsyncTrajectorySink& operator=(const AsyncTrajectorySink&) = delete;
+    
+    bool wantsStep(long) const override { return !finished; }
+    void record(long step, const MissionState& state,
+                const OrbitalElements& elements) override;
+    
+    /// Queues the final state and returns once the wrapped sink has finished
+    void finish(long step, const MissionState& final_state,
+                const OrbitalElements& elements) override;
+    
+    /// Drain the queue, then checkpoint the wrapped sink
+    bool saveCheckpoint(SinkCheckpoint& checkpoint) override;
+    bool restoreCheckpoint(SinkCheckpoint& checkpoint) override;
+    
+    /// Steps the ring can hold
+    std::size_t queueCapacity() const { return ring.capacity(); }
+    
+    /// Times the propagation thread had to wait for a full queue
+    long backpressureWaits() const { return backpressure_waits; }
+
+private:
+    friend class TrajectoryWriterThread;
+    
+    struct QueuedStep {
+        long step;
+        bool is_finish;
+        MissionState state;
+        OrbitalElements elements;
+    };
+    
+    void push(const QueuedStep& queued);
+    
+    /// Writer thread: hand up to max_steps queued steps to the wrapped sink
+    bool drain(std::size_t max_steps);
+    
+    /// Block until the writer thread has consumed everything queued
+    void waitUntilEmpty();
+    
+    TrajectorySink& downstream;
+    TrajectoryWriterThread& writer;
+    SpscRing<QueuedStep> ring;
+    bool finished = false;
+    long backpressure_waits = 0;
+};
+
+#endif // ASYNC_SINK_H
@@ -0,0 +1,153 @@
+#include <algorithm>
+#include "batch_elements.h"
+#include "thread_pool.h"
+
+namespace {
+
+/// Rows per task; large enough that task overhead is negligible
+constexpr std::size_t CHUNK_ROWS = 65536;
+
+// ===========================================================================
+// SIMD KERNEL
+// ===========================================================================
+// Same steps as computeOrbitalElements, written as one branch-free loop
+// (see batch_propagator.cpp). Lanes that take a degenerate branch in the
+// scalar code (equatorial, circular, parabolic) compute the general case
+// too and are overwritten by the select.
+
+void elementsKernel(std::size_t n,
+                    const double* __restrict x, const double* __restrict y,
+                    const double* __restrict z,
+                    const double* __restrict vx, const double* __restrict vy,
+                    const double* __restrict vz, double mu,
+                    double* __restrict a_out, double* __restrict e_out,
+                    double* __restrict i_out, double* __restrict Omega_out,
+                    double* __restrict omega_out, double* __restrict nu_out,
+                    double* __restrict rp_out, double* __restrict ra_out,
+                    double* __restrict h_out, double* __restrict E_out) {
+    const double two_pi = 2 * 3.14159265358979323846;
+    const double inv_mu = 1.0 / mu;
+    for (std::size_t k = 0; k < n; ++k) {
+        // Angular momentum h = r x v, energy E = v^2/2 - mu/r
+        double hx = y[k]*vz[k] - z[k]*vy[k];
+        double hy = z[k]*vx[k] - x[k]*vz[k];
+        double hz = x[k]*vy[k] - y[k]*vx[k];
+        double h_mag = std::sqrt(hx*hx + hy*hy + hz*hz);
+        double r_mag = std::sqrt(x[k]*x[k] + y[k]*y[k] + z[k]*z[k]);
+        double v_mag_sq = vx[k]*vx[k] + vy[k]*vy[k] + vz[k]*vz[k];
+        double energy = v_mag_sq / 2.0 - mu / r_mag;
+        
+        // Size and shape (2.0 flags a hyperbolic orbit)
+        double a = (std::abs(energy) > 1e-15) ? -mu / (2.0 * energy) : 1e10;
+        double e_sq = 1.0 - (h_mag * h_mag) / (mu * a);
+        e_sq = (e_sq < 0) ? 0.0 : e_sq;
+        double e = (a > 0) ? std::sqrt(e_sq) : 2.0;
+        
+        // Inclination; sin(i) = |h_xy| / |h| needs no trig call
+        bool tilted = h_mag > 1e-10;
+        double cos_i = hz / h_mag;
+        cos_i = std::min(1.0, std::max(-1.0, cos_i));
+        double h_xy = std::sqrt(hx*hx + hy*hy);
+        double inclination = tilted ? fastAcos(cos_i) : 0.0;
+        double sin_i = tilted ? h_xy / h_mag : 0.0;
+        
+        // Node: Omega = atan2(-h_x, h_y), so cos/sin(Omega) = (h_y, -h_x) / |h_xy|
+        double Omega = fastAtan2(-hx, hy);
+        Omega = (Omega < 0) ? Omega + two_pi : Omega;
+        bool has_node = h_xy > 0;
+        double inv_h_xy = 1.0 / h_xy;
+        double cos_Omega = has_node ? hy * inv_h_xy : 1.0;
+        double sin_Omega = has_node ? -hx * inv_h_xy : 0.0;
+        
+        // Argument of periapsis from the eccentricity vector (v x h)/mu - r/|r|
+        // (reciprocals instead of six divisions; omega is approximate anyway)
+        double inv_r = 1.0 / r_mag;
+        double ex = (vy[k]*hz - vz[k]*hy) * inv_mu - x[k] * inv_r;
+        double ey = (vz[k]*hx - vx[k]*hz) * inv_mu - y[k] * inv_r;
+        double ez = (vx[k]*hy - vy[k]*hx) * inv_mu - z[k] * inv_r;
+        double omega = fastAtan2(ez / sin_i, ex*cos_Omega + ey*sin_Omega);
+        omega = (sin_i > 1e-10) ? omega : 0.0;
+        omega = (omega < 0) ? omega + two_pi : omega;
+        
+        // True anomaly, on the far side of the orbit when r.v < 0
+        double cos_nu = (h_mag * h_mag / (mu * r_mag) - 1.0) / e;
+        cos_nu = std::min(1.0, std::max(-1.0, cos_nu));
+        double nu = fastAcos(cos_nu);
+        double r_dot_v = x[k]*vx[k] + y[k]*vy[k] + z[k]*vz[k];
+        nu = (r_dot_v < 0) ? two_pi - nu : nu;
+        nu = (e > 1e-10) ? nu : 0.0;
+        
+        a_out[k] = a;
+        e_out[k] = e;
+        i_out[k] = inclination;
+        Omega_out[k] = Omega;
+        omega_out[k] = omega;
+        nu_out[k] = nu;
+        rp_out[k] = a * (1.0 - e);
+        ra_out[k] = a * (1.0 + e);
+        h_out[k] = h_mag;
+        E_out[k] = energy;
+    }
+}
+
+}  // namespace
+
+// ===========================================================================
+// ELEMENT ARRAYS
+// ===========================================================================
+
+void ElementArrays::resize(std::size_t n) {
+    for (std::vector<double>* column : {&a, &e, &i, &Omega, &omega, &nu, &r_p, &r_a, &h, &E}) {
+        column->resize(n);
+    }
+}
+
+OrbitalElements ElementArrays::at(std::size_t k) const {
+    OrbitalElements elements;
+    elements.a = a[k];
+    elements.e = e[k];
+    elements.i = i[k];
+    elements.Omega = Omega[k];
+    elements.omega = omega[k];
+    elements.nu = nu[k];
+    elements.r_p = r_p[k];
+    elements.r_a = r_a[k];
+    elements.h = h[k];
+    elements.E = E[k];
+    return elements;
+}
+
+// ===========================================================================
+// BATCH CONVERSION
+// ===========================================================================
+
+void computeOrbitalElementsBatch(const StateColumns& states, double mu,
+                                 ElementArrays& elements, unsigned jobs) {
+    std::size_t n = states.count;
+    elements.resize(n);
+    
+    std::size_t chunks = (n + CHUNK_ROWS - 1) / CHUNK_ROWS;
+    auto run_chunk = [&](std::size_t chunk) {
+        std::size_t begin = chunk * CHUNK_ROWS;
+        std::size_t rows = std::min(n, begin + CHUNK_ROWS) - begin;
+        elementsKernel(rows,
+                       states.x + begin, states.y + begin, states.z + begin,
+                       states.vx + begin, states.vy + begin, states.vz + begin, mu,
+                       elements.a.data() + begin, elements.e.data() + begin,
+                       elements.i.data() + begin, elements.Omega.data() + begin,
+                       elements.omega.data() + begin, elements.nu.data() + begin,
+                       elements.r_p.data() + begin, elements.r_a.data() + begin,
+                       elements.h.data() + begin, elements.E.data() + begin);
+    };
+    
+    // Chunks write disjoint rows, so the split cannot change any value
+    unsigned num_threads = std::min<std::size_t>(ThreadPool::resolveThreadCount(jobs), chunks);
+    if (num_threads > 1) {
+        ThreadPool pool(num_threads);
+        pool.parallelFor(chunks, run_chunk);
+    } else {
+        for (std::size_t chunk = 0; chunk < chunks; chunk++) {
+            run_chunk(chunk);
+        }
+    }
+}
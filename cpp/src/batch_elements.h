@@ -0,0 +1,109 @@
+#ifndef BATCH_ELEMENTS_H
+#define BATCH_ELEMENTS_H
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include "orbital_elements.h"
+
+// ===========================================================================
+// BRANCH-FREE INVERSE TRIGONOMETRY
+// ===========================================================================
+// std::atan2/std::acos are library calls, so a loop that uses them cannot
+// be vectorized. These replacements are straight-line arithmetic with
+// selects instead of branches, so they inline into SIMD loops.
+//
+// fastAtan2 reduces to |t| <= 0.66 (octant swap, then atan(t) = pi/4 +
+// atan((t-1)/(t+1))) and evaluates the Cephes rational approximation
+// P(t^2)/Q(t^2). Error against std::atan2 stays below
+// FAST_ATAN2_MAX_ERROR over the whole plane; fastAcos inherits the same
+// bound, since acos(x) = atan2(sqrt((1-x)(1+x)), x) with both factors
+// exact near |x| = 1.
+// ===========================================================================
+
+/// Absolute error bound (radians) of fastAtan2 and fastAcos
+constexpr double FAST_ATAN2_MAX_ERROR = 1e-15;
+
+/// atan2(y, x) in (-pi, pi]; atan2(0, 0) = 0
+inline double fastAtan2(double y, double x) {
+    const double pi = 3.14159265358979323846;
+    double ax = x < 0 ? -x : x;
+    double ay = y < 0 ? -y : y;
+    
+    // t = min/max in [0, 1]; atan(t) = pi/4 + atan((t-1)/(t+1)) then
+    // brings it into [-0.205, 0.66], with a single division either way
+    bool swap = ay > ax;
+    double num = swap ? ax : ay;
+    double den = swap ? ay : ax;
+    bool shift = num > 0.66 * den;
+    double u_num = shift ? num - den : num;
+    double u_den = shift ? num + den : den;
+    double u = u_den > 0 ? u_num / u_den : 0.0;  // 0 when both are zero
+    
+    double z = u * u;
+    double p = (((-8.750608600031904122785e-1 * z - 1.615753718733365076637e1) * z
+                 - 7.500855792314704667340e1) * z - 1.228866684490136173410e2) * z
+               - 6.485021904942025371773e1;
+    double q = ((((z + 2.485846490142306297962e1) * z + 1.650270098316988542046e2) * z
+                 + 4.328810604912902668951e2) * z + 4.853903996359136964868e2) * z
+               + 1.945506571482613964425e2;
+    double angle = u + u * z * p / q;
+    angle = shift ? angle + 0.25 * pi : angle;
+    
+    // Undo the reductions: octant, then quadrant, then sign
+    angle = swap ? 0.5 * pi - angle : angle;
+    angle = x < 0 ? pi - angle : angle;
+    return y < 0 ? -angle : angle;
+}
+
+/// acos(x) in [0, pi] for x in [-1, 1]
+inline double fastAcos(double x) {
+    return fastAtan2(std::sqrt((1.0 - x) * (1.0 + x)), x);
+}
+
+// ===========================================================================
+// STRUCTURE-OF-ARRAYS ELEMENT CONVERSION
+// ===========================================================================
+// computeOrbitalElements for a whole trajectory at once: state columns in,
+// one array per element out. The kernel is a single unit-stride loop with
+// no calls (fastAtan2/fastAcos replace the library functions, and sin/cos
+// of i and Omega follow algebraically from h), so it vectorizes like the
+// batch propagator kernels. Rows are split into chunks across a thread
+// pool.
+//
+// Results agree with computeOrbitalElements to round-off: a, e, r_p, r_a,
+// h and E use the same arithmetic; the angles differ by at most a few
+// FAST_ATAN2_MAX_ERROR (more only where an angle is ill-conditioned, e.g.
+// omega of a near-circular orbit).
+// ===========================================================================
+
+/// Input state columns (count rows each), e.g. from a MappedTrajectory
+struct StateColumns {
+    std::size_t count = 0;
+    const double* x = nullptr;            // Position (km)
+    const double* y = nullptr;
+    const double* z = nullptr;
+    const double* vx = nullptr;           // Velocity (km/s)
+    const double* vy = nullptr;
+    const double* vz = nullptr;
+};
+
+/// One array per OrbitalElements field
+struct ElementArrays {
+    std::vector<double> a, e, i, Omega, omega, nu;
+    std::vector<double> r_p, r_a, h, E;
+    
+    std::size_t size() const { return a.size(); }
+    void resize(std::size_t n);
+    
+    /// Row k as an OrbitalElements struct
+    OrbitalElements at(std::size_t k) const;
+};
+
+/// Convert every row of states
+/// jobs as for --jobs (0 = one per hardware thread); results do not
+/// depend on jobs.
+void computeOrbitalElementsBatch(const StateColumns& states, double mu,
+                                 ElementArrays& elements, unsigned jobs = 1);
+
+#endif // BATCH_ELEMENTS_H
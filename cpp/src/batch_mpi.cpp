@@ -0,0 +1,145 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "batch_shards.h"
+#include "mission_batch.h"
+
+#ifdef LTMD_ENABLE_MPI
+#include <mpi.h>
+#endif
+
+// ===========================================================================
+// MPI DYNAMIC DISTRIBUTION
+// ===========================================================================
+
+bool mpiBatchAvailable() {
+#ifdef LTMD_ENABLE_MPI
+    return true;
+#else
+    return false;
+#endif
+}
+
+#ifdef LTMD_ENABLE_MPI
+namespace {
+
+constexpr int TAG_REQUEST = 1;   // Worker -> rank 0: finished row ("" = first request)
+constexpr int TAG_ASSIGN = 2;    // Rank 0 -> worker: next batch index (-1 = stop)
+
+/// Rank 0: hand out indices on request and collect the finished rows
+bool coordinate(std::size_t total, int ranks, std::vector<MissionResult>& missions) {
+    missions.assign(total, MissionResult());
+    std::vector<bool> received(total, false);
+    std::size_t next = 0;
+    int working = ranks - 1;
+    bool ok = true;
+    
+    while (working > 0) {
+        MPI_Status status;
+        MPI_Probe(MPI_ANY_SOURCE, TAG_REQUEST, MPI_COMM_WORLD, &status);
+        int length = 0;
+        MPI_Get_count(&status, MPI_CHAR, &length);
+        std::vector<char> buffer(static_cast<std::size_t>(length) + 1, '\0');
+        MPI_Recv(buffer.data(), length, MPI_CHAR, status.MPI_SOURCE, TAG_REQUEST,
+                 MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        
+        if (length > 0) {
+            std::size_t index = 0;
+            MissionResult mission;
+            if (parseShardRow(buffer.data(), index, mission) && index < total) {
+                missions[index] = mission;
+                received[index] = true;
+            } else {
+                std::cerr << "Error: Malformed result from rank " << status.MPI_SOURCE << "\n";
+                ok = false;
+            }
+        }
+        
+        long long assign = (next < total) ? static_cast<long long>(next++) : -1;
+        if (assign < 0) {
+            working--;
+        }
+        MPI_Send(&assign, 1, MPI_LONG_LONG, status.MPI_SOURCE, TAG_ASSIGN, MPI_COMM_WORLD);
+    }
+    
+    for (std::size_t k = 0; k < total; ++k) {
+        ok = ok && received[k];
+    }
+    return ok;
+}
+
+/// Other ranks: run whatever rank 0 assigns until it says stop
+void work(MissionBatchRunner& runner, const std::vector<std::string>& config_files, int rank) {
+    std::string row;
+    while (true) {
+        MPI_Send(row.data(), static_cast<int>(row.size()), MPI_CHAR, 0, TAG_REQUEST,
+                 MPI_COMM_WORLD);
+        long long index = -1;
+        MPI_Recv(&index, 1, MPI_LONG_LONG, 0, TAG_ASSIGN, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        if (index < 0) {
+            return;
+        }
+        
+        const std::string& config_file = config_files[static_cast<std::size_t>(index)];
+        std::cout << ("Rank " + std::to_string(rank) + " running mission: " + config_file +
+                      "...\n") << std::flush;
+        MissionResult mission = runner.runSingleMission(config_file);
+        computeMissionMetrics(mission);
+        row = formatShardRow(static_cast<std::size_t>(index), mission);
+    }
+}
+
+}  // namespace
+#endif
+
+MpiBatchStatus runBatchMissionsMpi(MissionBatchRunner& runner,
+                                   const std::vector<std::string>& config_files,
+                                   MissionComparison& comparison) {
+#ifdef LTMD_ENABLE_MPI
+    int initialized = 0;
+    MPI_Initialized(&initialized);
+    if (!initialized) {
+        MPI_Init(nullptr, nullptr);
+    }
+    int rank = 0;
+    int ranks = 1;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &ranks);
+    
+    MpiBatchStatus status = MpiBatchStatus::WORKER;
+    if (ranks == 1) {
+        // No workers: rank 0 runs the batch itself
+        comparison = runner.runBatchMissions(config_files);
+        status = MpiBatchStatus::COMPLETE;
+    } else if (rank == 0) {
+        std::cout << "Distributing " << config_files.size() << " missions over "
+                  << ranks - 1 << " MPI worker ranks...\n";
+        std::vector<MissionResult> missions;
+        if (coordinate(config_files.size(), ranks, missions)) {
+            comparison = MissionComparison();
+            for (const MissionResult& mission : missions) {
+                comparison.addMission(mission);
+            }
+            comparison.computeMetrics();
+            comparison.setPruned(runner.pruning() != nullptr);
+            status = MpiBatchStatus::COMPLETE;
+        } else {
+            std::cerr << "Error: Not every mission came back from the MPI workers\n";
+            status = MpiBatchStatus::FAILED;
+        }
+    } else {
+        work(runner, config_files, rank);
+    }
+    
+    if (!initialized) {
+        MPI_Finalize();
+    }
+    return status;
+#else
+    (void)runner;
+    (void)config_files;
+    (void)comparison;
+    std::cerr << "Warning: --mpi needs a build with -DLTMD_ENABLE_MPI=ON\n";
+    return MpiBatchStatus::FAILED;
+#endif
+}
@@ -0,0 +1,467 @@
+#include <cmath>
+#include "batch_propagator.h"
+#include "mission_propagation.h"
+#include "force_model.h"
+#include "pruning.h"
+#include "gpu_batch_propagator.h"
+
+// ===========================================================================
+// SIMD KERNELS
+// ===========================================================================
+// Every kernel is a single unit-stride loop over lanes with no calls and no
+// data-dependent branches (conditions are written as selects), so GCC and
+// Clang vectorize them at -O3. Masked lanes are computed like any other
+// lane and discarded by the final select, which keeps the loops branch-free.
+
+namespace {
+
+// Where a kernel takes thrust, ISP, mu and g0 from. LaneModel reads the
+// per-lane arrays and the step arguments. PresetModel<P> is used when
+// every lane flies thruster preset P around the Sun: the values are
+// compile-time constants from the registries, so the kernels lose two
+// array streams and the mass-flow rate folds to a constant. The
+// arithmetic is the same, so both models give the same bits.
+
+struct LaneModel {
+    static double thrust(const double* __restrict thrust_mN, std::size_t i) { return thrust_mN[i]; }
+    static double isp(const double* __restrict isp_s, std::size_t i) { return isp_s[i]; }
+    static double mu(double mu) { return mu; }
+    static double g0(double g0) { return g0; }
+};
+
+template <ThrusterPreset P>
+struct PresetModel {
+    static constexpr double THRUST_MN = getThrusterInfo(P).thrust_mN;
+    static constexpr double ISP_S = getThrusterInfo(P).isp_s;
+    
+    static double thrust(const double*, std::size_t) { return THRUST_MN; }
+    static double isp(const double*, std::size_t) { return ISP_S; }
+    static double mu(double) { return MU_SUN; }
+    static double g0(double) { return G0; }
+};
+
+/// a = gravity + thrust for every lane (same arithmetic as computeAcceleration)
+template <class Model>
+void accelerationKernel(std::size_t n,
+                        const double* __restrict x, const double* __restrict y,
+                        const double* __restrict z,
+                        const double* __restrict vx, const double* __restrict vy,
+                        const double* __restrict vz,
+                        const double* __restrict m, const double* __restrict thrust_mN,
+                        double mu_arg, double thrust_direction,
+                        double* __restrict ax, double* __restrict ay, double* __restrict az) {
+    const double mu = Model::mu(mu_arg);
+    for (std::size_t i = 0; i < n; ++i) {
+        // Gravity: a = -mu * r / |r|^3 (zero at the singularity)
+        double r_mag = std::sqrt(x[i]*x[i] + y[i]*y[i] + z[i]*z[i]);
+        double r_cubed = r_mag * r_mag * r_mag;
+        double g = (r_mag < 1e-10) ? 0.0 : -mu / r_cubed;
+        
+        // Thrust: a = dir * (thrust * 1e-6 / m) * v / |v| (zero when degenerate)
+        double thrust = Model::thrust(thrust_mN, i);
+        double v_mag = std::sqrt(vx[i]*vx[i] + vy[i]*vy[i] + vz[i]*vz[i]);
+        bool thrusting = (thrust >= 1e-10) & (m[i] >= 1e-10) & (v_mag >= 1e-10);
+        double a_mag = (thrust * 1e-6) / m[i];
+        double f = thrusting ? thrust_direction * a_mag / v_mag : 0.0;
+        
+        ax[i] = g * x[i] + f * vx[i];
+        ay[i] = g * y[i] + f * vy[i];
+        az[i] = g * z[i] + f * vz[i];
+    }
+}
+
+/// out = a + b*h
+void axpyKernel(std::size_t n, const double* __restrict a, const double* __restrict b,
+                double h, double* __restrict out) {
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = a[i] + b[i] * h;
+    }
+}
+
+/// out = a + b*h1 + c*h2
+void axpy2Kernel(std::size_t n, const double* __restrict a, const double* __restrict b,
+                 double h1, const double* __restrict c, double h2, double* __restrict out) {
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = a[i] + b[i] * h1 + c[i] * h2;
+    }
+}
+
+/// out = y + h * (k1 + 2*k2 + 2*k3 + k4)
+void rk4CombineKernel(std::size_t n, const double* __restrict y,
+                      const double* __restrict k1, const double* __restrict k2,
+                      const double* __restrict k3, const double* __restrict k4,
+                      double h, double* __restrict out) {
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = y[i] + h * (k1[i] + 2*k2[i] + 2*k3[i] + k4[i]);
+    }
+}
+
+/// y = value for active lanes only
+void commitKernel(std::size_t n, const std::int64_t* __restrict active,
+                  const double* __restrict value, double* __restrict y) {
+    for (std::size_t i = 0; i < n; ++i) {
+        y[i] = (active[i] != 0) ? value[i] : y[i];
+    }
+}
+
+/// m += dm/dt * dt (clamped at zero) and t += dt for active lanes
+/// dm/dt = -thrust / (isp * g0), as in RK4Propagator
+template <class Model>
+void massFlowKernel(std::size_t n, const std::int64_t* __restrict active,
+                    const double* __restrict thrust_mN, const double* __restrict isp_s,
+                    double g0_arg, double dt, double* __restrict m, double* __restrict t) {
+    const double g0 = Model::g0(g0_arg);
+    for (std::size_t i = 0; i < n; ++i) {
+        double thrust = Model::thrust(thrust_mN, i);
+        double isp = Model::isp(isp_s, i);
+        bool burning = (thrust > 1e-10) & (isp > 1e-10);
+        double v_e = isp * g0;
+        double dm_dt = -thrust * 1e-6 / v_e;
+        double m_new = m[i] + dm_dt * dt;
+        m_new = (m_new < 0) ? 0.0 : m_new;
+        
+        bool live = active[i] != 0;
+        m[i] = (live & burning) ? m_new : m[i];
+        t[i] = live ? t[i] + dt : t[i];
+    }
+}
+
+/// Preset whose exact thrust and ISP every config has, or -1
+int uniformPreset(const std::vector<MissionConfig>& configs) {
+    for (const ThrusterInfo& info : THRUSTERS) {
+        bool all = true;
+        for (const MissionConfig& config : configs) {
+            all = all && config.spacecraft.thrust_mN == info.thrust_mN &&
+                  config.spacecraft.isp_s == info.isp_s;
+        }
+        if (all) {
+            return static_cast<int>(info.preset);
+        }
+    }
+    return -1;
+}
+
+}  // namespace
+
+// ===========================================================================
+// BATCH STATE
+// ===========================================================================
+
+void BatchState::resize(std::size_t n) {
+    x.resize(n);  y.resize(n);  z.resize(n);
+    vx.resize(n); vy.resize(n); vz.resize(n);
+    m.resize(n);  t.resize(n);
+    thrust_mN.resize(n);
+    isp_s.resize(n);
+    active.resize(n);
+}
+
+void BatchState::setLane(std::size_t i, const MissionState& state, double thrust, double isp) {
+    x[i] = state.r[0];  y[i] = state.r[1];  z[i] = state.r[2];
+    vx[i] = state.v[0]; vy[i] = state.v[1]; vz[i] = state.v[2];
+    m[i] = state.m;
+    t[i] = state.t;
+    thrust_mN[i] = thrust;
+    isp_s[i] = isp;
+    active[i] = 1;
+}
+
+MissionState BatchState::lane(std::size_t i) const {
+    return MissionState(x[i], y[i], z[i], vx[i], vy[i], vz[i], m[i], t[i]);
+}
+
+void BatchState::moveLane(std::size_t from, std::size_t to) {
+    x[to] = x[from];   y[to] = y[from];   z[to] = z[from];
+    vx[to] = vx[from]; vy[to] = vy[from]; vz[to] = vz[from];
+    m[to] = m[from];
+    t[to] = t[from];
+    thrust_mN[to] = thrust_mN[from];
+    isp_s[to] = isp_s[from];
+    active[to] = active[from];
+}
+
+// ===========================================================================
+// BATCHED RK4 IMPLEMENTATION
+// ===========================================================================
+
+void BatchRK4Propagator::reserve(std::size_t n) {
+    if (k1x.size() >= n) {
+        return;
+    }
+    for (std::vector<double>* buffer : {&k1x, &k1y, &k1z, &k2x, &k2y, &k2z,
+                                        &k3x, &k3y, &k3z, &k4x, &k4y, &k4z,
+                                        &sx, &sy, &sz, &svx, &svy, &svz,
+                                        &v2x, &v2y, &v2z, &v3x, &v3y, &v3z}) {
+        buffer->resize(n);
+    }
+}
+
+void BatchRK4Propagator::step(BatchState& batch, double dt, double mu, double g0,
+                              int thrust_direction) {
+    if (batch.preset >= 0 && mu == MU_SUN && g0 == G0) {
+        stepPreset<0>(batch, dt, thrust_direction);
+    } else {
+        stepWith<LaneModel>(batch, dt, mu, g0, thrust_direction);
+    }
+}
+
+template <std::size_t I>
+void BatchRK4Propagator::stepPreset(BatchState& batch, double dt, int thrust_direction) {
+    if (static_cast<std::size_t>(batch.preset) == I) {
+        stepWith<PresetModel<static_cast<ThrusterPreset>(I)>>(batch, dt, MU_SUN, G0,
+                                                              thrust_direction);
+    } else if constexpr (I + 1 < THRUSTER_COUNT) {
+        stepPreset<I + 1>(batch, dt, thrust_direction);
+    }
+}
+
+template <class Model>
+void BatchRK4Propagator::stepWith(BatchState& batch, double dt, double mu, double g0,
+                                  int thrust_direction) {
+    const std::size_t n = batch.size();
+    reserve(n);
+    
+    double* x = batch.x.data();
+    double* y = batch.y.data();
+    double* z = batch.z.data();
+    double* vx = batch.vx.data();
+    double* vy = batch.vy.data();
+    double* vz = batch.vz.data();
+    const double* m = batch.m.data();
+    const double* thrust = batch.thrust_mN.data();
+    const double dir = thrust_direction;
+    const double half_dt = dt / 2;
+    
+    // STAGE 1: k1 = a(r, v)
+    accelerationKernel<Model>(n, x, y, z, vx, vy, vz, m, thrust, mu, dir,
+                              k1x.data(), k1y.data(), k1z.data());
+    
+    // STAGE 2: k2 = a(r + v*dt/2, v + k1*dt/2)
+    axpyKernel(n, x, vx, half_dt, sx.data());
+    axpyKernel(n, y, vy, half_dt, sy.data());
+    axpyKernel(n, z, vz, half_dt, sz.data());
+    axpyKernel(n, vx, k1x.data(), half_dt, v2x.data());
+    axpyKernel(n, vy, k1y.data(), half_dt, v2y.data());
+    axpyKernel(n, vz, k1z.data(), half_dt, v2z.data());
+    accelerationKernel<Model>(n, sx.data(), sy.data(), sz.data(),
+                              v2x.data(), v2y.data(), v2z.data(),
+                              m, thrust, mu, dir, k2x.data(), k2y.data(), k2z.data());
+    
+    // STAGE 3: k3 = a(r + v*dt/2, v + k2*dt/2)
+    axpyKernel(n, vx, k2x.data(), half_dt, v3x.data());
+    axpyKernel(n, vy, k2y.data(), half_dt, v3y.data());
+    axpyKernel(n, vz, k2z.data(), half_dt, v3z.data());
+    accelerationKernel<Model>(n, sx.data(), sy.data(), sz.data(),
+                              v3x.data(), v3y.data(), v3z.data(),
+                              m, thrust, mu, dir, k3x.data(), k3y.data(), k3z.data());
+    
+    // STAGE 4: k4 = a(r + v*dt + k3*dt²/2, v + k3*dt)
+    axpy2Kernel(n, x, vx, dt, k3x.data(), dt * dt / 2, sx.data());
+    axpy2Kernel(n, y, vy, dt, k3y.data(), dt * dt / 2, sy.data());
+    axpy2Kernel(n, z, vz, dt, k3z.data(), dt * dt / 2, sz.data());
+    axpyKernel(n, vx, k3x.data(), dt, svx.data());
+    axpyKernel(n, vy, k3y.data(), dt, svy.data());
+    axpyKernel(n, vz, k3z.data(), dt, svz.data());
+    accelerationKernel<Model>(n, sx.data(), sy.data(), sz.data(),
+                              svx.data(), svy.data(), svz.data(),
+                              m, thrust, mu, dir, k4x.data(), k4y.data(), k4z.data());
+    
+    // COMBINE: weighted average of the stage velocities (into sx) and
+    // accelerations (into v2x), since neither buffer is read again
+    rk4CombineKernel(n, x, vx, v2x.data(), v3x.data(), svx.data(), dt / 6.0, sx.data());
+    rk4CombineKernel(n, y, vy, v2y.data(), v3y.data(), svy.data(), dt / 6.0, sy.data());
+    rk4CombineKernel(n, z, vz, v2z.data(), v3z.data(), svz.data(), dt / 6.0, sz.data());
+    rk4CombineKernel(n, vx, k1x.data(), k2x.data(), k3x.data(), k4x.data(), dt / 6.0, v2x.data());
+    rk4CombineKernel(n, vy, k1y.data(), k2y.data(), k3y.data(), k4y.data(), dt / 6.0, v2y.data());
+    rk4CombineKernel(n, vz, k1z.data(), k2z.data(), k3z.data(), k4z.data(), dt / 6.0, v2z.data());
+    
+    // Masked write-back: frozen lanes keep their state bit for bit
+    const std::int64_t* active = batch.active.data();
+    commitKernel(n, active, sx.data(), x);
+    commitKernel(n, active, sy.data(), y);
+    commitKernel(n, active, sz.data(), z);
+    commitKernel(n, active, v2x.data(), vx);
+    commitKernel(n, active, v2y.data(), vy);
+    commitKernel(n, active, v2z.data(), vz);
+    massFlowKernel<Model>(n, active, thrust, batch.isp_s.data(), g0, dt,
+                          batch.m.data(), batch.t.data());
+}
+
+// ===========================================================================
+// BATCH MISSION PROPAGATION
+// ===========================================================================
+
+bool canPropagateAsBatch(const std::vector<MissionConfig>& configs) {
+    for (const MissionConfig& config : configs) {
+        if (config.integrator != "rk4" || config.precision != "double" || config.locate_coast ||
+            !config.events.empty() || config.coast_mode != "stop" || config.compute_sensitivity ||
+            hasPerturbations(config) ||
+            config.timestep_s != configs[0].timestep_s ||
+            config.max_flight_time_s != configs[0].max_flight_time_s ||
+            config.pruning != configs[0].pruning ||
+            config.batch_backend != configs[0].batch_backend) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<PropagationResult> propagateMissionBatch(
+    const std::vector<MissionConfig>& configs,
+    double r_departure,
+    double r_arrival) {
+    
+    std::vector<PropagationResult> results(configs.size());
+    
+    if (!canPropagateAsBatch(configs)) {
+        for (std::size_t i = 0; i < configs.size(); ++i) {
+            results[i] = propagateMission(configs[i], r_departure, r_arrival);
+        }
+        return results;
+    }
+    if (configs.empty()) {
+        return results;
+    }
+    
+    // One thread per spacecraft (gpu_batch_propagator.h); the pruning
+    // bound is a host atomic, so pruned sets stay on the SoA kernels
+    const std::string& backend = configs[0].batch_backend;
+    if (backend == "lanes" && !configs[0].pruning) {
+        return propagateMissionLanes(configs, r_departure, r_arrival);
+    }
+    if (backend == "gpu" && !configs[0].pruning &&
+        propagateMissionLanesGpu(configs, r_departure, r_arrival, results)) {
+        return results;
+    }
+    
+    // Determine thrust direction based on transfer type
+    int thrust_direction = (r_arrival > r_departure) ? 1 : -1;
+    double dt = configs[0].timestep_s;
+    double max_flight_time = configs[0].max_flight_time_s;
+    PruningBound* pruning = configs[0].pruning;
+    
+    // Initialize every lane on the departure circular orbit
+    std::size_t n = configs.size();
+    double v_circ = std::sqrt(MU_SUN / r_departure);
+    BatchState batch;
+    batch.resize(n);
+    batch.preset = uniformPreset(configs);
+    
+    // Per-lane bookkeeping, compacted together with the batch
+    std::vector<std::size_t> mission(n);
+    std::vector<double> coast_radius(n);
+    std::vector<double> delta_v(n, 0.0);
+    std::vector<double> apsis(n);
+    std::vector<long> steps(n, 0);
+    
+    for (std::size_t i = 0; i < n; ++i) {
+        MissionState initial(r_departure, 0, 0, 0, v_circ, 0,
+                             configs[i].spacecraft.initial_mass_kg, 0);
+        batch.setLane(i, initial, configs[i].spacecraft.thrust_mN, configs[i].spacecraft.isp_s);
+        mission[i] = i;
+        coast_radius[i] = configs[i].coast_threshold * r_arrival;
+    }
+    
+    BatchRK4Propagator rk4;
+    std::size_t live = n;
+    
+    while (live > 0) {
+        // Apoapsis (outbound) or periapsis (inbound) for every lane, using the
+        // computeApsides formulas so coast triggers on the same step
+        std::size_t lanes = batch.size();
+        const double* __restrict x = batch.x.data();
+        const double* __restrict y = batch.y.data();
+        const double* __restrict z = batch.z.data();
+        const double* __restrict vx = batch.vx.data();
+        const double* __restrict vy = batch.vy.data();
+        const double* __restrict vz = batch.vz.data();
+        double* __restrict p_apsis = apsis.data();
+        const double sign = thrust_direction > 0 ? 1.0 : -1.0;
+        for (std::size_t i = 0; i < lanes; ++i) {
+            double hx = y[i]*vz[i] - z[i]*vy[i];
+            double hy = z[i]*vx[i] - x[i]*vz[i];
+            double hz = x[i]*vy[i] - y[i]*vx[i];
+            double h_mag = std::sqrt(hx*hx + hy*hy + hz*hz);
+            double r_mag = std::sqrt(x[i]*x[i] + y[i]*y[i] + z[i]*z[i]);
+            double v_mag_sq = vx[i]*vx[i] + vy[i]*vy[i] + vz[i]*vz[i];
+            double energy = v_mag_sq / 2.0 - MU_SUN / r_mag;
+            double a = (std::abs(energy) > 1e-15) ? -MU_SUN / (2.0 * energy) : 1e10;
+            double e_sq = 1.0 - (h_mag * h_mag) / (MU_SUN * a);
+            e_sq = (e_sq < 0) ? 0.0 : e_sq;
+            double e = (a > 0) ? std::sqrt(e_sq) : 2.0;
+            p_apsis[i] = a * (1.0 + sign * e);
+        }
+        
+        // Termination checks, in propagateMission's order
+        for (std::size_t i = 0; i < lanes; ++i) {
+            if (!batch.active[i]) {
+                continue;
+            }
+            
+            bool done = batch.t[i] >= max_flight_time;
+            int coast_step = -1;
+            if (!done) {
+                bool coast_reached = (thrust_direction > 0) ? (apsis[i] >= coast_radius[i])
+                                                            : (apsis[i] <= coast_radius[i]);
+                if (coast_reached) {
+                    coast_step = static_cast<int>(steps[i]);
+                }
+                done = coast_reached || batch.m[i] < 100;
+            }
+            bool pruned = false;
+            if (!done && pruning) {
+                double initial_mass = configs[mission[i]].spacecraft.initial_mass_kg;
+                pruned = pruning->prunes(pruning->score(batch.t[i], delta_v[i], batch.m[i],
+                                                        initial_mass));
+            }
+            
+            if (done || pruned) {
+                PropagationResult& result = results[mission[i]];
+                result.final_state = batch.lane(i);
+                result.total_delta_v = delta_v[i];
+                result.coast_step = coast_step;
+                result.accepted_steps = steps[i];
+                result.pruned = pruned;
+                if (pruning) {
+                    pruning->finish(configs[mission[i]], result);
+                }
+                batch.active[i] = 0;
+                live--;
+            }
+        }
+        
+        if (live == 0) {
+            break;
+        }
+        
+        // Compact once most lanes are masked, so kernels stop paying for them
+        if (live * 2 <= lanes) {
+            std::size_t next = 0;
+            for (std::size_t i = 0; i < lanes; ++i) {
+                if (batch.active[i]) {
+                    batch.moveLane(i, next);
+                    mission[next] = mission[i];
+                    coast_radius[next] = coast_radius[i];
+                    delta_v[next] = delta_v[i];
+                    steps[next] = steps[i];
+                    next++;
+                }
+            }
+            batch.resize(next);
+            lanes = next;
+        }
+        
+        // Delta-V for this step uses the mass before the step
+        for (std::size_t i = 0; i < lanes; ++i) {
+            double thrust = batch.thrust_mN[i];
+            double dv = (thrust * 1e-6) / batch.m[i] * dt;
+            bool counts = batch.active[i] && thrust > 1e-10;
+            delta_v[i] = counts ? delta_v[i] + dv : delta_v[i];
+            steps[i] = batch.active[i] ? steps[i] + 1 : steps[i];
+        }
+        
+        rk4.step(batch, dt, MU_SUN, G0, thrust_direction);
+    }
+    
+    return results;
+}
@@ -0,0 +1,113 @@
+#ifndef BATCH_PROPAGATOR_H
+#define BATCH_PROPAGATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "propagator.h"
+#include "mission_propagation.h"
+
+// ===========================================================================
+// STRUCTURE-OF-ARRAYS BATCH STATE
+// ===========================================================================
+// N spacecraft stored one array per component (x[], y[], ..., m[]) instead
+// of N MissionState structs. Each kernel loop then reads and writes
+// unit-stride arrays, which the compiler turns into SIMD code (SSE2 by
+// default, AVX2/AVX-512 with LTMD_ENABLE_NATIVE_ARCH).
+//
+// Lanes are independent spacecraft that share mu, g0 and the timestep but
+// have their own thrust, ISP and mass. active[i] == 0 masks lane i out of
+// every update: its state is left untouched bit for bit.
+
+struct BatchState {
+    std::vector<double> x, y, z;          // Position (km)
+    std::vector<double> vx, vy, vz;       // Velocity (km/s)
+    std::vector<double> m;                // Mass (kg)
+    std::vector<double> t;                // Time (s)
+    std::vector<double> thrust_mN;        // Per-lane thrust (millinewtons)
+    std::vector<double> isp_s;            // Per-lane specific impulse (seconds)
+    std::vector<std::int64_t> active;     // Lane mask: 1 = propagate, 0 = frozen
+    
+    /// ThrusterPreset value when every lane has exactly that preset's
+    /// thrust and ISP (constant-folded kernels, see BatchRK4Propagator);
+    /// -1 otherwise
+    int preset = -1;
+    
+    std::size_t size() const { return x.size(); }
+    void resize(std::size_t n);
+    
+    /// Load one spacecraft into lane i (lane becomes active)
+    void setLane(std::size_t i, const MissionState& state, double thrust, double isp);
+    
+    /// Copy lane i back out as a MissionState
+    MissionState lane(std::size_t i) const;
+    
+    /// Copy lane from into lane to (both must exist)
+    void moveLane(std::size_t from, std::size_t to);
+};
+
+// ===========================================================================
+// BATCHED RK4 PROPAGATOR
+// ===========================================================================
+// Same RK4 scheme and arithmetic as RK4Propagator, applied to every active
+// lane of a BatchState at once. In the default build lane results match
+// RK4Propagator::step bit for bit; with LTMD_ENABLE_NATIVE_ARCH the
+// compiler may fuse multiply-adds, so they agree to round-off.
+//
+// The stage buffers live in the propagator, so stepping a batch does not
+// allocate once the buffers have grown to the batch size.
+//
+// A batch whose lanes all fly one registry thruster preset (BatchState::
+// preset) around the Sun runs kernels specialized for that preset, with
+// thrust, ISP, mu and g0 as compile-time constants. They use the same
+// arithmetic, so the results do not change, only the number of arrays the
+// kernels stream through.
+
+class BatchRK4Propagator {
+public:
+    /// Advance every active lane by dt
+    void step(BatchState& batch, double dt, double mu, double g0,
+              int thrust_direction = 1);
+
+private:
+    void reserve(std::size_t n);
+    
+    /// step() with thrust, ISP, mu and g0 taken from Model
+    template <class Model>
+    void stepWith(BatchState& batch, double dt, double mu, double g0, int thrust_direction);
+    
+    /// stepWith the constants of preset batch.preset (I walks the registry)
+    template <std::size_t I>
+    void stepPreset(BatchState& batch, double dt, int thrust_direction);
+    
+    // Stage accelerations and intermediate states (one entry per lane)
+    std::vector<double> k1x, k1y, k1z, k2x, k2y, k2z, k3x, k3y, k3z, k4x, k4y, k4z;
+    std::vector<double> sx, sy, sz, svx, svy, svz;          // Stage position/velocity
+    std::vector<double> v2x, v2y, v2z, v3x, v3y, v3z;       // Stage 2/3 velocities
+};
+
+// ===========================================================================
+// BATCH MISSION PROPAGATION
+// ===========================================================================
+
+/// Whether a set of missions can share one BatchState: all must use the
+/// rk4 integrator in double precision with the same timestep,
+/// flight-time limit, pruning bound and batch backend, and none may use
+/// event location, sensitivities or perturbations
+bool canPropagateAsBatch(const std::vector<MissionConfig>& configs);
+
+/// Propagate many missions between the same two orbits
+/// Each lane follows the same loop as propagateMission (coast check, fuel
+/// cutoff, flight-time limit, pruning) and its result matches the
+/// single-mission result. Lanes that finish are masked out and
+/// periodically compacted away. Trajectories are not recorded. Sets that
+/// fail canPropagateAsBatch fall back to propagateMission per config.
+/// config.batch_backend "lanes" or "gpu" runs the set through the lane
+/// backends of gpu_batch_propagator.h instead, with the same results.
+std::vector<PropagationResult> propagateMissionBatch(
+    const std::vector<MissionConfig>& configs,
+    double r_departure,
+    double r_arrival
+);
+
+#endif // BATCH_PROPAGATOR_H
@@ -0,0 +1,240 @@
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "batch_shards.h"
+#include "csv_writer.h"
+
+namespace {
+
+constexpr const char* SHARD_HEADER =
+    "Index,Mission,Thruster,From,To,"
+    "FlightTime(days),DeltaV(km/s),FuelConsumed(kg),FinalMass(kg),InitialMass(kg),"
+    "Apoapsis(km),Periapsis(km),Eccentricity,SemiMajorAxis(km),"
+    "PayloadFraction,EffectiveISP(s),FuelEfficiency(km/s/kg),TransferEfficiency(%),Pruned";
+
+constexpr std::size_t SHARD_FIELDS = 19;
+
+/// The doubles of a row, in column order after the four names
+double MissionResult::* const NUMERIC_FIELDS[] = {
+    &MissionResult::flight_time_days,
+    &MissionResult::total_delta_v_km_s,
+    &MissionResult::propellant_consumed_kg,
+    &MissionResult::final_mass_kg,
+    &MissionResult::initial_mass_kg,
+    &MissionResult::final_apoapsis_km,
+    &MissionResult::final_periapsis_km,
+    &MissionResult::final_eccentricity,
+    &MissionResult::final_semi_major_axis_km,
+    &MissionResult::payload_fraction,
+    &MissionResult::specific_impulse_achieved,
+    &MissionResult::fuel_efficiency,
+    &MissionResult::transfer_efficiency,
+};
+
+/// Shortest text that reads back as the same double
+void appendRoundTrip(std::string& row, double value) {
+    char buffer[32];
+    char* end = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+    row += ',';
+    row.append(buffer, end);
+}
+
+/// The batch a partial file belongs to (its "# shard" line)
+struct ShardFileInfo {
+    unsigned index = 0;
+    unsigned count = 0;
+    std::size_t missions = 0;
+    int pruned = 0;
+};
+
+}  // namespace
+
+// ===========================================================================
+// SHARD ASSIGNMENT
+// ===========================================================================
+
+bool parseShardSpec(const std::string& text, ShardSpec& spec) {
+    unsigned index = 0;
+    unsigned count = 0;
+    char extra = 0;
+    if (std::sscanf(text.c_str(), "%u/%u%c", &index, &count, &extra) != 2 ||
+        index < 1 || index > count) {
+        std::cerr << "Warning: Invalid shard '" << text << "' (expected i/N with 1 <= i <= N)\n";
+        return false;
+    }
+    spec.index = index;
+    spec.count = count;
+    return true;
+}
+
+std::vector<std::size_t> shardMissions(const ShardSpec& spec, std::size_t total) {
+    std::vector<std::size_t> indices;
+    for (std::size_t k = spec.index - 1; k < total; k += spec.count) {
+        indices.push_back(k);
+    }
+    return indices;
+}
+
+std::string shardFileName(const std::string& directory, const ShardSpec& spec) {
+    return directory + "/mission_comparison.shard-" + std::to_string(spec.index) + "-of-" +
+           std::to_string(spec.count) + ".csv";
+}
+
+// ===========================================================================
+// PARTIAL COMPARISON FILES
+// ===========================================================================
+
+std::string formatShardRow(std::size_t index, const MissionResult& mission) {
+    std::string row = std::to_string(index);
+    for (const std::string* name : {&mission.mission_name, &mission.thruster_name,
+                                    &mission.departure_body, &mission.arrival_body}) {
+        row += ',';
+        row += *name;
+    }
+    for (double MissionResult::* field : NUMERIC_FIELDS) {
+        appendRoundTrip(row, mission.*field);
+    }
+    row += mission.pruned ? ",1" : ",0";
+    return row;
+}
+
+bool parseShardRow(const std::string& line, std::size_t& index, MissionResult& mission) {
+    std::vector<std::string> fields;
+    std::stringstream stream(line);
+    std::string field;
+    while (std::getline(stream, field, ',')) {
+        fields.push_back(field);
+    }
+    if (fields.size() != SHARD_FIELDS) {
+        return false;
+    }
+    
+    char* end = nullptr;
+    index = std::strtoull(fields[0].c_str(), &end, 10);
+    if (fields[0].empty() || *end != '\0') {
+        return false;
+    }
+    mission = MissionResult();
+    mission.mission_name = fields[1];
+    mission.thruster_name = fields[2];
+    mission.departure_body = fields[3];
+    mission.arrival_body = fields[4];
+    std::size_t column = 5;
+    for (double MissionResult::* numeric : NUMERIC_FIELDS) {
+        const std::string& text = fields[column++];
+        mission.*numeric = std::strtod(text.c_str(), &end);
+        if (text.empty() || *end != '\0') {
+            return false;
+        }
+    }
+    mission.pruned = fields[column] == "1";
+    return true;
+}
+
+bool writeShardCSV(const std::string& filename, const ShardSpec& spec, std::size_t total,
+                   const std::vector<std::size_t>& indices, const MissionComparison& comparison) {
+    const std::vector<MissionResult>& missions = comparison.getMissions();
+    if (missions.size() != indices.size()) {
+        std::cerr << "Error: Shard has " << missions.size() << " results for "
+                  << indices.size() << " missions\n";
+        return false;
+    }
+    
+    CsvWriter file;
+    if (!file.open(filename)) {
+        return false;
+    }
+    file.write("# shard " + std::to_string(spec.index) + "/" + std::to_string(spec.count) +
+               " missions " + std::to_string(total) + " pruned " +
+               (comparison.isPruned() ? "1" : "0") + "\n");
+    file.write(std::string(SHARD_HEADER) + "\n");
+    for (std::size_t k = 0; k < missions.size(); ++k) {
+        file.write(formatShardRow(indices[k], missions[k]) + "\n");
+    }
+    if (!file.close()) {
+        return false;
+    }
+    std::cout << "Shard results saved to: " << filename << "\n";
+    return true;
+}
+
+bool mergeShards(const std::vector<std::string>& files, MissionComparison& merged) {
+    ShardFileInfo batch;
+    std::vector<MissionResult> missions;
+    std::vector<std::string> source;    // By batch index: file it came from ("" = missing)
+    
+    for (const std::string& filename : files) {
+        std::ifstream file(filename);
+        if (!file.is_open()) {
+            std::cerr << "Error: Cannot open shard file " << filename << "\n";
+            return false;
+        }
+        
+        std::string line;
+        ShardFileInfo info;
+        if (!std::getline(file, line) ||
+            std::sscanf(line.c_str(), "# shard %u/%u missions %zu pruned %d", &info.index,
+                        &info.count, &info.missions, &info.pruned) != 4 ||
+            !std::getline(file, line) || line != SHARD_HEADER) {
+            std::cerr << "Error: " << filename << " is not a shard comparison file\n";
+            return false;
+        }
+        if (source.empty()) {
+            batch = info;
+            missions.resize(info.missions);
+            source.assign(info.missions, "");
+        } else if (info.count != batch.count || info.missions != batch.missions ||
+                   info.pruned != batch.pruned) {
+            std::cerr << "Error: " << filename << " belongs to a different batch ("
+                      << info.missions << " missions in " << info.count << " shards, not "
+                      << batch.missions << " in " << batch.count << ")\n";
+            return false;
+        }
+        
+        long line_number = 2;
+        while (std::getline(file, line)) {
+            line_number++;
+            if (line.empty()) {
+                continue;
+            }
+            std::size_t index = 0;
+            MissionResult mission;
+            if (!parseShardRow(line, index, mission) || index >= batch.missions) {
+                std::cerr << "Error: " << filename << ":" << line_number
+                          << ": malformed shard row\n";
+                return false;
+            }
+            if (!source[index].empty()) {
+                std::cerr << "Error: Mission " << index << " appears in both "
+                          << source[index] << " and " << filename << "\n";
+                return false;
+            }
+            source[index] = filename;
+            missions[index] = mission;
+        }
+    }
+    
+    std::size_t missing = 0;
+    for (std::size_t k = 0; k < source.size(); ++k) {
+        if (source[k].empty()) {
+            if (missing == 0) {
+                std::cerr << "Error: Mission " << k << " is in none of the shard files";
+            }
+            missing++;
+        }
+    }
+    if (missing > 0) {
+        std::cerr << " (" << missing << " of " << batch.missions << " missing)\n";
+        return false;
+    }
+    
+    merged = MissionComparison();
+    for (const MissionResult& mission : missions) {
+        merged.addMission(mission);
+    }
+    merged.setPruned(batch.pruned != 0);
+    return true;
+}
@@ -0,0 +1,80 @@
+#ifndef BATCH_SHARDS_H
+#define BATCH_SHARDS_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "comparison.h"
+
+class MissionBatchRunner;
+
+// ===========================================================================
+// SHARDED BATCHES
+// ===========================================================================
+// A batch file can be split across processes or nodes. With --shard i/N
+// the process runs only missions k with k % N == i - 1. Striding, rather
+// than contiguous blocks, spreads slow missions that sit next to each
+// other in a batch file (same thruster, say) over the shards. The split
+// depends only on the batch file, so every node computes the same split
+// without talking to the others.
+//
+// Each shard writes a partial comparison file (writeShardCSV): its
+// missions with their batch index, every field at round-trip precision.
+// mergeShards (tools/merge_comparison.cpp) rebuilds the batch's
+// MissionComparison from those files alone, without re-reading any
+// trajectory. The merged mission_comparison.csv and summary are then
+// byte-identical to a single-process run.
+//
+// With -DLTMD_ENABLE_MPI=ON, --mpi (batch_mpi.cpp) hands out missions
+// dynamically instead: rank 0 gives the next mission index to whichever
+// rank asks, so ranks that draw short missions simply run more of them.
+
+/// Shard i of count (1 <= index <= count)
+struct ShardSpec {
+    unsigned index = 1;
+    unsigned count = 1;
+};
+
+/// Parse "i/N"; false (with a warning) unless 1 <= i <= N
+bool parseShardSpec(const std::string& text, ShardSpec& spec);
+
+/// Batch indices of the missions shard spec runs, in batch order
+std::vector<std::size_t> shardMissions(const ShardSpec& spec, std::size_t total);
+
+/// "<dir>/mission_comparison.shard-<i>-of-<N>.csv"
+std::string shardFileName(const std::string& directory, const ShardSpec& spec);
+
+/// One partial-file row: batch index, then every MissionResult field
+std::string formatShardRow(std::size_t index, const MissionResult& mission);
+
+/// Parse a formatShardRow line; false if it is malformed
+bool parseShardRow(const std::string& line, std::size_t& index, MissionResult& mission);
+
+/// Write the missions of one shard (indices[k] is the batch index of
+/// comparison's k-th mission) out of a batch of total missions
+bool writeShardCSV(const std::string& filename, const ShardSpec& spec, std::size_t total,
+                   const std::vector<std::size_t>& indices, const MissionComparison& comparison);
+
+/// Combine partial files into the batch's comparison, in batch order
+/// Fails (with a message) if the files disagree on the batch, or if a
+/// mission is missing or appears twice.
+bool mergeShards(const std::vector<std::string>& files, MissionComparison& merged);
+
+/// Whether this build can run --mpi
+bool mpiBatchAvailable();
+
+/// Outcome of runBatchMissionsMpi on this rank
+enum class MpiBatchStatus {
+    COMPLETE,   // Rank 0: comparison holds every mission, in batch order
+    WORKER,     // Other ranks: done, rank 0 reports the batch
+    FAILED      // A result was malformed or missing, or no MPI support
+};
+
+/// Run config_files on every MPI rank with dynamic assignment
+/// Rank 0 fills comparison only when every mission came back intact.
+/// Without MPI support, warns and returns FAILED.
+MpiBatchStatus runBatchMissionsMpi(MissionBatchRunner& runner,
+                                   const std::vector<std::string>& config_files,
+                                   MissionComparison& comparison);
+
+#endif // BATCH_SHARDS_H
@@ -0,0 +1,160 @@
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include "checkpoint.h"
+#include "result_cache.h"
+
+namespace {
+
+template <typename T>
+void writeValue(std::FILE* file, const T& value) {
+    std::fwrite(&value, sizeof(T), 1, file);
+}
+
+template <typename T>
+bool readValue(std::FILE* file, T& value) {
+    return std::fread(&value, sizeof(T), 1, file) == 1;
+}
+
+void writeState(std::FILE* file, const MissionState& state) {
+    std::fwrite(state.r, sizeof(double), 3, file);
+    std::fwrite(state.v, sizeof(double), 3, file);
+    writeValue(file, state.m);
+    writeValue(file, state.t);
+}
+
+bool readState(std::FILE* file, MissionState& state) {
+    return std::fread(state.r, sizeof(double), 3, file) == 3 &&
+           std::fread(state.v, sizeof(double), 3, file) == 3 &&
+           readValue(file, state.m) && readValue(file, state.t);
+}
+
+/// Body of a checkpoint after the magic and version
+bool readBody(std::FILE* file, PropagationCheckpoint& checkpoint) {
+    std::int64_t step = 0, accepted = 0, rejected = 0, averaged = 0;
+    std::uint8_t handed_off = 0;
+    std::uint32_t num_events = 0;
+    if (!readValue(file, checkpoint.config_key) || !readValue(file, step) ||
+        !readState(file, checkpoint.state) ||
+        !readValue(file, checkpoint.total_delta_v) || !readValue(file, checkpoint.dt_next) ||
+        !readValue(file, checkpoint.next_coast_check_t) ||
+        !readValue(file, accepted) || !readValue(file, rejected) ||
+        !readValue(file, handed_off) || !readValue(file, averaged) ||
+        !readValue(file, num_events)) {
+        return false;
+    }
+    checkpoint.step = static_cast<long>(step);
+    checkpoint.accepted_steps = static_cast<long>(accepted);
+    checkpoint.rejected_steps = static_cast<long>(rejected);
+    checkpoint.handed_off = (handed_off != 0);
+    checkpoint.averaged_steps = static_cast<long>(averaged);
+    
+    checkpoint.events.clear();
+    for (std::uint32_t i = 0; i < num_events; i++) {
+        std::uint32_t length = 0;
+        std::uint8_t terminal = 0;
+        MissionEvent event;
+        if (!readValue(file, length) || length > 64) {
+            return false;
+        }
+        event.type.resize(length);
+        if (std::fread(&event.type[0], 1, length, file) != length ||
+            !readValue(file, terminal) || !readState(file, event.state)) {
+            return false;
+        }
+        event.terminal = (terminal != 0);
+        checkpoint.events.push_back(event);
+    }
+    
+    std::uint64_t sink_bytes = 0;
+    if (!readValue(file, sink_bytes) || sink_bytes > (1ull << 32)) {
+        return false;
+    }
+    checkpoint.sink.bytes.resize(static_cast<std::size_t>(sink_bytes));
+    checkpoint.sink.read_offset = 0;
+    return std::fread(checkpoint.sink.bytes.data(), 1, checkpoint.sink.bytes.size(), file) ==
+           checkpoint.sink.bytes.size();
+}
+
+}  // namespace
+
+std::uint64_t checkpointKey(const MissionConfig& config) {
+    return hashMissionConfig(config, "checkpoint");
+}
+
+bool writeCheckpoint(const std::string& filename, const PropagationCheckpoint& checkpoint) {
+    // rename is atomic on POSIX, so an interruption mid-write keeps the
+    // previous checkpoint intact
+    std::string temp_filename = filename + ".tmp";
+    std::FILE* file = std::fopen(temp_filename.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Error: Cannot write checkpoint: " << temp_filename << "\n";
+        return false;
+    }
+    
+    std::fwrite(CHECKPOINT_FILE_MAGIC, 1, sizeof(CHECKPOINT_FILE_MAGIC), file);
+    writeValue(file, CHECKPOINT_FILE_VERSION);
+    writeValue(file, checkpoint.config_key);
+    writeValue(file, static_cast<std::int64_t>(checkpoint.step));
+    writeState(file, checkpoint.state);
+    writeValue(file, checkpoint.total_delta_v);
+    writeValue(file, checkpoint.dt_next);
+    writeValue(file, checkpoint.next_coast_check_t);
+    writeValue(file, static_cast<std::int64_t>(checkpoint.accepted_steps));
+    writeValue(file, static_cast<std::int64_t>(checkpoint.rejected_steps));
+    writeValue(file, static_cast<std::uint8_t>(checkpoint.handed_off ? 1 : 0));
+    writeValue(file, static_cast<std::int64_t>(checkpoint.averaged_steps));
+    
+    writeValue(file, static_cast<std::uint32_t>(checkpoint.events.size()));
+    for (const MissionEvent& event : checkpoint.events) {
+        writeValue(file, static_cast<std::uint32_t>(event.type.size()));
+        std::fwrite(event.type.data(), 1, event.type.size(), file);
+        writeValue(file, static_cast<std::uint8_t>(event.terminal ? 1 : 0));
+        writeState(file, event.state);
+    }
+    
+    writeValue(file, static_cast<std::uint64_t>(checkpoint.sink.bytes.size()));
+    std::fwrite(checkpoint.sink.bytes.data(), 1, checkpoint.sink.bytes.size(), file);
+    
+    bool ok = (std::ferror(file) == 0);
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok || std::rename(temp_filename.c_str(), filename.c_str()) != 0) {
+        std::cerr << "Error: Failed writing checkpoint: " << filename << "\n";
+        std::remove(temp_filename.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool readCheckpoint(const std::string& filename, PropagationCheckpoint& checkpoint) {
+    std::FILE* file = std::fopen(filename.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+    
+    char magic[8];
+    std::uint32_t version = 0;
+    bool valid = std::fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+                 std::memcmp(magic, CHECKPOINT_FILE_MAGIC, sizeof(magic)) == 0 &&
+                 readValue(file, version) && version == CHECKPOINT_FILE_VERSION &&
+                 readBody(file, checkpoint);
+    std::fclose(file);
+    
+    if (!valid) {
+        std::cerr << "Error: Not a valid checkpoint file: " << filename << "\n";
+    }
+    return valid;
+}
+
+bool findCheckpoint(const MissionConfig& config, PropagationCheckpoint& checkpoint) {
+    if (config.checkpoint_file.empty() ||
+        !readCheckpoint(config.checkpoint_file, checkpoint)) {
+        return false;
+    }
+    if (checkpoint.config_key != checkpointKey(config)) {
+        std::cerr << "Warning: Checkpoint " << config.checkpoint_file
+                  << " was written for another configuration; starting from the beginning\n";
+        return false;
+    }
+    return true;
+}
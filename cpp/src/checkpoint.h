@@ -0,0 +1,72 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "propagator.h"
+#include "events.h"
+#include "trajectory_sink.h"
+
+// ===========================================================================
+// PROPAGATION CHECKPOINTS
+// ===========================================================================
+// With config.checkpoint_interval = N and config.checkpoint_file set, the
+// propagation loop saves its complete state every N steps: the mission
+// state, the step counter, accumulated delta-V, the adaptive step proposal
+// and counters, the averaged propagator's handoff flag and step count, the
+// coast-check schedule, the events located so far, and the trajectory sink
+// position (SinkCheckpoint). config.resume continues
+// from that file, so an interrupted run finishes with the same final state
+// and trajectory files, bit for bit, as one that never stopped. The file is
+// removed when the propagation finishes.
+//
+// Layout (native byte order, like the .bin trajectory files):
+//
+//   "LTMDCKP1", u32 version, u64 config key, i64 step, 8 doubles state,
+//   f64 total_delta_v, f64 dt_next, f64 next_coast_check_t,
+//   i64 accepted_steps, i64 rejected_steps, u8 handed_off, i64 averaged_steps,
+//   u32 n_events, n_events x (u32 type length, type, u8 terminal, state),
+//   u64 sink bytes, sink bytes
+//
+// The config key is hashMissionConfig (result_cache.h), so a checkpoint is
+// only resumed by the configuration that wrote it.
+// ===========================================================================
+
+constexpr char CHECKPOINT_FILE_MAGIC[8] = {'L', 'T', 'M', 'D', 'C', 'K', 'P', '1'};
+constexpr std::uint32_t CHECKPOINT_FILE_VERSION = 2;
+
+/// Loop state of a propagation at the start of a step
+struct PropagationCheckpoint {
+    std::uint64_t config_key = 0;
+    long step = 0;
+    MissionState state;
+    double total_delta_v = 0;
+    double dt_next = 0;                 // Next step proposal (adaptive integrators)
+    double next_coast_check_t = 0;      // "bracketed" coast-check schedule
+    long accepted_steps = 0;
+    long rejected_steps = 0;
+    bool handed_off = false;            // Averaged propagator already stepping RK4
+    long averaged_steps = 0;
+    std::vector<MissionEvent> events;   // Non-terminal events located so far
+    SinkCheckpoint sink;
+};
+
+/// Key a checkpoint written for config must carry
+std::uint64_t checkpointKey(const MissionConfig& config);
+
+/// Read config.checkpoint_file if it was written for config
+/// A checkpoint of another configuration is reported and ignored.
+/// @return false if there is no checkpoint to resume from
+bool findCheckpoint(const MissionConfig& config, PropagationCheckpoint& checkpoint);
+
+/// Write a checkpoint atomically (temporary file renamed over filename)
+/// @return false (with a message on std::cerr) if it cannot be written
+bool writeCheckpoint(const std::string& filename, const PropagationCheckpoint& checkpoint);
+
+/// Read a checkpoint
+/// @return false if the file is missing, or (with a message on std::cerr)
+///         damaged or written by another format version
+bool readCheckpoint(const std::string& filename, PropagationCheckpoint& checkpoint);
+
+#endif // CHECKPOINT_H
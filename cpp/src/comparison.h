@@ -3,6 +3,8 @@
 
 #include <string>
 #include <vector>
+#include "instrumentation.h"
+#include "mission_summary.h"
 
 // ===========================================================================
 // MISSION RESULT STRUCTURE
@@ -35,6 +37,13 @@ struct MissionResult {
     double fuel_efficiency;           // delta-V per kg fuel (km/s/kg)
     double transfer_efficiency;       // How close apoapsis is to target (%)
     
+    // Time per phase (empty unless built with LTMD_ENABLE_INSTRUMENTATION)
+    ProfileCounters profile;
+    
+    // Stopped early by --prune (see pruning.h): the outcomes are where the
+    // mission stood, not where it would have ended
+    bool pruned;
+    
     /// Constructor
     MissionResult() : flight_time_days(0), total_delta_v_km_s(0),
                       propellant_consumed_kg(0), final_mass_kg(0),
@@ -42,9 +51,20 @@ struct MissionResult {
                       final_periapsis_km(0), final_eccentricity(0),
                       final_semi_major_axis_km(0), payload_fraction(0),
                       specific_impulse_achieved(0), fuel_efficiency(0),
-                      transfer_efficiency(0) {}
+                      transfer_efficiency(0), pruned(false) {}
 };
 
+/// Fill the derived metrics of one mission (payload fraction, efficiencies)
+void computeMissionMetrics(MissionResult& mission);
+
+/// Metrics understood by findBestMission: shortest_time, lowest_delta_v,
+/// least_fuel, most_efficient
+bool isMissionMetric(const std::string& metric);
+
+/// Score findBestMission minimizes for metric (most_efficient negates the
+/// payload fraction, so lower is always better)
+double missionMetricScore(const MissionResult& mission, const std::string& metric);
+
 // ===========================================================================
 // COMPARISON ENGINE
 // ===========================================================================
@@ -54,18 +74,36 @@ public:
     /// Add a mission result for comparison
     void addMission(const MissionResult& result);
     
+    /// Pre-size the result table to hold count missions
+    /// Used by parallel batches so each worker can fill its own slot.
+    void resizeMissions(size_t count);
+    
+    /// Store a result in a pre-sized slot
+    /// Safe to call concurrently as long as each index is set exactly once.
+    void setMission(size_t index, const MissionResult& result);
+    
     /// Compute derived metrics (payload fraction, efficiency, etc)
     void computeMetrics();
     
+    /// Results come from a pruned run: the CSV gets a Pruned column, and
+    /// the summary leaves pruned missions out of its averages and minima
+    void setPruned(bool enabled) { pruned_run = enabled; }
+    bool isPruned() const { return pruned_run; }
+    
     /// Write all results to CSV file
     void writeComparisonCSV(const std::string& filename);
     
     /// Write summary statistics to console
+    /// The per-group figures come from a MissionSummary updated by
+    /// addMission and setMission (mission_summary.h), not from the table.
     void printSummary();
     
     /// Find best mission by metric (e.g., "shortest_time", "most_fuel_efficient")
     MissionResult findBestMission(const std::string& metric);
     
+    /// All results, in the order they were added
+    const std::vector<MissionResult>& getMissions() const { return missions; }
+    
     /// Get all results for a specific thruster type
     std::vector<MissionResult> getMissionsByThruster(const std::string& thruster);
     
@@ -74,6 +112,8 @@ public:
     
 private:
     std::vector<MissionResult> missions;
+    MissionSummary summary;
+    bool pruned_run = false;
 };
 
 #endif // COMPARISON_H
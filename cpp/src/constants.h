@@ -1,6 +1,7 @@
 #ifndef CONSTANTS_H
 #define CONSTANTS_H
 
+#include <cstddef>
 #include <string>
 
 // ===========================================================================
@@ -51,54 +52,129 @@ enum class CelestialBody {
     PLUTO = 8
 };
 
+// ===========================================================================
+// BODY AND THRUSTER REGISTRIES
+// ===========================================================================
+// One constexpr table per kind, so a body or thruster is added by adding
+// one row (and, for a body, its enum value). Lookups by enum are constant
+// expressions; name lookups are only needed while reading config files.
+
+struct BodyInfo {
+    CelestialBody body;
+    const char* name;               // Display and config name ("Mars")
+    const char* lower_name;         // Also accepted in config files ("mars")
+    double orbital_radius_km;       // Heliocentric circular-orbit radius
+    double transfer_target_km;      // Apoapsis target of the comparison table (0 = none)
+    double mu_km3_s2;               // Gravitational parameter of the system (planet + moons)
+};
+
+/// Indexed by CelestialBody value
+constexpr BodyInfo BODIES[] = {
+    {CelestialBody::MERCURY, "Mercury", "mercury", R_MERCURY, 0,       2.2031868551e4},
+    {CelestialBody::VENUS,   "Venus",   "venus",   R_VENUS,   1.082e8, 3.24858592e5},
+    {CelestialBody::EARTH,   "Earth",   "earth",   R_EARTH,   0,       4.03503235502e5},
+    {CelestialBody::MARS,    "Mars",    "mars",    R_MARS,    2.279e8, 4.2828375214e4},
+    {CelestialBody::JUPITER, "Jupiter", "jupiter", R_JUPITER, 7.785e8, 1.267127641e8},
+    {CelestialBody::SATURN,  "Saturn",  "saturn",  R_SATURN,  0,       3.79405848418e7},
+    {CelestialBody::URANUS,  "Uranus",  "uranus",  R_URANUS,  0,       5.7945564e6},
+    {CelestialBody::NEPTUNE, "Neptune", "neptune", R_NEPTUNE, 0,       6.8365271005e6},
+    {CelestialBody::PLUTO,   "Pluto",   "pluto",   R_PLUTO,   0,       9.755e2},
+};
+constexpr std::size_t BODY_COUNT = sizeof(BODIES) / sizeof(BODIES[0]);
+
+/// Named thruster presets (spacecraft.name in config files)
+enum class ThrusterPreset {
+    LOW_POWER_HALL = 0,
+    HIGH_POWER_HALL = 1,
+    LOW_POWER_ION = 2,
+    HIGH_POWER_ION = 3
+};
+
+struct ThrusterInfo {
+    ThrusterPreset preset;
+    const char* name;
+    double thrust_mN;
+    double isp_s;
+};
+
+/// Indexed by ThrusterPreset value
+constexpr ThrusterInfo THRUSTERS[] = {
+    {ThrusterPreset::LOW_POWER_HALL,  "Low-Power Hall",  60,   1500},
+    {ThrusterPreset::HIGH_POWER_HALL, "High-Power Hall", 1000, 2750},
+    {ThrusterPreset::LOW_POWER_ION,   "Low-Power Ion",   250,  4000},
+    {ThrusterPreset::HIGH_POWER_ION,  "High-Power Ion",  450,  9000},
+};
+constexpr std::size_t THRUSTER_COUNT = sizeof(THRUSTERS) / sizeof(THRUSTERS[0]);
+
+constexpr bool registriesInEnumOrder() {
+    for (std::size_t i = 0; i < BODY_COUNT; i++) {
+        if (static_cast<std::size_t>(BODIES[i].body) != i) {
+            return false;
+        }
+    }
+    for (std::size_t i = 0; i < THRUSTER_COUNT; i++) {
+        if (static_cast<std::size_t>(THRUSTERS[i].preset) != i) {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(registriesInEnumOrder(), "registry rows must follow their enum order");
+
 // ===========================================================================
 // HELPER FUNCTIONS
 // ===========================================================================
 
+/// Registry row of a body (Earth for an out-of-range value)
+constexpr const BodyInfo& getBodyInfo(CelestialBody body) {
+    std::size_t index = static_cast<std::size_t>(body);
+    return BODIES[index < BODY_COUNT ? index : static_cast<std::size_t>(CelestialBody::EARTH)];
+}
+
 /// Convert enum to orbital radius (km)
-inline double getOrbitalRadius(CelestialBody body) {
-    switch (body) {
-        case CelestialBody::MERCURY:  return R_MERCURY;
-        case CelestialBody::VENUS:    return R_VENUS;
-        case CelestialBody::EARTH:    return R_EARTH;
-        case CelestialBody::MARS:     return R_MARS;
-        case CelestialBody::JUPITER:  return R_JUPITER;
-        case CelestialBody::SATURN:   return R_SATURN;
-        case CelestialBody::URANUS:   return R_URANUS;
-        case CelestialBody::NEPTUNE:  return R_NEPTUNE;
-        case CelestialBody::PLUTO:    return R_PLUTO;
-        default:                      return R_EARTH;
-    }
+constexpr double getOrbitalRadius(CelestialBody body) {
+    return getBodyInfo(body).orbital_radius_km;
 }
 
 /// Convert enum to body name (for printing)
-inline const char* getBodyName(CelestialBody body) {
-    switch (body) {
-        case CelestialBody::MERCURY:  return "Mercury";
-        case CelestialBody::VENUS:    return "Venus";
-        case CelestialBody::EARTH:    return "Earth";
-        case CelestialBody::MARS:     return "Mars";
-        case CelestialBody::JUPITER:  return "Jupiter";
-        case CelestialBody::SATURN:   return "Saturn";
-        case CelestialBody::URANUS:   return "Uranus";
-        case CelestialBody::NEPTUNE:  return "Neptune";
-        case CelestialBody::PLUTO:    return "Pluto";
-        default:                      return "Unknown";
+constexpr const char* getBodyName(CelestialBody body) {
+    return static_cast<std::size_t>(body) < BODY_COUNT ? getBodyInfo(body).name : "Unknown";
+}
+
+/// Registry row of a thruster preset
+constexpr const ThrusterInfo& getThrusterInfo(ThrusterPreset preset) {
+    return THRUSTERS[static_cast<std::size_t>(preset)];
+}
+
+/// Look up a body by name ("Mars" or "mars")
+/// @return false (body unchanged) if the name is unknown
+inline bool findBodyByName(const std::string& name, CelestialBody& body) {
+    for (const BodyInfo& info : BODIES) {
+        if (name == info.name || name == info.lower_name) {
+            body = info.body;
+            return true;
+        }
     }
+    return false;
 }
 
-/// Parse body name from string (case-insensitive)
+/// Parse body name from string ("Mars" or "mars"; Earth if unknown)
 inline CelestialBody parseBodyName(const std::string& name) {
-    if (name == "Mercury" || name == "mercury")   return CelestialBody::MERCURY;
-    if (name == "Venus" || name == "venus")       return CelestialBody::VENUS;
-    if (name == "Earth" || name == "earth")       return CelestialBody::EARTH;
-    if (name == "Mars" || name == "mars")         return CelestialBody::MARS;
-    if (name == "Jupiter" || name == "jupiter")   return CelestialBody::JUPITER;
-    if (name == "Saturn" || name == "saturn")     return CelestialBody::SATURN;
-    if (name == "Uranus" || name == "uranus")     return CelestialBody::URANUS;
-    if (name == "Neptune" || name == "neptune")   return CelestialBody::NEPTUNE;
-    if (name == "Pluto" || name == "pluto")       return CelestialBody::PLUTO;
-    return CelestialBody::EARTH;  // default
+    CelestialBody body = CelestialBody::EARTH;
+    findBodyByName(name, body);
+    return body;
+}
+
+/// Look up a thruster preset by name
+/// @return false (preset unchanged) if the name is unknown
+inline bool findThrusterByName(const std::string& name, ThrusterPreset& preset) {
+    for (const ThrusterInfo& info : THRUSTERS) {
+        if (name == info.name) {
+            preset = info.preset;
+            return true;
+        }
+    }
+    return false;
 }
 
 #endif // CONSTANTS_H
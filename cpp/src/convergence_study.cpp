@@ -0,0 +1,239 @@
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <yaml-cpp/yaml.h>
+#include "convergence_study.h"
+#include "mission_propagation.h"
+#include "thread_pool.h"
+#include "csv_writer.h"
+
+// Defined in mission_batch.cpp
+MissionConfig loadConfigFromYAML(const std::string& filename);
+
+namespace {
+
+/// Search interval for the observed order
+constexpr double MAX_ORDER = 16;
+constexpr int ORDER_BISECTIONS = 100;
+
+/// (h1^p - h2^p) / (h2^p - h3^p) for h scaled by h3, increasing in p
+double differenceRatio(double s1, double s2, double p) {
+    return (std::pow(s1, p) - std::pow(s2, p)) / (std::pow(s2, p) - 1.0);
+}
+
+/// The final values of one run, in CONVERGENCE_COLUMNS order
+ConvergenceRun propagateRun(const MissionConfig& config, double r_departure, double r_arrival) {
+    NullTrajectorySink sink;
+    PropagationResult result = propagateMission(config, r_departure, r_arrival, sink);
+    OrbitalElements elements = computeOrbitalElements(result.final_state.r,
+                                                      result.final_state.v, MU_SUN);
+    ConvergenceRun run;
+    run.timestep_s = config.timestep_s;
+    run.steps = result.accepted_steps;
+    run.coasted = result.coast_step >= 0;
+    run.values = {result.final_state.t / 86400.0, result.total_delta_v, result.final_state.m,
+                  elements.a, elements.e, elements.r_p, elements.r_a};
+    return run;
+}
+
+}  // namespace
+
+// ===========================================================================
+// ORDER AND EXTRAPOLATION
+// ===========================================================================
+
+double observedOrder(const double h[3], const double f[3]) {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    double coarse = f[0] - f[1];
+    double fine = f[1] - f[2];
+    if (coarse == 0 || fine == 0 || (coarse > 0) != (fine > 0) ||
+        !(h[0] > h[1] && h[1] > h[2] && h[2] > 0)) {
+        return nan;
+    }
+    
+    // The ratio of successive differences fixes p; bisect for it
+    double target = coarse / fine;
+    double s1 = h[0] / h[2];
+    double s2 = h[1] / h[2];
+    double low = 0;
+    double high = MAX_ORDER;
+    double low_ratio = std::log(s1 / s2) / std::log(s2);   // Limit as p -> 0
+    if (!(target > low_ratio && target < differenceRatio(s1, s2, high))) {
+        return nan;
+    }
+    for (int i = 0; i < ORDER_BISECTIONS; i++) {
+        double mid = 0.5 * (low + high);
+        if (differenceRatio(s1, s2, mid) < target) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+    return 0.5 * (low + high);
+}
+
+double richardsonExtrapolate(double h_coarse, double f_coarse, double h_fine, double f_fine,
+                             double order) {
+    if (std::isnan(order)) {
+        return f_fine;
+    }
+    return f_fine + (f_fine - f_coarse) / (std::pow(h_coarse / h_fine, order) - 1.0);
+}
+
+// ===========================================================================
+// SPEC FILE LOADER
+// ===========================================================================
+
+bool loadConvergenceFromYAML(const std::string& filename, ConvergenceSpec& spec) {
+    try {
+        YAML::Node yaml = YAML::LoadFile(filename);
+        
+        // The mission itself uses the mission file sections and loader
+        spec.base = loadConfigFromYAML(filename);
+        
+        if (YAML::Node study = yaml["convergence"]) {
+            if (study["timesteps"]) {
+                spec.timesteps = study["timesteps"].as<std::vector<double>>();
+            }
+            if (study["methods"]) {
+                spec.methods = study["methods"].as<std::vector<std::string>>();
+            }
+            if (study["output"]) {
+                spec.output_filename = study["output"].as<std::string>();
+            }
+        }
+    } catch (const YAML::Exception& e) {
+        std::cerr << "Error loading convergence file: " << e.what() << std::endl;
+        return false;
+    }
+    
+    std::sort(spec.timesteps.begin(), spec.timesteps.end(), std::greater<double>());
+    spec.timesteps.erase(std::unique(spec.timesteps.begin(), spec.timesteps.end()),
+                         spec.timesteps.end());
+    if (spec.timesteps.size() < 3 || !(spec.timesteps.back() > 0)) {
+        std::cerr << "Error: convergence needs at least three distinct positive timesteps\n";
+        return false;
+    }
+    for (const std::string& method : spec.methods) {
+        if (method != "rk4" && method != "euler") {
+            std::cerr << "Error: convergence method '" << method
+                      << "' is not a fixed-step integrator (rk4, euler)\n";
+            return false;
+        }
+    }
+    if (spec.methods.empty()) {
+        std::cerr << "Error: convergence needs at least one method\n";
+        return false;
+    }
+    return true;
+}
+
+// ===========================================================================
+// EXECUTION
+// ===========================================================================
+
+ConvergenceResult runConvergenceStudy(const ConvergenceSpec& spec, unsigned jobs) {
+    ConvergenceResult result;
+    std::size_t levels = spec.timesteps.size();
+    for (const std::string& method : spec.methods) {
+        MethodConvergence convergence;
+        convergence.method = method;
+        convergence.runs.resize(levels);
+        result.methods.push_back(convergence);
+    }
+    
+    // Only the final state is wanted: no files, checkpoints or pruning
+    MissionConfig base = spec.base;
+    base.checkpoint_interval = 0;
+    base.checkpoint_file.clear();
+    base.resume = false;
+    base.pruning = nullptr;
+    double r_departure = getOrbitalRadius(base.departure_body);
+    double r_arrival = getOrbitalRadius(base.arrival_body);
+    
+    // Every (method, timestep) run is one task; each writes its own slot
+    std::size_t tasks = spec.methods.size() * levels;
+    auto run_task = [&](std::size_t task) {
+        MissionConfig config = base;
+        config.integrator = spec.methods[task / levels];
+        config.timestep_s = spec.timesteps[task % levels];
+        result.methods[task / levels].runs[task % levels] =
+            propagateRun(config, r_departure, r_arrival);
+    };
+    unsigned num_threads = ThreadPool::resolveThreadCount(jobs);
+    if (num_threads > tasks) {
+        num_threads = static_cast<unsigned>(tasks);
+    }
+    if (num_threads > 1) {
+        ThreadPool pool(num_threads);
+        pool.parallelFor(tasks, run_task);
+    } else {
+        for (std::size_t task = 0; task < tasks; task++) {
+            run_task(task);
+        }
+    }
+    
+    // Orders and references from the three finest runs
+    if (levels < 3) {
+        return result;  // Runs only; loadConvergenceFromYAML asks for three
+    }
+    for (MethodConvergence& convergence : result.methods) {
+        const ConvergenceRun* finest = &convergence.runs[levels - 3];
+        double h[3] = {finest[0].timestep_s, finest[1].timestep_s, finest[2].timestep_s};
+        for (std::size_t q = 0; q < CONVERGENCE_QUANTITIES; q++) {
+            double f[3] = {finest[0].values[q], finest[1].values[q], finest[2].values[q]};
+            convergence.order[q] = observedOrder(h, f);
+            convergence.extrapolated[q] = richardsonExtrapolate(h[1], f[1], h[2], f[2],
+                                                                convergence.order[q]);
+        }
+    }
+    return result;
+}
+
+// ===========================================================================
+// RESULTS TABLE OUTPUT
+// ===========================================================================
+
+bool writeConvergenceCSV(const std::string& filename, const ConvergenceResult& result) {
+    CsvWriter file;
+    if (!file.open(filename)) {
+        return false;
+    }
+    
+    file.write("Method,Kind,Timestep(s),Steps,Coasted");
+    for (const char* column : CONVERGENCE_COLUMNS) {
+        file.write(std::string(",") + column);
+    }
+    file.write("\n");
+    
+    for (const MethodConvergence& convergence : result.methods) {
+        for (const ConvergenceRun& run : convergence.runs) {
+            file.text(convergence.method);
+            file.text("run");
+            file.general(run.timestep_s, 10);
+            file.integer(run.steps);
+            file.integer(run.coasted ? 1 : 0);
+            for (double value : run.values) {
+                file.general(value, 15);
+            }
+            file.endRow();
+        }
+        for (const char* kind : {"order", "extrapolated"}) {
+            bool order = kind[0] == 'o';
+            file.text(convergence.method);
+            file.text(kind);
+            file.text("");
+            file.text("");
+            file.text("");
+            for (std::size_t q = 0; q < CONVERGENCE_QUANTITIES; q++) {
+                file.general(order ? convergence.order[q] : convergence.extrapolated[q],
+                             order ? 4 : 15);
+            }
+            file.endRow();
+        }
+    }
+    
+    return file.close();
+}
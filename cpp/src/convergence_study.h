@@ -0,0 +1,101 @@
+#ifndef CONVERGENCE_STUDY_H
+#define CONVERGENCE_STUDY_H
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "propagator.h"
+
+// ===========================================================================
+// TIMESTEP CONVERGENCE STUDY
+// ===========================================================================
+// Propagates one mission with every fixed-step method at every timestep of
+// a ladder, in parallel and inside one process. The mission file is parsed
+// once and no trajectory is written: only the final values of each run are
+// kept.
+//
+// For each method and quantity, the three finest timesteps h1 > h2 > h3
+// give the observed order p of f(h) = f* + C h^p, and the two finest give
+// the Richardson-extrapolated reference
+//
+//   f* = f3 + (f3 - f2) / ((h2 / h3)^p - 1)
+//
+// The ladder need not have a constant ratio. When the differences do not
+// shrink monotonically (round-off, or a quantity that no longer changes),
+// p is NaN and the reference is the finest run.
+//
+// The order measured is that of the whole propagation, not of the
+// integrator alone. The coast check ends a run on a step boundary unless
+// the mission locates the coast (events.locate_coast). The RK4 stages
+// hold the mass at its step-start value, and delta-V is summed per step.
+// On thrust arcs rk4 therefore converges at first order too, with an
+// error about a hundred times smaller than Euler's.
+//
+// Spec file format: any mission file, with an optional section
+//
+//   convergence:
+//     timesteps: [10000, 5000, 2000, 1000]    # s, at least three
+//     methods: [rk4, euler]                   # fixed-step integrators
+//     output: convergence_study.csv
+// ===========================================================================
+
+/// Quantities compared across the ladder, in CSV column order
+constexpr std::size_t CONVERGENCE_QUANTITIES = 7;
+constexpr const char* CONVERGENCE_COLUMNS[CONVERGENCE_QUANTITIES] = {
+    "FlightTime(days)", "DeltaV(km/s)", "FinalMass(kg)", "SemiMajorAxis(km)",
+    "Eccentricity", "Periapsis(km)", "Apoapsis(km)"};
+
+using ConvergenceValues = std::array<double, CONVERGENCE_QUANTITIES>;
+
+struct ConvergenceSpec {
+    MissionConfig base;                                      // Mission to propagate
+    std::vector<double> timesteps = {10000, 5000, 2000, 1000};   // Coarse to fine (s)
+    std::vector<std::string> methods = {"rk4", "euler"};
+    std::string output_filename = "convergence_study.csv";
+};
+
+/// Final values of one method at one timestep
+struct ConvergenceRun {
+    double timestep_s = 0;
+    long steps = 0;
+    bool coasted = false;
+    ConvergenceValues values{};
+};
+
+struct MethodConvergence {
+    std::string method;
+    std::vector<ConvergenceRun> runs;          // Coarse to fine, as spec.timesteps
+    ConvergenceValues order{};                 // Observed order (NaN = undefined)
+    ConvergenceValues extrapolated{};          // Richardson reference
+};
+
+struct ConvergenceResult {
+    std::vector<MethodConvergence> methods;    // As spec.methods
+};
+
+/// Observed order p of f(h) = f* + C h^p through (h[k], f[k]), h[0] > h[1] > h[2]
+/// NaN unless f[0] - f[1] and f[1] - f[2] are nonzero with the same sign
+/// and p lies in (0, 16).
+double observedOrder(const double h[3], const double f[3]);
+
+/// f* from a coarse and a fine run with order p (NaN p: the fine value)
+double richardsonExtrapolate(double h_coarse, double f_coarse, double h_fine, double f_fine,
+                             double order);
+
+/// Load a mission file and its optional convergence section
+/// @return false (with a message on std::cerr) if the file cannot be read,
+///         there are fewer than three distinct timesteps, or a method is
+///         not fixed-step (rk4, euler)
+bool loadConvergenceFromYAML(const std::string& filename, ConvergenceSpec& spec);
+
+/// Propagate every method at every timestep and estimate orders
+/// jobs as for --jobs (0 = one per hardware thread). Results do not
+/// depend on jobs.
+ConvergenceResult runConvergenceStudy(const ConvergenceSpec& spec, unsigned jobs = 0);
+
+/// Per method: one "run" row per timestep, then "order" and "extrapolated"
+/// @return false if the file cannot be opened
+bool writeConvergenceCSV(const std::string& filename, const ConvergenceResult& result);
+
+#endif // CONVERGENCE_STUDY_H
@@ -0,0 +1,201 @@
+#include <iostream>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include "csv_writer.h"
+
+CsvWriter::CsvWriter(std::size_t buffer_bytes, bool background_flush)
+    : buffer(std::max(buffer_bytes, 2 * MAX_FIELD_CHARS)), background(background_flush) {
+    if (background) {
+        in_flight.resize(buffer.size());
+        writer = std::thread(&CsvWriter::writerLoop, this);
+    }
+}
+
+CsvWriter::~CsvWriter() {
+    close();
+    if (background) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        cv.notify_all();
+        writer.join();
+    }
+}
+
+bool CsvWriter::open(const std::string& filename, CsvOpenMode mode) {
+    close();
+    this->filename = filename;
+    used = 0;
+    file_offset = 0;
+    row_started = false;
+    failed = false;
+    
+    // Existing rows are kept for APPEND, so the file must already exist
+    file = std::fopen(filename.c_str(), mode == CsvOpenMode::APPEND ? "r+b" : "wb");
+    if (!file) {
+        std::cerr << "Error: Cannot open output file: " << filename << "\n";
+        return false;
+    }
+    std::setvbuf(file, nullptr, _IONBF, 0);  // Rows are already buffered here
+    if (mode == CsvOpenMode::APPEND) {
+        if (std::fseek(file, 0, SEEK_END) != 0) {
+            failed = true;
+        }
+        file_offset = static_cast<std::int64_t>(std::ftell(file));
+    }
+    return true;
+}
+
+// ===========================================================================
+// FIELD FORMATTING
+// ===========================================================================
+
+void CsvWriter::write(const std::string& text) {
+    write(text.data(), text.size());
+}
+
+void CsvWriter::write(const char* text, std::size_t length) {
+    while (length > 0) {
+        if (used == buffer.size()) {
+            handOff();
+        }
+        std::size_t chunk = std::min(length, buffer.size() - used);
+        std::memcpy(buffer.data() + used, text, chunk);
+        used += chunk;
+        text += chunk;
+        length -= chunk;
+    }
+}
+
+void CsvWriter::beginField() {
+    reserve(MAX_FIELD_CHARS);
+    if (row_started) {
+        buffer[used++] = ',';
+    }
+    row_started = true;
+}
+
+void CsvWriter::reserve(std::size_t length) {
+    if (buffer.size() - used < length) {
+        handOff();
+    }
+}
+
+void CsvWriter::text(const std::string& value) {
+    beginField();
+    write(value);
+}
+
+void CsvWriter::integer(long long value) {
+    beginField();
+    char* end = buffer.data() + buffer.size();
+    used = std::to_chars(buffer.data() + used, end, value).ptr - buffer.data();
+}
+
+void CsvWriter::fixed(double value, int precision) {
+    beginField();
+    char* end = buffer.data() + buffer.size();
+    std::to_chars_result result = std::to_chars(buffer.data() + used, end, value,
+                                                std::chars_format::fixed, precision);
+    if (result.ec == std::errc()) {
+        used = result.ptr - buffer.data();
+    } else {
+        // Only a precision far beyond the CSV formats can get here
+        char text[MAX_FIELD_CHARS];
+        int length = std::snprintf(text, sizeof(text), "%.*f", precision, value);
+        if (length > 0) {
+            write(text, std::min(static_cast<std::size_t>(length), sizeof(text) - 1));
+        }
+    }
+}
+
+void CsvWriter::scientific(double value, int precision) {
+    beginField();
+    char* end = buffer.data() + buffer.size();
+    used = std::to_chars(buffer.data() + used, end, value,
+                         std::chars_format::scientific, precision).ptr - buffer.data();
+}
+
+void CsvWriter::general(double value, int precision) {
+    beginField();
+    char* end = buffer.data() + buffer.size();
+    used = std::to_chars(buffer.data() + used, end, value,
+                         std::chars_format::general, precision).ptr - buffer.data();
+}
+
+void CsvWriter::endRow() {
+    reserve(1);
+    buffer[used++] = '\n';
+    row_started = false;
+}
+
+// ===========================================================================
+// FILE OUTPUT
+// ===========================================================================
+
+void CsvWriter::handOff() {
+    if (used == 0) {
+        return;
+    }
+    if (!file) {
+        used = 0;  // Nothing to write to; the error was reported by open()
+        return;
+    }
+    
+    if (!background) {
+        failed = failed || std::fwrite(buffer.data(), 1, used, file) != used;
+    } else {
+        // Swap in the idle buffer and let the writer thread take this one
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this] { return in_flight_used == 0; });
+        std::swap(buffer, in_flight);
+        in_flight_used = used;
+        lock.unlock();
+        cv.notify_all();
+    }
+    file_offset += static_cast<std::int64_t>(used);
+    used = 0;
+}
+
+void CsvWriter::writerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        cv.wait(lock, [this] { return in_flight_used > 0 || stopping; });
+        if (in_flight_used == 0) {
+            return;  // Stopping with nothing left to write
+        }
+        std::size_t length = in_flight_used;
+        lock.unlock();
+        bool ok = std::fwrite(in_flight.data(), 1, length, file) == length;
+        lock.lock();
+        failed = failed || !ok;
+        in_flight_used = 0;
+        cv.notify_all();
+    }
+}
+
+bool CsvWriter::flush() {
+    if (!file) {
+        return false;
+    }
+    handOff();
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [this] { return in_flight_used == 0; });
+    failed = failed || std::fflush(file) != 0;
+    return !failed;
+}
+
+bool CsvWriter::close() {
+    if (!file) {
+        return true;
+    }
+    bool ok = flush();
+    ok = (std::fclose(file) == 0) && ok;
+    file = nullptr;
+    if (!ok) {
+        std::cerr << "Error: Failed writing output file: " << filename << "\n";
+    }
+    return ok;
+}
@@ -0,0 +1,107 @@
+#ifndef CSV_WRITER_H
+#define CSV_WRITER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ===========================================================================
+// BUFFERED CSV WRITER
+// ===========================================================================
+// Fixed-format CSV output without iostreams. Numbers are formatted with
+// std::to_chars straight into a large write buffer, which produces exactly
+// the characters printf (and so std::ostream) gives for the same format:
+//
+//   fixed(x, 2)          == file << std::fixed << std::setprecision(2) << x
+//   scientific(x, 6)     == file << std::scientific << std::setprecision(6) << x
+//   general(x, 10)       == file << std::defaultfloat << std::setprecision(10) << x
+//
+// Fields are comma-separated automatically; endRow() ends the line.
+//
+// The buffer is written out only when full, on flush() and on close().
+// With background flushing, a full buffer is handed to a writer thread
+// and formatting carries on in a second buffer, so file I/O overlaps
+// with the propagation.
+// ===========================================================================
+
+enum class CsvOpenMode {
+    CREATE,   // Truncate or create the file
+    APPEND    // Keep existing contents, write at the end
+};
+
+class CsvWriter {
+public:
+    static constexpr std::size_t DEFAULT_BUFFER_BYTES = 1 << 20;
+    
+    explicit CsvWriter(std::size_t buffer_bytes = DEFAULT_BUFFER_BYTES,
+                       bool background_flush = false);
+    
+    /// Flushes and closes the file
+    ~CsvWriter();
+    
+    CsvWriter(const CsvWriter&) = delete;
+    CsvWriter& operator=(const CsvWriter&) = delete;
+    
+    /// Open a file for writing, closing any previous one
+    /// @return false (with a message on std::cerr) if it cannot be opened
+    bool open(const std::string& filename, CsvOpenMode mode = CsvOpenMode::CREATE);
+    
+    bool isOpen() const { return file != nullptr; }
+    
+    /// Raw text (header lines, pre-formatted rows); no separator added
+    void write(const std::string& text);
+    void write(const char* text, std::size_t length);
+    
+    /// One field each; a comma is written before every field but the first of a row
+    void text(const std::string& value);
+    void integer(long long value);
+    void fixed(double value, int precision);
+    void scientific(double value, int precision);
+    void general(double value, int precision);
+    
+    void endRow();
+    
+    /// Write all buffered rows to the file (waits for a background flush)
+    /// @return false if any write so far has failed
+    bool flush();
+    
+    /// Bytes in the file once everything buffered is written
+    std::int64_t position() const { return file_offset + static_cast<std::int64_t>(used); }
+    
+    /// Flush and close
+    /// @return false (with a message on std::cerr) if any write failed
+    bool close();
+
+private:
+    /// Room for the longest number we format (fixed 1e308 has 309 digits)
+    static constexpr std::size_t MAX_FIELD_CHARS = 400;
+    
+    void beginField();
+    void reserve(std::size_t length);
+    void handOff();
+    void writerLoop();
+    
+    std::FILE* file = nullptr;
+    std::string filename;
+    std::vector<char> buffer;
+    std::size_t used = 0;
+    std::int64_t file_offset = 0;   // Bytes already handed to the file
+    bool row_started = false;
+    bool failed = false;              // Guarded by mutex with background flushing
+    
+    // Background flushing: one buffer in flight while `buffer` fills
+    bool background;
+    std::thread writer;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<char> in_flight;
+    std::size_t in_flight_used = 0;   // Guarded by mutex; 0 = writer idle
+    bool stopping = false;            // Guarded by mutex
+};
+
+#endif // CSV_WRITER_H
@@ -98,16 +98,21 @@ void computeThrustAccel(const double v[3], double m, double thrust_mN,
 
 void computeAcceleration(const MissionState& state, double thrust_mN, 
                         double mu, double a[3], int thrust_direction) {
+    computeAcceleration(state.r, state.v, state.m, thrust_mN, mu, a, thrust_direction);
+}
+
+void computeAcceleration(const double r[3], const double v[3], double m,
+                        double thrust_mN, double mu, double a[3], int thrust_direction) {
     // Step 1: Compute gravitational acceleration
     // This includes both the magnitude and direction of gravity
     double a_grav[3];
-    computeGravityAccel(state.r, mu, a_grav);
+    computeGravityAccel(r, mu, a_grav);
     
     // Step 2: Compute thrust acceleration
     // This is zero during coast phase (thrust_mN = 0)
     // thrust_direction: +1 for prograde (outward), -1 for retrograde (inward)
     double a_thrust[3];
-    computeThrustAccel(state.v, state.m, thrust_mN, a_thrust, thrust_direction);
+    computeThrustAccel(v, m, thrust_mN, a_thrust, thrust_direction);
     
     // Step 3: Combine into total acceleration
     // Newton's second law allows acceleration components to be added vectorially
@@ -119,3 +124,80 @@ void computeAcceleration(const MissionState& state, double thrust_mN,
     // Result: a = a_gravity + a_thrust (vector sum)
     //        This is what RK4/Euler integrates to update velocity/position
 }
+
+
+// ===========================================================================
+// ACCELERATION PARTIALS IMPLEMENTATION
+// ===========================================================================
+
+void computeAccelerationPartials(const double r[3], const double v[3], double m,
+                                 double thrust_mN, double mu, AccelerationPartials& partials,
+                                 int thrust_direction) {
+    // Same evaluation (and the same sum) as computeAcceleration, so an
+    // integrator stepping with the partials keeps the plain trajectory
+    double a_grav[3];
+    computeGravityAccel(r, mu, a_grav);
+    double a_thrust[3];
+    computeThrustAccel(v, m, thrust_mN, a_thrust, thrust_direction);
+    for (int i = 0; i < 3; i++) {
+        partials.a[i] = a_grav[i] + a_thrust[i];
+    }
+    
+    // Gravity gradient: d(-μ r/|r|³)/dr = -μ/|r|³ (I - 3 r rᵀ/|r|²)
+    double r2 = r[0]*r[0] + r[1]*r[1] + r[2]*r[2];
+    double r_mag = std::sqrt(r2);
+    double factor = (r_mag < 1e-10) ? 0.0 : -mu / (r2 * r_mag);
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            double outer = (r_mag < 1e-10) ? 0.0 : 3.0 * r[i] * r[j] / r2;
+            partials.da_dr[i][j] = factor * ((i == j ? 1.0 : 0.0) - outer);
+        }
+    }
+    
+    // Thrust along ±v/|v| with magnitude thrust/m: only the direction
+    // depends on v, the magnitude on m and thrust
+    double v2 = v[0]*v[0] + v[1]*v[1] + v[2]*v[2];
+    double v_mag = std::sqrt(v2);
+    bool thrusting = !(thrust_mN < 1e-10 || m < 1e-10 || v_mag < 1e-10);
+    double steering = thrusting ? thrust_direction * (thrust_mN * 1e-6) / m / v_mag : 0.0;
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            double outer = thrusting ? v[i] * v[j] / v2 : 0.0;
+            partials.da_dv[i][j] = steering * ((i == j ? 1.0 : 0.0) - outer);
+        }
+        partials.da_dm[i] = thrusting ? -a_thrust[i] / m : 0.0;
+        partials.da_dthrust[i] = thrusting ? thrust_direction * 1e-6 / (m * v_mag) * v[i] : 0.0;
+    }
+}
+
+
+// ===========================================================================
+// STATE DERIVATIVE IMPLEMENTATION
+// ===========================================================================
+
+void computeStateDerivative(const double y[7], double thrust_mN, double isp_s,
+                            double mu, double g0, double dydt[7],
+                            int thrust_direction) {
+    // Position derivative is the velocity
+    dydt[0] = y[3];
+    dydt[1] = y[4];
+    dydt[2] = y[5];
+    
+    // Velocity derivative is the total acceleration
+    double a_grav[3];
+    computeGravityAccel(&y[0], mu, a_grav);
+    
+    double a_thrust[3];
+    computeThrustAccel(&y[3], y[6], thrust_mN, a_thrust, thrust_direction);
+    
+    dydt[3] = a_grav[0] + a_thrust[0];
+    dydt[4] = a_grav[1] + a_thrust[1];
+    dydt[5] = a_grav[2] + a_thrust[2];
+    
+    // Mass flow: dm/dt = -F / v_e = -(thrust_mN * 1e-6) / (isp_s * g0)
+    if (thrust_mN > 1e-10 && isp_s > 1e-10 && y[6] > 0) {
+        dydt[6] = -thrust_mN * 1e-6 / (isp_s * g0);
+    } else {
+        dydt[6] = 0;
+    }
+}
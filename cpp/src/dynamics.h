@@ -94,4 +94,49 @@ void computeThrustAccel(const double v[3], double m, double thrust_mN,
 void computeAcceleration(const MissionState& state, double thrust_mN, 
                         double mu, double a[3], int thrust_direction = 1);
 
+/// Total acceleration from position, velocity and mass directly
+/// Same result as the MissionState overload; lets integrators evaluate
+/// intermediate stages without building temporary MissionState objects.
+void computeAcceleration(const double r[3], const double v[3], double m,
+                        double thrust_mN, double mu, double a[3],
+                        int thrust_direction = 1);
+
+/// Total acceleration with its partial derivatives (variational equations)
+///
+/// Row i of each matrix is component i of the acceleration:
+///   da_dr:      gravity gradient  -μ/|r|³ (I - 3 r rᵀ/|r|²)
+///   da_dv:      thrust steering   (|a_t|/|v|) (I - v vᵀ/|v|²) along ±v
+///   da_dm:      -a_thrust / m
+///   da_dthrust: a_thrust / thrust_mN
+/// Thrust terms are zero wherever computeThrustAccel returns zero.
+struct AccelerationPartials {
+    double a[3];               // Total acceleration, bit for bit as computeAcceleration
+    double da_dr[3][3];        // (1/s²)
+    double da_dv[3][3];        // (1/s)
+    double da_dm[3];           // (km/s² per kg)
+    double da_dthrust[3];      // (km/s² per mN)
+};
+
+/// Evaluate the acceleration and its partials at one stage state
+void computeAccelerationPartials(const double r[3], const double v[3], double m,
+                                 double thrust_mN, double mu, AccelerationPartials& partials,
+                                 int thrust_direction = 1);
+
+/// Compute the full state derivative for integrators that carry mass in the
+/// state vector (adaptive Runge-Kutta methods)
+///
+/// State layout: y = [rx, ry, rz, vx, vy, vz, m]
+/// Derivative:   dy/dt = [v, a_gravity + a_thrust, dm/dt]
+/// with dm/dt = -thrust / (isp * g0) while thrusting and mass remains.
+///
+/// @param y: state vector (km, km/s, kg)
+/// @param thrust_mN: thrust magnitude (millinewtons)
+/// @param isp_s: specific impulse (seconds)
+/// @param mu: gravitational parameter (km³/s²)
+/// @param g0: standard gravity (km/s²)
+/// @param dydt: [output] state derivative
+void computeStateDerivative(const double y[7], double thrust_mN, double isp_s,
+                            double mu, double g0, double dydt[7],
+                            int thrust_direction = 1);
+
 #endif // DYNAMICS_H
@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <utility>
+#include "ephemeris.h"
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+/// Σ' c_k T_k(u) with the first term halved (Clenshaw recurrence)
+double chebyshevSeries(const double* c, int count, double u) {
+    double b1 = 0;
+    double b2 = 0;
+    for (int k = count - 1; k >= 1; k--) {
+        double b0 = 2.0 * u * b1 - b2 + c[k];
+        b2 = b1;
+        b1 = b0;
+    }
+    return u * b1 - b2 + 0.5 * c[0];
+}
+
+}  // namespace
+
+// ===========================================================================
+// CIRCULAR-ORBIT MODEL
+// ===========================================================================
+
+void circularOrbitState(CelestialBody body, double phase_deg, double t, double r[3], double v[3]) {
+    double radius = getOrbitalRadius(body);
+    double n = std::sqrt(MU_SUN / (radius * radius * radius));
+    double angle = phase_deg * PI / 180.0 + n * t;
+    double c = std::cos(angle);
+    double s = std::sin(angle);
+    r[0] = radius * c;
+    r[1] = radius * s;
+    r[2] = 0;
+    v[0] = -radius * n * s;
+    v[1] = radius * n * c;
+    v[2] = 0;
+}
+
+// ===========================================================================
+// CHEBYSHEV TABLE
+// ===========================================================================
+
+ChebyshevEphemeris::ChebyshevEphemeris(CelestialBody body, double phase_deg, double span_s)
+    : body_(body), phase_deg(phase_deg), span_s(span_s) {
+    segments = std::max(1, static_cast<int>(std::ceil(span_s / SEGMENT_S)));
+    position.assign(static_cast<std::size_t>(segments) * 3 * COEFFICIENTS, 0.0);
+    velocity.assign(position.size(), 0.0);
+    
+    // Samples at the Chebyshev nodes u_j = cos(π (j + 1/2) / N) of each segment
+    double samples[3][COEFFICIENTS];
+    for (int segment = 0; segment < segments; segment++) {
+        double t_start = segment * SEGMENT_S;
+        for (int j = 0; j < COEFFICIENTS; j++) {
+            double u = std::cos(PI * (j + 0.5) / COEFFICIENTS);
+            double r[3];
+            double v[3];
+            circularOrbitState(body, phase_deg, t_start + 0.5 * (u + 1.0) * SEGMENT_S, r, v);
+            for (int i = 0; i < 3; i++) {
+                samples[i][j] = r[i];
+            }
+        }
+        
+        for (int i = 0; i < 3; i++) {
+            double* c = &position[(static_cast<std::size_t>(segment) * 3 + i) * COEFFICIENTS];
+            for (int k = 0; k < COEFFICIENTS; k++) {
+                double sum = 0;
+                for (int j = 0; j < COEFFICIENTS; j++) {
+                    sum += samples[i][j] * std::cos(PI * k * (j + 0.5) / COEFFICIENTS);
+                }
+                c[k] = 2.0 * sum / COEFFICIENTS;
+            }
+            
+            // Derivative series: c'_{k-1} = c'_{k+1} + 2k c_k, then d/du -> d/dt
+            double* d = &velocity[(static_cast<std::size_t>(segment) * 3 + i) * COEFFICIENTS];
+            d[COEFFICIENTS - 1] = 0;
+            d[COEFFICIENTS - 2] = 2.0 * (COEFFICIENTS - 1) * c[COEFFICIENTS - 1];
+            for (int k = COEFFICIENTS - 3; k >= 0; k--) {
+                d[k] = d[k + 2] + 2.0 * (k + 1) * c[k + 1];
+            }
+            for (int k = 0; k < COEFFICIENTS; k++) {
+                d[k] *= 2.0 / SEGMENT_S;
+            }
+        }
+    }
+}
+
+void ChebyshevEphemeris::evaluate(double t, double r[3], double v[3]) const {
+    int segment = static_cast<int>(std::floor(t / SEGMENT_S));
+    segment = std::min(std::max(segment, 0), segments - 1);
+    double u = 2.0 * (t - segment * SEGMENT_S) / SEGMENT_S - 1.0;
+    for (int i = 0; i < 3; i++) {
+        std::size_t offset = (static_cast<std::size_t>(segment) * 3 + i) * COEFFICIENTS;
+        r[i] = chebyshevSeries(&position[offset], COEFFICIENTS, u);
+        v[i] = chebyshevSeries(&velocity[offset], COEFFICIENTS, u);
+    }
+}
+
+// ===========================================================================
+// SHARED TABLES
+// ===========================================================================
+
+std::shared_ptr<const ChebyshevEphemeris> sharedEphemeris(CelestialBody body, double phase_deg,
+                                                          double span_s) {
+    static std::mutex mutex;
+    static std::map<std::pair<int, double>, std::shared_ptr<const ChebyshevEphemeris>> tables;
+    
+    std::lock_guard<std::mutex> lock(mutex);
+    std::shared_ptr<const ChebyshevEphemeris>& table =
+        tables[{static_cast<int>(body), phase_deg}];
+    if (!table || table->span() < span_s) {
+        table = std::make_shared<const ChebyshevEphemeris>(body, phase_deg, span_s);
+    }
+    return table;
+}
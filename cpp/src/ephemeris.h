@@ -0,0 +1,67 @@
+#ifndef EPHEMERIS_H
+#define EPHEMERIS_H
+
+#include <memory>
+#include <vector>
+#include "constants.h"
+
+// ===========================================================================
+// PLANETARY EPHEMERIS (CHEBYSHEV TABLE)
+// ===========================================================================
+// Heliocentric body positions over [0, span], stored the way JPL's
+// development ephemerides are. The span is cut into segments of equal
+// length, and each coordinate is a Chebyshev series on its segment,
+// fitted at the Chebyshev nodes. A lookup is one Clenshaw recurrence per
+// coordinate. The series differentiates term by term, which gives the
+// velocity.
+//
+// The source model is the one the rest of the tree assumes. Each body
+// moves on its circular, coplanar orbit of BODIES radius at the Keplerian
+// mean motion, starting from longitude phase_deg at t = 0. A fitted real
+// ephemeris would slot in without changes downstream.
+//
+// A table is immutable once built. sharedEphemeris() keeps one table per
+// body and phase for the whole process, so every thread of a batch reads
+// the same coefficients. A request for a longer span replaces the table
+// with a longer one. Holders of the old table keep it alive until they
+// drop it.
+// ===========================================================================
+
+class ChebyshevEphemeris {
+public:
+    static constexpr int DEGREE = 12;                   // Per segment and coordinate
+    static constexpr double SEGMENT_S = 16 * 86400.0;   // Segment length (s)
+    
+    /// Fit the circular-orbit model of body over [0, span_s]
+    ChebyshevEphemeris(CelestialBody body, double phase_deg, double span_s);
+    
+    /// Position (km) and velocity (km/s) at t. Outside [0, span], the
+    /// first or last segment is extrapolated.
+    void evaluate(double t, double r[3], double v[3]) const;
+    
+    CelestialBody body() const { return body_; }
+    double phaseDeg() const { return phase_deg; }
+    double span() const { return span_s; }
+
+private:
+    static constexpr int COEFFICIENTS = DEGREE + 1;
+    
+    CelestialBody body_;
+    double phase_deg;
+    double span_s;
+    int segments;
+    
+    // [segment][coordinate][COEFFICIENTS], first term halved (f = c0/2 + Σ c_k T_k)
+    std::vector<double> position;
+    std::vector<double> velocity;   // Series of d/dt, same layout
+};
+
+/// Process-wide table for body at phase_deg covering at least [0, span_s]
+/// Safe to call from several threads.
+std::shared_ptr<const ChebyshevEphemeris> sharedEphemeris(CelestialBody body, double phase_deg,
+                                                          double span_s);
+
+/// The circular-orbit model the tables are fitted to, evaluated directly
+void circularOrbitState(CelestialBody body, double phase_deg, double t, double r[3], double v[3]);
+
+#endif // EPHEMERIS_H
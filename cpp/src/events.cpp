@@ -0,0 +1,193 @@
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <memory>
+#include <functional>
+#include "events.h"
+#include "constants.h"
+#include "dynamics.h"
+#include "orbital_elements.h"
+
+// ===========================================================================
+// STEP INTERPOLANT
+// ===========================================================================
+
+StepInterpolant::StepInterpolant(const MissionState& before, const MissionState& after,
+                                 double thrust_mN, double mu, int thrust_direction)
+    : before(before), after(after) {
+    computeAcceleration(before, thrust_mN, mu, a0, thrust_direction);
+    computeAcceleration(after, thrust_mN, mu, a1, thrust_direction);
+}
+
+MissionState StepInterpolant::at(double t) const {
+    double h = after.t - before.t;
+    if (h <= 0) {
+        return after;
+    }
+    
+    // Hermite basis on s in [0, 1]
+    double s = (t - before.t) / h;
+    double s2 = s * s;
+    double s3 = s2 * s;
+    double h00 = 2*s3 - 3*s2 + 1;
+    double h10 = s3 - 2*s2 + s;
+    double h01 = -2*s3 + 3*s2;
+    double h11 = s3 - s2;
+    
+    MissionState state;
+    for (int i = 0; i < 3; i++) {
+        state.r[i] = h00 * before.r[i] + h10 * h * before.v[i] +
+                     h01 * after.r[i] + h11 * h * after.v[i];
+        state.v[i] = h00 * before.v[i] + h10 * h * a0[i] +
+                     h01 * after.v[i] + h11 * h * a1[i];
+    }
+    state.m = before.m + s * (after.m - before.m);
+    state.t = t;
+    return state;
+}
+
+// ===========================================================================
+// EVENT LOCATOR
+// ===========================================================================
+
+EventLocator::EventLocator(const MissionConfig& config, double coast_radius,
+                           int thrust_direction)
+    : coast_radius(coast_radius),
+      thrust_mN(config.spacecraft.thrust_mN),
+      thrust_direction(thrust_direction) {
+    
+    const double none = std::numeric_limits<double>::quiet_NaN();
+    if (config.locate_coast) {
+        watched.push_back({"coast", 0, true, 0, none});
+    }
+    for (const EventSpec& spec : config.events) {
+        watched.push_back({spec.type, spec.value, spec.terminal, 0, none});
+    }
+}
+
+double EventLocator::eventValue(const Watched& event, const MissionState& state) const {
+    if (event.type == "coast") {
+        Apsides apsides = computeApsides(state.r, state.v, MU_SUN);
+        return (thrust_direction > 0) ? apsides.r_a - coast_radius
+                                      : coast_radius - apsides.r_p;
+    }
+    if (event.type == "mass_below") {
+        return event.value - state.m;
+    }
+    return state.radius() - event.value;  // radius_crossing
+}
+
+bool EventLocator::crossed(const Watched& event, double g_before, double g_after) const {
+    if (event.type == "radius_crossing") {
+        return (g_before < 0) != (g_after < 0);
+    }
+    return g_before < 0 && g_after >= 0;
+}
+
+double EventLocator::locateRoot(const Watched& event,
+                                const std::function<MissionState(double)>& state_at,
+                                double t0, double g0, double t1, double g1,
+                                double t_first, MissionState* triggered) const {
+    // Illinois variant of regula falsi: keeps the root bracketed and halves
+    // the stale end's weight so convergence stays superlinear. Returns the
+    // bracket end on the triggered side (g has the sign of g1).
+    int side = 0;
+    for (int iter = 0; iter < 100 && t1 - t0 > EVENT_TIME_TOL_S; iter++) {
+        double t = (iter == 0 && t_first > t0 && t_first < t1)
+                       ? t_first : (t0 * g1 - t1 * g0) / (g1 - g0);
+        if (!(t > t0 && t < t1)) {
+            t = 0.5 * (t0 + t1);
+        }
+        MissionState state = state_at(t);
+        double g = eventValue(event, state);
+        
+        if ((g < 0) == (g0 < 0)) {
+            t0 = t;
+            g0 = g;
+            if (side == -1) {
+                g1 *= 0.5;
+            }
+            side = -1;
+        } else {
+            t1 = t;
+            g1 = g;
+            if (triggered) {
+                *triggered = state;
+            }
+            if (side == 1) {
+                g0 *= 0.5;
+            }
+            side = 1;
+        }
+    }
+    return t1;
+}
+
+bool EventLocator::checkStep(const MissionState& before, const MissionState& after,
+                             bool coast_possible, std::vector<MissionEvent>& events) {
+    std::vector<MissionEvent> found;
+    std::unique_ptr<StepInterpolant> interpolant;  // built on the first crossing
+    terminal_t = after.t;
+    terminal_type.clear();
+    
+    for (Watched& event : watched) {
+        if (event.type == "coast" && !coast_possible) {
+            event.cached_t = std::numeric_limits<double>::quiet_NaN();
+            continue;
+        }
+        
+        double g_before = (event.cached_t == before.t) ? event.g_cached
+                                                        : eventValue(event, before);
+        double g_after = eventValue(event, after);
+        event.g_cached = g_after;
+        event.cached_t = after.t;
+        
+        if (!crossed(event, g_before, g_after)) {
+            continue;
+        }
+        
+        if (!interpolant) {
+            interpolant = std::make_unique<StepInterpolant>(before, after, thrust_mN,
+                                                            MU_SUN, thrust_direction);
+        }
+        const StepInterpolant& dense = *interpolant;
+        double t = locateRoot(event, [&dense](double t) { return dense.at(t); },
+                              before.t, g_before, after.t, g_after);
+        
+        if (event.terminal) {
+            if (terminal_type.empty() || t < terminal_t) {
+                terminal_t = t;
+                terminal_type = event.type;
+                terminal_index = static_cast<int>(&event - watched.data());
+            }
+        } else {
+            found.push_back(MissionEvent(event.type, interpolant->at(t), false));
+        }
+    }
+    
+    std::sort(found.begin(), found.end(), [](const MissionEvent& a, const MissionEvent& b) {
+        return a.state.t < b.state.t;
+    });
+    for (const MissionEvent& event : found) {
+        if (terminal_type.empty() || event.state.t <= terminal_t) {
+            events.push_back(event);
+        }
+    }
+    
+    return !terminal_type.empty();
+}
+
+MissionState EventLocator::refineTerminal(
+    const MissionState& before, const MissionState& after,
+    const std::function<MissionState(double)>& integrate_to) {
+    
+    // Same root, now on the integrator's own solution; the interpolant's
+    // estimate is the first guess, so this takes only a few re-steps
+    const Watched& event = watched[terminal_index];
+    MissionState state = after;
+    terminal_t = locateRoot(event, integrate_to,
+                            before.t, eventValue(event, before),
+                            after.t, eventValue(event, after),
+                            terminal_t, &state);
+    return state;
+}
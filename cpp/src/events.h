@@ -0,0 +1,120 @@
+#ifndef EVENTS_H
+#define EVENTS_H
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "propagator.h"
+
+// ===========================================================================
+// EVENT LOCATION WITH DENSE OUTPUT
+// ===========================================================================
+// Without event location the coast condition is only tested at step
+// boundaries, so the coast time is quantized to the timestep. An event is a
+// scalar function g(state) that changes sign when the event happens:
+//
+//   coast            g = r_a - coast_radius (outbound)
+//                    g = coast_radius - r_p (inbound)
+//   mass_below       g = limit - m
+//   radius_crossing  g = |r| - radius (either direction)
+//
+// After every step g is compared at both ends. When it changes sign, the
+// root is found on a cubic Hermite interpolant of the step (positions and
+// velocities with their derivatives at both ends). A terminal event is then
+// refined by re-stepping the integrator from the start of the step, with
+// the interpolant's root as first guess, so the final state is a genuine
+// integrator state that satisfies the event condition.
+
+/// Time tolerance of the event root finder (s)
+constexpr double EVENT_TIME_TOL_S = 1e-3;
+
+/// One located event
+struct MissionEvent {
+    std::string type;      // "coast", "mass_below" or "radius_crossing"
+    MissionState state;    // state at the event (state.t is the event time)
+    bool terminal;         // propagation stopped here
+    
+    MissionEvent() : terminal(false) {}
+    MissionEvent(const std::string& type, const MissionState& state, bool terminal)
+        : type(type), state(state), terminal(terminal) {}
+};
+
+// ===========================================================================
+// STEP INTERPOLANT
+// ===========================================================================
+
+/// Cubic Hermite interpolant over one integration step
+/// Position uses (r, v) and velocity uses (v, a) at both ends, so both are
+/// fourth-order accurate in the step size. Mass is interpolated linearly,
+/// which is exact for constant thrust.
+class StepInterpolant {
+public:
+    StepInterpolant(const MissionState& before, const MissionState& after,
+                    double thrust_mN, double mu, int thrust_direction = 1);
+    
+    /// Interpolated state at time t (before.t <= t <= after.t)
+    MissionState at(double t) const;
+
+private:
+    MissionState before, after;
+    double a0[3], a1[3];    // Accelerations at both ends (km/s²)
+};
+
+// ===========================================================================
+// EVENT LOCATOR
+// ===========================================================================
+
+class EventLocator {
+public:
+    /// Watches config.events, plus the coast condition when config.locate_coast
+    EventLocator(const MissionConfig& config, double coast_radius, int thrust_direction);
+    
+    /// Whether any event is watched at all
+    bool active() const { return !watched.empty(); }
+    
+    /// Look for events inside the step before -> after
+    ///
+    /// Non-terminal events are appended to events in time order. Returns
+    /// true when a terminal event occurs inside the step; non-terminal
+    /// events after it are dropped. coast_possible = false skips the coast
+    /// function (e.g. while a bracketed coast check proves it cannot fire).
+    bool checkStep(const MissionState& before, const MissionState& after,
+                   bool coast_possible, std::vector<MissionEvent>& events);
+    
+    /// Terminal event state on the integrator's own solution
+    /// After checkStep returns true: locates the terminal event again with
+    /// integrate_to(t), the integrator state at t stepped from before, and
+    /// returns the state just past the event. terminalTime() is updated.
+    MissionState refineTerminal(const MissionState& before, const MissionState& after,
+                                const std::function<MissionState(double)>& integrate_to);
+    
+    /// Time and type of the terminal event found by the last checkStep
+    double terminalTime() const { return terminal_t; }
+    const std::string& terminalType() const { return terminal_type; }
+
+private:
+    struct Watched {
+        std::string type;
+        double value;
+        bool terminal;
+        double g_cached;      // g at cached_t
+        double cached_t;      // time of g_cached (NaN = none)
+    };
+    
+    double eventValue(const Watched& event, const MissionState& state) const;
+    bool crossed(const Watched& event, double g_before, double g_after) const;
+    double locateRoot(const Watched& event,
+                      const std::function<MissionState(double)>& state_at,
+                      double t0, double g0, double t1, double g1,
+                      double t_first = -1, MissionState* triggered = nullptr) const;
+    
+    std::vector<Watched> watched;
+    double coast_radius;
+    double thrust_mN;
+    int thrust_direction;
+    double terminal_t = 0;
+    std::string terminal_type;
+    int terminal_index = -1;
+};
+
+#endif // EVENTS_H
@@ -0,0 +1,190 @@
+#include <iostream>
+#include <cmath>
+#include <utility>
+#include "force_model.h"
+
+namespace {
+
+/// Solar radiation pressure at 1 AU (N/m²) and 1 AU (km)
+constexpr double SOLAR_PRESSURE_1AU = 4.56e-6;
+constexpr double AU_KM = 1.495978707e8;
+
+// ===========================================================================
+// PERTURBATION REGISTRY
+// ===========================================================================
+
+std::unique_ptr<Perturbation> makeThirdBody(const PerturbationSpec& spec,
+                                            const MissionConfig& config) {
+    // Cover the last stage past max_flight_time_s as well
+    double span = config.max_flight_time_s +
+                  2.0 * std::fmax(config.timestep_s, config.ephemeris_cadence_s);
+    EphemerisSampler sampler(sharedEphemeris(spec.body, spec.phase_deg, span),
+                             config.ephemeris_cadence_s);
+    return std::make_unique<ThirdBodyPerturbation>(getBodyInfo(spec.body).mu_km3_s2,
+                                                   std::move(sampler));
+}
+
+std::unique_ptr<Perturbation> makeSolarRadiationPressure(const PerturbationSpec& spec,
+                                                         const MissionConfig&) {
+    return std::make_unique<SolarRadiationPressure>(spec.area_m2, spec.reflectivity);
+}
+
+struct PerturbationTypeInfo {
+    const char* name;               // PerturbationSpec::type
+    std::unique_ptr<Perturbation> (*create)(const PerturbationSpec&, const MissionConfig&);
+};
+
+const PerturbationTypeInfo PERTURBATION_TYPES[] = {
+    {"third_body", makeThirdBody},
+    {"solar_radiation_pressure", makeSolarRadiationPressure},
+};
+
+const PerturbationTypeInfo* findPerturbationType(const std::string& type) {
+    for (const PerturbationTypeInfo& info : PERTURBATION_TYPES) {
+        if (type == info.name) {
+            return &info;
+        }
+    }
+    return nullptr;
+}
+
+/// Warn if the departure point lies inside the Hill sphere of spec.body
+/// There the body dominates and a heliocentric perturbation does not hold.
+void warnIfStartInsideHillSphere(const PerturbationSpec& spec, const MissionConfig& config) {
+    double r_body[3];
+    double v_body[3];
+    circularOrbitState(spec.body, spec.phase_deg, 0.0, r_body, v_body);
+    double dx = getOrbitalRadius(config.departure_body) - r_body[0];
+    double dy = -r_body[1];
+    double distance = std::sqrt(dx * dx + dy * dy);
+    double hill_radius = getOrbitalRadius(spec.body) *
+                         std::cbrt(getBodyInfo(spec.body).mu_km3_s2 / (3.0 * MU_SUN));
+    if (distance < hill_radius) {
+        std::cerr << "Warning: the mission starts " << distance << " km from "
+                  << getBodyName(spec.body) << ", inside its sphere of influence ("
+                  << hill_radius << " km); set phase_deg to place it elsewhere\n";
+    }
+}
+
+}  // namespace
+
+// ===========================================================================
+// EPHEMERIS SAMPLER
+// ===========================================================================
+
+EphemerisSampler::EphemerisSampler(std::shared_ptr<const ChebyshevEphemeris> table,
+                                   double cadence_s)
+    : table(std::move(table)), cadence_s(cadence_s) {}
+
+void EphemerisSampler::loadInterval(long k) {
+    if (loaded && k == interval + 1) {
+        // Next interval: its start is the current end
+        for (int i = 0; i < 3; i++) {
+            r0[i] = r1[i];
+            v0[i] = v1[i];
+        }
+    } else {
+        table->evaluate(k * cadence_s, r0, v0);
+        evaluations++;
+    }
+    table->evaluate((k + 1) * cadence_s, r1, v1);
+    evaluations++;
+    interval = k;
+    loaded = true;
+}
+
+void EphemerisSampler::position(double t, double r[3]) {
+    if (!(cadence_s > 0)) {
+        double v[3];
+        table->evaluate(t, r, v);
+        evaluations++;
+        return;
+    }
+    
+    long k = static_cast<long>(std::floor(t / cadence_s));
+    if (!loaded || k != interval) {
+        loadInterval(k);
+    }
+    
+    // Cubic Hermite basis on s in [0, 1]
+    double s = (t - k * cadence_s) / cadence_s;
+    double s2 = s * s;
+    double s3 = s2 * s;
+    double h00 = 2 * s3 - 3 * s2 + 1;
+    double h10 = s3 - 2 * s2 + s;
+    double h01 = -2 * s3 + 3 * s2;
+    double h11 = s3 - s2;
+    for (int i = 0; i < 3; i++) {
+        r[i] = h00 * r0[i] + h10 * cadence_s * v0[i] + h01 * r1[i] + h11 * cadence_s * v1[i];
+    }
+}
+
+// ===========================================================================
+// PERTURBATIONS
+// ===========================================================================
+
+void ThirdBodyPerturbation::addAcceleration(const double r[3], double t, double, double a[3]) {
+    double r_body[3];
+    sampler.position(t, r_body);
+    
+    // Direct term toward the body, minus the Sun's own acceleration toward it
+    double d[3] = {r_body[0] - r[0], r_body[1] - r[1], r_body[2] - r[2]};
+    double d_mag = std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+    double body_mag = std::sqrt(r_body[0] * r_body[0] + r_body[1] * r_body[1] +
+                                r_body[2] * r_body[2]);
+    if (d_mag < 1e-10 || body_mag < 1e-10) {
+        return;
+    }
+    double direct = mu / (d_mag * d_mag * d_mag);
+    double indirect = mu / (body_mag * body_mag * body_mag);
+    for (int i = 0; i < 3; i++) {
+        a[i] += direct * d[i] - indirect * r_body[i];
+    }
+}
+
+SolarRadiationPressure::SolarRadiationPressure(double area_m2, double reflectivity)
+    // N/m² * m² / kg = m/s²; 1e-3 converts to km/s²
+    : coefficient(SOLAR_PRESSURE_1AU * reflectivity * area_m2 * 1e-3 * AU_KM * AU_KM) {}
+
+void SolarRadiationPressure::addAcceleration(const double r[3], double, double m, double a[3]) {
+    double r2 = r[0] * r[0] + r[1] * r[1] + r[2] * r[2];
+    if (m < 1e-10 || r2 < 1e-20) {
+        return;
+    }
+    // (coefficient / m) / r² along r / |r|
+    double factor = coefficient / (m * r2 * std::sqrt(r2));
+    for (int i = 0; i < 3; i++) {
+        a[i] += factor * r[i];
+    }
+}
+
+// ===========================================================================
+// FORCE MODEL
+// ===========================================================================
+
+ForceModel::ForceModel(const MissionConfig& config) {
+    for (const PerturbationSpec& spec : config.perturbations) {
+        if (!spec.enabled) {
+            continue;
+        }
+        const PerturbationTypeInfo* info = findPerturbationType(spec.type);
+        if (!info) {
+            std::cerr << "Warning: unknown perturbation type '" << spec.type << "' ignored\n";
+            continue;
+        }
+        if (spec.type == "third_body") {
+            warnIfStartInsideHillSphere(spec, config);
+        }
+        models.push_back(info->create(spec, config));
+    }
+}
+
+void ForceModel::addAcceleration(const double r[3], double t, double m, double a[3]) {
+    for (const std::unique_ptr<Perturbation>& model : models) {
+        model->addAcceleration(r, t, m, a);
+    }
+}
+
+bool isKnownPerturbation(const std::string& type) {
+    return findPerturbationType(type) != nullptr;
+}
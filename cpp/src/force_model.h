@@ -0,0 +1,134 @@
+#ifndef FORCE_MODEL_H
+#define FORCE_MODEL_H
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "propagator.h"
+#include "ephemeris.h"
+
+// ===========================================================================
+// FORCE MODELS (MissionConfig::perturbations)
+// ===========================================================================
+// computeAcceleration covers solar gravity and thrust. A mission adds terms
+// to it with a list of perturbation entries, each with its own enable flag:
+//
+//   third_body                 point-mass gravity of `body`: the direct
+//                              pull minus the pull on the Sun itself, since
+//                              the frame is heliocentric
+//   solar_radiation_pressure   P (1 AU / r)² C_r A / m, directed away
+//                              from the Sun, with P = 4.56e-6 N/m²
+//                              at 1 AU (no eclipses)
+//
+// ForceModel builds the enabled entries and hands their sum to the
+// integrator's stage hook (Propagator::setPerturbation). RK4, Euler, RK45
+// and DOP853 call the hook. Missions without enabled entries attach
+// nothing, so their arithmetic is unchanged bit for bit. Each type is a
+// Perturbation subclass with one row in the registry in force_model.cpp.
+//
+// The expensive part is the body position. A third-body term reads it
+// through an EphemerisSampler. The sampler evaluates the shared Chebyshev
+// table (ephemeris.h) only on a grid of ephemeris_cadence_s, and
+// interpolates between grid points. Solar radiation pressure needs only r,
+// so it is evaluated at every stage.
+//
+// Closed-form coast arcs stay two-body. Perturbed missions check the
+// coast condition at every step: the "bracketed" skip bound accounts for
+// thrust only. They also run without the batched kernel and have no
+// sensitivities.
+// ===========================================================================
+
+/// Body position at any time, interpolated between samples of a table
+///
+/// The samples lie on the fixed grid t_k = k * cadence_s, so the result
+/// depends on t alone, not on the order of the calls, and a resumed run
+/// reproduces it. Each sample holds position and velocity, and a cubic
+/// Hermite spline joins neighbours. Stepping into the next interval costs
+/// one table evaluation. cadence_s <= 0 evaluates the table at every call.
+class EphemerisSampler {
+public:
+    EphemerisSampler(std::shared_ptr<const ChebyshevEphemeris> table, double cadence_s);
+    
+    /// Interpolated position (km) at t
+    void position(double t, double r[3]);
+    
+    /// Table evaluations so far
+    long tableEvaluations() const { return evaluations; }
+
+private:
+    /// Make [t_k, t_k+1] the current interval
+    void loadInterval(long k);
+    
+    std::shared_ptr<const ChebyshevEphemeris> table;
+    double cadence_s;
+    bool loaded = false;
+    long interval = 0;
+    double r0[3] = {};
+    double v0[3] = {};
+    double r1[3] = {};
+    double v1[3] = {};
+    long evaluations = 0;
+};
+
+/// Point-mass gravity of a body on an ephemeris (heliocentric frame)
+class ThirdBodyPerturbation final : public Perturbation {
+public:
+    ThirdBodyPerturbation(double mu_km3_s2, EphemerisSampler sampler)
+        : mu(mu_km3_s2), sampler(std::move(sampler)) {}
+    
+    void addAcceleration(const double r[3], double t, double m, double a[3]) override;
+    
+    const EphemerisSampler& ephemeris() const { return sampler; }
+
+private:
+    double mu;
+    EphemerisSampler sampler;
+};
+
+/// Cannonball solar radiation pressure, always sunlit
+class SolarRadiationPressure final : public Perturbation {
+public:
+    SolarRadiationPressure(double area_m2, double reflectivity);
+    
+    void addAcceleration(const double r[3], double t, double m, double a[3]) override;
+
+private:
+    double coefficient;   // P(1 AU) C_r A AU² (kg km³/s²)
+};
+
+/// Sum of the enabled perturbations of one mission
+/// Holds per-mission interpolation state, so a propagation needs its own.
+class ForceModel final : public Perturbation {
+public:
+    /// Build the enabled entries of config.perturbations. Warns and skips
+    /// unknown types, and warns when the mission starts inside the
+    /// sphere of influence of a perturbing body.
+    explicit ForceModel(const MissionConfig& config);
+    
+    /// No perturbations
+    ForceModel() = default;
+    
+    bool empty() const { return models.empty(); }
+    std::size_t size() const { return models.size(); }
+    
+    void addAcceleration(const double r[3], double t, double m, double a[3]) override;
+
+private:
+    std::vector<std::unique_ptr<Perturbation>> models;
+};
+
+/// True for the type names in the registry
+bool isKnownPerturbation(const std::string& type);
+
+/// True if config has an enabled perturbation entry
+inline bool hasPerturbations(const MissionConfig& config) {
+    for (const PerturbationSpec& spec : config.perturbations) {
+        if (spec.enabled) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#endif // FORCE_MODEL_H
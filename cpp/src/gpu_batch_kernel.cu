@@ -0,0 +1,81 @@
+#include <cstddef>
+#include <string>
+#include <cuda_runtime.h>
+#include "lane_kernel.h"
+
+// ===========================================================================
+// CUDA LANE KERNEL
+// ===========================================================================
+// Only built with -DLTMD_ENABLE_CUDA=ON. One thread propagates one
+// spacecraft from departure to its coast, fuel or flight-time cutoff
+// (propagateLane), so lanes that finish early simply retire their thread.
+// The missions are uploaded once, and only the LaneOutcome array comes
+// back. The host side is gpu_batch_propagator.cpp.
+
+namespace {
+
+constexpr int THREADS_PER_BLOCK = 128;
+
+__global__ void laneKernel(const LaneMission* __restrict__ missions, std::size_t n,
+                           LaneConstants constants, LaneOutcome* __restrict__ outcomes) {
+    std::size_t i = static_cast<std::size_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+    if (i < n) {
+        propagateLane(missions[i], constants, outcomes[i]);
+    }
+}
+
+/// false with error set to the CUDA message when status is not cudaSuccess
+bool ok(cudaError_t status, const char* what, std::string& error) {
+    if (status == cudaSuccess) {
+        return true;
+    }
+    error = std::string(what) + ": " + cudaGetErrorString(status);
+    return false;
+}
+
+}  // namespace
+
+bool gpuLaneDevice(std::string& description) {
+    int count = 0;
+    if (!ok(cudaGetDeviceCount(&count), "cudaGetDeviceCount", description)) {
+        return false;
+    }
+    if (count == 0) {
+        description = "no CUDA device";
+        return false;
+    }
+    int device = 0;
+    cudaDeviceProp properties;
+    if (!ok(cudaGetDevice(&device), "cudaGetDevice", description) ||
+        !ok(cudaGetDeviceProperties(&properties, device), "cudaGetDeviceProperties",
+            description)) {
+        return false;
+    }
+    description = properties.name;
+    return true;
+}
+
+bool gpuLaunchLanes(const LaneMission* missions, std::size_t n, const LaneConstants& constants,
+                    LaneOutcome* outcomes, std::string& error) {
+    LaneMission* device_missions = nullptr;
+    LaneOutcome* device_outcomes = nullptr;
+    
+    bool launched =
+        ok(cudaMalloc(&device_missions, n * sizeof(LaneMission)), "cudaMalloc", error) &&
+        ok(cudaMalloc(&device_outcomes, n * sizeof(LaneOutcome)), "cudaMalloc", error) &&
+        ok(cudaMemcpy(device_missions, missions, n * sizeof(LaneMission),
+                      cudaMemcpyHostToDevice), "cudaMemcpy", error);
+    if (launched) {
+        unsigned int blocks = static_cast<unsigned int>(
+            (n + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK);
+        laneKernel<<<blocks, THREADS_PER_BLOCK>>>(device_missions, n, constants,
+                                                  device_outcomes);
+        launched = ok(cudaGetLastError(), "laneKernel launch", error) &&
+                   ok(cudaMemcpy(outcomes, device_outcomes, n * sizeof(LaneOutcome),
+                                 cudaMemcpyDeviceToHost), "cudaMemcpy", error);
+    }
+    
+    cudaFree(device_missions);
+    cudaFree(device_outcomes);
+    return launched;
+}
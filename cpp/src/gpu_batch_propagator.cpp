@@ -0,0 +1,151 @@
+#include <cmath>
+#include <iostream>
+#include <mutex>
+#include "gpu_batch_propagator.h"
+#include "lane_kernel.h"
+
+#ifdef LTMD_ENABLE_CUDA
+// Defined in gpu_batch_kernel.cu
+bool gpuLaneDevice(std::string& description);
+bool gpuLaunchLanes(const LaneMission* missions, std::size_t n, const LaneConstants& constants,
+                    LaneOutcome* outcomes, std::string& error);
+#endif
+
+namespace {
+
+/// Launch settings of a canPropagateAsBatch set
+LaneConstants laneConstants(const std::vector<MissionConfig>& configs,
+                            double r_departure, double r_arrival) {
+    LaneConstants constants;
+    constants.dt = configs[0].timestep_s;
+    constants.max_flight_time_s = configs[0].max_flight_time_s;
+    constants.mu = MU_SUN;
+    constants.g0 = G0;
+    constants.thrust_direction = (r_arrival > r_departure) ? 1 : -1;
+    return constants;
+}
+
+/// Every mission on the departure circular orbit, as propagateMissionBatch
+std::vector<LaneMission> laneMissions(const std::vector<MissionConfig>& configs,
+                                      double r_departure, double r_arrival) {
+    double v_circ = std::sqrt(MU_SUN / r_departure);
+    std::vector<LaneMission> missions(configs.size());
+    for (std::size_t i = 0; i < configs.size(); ++i) {
+        LaneMission& lane = missions[i];
+        lane.x = r_departure;  lane.y = 0;       lane.z = 0;
+        lane.vx = 0;           lane.vy = v_circ; lane.vz = 0;
+        lane.m = configs[i].spacecraft.initial_mass_kg;
+        lane.thrust_mN = configs[i].spacecraft.thrust_mN;
+        lane.isp_s = configs[i].spacecraft.isp_s;
+        lane.coast_radius = configs[i].coast_threshold * r_arrival;
+    }
+    return missions;
+}
+
+/// The PropagationResult fields propagateMissionBatch fills
+PropagationResult laneResult(const LaneOutcome& outcome) {
+    PropagationResult result;
+    result.final_state = MissionState(outcome.x, outcome.y, outcome.z,
+                                      outcome.vx, outcome.vy, outcome.vz,
+                                      outcome.m, outcome.t);
+    result.total_delta_v = outcome.delta_v;
+    result.coast_step = static_cast<int>(outcome.coast_step);
+    result.accepted_steps = static_cast<long>(outcome.steps);
+    return result;
+}
+
+}  // namespace
+
+// ===========================================================================
+// BACKEND SELECTION
+// ===========================================================================
+
+bool isBatchBackend(const std::string& name) {
+    return name == "cpu" || name == "lanes" || name == "gpu";
+}
+
+bool gpuBatchAvailable() {
+#ifdef LTMD_ENABLE_CUDA
+    std::string description;
+    return gpuLaneDevice(description);
+#else
+    return false;
+#endif
+}
+
+std::string gpuBatchDescription() {
+#ifdef LTMD_ENABLE_CUDA
+    std::string description;
+    gpuLaneDevice(description);
+    return description;
+#else
+    return "not built; configure with -DLTMD_ENABLE_CUDA=ON";
+#endif
+}
+
+// ===========================================================================
+// LANE PROPAGATION
+// ===========================================================================
+
+std::vector<PropagationResult> propagateMissionLanes(
+    const std::vector<MissionConfig>& configs,
+    double r_departure,
+    double r_arrival) {
+    
+    std::vector<PropagationResult> results(configs.size());
+    if (configs.empty()) {
+        return results;
+    }
+    
+    LaneConstants constants = laneConstants(configs, r_departure, r_arrival);
+    std::vector<LaneMission> missions = laneMissions(configs, r_departure, r_arrival);
+    for (std::size_t i = 0; i < missions.size(); ++i) {
+        LaneOutcome outcome;
+        propagateLane(missions[i], constants, outcome);
+        results[i] = laneResult(outcome);
+    }
+    return results;
+}
+
+bool propagateMissionLanesGpu(
+    const std::vector<MissionConfig>& configs,
+    double r_departure,
+    double r_arrival,
+    std::vector<PropagationResult>& results) {
+    
+    // One warning per run, not one per chunk
+    static std::once_flag warned;
+
+#ifdef LTMD_ENABLE_CUDA
+    results.assign(configs.size(), PropagationResult());
+    if (configs.empty()) {
+        return true;
+    }
+    
+    LaneConstants constants = laneConstants(configs, r_departure, r_arrival);
+    std::vector<LaneMission> missions = laneMissions(configs, r_departure, r_arrival);
+    std::vector<LaneOutcome> outcomes(missions.size());
+    std::string error;
+    if (!gpuLaunchLanes(missions.data(), missions.size(), constants, outcomes.data(), error)) {
+        std::call_once(warned, [&error]() {
+            std::cerr << "Warning: GPU batch backend failed (" << error
+                      << "), propagating on the CPU\n";
+        });
+        return false;
+    }
+    for (std::size_t i = 0; i < outcomes.size(); ++i) {
+        results[i] = laneResult(outcomes[i]);
+    }
+    return true;
+#else
+    (void)configs;
+    (void)r_departure;
+    (void)r_arrival;
+    (void)results;
+    std::call_once(warned, []() {
+        std::cerr << "Warning: GPU batch backend unavailable (" << gpuBatchDescription()
+                  << "), propagating on the CPU\n";
+    });
+    return false;
+#endif
+}
@@ -0,0 +1,56 @@
+#ifndef GPU_BATCH_PROPAGATOR_H
+#define GPU_BATCH_PROPAGATOR_H
+
+#include <string>
+#include <vector>
+#include "propagator.h"
+#include "mission_propagation.h"
+
+// ===========================================================================
+// LANE BACKENDS FOR BATCH PROPAGATION
+// ===========================================================================
+// propagateMissionBatch steps every lane of a BatchState together on the
+// CPU. A GPU would rather run one thread per spacecraft, from departure to
+// coast, with no synchronization between lanes. These backends run that
+// scheme (propagateLane, lane_kernel.h) behind the same batch API. They are
+// selected with MissionConfig::batch_backend:
+//
+//   "cpu"    SoA kernels (default)
+//   "lanes"  propagateLane on the host, one mission after another: the
+//            reference for the device kernel, and the CPU fallback
+//   "gpu"    propagateLane as a CUDA kernel, one thread per spacecraft.
+//            Needs a build with -DLTMD_ENABLE_CUDA=ON and a device.
+//
+// Missions are uploaded once and only the final LaneOutcome fields are
+// copied back, so trajectories and per-step data never leave the device.
+// Every backend gives the same results bit for bit (see lane_kernel.h for
+// the conditions on a device). Pruned sets stay on the CPU, since the
+// shared bound is a host atomic.
+
+/// Whether this build has the GPU backend and a device to run it on
+bool gpuBatchAvailable();
+
+/// Device name, or why the GPU backend is unavailable
+std::string gpuBatchDescription();
+
+/// Whether a batch_backend name is known ("cpu", "lanes" or "gpu")
+bool isBatchBackend(const std::string& name);
+
+/// Propagate a canPropagateAsBatch set through the lane kernel on the host
+std::vector<PropagationResult> propagateMissionLanes(
+    const std::vector<MissionConfig>& configs,
+    double r_departure,
+    double r_arrival
+);
+
+/// Propagate a canPropagateAsBatch set on the device
+/// Returns false (with a warning) if the device is missing or a CUDA
+/// call fails, and the caller falls back to the CPU
+bool propagateMissionLanesGpu(
+    const std::vector<MissionConfig>& configs,
+    double r_departure,
+    double r_arrival,
+    std::vector<PropagationResult>& results
+);
+
+#endif // GPU_BATCH_PROPAGATOR_H
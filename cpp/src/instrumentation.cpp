@@ -0,0 +1,194 @@
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "instrumentation.h"
+
+namespace {
+
+struct TraceEvent {
+    ProfilePhase phase;
+    std::int64_t start_ns;
+    std::int64_t duration_ns;
+};
+
+/// Counters of one thread; only that thread writes them
+/// Each slot starts on its own cache line, so neighbouring workers
+/// updating their counters do not contend for one line.
+struct alignas(64) ThreadProfile {
+    std::atomic<std::uint64_t> calls[PROFILE_PHASE_COUNT] = {};
+    std::atomic<std::uint64_t> nanoseconds[PROFILE_PHASE_COUNT] = {};
+    std::vector<TraceEvent> trace;
+    int thread_index = 0;
+};
+
+/// Statically allocated so registering a thread never touches the heap;
+/// threads past the limit run unprofiled
+constexpr int MAX_PROFILED_THREADS = 256;
+ThreadProfile thread_profiles[MAX_PROFILED_THREADS];
+std::atomic<int> thread_count{0};
+
+std::atomic<bool> trace_enabled{false};
+
+/// The calling thread's slot, or nullptr once every slot is taken
+ThreadProfile* localProfile() {
+    thread_local ThreadProfile* profile = [] {
+        int index = thread_count.fetch_add(1);
+        if (index >= MAX_PROFILED_THREADS) {
+            return static_cast<ThreadProfile*>(nullptr);
+        }
+        thread_profiles[index].thread_index = index + 1;
+        return &thread_profiles[index];
+    }();
+    return profile;
+}
+
+int profiledThreads() {
+    int count = thread_count.load();
+    return count < MAX_PROFILED_THREADS ? count : MAX_PROFILED_THREADS;
+}
+
+/// Single-writer increment: no read-modify-write instruction needed
+void addRelaxed(std::atomic<std::uint64_t>& counter, std::uint64_t amount) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+ProfileCounters snapshot(const ThreadProfile& profile) {
+    ProfileCounters counters;
+    for (int p = 0; p < PROFILE_PHASE_COUNT; p++) {
+        counters.calls[p] = profile.calls[p].load(std::memory_order_relaxed);
+        counters.nanoseconds[p] = profile.nanoseconds[p].load(std::memory_order_relaxed);
+    }
+    return counters;
+}
+
+}  // namespace
+
+// ===========================================================================
+// PROFILE COUNTERS
+// ===========================================================================
+
+const char* getProfilePhaseName(ProfilePhase phase) {
+    switch (phase) {
+        case ProfilePhase::CONFIG_LOAD:      return "config_load";
+        case ProfilePhase::INTEGRATOR_STEP:  return "integrator_step";
+        case ProfilePhase::ORBITAL_ELEMENTS: return "orbital_elements";
+        case ProfilePhase::COAST_CHECK:      return "coast_check";
+        case ProfilePhase::OUTPUT:           return "output";
+        default:                             return "unknown";
+    }
+}
+
+ProfileCounters ProfileCounters::operator-(const ProfileCounters& earlier) const {
+    ProfileCounters difference;
+    for (int p = 0; p < PROFILE_PHASE_COUNT; p++) {
+        difference.calls[p] = calls[p] - earlier.calls[p];
+        difference.nanoseconds[p] = nanoseconds[p] - earlier.nanoseconds[p];
+    }
+    return difference;
+}
+
+ProfileCounters& ProfileCounters::operator+=(const ProfileCounters& other) {
+    for (int p = 0; p < PROFILE_PHASE_COUNT; p++) {
+        calls[p] += other.calls[p];
+        nanoseconds[p] += other.nanoseconds[p];
+    }
+    return *this;
+}
+
+bool ProfileCounters::empty() const {
+    for (int p = 0; p < PROFILE_PHASE_COUNT; p++) {
+        if (calls[p] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+ProfileCounters threadProfile() {
+    ThreadProfile* profile = instrumentationEnabled() ? localProfile() : nullptr;
+    if (!profile) {
+        return ProfileCounters();
+    }
+    return snapshot(*profile);
+}
+
+ProfileCounters totalProfile() {
+    ProfileCounters total;
+    for (int i = 0; i < profiledThreads(); i++) {
+        total += snapshot(thread_profiles[i]);
+    }
+    return total;
+}
+
+// ===========================================================================
+// SCOPE RECORDING
+// ===========================================================================
+
+namespace instrumentation_detail {
+
+std::int64_t nowNanoseconds() {
+    static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - epoch).count();
+}
+
+void recordScope(ProfilePhase phase, std::int64_t start_ns, std::int64_t end_ns) {
+    ThreadProfile* profile = localProfile();
+    if (!profile) {
+        return;
+    }
+    int p = static_cast<int>(phase);
+    addRelaxed(profile->calls[p], 1);
+    addRelaxed(profile->nanoseconds[p], static_cast<std::uint64_t>(end_ns - start_ns));
+    
+    if (trace_enabled.load(std::memory_order_relaxed) &&
+        profile->trace.size() < TRACE_EVENTS_PER_THREAD) {
+        // One allocation on the thread's first traced scope, never a regrowth
+        if (profile->trace.capacity() < TRACE_EVENTS_PER_THREAD) {
+            profile->trace.reserve(TRACE_EVENTS_PER_THREAD);
+        }
+        profile->trace.push_back(TraceEvent{phase, start_ns, end_ns - start_ns});
+    }
+}
+
+}  // namespace instrumentation_detail
+
+// ===========================================================================
+// CHROME TRACE EXPORT
+// ===========================================================================
+
+void setTraceEnabled(bool enabled) {
+    trace_enabled.store(enabled);
+}
+
+bool writeChromeTrace(const std::string& filename) {
+    std::FILE* file = std::fopen(filename.c_str(), "w");
+    if (!file) {
+        std::cerr << "Error: Cannot open trace file: " << filename << "\n";
+        return false;
+    }
+    
+    // "Complete" events; timestamps and durations in microseconds
+    std::fprintf(file, "{\"traceEvents\":[");
+    bool first = true;
+    for (int i = 0; i < profiledThreads(); i++) {
+        const ThreadProfile& profile = thread_profiles[i];
+        for (const TraceEvent& event : profile.trace) {
+            std::fprintf(file, "%s\n{\"name\":\"%s\",\"cat\":\"ltmd\",\"ph\":\"X\","
+                               "\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}",
+                         first ? "" : ",", getProfilePhaseName(event.phase),
+                         event.start_ns * 1e-3, event.duration_ns * 1e-3, profile.thread_index);
+            first = false;
+        }
+    }
+    std::fprintf(file, "\n],\"displayTimeUnit\":\"ns\"}\n");
+    
+    bool ok = (std::ferror(file) == 0);
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok) {
+        std::cerr << "Error: Failed writing trace file: " << filename << "\n";
+    }
+    return ok;
+}
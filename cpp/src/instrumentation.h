@@ -0,0 +1,132 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// ===========================================================================
+// HOT-PATH INSTRUMENTATION
+// ===========================================================================
+// Scoped timers and call counters for the phases of a mission run:
+//
+//   config_load       loadConfigFromYAML
+//   integrator_step   one integrator step (or accepted adaptive step)
+//   orbital_elements  full elements for a step the trajectory sink keeps
+//   coast_check       apsides evaluation of the coast condition
+//   output            trajectory sink record/finish (formatting and I/O)
+//
+// The timers are only compiled in with the LTMD_ENABLE_INSTRUMENTATION
+// CMake option. Otherwise LTMD_PROFILE_SCOPE expands to nothing and the
+// hot paths are exactly the uninstrumented code; the functions below still
+// exist and report empty profiles.
+//
+// Every thread accumulates into its own counters (single writer, relaxed
+// atomics, no locks), so parallel batch workers never contend. A mission
+// runs on one thread, so threadProfile() taken before and after it gives
+// that mission's breakdown. With tracing switched on, every scope is also
+// logged as a Chrome trace event (chrome://tracing or ui.perfetto.dev).
+// ===========================================================================
+
+enum class ProfilePhase : int {
+    CONFIG_LOAD = 0,
+    INTEGRATOR_STEP = 1,
+    ORBITAL_ELEMENTS = 2,
+    COAST_CHECK = 3,
+    OUTPUT = 4
+};
+
+constexpr int PROFILE_PHASE_COUNT = 5;
+
+/// Phase name used in summaries and trace files
+const char* getProfilePhaseName(ProfilePhase phase);
+
+/// Calls and time per phase
+struct ProfileCounters {
+    std::uint64_t calls[PROFILE_PHASE_COUNT] = {};
+    std::uint64_t nanoseconds[PROFILE_PHASE_COUNT] = {};
+    
+    /// Counts accumulated since earlier (a snapshot of the same thread)
+    ProfileCounters operator-(const ProfileCounters& earlier) const;
+    ProfileCounters& operator+=(const ProfileCounters& other);
+    
+    bool empty() const;
+    double milliseconds(ProfilePhase phase) const {
+        return nanoseconds[static_cast<int>(phase)] * 1e-6;
+    }
+};
+
+/// Whether this build records anything
+constexpr bool instrumentationEnabled() {
+#ifdef LTMD_ENABLE_INSTRUMENTATION
+    return true;
+#else
+    return false;
+#endif
+}
+
+/// Totals of the calling thread since it started
+ProfileCounters threadProfile();
+
+/// Totals over every thread that has recorded a scope
+ProfileCounters totalProfile();
+
+/// Start or stop logging scopes as trace events
+/// Each thread keeps at most TRACE_EVENTS_PER_THREAD events; later scopes
+/// are still counted but not logged. A thread reserves its whole log on its
+/// first traced scope, so logging does not allocate after that.
+void setTraceEnabled(bool enabled);
+
+constexpr std::size_t TRACE_EVENTS_PER_THREAD = 1 << 20;
+
+/// Write the logged events as Chrome trace JSON
+/// Call once the propagations are done: the per-thread logs are read
+/// without locking.
+/// @return false (with a message on std::cerr) if the file cannot be written
+bool writeChromeTrace(const std::string& filename);
+
+// ===========================================================================
+// SCOPED TIMER
+// ===========================================================================
+
+namespace instrumentation_detail {
+
+/// Monotonic clock in nanoseconds since the first call
+std::int64_t nowNanoseconds();
+
+/// Add one scope to the calling thread's counters (and trace)
+void recordScope(ProfilePhase phase, std::int64_t start_ns, std::int64_t end_ns);
+
+}  // namespace instrumentation_detail
+
+/// Times its own lifetime as one call of phase
+/// Use through LTMD_PROFILE_SCOPE so it disappears from uninstrumented builds.
+class ScopedPhaseTimer {
+public:
+    explicit ScopedPhaseTimer(ProfilePhase phase)
+        : phase(phase), start_ns(instrumentation_detail::nowNanoseconds()) {}
+    ~ScopedPhaseTimer() {
+        instrumentation_detail::recordScope(phase, start_ns,
+                                            instrumentation_detail::nowNanoseconds());
+    }
+    
+    ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+    ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+
+private:
+    ProfilePhase phase;
+    std::int64_t start_ns;
+};
+
+#define LTMD_PROFILE_CONCAT_INNER(a, b) a##b
+#define LTMD_PROFILE_CONCAT(a, b) LTMD_PROFILE_CONCAT_INNER(a, b)
+
+/// Time the rest of the enclosing block as one call of ProfilePhase::phase
+#ifdef LTMD_ENABLE_INSTRUMENTATION
+#define LTMD_PROFILE_SCOPE(phase) \
+    ScopedPhaseTimer LTMD_PROFILE_CONCAT(ltmd_profile_scope_, __LINE__)(ProfilePhase::phase)
+#else
+#define LTMD_PROFILE_SCOPE(phase) ((void)0)
+#endif
+
+#endif // INSTRUMENTATION_H
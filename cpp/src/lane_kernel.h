@@ -0,0 +1,188 @@
+#ifndef LANE_KERNEL_H
+#define LANE_KERNEL_H
+
+#include <cmath>
+#include <cstdint>
+
+// ===========================================================================
+// ONE-SPACECRAFT RK4 LANE
+// ===========================================================================
+// The propagateMissionBatch loop for a single lane, with no arrays shared
+// between lanes: one GPU thread runs it for one spacecraft
+// (gpu_batch_kernel.cu), and the host runs it for the reference backend
+// (gpu_batch_propagator.h). The header is plain C++ plus
+// LTMD_HOST_DEVICE, so nvcc and the host compiler build the same source.
+//
+// The arithmetic mirrors the SoA kernels in batch_propagator.cpp
+// operation for operation: the same acceleration, the same stage sums in
+// the same order, the same mass-flow clamp and the same apsis formula for
+// the coast check. On the host a lane therefore matches the batched result
+// bit for bit. On a device it does too, provided the kernel is compiled
+// without fused multiply-adds (the CMake option passes --fmad=false) and
+// with IEEE division and square root (nvcc's default).
+
+#if defined(__CUDACC__) || defined(__HIPCC__)
+#define LTMD_HOST_DEVICE __host__ __device__
+#else
+#define LTMD_HOST_DEVICE
+#endif
+
+/// Settings shared by every lane of a launch
+struct LaneConstants {
+    double dt;                  // RK4 timestep (s)
+    double max_flight_time_s;   // Flight-time limit (s)
+    double mu;                  // Central-body gravitational parameter (km^3/s^2)
+    double g0;                  // Standard gravity for the mass flow (m/s^2)
+    double thrust_direction;    // +1 outbound, -1 inbound
+};
+
+/// Initial state and thruster of one lane
+struct LaneMission {
+    double x, y, z;             // Position (km)
+    double vx, vy, vz;          // Velocity (km/s)
+    double m;                   // Mass (kg)
+    double thrust_mN;           // Thrust (millinewtons)
+    double isp_s;               // Specific impulse (seconds)
+    double coast_radius;        // Coast once the apsis reaches this radius (km)
+};
+
+/// Final fields of one lane (the only data copied back from a device)
+struct LaneOutcome {
+    double x, y, z;
+    double vx, vy, vz;
+    double m;
+    double t;
+    double delta_v;             // Accumulated delta-V (km/s)
+    std::int64_t steps;         // Accepted steps
+    std::int64_t coast_step;    // Step at which the coast triggered, or -1
+};
+
+/// Gravity plus thrust, as accelerationKernel in batch_propagator.cpp
+LTMD_HOST_DEVICE inline void laneAcceleration(double x, double y, double z,
+                                              double vx, double vy, double vz,
+                                              double m, double thrust_mN,
+                                              const LaneConstants& c,
+                                              double& ax, double& ay, double& az) {
+    double r_mag = sqrt(x*x + y*y + z*z);
+    double r_cubed = r_mag * r_mag * r_mag;
+    double g = (r_mag < 1e-10) ? 0.0 : -c.mu / r_cubed;
+    
+    double v_mag = sqrt(vx*vx + vy*vy + vz*vz);
+    bool thrusting = (thrust_mN >= 1e-10) & (m >= 1e-10) & (v_mag >= 1e-10);
+    double a_mag = (thrust_mN * 1e-6) / m;
+    double f = thrusting ? c.thrust_direction * a_mag / v_mag : 0.0;
+    
+    ax = g * x + f * vx;
+    ay = g * y + f * vy;
+    az = g * z + f * vz;
+}
+
+/// Apoapsis (outbound) or periapsis (inbound), as the batch coast check
+LTMD_HOST_DEVICE inline double laneApsis(double x, double y, double z,
+                                         double vx, double vy, double vz,
+                                         double mu, double sign) {
+    double hx = y*vz - z*vy;
+    double hy = z*vx - x*vz;
+    double hz = x*vy - y*vx;
+    double h_mag = sqrt(hx*hx + hy*hy + hz*hz);
+    double r_mag = sqrt(x*x + y*y + z*z);
+    double v_mag_sq = vx*vx + vy*vy + vz*vz;
+    double energy = v_mag_sq / 2.0 - mu / r_mag;
+    double a = (fabs(energy) > 1e-15) ? -mu / (2.0 * energy) : 1e10;
+    double e_sq = 1.0 - (h_mag * h_mag) / (mu * a);
+    e_sq = (e_sq < 0) ? 0.0 : e_sq;
+    double e = (a > 0) ? sqrt(e_sq) : 2.0;
+    return a * (1.0 + sign * e);
+}
+
+/// Propagate one lane until it coasts, runs low on fuel or runs out of time
+LTMD_HOST_DEVICE inline void propagateLane(const LaneMission& mission, const LaneConstants& c,
+                                           LaneOutcome& out) {
+    double x = mission.x, y = mission.y, z = mission.z;
+    double vx = mission.vx, vy = mission.vy, vz = mission.vz;
+    double m = mission.m;
+    double t = 0;
+    double delta_v = 0;
+    std::int64_t steps = 0;
+    std::int64_t coast_step = -1;
+    
+    const double thrust = mission.thrust_mN;
+    const double dt = c.dt;
+    const double half_dt = dt / 2;
+    const double sixth_dt = dt / 6.0;
+    const double sign = c.thrust_direction > 0 ? 1.0 : -1.0;
+    const bool burning = (thrust > 1e-10) & (mission.isp_s > 1e-10);
+    const double dm_dt = -thrust * 1e-6 / (mission.isp_s * c.g0);
+    
+    while (true) {
+        // Termination checks, in propagateMission's order
+        if (t >= c.max_flight_time_s) {
+            break;
+        }
+        double apsis = laneApsis(x, y, z, vx, vy, vz, c.mu, sign);
+        bool coast_reached = (sign > 0) ? (apsis >= mission.coast_radius)
+                                        : (apsis <= mission.coast_radius);
+        if (coast_reached) {
+            coast_step = steps;
+            break;
+        }
+        if (m < 100) {
+            break;
+        }
+        
+        // Delta-V for this step uses the mass before the step
+        if (thrust > 1e-10) {
+            delta_v = delta_v + (thrust * 1e-6) / m * dt;
+        }
+        steps++;
+        
+        // STAGE 1: k1 = a(r, v)
+        double k1x, k1y, k1z;
+        laneAcceleration(x, y, z, vx, vy, vz, m, thrust, c, k1x, k1y, k1z);
+        
+        // STAGE 2: k2 = a(r + v*dt/2, v + k1*dt/2)
+        double sx = x + vx * half_dt, sy = y + vy * half_dt, sz = z + vz * half_dt;
+        double v2x = vx + k1x * half_dt, v2y = vy + k1y * half_dt, v2z = vz + k1z * half_dt;
+        double k2x, k2y, k2z;
+        laneAcceleration(sx, sy, sz, v2x, v2y, v2z, m, thrust, c, k2x, k2y, k2z);
+        
+        // STAGE 3: k3 = a(r + v*dt/2, v + k2*dt/2)
+        double v3x = vx + k2x * half_dt, v3y = vy + k2y * half_dt, v3z = vz + k2z * half_dt;
+        double k3x, k3y, k3z;
+        laneAcceleration(sx, sy, sz, v3x, v3y, v3z, m, thrust, c, k3x, k3y, k3z);
+        
+        // STAGE 4: k4 = a(r + v*dt + k3*dt²/2, v + k3*dt)
+        double dt2 = dt * dt / 2;
+        double s4x = x + vx * dt + k3x * dt2;
+        double s4y = y + vy * dt + k3y * dt2;
+        double s4z = z + vz * dt + k3z * dt2;
+        double v4x = vx + k3x * dt, v4y = vy + k3y * dt, v4z = vz + k3z * dt;
+        double k4x, k4y, k4z;
+        laneAcceleration(s4x, s4y, s4z, v4x, v4y, v4z, m, thrust, c, k4x, k4y, k4z);
+        
+        // COMBINE
+        x = x + sixth_dt * (vx + 2*v2x + 2*v3x + v4x);
+        y = y + sixth_dt * (vy + 2*v2y + 2*v3y + v4y);
+        z = z + sixth_dt * (vz + 2*v2z + 2*v3z + v4z);
+        vx = vx + sixth_dt * (k1x + 2*k2x + 2*k3x + k4x);
+        vy = vy + sixth_dt * (k1y + 2*k2y + 2*k3y + k4y);
+        vz = vz + sixth_dt * (k1z + 2*k2z + 2*k3z + k4z);
+        
+        // Mass flow, clamped at zero
+        if (burning) {
+            double m_new = m + dm_dt * dt;
+            m = (m_new < 0) ? 0.0 : m_new;
+        }
+        t = t + dt;
+    }
+    
+    out.x = x;   out.y = y;   out.z = z;
+    out.vx = vx; out.vy = vy; out.vz = vz;
+    out.m = m;
+    out.t = t;
+    out.delta_v = delta_v;
+    out.steps = steps;
+    out.coast_step = coast_step;
+}
+
+#endif // LANE_KERNEL_H
@@ -4,6 +4,8 @@
 #include <iomanip>
 #include <memory>
 #include <vector>
+#include <chrono>
+#include <algorithm>
 #include <sys/stat.h>
 #include <errno.h>
 #include <yaml-cpp/yaml.h>
@@ -14,6 +16,18 @@
 #include "comparison.h"
 #include "mission_batch.h"
 #include "mission_propagation.h"
+#include "parameter_sweep.h"
+#include "optimizer.h"
+#include "monte_carlo.h"
+#include "convergence_study.h"
+#include "mission_server.h"
+#include "pruning.h"
+#include "gpu_batch_propagator.h"
+#include "batch_shards.h"
+#include "thread_pool.h"
+#include "trajectory_file.h"
+#include "checkpoint.h"
+#include "instrumentation.h"
 
 
 // Forward declarations - these are defined in mission_batch.cpp
@@ -42,12 +56,225 @@ double parseTimestepOverride(int argc, char* argv[]) {
 }
 
 
+// ===========================================================================
+// HELPER: Parse command-line parallel job count
+// ===========================================================================
+
+unsigned parseJobsOption(int argc, char* argv[]) {
+    for (int i = 1; i < argc - 1; ++i) {
+        if (std::string(argv[i]) == "--jobs" || std::string(argv[i]) == "-j") {
+            try {
+                int jobs = std::stoi(argv[i + 1]);
+                if (jobs >= 0) {
+                    return static_cast<unsigned>(jobs);
+                }
+            } catch (...) {
+            }
+            std::cerr << "Warning: Invalid job count, running sequentially\n";
+        }
+    }
+    return 1;  // Default: sequential batch
+}
+
+
+// ===========================================================================
+// HELPER: Parse command-line CSV export flag
+// ===========================================================================
+
+bool parseCsvOption(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--csv") {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+// ===========================================================================
+// HELPER: Parse command-line result cache flag
+// ===========================================================================
+
+bool parseCacheOption(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--cache") {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+// ===========================================================================
+// HELPER: Parse command-line checkpoint options
+// ===========================================================================
+
+/// Checkpoint interval used by --resume when --checkpoint is not given (steps)
+constexpr long DEFAULT_CHECKPOINT_INTERVAL = 100000;
+
+long parseCheckpointOption(int argc, char* argv[]) {
+    for (int i = 1; i < argc - 1; ++i) {
+        if (std::string(argv[i]) == "--checkpoint") {
+            try {
+                long interval = std::stol(argv[i + 1]);
+                if (interval > 0) {
+                    return interval;
+                }
+            } catch (...) {
+            }
+            std::cerr << "Warning: Invalid checkpoint interval, checkpoints disabled\n";
+        }
+    }
+    return 0;  // Default: no checkpoints
+}
+
+bool parseResumeOption(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--resume") {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+// ===========================================================================
+// HELPER: Parse command-line asynchronous output option
+// ===========================================================================
+
+bool parseAsyncOutputOption(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--async-output") {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+// ===========================================================================
+// HELPER: Parse command-line pruning option
+// ===========================================================================
+
+std::string parsePruneOption(int argc, char* argv[]) {
+    for (int i = 1; i < argc - 1; ++i) {
+        if (std::string(argv[i]) == "--prune") {
+            if (isMissionMetric(argv[i + 1])) {
+                return argv[i + 1];
+            }
+            std::cerr << "Warning: Unknown pruning metric '" << argv[i + 1]
+                      << "' (shortest_time, lowest_delta_v, least_fuel or most_efficient), "
+                      << "pruning disabled\n";
+        }
+    }
+    return "";  // Default: run every mission to the end
+}
+
+// ===========================================================================
+// HELPER: Parse command-line shard and MPI options
+// ===========================================================================
+
+/// --shard i/N: whether to run one shard of the batch (and which)
+bool parseShardOption(int argc, char* argv[], ShardSpec& spec) {
+    for (int i = 1; i < argc - 1; ++i) {
+        if (std::string(argv[i]) == "--shard") {
+            if (parseShardSpec(argv[i + 1], spec)) {
+                return true;
+            }
+            std::cerr << "Warning: Running the whole batch\n";
+        }
+    }
+    return false;  // Default: every mission in this process
+}
+
+bool parseMpiOption(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--mpi") {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ===========================================================================
+// HELPER: Parse command-line batch backend option
+// ===========================================================================
+
+std::string parseBackendOption(int argc, char* argv[]) {
+    for (int i = 1; i < argc - 1; ++i) {
+        if (std::string(argv[i]) == "--backend") {
+            if (isBatchBackend(argv[i + 1])) {
+                return argv[i + 1];
+            }
+            std::cerr << "Warning: Unknown batch backend '" << argv[i + 1]
+                      << "' (cpu, lanes or gpu), using cpu\n";
+        }
+    }
+    return "cpu";  // Default: SoA kernels
+}
+
+/// "Batch backend: gpu (<device>)" for sweeps, optimizations and Monte Carlo runs
+void printBackend(const std::string& backend) {
+    if (backend == "cpu") {
+        return;
+    }
+    std::cout << "Batch backend: " << backend;
+    if (backend == "gpu") {
+        std::cout << " (" << gpuBatchDescription() << ")";
+    }
+    std::cout << "\n";
+}
+
+/// What --prune saved, after a batch or sweep
+void printPruningStats(const PruningBound& pruning) {
+    PruningStats stats = pruning.stats();
+    std::cout << "Pruned on " << pruning.metric() << ": " << stats.pruned << " of "
+              << stats.missions << " missions stopped early\n";
+    std::cout << "  Steps integrated: " << stats.steps << " (" << stats.pruned_steps
+              << " by pruned missions)\n";
+    std::cout << "  Steps skipped: at most " << stats.steps_skipped
+              << " (flight-time budget the pruned missions had left)\n";
+}
+
+
+// ===========================================================================
+// HELPER: Parse command-line trace export option
+// ===========================================================================
+
+std::string parseTraceOption(int argc, char* argv[]) {
+    for (int i = 1; i < argc - 1; ++i) {
+        if (std::string(argv[i]) == "--trace") {
+            return argv[i + 1];
+        }
+    }
+    return "";  // Default: no trace
+}
+
+
+// ===========================================================================
+// HELPER: Print command-line usage
+// ===========================================================================
+
+/// One line per mode; shared by the no-arguments screen and argument errors
+void printUsage(std::ostream& out) {
+    out << "  Single mission:  ./propagator <config.yaml> [--timestep <seconds>] [--csv] [--checkpoint <steps>] [--resume] [--async-output] [--trace <trace.json>]\n";
+    out << "  Batch missions:  ./propagator --batch <batch_config.txt> [--timestep <seconds>] [--jobs <N>] [--csv] [--cache] [--checkpoint <steps>] [--resume] [--async-output] [--prune <metric>] [--shard <i/N>] [--mpi] [--trace <trace.json>]\n";
+    out << "  Parameter sweep: ./propagator --sweep <sweep.yaml> [--timestep <seconds>] [--jobs <N>] [--prune <metric>] [--backend <cpu|lanes|gpu>] [--trace <trace.json>]\n";
+    out << "  Optimization:    ./propagator --optimize <spec.yaml> [--timestep <seconds>] [--jobs <N>] [--cache] [--backend <cpu|lanes|gpu>]\n";
+    out << "  Monte Carlo:     ./propagator --monte-carlo <spec.yaml> [--timestep <seconds>] [--jobs <N>] [--backend <cpu|lanes|gpu>]\n";
+    out << "  Convergence:     ./propagator --convergence <config.yaml> [--jobs <N>]\n";
+    out << "  Service:         ./propagator --serve [--jobs <N>]\n";
+}
+
+
 // ===========================================================================
 // MISSION RUNNER (Single Mission)
 // ===========================================================================
 
 
-void runSingleMissionMode(const std::string& config_path, double timestep_override = -1.0) {
+void runSingleMissionMode(const std::string& config_path, double timestep_override = -1.0,
+                          bool export_csv = false, long checkpoint_interval = 0,
+                          bool resume = false, bool async_output = false) {
     std::cout << "\n";
     std::cout << "=====================================================\n";
     std::cout << "ORBITAL TRANSFER PROPAGATOR - SINGLE MISSION MODE\n";
@@ -60,6 +287,12 @@ void runSingleMissionMode(const std::string& config_path, double timestep_overri
     if (timestep_override > 0) {
         config.timestep_s = timestep_override;
     }
+    if (export_csv && config.output_format == "binary") {
+        config.output_format = "both";
+    }
+    if (async_output) {
+        config.async_output = true;
+    }
     
     std::cout << "Configuration loaded from: " << config_path << "\n";
     std::cout << "  Spacecraft: " << config.spacecraft.name << "\n";
@@ -69,6 +302,18 @@ void runSingleMissionMode(const std::string& config_path, double timestep_overri
     std::cout << "  From: " << getBodyName(config.departure_body) << "\n";
     std::cout << "  To: " << getBodyName(config.arrival_body) << "\n";
     std::cout << "  Integrator: " << config.integrator << "\n";
+    if (config.precision != "double") {
+        std::cout << "  Precision: " << config.precision << "\n";
+    }
+    for (const PerturbationSpec& spec : config.perturbations) {
+        if (spec.enabled) {
+            std::cout << "  Perturbation: " << spec.type;
+            if (spec.type == "third_body") {
+                std::cout << " (" << getBodyName(spec.body) << ")";
+            }
+            std::cout << "\n";
+        }
+    }
     std::cout << "  Timestep: " << config.timestep_s << " s";
     if (timestep_override > 0) {
         config.timestep_s = timestep_override;
@@ -88,12 +333,42 @@ void runSingleMissionMode(const std::string& config_path, double timestep_overri
     std::cout << "  Mass: " << std::fixed << std::setprecision(1) 
               << config.spacecraft.initial_mass_kg << " kg\n\n";
     
-    std::cout << "Using " << (config.integrator == "rk4" ? "RK4" : "Euler") << " integrator\n\n";
+    std::cout << "Using " << getIntegratorDisplayName(config.integrator) << " integrator";
+    if (isAdaptiveIntegrator(config.integrator)) {
+        std::cout << " (abs_tol=" << std::scientific << std::setprecision(1) << config.abs_tol
+                  << ", rel_tol=" << config.rel_tol << ")";
+    }
+    std::cout << "\n\n";
     
     // Create results directory
     std::string results_dir = "../results";
     createDirectory(results_dir);
     
+    // Checkpoint next to the trajectory: results/<output name>.ckpt
+    if (checkpoint_interval > 0) {
+        config.checkpoint_interval = checkpoint_interval;
+    }
+    if (config.checkpoint_interval > 0 || resume) {
+        std::string checkpoint_path = results_dir + "/" + config.output_filename;
+        size_t last_dot = checkpoint_path.find_last_of('.');
+        size_t last_slash = checkpoint_path.find_last_of('/');
+        if (last_dot != std::string::npos && last_dot > last_slash) {
+            checkpoint_path = checkpoint_path.substr(0, last_dot);
+        }
+        config.checkpoint_file = checkpoint_path + ".ckpt";
+        config.resume = resume;
+        if (config.checkpoint_interval > 0) {
+            std::cout << "Checkpoint every " << config.checkpoint_interval << " steps: "
+                      << config.checkpoint_file << "\n";
+        }
+        PropagationCheckpoint saved;
+        if (resume && findCheckpoint(config, saved)) {
+            std::cout << "Resuming from step " << saved.step << " (t="
+                      << std::fixed << std::setprecision(1) << saved.state.t / 86400.0
+                      << " days)\n";
+        }
+    }
+    
     // Propagate mission
     std::cout << "Propagating...\n";
     PropagationResult prop_result = propagateMission(config, r_dep, r_arr, true,
@@ -102,10 +377,25 @@ void runSingleMissionMode(const std::string& config_path, double timestep_overri
     if (prop_result.coast_step >= 0) {
         std::cout << "  Coast activated at step " << prop_result.coast_step 
                   << " (t=" << std::fixed << std::setprecision(1) 
-                  << prop_result.final_state.t / 86400.0 << " days)\n";
+                  << prop_result.coast_state.t / 86400.0 << " days)\n";
+    }
+    if (prop_result.coast_arc_s > 0) {
+        std::cout << "  Coast arc (" << config.coast_mode << "): "
+                  << std::fixed << std::setprecision(1)
+                  << prop_result.coast_arc_s / 86400.0 << " days"
+                  << (prop_result.arrival_reached ? ", arrival radius reached" : "") << "\n";
     }
     
     std::cout << "\nPropagation Complete!\n\n";
+    if (isAdaptiveIntegrator(config.integrator)) {
+        std::cout << "Adaptive Steps:\n";
+        std::cout << "  Accepted: " << prop_result.accepted_steps << "\n";
+        std::cout << "  Rejected: " << prop_result.rejected_steps << "\n\n";
+    }
+    if (config.integrator == "averaged") {
+        std::cout << "Averaged Steps: " << prop_result.averaged_steps << ", then "
+                  << prop_result.accepted_steps - prop_result.averaged_steps << " RK4 steps\n\n";
+    }
     std::cout << "Final State:\n";
     std::cout << "  Time: " << std::fixed << std::setprecision(2) 
               << prop_result.final_state.t / 86400.0 << " days\n";
@@ -131,7 +421,42 @@ void runSingleMissionMode(const std::string& config_path, double timestep_overri
     std::cout << "  Semi-major axis: " << std::scientific << std::setprecision(3) 
               << final_elements.a << " km\n\n";
     
-    std::cout << "Results saved to: " << results_dir << "/" << config.output_filename << "\n";
+    if (prop_result.has_sensitivity) {
+        // Thruster columns of the Jacobian of the thrust-arc end state
+        const auto& jacobian = prop_result.sensitivity.jacobian;
+        const char* rows[] = {"rx (km)", "ry (km)", "rz (km)", "vx (km/s)", "vy (km/s)",
+                              "vz (km/s)", "m (kg)"};
+        std::cout << "Sensitivity at Thrust-Arc End:\n";
+        std::cout << "  " << std::left << std::setw(12) << "" << std::setw(14) << "per mN"
+                  << "per s ISP\n";
+        for (int i = 0; i < StateSensitivity::ROWS; i++) {
+            std::cout << "  " << std::setw(12) << rows[i] << std::scientific
+                      << std::setprecision(4) << std::setw(14)
+                      << jacobian[i][StateSensitivity::THRUST]
+                      << jacobian[i][StateSensitivity::ISP] << "\n";
+        }
+        std::cout << std::right << "\n";
+    }
+    
+    std::string trajectory_path = results_dir + "/" + config.output_filename;
+    if (config.output_format != "csv") {
+        std::cout << "Results saved to: " << binaryTrajectoryPath(trajectory_path) << "\n";
+    }
+    if (config.output_format == "csv" || config.output_format == "both") {
+        std::cout << "Results saved to: " << trajectory_path << "\n";
+    }
+    
+    ProfileCounters profile = threadProfile();
+    if (!profile.empty()) {
+        std::cout << "\nTime by Phase:\n";
+        for (int p = 0; p < PROFILE_PHASE_COUNT; p++) {
+            ProfilePhase phase = static_cast<ProfilePhase>(p);
+            std::cout << "  " << std::left << std::setw(18) << getProfilePhaseName(phase)
+                      << std::right << std::fixed << std::setprecision(2) << std::setw(10)
+                      << profile.milliseconds(phase) << " ms  (" << profile.calls[p]
+                      << " calls)\n";
+        }
+    }
     std::cout << "=====================================================\n\n";
 }
 
@@ -142,7 +467,17 @@ void runSingleMissionMode(const std::string& config_path, double timestep_overri
 // ===========================================================================
 
 
-void runBatchMissionMode(const std::string& batch_config_file, double timestep_override = -1.0) {
+bool runBatchMissionMode(const std::string& batch_config_file, double timestep_override = -1.0,
+                         unsigned jobs = 1, bool export_csv = false, bool use_cache = false,
+                         long checkpoint_interval = 0, bool resume = false,
+                         bool async_output = false, const std::string& prune_metric = "",
+                         const ShardSpec* shard = nullptr, bool use_mpi = false) {
+    if (use_mpi && !mpiBatchAvailable()) {
+        std::cerr << "Warning: --mpi needs a build with -DLTMD_ENABLE_MPI=ON, "
+                  << "running the batch in this process\n";
+        use_mpi = false;
+    }
+    
     std::cout << "\n";
     std::cout << "=====================================================\n";
     std::cout << "ORBITAL TRANSFER PROPAGATOR - BATCH MODE\n";
@@ -154,7 +489,7 @@ void runBatchMissionMode(const std::string& batch_config_file, double timestep_o
     
     if (!batch_file.is_open()) {
         std::cerr << "Error: Cannot open batch config file: " << batch_config_file << "\n";
-        return;
+        return false;
     }
     
     std::string line;
@@ -171,28 +506,477 @@ void runBatchMissionMode(const std::string& batch_config_file, double timestep_o
     }
     batch_file.close();
     
+    // A shard runs every N-th mission; the rest belong to other processes
+    std::size_t batch_missions = config_files.size();
+    std::vector<std::size_t> shard_indices;
+    if (shard) {
+        shard_indices = shardMissions(*shard, batch_missions);
+        std::vector<std::string> shard_files;
+        for (std::size_t index : shard_indices) {
+            shard_files.push_back(config_files[index]);
+        }
+        config_files.swap(shard_files);
+    }
+    
     std::cout << "Batch configuration loaded: " << batch_config_file << "\n";
+    if (shard) {
+        std::cout << "Shard: " << shard->index << "/" << shard->count << " (missions "
+                  << shard->index << ", " << shard->index + shard->count << ", ... of "
+                  << batch_missions << ")\n";
+    }
     std::cout << "Missions to run: " << config_files.size() << "\n";
+    if (use_mpi) {
+        std::cout << "MPI: missions handed out by rank 0 on request\n";
+    }
     if (timestep_override > 0) {
         std::cout << "Timestep override: " << timestep_override << " s\n";
     }
+    if (jobs != 1) {
+        std::cout << "Parallel jobs: " << ThreadPool::resolveThreadCount(jobs) << "\n";
+    }
+    if (export_csv) {
+        std::cout << "Trajectory CSV export: enabled\n";
+    }
+    if (async_output) {
+        std::cout << "Trajectory output: one shared I/O thread\n";
+    }
+    // Checkpointed batches record finished missions in the cache, so that
+    // --resume only continues the missions that did not finish
+    if (checkpoint_interval > 0 || resume) {
+        use_cache = true;
+        std::cout << "Checkpoints: ../results/checkpoints";
+        if (checkpoint_interval > 0) {
+            std::cout << " (every " << checkpoint_interval << " steps)";
+        }
+        std::cout << (resume ? ", resuming unfinished missions" : "") << "\n";
+    }
+    if (use_cache) {
+        std::cout << "Result cache: ../results/cache\n";
+    }
+    if (!prune_metric.empty()) {
+        std::cout << "Pruning: stop missions that cannot beat the best " << prune_metric << "\n";
+    }
     std::cout << "\n";
     
     // Create batch runner and execute missions
     // NOTE: If your MissionBatchRunner needs timestep override, add support there
     MissionBatchRunner batch_runner;
-    MissionComparison comparison = batch_runner.runBatchMissions(config_files);
+    if (export_csv) {
+        batch_runner.setCsvExport(true);
+    }
+    if (use_cache) {
+        batch_runner.setCacheDirectory("../results/cache");
+    }
+    batch_runner.setCheckpointing(checkpoint_interval, resume);
+    batch_runner.setAsyncOutput(async_output);
+    batch_runner.setPruning(prune_metric);
+    MissionComparison comparison;
+    if (use_mpi) {
+        MpiBatchStatus status = runBatchMissionsMpi(batch_runner, config_files, comparison);
+        if (status == MpiBatchStatus::FAILED) {
+            return false;  // No comparison rather than one with holes
+        }
+        if (status == MpiBatchStatus::WORKER) {
+            return true;   // Rank 0 reports the batch
+        }
+    } else {
+        comparison = batch_runner.runBatchMissions(config_files, jobs);
+    }
+    if (use_cache) {
+        std::cout << "Reused " << batch_runner.cacheHits() << " of " << config_files.size()
+                  << " missions from the result cache\n";
+    }
+    if (batch_runner.pruning()) {
+        printPruningStats(*batch_runner.pruning());
+    }
     
     // Print summary to console
     std::cout << "\n";
     comparison.printSummary();
     
-    // Write detailed comparison CSV
+    // Write detailed comparison CSV (one partial file per shard, see
+    // tools/merge_comparison.cpp)
     std::string results_dir = "../results";
     createDirectory(results_dir);
-    comparison.writeComparisonCSV(results_dir + "/mission_comparison.csv");
+    if (shard) {
+        writeShardCSV(shardFileName(results_dir, *shard), *shard, batch_missions, shard_indices,
+                      comparison);
+    } else {
+        comparison.writeComparisonCSV(results_dir + "/mission_comparison.csv");
+    }
+    
+    std::cout << "=====================================================\n\n";
+    return true;
+}
+
+
+// ===========================================================================
+// PARAMETER SWEEP RUNNER
+// ===========================================================================
+
+
+void runSweepMode(const std::string& sweep_file, double timestep_override = -1.0,
+                  unsigned jobs = 1, const std::string& prune_metric = "",
+                  const std::string& backend = "cpu") {
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "ORBITAL TRANSFER PROPAGATOR - PARAMETER SWEEP\n";
+    std::cout << "=====================================================\n\n";
+    
+    ParameterSweep sweep;
+    if (!loadSweepFromYAML(sweep_file, sweep)) {
+        return;
+    }
+    if (timestep_override > 0) {
+        sweep.base.timestep_s = timestep_override;  // Unless swept
+    }
+    sweep.base.batch_backend = backend;
+    
+    std::cout << "Sweep loaded: " << sweep_file << "\n";
+    std::cout << "Grid: " << std::max<size_t>(sweep.thrust_mN.size(), 1) << " thrust x "
+              << std::max<size_t>(sweep.isp_s.size(), 1) << " ISP x "
+              << std::max<size_t>(sweep.initial_mass_kg.size(), 1) << " mass x "
+              << std::max<size_t>(sweep.timestep_s.size(), 1) << " timestep x "
+              << std::max<size_t>(sweep.destinations.size(), 1) << " destination = "
+              << sweep.size() << " missions\n";
+    std::cout << "Parallel jobs: " << ThreadPool::resolveThreadCount(jobs) << "\n";
+    printBackend(backend);
+    
+    // Only a coasted point can be the sweep's best, so only those set the bound
+    std::unique_ptr<PruningBound> pruning;
+    if (!prune_metric.empty()) {
+        pruning = std::make_unique<PruningBound>(prune_metric, true);
+        std::cout << "Pruning: stop points that cannot beat the best coasted "
+                  << prune_metric << "\n";
+    }
+    std::cout << "\n";
+    
+    auto start = std::chrono::steady_clock::now();
+    MissionSummary summary;
+    std::vector<SweepPointResult> results = runParameterSweep(sweep, jobs, pruning.get(), &summary);
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    // Fastest point that reached coast
+    size_t coasted = 0;
+    size_t fastest = results.size();
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (!results[i].coasted) continue;
+        coasted++;
+        if (fastest == results.size() ||
+            results[i].flight_time_days < results[fastest].flight_time_days) {
+            fastest = i;
+        }
+    }
+    
+    std::cout << "Missions propagated: " << results.size() << " in " << std::fixed
+              << std::setprecision(2) << elapsed << " s ("
+              << std::setprecision(0) << results.size() / std::max(elapsed, 1e-9)
+              << " missions/s)\n";
+    std::cout << "Reached coast: " << coasted << "\n";
+    // Pruning on another metric cuts the slower points short, so the
+    // shortest flight among the survivors would mean nothing
+    if (fastest < results.size() && (!pruning || prune_metric == "shortest_time")) {
+        const SweepPointResult& best = results[fastest];
+        std::cout << "Shortest flight: #" << fastest << " to "
+                  << getBodyName(best.destination) << ", " << std::setprecision(0)
+                  << best.thrust_mN << " mN, " << best.isp_s << " s ISP, "
+                  << best.initial_mass_kg << " kg -> " << std::setprecision(1)
+                  << best.flight_time_days << " days\n";
+    }
+    
+    if (pruning) {
+        // Best coasted point on the pruning metric (pruned points never coast)
+        size_t best_index = results.size();
+        double best_score = 0;
+        for (size_t i = 0; i < results.size(); ++i) {
+            const SweepPointResult& point = results[i];
+            if (!point.coasted) continue;
+            double score = pruning->score(point.flight_time_days * 86400.0,
+                                          point.total_delta_v_km_s, point.final_mass_kg,
+                                          point.initial_mass_kg);
+            if (best_index == results.size() || score < best_score) {
+                best_index = i;
+                best_score = score;
+            }
+        }
+        if (best_index < results.size() && prune_metric != "shortest_time") {
+            const SweepPointResult& best = results[best_index];
+            std::cout << "Best " << prune_metric << ": #" << best_index << " to "
+                      << getBodyName(best.destination) << ", " << std::setprecision(0)
+                      << best.thrust_mN << " mN, " << best.isp_s << " s ISP, "
+                      << best.initial_mass_kg << " kg -> " << std::setprecision(3)
+                      << best.total_delta_v_km_s << " km/s, " << std::setprecision(1)
+                      << best.initial_mass_kg - best.final_mass_kg << " kg propellant\n";
+        }
+        printPruningStats(*pruning);
+    }
+    
+    // Coasted points by destination, accumulated by the workers
+    std::cout << "\n";
+    summary.print();
+    
+    std::string results_dir = "../results";
+    createDirectory(results_dir);
+    std::string table_path = results_dir + "/" + sweep.output_filename;
+    if (writeSweepCSV(table_path, results, pruning != nullptr)) {
+        std::cout << "Sweep table saved to: " << table_path << "\n";
+    }
+    std::cout << "=====================================================\n\n";
+}
+
+
+// ===========================================================================
+// OPTIMIZATION MODE: Multi-start thrust/ISP/mass selection
+// ===========================================================================
+
+void runOptimizationMode(const std::string& spec_file, double timestep_override = -1.0,
+                         unsigned jobs = 1, bool use_cache = false,
+                         const std::string& backend = "cpu") {
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "ORBITAL TRANSFER PROPAGATOR - THRUSTER OPTIMIZATION\n";
+    std::cout << "=====================================================\n\n";
+    
+    OptimizationSpec spec;
+    if (!loadOptimizationFromYAML(spec_file, spec)) {
+        return;
+    }
+    if (timestep_override > 0) {
+        spec.base.timestep_s = timestep_override;
+    }
+    spec.base.batch_backend = backend;
+    
+    std::cout << "Spec loaded: " << spec_file << "\n";
+    printBackend(backend);
+    std::cout << "Objective: " << spec.objective;
+    if (spec.propellant_budget_kg > 0) {
+        std::cout << " (propellant budget " << std::fixed << std::setprecision(0)
+                  << spec.propellant_budget_kg << " kg)";
+    }
+    std::cout << "\n";
+    std::cout << "Free parameters: " << spec.dimensions() << ", starts: " << spec.starts
+              << ", max evaluations per start: " << spec.max_evaluations << "\n";
+    std::cout << "Parallel jobs: " << ThreadPool::resolveThreadCount(jobs) << "\n";
+    std::string results_dir = "../results";
+    std::string cache_directory;
+    if (use_cache) {
+        cache_directory = results_dir + "/cache";
+        std::cout << "Result cache: " << cache_directory << "\n";
+    }
+    std::cout << "\n";
+    
+    auto start = std::chrono::steady_clock::now();
+    OptimizationResult result = runOptimization(spec, jobs, cache_directory);
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    std::cout << std::left << std::setw(7) << "Start" << std::setw(12) << "Thrust(mN)"
+              << std::setw(10) << "ISP(s)" << std::setw(12) << "Mass(kg)" << std::setw(10)
+              << "Days" << std::setw(14) << "Propellant" << "Status\n";
+    for (size_t s = 0; s < result.starts.size(); ++s) {
+        const OptimizationStart& run = result.starts[s];
+        std::cout << std::left << std::setw(7) << s << std::fixed << std::setprecision(1)
+                  << std::setw(12) << run.best.thrust_mN << std::setw(10) << run.best.isp_s
+                  << std::setw(12) << run.best.initial_mass_kg << std::setw(10)
+                  << run.best.mission.flight_time_days << std::setw(14)
+                  << run.best.mission.propellant_consumed_kg
+                  << (run.best.feasible ? "" : "infeasible, ")
+                  << (run.converged ? "converged" : "evaluation limit")
+                  << (s == result.best_start ? " *" : "") << "\n";
+    }
+    std::cout << std::right << "\n";
+    
+    std::cout << "Candidates evaluated: " << result.evaluations << " in " << result.generations
+              << " generations, " << std::setprecision(2) << elapsed << " s\n";
+    if (use_cache) {
+        std::cout << "Cache hits: " << result.cache_hits << "\n";
+    }
+    if (result.feasible) {
+        const OptimizationPoint& best = result.starts[result.best_start].best;
+        std::cout << "Best design (" << spec.objective << "): " << std::setprecision(1)
+                  << best.thrust_mN << " mN, " << best.isp_s << " s ISP, "
+                  << best.initial_mass_kg << " kg -> " << best.mission.flight_time_days
+                  << " days, " << best.mission.propellant_consumed_kg << " kg propellant\n";
+    } else {
+        std::cout << "No feasible design found\n";
+    }
+    
+    createDirectory(results_dir);
+    std::string table_path = results_dir + "/" + spec.output_filename;
+    if (writeOptimizationCSV(table_path, result)) {
+        std::cout << "Optimization table saved to: " << table_path << "\n";
+    }
+    std::cout << "=====================================================\n\n";
+}
+
+
+// ===========================================================================
+// MONTE CARLO MODE: Thruster and mass dispersions
+// ===========================================================================
+
+void runMonteCarloMode(const std::string& spec_file, double timestep_override = -1.0,
+                       unsigned jobs = 1, const std::string& backend = "cpu") {
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "ORBITAL TRANSFER PROPAGATOR - MONTE CARLO DISPERSIONS\n";
+    std::cout << "=====================================================\n\n";
+    
+    MonteCarloSpec spec;
+    if (!loadMonteCarloFromYAML(spec_file, spec)) {
+        return;
+    }
+    if (timestep_override > 0) {
+        spec.base.timestep_s = timestep_override;
+    }
+    spec.base.batch_backend = backend;
+    
+    std::cout << "Spec loaded: " << spec_file << "\n";
+    printBackend(backend);
+    std::cout << "Nominal: " << spec.base.spacecraft.name << ", " << std::fixed
+              << std::setprecision(1) << spec.base.spacecraft.thrust_mN << " mN, "
+              << spec.base.spacecraft.isp_s << " s ISP, " << spec.base.spacecraft.initial_mass_kg
+              << " kg, " << getBodyName(spec.base.departure_body) << " -> "
+              << getBodyName(spec.base.arrival_body) << "\n";
+    std::cout << "Samples: " << spec.samples << " (seed " << spec.seed << ")\n";
+    std::cout << "Parallel jobs: " << ThreadPool::resolveThreadCount(jobs) << "\n\n";
+    
+    auto start = std::chrono::steady_clock::now();
+    MonteCarloResult result = runMonteCarlo(spec, jobs);
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    std::cout << std::left << std::setw(18) << "Metric" << std::setw(14) << "Mean"
+              << std::setw(14) << "StdDev";
+    for (double percentile : spec.percentiles) {
+        std::ostringstream label;
+        label << "P" << percentile;
+        std::cout << std::setw(14) << label.str();
+    }
+    std::cout << "\n";
+    for (const MetricSummary& summary : result.metrics) {
+        std::cout << std::left << std::setw(18) << summary.name << std::setprecision(3)
+                  << std::setw(14) << summary.statistics.mean()
+                  << std::setw(14) << summary.statistics.stddev();
+        for (const StreamingQuantile& quantile : summary.quantiles) {
+            std::cout << std::setw(14) << quantile.value();
+        }
+        std::cout << "\n";
+    }
+    std::cout << std::right << "\n";
+    
+    std::cout << "Missions propagated: " << result.samples << " in " << std::setprecision(2)
+              << elapsed << " s (" << std::setprecision(0)
+              << result.samples / std::max(elapsed, 1e-9) << " missions/s)\n";
+    std::cout << "Reached coast: " << result.coasted << " (" << std::setprecision(2)
+              << 100.0 * result.coasted / std::max<size_t>(result.samples, 1) << "%)\n";
+    
+    std::string results_dir = "../results";
+    createDirectory(results_dir);
+    std::string table_path = results_dir + "/" + spec.output_filename;
+    if (writeMonteCarloCSV(table_path, spec, result)) {
+        std::cout << "Statistics table saved to: " << table_path << "\n";
+    }
+    std::cout << "=====================================================\n\n";
+}
+
+
+// ===========================================================================
+// TIMESTEP CONVERGENCE STUDY
+// ===========================================================================
 
+void runConvergenceMode(const std::string& config_file, double timestep_override = -1.0,
+                        unsigned jobs = 1) {
+    if (timestep_override > 0) {
+        std::cerr << "Warning: --timestep is ignored by --convergence; "
+                  << "set convergence.timesteps in the config file\n";
+    }
+    
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "ORBITAL TRANSFER PROPAGATOR - CONVERGENCE STUDY\n";
     std::cout << "=====================================================\n\n";
+    
+    ConvergenceSpec spec;
+    if (!loadConvergenceFromYAML(config_file, spec)) {
+        return;
+    }
+    
+    std::cout << "Mission loaded: " << config_file << "\n";
+    std::cout << "Mission: " << spec.base.spacecraft.name << ", "
+              << getBodyName(spec.base.departure_body) << " -> "
+              << getBodyName(spec.base.arrival_body) << "\n";
+    std::cout << "Timesteps:";
+    for (double timestep : spec.timesteps) {
+        std::cout << " " << timestep;
+    }
+    std::cout << " s\n";
+    std::cout << "Parallel jobs: " << ThreadPool::resolveThreadCount(jobs) << "\n\n";
+    
+    auto start = std::chrono::steady_clock::now();
+    ConvergenceResult result = runConvergenceStudy(spec, jobs);
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    // Flight time, delta-V, semi-major axis and eccentricity; the file has all
+    const std::size_t shown[] = {0, 1, 3, 4};
+    for (const MethodConvergence& convergence : result.methods) {
+        std::cout << getIntegratorDisplayName(convergence.method) << ":\n";
+        std::cout << std::left << std::setw(14) << "  Timestep(s)" << std::setw(10) << "Steps";
+        for (std::size_t q : shown) {
+            std::cout << std::setw(20) << CONVERGENCE_COLUMNS[q];
+        }
+        std::cout << "\n";
+        for (const ConvergenceRun& run : convergence.runs) {
+            std::ostringstream timestep;
+            timestep << "  " << run.timestep_s;
+            std::cout << std::setw(14) << timestep.str() << std::setw(10) << run.steps;
+            for (std::size_t q : shown) {
+                std::cout << std::setw(20) << std::setprecision(10) << run.values[q];
+            }
+            std::cout << (run.coasted ? "" : "  (no coast)") << "\n";
+        }
+        std::cout << std::setw(24) << "  Richardson";
+        for (std::size_t q : shown) {
+            std::cout << std::setw(20) << std::setprecision(10) << convergence.extrapolated[q];
+        }
+        std::cout << "\n" << std::setw(24) << "  Observed order";
+        for (std::size_t q : shown) {
+            std::cout << std::setw(20) << std::setprecision(3) << convergence.order[q];
+        }
+        std::cout << std::right << "\n\n";
+    }
+    
+    std::size_t runs = spec.methods.size() * spec.timesteps.size();
+    std::cout << "Runs propagated: " << runs << " in " << std::fixed << std::setprecision(2)
+              << elapsed << " s\n";
+    
+    std::string results_dir = "../results";
+    createDirectory(results_dir);
+    std::string table_path = results_dir + "/" + spec.output_filename;
+    if (writeConvergenceCSV(table_path, result)) {
+        std::cout << "Convergence table saved to: " << table_path << "\n";
+    }
+    std::cout << "=====================================================\n\n";
+}
+
+
+// ===========================================================================
+// SERVICE MODE: JSON-lines mission requests on stdin (stdout carries only
+// the replies, so every message goes to stderr)
+// ===========================================================================
+
+void runServeMode(unsigned jobs = 1) {
+    std::cerr << "Serving mission requests on stdin ("
+              << ThreadPool::resolveThreadCount(jobs) << " jobs)\n";
+    
+    MissionServer server(jobs);
+    std::size_t handled = server.serve(std::cin, std::cout);
+    
+    ServerStatistics stats = server.statistics();
+    std::cerr << "Requests handled: " << handled << " (" << stats.errors << " errors, "
+              << stats.cached_configs << " base configs parsed)\n";
+    if (stats.completed > 0) {
+        std::cerr << std::fixed << std::setprecision(3) << "Latency: mean " << stats.mean_ms
+                  << " ms, p50 " << stats.p50_ms << " ms, p90 " << stats.p90_ms
+                  << " ms, p99 " << stats.p99_ms << " ms, max " << stats.max_ms << " ms\n";
+    }
 }
 
 
@@ -202,47 +986,123 @@ void runBatchMissionMode(const std::string& batch_config_file, double timestep_o
 
 
 int main(int argc, char* argv[]) {
-    std::cout << "\n";
-    std::cout << "╔═════════════════════════════════════════════════════╗\n";
-    std::cout << "║  ORBITAL TRANSFER PROPAGATOR WITH ELECTRIC THRUST  ║\n";
-    std::cout << "║                    Version 1.0                      ║\n";
-    std::cout << "╚═════════════════════════════════════════════════════╝\n";
+    // In service mode stdout is the reply stream
+    bool serve_mode = argc >= 2 && std::string(argv[1]) == "--serve";
+    if (!serve_mode) {
+        std::cout << "\n";
+        std::cout << "╔═════════════════════════════════════════════════════╗\n";
+        std::cout << "║  ORBITAL TRANSFER PROPAGATOR WITH ELECTRIC THRUST  ║\n";
+        std::cout << "║                    Version 1.0                      ║\n";
+        std::cout << "╚═════════════════════════════════════════════════════╝\n";
+    }
     
-    // Parse timestep override
+    // Parse timestep override and parallel job count
     double timestep_override = parseTimestepOverride(argc, argv);
+    unsigned jobs = parseJobsOption(argc, argv);
+    bool export_csv = parseCsvOption(argc, argv);
+    bool use_cache = parseCacheOption(argc, argv);
+    long checkpoint_interval = parseCheckpointOption(argc, argv);
+    bool resume = parseResumeOption(argc, argv);
+    bool async_output = parseAsyncOutputOption(argc, argv);
+    std::string prune_metric = parsePruneOption(argc, argv);
+    std::string backend = parseBackendOption(argc, argv);
+    ShardSpec shard;
+    bool sharded = parseShardOption(argc, argv, shard);
+    bool use_mpi = parseMpiOption(argc, argv);
+    if (resume && checkpoint_interval == 0) {
+        checkpoint_interval = DEFAULT_CHECKPOINT_INTERVAL;  // Keep checkpointing after resuming
+    }
+    std::string trace_file = parseTraceOption(argc, argv);
+    if (!trace_file.empty()) {
+        if (instrumentationEnabled()) {
+            setTraceEnabled(true);
+        } else {
+            std::cerr << "Warning: --trace needs a build with -DLTMD_ENABLE_INSTRUMENTATION=ON\n";
+            trace_file.clear();
+        }
+    }
     
     // Check command line arguments
     if (argc == 1) {
         // Default: run single mission
         std::cout << "\nUsage:\n";
-        std::cout << "  Single mission:  ./propagator <config.yaml> [--timestep <seconds>]\n";
-        std::cout << "  Batch missions:  ./propagator --batch <batch_config.txt> [--timestep <seconds>]\n\n";
+        printUsage(std::cout);
+        std::cout << "\n";
         
         std::cout << "No arguments provided. Running default single mission mode...\n";
-        runSingleMissionMode("../config/earth_mars_baseline.yaml", timestep_override);
+        runSingleMissionMode("../config/earth_mars_baseline.yaml", timestep_override, export_csv,
+                             checkpoint_interval, resume, async_output);
         
     } else if (argc == 2 && std::string(argv[1]) == "--batch") {
         std::cerr << "Error: --batch flag requires a config file argument\n";
-        std::cerr << "Usage: ./propagator --batch <batch_config.txt> [--timestep <seconds>]\n";
+        std::cerr << "Usage: ./propagator --batch <batch_config.txt> [--timestep <seconds>] [--jobs <N>] [--csv] [--cache] [--checkpoint <steps>] [--resume] [--async-output] [--prune <metric>] [--shard <i/N>] [--mpi] [--trace <trace.json>]\n";
         return 1;
         
     } else if (argc >= 2 && std::string(argv[1]) == "--batch") {
         // Batch mode
         std::string batch_config = argv[2];
-        runBatchMissionMode(batch_config, timestep_override);
+        if (!runBatchMissionMode(batch_config, timestep_override, jobs, export_csv, use_cache,
+                                 checkpoint_interval, resume, async_output, prune_metric,
+                                 sharded ? &shard : nullptr, use_mpi)) {
+            return 1;
+        }
+        
+    } else if (argc == 2 && std::string(argv[1]) == "--sweep") {
+        std::cerr << "Error: --sweep flag requires a sweep file argument\n";
+        std::cerr << "Usage: ./propagator --sweep <sweep.yaml> [--timestep <seconds>] [--jobs <N>] [--prune <metric>] [--backend <cpu|lanes|gpu>] [--trace <trace.json>]\n";
+        return 1;
+        
+    } else if (argc >= 2 && std::string(argv[1]) == "--sweep") {
+        // Parameter sweep mode
+        runSweepMode(argv[2], timestep_override, jobs, prune_metric, backend);
+        
+    } else if (argc == 2 && std::string(argv[1]) == "--optimize") {
+        std::cerr << "Error: --optimize flag requires a spec file argument\n";
+        std::cerr << "Usage: ./propagator --optimize <spec.yaml> [--timestep <seconds>] [--jobs <N>] [--cache] [--backend <cpu|lanes|gpu>]\n";
+        return 1;
+        
+    } else if (argc >= 2 && std::string(argv[1]) == "--optimize") {
+        // Thruster optimization mode
+        runOptimizationMode(argv[2], timestep_override, jobs, use_cache, backend);
+        
+    } else if (argc == 2 && std::string(argv[1]) == "--monte-carlo") {
+        std::cerr << "Error: --monte-carlo flag requires a spec file argument\n";
+        std::cerr << "Usage: ./propagator --monte-carlo <spec.yaml> [--timestep <seconds>] [--jobs <N>] [--backend <cpu|lanes|gpu>]\n";
+        return 1;
+        
+    } else if (argc >= 2 && std::string(argv[1]) == "--monte-carlo") {
+        // Monte Carlo dispersion mode
+        runMonteCarloMode(argv[2], timestep_override, jobs, backend);
+        
+    } else if (argc == 2 && std::string(argv[1]) == "--convergence") {
+        std::cerr << "Error: --convergence flag requires a config file argument\n";
+        std::cerr << "Usage: ./propagator --convergence <config.yaml> [--jobs <N>]\n";
+        return 1;
+        
+    } else if (argc >= 2 && std::string(argv[1]) == "--convergence") {
+        // Timestep convergence study
+        runConvergenceMode(argv[2], timestep_override, jobs);
+        
+    } else if (serve_mode) {
+        // Long-running mission service
+        runServeMode(jobs);
         
     } else if (argc >= 2) {
         // Single mission mode with specified config
-        // (argv[1] is config file; --timestep handled by parseTimestepOverride)
-        runSingleMissionMode(argv[1], timestep_override);
+        // (argv[1] is config file; --timestep/--csv handled by the option parsers)
+        runSingleMissionMode(argv[1], timestep_override, export_csv, checkpoint_interval, resume,
+                             async_output);
         
     } else {
         std::cerr << "Error: Invalid arguments\n";
         std::cerr << "Usage:\n";
-        std::cerr << "  Single mission:  ./propagator <config.yaml> [--timestep <seconds>]\n";
-        std::cerr << "  Batch missions:  ./propagator --batch <batch_config.txt> [--timestep <seconds>]\n";
+        printUsage(std::cerr);
         return 1;
     }
     
+    if (!trace_file.empty() && writeChromeTrace(trace_file)) {
+        std::cout << "Trace saved to: " << trace_file << "\n";
+    }
+    
     return 0;
 }
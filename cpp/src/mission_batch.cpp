@@ -12,6 +12,29 @@
 #include "orbital_elements.h"
 #include "mission_batch.h"
 #include "mission_propagation.h"
+#include "force_model.h"
+#include "thread_pool.h"
+#include "trajectory_file.h"
+#include "result_cache.h"
+#include "instrumentation.h"
+
+namespace {
+
+/// Whether the trajectory files a mission writes are all present
+bool trajectoryFilesExist(const MissionConfig& config, const std::string& trajectory_path) {
+    struct stat info;
+    if (config.output_format != "csv" &&
+        stat(binaryTrajectoryPath(trajectory_path).c_str(), &info) != 0) {
+        return false;
+    }
+    if ((config.output_format == "csv" || config.output_format == "both") &&
+        stat(trajectory_path.c_str(), &info) != 0) {
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
 
 // ===========================================================================
 // DIRECTORY CREATION HELPER
@@ -37,7 +60,19 @@ std::string getResultsDirectory() {
 // CONFIGURATION LOADER
 // ===========================================================================
 
+/// Thrust and ISP of a named thruster; false (spacecraft unchanged) if unknown
+bool applyThrusterPreset(const std::string& name, SpacecraftConfig& spacecraft) {
+    ThrusterPreset preset;
+    if (!findThrusterByName(name, preset)) {
+        return false;
+    }
+    spacecraft.thrust_mN = getThrusterInfo(preset).thrust_mN;
+    spacecraft.isp_s = getThrusterInfo(preset).isp_s;
+    return true;
+}
+
 MissionConfig loadConfigFromYAML(const std::string& filename) {
+    LTMD_PROFILE_SCOPE(CONFIG_LOAD);
     MissionConfig config;
     
     try {
@@ -63,20 +98,7 @@ MissionConfig loadConfigFromYAML(const std::string& filename) {
             if (spacecraft["name"]) {
                 std::string name = spacecraft["name"].as<std::string>();
                 config.spacecraft.name = name;
-                
-                if (name == "Low-Power Hall") {
-                    config.spacecraft.thrust_mN = 60;
-                    config.spacecraft.isp_s = 1500;
-                } else if (name == "High-Power Hall") {
-                    config.spacecraft.thrust_mN = 1000;
-                    config.spacecraft.isp_s = 2750;
-                } else if (name == "Low-Power Ion") {
-                    config.spacecraft.thrust_mN = 250;
-                    config.spacecraft.isp_s = 4000;
-                } else if (name == "High-Power Ion") {
-                    config.spacecraft.thrust_mN = 450;
-                    config.spacecraft.isp_s = 9000;
-                }
+                applyThrusterPreset(name, config.spacecraft);
             }
         }
         
@@ -94,6 +116,24 @@ MissionConfig loadConfigFromYAML(const std::string& filename) {
             if (integration["max_flight_time_s"]) {
                 config.max_flight_time_s = integration["max_flight_time_s"].as<double>();
             }
+            if (integration["abs_tol"]) {
+                config.abs_tol = integration["abs_tol"].as<double>();
+            }
+            if (integration["rel_tol"]) {
+                config.rel_tol = integration["rel_tol"].as<double>();
+            }
+            if (integration["averaging_revolutions"]) {
+                config.averaging_revolutions = integration["averaging_revolutions"].as<double>();
+            }
+            if (integration["averaging_handoff"]) {
+                config.averaging_handoff = integration["averaging_handoff"].as<double>();
+            }
+            if (integration["precision"]) {
+                config.precision = integration["precision"].as<std::string>();
+            }
+            if (integration["sensitivity"]) {
+                config.compute_sensitivity = integration["sensitivity"].as<bool>();
+            }
         }
         
         if (yaml["propagation"]) {
@@ -101,6 +141,85 @@ MissionConfig loadConfigFromYAML(const std::string& filename) {
             if (propagation["coast_threshold"]) {
                 config.coast_threshold = propagation["coast_threshold"].as<double>();
             }
+            if (propagation["coast_check"]) {
+                config.coast_check = propagation["coast_check"].as<std::string>();
+            }
+            if (propagation["coast_mode"]) {
+                config.coast_mode = propagation["coast_mode"].as<std::string>();
+            }
+            if (propagation["coast_epoch_s"]) {
+                config.coast_epoch_s = propagation["coast_epoch_s"].as<double>();
+            }
+            if (propagation["checkpoint_interval"]) {
+                config.checkpoint_interval = propagation["checkpoint_interval"].as<long>();
+            }
+        }
+        
+        if (yaml["events"]) {
+            YAML::Node events = yaml["events"];
+            if (events["locate_coast"]) {
+                config.locate_coast = events["locate_coast"].as<bool>();
+            }
+            if (events["user"]) {
+                for (const YAML::Node& node : events["user"]) {
+                    EventSpec spec;
+                    if (node["type"]) {
+                        spec.type = node["type"].as<std::string>();
+                    }
+                    if (node["value"]) {
+                        spec.value = node["value"].as<double>();
+                    }
+                    if (node["terminal"]) {
+                        spec.terminal = node["terminal"].as<bool>();
+                    }
+                    if (spec.type != "mass_below" && spec.type != "radius_crossing") {
+                        std::cerr << "Warning: unknown event type '" << spec.type
+                                  << "' ignored\n";
+                        continue;
+                    }
+                    config.events.push_back(spec);
+                }
+            }
+        }
+        
+        if (yaml["perturbations"]) {
+            YAML::Node perturbations = yaml["perturbations"];
+            if (perturbations["ephemeris_cadence_s"]) {
+                config.ephemeris_cadence_s = perturbations["ephemeris_cadence_s"].as<double>();
+            }
+            if (perturbations["models"]) {
+                for (const YAML::Node& node : perturbations["models"]) {
+                    PerturbationSpec spec;
+                    if (node["type"]) {
+                        spec.type = node["type"].as<std::string>();
+                    }
+                    if (node["enabled"]) {
+                        spec.enabled = node["enabled"].as<bool>();
+                    }
+                    if (node["body"]) {
+                        std::string body = node["body"].as<std::string>();
+                        if (!findBodyByName(body, spec.body)) {
+                            std::cerr << "Warning: unknown perturbing body '" << body
+                                      << "'; using " << getBodyName(spec.body) << "\n";
+                        }
+                    }
+                    if (node["phase_deg"]) {
+                        spec.phase_deg = node["phase_deg"].as<double>();
+                    }
+                    if (node["area_m2"]) {
+                        spec.area_m2 = node["area_m2"].as<double>();
+                    }
+                    if (node["reflectivity"]) {
+                        spec.reflectivity = node["reflectivity"].as<double>();
+                    }
+                    if (!isKnownPerturbation(spec.type)) {
+                        std::cerr << "Warning: unknown perturbation type '" << spec.type
+                                  << "' ignored\n";
+                        continue;
+                    }
+                    config.perturbations.push_back(spec);
+                }
+            }
         }
         
         if (yaml["output"]) {
@@ -108,6 +227,21 @@ MissionConfig loadConfigFromYAML(const std::string& filename) {
             if (output["filename"]) {
                 config.output_filename = output["filename"].as<std::string>();
             }
+            if (output["save_interval"]) {
+                config.save_interval = output["save_interval"].as<int>();
+            }
+            if (output["format"]) {
+                config.output_format = output["format"].as<std::string>();
+            }
+            if (output["background_flush"]) {
+                config.background_flush = output["background_flush"].as<bool>();
+            }
+            if (output["async"]) {
+                config.async_output = output["async"].as<bool>();
+            }
+            if (output["async_buffer_mb"]) {
+                config.async_buffer_mb = output["async_buffer_mb"].as<double>();
+            }
         }
         
     } catch (const YAML::Exception& e) {
@@ -126,8 +260,19 @@ MissionResult MissionBatchRunner::propagateMission(const std::string& config_pat
     MissionResult result;
     result.mission_name = mission_name;
     
+    // The whole mission runs on this thread, so the growth of its counters
+    // is this mission's breakdown
+    ProfileCounters profile_start = threadProfile();
+    
     // Load configuration
     MissionConfig config = loadConfigFromYAML(config_path);
+    if (csv_export && config.output_format == "binary") {
+        config.output_format = "both";
+    }
+    if (async_output) {
+        config.async_output = true;
+    }
+    config.pruning = pruning_bound.get();
     
     result.thruster_name = config.spacecraft.name;
     result.departure_body = getBodyName(config.departure_body);
@@ -149,9 +294,41 @@ MissionResult MissionBatchRunner::propagateMission(const std::string& config_pat
         base_name = base_name.substr(0, last_dot);
     }
     
+    std::string trajectory_path = results_dir + "/" + base_name + "_trajectory.csv";
+    
+    // Checkpoints per mission; finished missions leave none behind
+    if (checkpoint_interval > 0) {
+        config.checkpoint_interval = checkpoint_interval;
+    }
+    if (config.checkpoint_interval > 0 || resume) {
+        createDirectory(results_dir + "/checkpoints");
+        config.checkpoint_file = results_dir + "/checkpoints/" + base_name + ".ckpt";
+        config.resume = resume;
+    }
+    
+    // Unchanged mission with its trajectory still on disk: reuse the result
+    std::uint64_t cache_key = 0;
+    if (!cache_directory.empty()) {
+        cache_key = hashMissionConfig(config, trajectory_path);
+        CachedMission cached;
+        if (ResultCache(cache_directory).lookup(cache_key, cached) &&
+            trajectoryFilesExist(config, trajectory_path)) {
+            cached.result.mission_name = mission_name;
+            cached.result.profile = threadProfile() - profile_start;
+            cache_hits++;
+            if (pruning_bound) {
+                MissionResult scored = cached.result;
+                computeMissionMetrics(scored);
+                pruning_bound->offer(missionMetricScore(scored, pruning_bound->metric()));
+            }
+            return cached.result;
+        }
+    }
+    
     // Propagate mission and save trajectory
-    PropagationResult prop_result = ::propagateMission(config, r_dep, r_arr, true,
-                                                       results_dir + "/" + base_name + "_trajectory.csv");
+    PropagationResult prop_result = ::propagateMission(
+        config, r_dep, r_arr, true, trajectory_path,
+        config.async_output ? sharedWriter() : nullptr);
     
     // Extract mission results
     result.flight_time_days = prop_result.final_state.t / 86400.0;
@@ -166,24 +343,78 @@ MissionResult MissionBatchRunner::propagateMission(const std::string& config_pat
     result.final_periapsis_km = elements.r_p;
     result.final_eccentricity = elements.e;
     result.final_semi_major_axis_km = elements.a;
+    result.pruned = prop_result.pruned;
+    
+    result.profile = threadProfile() - profile_start;
+    
+    // A pruned result is partial, so it must not stand in for the mission
+    if (!cache_directory.empty() && !result.pruned) {
+        CachedMission entry;
+        entry.result = result;
+        entry.propagation = prop_result;
+        entry.trajectory_path = trajectory_path;
+        ResultCache(cache_directory).store(cache_key, entry);
+    }
     
     return result;
 }
 
+TrajectoryWriterThread* MissionBatchRunner::sharedWriter() {
+    std::lock_guard<std::mutex> lock(writer_mutex);
+    if (!writer_thread) {
+        writer_thread = std::make_unique<TrajectoryWriterThread>();
+    }
+    return writer_thread.get();
+}
+
+void MissionBatchRunner::setPruning(const std::string& metric) {
+    if (metric.empty()) {
+        pruning_bound.reset();
+    } else {
+        pruning_bound = std::make_unique<PruningBound>(metric);
+    }
+}
+
 MissionResult MissionBatchRunner::runSingleMission(const std::string& config_file) {
     std::string config_path = "../config/" + config_file;
     return propagateMission(config_path, config_file);
 }
 
-MissionComparison MissionBatchRunner::runBatchMissions(const std::vector<std::string>& config_files) {
+MissionComparison MissionBatchRunner::runBatchMissions(const std::vector<std::string>& config_files,
+                                                        unsigned jobs) {
     MissionComparison comparison;
     
-    for (const auto& config_file : config_files) {
-        std::cout << "Running mission: " << config_file << "...\n";
-        MissionResult result = runSingleMission(config_file);
-        comparison.addMission(result);
+    if (jobs == 1 || config_files.size() <= 1) {
+        for (const auto& config_file : config_files) {
+            std::cout << "Running mission: " << config_file << "...\n";
+            MissionResult result = runSingleMission(config_file);
+            comparison.addMission(result);
+        }
+        
+        comparison.computeMetrics();
+        comparison.setPruned(pruning_bound != nullptr);
+        return comparison;
     }
     
+    // Parallel batch: every mission builds its own config, integrator and
+    // trajectory stream inside propagateMission, so workers share nothing
+    // except their own slot in the comparison table.
+    unsigned num_threads = ThreadPool::resolveThreadCount(jobs);
+    if (num_threads > config_files.size()) {
+        num_threads = static_cast<unsigned>(config_files.size());
+    }
+    std::cout << "Running " << config_files.size() << " missions on "
+              << num_threads << " threads...\n";
+    
+    comparison.resizeMissions(config_files.size());
+    ThreadPool pool(num_threads);
+    pool.parallelFor(config_files.size(), [&](size_t index) {
+        // Single insertion per line keeps worker output from interleaving
+        std::cout << ("Running mission: " + config_files[index] + "...\n");
+        comparison.setMission(index, runSingleMission(config_files[index]));
+    });
+    
     comparison.computeMetrics();
+    comparison.setPruned(pruning_bound != nullptr);
     return comparison;
 }
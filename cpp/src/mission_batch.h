@@ -1,9 +1,14 @@
 #ifndef MISSION_BATCH_H
 #define MISSION_BATCH_H
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 #include "comparison.h"
+#include "async_sink.h"
+#include "pruning.h"
 
 // ===========================================================================
 // BATCH MISSION RUNNER
@@ -16,13 +21,65 @@ public:
     MissionResult runSingleMission(const std::string& config_file);
     
     /// Run all missions in configuration vector
-    MissionComparison runBatchMissions(const std::vector<std::string>& config_files);
+    /// jobs > 1 runs missions concurrently on a work-stealing thread pool
+    /// (0 = one job per hardware thread). Result order always follows
+    /// config_files, regardless of which mission finishes first.
+    MissionComparison runBatchMissions(const std::vector<std::string>& config_files,
+                                       unsigned jobs = 1);
+    
+    /// Also export each trajectory as CSV next to the binary file (--csv)
+    void setCsvExport(bool enabled) { csv_export = enabled; }
+    
+    /// Reuse results of unchanged missions from an on-disk cache (--cache)
+    /// A mission is skipped when its config hash (see result_cache.h) has
+    /// an entry and its trajectory file still exists. Empty = no cache.
+    void setCacheDirectory(const std::string& directory) { cache_directory = directory; }
+    
+    /// Checkpoint every interval steps (0 = as configured) and, with resume,
+    /// continue missions from their checkpoints (--checkpoint / --resume)
+    /// Checkpoints live in ../results/checkpoints/<mission>.ckpt. Combined
+    /// with the result cache, a resumed batch skips the missions that had
+    /// finished and only continues the interrupted ones.
+    void setCheckpointing(long interval, bool resume_missions) {
+        checkpoint_interval = interval;
+        resume = resume_missions;
+    }
+    
+    /// Write every mission's trajectory through the async pipeline
+    /// (--async-output). All missions of a batch share one I/O thread, as do
+    /// missions that enable output.async in their own config.
+    void setAsyncOutput(bool enabled) { async_output = enabled; }
+    
+    /// Stop missions that can no longer beat the best finished one on
+    /// metric, a findBestMission metric (--prune, see pruning.h). The
+    /// missions of a batch share one bound across its threads. Empty = off.
+    void setPruning(const std::string& metric);
+    
+    /// The bound of setPruning, with its statistics (nullptr when off)
+    const PruningBound* pruning() const { return pruning_bound.get(); }
+    
+    /// Missions served from the cache so far
+    long cacheHits() const { return cache_hits.load(); }
     
 private:
     /// Helper function to run main propagation logic
     /// Returns a MissionResult with all metrics
     MissionResult propagateMission(const std::string& config_path,
                                   const std::string& mission_name);
+    
+    bool csv_export = false;
+    std::string cache_directory;
+    std::atomic<long> cache_hits{0};
+    long checkpoint_interval = 0;
+    bool resume = false;
+    std::unique_ptr<PruningBound> pruning_bound;
+    
+    /// The I/O thread shared by async missions, started by the first one
+    TrajectoryWriterThread* sharedWriter();
+    
+    bool async_output = false;
+    std::mutex writer_mutex;
+    std::unique_ptr<TrajectoryWriterThread> writer_thread;
 };
 
 #endif // MISSION_BATCH_H
@@ -1,20 +1,142 @@
 #include <iostream>
 #include <iomanip>
+#include <cstdio>
 #include <fstream>
 #include <memory>
 #include <cmath>
+#include <algorithm>
+#include <type_traits>
 #include "mission_propagation.h"
 #include "orbital_elements.h"
+#include "trajectory_file.h"
+#include "checkpoint.h"
+#include "instrumentation.h"
+#include "async_sink.h"
+#include "precision.h"
+#include "force_model.h"
+#include "pruning.h"
 
+namespace {
+
+/// Time over which the coast radius provably stays out of reach
+///
+/// Bounds how fast r_a or r_p can move under thrust along the velocity,
+/// from the Gauss variational equations:
+///   |da/dt| <= 2 a² v a_T / μ,   |de/dt| <= 2 (1 + e) a_T / v
+///   |dr/dt| <= (1 + e) |da/dt| + a |de/dt|
+/// taking the periapsis speed in the first term, the apoapsis speed in the
+/// second, and the thrust acceleration at the mass left after the skip.
+/// The result is halved and capped at 1/20 of an orbit, so the drift of a
+/// and e over the skipped interval cannot invalidate the bound.
+///
+/// @param apsides: current apsides
+/// @param margin: distance (km) between the watched apsis and the coast radius
+/// @return skip time (s); 0 when the orbit is not closed
+double coastCheckSkipTime(const Apsides& apsides, double margin,
+                          const SpacecraftConfig& spacecraft, double mass) {
+    if (margin <= 0 || apsides.a <= 0 || apsides.e >= 1.0) {
+        return 0;
+    }
+    
+    double period = 2.0 * 3.14159265358979323846 *
+                    std::sqrt(apsides.a * apsides.a * apsides.a / MU_SUN);
+    double max_skip = period / 20.0;
+    if (spacecraft.thrust_mN < 1e-10) {
+        return max_skip;  // Unperturbed Kepler orbit: apsides are fixed
+    }
+    
+    double v_max = std::sqrt(MU_SUN * (2.0 / apsides.r_p - 1.0 / apsides.a));
+    double v_min = std::sqrt(MU_SUN * (2.0 / apsides.r_a - 1.0 / apsides.a));
+    double rate_per_accel = (1.0 + apsides.e) *
+                            (2.0 * apsides.a * apsides.a * v_max / MU_SUN +
+                             2.0 * apsides.a / v_min);
+    
+    // First pass at the current mass, second at the mass left after that skip
+    double skip = margin / (rate_per_accel * spacecraft.thrust_mN * 1e-6 / mass);
+    if (spacecraft.isp_s > 1e-10) {
+        double mass_flow = spacecraft.thrust_mN * 1e-6 / (spacecraft.isp_s * G0);
+        double mass_end = mass - mass_flow * std::min(skip, max_skip);
+        if (mass_end < 100) {
+            mass_end = 100;  // Fuel cutoff ends the thrust arc anyway
+        }
+        skip = margin / (rate_per_accel * spacecraft.thrust_mN * 1e-6 / mass_end);
+    }
+    
+    return std::min(0.5 * skip, max_skip);
+}
+
+/// Closed-form coast arc once the thrust arc has ended
+///
+/// "to_arrival" coasts to the next crossing of the arrival radius, or to
+/// the apsis nearest it when the orbit falls short; "to_epoch" coasts to
+/// config.coast_epoch_s. Neither goes past max_flight_time_s. Mass is
+/// unchanged over the arc.
+///
+/// @return true if state was advanced
+bool flyCoastArc(const MissionConfig& config, double r_arrival,
+                 MissionState& state, bool& arrival_reached) {
+    double t_end;
+    if (config.coast_mode == "to_arrival") {
+        double dt = timeToRadius(state.r, state.v, MU_SUN, r_arrival);
+        arrival_reached = (dt >= 0);
+        if (!arrival_reached) {
+            Apsides apsides = computeApsides(state.r, state.v, MU_SUN);
+            double apsis = (r_arrival > state.radius()) ? apsides.r_a : apsides.r_p;
+            dt = timeToRadius(state.r, state.v, MU_SUN, apsis);
+        }
+        if (dt < 0) {
+            return false;
+        }
+        t_end = state.t + dt;
+    } else if (config.coast_mode == "to_epoch") {
+        t_end = config.coast_epoch_s;
+    } else {
+        return false;
+    }
+    
+    if (t_end > config.max_flight_time_s) {
+        t_end = config.max_flight_time_s;
+        arrival_reached = false;
+    }
+    if (t_end <= state.t ||
+        !propagateKepler(state.r, state.v, t_end - state.t, MU_SUN, state.r, state.v)) {
+        arrival_reached = false;
+        return false;
+    }
+    state.t = t_end;
+    return true;
+}
+
+/// One fixed step; rk4 also advances sensitivity when it is given
+template <typename Integrator>
+void fixedStep(Integrator& integrator, MissionState& state, StateSensitivity* sensitivity,
+               double dt, const MissionConfig& config, int thrust_direction) {
+    if constexpr (std::is_same<Integrator, RK4Propagator>::value) {
+        if (sensitivity) {
+            integrator.stepWithSensitivity(state, *sensitivity, dt,
+                                           config.spacecraft.thrust_mN, config.spacecraft.isp_s,
+                                           MU_SUN, G0, thrust_direction);
+            return;
+        }
+    }
+    integrator.step(state, dt, config.spacecraft.thrust_mN, config.spacecraft.isp_s,
+                    MU_SUN, G0, thrust_direction);
+}
+
+}  // namespace
+
+template <typename Integrator>
 PropagationResult propagateMission(
+    Integrator& integrator,
     const MissionConfig& config,
     double r_departure,
     double r_arrival,
-    bool save_trajectory,
-    const std::string& output_filename) {
+    TrajectorySink& sink) {
     
+    constexpr bool adaptive = std::is_base_of<AdaptivePropagator, Integrator>::value;
+    constexpr bool averaged = std::is_same<Integrator, AveragedPropagator>::value;
     PropagationResult result;
-
+    
     // Determine thrust direction based on transfer type
     int thrust_direction = (r_arrival > r_departure) ? 1 : -1;
     
@@ -23,105 +145,467 @@ PropagationResult propagateMission(
     MissionState state(r_departure, 0, 0, 0, v_circ, 0,
                       config.spacecraft.initial_mass_kg, 0);
     
-    // Create integrator
-    std::unique_ptr<Propagator> integrator;
-    if (config.integrator == "rk4") {
-        integrator = std::make_unique<RK4Propagator>();
-    } else {
-        integrator = std::make_unique<EulerPropagator>();
+    double dt_next = config.timestep_s;  // Step proposal for adaptive integrators
+    if constexpr (adaptive) {
+        integrator.resetCounters();
+    }
+    if constexpr (averaged) {
+        integrator.reset();
     }
     
-    // Open output file if requested
-    std::ofstream outfile;
-    if (save_trajectory && !output_filename.empty()) {
-        outfile.open(output_filename);
-        outfile << "time(s),x(km),y(km),vx(km/s),vy(km/s),r(km),v(km/s),m(kg),"
-        << "ra(km),rp(km),e,a(km)\n";
+    // Perturbations ride on the stages of the integrators that support
+    // them; none attached leaves the integrator exactly as it was
+    constexpr bool perturbable = adaptive || std::is_same<Integrator, RK4Propagator>::value ||
+                                 std::is_same<Integrator, EulerPropagator>::value;
+    ForceModel forces = perturbable ? ForceModel(config) : ForceModel();
+    if (!forces.empty()) {
+        integrator.setPerturbation(&forces);
     }
     
     // Propagation loop
     int step = 0;
     double total_delta_v = 0;
     int coast_step = -1;
+    OrbitalElements elements;
+    
+    // Coast check: "bracketed" skips the apsides evaluation until the
+    // watched apsis could have reached the coast radius. Its bound covers
+    // thrust only, so perturbed missions check every step.
+    double coast_radius = config.coast_threshold * r_arrival;
+    bool bracketed = (config.coast_check == "bracketed") && forces.empty();
+    double next_coast_check_t = 0;
+    
+    // Event location inside each step (opt-in). A terminal event replaces
+    // the end of the step with the state at the event.
+    EventLocator locator(config, coast_radius, thrust_direction);
+    MissionState step_start;
+    bool coast_event = false;
+    bool stop_event = false;
+    
+    // Checkpoints save the loop state at the top of a step, before the
+    // step is offered to the sink (checkpoint.h)
+    long checkpoint_interval = config.checkpoint_file.empty() ? 0 : config.checkpoint_interval;
+    bool resumed = false;
+    int resumed_step = -1;
+    if (config.resume) {
+        PropagationCheckpoint saved;
+        if (findCheckpoint(config, saved)) {
+            if (!sink.restoreCheckpoint(saved.sink)) {
+                std::cerr << "Warning: Trajectory output cannot be resumed from "
+                          << config.checkpoint_file << "; continuing without it\n";
+            }
+            state = saved.state;
+            step = static_cast<int>(saved.step);
+            total_delta_v = saved.total_delta_v;
+            dt_next = saved.dt_next;
+            next_coast_check_t = saved.next_coast_check_t;
+            result.events = saved.events;
+            if constexpr (adaptive) {
+                integrator.restoreCounters(saved.accepted_steps, saved.rejected_steps);
+            }
+            if constexpr (averaged) {
+                integrator.restore(saved.handed_off, saved.averaged_steps);
+            }
+            resumed = true;
+            resumed_step = step;
+        }
+    }
+    
+    // Sensitivities start from [I | 0] at departure, so a resumed run
+    // (whose checkpoint holds only the state) cannot provide them
+    constexpr bool variational = std::is_same<Integrator, RK4Propagator>::value;
+    bool track_sensitivity = variational && config.compute_sensitivity && !resumed &&
+                             forces.empty();
+    StateSensitivity sensitivity;
+    StateSensitivity sensitivity_start;
     
     while (state.t < config.max_flight_time_s) {
-        // Compute orbital elements
-        OrbitalElements elements = computeOrbitalElements(state.r, state.v, MU_SUN);
-        
-        // Store state in history
-        result.trajectory_history.push_back(state);
+        if (checkpoint_interval > 0 && step > 0 && step % checkpoint_interval == 0 &&
+            step != resumed_step && !coast_event && !stop_event) {
+            PropagationCheckpoint checkpoint;
+            checkpoint.config_key = checkpointKey(config);
+            checkpoint.step = step;
+            checkpoint.state = state;
+            checkpoint.total_delta_v = total_delta_v;
+            checkpoint.dt_next = dt_next;
+            checkpoint.next_coast_check_t = next_coast_check_t;
+            if constexpr (adaptive) {
+                checkpoint.accepted_steps = integrator.acceptedSteps();
+                checkpoint.rejected_steps = integrator.rejectedSteps();
+            }
+            if constexpr (averaged) {
+                checkpoint.handed_off = integrator.handedOff();
+                checkpoint.averaged_steps = integrator.averagedSteps();
+            }
+            checkpoint.events = result.events;
+            if (sink.saveCheckpoint(checkpoint.sink)) {
+                writeCheckpoint(config.checkpoint_file, checkpoint);
+            } else {
+                std::cerr << "Warning: Trajectory output cannot be checkpointed; "
+                          << "checkpoints disabled\n";
+                checkpoint_interval = 0;
+            }
+        }
         
-        // Write to file if enabled
-        if (outfile.is_open()) {
-            outfile << std::scientific << std::setprecision(6)
-                    << state.t << ","
-                    << state.r[0] << ","   // x
-                    << state.r[1] << ","   // y
-                    << state.v[0] << ","   // vx
-                    << state.v[1] << ","   // vy
-                    << state.radius() << ","
-                    << state.speed() << ","
-                    << std::fixed << std::setprecision(2)
-                    << state.m << ","
-                    << std::scientific << std::setprecision(3)
-                    << elements.r_a << ","
-                    << elements.r_p << ","
-                    << std::fixed << std::setprecision(6)
-                    << elements.e << ","
-                    << std::scientific << std::setprecision(3)
-                    << elements.a << "\n";
+        // Full elements only for steps the trajectory sink keeps
+        if (sink.wantsStep(step)) {
+            {
+                LTMD_PROFILE_SCOPE(ORBITAL_ELEMENTS);
+                elements = computeOrbitalElements(state.r, state.v, MU_SUN);
+            }
+            LTMD_PROFILE_SCOPE(OUTPUT);
+            sink.record(step, state, elements);
         }
         
         // Check coast condition
         // For outbound: coast when apoapsis >= arrival radius
         // For inbound: coast when periapsis <= arrival radius
-        bool coast_reached = false;
-        if (thrust_direction > 0) {
-            // Outbound: check apoapsis
-            coast_reached = (elements.r_a >= config.coast_threshold * r_arrival);
-        } else {
-            // Inbound: check periapsis
-            coast_reached = (elements.r_p <= config.coast_threshold * r_arrival);
+        bool coast_reached = coast_event;
+        if (!coast_reached && (!bracketed || state.t >= next_coast_check_t)) {
+            LTMD_PROFILE_SCOPE(COAST_CHECK);
+            Apsides apsides = computeApsides(state.r, state.v, MU_SUN);
+            double margin;
+            if (thrust_direction > 0) {
+                // Outbound: check apoapsis
+                coast_reached = (apsides.r_a >= coast_radius);
+                margin = coast_radius - apsides.r_a;
+            } else {
+                // Inbound: check periapsis
+                coast_reached = (apsides.r_p <= coast_radius);
+                margin = apsides.r_p - coast_radius;
+            }
+            
+            if (bracketed && !coast_reached) {
+                next_coast_check_t = state.t + coastCheckSkipTime(apsides, margin,
+                                                                  config.spacecraft, state.m);
+            }
         }
         
         if (coast_reached && coast_step < 0) {
             coast_step = step;
         }
         
-        // Stop if coast reached
-        if (coast_step >= 0) {
-            result.final_state = state;
-            result.total_delta_v = total_delta_v;
-            result.coast_step = coast_step;
+        // Stop if coast reached or fuel exhausted
+        if (coast_step >= 0 || stop_event || state.m < 100) {
             break;
         }
         
-        // Check fuel
-        if (state.m < 100) {
-            result.final_state = state;
-            result.total_delta_v = total_delta_v;
-            result.coast_step = coast_step;
+        // Trade-study pruning: already worse than a finished mission
+        if (config.pruning &&
+            config.pruning->prunes(config.pruning->score(state.t, total_delta_v, state.m,
+                                                         config.spacecraft.initial_mass_kg))) {
+            result.pruned = true;
             break;
         }
         
+        // Integration step
+        double mass_before = state.m;
+        step_start = state;
+        double dt_taken = config.timestep_s;
+        {
+            LTMD_PROFILE_SCOPE(INTEGRATOR_STEP);
+            if constexpr (adaptive) {
+                dt_taken = integrator.adaptiveStep(state, dt_next, dt_next,
+                                                   config.spacecraft.thrust_mN, config.spacecraft.isp_s,
+                                                   MU_SUN, G0, thrust_direction,
+                                                   config.max_flight_time_s - state.t);
+            } else if constexpr (averaged) {
+                dt_taken = integrator.advance(state, config.spacecraft.thrust_mN,
+                                              config.spacecraft.isp_s, MU_SUN, G0,
+                                              thrust_direction, config.max_flight_time_s - state.t);
+            } else {
+                if (track_sensitivity) {
+                    sensitivity_start = sensitivity;
+                }
+                fixedStep(integrator, state, track_sensitivity ? &sensitivity : nullptr,
+                          config.timestep_s, config, thrust_direction);
+            }
+        }
+        
+        // Terminal event inside the step: re-step from its start to the event
+        if (locator.active() &&
+            locator.checkStep(step_start, state, !bracketed || state.t >= next_coast_check_t,
+                              result.events)) {
+            // The bisection probes are not mission steps: keep them out of
+            // the adaptive step counts and the averaged handoff state
+            long accepted_before = 0;
+            long rejected_before = 0;
+            bool handed_off_before = false;
+            long averaged_before = 0;
+            if constexpr (adaptive) {
+                accepted_before = integrator.acceptedSteps();
+                rejected_before = integrator.rejectedSteps();
+            }
+            if constexpr (averaged) {
+                handed_off_before = integrator.handedOff();
+                averaged_before = integrator.averagedSteps();
+            }
+            state = locator.refineTerminal(step_start, state, [&](double t) {
+                MissionState partial = step_start;
+                integrator.step(partial, t - step_start.t,
+                                config.spacecraft.thrust_mN, config.spacecraft.isp_s,
+                                MU_SUN, G0, thrust_direction);
+                return partial;
+            });
+            if constexpr (adaptive) {
+                integrator.restoreCounters(accepted_before, rejected_before);
+            }
+            if constexpr (averaged) {
+                integrator.restore(handed_off_before, averaged_before);
+            }
+            dt_taken = state.t - step_start.t;
+            if (track_sensitivity) {
+                // Redo the shortened step for its Jacobian (the grid of the
+                // event time itself is not differentiated)
+                MissionState partial = step_start;
+                sensitivity = sensitivity_start;
+                fixedStep(integrator, partial, &sensitivity, dt_taken, config, thrust_direction);
+            }
+            result.events.push_back(MissionEvent(locator.terminalType(), state, true));
+            coast_event = (locator.terminalType() == "coast");
+            stop_event = !coast_event;
+        }
+        
         // Calculate delta-V for this step
         if (config.spacecraft.thrust_mN > 1e-10) {
-            double thrust_accel = (config.spacecraft.thrust_mN * 1e-6) / state.m;
-            double delta_v_step = thrust_accel * config.timestep_s;
+            double thrust_accel = (config.spacecraft.thrust_mN * 1e-6) / mass_before;
+            double delta_v_step = thrust_accel * dt_taken;
+            if constexpr (averaged) {
+                // A step may span a large mass drop: integrate thrust/m
+                if (config.spacecraft.isp_s > 1e-10 && state.m > 0) {
+                    delta_v_step = config.spacecraft.isp_s * G0 * std::log(mass_before / state.m);
+                }
+            }
             total_delta_v += delta_v_step;
         }
         
-        // Integration step
-        integrator->step(state, config.timestep_s,
-                        config.spacecraft.thrust_mN, config.spacecraft.isp_s,
-                        MU_SUN, G0, thrust_direction);
+        step++;
         
+        // Reached the flight-time limit: the state after the last step
+        // is the final state, so offer it to the sink as well
+        if (state.t >= config.max_flight_time_s && sink.wantsStep(step)) {
+            {
+                LTMD_PROFILE_SCOPE(ORBITAL_ELEMENTS);
+                elements = computeOrbitalElements(state.r, state.v, MU_SUN);
+            }
+            LTMD_PROFILE_SCOPE(OUTPUT);
+            sink.record(step, state, elements);
+        }
+    }
+    
+    // Coast located in the step that reached the flight-time limit
+    if (coast_event && coast_step < 0) {
+        coast_step = step;
+    }
+    
+    result.total_delta_v = total_delta_v;
+    result.coast_step = coast_step;
+    
+    if constexpr (adaptive) {
+        result.accepted_steps = integrator.acceptedSteps();
+        result.rejected_steps = integrator.rejectedSteps();
+    } else {
+        result.accepted_steps = step;
+    }
+    if constexpr (averaged) {
+        result.averaged_steps = integrator.averagedSteps();
+    }
+    
+    result.has_sensitivity = track_sensitivity;
+    if (track_sensitivity) {
+        result.sensitivity = sensitivity;
+    }
+    
+    // Unpowered arc after coast onset or fuel cutoff, in a single step
+    result.coast_state = state;
+    bool thrust_ended = (coast_step >= 0 || state.m < 100) && !stop_event;
+    if (thrust_ended && state.t < config.max_flight_time_s &&
+        flyCoastArc(config, r_arrival, state, result.arrival_reached)) {
+        result.coast_arc_s = state.t - result.coast_state.t;
         step++;
     }
+    result.final_state = state;
+    
+    elements = computeOrbitalElements(state.r, state.v, MU_SUN);
+    {
+        LTMD_PROFILE_SCOPE(OUTPUT);
+        sink.finish(step, state, elements);
+    }
+    
+    // A finished propagation leaves nothing to resume
+    if (checkpoint_interval > 0 || resumed) {
+        std::remove(config.checkpoint_file.c_str());
+    }
     
-    if (outfile.is_open()) {
-        outfile.close();
+    if (config.pruning) {
+        config.pruning->finish(config, result);
     }
     
+    if (!forces.empty()) {
+        integrator.setPerturbation(nullptr);
+    }
     return result;
 }
+
+template PropagationResult propagateMission<RK4Propagator>(
+    RK4Propagator&, const MissionConfig&, double, double, TrajectorySink&);
+template PropagationResult propagateMission<EulerPropagator>(
+    EulerPropagator&, const MissionConfig&, double, double, TrajectorySink&);
+template PropagationResult propagateMission<DormandPrince54Propagator>(
+    DormandPrince54Propagator&, const MissionConfig&, double, double, TrajectorySink&);
+template PropagationResult propagateMission<DOP853Propagator>(
+    DOP853Propagator&, const MissionConfig&, double, double, TrajectorySink&);
+template PropagationResult propagateMission<AveragedPropagator>(
+    AveragedPropagator&, const MissionConfig&, double, double, TrajectorySink&);
+template PropagationResult propagateMission<FloatRK4Propagator>(
+    FloatRK4Propagator&, const MissionConfig&, double, double, TrajectorySink&);
+template PropagationResult propagateMission<CompensatedRK4Propagator>(
+    CompensatedRK4Propagator&, const MissionConfig&, double, double, TrajectorySink&);
+template PropagationResult propagateMission<DoubleDoubleRK4Propagator>(
+    DoubleDoubleRK4Propagator&, const MissionConfig&, double, double, TrajectorySink&);
+
+PropagationResult propagateMission(
+    const MissionConfig& config,
+    double r_departure,
+    double r_arrival,
+    TrajectorySink& sink) {
+    
+    // Integrator lives on the stack and is chosen once; names as in
+    // createPropagator
+    const std::string& name = config.integrator;
+    if (config.compute_sensitivity && name != "rk4") {
+        std::cerr << "Warning: sensitivities need the rk4 integrator; not computed for "
+                  << name << "\n";
+    }
+    if (hasPerturbations(config)) {
+        bool precision_mode = name == "rk4" && config.precision != "double" &&
+                              isValidPrecision(config.precision);
+        if (name == "averaged" || precision_mode) {
+            std::cerr << "Warning: perturbations need the rk4, euler, rk45 or dop853 "
+                      << "integrator in double precision; ignored\n";
+        } else if (config.compute_sensitivity && name == "rk4") {
+            std::cerr << "Warning: sensitivities do not cover perturbations; not computed\n";
+        }
+    }
+    if (config.precision != "double") {
+        if (!isValidPrecision(config.precision)) {
+            std::cerr << "Warning: unknown precision '" << config.precision
+                      << "'; using double\n";
+        } else if (name != "rk4") {
+            std::cerr << "Warning: precision modes need the rk4 integrator; using double for "
+                      << name << "\n";
+        } else {
+            if (config.compute_sensitivity) {
+                std::cerr << "Warning: sensitivities need double precision; not computed\n";
+            }
+            if (config.precision == "float") {
+                FloatRK4Propagator integrator;
+                return propagateMission(integrator, config, r_departure, r_arrival, sink);
+            }
+            if (config.precision == "double_kahan") {
+                CompensatedRK4Propagator integrator;
+                return propagateMission(integrator, config, r_departure, r_arrival, sink);
+            }
+            DoubleDoubleRK4Propagator integrator;
+            return propagateMission(integrator, config, r_departure, r_arrival, sink);
+        }
+    }
+    if (name == "rk4") {
+        RK4Propagator integrator;
+        return propagateMission(integrator, config, r_departure, r_arrival, sink);
+    }
+    if (name == "rk45" || name == "dopri5") {
+        DormandPrince54Propagator integrator(config.abs_tol, config.rel_tol);
+        return propagateMission(integrator, config, r_departure, r_arrival, sink);
+    }
+    if (name == "dop853") {
+        DOP853Propagator integrator(config.abs_tol, config.rel_tol);
+        return propagateMission(integrator, config, r_departure, r_arrival, sink);
+    }
+    if (name == "averaged") {
+        double revolutions = config.averaging_revolutions;
+        double handoff = config.averaging_handoff;
+        if (!(revolutions > 0)) {
+            std::cerr << "Warning: averaging_revolutions must be positive; using 1\n";
+            revolutions = 1;
+        }
+        if (!(handoff > 0 && handoff <= 1)) {
+            std::cerr << "Warning: averaging_handoff must be in (0, 1]; using 0.9\n";
+            handoff = 0.9;
+        }
+        AveragedPropagator integrator(config.timestep_s, revolutions,
+                                      config.coast_threshold * r_arrival, handoff);
+        return propagateMission(integrator, config, r_departure, r_arrival, sink);
+    }
+    EulerPropagator integrator;
+    return propagateMission(integrator, config, r_departure, r_arrival, sink);
+}
+
+namespace {
+
+/// Decimate, then write output directly or through the async pipeline
+/// Decimating first keeps skipped steps out of the queue.
+PropagationResult propagateToOutput(const MissionConfig& config, double r_departure,
+                                    double r_arrival, TrajectorySink& output,
+                                    TrajectoryWriterThread* writer_thread) {
+    if (!config.async_output) {
+        DecimatingTrajectorySink decimated(output, config.save_interval);
+        return propagateMission(config, r_departure, r_arrival, decimated);
+    }
+    
+    // Declared before the sink so it outlives it
+    std::unique_ptr<TrajectoryWriterThread> own_writer;
+    if (!writer_thread) {
+        own_writer = std::make_unique<TrajectoryWriterThread>();
+        writer_thread = own_writer.get();
+    }
+    std::size_t buffer_bytes = static_cast<std::size_t>(config.async_buffer_mb * 1024 * 1024);
+    AsyncTrajectorySink async_sink(output, *writer_thread, buffer_bytes);
+    DecimatingTrajectorySink decimated(async_sink, config.save_interval);
+    return propagateMission(config, r_departure, r_arrival, decimated);
+}
+
+}  // namespace
+
+PropagationResult propagateMission(
+    const MissionConfig& config,
+    double r_departure,
+    double r_arrival,
+    bool save_trajectory,
+    const std::string& output_filename,
+    TrajectoryWriterThread* writer_thread) {
+    
+    if (!save_trajectory || output_filename.empty()) {
+        NullTrajectorySink null_sink;
+        return propagateMission(config, r_departure, r_arrival, null_sink);
+    }
+    
+    // Binary is the primary format; CSV is an opt-in export
+    bool write_binary = config.output_format != "csv";
+    bool write_csv = config.output_format == "csv" || config.output_format == "both";
+    
+    // A run continuing from a checkpoint keeps the rows already written
+    PropagationCheckpoint saved;
+    bool resuming = config.resume && !config.checkpoint_file.empty() &&
+                    readCheckpoint(config.checkpoint_file, saved) &&
+                    saved.config_key == checkpointKey(config);
+    SinkOpenMode mode = resuming ? SinkOpenMode::RESUME : SinkOpenMode::CREATE;
+    int thrust_direction = (r_arrival > r_departure) ? 1 : -1;
+    
+    if (write_binary && write_csv) {
+        BinaryTrajectorySink binary_sink(binaryTrajectoryPath(output_filename), config,
+                                         thrust_direction);
+        CsvTrajectorySink csv_sink(output_filename, mode, config.background_flush);
+        TeeTrajectorySink tee(binary_sink, csv_sink);
+        return propagateToOutput(config, r_departure, r_arrival, tee, writer_thread);
+    }
+    
+    if (write_csv) {
+        CsvTrajectorySink csv_sink(output_filename, mode, config.background_flush);
+        return propagateToOutput(config, r_departure, r_arrival, csv_sink, writer_thread);
+    }
+    
+    BinaryTrajectorySink binary_sink(binaryTrajectoryPath(output_filename), config,
+                                     thrust_direction);
+    return propagateToOutput(config, r_departure, r_arrival, binary_sink, writer_thread);
+}
@@ -6,19 +6,50 @@
 #include "propagator.h"
 #include "constants.h"
 #include "orbital_elements.h"
+#include "trajectory_sink.h"
+#include "events.h"
+
+class TrajectoryWriterThread;
 
 // ===========================================================================
 // PROPAGATION RESULT STRUCTURE
 // ===========================================================================
-// Contains both trajectory history and final mission result
+// Final mission state and summary statistics. The trajectory itself is
+// streamed to a TrajectorySink during propagation and never held here.
 
 struct PropagationResult {
     MissionState final_state;
     double total_delta_v;
     int coast_step;
-    std::vector<MissionState> trajectory_history;
     
-    PropagationResult() : total_delta_v(0), coast_step(-1) {}
+    // Step statistics (fixed-step integrators never reject a step)
+    long accepted_steps;
+    long rejected_steps;
+    long averaged_steps;            // "averaged": steps before the RK4 handoff
+    
+    // Located events in time order (config.locate_coast / config.events)
+    std::vector<MissionEvent> events;
+    
+    // Closed-form coast arc (config.coast_mode); coast_state is where the
+    // thrust arc ended and equals final_state when no arc was flown
+    MissionState coast_state;
+    double coast_arc_s;             // duration of the coast arc (s)
+    bool arrival_reached;           // "to_arrival" arc ended on the arrival radius
+    
+    // Stopped by config.pruning: final_state is where the mission stood
+    // when it could no longer beat the best one, not its outcome
+    bool pruned;
+    
+    // Jacobian of coast_state (config.compute_sensitivity, rk4 only) with
+    // respect to the departure state, thrust and ISP, at a fixed number of
+    // steps: how the thrust-arc end moves, not when it happens
+    bool has_sensitivity;
+    StateSensitivity sensitivity;
+    
+    PropagationResult() : total_delta_v(0), coast_step(-1),
+                          accepted_steps(0), rejected_steps(0), averaged_steps(0),
+                          coast_arc_s(0), arrival_reached(false), pruned(false),
+                          has_sensitivity(false) {}
 };
 
 // ===========================================================================
@@ -26,13 +57,48 @@ struct PropagationResult {
 // ===========================================================================
 
 /// Propagates a mission from start to coast or fuel depletion
-/// Returns full trajectory history and final state
+/// Every step is offered to sink (see TrajectorySink::wantsStep); memory
+/// use is independent of the number of steps. With config.coast_mode set,
+/// the unpowered arc after the thrust arc is then flown in closed form and
+/// its end is passed to sink.finish as one more step. The integrator named by
+/// config.integrator is created on the stack and the loop below is run for
+/// its concrete type.
+PropagationResult propagateMission(
+    const MissionConfig& config,
+    double r_departure,
+    double r_arrival,
+    TrajectorySink& sink
+);
+
+/// Propagation loop for one concrete integrator type
+/// The integrator classes are final, so integrator.step is a direct call
+/// that the compiler can inline into the loop. After setup the loop does
+/// no heap allocation unless an event is located. Instantiated for every
+/// integrator and precision mode the config overload can select (see the
+/// explicit instantiations in mission_propagation.cpp).
+template <typename Integrator>
+PropagationResult propagateMission(
+    Integrator& integrator,
+    const MissionConfig& config,
+    double r_departure,
+    double r_arrival,
+    TrajectorySink& sink
+);
+
+/// Convenience overload: stream the trajectory to disk
+/// Writes every config.save_interval-th step (plus the final state) when
+/// save_trajectory is set; otherwise nothing is kept. config.output_format
+/// selects the columnar binary file (output_filename with a .bin
+/// extension), the CSV file output_filename, or both. With
+/// config.async_output the files are written on writer_thread (or on a
+/// thread of this call's own when it is nullptr), see async_sink.h.
 PropagationResult propagateMission(
     const MissionConfig& config,
     double r_departure,
     double r_arrival,
     bool save_trajectory = false,
-    const std::string& output_filename = ""
+    const std::string& output_filename = "",
+    TrajectoryWriterThread* writer_thread = nullptr
 );
 
 #endif // MISSION_PROPAGATION_H
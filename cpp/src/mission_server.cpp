@@ -0,0 +1,311 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cmath>
+#include <cstdio>
+#include <yaml-cpp/yaml.h>
+#include "mission_server.h"
+#include "mission_propagation.h"
+#include "orbital_elements.h"
+#include "comparison.h"
+#include "constants.h"
+
+// Defined in mission_batch.cpp
+MissionConfig loadConfigFromYAML(const std::string& filename);
+bool applyThrusterPreset(const std::string& name, SpacecraftConfig& spacecraft);
+
+namespace {
+
+// ===========================================================================
+// JSON OUTPUT HELPERS
+// ===========================================================================
+
+/// Quoted JSON string with the mandatory escapes
+std::string jsonString(const std::string& value) {
+    std::string out = "\"";
+    for (char c : value) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escape[8];
+                    std::snprintf(escape, sizeof(escape), "\\u%04x", c);
+                    out += escape;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    return out + "\"";
+}
+
+/// JSON number (10 significant digits); null for NaN or infinity
+std::string jsonNumber(double value) {
+    if (!std::isfinite(value)) {
+        return "null";
+    }
+    std::ostringstream out;
+    out << std::setprecision(10) << value;
+    return out.str();
+}
+
+/// Resolve the mission fields of a request onto config
+/// @return false with message set if a field is malformed
+bool applyRequestFields(const YAML::Node& request, MissionConfig& config, std::string& message) {
+    if (request["thruster"]) {
+        std::string name = request["thruster"].as<std::string>();
+        if (!applyThrusterPreset(name, config.spacecraft)) {
+            message = "unknown thruster '" + name + "'";
+            return false;
+        }
+        config.spacecraft.name = name;
+    }
+    for (const char* key : {"departure_body", "arrival_body"}) {
+        if (request[key]) {
+            std::string name = request[key].as<std::string>();
+            CelestialBody& body = std::string(key) == "departure_body" ? config.departure_body
+                                                                      : config.arrival_body;
+            if (!findBodyByName(name, body)) {
+                message = "unknown body '" + name + "'";
+                return false;
+            }
+        }
+    }
+    if (request["integrator"]) {
+        config.integrator = request["integrator"].as<std::string>();
+    }
+    
+    struct NumericField {
+        const char* key;
+        double* value;
+    };
+    const NumericField fields[] = {
+        {"thrust_mN", &config.spacecraft.thrust_mN},
+        {"isp_s", &config.spacecraft.isp_s},
+        {"initial_mass_kg", &config.spacecraft.initial_mass_kg},
+        {"timestep_s", &config.timestep_s},
+        {"max_flight_time_s", &config.max_flight_time_s},
+    };
+    for (const NumericField& field : fields) {
+        if (request[field.key]) {
+            *field.value = request[field.key].as<double>();
+            if (!(*field.value > 0)) {
+                message = std::string(field.key) + " must be positive";
+                return false;
+            }
+        }
+    }
+    
+    // Only the result is wanted; no files of any kind
+    config.checkpoint_interval = 0;
+    config.checkpoint_file.clear();
+    config.resume = false;
+    config.async_output = false;
+    return true;
+}
+
+}  // namespace
+
+// ===========================================================================
+// SERVER LIFETIME
+// ===========================================================================
+
+MissionServer::MissionServer(unsigned jobs) {
+    unsigned num_threads = ThreadPool::resolveThreadCount(jobs);
+    if (num_threads > 1) {
+        pool = std::make_unique<ThreadPool>(num_threads);
+    }
+}
+
+MissionServer::~MissionServer() {
+    waitIdle();
+}
+
+void MissionServer::waitIdle() {
+    if (pool) {
+        pool->waitIdle();
+    }
+}
+
+// ===========================================================================
+// REQUEST HANDLING
+// ===========================================================================
+
+std::size_t MissionServer::serve(std::istream& in, std::ostream& out) {
+    std::size_t handled = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+        handled++;
+        if (!handleLine(line, out)) {
+            break;
+        }
+    }
+    waitIdle();
+    return handled;
+}
+
+bool MissionServer::handleLine(const std::string& line, std::ostream& out) {
+    Clock::time_point received = Clock::now();
+    std::string id;
+    MissionConfig config;
+    std::string message;
+    
+    try {
+        YAML::Node request = YAML::Load(line);
+        if (!request.IsMap()) {
+            reply("{\"id\":\"\",\"status\":\"error\",\"message\":\"request is not an object\"",
+                  true, received, out);
+            return true;
+        }
+        
+        if (request["command"]) {
+            std::string command = request["command"].as<std::string>();
+            if (command == "shutdown") {
+                return false;
+            }
+            if (command == "stats") {
+                ServerStatistics stats = statistics();
+                std::string json = "{\"command\":\"stats\",\"completed\":" +
+                                   std::to_string(stats.completed) +
+                                   ",\"errors\":" + std::to_string(stats.errors) +
+                                   ",\"cached_configs\":" + std::to_string(stats.cached_configs) +
+                                   ",\"latency_ms\":{\"mean\":" + jsonNumber(stats.mean_ms) +
+                                   ",\"p50\":" + jsonNumber(stats.p50_ms) +
+                                   ",\"p90\":" + jsonNumber(stats.p90_ms) +
+                                   ",\"p99\":" + jsonNumber(stats.p99_ms) +
+                                   ",\"max\":" + jsonNumber(stats.max_ms) + "}}\n";
+                std::lock_guard<std::mutex> lock(reply_mutex);
+                out << json << std::flush;
+                return true;
+            }
+            message = "unknown command '" + command + "'";
+        } else {
+            id = request["id"] ? request["id"].as<std::string>() : "";
+            if (request["config"]) {
+                std::string filename = request["config"].as<std::string>();
+                const MissionConfig* base = baseConfig(filename);
+                if (base) {
+                    config = *base;
+                } else {
+                    message = "cannot read config '" + filename + "'";
+                }
+            }
+            if (message.empty()) {
+                applyRequestFields(request, config, message);
+            }
+        }
+    } catch (const YAML::Exception& e) {
+        message = std::string("malformed request: ") + e.what();
+    }
+    
+    if (!message.empty()) {
+        reply("{\"id\":" + jsonString(id) + ",\"status\":\"error\",\"message\":" +
+              jsonString(message), true, received, out);
+        return true;
+    }
+    
+    if (pool) {
+        pool->submit([this, id, config, received, &out]() {
+            runRequest(id, config, received, out);
+        });
+    } else {
+        runRequest(id, config, received, out);
+    }
+    return true;
+}
+
+const MissionConfig* MissionServer::baseConfig(const std::string& filename) {
+    auto found = base_configs.find(filename);
+    if (found != base_configs.end()) {
+        return &found->second;
+    }
+    
+    // loadConfigFromYAML falls back to defaults for a missing file; a
+    // request naming one should fail instead
+    if (!std::ifstream(filename)) {
+        return nullptr;
+    }
+    return &base_configs.emplace(filename, loadConfigFromYAML(filename)).first->second;
+}
+
+void MissionServer::runRequest(const std::string& id, const MissionConfig& config,
+                               Clock::time_point received, std::ostream& out) {
+    PropagationResult propagation = propagateMission(config,
+                                                     getOrbitalRadius(config.departure_body),
+                                                     getOrbitalRadius(config.arrival_body), false);
+    
+    // Same fields as a batch mission
+    MissionResult mission;
+    mission.thruster_name = config.spacecraft.name;
+    mission.departure_body = getBodyName(config.departure_body);
+    mission.arrival_body = getBodyName(config.arrival_body);
+    mission.initial_mass_kg = config.spacecraft.initial_mass_kg;
+    mission.flight_time_days = propagation.final_state.t / 86400.0;
+    mission.total_delta_v_km_s = propagation.total_delta_v;
+    mission.final_mass_kg = propagation.final_state.m;
+    mission.propellant_consumed_kg = config.spacecraft.initial_mass_kg - propagation.final_state.m;
+    OrbitalElements elements = computeOrbitalElements(propagation.final_state.r,
+                                                      propagation.final_state.v, MU_SUN);
+    mission.final_apoapsis_km = elements.r_a;
+    mission.final_periapsis_km = elements.r_p;
+    mission.final_eccentricity = elements.e;
+    mission.final_semi_major_axis_km = elements.a;
+    computeMissionMetrics(mission);
+    
+    std::string json = "{\"id\":" + jsonString(id) + ",\"status\":\"ok\"" +
+                       ",\"thruster\":" + jsonString(mission.thruster_name) +
+                       ",\"departure_body\":" + jsonString(mission.departure_body) +
+                       ",\"arrival_body\":" + jsonString(mission.arrival_body) +
+                       ",\"coasted\":" + (propagation.coast_step >= 0 ? "true" : "false") +
+                       ",\"flight_time_days\":" + jsonNumber(mission.flight_time_days) +
+                       ",\"delta_v_km_s\":" + jsonNumber(mission.total_delta_v_km_s) +
+                       ",\"propellant_kg\":" + jsonNumber(mission.propellant_consumed_kg) +
+                       ",\"final_mass_kg\":" + jsonNumber(mission.final_mass_kg) +
+                       ",\"apoapsis_km\":" + jsonNumber(mission.final_apoapsis_km) +
+                       ",\"periapsis_km\":" + jsonNumber(mission.final_periapsis_km) +
+                       ",\"eccentricity\":" + jsonNumber(mission.final_eccentricity) +
+                       ",\"semi_major_axis_km\":" + jsonNumber(mission.final_semi_major_axis_km) +
+                       ",\"payload_fraction\":" + jsonNumber(mission.payload_fraction);
+    reply(json, false, received, out);
+}
+
+void MissionServer::reply(const std::string& json, bool error, Clock::time_point received,
+                          std::ostream& out) {
+    std::lock_guard<std::mutex> lock(reply_mutex);
+    double latency_ms = std::chrono::duration<double, std::milli>(Clock::now() - received).count();
+    out << json << ",\"latency_ms\":" << jsonNumber(latency_ms) << "}\n" << std::flush;
+    
+    completed++;
+    if (error) {
+        errors++;
+    }
+    latency.add(latency_ms);
+    latency_p50.add(latency_ms);
+    latency_p90.add(latency_ms);
+    latency_p99.add(latency_ms);
+}
+
+ServerStatistics MissionServer::statistics() const {
+    ServerStatistics stats;
+    stats.cached_configs = base_configs.size();
+    
+    std::lock_guard<std::mutex> lock(reply_mutex);
+    stats.completed = completed;
+    stats.errors = errors;
+    if (completed > 0) {
+        stats.mean_ms = latency.mean();
+        stats.p50_ms = latency_p50.value();
+        stats.p90_ms = latency_p90.value();
+        stats.p99_ms = latency_p99.value();
+        stats.max_ms = latency.max();
+    }
+    return stats;
+}
@@ -0,0 +1,125 @@
+#ifndef MISSION_SERVER_H
+#define MISSION_SERVER_H
+
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "propagator.h"
+#include "online_statistics.h"
+#include "thread_pool.h"
+
+// ===========================================================================
+// MISSION SERVICE (--serve)
+// ===========================================================================
+// A long-running process that answers mission requests, one JSON object
+// per line on stdin, with one JSON result per line on stdout. Process
+// start-up and YAML parsing are paid once: a base config file is parsed
+// the first time a request names it and kept for the following requests,
+// and thruster presets are resolved by name without touching a file.
+// Requests are scheduled on one shared thread pool as they arrive.
+//
+// Request (every field except id is optional):
+//
+//   {"id": "r1", "config": "../config/earth_mars_high_hall.yaml",
+//    "thruster": "High-Power Ion", "thrust_mN": 400, "isp_s": 8000,
+//    "initial_mass_kg": 9000, "departure_body": "Earth",
+//    "arrival_body": "Mars", "integrator": "rk4", "timestep_s": 10000,
+//    "max_flight_time_s": 1.577e9}
+//
+// Without "config" the request starts from the MissionConfig defaults;
+// "thruster" applies a preset and the numeric fields override it.
+// Trajectories are not written. Reply (the MissionResult fields):
+//
+//   {"id": "r1", "status": "ok", "thruster": "...", "departure_body": "Earth",
+//    "arrival_body": "Mars", "coasted": true, "flight_time_days": ...,
+//    "delta_v_km_s": ..., "propellant_kg": ..., "final_mass_kg": ...,
+//    "apoapsis_km": ..., "periapsis_km": ..., "eccentricity": ...,
+//    "semi_major_axis_km": ..., "payload_fraction": ..., "latency_ms": ...}
+//
+// or {"id": "r1", "status": "error", "message": "..."}. With more than
+// one job, replies come back in completion order; match them by id.
+//
+// Commands: {"command": "stats"} replies with the request count and
+// latency mean/percentiles/max (time from reading the request to writing
+// its reply) over the requests finished so far; {"command": "shutdown"}
+// stops reading, like end of input. Either way the server finishes the
+// requests in flight before serve() returns.
+//
+// JSON is parsed with yaml-cpp, whose flow syntax is a superset of JSON.
+// To serve a socket instead of a pipe, put the process behind an inetd or
+// socat listener.
+// ===========================================================================
+
+/// Latency summary of the finished requests (milliseconds)
+struct ServerStatistics {
+    std::size_t completed = 0;         // Replies written (including errors)
+    std::size_t errors = 0;
+    std::size_t cached_configs = 0;    // Base config files parsed so far
+    double mean_ms = 0;
+    double p50_ms = 0;
+    double p90_ms = 0;
+    double p99_ms = 0;
+    double max_ms = 0;
+};
+
+class MissionServer {
+public:
+    /// jobs as for --jobs (0 = one per hardware thread); with one job,
+    /// requests run on the reading thread
+    explicit MissionServer(unsigned jobs = 1);
+    
+    /// Finishes the requests in flight
+    ~MissionServer();
+    
+    MissionServer(const MissionServer&) = delete;
+    MissionServer& operator=(const MissionServer&) = delete;
+    
+    /// Answer requests from in until end of input or a shutdown command
+    /// @return number of request lines handled
+    std::size_t serve(std::istream& in, std::ostream& out);
+    
+    /// Handle one request line; the reply goes to out, from a worker
+    /// thread when requests run on the pool
+    /// @return false for a shutdown command
+    bool handleLine(const std::string& line, std::ostream& out);
+    
+    /// Block until every request handed to the pool has been answered
+    void waitIdle();
+    
+    ServerStatistics statistics() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+    
+    /// Parsed base config for a file, loaded on first use
+    /// @return nullptr if the file cannot be read
+    const MissionConfig* baseConfig(const std::string& filename);
+    
+    /// Propagate one resolved request and write its reply
+    void runRequest(const std::string& id, const MissionConfig& config,
+                    Clock::time_point received, std::ostream& out);
+    
+    /// Write one reply line and account for its latency
+    void reply(const std::string& json, bool error, Clock::time_point received,
+               std::ostream& out);
+    
+    std::unique_ptr<ThreadPool> pool;
+    
+    // Used by the reading thread only
+    std::map<std::string, MissionConfig> base_configs;
+    
+    // Guarded by reply_mutex: the output stream and the statistics
+    mutable std::mutex reply_mutex;
+    std::size_t completed = 0;
+    std::size_t errors = 0;
+    RunningStatistics latency;
+    StreamingQuantile latency_p50{0.50};
+    StreamingQuantile latency_p90{0.90};
+    StreamingQuantile latency_p99{0.99};
+};
+
+#endif // MISSION_SERVER_H
@@ -0,0 +1,184 @@
+#include <iostream>
+#include <iomanip>
+#include "mission_summary.h"
+#include "comparison.h"
+
+MissionSummary::MissionSummary(const std::vector<double>& percentiles)
+    : percentiles(percentiles), mutex(std::make_unique<std::mutex>()) {}
+
+// ===========================================================================
+// INTERNING
+// ===========================================================================
+
+std::uint32_t MissionSummary::intern(GroupTable& table, const std::string& name) {
+    auto found = table.ids.find(name);
+    if (found != table.ids.end()) {
+        return found->second;
+    }
+    std::uint32_t id = static_cast<std::uint32_t>(table.groups.size());
+    table.ids.emplace(name, id);
+    table.groups.emplace_back();
+    Group& group = table.groups.back();
+    group.name = name;
+    for (double percentile : percentiles) {
+        group.flight_time_quantiles.emplace_back(percentile / 100.0);
+    }
+    table.seen.push_back(false);
+    return id;
+}
+
+std::uint32_t MissionSummary::thrusterId(const std::string& name) {
+    std::lock_guard<std::mutex> lock(*mutex);
+    return intern(thruster_table, name);
+}
+
+std::uint32_t MissionSummary::targetId(const std::string& name) {
+    std::lock_guard<std::mutex> lock(*mutex);
+    return intern(target_table, name);
+}
+
+// ===========================================================================
+// ORDERED FOLDING
+// ===========================================================================
+
+void MissionSummary::add(std::size_t index, const MissionResult& mission) {
+    std::uint32_t thruster = thrusterId(mission.thruster_name);
+    std::uint32_t target = targetId(mission.arrival_body);
+    add(index, thruster, target, mission.flight_time_days, mission.total_delta_v_km_s,
+        mission.propellant_consumed_kg, !mission.pruned);
+}
+
+void MissionSummary::add(std::size_t index, std::uint32_t thruster, std::uint32_t target,
+                         double flight_time_days, double delta_v_km_s, double propellant_kg,
+                         bool counted) {
+    Record record = {thruster, target, flight_time_days, delta_v_km_s, propellant_kg, counted};
+    std::lock_guard<std::mutex> lock(*mutex);
+    if (index != next_index) {
+        pending.emplace(index, record);
+        return;
+    }
+    
+    // In order: fold it, then whatever it was holding up
+    fold(record);
+    next_index++;
+    auto next = pending.begin();
+    while (next != pending.end() && next->first == next_index) {
+        fold(next->second);
+        next_index++;
+        next = pending.erase(next);
+    }
+}
+
+void MissionSummary::finish() {
+    std::lock_guard<std::mutex> lock(*mutex);
+    for (const auto& entry : pending) {
+        fold(entry.second);
+        next_index = entry.first + 1;
+    }
+    pending.clear();
+}
+
+void MissionSummary::fold(const Record& record) {
+    folded++;
+    if (!record.counted) {
+        excluded_++;
+        return;
+    }
+    if (record.thruster != NO_GROUP) {
+        foldInto(thruster_table, record.thruster, record);
+    }
+    if (record.target != NO_GROUP) {
+        foldInto(target_table, record.target, record);
+    }
+}
+
+void MissionSummary::foldInto(GroupTable& table, std::uint32_t id, const Record& record) {
+    if (!table.seen[id]) {
+        table.seen[id] = true;
+        table.order.push_back(id);
+    }
+    Group& group = table.groups[id];
+    group.flight_time_days.add(record.flight_time_days);
+    group.delta_v_km_s.add(record.delta_v_km_s);
+    group.propellant_kg.add(record.propellant_kg);
+    for (StreamingQuantile& quantile : group.flight_time_quantiles) {
+        quantile.add(record.flight_time_days);
+    }
+}
+
+// ===========================================================================
+// REPORTING
+// ===========================================================================
+
+std::vector<const MissionSummary::Group*> MissionSummary::ordered(const GroupTable& table) const {
+    std::vector<const Group*> groups;
+    for (std::uint32_t id : table.order) {
+        groups.push_back(&table.groups[id]);
+    }
+    return groups;
+}
+
+std::vector<const MissionSummary::Group*> MissionSummary::thrusters() const {
+    return ordered(thruster_table);
+}
+
+std::vector<const MissionSummary::Group*> MissionSummary::targets() const {
+    return ordered(target_table);
+}
+
+namespace {
+
+/// "    Flight time p50 / p95: 412.0 / 530.2 days" (nothing without percentiles)
+void printQuantiles(const MissionSummary::Group& group) {
+    if (group.flight_time_quantiles.empty()) {
+        return;
+    }
+    std::cout << "    Flight time";
+    for (std::size_t q = 0; q < group.flight_time_quantiles.size(); q++) {
+        std::cout << (q == 0 ? " p" : " / p") << std::setprecision(0)
+                  << group.flight_time_quantiles[q].probability() * 100.0;
+    }
+    std::cout << ":";
+    for (std::size_t q = 0; q < group.flight_time_quantiles.size(); q++) {
+        std::cout << (q == 0 ? " " : " / ") << std::setprecision(1)
+                  << group.flight_time_quantiles[q].value();
+    }
+    std::cout << " days\n";
+}
+
+}  // namespace
+
+void MissionSummary::print() const {
+    std::vector<const Group*> thruster_groups = thrusters();
+    if (!thruster_groups.empty()) {
+        std::cout << "Results by Thruster Type:\n";
+        std::cout << "---\n";
+        for (const Group* group : thruster_groups) {
+            std::cout << "  " << group->name << ":\n";
+            std::cout << "    Missions: " << group->flight_time_days.count() << "\n";
+            std::cout << "    Avg flight time: " << std::fixed << std::setprecision(1)
+                      << group->flight_time_days.mean() << " days\n";
+            std::cout << "    Avg delta-V: " << std::setprecision(2)
+                      << group->delta_v_km_s.mean() << " km/s\n";
+            std::cout << "    Avg fuel consumed: " << std::setprecision(0)
+                      << group->propellant_kg.mean() << " kg\n";
+            printQuantiles(*group);
+        }
+        std::cout << "\n";
+    }
+    
+    std::vector<const Group*> target_groups = targets();
+    if (!target_groups.empty()) {
+        std::cout << "Results by Target Body:\n";
+        std::cout << "---\n";
+        for (const Group* group : target_groups) {
+            std::cout << "  To " << group->name << ":\n";
+            std::cout << "    Fastest transfer: " << std::fixed << std::setprecision(1)
+                      << group->flight_time_days.min() << " days\n";
+            std::cout << "    Minimum delta-V: " << std::setprecision(2)
+                      << group->delta_v_km_s.min() << " km/s\n";
+            printQuantiles(*group);
+        }
+        std::cout << "\n";
+    }
+}
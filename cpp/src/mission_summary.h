@@ -0,0 +1,114 @@
+#ifndef MISSION_SUMMARY_H
+#define MISSION_SUMMARY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "constants.h"
+#include "online_statistics.h"
+
+struct MissionResult;
+
+// ===========================================================================
+// STREAMING MISSION SUMMARY
+// ===========================================================================
+// Per-thruster and per-target figures (count, mean, extremes, percentiles)
+// built one mission at a time. Memory grows with the number of groups,
+// not of missions, so a summary of 10^5 sweep points holds no results.
+//
+// Group names are interned once. Each mission becomes a record with two
+// integer keys and its outcome, and nothing but the records is compared
+// or copied. Groups keep the order in which they first appear.
+//
+// Workers may call add() concurrently, in any order. The records are
+// folded in index order: a record that arrives early waits in a small
+// buffer until its predecessors are in. This matters because the
+// accumulators (online_statistics.h) depend on the order of their
+// values. So the summary is the same for every thread count, and the
+// buffer only holds the records currently out of order.
+// ===========================================================================
+
+class MissionSummary {
+public:
+    /// Group id for records that belong to no group of that kind
+    static constexpr std::uint32_t NO_GROUP = 0xffffffffu;
+    
+    /// Figures of one group
+    struct Group {
+        std::string name;
+        RunningStatistics flight_time_days;
+        RunningStatistics delta_v_km_s;
+        RunningStatistics propellant_kg;
+        std::vector<StreamingQuantile> flight_time_quantiles;   // One per percentile
+    };
+    
+    /// percentiles: flight-time percentiles kept per group (0-100)
+    explicit MissionSummary(const std::vector<double>& percentiles = {50, 95});
+    
+    /// Id of a thruster or target name (thread-safe)
+    std::uint32_t thrusterId(const std::string& name);
+    std::uint32_t targetId(const std::string& name);
+    
+    /// Add mission index (each index once, starting at 0). Pruned missions
+    /// are counted but left out of the figures. Thread-safe.
+    void add(std::size_t index, const MissionResult& mission);
+    
+    /// Add an outcome under interned ids; counted = false only counts it
+    void add(std::size_t index, std::uint32_t thruster, std::uint32_t target,
+             double flight_time_days, double delta_v_km_s, double propellant_kg,
+             bool counted = true);
+    
+    /// Fold the records still waiting for a missing index, in index order
+    void finish();
+    
+    /// Missions added, and those left out of the figures
+    std::size_t missions() const { return folded; }
+    std::size_t excluded() const { return excluded_; }
+    
+    /// Groups in order of first appearance (after all adds, or finish())
+    std::vector<const Group*> thrusters() const;
+    std::vector<const Group*> targets() const;
+    
+    /// Print the "by thruster" and "by target" sections (groups with figures)
+    void print() const;
+
+private:
+    struct Record {
+        std::uint32_t thruster;
+        std::uint32_t target;
+        double flight_time_days;
+        double delta_v_km_s;
+        double propellant_kg;
+        bool counted;
+    };
+    
+    /// Interned names of one kind, with their groups
+    struct GroupTable {
+        std::unordered_map<std::string, std::uint32_t> ids;
+        std::vector<Group> groups;              // By id
+        std::vector<std::uint32_t> order;       // Ids by first folded record
+        std::vector<bool> seen;                 // By id: listed in order
+    };
+    
+    std::uint32_t intern(GroupTable& table, const std::string& name);
+    void fold(const Record& record);
+    void foldInto(GroupTable& table, std::uint32_t id, const Record& record);
+    std::vector<const Group*> ordered(const GroupTable& table) const;
+    
+    std::vector<double> percentiles;
+    GroupTable thruster_table;
+    GroupTable target_table;
+    
+    std::unique_ptr<std::mutex> mutex;          // Held by add, intern and finish
+    std::size_t next_index = 0;                 // Next record to fold
+    std::map<std::size_t, Record> pending;      // Arrived ahead of next_index
+    std::size_t folded = 0;
+    std::size_t excluded_ = 0;
+};
+
+#endif // MISSION_SUMMARY_H
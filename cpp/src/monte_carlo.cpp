@@ -0,0 +1,307 @@
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <memory>
+#include <yaml-cpp/yaml.h>
+#include "monte_carlo.h"
+#include "philox.h"
+#include "batch_propagator.h"
+#include "thread_pool.h"
+#include "csv_writer.h"
+
+// Defined in mission_batch.cpp
+MissionConfig loadConfigFromYAML(const std::string& filename);
+
+namespace {
+
+/// Consecutive samples propagated by one pool task
+constexpr std::size_t MC_CHUNK_SIZE = 256;
+
+/// Chunks per thread in one wave; outcomes of a wave are buffered until
+/// they are fed to the accumulators in index order
+constexpr std::size_t MC_CHUNKS_PER_THREAD = 4;
+
+/// Philox counter word that separates the parameters' draws
+enum DrawIndex : std::uint32_t { DRAW_THRUST = 0, DRAW_ISP = 1, DRAW_MASS = 2 };
+
+/// Outcome of one sample, kept only until its wave is accumulated
+struct SampleOutcome {
+    double thrust_mN = 0;
+    double isp_s = 0;
+    double initial_mass_kg = 0;
+    bool coasted = false;
+    double flight_time_days = 0;
+    double propellant_kg = 0;
+    double delta_v_km_s = 0;
+};
+
+/// Draw one parameter's perturbation for a sample
+double perturb(const Philox4x32& rng, std::size_t index, DrawIndex draw,
+               const Dispersion& dispersion, double nominal) {
+    if (dispersion.distribution == Dispersion::Distribution::NONE) {
+        return nominal;
+    }
+    Philox4x32::Block block = rng.block(index, draw);
+    return dispersion.apply(nominal, uniformFromBits(block[0], block[1]),
+                            normalPairFromBlock(block)[0]);
+}
+
+/// Parse {distribution: uniform|normal|none, percent: X}
+bool parseDispersion(const YAML::Node& node, const std::string& name, Dispersion& dispersion) {
+    std::string distribution = node["distribution"] ? node["distribution"].as<std::string>()
+                                                    : "normal";
+    if (distribution == "uniform") {
+        dispersion.distribution = Dispersion::Distribution::UNIFORM;
+    } else if (distribution == "normal") {
+        dispersion.distribution = Dispersion::Distribution::NORMAL;
+    } else if (distribution == "none") {
+        dispersion.distribution = Dispersion::Distribution::NONE;
+    } else {
+        std::cerr << "Error: dispersion '" << name << "' has unknown distribution '"
+                  << distribution << "' (uniform, normal, none)\n";
+        return false;
+    }
+    
+    dispersion.percent = node["percent"] ? node["percent"].as<double>() : 0.0;
+    if (dispersion.percent < 0 || dispersion.percent >= 100) {
+        std::cerr << "Error: dispersion '" << name << "' percent must be in [0, 100)\n";
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+// ===========================================================================
+// SAMPLING
+// ===========================================================================
+
+double Dispersion::apply(double nominal, double unit_uniform, double unit_normal) const {
+    double fraction = percent / 100.0;
+    switch (distribution) {
+        case Distribution::UNIFORM: return nominal * (1.0 + fraction * (2.0 * unit_uniform - 1.0));
+        case Distribution::NORMAL:  return nominal * (1.0 + fraction * unit_normal);
+        default:                    return nominal;
+    }
+}
+
+MissionConfig MonteCarloSpec::configAt(std::size_t index) const {
+    Philox4x32 rng(seed);
+    MissionConfig config = base;
+    SpacecraftConfig& spacecraft = config.spacecraft;
+    spacecraft.thrust_mN = perturb(rng, index, DRAW_THRUST, thrust_mN, spacecraft.thrust_mN);
+    spacecraft.isp_s = perturb(rng, index, DRAW_ISP, isp_s, spacecraft.isp_s);
+    spacecraft.initial_mass_kg = perturb(rng, index, DRAW_MASS, initial_mass_kg,
+                                         spacecraft.initial_mass_kg);
+    return config;
+}
+
+// ===========================================================================
+// SUMMARIES
+// ===========================================================================
+
+MetricSummary::MetricSummary(const std::string& name, const std::vector<double>& percentiles)
+    : name(name) {
+    for (double percentile : percentiles) {
+        quantiles.emplace_back(percentile / 100.0);
+    }
+}
+
+void MetricSummary::add(double value) {
+    statistics.add(value);
+    for (StreamingQuantile& quantile : quantiles) {
+        quantile.add(value);
+    }
+}
+
+const MetricSummary* MonteCarloResult::metric(const std::string& name) const {
+    for (const MetricSummary& summary : metrics) {
+        if (summary.name == name) {
+            return &summary;
+        }
+    }
+    return nullptr;
+}
+
+// ===========================================================================
+// SPEC FILE LOADER
+// ===========================================================================
+
+bool loadMonteCarloFromYAML(const std::string& filename, MonteCarloSpec& spec) {
+    try {
+        YAML::Node yaml = YAML::LoadFile(filename);
+        if (!yaml["monte_carlo"]) {
+            std::cerr << "Error: no 'monte_carlo' section in " << filename << "\n";
+            return false;
+        }
+        
+        // Base settings use the mission file sections and loader
+        spec.base = loadConfigFromYAML(filename);
+        
+        YAML::Node mc = yaml["monte_carlo"];
+        if (mc["samples"]) {
+            long samples = mc["samples"].as<long>();
+            if (samples < 1) {
+                std::cerr << "Error: monte_carlo samples must be at least 1\n";
+                return false;
+            }
+            spec.samples = static_cast<std::size_t>(samples);
+        }
+        if (mc["seed"]) {
+            spec.seed = mc["seed"].as<std::uint64_t>();
+        }
+        if (mc["thrust_mN"] && !parseDispersion(mc["thrust_mN"], "thrust_mN", spec.thrust_mN)) {
+            return false;
+        }
+        if (mc["isp_s"] && !parseDispersion(mc["isp_s"], "isp_s", spec.isp_s)) {
+            return false;
+        }
+        if (mc["initial_mass_kg"] &&
+            !parseDispersion(mc["initial_mass_kg"], "initial_mass_kg", spec.initial_mass_kg)) {
+            return false;
+        }
+        if (mc["percentiles"]) {
+            spec.percentiles.clear();
+            for (const YAML::Node& value : mc["percentiles"]) {
+                double percentile = value.as<double>();
+                if (percentile <= 0 || percentile >= 100) {
+                    std::cerr << "Error: monte_carlo percentiles must be in (0, 100)\n";
+                    return false;
+                }
+                spec.percentiles.push_back(percentile);
+            }
+        }
+        
+        if (yaml["output"] && yaml["output"]["filename"]) {
+            spec.output_filename = yaml["output"]["filename"].as<std::string>();
+        }
+    } catch (const YAML::Exception& e) {
+        std::cerr << "Error loading Monte Carlo file: " << e.what() << std::endl;
+        return false;
+    }
+    
+    return true;
+}
+
+// ===========================================================================
+// EXECUTION
+// ===========================================================================
+
+MonteCarloResult runMonteCarlo(const MonteCarloSpec& spec, unsigned jobs) {
+    MonteCarloResult result;
+    result.samples = spec.samples;
+    for (const char* name : {"thrust_mN", "isp_s", "initial_mass_kg",
+                             "flight_time_days", "propellant_kg", "delta_v_km_s"}) {
+        result.metrics.emplace_back(name, spec.percentiles);
+    }
+    MetricSummary& thrust = result.metrics[0];
+    MetricSummary& isp = result.metrics[1];
+    MetricSummary& mass = result.metrics[2];
+    MetricSummary& flight_time = result.metrics[3];
+    MetricSummary& propellant = result.metrics[4];
+    MetricSummary& delta_v = result.metrics[5];
+    
+    double r_departure = getOrbitalRadius(spec.base.departure_body);
+    double r_arrival = getOrbitalRadius(spec.base.arrival_body);
+    
+    std::size_t chunks = (spec.samples + MC_CHUNK_SIZE - 1) / MC_CHUNK_SIZE;
+    unsigned num_threads = ThreadPool::resolveThreadCount(jobs);
+    if (num_threads > chunks) {
+        num_threads = static_cast<unsigned>(std::max<std::size_t>(chunks, 1));
+    }
+    std::unique_ptr<ThreadPool> pool;
+    if (num_threads > 1) {
+        pool = std::make_unique<ThreadPool>(num_threads);
+    }
+    
+    std::size_t wave_chunks = num_threads * MC_CHUNKS_PER_THREAD;
+    std::vector<SampleOutcome> wave(wave_chunks * MC_CHUNK_SIZE);
+    for (std::size_t first_chunk = 0; first_chunk < chunks; first_chunk += wave_chunks) {
+        std::size_t wave_begin = first_chunk * MC_CHUNK_SIZE;
+        std::size_t wave_end = std::min(spec.samples, wave_begin + wave.size());
+        
+        auto run_chunk = [&](std::size_t chunk) {
+            std::size_t begin = wave_begin + chunk * MC_CHUNK_SIZE;
+            std::size_t end = std::min(wave_end, begin + MC_CHUNK_SIZE);
+            std::vector<MissionConfig> configs;
+            for (std::size_t i = begin; i < end; i++) {
+                configs.push_back(spec.configAt(i));
+            }
+            
+            std::vector<PropagationResult> props =
+                propagateMissionBatch(configs, r_departure, r_arrival);
+            for (std::size_t k = 0; k < configs.size(); k++) {
+                const SpacecraftConfig& spacecraft = configs[k].spacecraft;
+                SampleOutcome& outcome = wave[begin - wave_begin + k];
+                outcome.thrust_mN = spacecraft.thrust_mN;
+                outcome.isp_s = spacecraft.isp_s;
+                outcome.initial_mass_kg = spacecraft.initial_mass_kg;
+                outcome.coasted = props[k].coast_step >= 0;
+                outcome.flight_time_days = props[k].final_state.t / 86400.0;
+                outcome.propellant_kg = spacecraft.initial_mass_kg - props[k].final_state.m;
+                outcome.delta_v_km_s = props[k].total_delta_v;
+            }
+        };
+        std::size_t count = (wave_end - wave_begin + MC_CHUNK_SIZE - 1) / MC_CHUNK_SIZE;
+        if (pool && count > 1) {
+            pool->parallelFor(count, run_chunk);
+        } else {
+            for (std::size_t chunk = 0; chunk < count; chunk++) {
+                run_chunk(chunk);
+            }
+        }
+        
+        // Index order, whatever order the chunks finished in
+        for (std::size_t i = 0; i < wave_end - wave_begin; i++) {
+            const SampleOutcome& outcome = wave[i];
+            thrust.add(outcome.thrust_mN);
+            isp.add(outcome.isp_s);
+            mass.add(outcome.initial_mass_kg);
+            if (outcome.coasted) {
+                result.coasted++;
+                flight_time.add(outcome.flight_time_days);
+                propellant.add(outcome.propellant_kg);
+                delta_v.add(outcome.delta_v_km_s);
+            }
+        }
+    }
+    
+    return result;
+}
+
+// ===========================================================================
+// STATISTICS TABLE OUTPUT
+// ===========================================================================
+
+bool writeMonteCarloCSV(const std::string& filename, const MonteCarloSpec& spec,
+                        const MonteCarloResult& result) {
+    CsvWriter file;
+    if (!file.open(filename)) {
+        return false;
+    }
+    
+    std::ostringstream header;
+    header << "Metric,Count,Mean,StdDev,Min,Max";
+    for (double percentile : spec.percentiles) {
+        header << ",P" << percentile;
+    }
+    header << "\n";
+    file.write(header.str());
+    
+    for (const MetricSummary& summary : result.metrics) {
+        const RunningStatistics& stats = summary.statistics;
+        bool empty = stats.count() == 0;
+        file.text(summary.name);
+        file.integer(static_cast<long long>(stats.count()));
+        file.general(stats.mean(), 10);
+        file.general(stats.stddev(), 10);
+        file.general(empty ? 0.0 : stats.min(), 10);
+        file.general(empty ? 0.0 : stats.max(), 10);
+        for (const StreamingQuantile& quantile : summary.quantiles) {
+            file.general(quantile.value(), 10);
+        }
+        file.endRow();
+    }
+    
+    return file.close();
+}
@@ -0,0 +1,108 @@
+#ifndef MONTE_CARLO_H
+#define MONTE_CARLO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "propagator.h"
+#include "online_statistics.h"
+
+// ===========================================================================
+// MONTE CARLO DISPERSION ANALYSIS
+// ===========================================================================
+// Propagates N copies of a mission whose thrust, ISP and initial mass are
+// perturbed by random dispersions, and reports statistics of the outcomes.
+//
+// Sample i is drawn from Philox4x32 with the spec's seed as key and
+// (i, parameter) as counter, so configAt(i) is a pure function of the
+// index: the same samples come out for any --jobs value, any chunking and
+// any subset of indices. Each parameter has its own counter, so adding a
+// dispersion to one parameter leaves the others' draws unchanged.
+//
+// Samples are propagated in chunks through propagateMissionBatch (SoA
+// kernel for rk4) on a thread pool, one bounded wave of chunks at a time.
+// Each wave's outcomes are fed to online accumulators in index order and
+// then dropped, so memory does not grow with the sample count and the
+// statistics do not depend on the thread count either.
+//
+// Spec file format (the base sections are the same as a mission file):
+//
+//   mission: {departure_body: Earth, arrival_body: Mars, initial_mass_kg: 10000}
+//   spacecraft: {thrust_mN: 1000, isp_s: 2750}
+//   integration: {method: rk4, timestep_s: 10000}
+//   monte_carlo:
+//     samples: 10000
+//     seed: 1
+//     thrust_mN: {distribution: uniform, percent: 3}      # +-3% (flat)
+//     isp_s: {distribution: normal, percent: 2}           # 2% one-sigma
+//     initial_mass_kg: {distribution: normal, percent: 0.5}
+//     percentiles: [5, 50, 95]
+//   output: {filename: monte_carlo_results.csv}
+//
+// A parameter without a dispersion keeps the base config's value.
+// ===========================================================================
+
+/// Random relative perturbation of one parameter
+struct Dispersion {
+    enum class Distribution { NONE, UNIFORM, NORMAL };
+    
+    Distribution distribution = Distribution::NONE;
+    double percent = 0;        // Uniform: half-width; normal: one sigma
+    
+    /// Perturbed value; unit_uniform in [0, 1), unit_normal ~ N(0, 1)
+    double apply(double nominal, double unit_uniform, double unit_normal) const;
+};
+
+struct MonteCarloSpec {
+    MissionConfig base;                         // Nominal mission
+    Dispersion thrust_mN;
+    Dispersion isp_s;
+    Dispersion initial_mass_kg;
+    std::size_t samples = 1000;
+    std::uint64_t seed = 1;                     // Philox key
+    std::vector<double> percentiles = {5, 50, 95};
+    std::string output_filename = "monte_carlo_results.csv";
+    
+    /// Config of sample index (any index; reproducible)
+    MissionConfig configAt(std::size_t index) const;
+};
+
+/// Streaming summary of one quantity
+struct MetricSummary {
+    std::string name;
+    RunningStatistics statistics;
+    std::vector<StreamingQuantile> quantiles;   // One per spec percentile
+    
+    MetricSummary(const std::string& name, const std::vector<double>& percentiles);
+    void add(double value);
+};
+
+struct MonteCarloResult {
+    std::size_t samples = 0;
+    std::size_t coasted = 0;                    // Reached coast before fuel/time ran out
+    
+    // Sampled inputs (every sample) and outcomes (samples that coasted)
+    std::vector<MetricSummary> metrics;
+    
+    /// Summary by name, or nullptr
+    const MetricSummary* metric(const std::string& name) const;
+};
+
+/// Load a Monte Carlo spec
+/// @return false (with a message on std::cerr) if the file cannot be read
+///         or a dispersion or percentile is malformed
+bool loadMonteCarloFromYAML(const std::string& filename, MonteCarloSpec& spec);
+
+/// Propagate every sample and accumulate the statistics
+/// jobs as for --jobs (0 = one per hardware thread). Results do not
+/// depend on jobs.
+MonteCarloResult runMonteCarlo(const MonteCarloSpec& spec, unsigned jobs = 0);
+
+/// Write one row per metric (count, mean, standard deviation, extremes,
+/// percentiles)
+/// @return false if the file cannot be opened
+bool writeMonteCarloCSV(const std::string& filename, const MonteCarloSpec& spec,
+                        const MonteCarloResult& result);
+
+#endif // MONTE_CARLO_H
@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <cmath>
+#include "online_statistics.h"
+
+// ===========================================================================
+// RUNNING STATISTICS
+// ===========================================================================
+
+double RunningStatistics::stddev() const {
+    return std::sqrt(variance());
+}
+
+// ===========================================================================
+// P-SQUARED QUANTILE ESTIMATOR
+// ===========================================================================
+
+StreamingQuantile::StreamingQuantile(double p) : p(p) {
+    desired[0] = 1;
+    desired[1] = 1 + 2 * p;
+    desired[2] = 1 + 4 * p;
+    desired[3] = 3 + 2 * p;
+    desired[4] = 5;
+    increments[0] = 0;
+    increments[1] = p / 2;
+    increments[2] = p;
+    increments[3] = (1 + p) / 2;
+    increments[4] = 1;
+}
+
+void StreamingQuantile::add(double value) {
+    if (count_ < 5) {
+        // Collect the first five values; sorted, they are the initial markers
+        heights[count_++] = value;
+        std::sort(heights, heights + count_);
+        return;
+    }
+    count_++;
+    
+    // Cell k holds the value; the extreme markers follow new extremes
+    int k;
+    if (value < heights[0]) {
+        heights[0] = value;
+        k = 0;
+    } else if (value >= heights[4]) {
+        heights[4] = value;
+        k = 3;
+    } else {
+        k = 0;
+        while (k < 3 && value >= heights[k + 1]) {
+            k++;
+        }
+    }
+    for (int i = k + 1; i < 5; i++) {
+        positions[i] += 1;
+    }
+    for (int i = 0; i < 5; i++) {
+        desired[i] += increments[i];
+    }
+    
+    // Move each middle marker at most one rank toward its ideal rank
+    for (int i = 1; i < 4; i++) {
+        double offset = desired[i] - positions[i];
+        bool up = offset >= 1 && positions[i + 1] - positions[i] > 1;
+        bool down = offset <= -1 && positions[i - 1] - positions[i] < -1;
+        if (!up && !down) {
+            continue;
+        }
+        double d = up ? 1.0 : -1.0;
+        
+        // Piecewise-parabolic prediction, linear if it would break the order
+        double left = positions[i] - positions[i - 1];
+        double right = positions[i + 1] - positions[i];
+        double parabolic = heights[i] + d / (positions[i + 1] - positions[i - 1]) *
+                           ((left + d) * (heights[i + 1] - heights[i]) / right +
+                            (right - d) * (heights[i] - heights[i - 1]) / left);
+        if (heights[i - 1] < parabolic && parabolic < heights[i + 1]) {
+            heights[i] = parabolic;
+        } else {
+            int j = up ? i + 1 : i - 1;
+            heights[i] += d * (heights[j] - heights[i]) / (positions[j] - positions[i]);
+        }
+        positions[i] += d;
+    }
+}
+
+double StreamingQuantile::value() const {
+    if (count_ == 0) {
+        return 0;
+    }
+    if (count_ <= 5) {
+        // Exact: linear interpolation between the sorted values
+        double rank = p * static_cast<double>(count_ - 1);
+        std::size_t below = static_cast<std::size_t>(rank);
+        std::size_t above = std::min(below + 1, count_ - 1);
+        return heights[below] + (rank - below) * (heights[above] - heights[below]);
+    }
+    return heights[2];
+}
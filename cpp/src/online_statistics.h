@@ -0,0 +1,80 @@
+#ifndef ONLINE_STATISTICS_H
+#define ONLINE_STATISTICS_H
+
+#include <cstddef>
+#include <limits>
+
+// ===========================================================================
+// ONLINE (STREAMING) STATISTICS
+// ===========================================================================
+// Accumulators that see each value once and keep O(1) state, so statistics
+// over millions of samples never hold the samples themselves.
+//
+// - RunningStatistics: count, mean, variance (Welford's update, which
+//   avoids the cancellation of the sum-of-squares formula), min and max.
+// - StreamingQuantile: the P-squared estimator of Jain and Chlamtac
+//   (CACM 1985). Five markers track the minimum, the p/2, p and (1+p)/2
+//   quantiles and the maximum; each new value moves the middle markers
+//   toward their ideal ranks with a piecewise-parabolic fit. Exact for
+//   the first five values, then an estimate whose error shrinks as the
+//   distribution is sampled more densely.
+//
+// Both depend on the order values arrive in; feed them in a fixed order
+// for reproducible results.
+// ===========================================================================
+
+class RunningStatistics {
+public:
+    void add(double value) {
+        count_++;
+        double delta = value - mean_;
+        mean_ += delta / static_cast<double>(count_);
+        m2 += delta * (value - mean_);
+        min_ = value < min_ ? value : min_;
+        max_ = value > max_ ? value : max_;
+    }
+    
+    std::size_t count() const { return count_; }
+    double mean() const { return mean_; }
+    
+    /// Sample variance (n - 1 denominator); 0 below two values
+    double variance() const {
+        return count_ > 1 ? m2 / static_cast<double>(count_ - 1) : 0.0;
+    }
+    double stddev() const;
+    
+    /// Extremes (+inf / -inf while empty)
+    double min() const { return min_; }
+    double max() const { return max_; }
+
+private:
+    std::size_t count_ = 0;
+    double mean_ = 0;
+    double m2 = 0;                 // Sum of squared deviations from the mean
+    double min_ = std::numeric_limits<double>::infinity();
+    double max_ = -std::numeric_limits<double>::infinity();
+};
+
+class StreamingQuantile {
+public:
+    /// Track quantile p (0 < p < 1, e.g. 0.95)
+    explicit StreamingQuantile(double p);
+    
+    void add(double value);
+    
+    /// Current estimate (0 while empty)
+    double value() const;
+    
+    double probability() const { return p; }
+    std::size_t count() const { return count_; }
+
+private:
+    double p;
+    std::size_t count_ = 0;
+    double heights[5] = {0, 0, 0, 0, 0};     // Marker values (first five: raw values)
+    double positions[5] = {1, 2, 3, 4, 5};   // Marker ranks, 1-based
+    double desired[5] = {0, 0, 0, 0, 0};     // Ideal marker ranks
+    double increments[5] = {0, 0, 0, 0, 0};  // Ideal rank growth per value
+};
+
+#endif // ONLINE_STATISTICS_H
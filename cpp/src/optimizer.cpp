@@ -0,0 +1,574 @@
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <yaml-cpp/yaml.h>
+#include "optimizer.h"
+#include "batch_propagator.h"
+#include "orbital_elements.h"
+#include "result_cache.h"
+#include "thread_pool.h"
+#include "csv_writer.h"
+
+// Defined in mission_batch.cpp
+MissionConfig loadConfigFromYAML(const std::string& filename);
+
+namespace {
+
+// Standard Nelder-Mead coefficients
+constexpr double REFLECTION = 1.0;
+constexpr double EXPANSION = 2.0;
+constexpr double CONTRACTION = 0.5;
+constexpr double SHRINKAGE = 0.5;
+
+/// Score of an infeasible design, scaled by (1 + violation)
+/// Far above any metric value, so every feasible design beats it
+constexpr double INFEASIBLE_PENALTY = 1e9;
+
+std::vector<double> clampToBox(std::vector<double> point) {
+    for (double& x : point) {
+        x = std::min(1.0, std::max(0.0, x));
+    }
+    return point;
+}
+
+/// from + coefficient * (to - from), clamped onto the unit box
+std::vector<double> along(const std::vector<double>& from, const std::vector<double>& to,
+                          double coefficient) {
+    std::vector<double> point(from.size());
+    for (std::size_t i = 0; i < from.size(); i++) {
+        point[i] = from[i] + coefficient * (to[i] - from[i]);
+    }
+    return clampToBox(point);
+}
+
+/// Parse one design parameter: a single value (fixed) or {min, max}
+bool parseRange(const YAML::Node& node, const std::string& name, ParameterRange& range) {
+    if (node.IsMap()) {
+        if (!node["min"] || !node["max"]) {
+            std::cerr << "Error: optimize parameter '" << name << "' needs min and max\n";
+            return false;
+        }
+        range.min = node["min"].as<double>();
+        range.max = node["max"].as<double>();
+        if (range.max < range.min) {
+            std::cerr << "Error: optimize parameter '" << name << "' has max < min\n";
+            return false;
+        }
+    } else {
+        range.min = range.max = node.as<double>();
+    }
+    return true;
+}
+
+double rangeValue(const ParameterRange& range, double x) {
+    return range.min + (range.max - range.min) * x;
+}
+
+/// Start points: the box centre, then a Latin hypercube (each remaining
+/// start takes a different random stratum of every dimension)
+std::vector<std::vector<double>> startPoints(std::size_t dimensions, int starts,
+                                             std::uint64_t seed) {
+    std::vector<std::vector<double>> points(starts, std::vector<double>(dimensions, 0.5));
+    std::size_t strata = static_cast<std::size_t>(std::max(starts - 1, 0));
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    
+    std::vector<std::size_t> order(strata);
+    for (std::size_t d = 0; d < dimensions; d++) {
+        std::iota(order.begin(), order.end(), 0);
+        std::shuffle(order.begin(), order.end(), rng);
+        for (std::size_t k = 0; k < strata; k++) {
+            points[k + 1][d] = (order[k] + uniform(rng)) / strata;
+        }
+    }
+    return points;
+}
+
+/// Fraction of the transfer still missing when thrusting stopped
+double radiusShortfall(const MissionConfig& config, const PropagationResult& propagation) {
+    double r_departure = getOrbitalRadius(config.departure_body);
+    double r_arrival = getOrbitalRadius(config.arrival_body);
+    if (r_arrival == r_departure) {
+        return 0;
+    }
+    Apsides apsides = computeApsides(propagation.final_state.r, propagation.final_state.v, MU_SUN);
+    double reached = r_arrival > r_departure ? apsides.r_a : apsides.r_p;
+    return std::max(0.0, (r_arrival - reached) / (r_arrival - r_departure));
+}
+
+}  // namespace
+
+// ===========================================================================
+// NELDER-MEAD IMPLEMENTATION
+// ===========================================================================
+
+NelderMead::NelderMead(const std::vector<double>& start, const NelderMeadOptions& options)
+    : options(options), dimensions(start.size()) {
+    std::vector<double> origin = clampToBox(start);
+    vertices.push_back(origin);
+    for (std::size_t i = 0; i < dimensions; i++) {
+        std::vector<double> vertex = origin;
+        // Step inward from an upper face so the simplex keeps its volume
+        vertex[i] += (origin[i] + options.initial_step <= 1.0) ? options.initial_step
+                                                              : -options.initial_step;
+        vertices.push_back(clampToBox(vertex));
+    }
+    values.assign(vertices.size(), 0.0);
+    points = vertices;
+}
+
+void NelderMead::tell(const std::vector<double>& results) {
+    if (phase == Phase::DONE || results.size() != points.size()) {
+        return;
+    }
+    evaluation_count += static_cast<int>(results.size());
+    std::size_t worst = dimensions;
+    
+    switch (phase) {
+    case Phase::INITIAL:
+        values = results;
+        startIteration();
+        break;
+    
+    case Phase::REFLECT:
+        if (results[0] < values[0]) {
+            // Better than the best: try going further
+            reflected = points[0];
+            reflected_value = results[0];
+            points = {along(centroid, reflected, EXPANSION)};
+            phase = Phase::EXPAND;
+        } else if (results[0] < values[worst - 1]) {
+            replaceWorst(points[0], results[0]);
+            startIteration();
+        } else {
+            // No better than the second worst: contract toward the centroid
+            reflected = points[0];
+            reflected_value = results[0];
+            outside_contraction = reflected_value < values[worst];
+            points = {along(centroid, outside_contraction ? reflected : vertices[worst],
+                            CONTRACTION)};
+            phase = Phase::CONTRACT;
+        }
+        break;
+    
+    case Phase::EXPAND:
+        if (results[0] < reflected_value) {
+            replaceWorst(points[0], results[0]);
+        } else {
+            replaceWorst(reflected, reflected_value);
+        }
+        startIteration();
+        break;
+    
+    case Phase::CONTRACT:
+        if (outside_contraction ? results[0] <= reflected_value : results[0] < values[worst]) {
+            replaceWorst(points[0], results[0]);
+            startIteration();
+        } else {
+            queueShrink();
+        }
+        break;
+    
+    case Phase::SHRINK:
+        for (std::size_t i = 1; i < vertices.size(); i++) {
+            vertices[i] = points[i - 1];
+            values[i] = results[i - 1];
+        }
+        startIteration();
+        break;
+    
+    case Phase::DONE:
+        break;
+    }
+}
+
+void NelderMead::startIteration() {
+    // Sort the simplex by value (stable, so ties keep the older vertex first)
+    std::vector<std::size_t> order(vertices.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [this](std::size_t a, std::size_t b) { return values[a] < values[b]; });
+    std::vector<std::vector<double>> sorted_vertices;
+    std::vector<double> sorted_values;
+    for (std::size_t index : order) {
+        sorted_vertices.push_back(vertices[index]);
+        sorted_values.push_back(values[index]);
+    }
+    vertices.swap(sorted_vertices);
+    values.swap(sorted_values);
+    
+    double size = 0;
+    for (std::size_t i = 1; i < vertices.size(); i++) {
+        for (std::size_t d = 0; d < dimensions; d++) {
+            size = std::max(size, std::abs(vertices[i][d] - vertices[0][d]));
+        }
+    }
+    has_converged = size <= options.tolerance;
+    if (has_converged || evaluation_count >= options.max_evaluations) {
+        points.clear();
+        phase = Phase::DONE;
+        return;
+    }
+    
+    centroid.assign(dimensions, 0.0);
+    for (std::size_t i = 0; i < dimensions; i++) {
+        for (std::size_t d = 0; d < dimensions; d++) {
+            centroid[d] += vertices[i][d] / dimensions;
+        }
+    }
+    points = {along(centroid, vertices[dimensions], -REFLECTION)};
+    phase = Phase::REFLECT;
+}
+
+void NelderMead::replaceWorst(const std::vector<double>& point, double value) {
+    vertices[dimensions] = point;
+    values[dimensions] = value;
+}
+
+void NelderMead::queueShrink() {
+    points.clear();
+    for (std::size_t i = 1; i < vertices.size(); i++) {
+        points.push_back(along(vertices[0], vertices[i], SHRINKAGE));
+    }
+    phase = Phase::SHRINK;
+}
+
+NelderMead minimizeNelderMead(const std::function<double(const std::vector<double>&)>& objective,
+                              const std::vector<double>& start,
+                              const NelderMeadOptions& options) {
+    NelderMead search(start, options);
+    std::vector<double> results;
+    while (!search.done()) {
+        results.clear();
+        for (const std::vector<double>& point : search.pending()) {
+            results.push_back(objective(point));
+        }
+        search.tell(results);
+    }
+    return search;
+}
+
+// ===========================================================================
+// DESIGN SPACE
+// ===========================================================================
+
+std::size_t OptimizationSpec::dimensions() const {
+    return (thrust_mN.isFree() ? 1 : 0) + (isp_s.isFree() ? 1 : 0) +
+           (initial_mass_kg.isFree() ? 1 : 0);
+}
+
+MissionConfig OptimizationSpec::configAt(const std::vector<double>& x) const {
+    MissionConfig config = base;
+    std::size_t k = 0;
+    if (thrust_mN.isFree()) {
+        config.spacecraft.thrust_mN = rangeValue(thrust_mN, x[k++]);
+    }
+    if (isp_s.isFree()) {
+        config.spacecraft.isp_s = rangeValue(isp_s, x[k++]);
+    }
+    if (initial_mass_kg.isFree()) {
+        config.spacecraft.initial_mass_kg = rangeValue(initial_mass_kg, x[k++]);
+    }
+    return config;
+}
+
+// ===========================================================================
+// SPEC FILE LOADER
+// ===========================================================================
+
+bool loadOptimizationFromYAML(const std::string& filename, OptimizationSpec& spec) {
+    try {
+        YAML::Node yaml = YAML::LoadFile(filename);
+        if (!yaml["optimize"]) {
+            std::cerr << "Error: no 'optimize' section in " << filename << "\n";
+            return false;
+        }
+        
+        // Base settings use the mission file sections and loader
+        spec.base = loadConfigFromYAML(filename);
+        spec.base.output_filename.clear();  // The table name must not change cache keys
+        
+        YAML::Node optimize = yaml["optimize"];
+        if (optimize["objective"]) {
+            spec.objective = optimize["objective"].as<std::string>();
+        }
+        if (!isMissionMetric(spec.objective)) {
+            std::cerr << "Error: unknown optimize objective '" << spec.objective
+                      << "' (shortest_time, lowest_delta_v, least_fuel, most_efficient)\n";
+            return false;
+        }
+        if (optimize["propellant_budget_kg"]) {
+            spec.propellant_budget_kg = optimize["propellant_budget_kg"].as<double>();
+        }
+        
+        // Fixed values go straight into the base config
+        SpacecraftConfig& spacecraft = spec.base.spacecraft;
+        spec.thrust_mN = {spacecraft.thrust_mN, spacecraft.thrust_mN};
+        spec.isp_s = {spacecraft.isp_s, spacecraft.isp_s};
+        spec.initial_mass_kg = {spacecraft.initial_mass_kg, spacecraft.initial_mass_kg};
+        if (optimize["thrust_mN"] &&
+            !parseRange(optimize["thrust_mN"], "thrust_mN", spec.thrust_mN)) {
+            return false;
+        }
+        if (optimize["isp_s"] && !parseRange(optimize["isp_s"], "isp_s", spec.isp_s)) {
+            return false;
+        }
+        if (optimize["initial_mass_kg"] &&
+            !parseRange(optimize["initial_mass_kg"], "initial_mass_kg", spec.initial_mass_kg)) {
+            return false;
+        }
+        spacecraft.thrust_mN = spec.thrust_mN.min;
+        spacecraft.isp_s = spec.isp_s.min;
+        spacecraft.initial_mass_kg = spec.initial_mass_kg.min;
+        
+        if (optimize["starts"]) {
+            spec.starts = optimize["starts"].as<int>();
+        }
+        if (optimize["max_evaluations"]) {
+            spec.max_evaluations = optimize["max_evaluations"].as<int>();
+        }
+        if (optimize["tolerance"]) {
+            spec.tolerance = optimize["tolerance"].as<double>();
+        }
+        if (optimize["seed"]) {
+            spec.seed = optimize["seed"].as<std::uint64_t>();
+        }
+        if (spec.starts < 1 || spec.max_evaluations < 1) {
+            std::cerr << "Error: optimize starts and max_evaluations must be at least 1\n";
+            return false;
+        }
+        
+        if (yaml["output"] && yaml["output"]["filename"]) {
+            spec.output_filename = yaml["output"]["filename"].as<std::string>();
+        }
+    } catch (const YAML::Exception& e) {
+        std::cerr << "Error loading optimization file: " << e.what() << std::endl;
+        return false;
+    }
+    
+    return true;
+}
+
+// ===========================================================================
+// CANDIDATE EVALUATION
+// ===========================================================================
+
+OptimizationPoint evaluateCandidate(const OptimizationSpec& spec, const MissionConfig& config,
+                                    const PropagationResult& propagation) {
+    OptimizationPoint point;
+    point.thrust_mN = config.spacecraft.thrust_mN;
+    point.isp_s = config.spacecraft.isp_s;
+    point.initial_mass_kg = config.spacecraft.initial_mass_kg;
+    
+    // Same fields as a batch mission, so the comparison metrics apply
+    MissionResult& mission = point.mission;
+    mission.thruster_name = config.spacecraft.name;
+    mission.departure_body = getBodyName(config.departure_body);
+    mission.arrival_body = getBodyName(config.arrival_body);
+    mission.initial_mass_kg = config.spacecraft.initial_mass_kg;
+    mission.flight_time_days = propagation.final_state.t / 86400.0;
+    mission.total_delta_v_km_s = propagation.total_delta_v;
+    mission.final_mass_kg = propagation.final_state.m;
+    mission.propellant_consumed_kg = config.spacecraft.initial_mass_kg - propagation.final_state.m;
+    OrbitalElements elements = computeOrbitalElements(propagation.final_state.r,
+                                                      propagation.final_state.v, MU_SUN);
+    mission.final_apoapsis_km = elements.r_a;
+    mission.final_periapsis_km = elements.r_p;
+    mission.final_eccentricity = elements.e;
+    mission.final_semi_major_axis_km = elements.a;
+    computeMissionMetrics(mission);
+    
+    // Violation: missing transfer (at least 1) plus relative budget overrun
+    point.coasted = propagation.coast_step >= 0;
+    double violation = 0;
+    if (!point.coasted) {
+        violation += 1.0 + radiusShortfall(config, propagation);
+    }
+    if (spec.propellant_budget_kg > 0 && mission.propellant_consumed_kg > spec.propellant_budget_kg) {
+        violation += (mission.propellant_consumed_kg - spec.propellant_budget_kg) /
+                     spec.propellant_budget_kg;
+    }
+    point.feasible = violation == 0;
+    point.objective = point.feasible ? missionMetricScore(mission, spec.objective)
+                                     : INFEASIBLE_PENALTY * (1.0 + violation);
+    return point;
+}
+
+// ===========================================================================
+// MULTI-START SEARCH
+// ===========================================================================
+
+OptimizationResult runOptimization(const OptimizationSpec& spec, unsigned jobs,
+                                   const std::string& cache_directory) {
+    OptimizationResult result;
+    double r_departure = getOrbitalRadius(spec.base.departure_body);
+    double r_arrival = getOrbitalRadius(spec.base.arrival_body);
+    
+    NelderMeadOptions options;
+    options.tolerance = spec.tolerance;
+    options.max_evaluations = spec.max_evaluations;
+    std::vector<NelderMead> searches;
+    for (const std::vector<double>& start : startPoints(spec.dimensions(), spec.starts, spec.seed)) {
+        searches.emplace_back(start, options);
+    }
+    result.starts.resize(searches.size());
+    
+    unsigned num_threads = ThreadPool::resolveThreadCount(jobs);
+    std::unique_ptr<ThreadPool> pool;
+    if (num_threads > 1) {
+        pool = std::make_unique<ThreadPool>(num_threads);
+    }
+    std::atomic<long> cache_hits{0};
+    
+    std::vector<MissionConfig> population;
+    std::vector<OptimizationPoint> evaluated;
+    while (true) {
+        // One population per generation: every search's pending points
+        population.clear();
+        for (const NelderMead& search : searches) {
+            for (const std::vector<double>& x : search.pending()) {
+                population.push_back(spec.configAt(x));
+            }
+        }
+        if (population.empty()) {
+            break;
+        }
+        
+        // One contiguous chunk per worker, propagated as one batch after
+        // the cached candidates are taken out
+        evaluated.assign(population.size(), OptimizationPoint());
+        std::size_t chunk_size = (population.size() + num_threads - 1) / num_threads;
+        std::size_t chunks = (population.size() + chunk_size - 1) / chunk_size;
+        auto run_chunk = [&](std::size_t chunk) {
+            std::size_t begin = chunk * chunk_size;
+            std::size_t end = std::min(population.size(), begin + chunk_size);
+            std::vector<MissionConfig> missing;
+            std::vector<std::size_t> missing_index;
+            for (std::size_t i = begin; i < end; i++) {
+                CachedMission cached;
+                if (!cache_directory.empty() &&
+                    ResultCache(cache_directory).lookup(hashMissionConfig(population[i]), cached)) {
+                    evaluated[i] = evaluateCandidate(spec, population[i], cached.propagation);
+                    cache_hits++;
+                } else {
+                    missing.push_back(population[i]);
+                    missing_index.push_back(i);
+                }
+            }
+            if (missing.empty()) {
+                return;
+            }
+            
+            std::vector<PropagationResult> props =
+                propagateMissionBatch(missing, r_departure, r_arrival);
+            for (std::size_t k = 0; k < missing.size(); k++) {
+                OptimizationPoint& point = evaluated[missing_index[k]];
+                point = evaluateCandidate(spec, missing[k], props[k]);
+                if (!cache_directory.empty()) {
+                    CachedMission entry;
+                    entry.result = point.mission;
+                    entry.propagation = props[k];
+                    ResultCache(cache_directory).store(hashMissionConfig(missing[k]), entry);
+                }
+            }
+        };
+        if (pool && chunks > 1) {
+            pool->parallelFor(chunks, run_chunk);
+        } else {
+            for (std::size_t chunk = 0; chunk < chunks; chunk++) {
+                run_chunk(chunk);
+            }
+        }
+        
+        // Hand each search its slice, remembering the first and best designs
+        std::size_t offset = 0;
+        for (std::size_t s = 0; s < searches.size(); s++) {
+            std::size_t count = searches[s].pending().size();
+            if (count == 0) {
+                continue;
+            }
+            OptimizationStart& start = result.starts[s];
+            std::vector<double> values;
+            for (std::size_t i = offset; i < offset + count; i++) {
+                if (searches[s].evaluations() == 0 && i == offset) {
+                    start.initial = evaluated[i];
+                    start.best = evaluated[i];
+                }
+                if (evaluated[i].objective < start.best.objective) {
+                    start.best = evaluated[i];
+                }
+                values.push_back(evaluated[i].objective);
+            }
+            searches[s].tell(values);
+            offset += count;
+        }
+        result.generations++;
+        result.evaluations += static_cast<long>(population.size());
+    }
+    
+    // Overall winner: findBestMission over the feasible searches, else the
+    // smallest penalty
+    MissionComparison comparison;
+    for (std::size_t s = 0; s < searches.size(); s++) {
+        OptimizationStart& start = result.starts[s];
+        start.evaluations = searches[s].evaluations();
+        start.converged = searches[s].converged();
+        start.best.mission.mission_name = "start_" + std::to_string(s);
+        if (start.best.feasible) {
+            comparison.addMission(start.best.mission);
+            result.feasible = true;
+        }
+        if (start.best.objective < result.starts[result.best_start].best.objective) {
+            result.best_start = s;
+        }
+    }
+    if (result.feasible) {
+        std::string winner = comparison.findBestMission(spec.objective).mission_name;
+        result.best_start = std::stoul(winner.substr(winner.find('_') + 1));
+    }
+    result.cache_hits = cache_hits.load();
+    return result;
+}
+
+// ===========================================================================
+// RESULTS TABLE OUTPUT
+// ===========================================================================
+
+bool writeOptimizationCSV(const std::string& filename, const OptimizationResult& result) {
+    CsvWriter file;
+    if (!file.open(filename)) {
+        return false;
+    }
+    
+    file.write("Start,Best,Converged,Evaluations,StartThrust(mN),StartISP(s),StartMass(kg),"
+               "Thrust(mN),ISP(s),InitialMass(kg),Feasible,Objective,FlightTime(days),"
+               "DeltaV(km/s),Propellant(kg),PayloadFraction\n");
+    
+    for (std::size_t s = 0; s < result.starts.size(); s++) {
+        const OptimizationStart& start = result.starts[s];
+        const OptimizationPoint& best = start.best;
+        file.integer(static_cast<long long>(s));
+        file.integer(s == result.best_start ? 1 : 0);
+        file.integer(start.converged ? 1 : 0);
+        file.integer(start.evaluations);
+        file.general(start.initial.thrust_mN, 10);
+        file.general(start.initial.isp_s, 10);
+        file.general(start.initial.initial_mass_kg, 10);
+        file.general(best.thrust_mN, 10);
+        file.general(best.isp_s, 10);
+        file.general(best.initial_mass_kg, 10);
+        file.integer(best.feasible ? 1 : 0);
+        file.general(best.objective, 10);
+        file.fixed(best.mission.flight_time_days, 3);
+        file.fixed(best.mission.total_delta_v_km_s, 3);
+        file.fixed(best.mission.propellant_consumed_kg, 3);
+        file.fixed(best.mission.payload_fraction, 6);
+        file.endRow();
+    }
+    
+    return file.close();
+}
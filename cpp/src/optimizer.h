@@ -0,0 +1,191 @@
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "propagator.h"
+#include "comparison.h"
+#include "mission_propagation.h"
+
+// ===========================================================================
+// NELDER-MEAD SIMPLEX
+// ===========================================================================
+// Derivative-free minimizer over the unit box [0,1]^n. Trial points are
+// clamped onto the box, so bounds never need a penalty. The search is an
+// ask/tell state machine: pending() lists the points whose objective
+// values the next tell() expects (the initial simplex, one reflection,
+// expansion or contraction, or the n points of a shrink). A caller can
+// therefore advance many searches in lockstep and evaluate all of their
+// pending points together.
+// ===========================================================================
+
+struct NelderMeadOptions {
+    double initial_step = 0.25;    // Edge of the initial simplex (box units)
+    double tolerance = 1e-3;       // Converged once every vertex is this close to the best
+    int max_evaluations = 100;     // Objective evaluations before giving up
+};
+
+class NelderMead {
+public:
+    /// Search from start (n coordinates in [0,1]; n = 0 is allowed)
+    NelderMead(const std::vector<double>& start, const NelderMeadOptions& options);
+    
+    /// Points to evaluate next (empty once done)
+    const std::vector<std::vector<double>>& pending() const { return points; }
+    
+    /// Objective values of pending(), in the same order
+    void tell(const std::vector<double>& values);
+    
+    /// No more points to evaluate (converged or out of evaluations)
+    bool done() const { return phase == Phase::DONE; }
+    
+    /// Stopped because the simplex shrank below the tolerance
+    bool converged() const { return has_converged; }
+    
+    const std::vector<double>& bestPoint() const { return vertices[0]; }
+    double bestValue() const { return values[0]; }
+    int evaluations() const { return evaluation_count; }
+
+private:
+    enum class Phase { INITIAL, REFLECT, EXPAND, CONTRACT, SHRINK, DONE };
+    
+    /// Order the simplex, then either stop or queue the next reflection
+    void startIteration();
+    void replaceWorst(const std::vector<double>& point, double value);
+    void queueShrink();
+    
+    NelderMeadOptions options;
+    std::size_t dimensions;
+    std::vector<std::vector<double>> vertices;   // n + 1 vertices, best first after sorting
+    std::vector<double> values;
+    std::vector<std::vector<double>> points;     // Pending trial points
+    std::vector<double> centroid;                // Of every vertex but the worst
+    std::vector<double> reflected;
+    double reflected_value = 0;
+    bool outside_contraction = false;
+    Phase phase = Phase::INITIAL;
+    bool has_converged = false;
+    int evaluation_count = 0;
+};
+
+/// Run one search to completion, evaluating objective serially
+NelderMead minimizeNelderMead(const std::function<double(const std::vector<double>&)>& objective,
+                              const std::vector<double>& start,
+                              const NelderMeadOptions& options);
+
+// ===========================================================================
+// THRUSTER SELECTION OPTIMIZER
+// ===========================================================================
+// Picks thrust, ISP and initial mass within bounds to minimize one of the
+// findBestMission metrics (shortest_time, lowest_delta_v, least_fuel,
+// most_efficient) subject to an optional propellant budget. Missions that
+// do not reach coast, or burn more than the budget, score a penalty that
+// grows with the violation, so the simplex is pushed back toward feasible
+// designs.
+//
+// Several Nelder-Mead searches (multi-start) run in lockstep; each
+// generation gathers every search's pending points into one population
+// that is propagated on a thread pool through propagateMissionBatch. With
+// a cache directory, each candidate is first looked up in the result
+// cache, so a rerun (or a search revisiting a design) skips propagation.
+//
+// Spec file format (the base sections are the same as a mission file):
+//
+//   mission: {departure_body: Earth, arrival_body: Mars}
+//   integration: {method: rk4, timestep_s: 10000}
+//   optimize:
+//     objective: shortest_time
+//     propellant_budget_kg: 2500              # optional, 0 = no budget
+//     thrust_mN: {min: 100, max: 1000}        # free parameter
+//     isp_s: {min: 1500, max: 9000}
+//     initial_mass_kg: 10000                  # single value = fixed
+//     starts: 8
+//     max_evaluations: 150                    # per start
+//     tolerance: 1e-3                         # simplex size, box units
+//     seed: 1
+//   output: {filename: optimization_results.csv}
+//
+// A parameter that is left out keeps the base config's value.
+// ===========================================================================
+
+/// Bounds of one design parameter
+/// Free when max > min; a fixed parameter keeps the base config's value.
+struct ParameterRange {
+    double min = 0;
+    double max = 0;
+    
+    bool isFree() const { return max > min; }
+};
+
+struct OptimizationSpec {
+    MissionConfig base;                  // Settings shared by every candidate
+    std::string objective = "shortest_time";
+    double propellant_budget_kg = 0;     // 0 = no budget
+    ParameterRange thrust_mN;
+    ParameterRange isp_s;
+    ParameterRange initial_mass_kg;
+    int starts = 8;                      // Independent searches
+    int max_evaluations = 150;           // Per search
+    double tolerance = 1e-3;
+    std::uint64_t seed = 1;              // Start points after the first
+    std::string output_filename = "optimization_results.csv";
+    
+    /// Number of free parameters
+    std::size_t dimensions() const;
+    
+    /// Candidate config at box coordinates x (one per free parameter,
+    /// in the order thrust, ISP, mass)
+    MissionConfig configAt(const std::vector<double>& x) const;
+};
+
+/// One evaluated design
+struct OptimizationPoint {
+    double thrust_mN = 0;
+    double isp_s = 0;
+    double initial_mass_kg = 0;
+    bool coasted = false;                // Reached coast before fuel/time ran out
+    bool feasible = false;               // Coasted within the propellant budget
+    double objective = 0;                // Metric score, or penalty when infeasible
+    MissionResult mission;               // Outcomes and derived metrics
+};
+
+/// Outcome of one search
+struct OptimizationStart {
+    OptimizationPoint initial;           // Where the search started
+    OptimizationPoint best;              // Best design it found
+    int evaluations = 0;
+    bool converged = false;
+};
+
+struct OptimizationResult {
+    std::vector<OptimizationStart> starts;
+    std::size_t best_start = 0;          // Index into starts
+    bool feasible = false;               // Some search found a feasible design
+    int generations = 0;                 // Lockstep population evaluations
+    long evaluations = 0;                // Candidates evaluated (incl. cache hits)
+    long cache_hits = 0;
+};
+
+/// Load an optimization spec
+/// @return false (with a message on std::cerr) if the file cannot be read,
+///         the objective is unknown or a range is malformed
+bool loadOptimizationFromYAML(const std::string& filename, OptimizationSpec& spec);
+
+/// Objective value of a finished propagation (lower is better)
+OptimizationPoint evaluateCandidate(const OptimizationSpec& spec, const MissionConfig& config,
+                                    const PropagationResult& propagation);
+
+/// Run the multi-start search
+/// jobs as for --jobs (0 = one per hardware thread); cache_directory ""
+/// disables the result cache. Results do not depend on jobs.
+OptimizationResult runOptimization(const OptimizationSpec& spec, unsigned jobs = 0,
+                                   const std::string& cache_directory = "");
+
+/// Write one row per search (start point, best design, convergence)
+/// @return false if the file cannot be opened
+bool writeOptimizationCSV(const std::string& filename, const OptimizationResult& result);
+
+#endif // OPTIMIZER_H
@@ -1,4 +1,5 @@
 #include <cmath>
+#include <algorithm>
 #include "orbital_elements.h"
 
 // ===========================================================================
@@ -238,3 +239,314 @@ OrbitalElements computeOrbitalElements(const double r[3], const double v[3],
     
     return elements;
 }
+
+// ===========================================================================
+// COMPUTE APSIDES FROM STATE VECTORS
+// ===========================================================================
+
+Apsides computeApsides(const double r[3], const double v[3], double mu) {
+    Apsides apsides;
+    
+    // Angular momentum magnitude |r × v|
+    double h_x = r[1]*v[2] - r[2]*v[1];
+    double h_y = r[2]*v[0] - r[0]*v[2];
+    double h_z = r[0]*v[1] - r[1]*v[0];
+    double h_mag = std::sqrt(h_x*h_x + h_y*h_y + h_z*h_z);
+    apsides.h = h_mag;
+    
+    // Specific orbital energy E = v²/2 - μ/r
+    double r_mag = std::sqrt(r[0]*r[0] + r[1]*r[1] + r[2]*r[2]);
+    double v_mag_sq = v[0]*v[0] + v[1]*v[1] + v[2]*v[2];
+    apsides.E = v_mag_sq / 2.0 - mu / r_mag;
+    
+    // Semi-major axis a = -μ / (2*E)
+    if (std::abs(apsides.E) > 1e-15) {
+        apsides.a = -mu / (2.0 * apsides.E);
+    } else {
+        apsides.a = 1e10;  // Parabolic
+    }
+    
+    // Eccentricity from h and a
+    if (apsides.a > 0) {
+        double e_sq = 1.0 - (h_mag * h_mag) / (mu * apsides.a);
+        if (e_sq < 0) e_sq = 0;  // Numerical safety
+        apsides.e = std::sqrt(e_sq);
+    } else {
+        apsides.e = 2.0;  // Hyperbolic
+    }
+    
+    apsides.r_p = apsides.a * (1.0 - apsides.e);
+    apsides.r_a = apsides.a * (1.0 + apsides.e);
+    
+    return apsides;
+}
+
+// ===========================================================================
+// UNIVERSAL-VARIABLE KEPLER PROPAGATION
+// ===========================================================================
+
+namespace {
+
+/// Stumpff functions C(z) and S(z), with series near z = 0
+void stumpff(double z, double& C, double& S) {
+    if (z > 1e-6) {
+        double sz = std::sqrt(z);
+        C = (1.0 - std::cos(sz)) / z;
+        S = (sz - std::sin(sz)) / (sz * z);
+    } else if (z < -1e-6) {
+        double sz = std::sqrt(-z);
+        C = (std::cosh(sz) - 1.0) / (-z);
+        S = (std::sinh(sz) - sz) / (sz * (-z));
+    } else {
+        C = 0.5 - z / 24.0 + z * z / 720.0;
+        S = 1.0 / 6.0 - z / 120.0 + z * z / 5040.0;
+    }
+}
+
+}  // namespace
+
+bool propagateKepler(const double r0[3], const double v0[3], double dt, double mu,
+                     double r[3], double v[3]) {
+    const double pi = 3.14159265358979323846;
+    double sqrt_mu = std::sqrt(mu);
+    double r0_mag = std::sqrt(r0[0]*r0[0] + r0[1]*r0[1] + r0[2]*r0[2]);
+    double v0_sq = v0[0]*v0[0] + v0[1]*v0[1] + v0[2]*v0[2];
+    double r0_dot_v0 = r0[0]*v0[0] + r0[1]*v0[1] + r0[2]*v0[2];
+    double alpha = 2.0 / r0_mag - v0_sq / mu;  // 1/a
+    
+    // Whole revolutions of an ellipse change nothing
+    if (alpha > 1e-15) {
+        double period = 2.0 * pi / (sqrt_mu * alpha * std::sqrt(alpha));
+        dt = std::fmod(dt, period);
+    }
+    if (dt == 0) {
+        for (int i = 0; i < 3; i++) {
+            r[i] = r0[i];
+            v[i] = v0[i];
+        }
+        return true;
+    }
+    
+    // Initial guess for χ (Vallado, Algorithm 8)
+    double chi;
+    if (alpha > 1e-15) {
+        chi = sqrt_mu * dt * alpha;
+    } else if (alpha < -1e-15) {
+        double a = 1.0 / alpha;
+        double sign = (dt > 0) ? 1.0 : -1.0;
+        chi = sign * std::sqrt(-a) *
+              std::log((-2.0 * mu * alpha * dt) /
+                       (r0_dot_v0 + sign * std::sqrt(-mu * a) * (1.0 - r0_mag * alpha)));
+    } else {
+        chi = sqrt_mu * dt / r0_mag;
+    }
+    
+    // Newton-Raphson on the universal Kepler equation; F'(χ) = r(χ)
+    double C = 0, S = 0, z = 0, r_mag = r0_mag;
+    bool converged = false;
+    for (int iter = 0; iter < 50; iter++) {
+        z = alpha * chi * chi;
+        stumpff(z, C, S);
+        double chi_sq = chi * chi;
+        double F = r0_dot_v0 / sqrt_mu * chi_sq * C +
+                   (1.0 - alpha * r0_mag) * chi_sq * chi * S +
+                   r0_mag * chi - sqrt_mu * dt;
+        r_mag = r0_dot_v0 / sqrt_mu * chi * (1.0 - z * S) +
+                (1.0 - alpha * r0_mag) * chi_sq * C + r0_mag;
+        double delta = F / r_mag;
+        chi -= delta;
+        if (std::abs(delta) <= 1e-12 * std::max(1.0, std::abs(chi))) {
+            converged = true;
+            break;
+        }
+    }
+    if (!converged || !std::isfinite(chi)) {
+        return false;
+    }
+    
+    // Lagrange coefficients at the converged χ
+    z = alpha * chi * chi;
+    stumpff(z, C, S);
+    double chi_sq = chi * chi;
+    double f = 1.0 - chi_sq / r0_mag * C;
+    double g = dt - chi_sq * chi / sqrt_mu * S;
+    
+    double r_new[3];
+    for (int i = 0; i < 3; i++) {
+        r_new[i] = f * r0[i] + g * v0[i];
+    }
+    r_mag = std::sqrt(r_new[0]*r_new[0] + r_new[1]*r_new[1] + r_new[2]*r_new[2]);
+    
+    double f_dot = sqrt_mu / (r_mag * r0_mag) * chi * (z * S - 1.0);
+    double g_dot = 1.0 - chi_sq / r_mag * C;
+    
+    double v_new[3];
+    for (int i = 0; i < 3; i++) {
+        v_new[i] = f_dot * r0[i] + g_dot * v0[i];
+    }
+    for (int i = 0; i < 3; i++) {
+        r[i] = r_new[i];
+        v[i] = v_new[i];
+    }
+    return true;
+}
+
+// ===========================================================================
+// TIME OF FLIGHT TO A RADIUS
+// ===========================================================================
+
+double timeToRadius(const double r[3], const double v[3], double mu, double radius) {
+    const double pi = 3.14159265358979323846;
+    
+    double h_x = r[1]*v[2] - r[2]*v[1];
+    double h_y = r[2]*v[0] - r[0]*v[2];
+    double h_z = r[0]*v[1] - r[1]*v[0];
+    double h_mag = std::sqrt(h_x*h_x + h_y*h_y + h_z*h_z);
+    double r_mag = std::sqrt(r[0]*r[0] + r[1]*r[1] + r[2]*r[2]);
+    double v_mag_sq = v[0]*v[0] + v[1]*v[1] + v[2]*v[2];
+    double r_dot_v = r[0]*v[0] + r[1]*v[1] + r[2]*v[2];
+    
+    // Conic: r = p / (1 + e cos ν)
+    double energy = v_mag_sq / 2.0 - mu / r_mag;
+    double p = h_mag * h_mag / mu;
+    double e_sq = 1.0 + 2.0 * energy * h_mag * h_mag / (mu * mu);
+    double e = std::sqrt(std::max(e_sq, 0.0));
+    if (e < 1e-10) {
+        return -1;  // Circular: radius never changes
+    }
+    
+    // Target true anomaly; clamp rounding at the apsides
+    double cos_target = (p / radius - 1.0) / e;
+    if (std::abs(cos_target) > 1.0 + 1e-12) {
+        return -1;
+    }
+    cos_target = std::max(-1.0, std::min(1.0, cos_target));
+    double nu_target = std::acos(cos_target);
+    
+    // Current true anomaly from e cos ν = p/r - 1, e sin ν = h (r·v) / (μ r)
+    double nu_now = std::atan2(h_mag * r_dot_v / (mu * r_mag), p / r_mag - 1.0);
+    
+    // Time since periapsis at true anomaly ν
+    auto time_since_periapsis = [&](double nu) {
+        if (std::abs(e - 1.0) < 1e-9) {
+            // Parabola (Barker's equation)
+            double D = std::tan(nu / 2.0);
+            return 0.5 * std::sqrt(p * p * p / mu) * (D + D * D * D / 3.0);
+        }
+        double a = p / (1.0 - e * e);
+        if (e < 1.0) {
+            double E = 2.0 * std::atan2(std::sqrt(1.0 - e) * std::sin(nu / 2.0),
+                                        std::sqrt(1.0 + e) * std::cos(nu / 2.0));
+            return (E - e * std::sin(E)) / std::sqrt(mu / (a * a * a));
+        }
+        double F = 2.0 * std::atanh(std::sqrt((e - 1.0) / (e + 1.0)) * std::tan(nu / 2.0));
+        return (e * std::sinh(F) - F) / std::sqrt(mu / (-a * a * a));
+    };
+    
+    double t_now = time_since_periapsis(nu_now);
+    double best = -1;
+    for (double nu : {nu_target, -nu_target}) {
+        double dt = time_since_periapsis(nu) - t_now;
+        if (e < 1.0) {
+            // Ellipse: the crossing recurs every period
+            double a = p / (1.0 - e * e);
+            double period = 2.0 * pi * std::sqrt(a * a * a / mu);
+            dt = std::fmod(dt, period);
+            if (dt < 0) {
+                dt += period;
+            }
+        }
+        if (dt >= 0 && (best < 0 || dt < best)) {
+            best = dt;
+        }
+    }
+    return best;
+}
+
+// ===========================================================================
+// MODIFIED EQUINOCTIAL ELEMENTS
+// ===========================================================================
+
+namespace {
+
+/// Equinoctial frame: in-plane unit vectors at true longitude 0 and 90°
+void equinoctialFrame(double h, double k, double f_hat[3], double g_hat[3]) {
+    double s2 = 1.0 + h * h + k * k;
+    f_hat[0] = (1.0 - k * k + h * h) / s2;
+    f_hat[1] = 2.0 * h * k / s2;
+    f_hat[2] = -2.0 * k / s2;
+    g_hat[0] = 2.0 * h * k / s2;
+    g_hat[1] = (1.0 + k * k - h * h) / s2;
+    g_hat[2] = 2.0 * h / s2;
+}
+
+}  // namespace
+
+EquinoctialElements computeEquinoctialElements(const double r[3], const double v[3], double mu) {
+    EquinoctialElements elements;
+    double h_vec[3] = {
+        r[1] * v[2] - r[2] * v[1],
+        r[2] * v[0] - r[0] * v[2],
+        r[0] * v[1] - r[1] * v[0]
+    };
+    double h_mag = std::sqrt(h_vec[0]*h_vec[0] + h_vec[1]*h_vec[1] + h_vec[2]*h_vec[2]);
+    double r_mag = std::sqrt(r[0]*r[0] + r[1]*r[1] + r[2]*r[2]);
+    if (h_mag < 1e-10 || r_mag < 1e-10) {
+        return elements;
+    }
+    
+    elements.p = h_mag * h_mag / mu;
+    double denominator = h_mag + h_vec[2];
+    elements.h = -h_vec[1] / denominator;
+    elements.k = h_vec[0] / denominator;
+    
+    // Eccentricity vector e = (v × h)/μ - r/|r| in the equinoctial frame
+    double e_vec[3] = {
+        (v[1] * h_vec[2] - v[2] * h_vec[1]) / mu - r[0] / r_mag,
+        (v[2] * h_vec[0] - v[0] * h_vec[2]) / mu - r[1] / r_mag,
+        (v[0] * h_vec[1] - v[1] * h_vec[0]) / mu - r[2] / r_mag
+    };
+    double f_hat[3];
+    double g_hat[3];
+    equinoctialFrame(elements.h, elements.k, f_hat, g_hat);
+    elements.f = e_vec[0] * f_hat[0] + e_vec[1] * f_hat[1] + e_vec[2] * f_hat[2];
+    elements.g = e_vec[0] * g_hat[0] + e_vec[1] * g_hat[1] + e_vec[2] * g_hat[2];
+    elements.L = std::atan2(r[0] * g_hat[0] + r[1] * g_hat[1] + r[2] * g_hat[2],
+                            r[0] * f_hat[0] + r[1] * f_hat[1] + r[2] * f_hat[2]);
+    return elements;
+}
+
+void equinoctialToState(const EquinoctialElements& elements, double mu,
+                        double r[3], double v[3]) {
+    double f_hat[3];
+    double g_hat[3];
+    equinoctialFrame(elements.h, elements.k, f_hat, g_hat);
+    
+    double cos_L = std::cos(elements.L);
+    double sin_L = std::sin(elements.L);
+    double w = 1.0 + elements.f * cos_L + elements.g * sin_L;
+    double radius = elements.p / w;
+    double speed_scale = std::sqrt(mu / elements.p);
+    double v_f = -speed_scale * (sin_L + elements.g);
+    double v_g = speed_scale * (cos_L + elements.f);
+    for (int i = 0; i < 3; i++) {
+        r[i] = radius * (cos_L * f_hat[i] + sin_L * g_hat[i]);
+        v[i] = v_f * f_hat[i] + v_g * g_hat[i];
+    }
+}
+
+double trueToMeanLongitude(double L, double f, double g) {
+    double e = std::sqrt(f * f + g * g);
+    double periapsis = (e > 1e-12) ? std::atan2(g, f) : 0.0;
+    double nu = L - periapsis;
+    double E = std::atan2(std::sqrt(1.0 - e * e) * std::sin(nu), e + std::cos(nu));
+    return E - e * std::sin(E) + periapsis;
+}
+
+double meanToTrueLongitude(double lambda, double f, double g) {
+    double e = std::sqrt(f * f + g * g);
+    double periapsis = (e > 1e-12) ? std::atan2(g, f) : 0.0;
+    double E = solveKeplersEquation(lambda - periapsis, e);
+    double nu = std::atan2(std::sqrt(1.0 - e * e) * std::sin(E), std::cos(E) - e);
+    return nu + periapsis;
+}
@@ -37,6 +37,24 @@ struct OrbitalElements {
                        r_p(0), r_a(0), h(0), E(0) {}
 };
 
+// ===========================================================================
+// APSIDES (LIGHTWEIGHT SUBSET OF THE ELEMENTS)
+// ===========================================================================
+// Coast checks only need the apoapsis/periapsis radii, which follow from
+// energy and angular momentum alone. Skipping i, Omega, omega and nu saves
+// the acos/atan2/sin/cos calls of the full element computation.
+
+struct Apsides {
+    double a;      // Semi-major axis (km)
+    double e;      // Eccentricity (2.0 flags a hyperbolic orbit)
+    double r_p;    // Periapsis radius (km) = a(1-e)
+    double r_a;    // Apoapsis radius (km) = a(1+e)
+    double h;      // Specific orbital angular momentum (km²/s)
+    double E;      // Specific orbital energy (km²/s²)
+    
+    Apsides() : a(0), e(0), r_p(0), r_a(0), h(0), E(0) {}
+};
+
 // ===========================================================================
 // KEPLER EQUATION SOLVER
 // ===========================================================================
@@ -99,4 +117,91 @@ double eccentricToTrueAnomaly(double E, double e);
 OrbitalElements computeOrbitalElements(const double r[3], const double v[3], 
                                        double mu);
 
+/// Compute only a, e, r_p, r_a, h and E from state vectors
+///
+/// Uses the same formulas (and the same floating-point operations) as
+/// computeOrbitalElements, so the results are identical to the matching
+/// fields of the full element set.
+///
+/// @param r: position vector (km) [rx, ry, rz]
+/// @param v: velocity vector (km/s) [vx, vy, vz]
+/// @param mu: gravitational parameter (km³/s²)
+/// @return Apsides structure with the energy-derived elements
+Apsides computeApsides(const double r[3], const double v[3], double mu);
+
+// ===========================================================================
+// ANALYTIC TWO-BODY PROPAGATION
+// ===========================================================================
+// With the engine off the dynamics are pure two-body, so a coast arc has a
+// closed-form solution. The universal-variable formulation covers elliptic,
+// parabolic and hyperbolic arcs with one equation:
+//
+//   √μ Δt = (r0·v0)/√μ χ² C(z) + (1 - α r0) χ³ S(z) + r0 χ,   z = α χ²
+//
+// where α = 2/r0 - v0²/μ = 1/a and C, S are the Stumpff functions. Once χ
+// is known, the Lagrange coefficients f, g, ḟ, ġ map (r0, v0) to (r, v).
+
+/// Propagate a two-body state over dt in closed form
+///
+/// Solves the universal Kepler equation for χ by Newton-Raphson (elliptic
+/// arcs are first reduced modulo the orbital period). Cost is independent
+/// of dt. Negative dt propagates backwards.
+///
+/// @param r0, v0: initial position (km) and velocity (km/s)
+/// @param dt: time of flight (s)
+/// @param mu: gravitational parameter (km³/s²)
+/// @param r, v: output position and velocity (may alias r0, v0)
+/// @return false if the iteration did not converge (r, v untouched)
+bool propagateKepler(const double r0[3], const double v0[3], double dt, double mu,
+                     double r[3], double v[3]);
+
+/// Time until a two-body orbit next passes through a given radius
+///
+/// Converts the current and target true anomalies to mean anomalies
+/// (elliptic or hyperbolic) and takes the first crossing ahead in time,
+/// in either radial direction.
+///
+/// @param r, v: current position (km) and velocity (km/s)
+/// @param mu: gravitational parameter (km³/s²)
+/// @param radius: target radius (km)
+/// @return time of flight (s), or -1 if the orbit never reaches radius
+double timeToRadius(const double r[3], const double v[3], double mu, double radius);
+
+// ===========================================================================
+// MODIFIED EQUINOCTIAL ELEMENTS
+// ===========================================================================
+// Walker, Ireland and Owens (1985). Non-singular for circular and
+// equatorial orbits, which the classical ω and Ω are not:
+//
+//   p = a(1 - e²)          f = e cos(ω + Ω)      g = e sin(ω + Ω)
+//   h = tan(i/2) cos Ω     k = tan(i/2) sin Ω    L = Ω + ω + ν
+//
+// Under a small perturbing acceleration p, f, g, h and k drift slowly
+// while the true longitude L carries the orbital motion, which is what an
+// orbit-averaged propagator needs. Only i = 180° is singular.
+
+struct EquinoctialElements {
+    double p = 0;  // Semi-latus rectum (km)
+    double f = 0;
+    double g = 0;
+    double h = 0;
+    double k = 0;
+    double L = 0;  // True longitude (radians)
+    
+    double eccentricity() const { return std::sqrt(f * f + g * g); }
+};
+
+/// Equinoctial elements of a state
+EquinoctialElements computeEquinoctialElements(const double r[3], const double v[3], double mu);
+
+/// State of equinoctial elements (the inverse of computeEquinoctialElements)
+void equinoctialToState(const EquinoctialElements& elements, double mu,
+                        double r[3], double v[3]);
+
+/// Mean longitude λ = M + ω + Ω of an elliptic orbit's true longitude
+double trueToMeanLongitude(double L, double f, double g);
+
+/// True longitude of a mean longitude (solves Kepler's equation)
+double meanToTrueLongitude(double lambda, double f, double g);
+
 #endif // ORBITAL_ELEMENTS_H
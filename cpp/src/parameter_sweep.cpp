@@ -0,0 +1,310 @@
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <algorithm>
+#include <yaml-cpp/yaml.h>
+#include "parameter_sweep.h"
+#include "batch_propagator.h"
+#include "orbital_elements.h"
+#include "thread_pool.h"
+#include "csv_writer.h"
+
+// Defined in mission_batch.cpp
+MissionConfig loadConfigFromYAML(const std::string& filename);
+
+namespace {
+
+/// Consecutive grid points propagated by one pool task
+constexpr std::size_t SWEEP_CHUNK_SIZE = 256;
+
+/// Axis length, with an empty axis standing for the base value
+std::size_t axisLength(std::size_t size) {
+    return size == 0 ? 1 : size;
+}
+
+/// Parse one numeric axis: a list, a single value, or a range map
+/// {start, stop, count} (inclusive linspace) / {start, stop, step}
+bool parseAxis(const YAML::Node& node, const std::string& name, std::vector<double>& values) {
+    values.clear();
+    if (node.IsSequence()) {
+        for (const YAML::Node& value : node) {
+            values.push_back(value.as<double>());
+        }
+    } else if (node.IsMap()) {
+        if (!node["start"] || !node["stop"] || (!node["count"] && !node["step"])) {
+            std::cerr << "Error: sweep axis '" << name
+                      << "' needs start, stop and either count or step\n";
+            return false;
+        }
+        double start = node["start"].as<double>();
+        double stop = node["stop"].as<double>();
+        if (node["count"]) {
+            int count = node["count"].as<int>();
+            if (count < 1) {
+                std::cerr << "Error: sweep axis '" << name << "' has count < 1\n";
+                return false;
+            }
+            for (int k = 0; k < count; k++) {
+                values.push_back(count == 1 ? start
+                                            : start + (stop - start) * k / (count - 1));
+            }
+        } else {
+            double step = node["step"].as<double>();
+            if (step == 0 || (stop - start) * step < 0) {
+                std::cerr << "Error: sweep axis '" << name
+                          << "' step does not lead from start to stop\n";
+                return false;
+            }
+            long count = static_cast<long>(std::floor((stop - start) / step + 1e-9)) + 1;
+            for (long k = 0; k < count; k++) {
+                values.push_back(start + k * step);
+            }
+        }
+    } else {
+        values.push_back(node.as<double>());
+    }
+    
+    if (values.empty()) {
+        std::cerr << "Error: sweep axis '" << name << "' is empty\n";
+        return false;
+    }
+    return true;
+}
+
+SweepPointResult makePointResult(const MissionConfig& config, const PropagationResult& prop) {
+    SweepPointResult point;
+    point.thrust_mN = config.spacecraft.thrust_mN;
+    point.isp_s = config.spacecraft.isp_s;
+    point.initial_mass_kg = config.spacecraft.initial_mass_kg;
+    point.timestep_s = config.timestep_s;
+    point.destination = config.arrival_body;
+    
+    point.coasted = prop.coast_step >= 0;
+    point.pruned = prop.pruned;
+    point.flight_time_days = prop.final_state.t / 86400.0;
+    point.total_delta_v_km_s = prop.total_delta_v;
+    point.final_mass_kg = prop.final_state.m;
+    
+    Apsides apsides = computeApsides(prop.final_state.r, prop.final_state.v, MU_SUN);
+    point.final_apoapsis_km = apsides.r_a;
+    point.final_periapsis_km = apsides.r_p;
+    return point;
+}
+
+}  // namespace
+
+// ===========================================================================
+// GRID EXPANSION
+// ===========================================================================
+
+std::size_t ParameterSweep::size() const {
+    return axisLength(thrust_mN.size()) * axisLength(isp_s.size()) *
+           axisLength(initial_mass_kg.size()) * axisLength(timestep_s.size()) *
+           axisLength(destinations.size());
+}
+
+MissionConfig ParameterSweep::configAt(std::size_t index) const {
+    MissionConfig config = base;
+    
+    // Mixed-radix digits, thrust fastest
+    std::size_t n = thrust_mN.size();
+    if (n > 0) {
+        config.spacecraft.thrust_mN = thrust_mN[index % n];
+    }
+    index /= axisLength(n);
+    
+    n = isp_s.size();
+    if (n > 0) {
+        config.spacecraft.isp_s = isp_s[index % n];
+    }
+    index /= axisLength(n);
+    
+    n = initial_mass_kg.size();
+    if (n > 0) {
+        config.spacecraft.initial_mass_kg = initial_mass_kg[index % n];
+    }
+    index /= axisLength(n);
+    
+    n = timestep_s.size();
+    if (n > 0) {
+        config.timestep_s = timestep_s[index % n];
+    }
+    index /= axisLength(n);
+    
+    n = destinations.size();
+    if (n > 0) {
+        config.arrival_body = destinations[index % n];
+    }
+    return config;
+}
+
+// ===========================================================================
+// SWEEP FILE LOADER
+// ===========================================================================
+
+bool loadSweepFromYAML(const std::string& filename, ParameterSweep& sweep) {
+    try {
+        YAML::Node yaml = YAML::LoadFile(filename);
+        if (!yaml["sweep"]) {
+            std::cerr << "Error: no 'sweep' section in " << filename << "\n";
+            return false;
+        }
+        
+        // Base settings use the mission file sections and loader
+        sweep.base = loadConfigFromYAML(filename);
+        
+        YAML::Node axes = yaml["sweep"];
+        if (axes["thrust_mN"] && !parseAxis(axes["thrust_mN"], "thrust_mN", sweep.thrust_mN)) {
+            return false;
+        }
+        if (axes["isp_s"] && !parseAxis(axes["isp_s"], "isp_s", sweep.isp_s)) {
+            return false;
+        }
+        if (axes["initial_mass_kg"] &&
+            !parseAxis(axes["initial_mass_kg"], "initial_mass_kg", sweep.initial_mass_kg)) {
+            return false;
+        }
+        if (axes["timestep_s"] && !parseAxis(axes["timestep_s"], "timestep_s", sweep.timestep_s)) {
+            return false;
+        }
+        if (axes["destination"]) {
+            sweep.destinations.clear();
+            YAML::Node destinations = axes["destination"];
+            if (destinations.IsSequence()) {
+                for (const YAML::Node& body : destinations) {
+                    sweep.destinations.push_back(parseBodyName(body.as<std::string>()));
+                }
+            } else {
+                sweep.destinations.push_back(parseBodyName(destinations.as<std::string>()));
+            }
+        }
+        
+        if (yaml["output"] && yaml["output"]["filename"]) {
+            sweep.output_filename = yaml["output"]["filename"].as<std::string>();
+        }
+    } catch (const YAML::Exception& e) {
+        std::cerr << "Error loading sweep file: " << e.what() << std::endl;
+        return false;
+    }
+    
+    return true;
+}
+
+// ===========================================================================
+// SWEEP EXECUTION
+// ===========================================================================
+
+std::vector<SweepPointResult> runParameterSweep(const ParameterSweep& sweep, unsigned jobs,
+                                                PruningBound* pruning, MissionSummary* summary) {
+    std::size_t total = sweep.size();
+    std::vector<SweepPointResult> results(total);
+    double r_departure = getOrbitalRadius(sweep.base.departure_body);
+    
+    // Destination groups, interned once
+    std::vector<std::uint32_t> target_ids(BODY_COUNT, MissionSummary::NO_GROUP);
+    if (summary) {
+        std::vector<CelestialBody> destinations = sweep.destinations;
+        if (destinations.empty()) {
+            destinations.push_back(sweep.base.arrival_body);
+        }
+        for (CelestialBody body : destinations) {
+            target_ids[static_cast<std::size_t>(body)] = summary->targetId(getBodyName(body));
+        }
+    }
+    
+    // Each task expands its own index range, so configs only exist for the
+    // points being propagated
+    auto run_chunk = [&](std::size_t chunk) {
+        std::size_t begin = chunk * SWEEP_CHUNK_SIZE;
+        std::size_t end = std::min(total, begin + SWEEP_CHUNK_SIZE);
+        std::vector<MissionConfig> group;
+        
+        std::size_t i = begin;
+        while (i < end) {
+            // Consecutive points with the same destination and timestep
+            // share the two orbits and one batch timestep
+            group.clear();
+            group.push_back(sweep.configAt(i));
+            group[0].pruning = pruning;
+            std::size_t j = i + 1;
+            for (; j < end; j++) {
+                MissionConfig next = sweep.configAt(j);
+                next.pruning = pruning;
+                if (next.arrival_body != group[0].arrival_body ||
+                    next.timestep_s != group[0].timestep_s) {
+                    break;
+                }
+                group.push_back(next);
+            }
+            
+            std::vector<PropagationResult> props =
+                propagateMissionBatch(group, r_departure, getOrbitalRadius(group[0].arrival_body));
+            for (std::size_t k = 0; k < group.size(); k++) {
+                results[i + k] = makePointResult(group[k], props[k]);
+                const SweepPointResult& point = results[i + k];
+                if (summary) {
+                    summary->add(i + k, MissionSummary::NO_GROUP,
+                                 target_ids[static_cast<std::size_t>(point.destination)],
+                                 point.flight_time_days, point.total_delta_v_km_s,
+                                 point.initial_mass_kg - point.final_mass_kg, point.coasted);
+                }
+            }
+            i = j;
+        }
+    };
+    
+    std::size_t chunks = (total + SWEEP_CHUNK_SIZE - 1) / SWEEP_CHUNK_SIZE;
+    unsigned num_threads = ThreadPool::resolveThreadCount(jobs);
+    if (num_threads > chunks) {
+        num_threads = static_cast<unsigned>(std::max<std::size_t>(chunks, 1));
+    }
+    
+    if (num_threads == 1) {
+        for (std::size_t chunk = 0; chunk < chunks; chunk++) {
+            run_chunk(chunk);
+        }
+    } else {
+        ThreadPool pool(num_threads);
+        pool.parallelFor(chunks, run_chunk);
+    }
+    
+    return results;
+}
+
+// ===========================================================================
+// SWEEP TABLE OUTPUT
+// ===========================================================================
+
+bool writeSweepCSV(const std::string& filename, const std::vector<SweepPointResult>& results,
+                   bool pruned_column) {
+    CsvWriter file;
+    if (!file.open(filename)) {
+        return false;
+    }
+    
+    file.write("Index,Thrust(mN),ISP(s),InitialMass(kg),Timestep(s),To,Coasted,"
+               "FlightTime(days),DeltaV(km/s),FinalMass(kg),Apoapsis(km),Periapsis(km)");
+    file.write(pruned_column ? ",Pruned\n" : "\n");
+    
+    for (std::size_t i = 0; i < results.size(); i++) {
+        const SweepPointResult& point = results[i];
+        file.integer(static_cast<long long>(i));
+        file.general(point.thrust_mN, 10);
+        file.general(point.isp_s, 10);
+        file.general(point.initial_mass_kg, 10);
+        file.general(point.timestep_s, 10);
+        file.text(getBodyName(point.destination));
+        file.integer(point.coasted ? 1 : 0);
+        file.fixed(point.flight_time_days, 3);
+        file.fixed(point.total_delta_v_km_s, 3);
+        file.fixed(point.final_mass_kg, 3);
+        file.scientific(point.final_apoapsis_km, 6);
+        file.scientific(point.final_periapsis_km, 6);
+        if (pruned_column) {
+            file.integer(point.pruned ? 1 : 0);
+        }
+        file.endRow();
+    }
+    
+    return file.close();
+}
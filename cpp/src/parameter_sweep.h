@@ -0,0 +1,100 @@
+#ifndef PARAMETER_SWEEP_H
+#define PARAMETER_SWEEP_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "constants.h"
+#include "propagator.h"
+#include "mission_summary.h"
+
+// ===========================================================================
+// PARAMETER SWEEP
+// ===========================================================================
+// A trade study over the full grid of thrust, ISP, initial mass, timestep
+// and destination values. The grid is never materialized as config files
+// or as a vector of configs: point i is decoded from its index on demand
+// (mixed radix, thrust varying fastest and destination slowest), so a
+// 10^5-point sweep is one YAML parse plus the propagations.
+//
+// Sweep file format (the base sections are the same as a mission file):
+//
+//   mission: {departure_body: Earth, initial_mass_kg: 10000}
+//   integration: {method: rk4, timestep_s: 10000, max_flight_time_s: 1.577e9}
+//   sweep:
+//     thrust_mN: {start: 60, stop: 1000, count: 25}    # inclusive linspace
+//     isp_s: [1500, 2750, 4000, 9000]                   # explicit list
+//     initial_mass_kg: {start: 5000, stop: 20000, step: 5000}
+//     destination: [Venus, Mars, Jupiter]
+//     timestep_s: 10000                                 # single value
+//   output: {filename: sweep_results.csv}
+//
+// An axis that is left out keeps the base config's value.
+// ===========================================================================
+
+struct ParameterSweep {
+    MissionConfig base;                         // Settings shared by every point
+    std::vector<double> thrust_mN;              // Thrust axis (millinewtons)
+    std::vector<double> isp_s;                  // Specific impulse axis (seconds)
+    std::vector<double> initial_mass_kg;        // Initial mass axis (kg)
+    std::vector<double> timestep_s;             // Timestep axis (seconds)
+    std::vector<CelestialBody> destinations;    // Arrival body axis
+    std::string output_filename = "sweep_results.csv";
+    
+    /// Number of grid points (product of the axis lengths)
+    std::size_t size() const;
+    
+    /// Config of grid point index (0 <= index < size())
+    MissionConfig configAt(std::size_t index) const;
+};
+
+/// Outcome of one grid point (one row of the sweep table)
+struct SweepPointResult {
+    double thrust_mN;
+    double isp_s;
+    double initial_mass_kg;
+    double timestep_s;
+    CelestialBody destination;
+    
+    bool coasted;                     // Coast reached before fuel/time ran out
+    double flight_time_days;          // Duration of the thrust phase (days)
+    double total_delta_v_km_s;        // Total velocity change (km/s)
+    double final_mass_kg;             // Remaining mass (kg)
+    double final_apoapsis_km;         // Apoapsis at the end (km)
+    double final_periapsis_km;        // Periapsis at the end (km)
+    bool pruned;                      // Stopped by the pruning bound (partial row)
+    
+    SweepPointResult() : thrust_mN(0), isp_s(0), initial_mass_kg(0), timestep_s(0),
+                         destination(CelestialBody::EARTH), coasted(false),
+                         flight_time_days(0), total_delta_v_km_s(0), final_mass_kg(0),
+                         final_apoapsis_km(0), final_periapsis_km(0), pruned(false) {}
+};
+
+/// Load a sweep spec
+/// @return false (with a message on std::cerr) if the file cannot be read
+///         or an axis is malformed
+bool loadSweepFromYAML(const std::string& filename, ParameterSweep& sweep);
+
+/// Propagate every grid point
+/// Points are processed in chunks of consecutive indices on a thread pool
+/// (jobs as for --jobs, 0 = one per hardware thread). Within a chunk,
+/// points sharing a destination and timestep go through
+/// propagateMissionBatch, so rk4 sweeps use the SoA kernel. No trajectory
+/// is recorded. Results are in index order. With pruning (constructed
+/// coasted_only, see pruning.h), points that can no longer beat the best
+/// coasted point on its metric stop early and are marked pruned. With
+/// summary, each worker streams its points into it as a chunk finishes,
+/// grouped by destination; only coasted points enter the figures.
+std::vector<SweepPointResult> runParameterSweep(const ParameterSweep& sweep,
+                                                unsigned jobs = 0,
+                                                PruningBound* pruning = nullptr,
+                                                MissionSummary* summary = nullptr);
+
+/// Write the consolidated sweep table (one row per grid point)
+/// pruned_column adds a Pruned column (for pruned sweeps).
+/// @return false if the file cannot be opened
+bool writeSweepCSV(const std::string& filename,
+                   const std::vector<SweepPointResult>& results,
+                   bool pruned_column = false);
+
+#endif // PARAMETER_SWEEP_H
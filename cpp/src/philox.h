@@ -0,0 +1,76 @@
+#ifndef PHILOX_H
+#define PHILOX_H
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+// ===========================================================================
+// PHILOX4x32-10 COUNTER-BASED RANDOM NUMBERS
+// ===========================================================================
+// Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3" (SC'11).
+// Output is a pure function of (key, counter): ten rounds of multiply,
+// xor and key bump turn a 128-bit counter into 128 random bits. There is
+// no generator state to advance, so stream k can jump straight to draw n
+// and every value is the same no matter which thread computes it or in
+// which order. Matches the Random123 known-answer vectors.
+// ===========================================================================
+
+class Philox4x32 {
+public:
+    using Block = std::array<std::uint32_t, 4>;
+    
+    /// Generator for a 64-bit seed (the key)
+    explicit Philox4x32(std::uint64_t seed)
+        : key{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)} {}
+    
+    Philox4x32(std::uint32_t key0, std::uint32_t key1) : key{key0, key1} {}
+    
+    /// 128 random bits for a counter
+    Block operator()(Block counter) const {
+        std::uint32_t k0 = key[0];
+        std::uint32_t k1 = key[1];
+        for (int round = 0; round < 10; round++) {
+            std::uint64_t p0 = static_cast<std::uint64_t>(M0) * counter[0];
+            std::uint64_t p1 = static_cast<std::uint64_t>(M1) * counter[2];
+            counter = {static_cast<std::uint32_t>(p1 >> 32) ^ counter[1] ^ k0,
+                       static_cast<std::uint32_t>(p1),
+                       static_cast<std::uint32_t>(p0 >> 32) ^ counter[3] ^ k1,
+                       static_cast<std::uint32_t>(p0)};
+            k0 += W0;
+            k1 += W1;
+        }
+        return counter;
+    }
+    
+    /// Block number draw of stream number stream
+    Block block(std::uint64_t stream, std::uint32_t draw) const {
+        return (*this)({static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32),
+                        draw, 0});
+    }
+
+private:
+    static constexpr std::uint32_t M0 = 0xD2511F53;
+    static constexpr std::uint32_t M1 = 0xCD9E8D57;
+    static constexpr std::uint32_t W0 = 0x9E3779B9;  // Golden ratio
+    static constexpr std::uint32_t W1 = 0xBB67AE85;  // sqrt(3) - 1
+    
+    std::uint32_t key[2];
+};
+
+/// Uniform double in [0, 1) from 64 random bits (53-bit resolution)
+inline double uniformFromBits(std::uint32_t high, std::uint32_t low) {
+    std::uint64_t bits = (static_cast<std::uint64_t>(high) << 32) | low;
+    return static_cast<double>(bits >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/// Two independent standard normals from one block (Box-Muller)
+inline std::array<double, 2> normalPairFromBlock(const Philox4x32::Block& block) {
+    const double two_pi = 2 * 3.14159265358979323846;
+    double u1 = 1.0 - uniformFromBits(block[0], block[1]);  // (0, 1], so log is finite
+    double u2 = uniformFromBits(block[2], block[3]);
+    double radius = std::sqrt(-2.0 * std::log(u1));
+    return {radius * std::cos(two_pi * u2), radius * std::sin(two_pi * u2)};
+}
+
+#endif // PHILOX_H
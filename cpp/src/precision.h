@@ -0,0 +1,320 @@
+#ifndef PRECISION_H
+#define PRECISION_H
+
+#include <cmath>
+#include <string>
+#include "propagator.h"
+
+// ===========================================================================
+// SELECTABLE-PRECISION RK4 (integration.precision)
+// ===========================================================================
+// RK4Propagator works in double and rounds every state update. Over the
+// ~10^5 steps of a Jupiter transfer that round-off accumulates in r, v, m
+// and t, and a timestep study cannot tell it apart from truncation error.
+// PrecisionRK4Propagator runs the same step in another scalar type:
+//
+//   "double"         RK4Propagator itself (default, results unchanged)
+//   "float"          float stages, Kahan-compensated state update
+//   "double_kahan"   double stages, Kahan-compensated state update
+//   "double_double"  ~106-bit arithmetic throughout: the reference that
+//                    measures how much of a run's error is round-off
+//
+// The state update y += (dt/6) (k1 + 2 k2 + 2 k3 + k4) adds a small
+// increment to a large value, so it is where rounding loses the most;
+// compensation keeps the lost low part of every component in a carry and
+// feeds it into the next update. Float stages are fine for the increment
+// (it only needs a few digits); with the carries the trajectory stays
+// close to the double one while the arithmetic runs in float.
+//
+// The working state (and carries) live inside the propagator. Each step
+// writes the rounded state back to the MissionState, and the next step
+// continues from the working state as long as it is handed that same
+// MissionState; any other state starts a new working state from its
+// doubles. A checkpoint stores the rounded state, so a resumed run drops
+// the carries (and double-double's low words) once.
+// ===========================================================================
+
+// ===========================================================================
+// DOUBLE-DOUBLE ARITHMETIC
+// ===========================================================================
+// Unevaluated sum hi + lo with |lo| <= ulp(hi) / 2 (Dekker; Hida, Li and
+// Bailey's QD library). Error-free transforms make +, -, * and / accurate
+// to about 2^-104 relative; std::fma gives the exact product error.
+
+struct DoubleDouble {
+    double hi = 0;
+    double lo = 0;
+    
+    constexpr DoubleDouble() = default;
+    constexpr DoubleDouble(double value) : hi(value), lo(0) {}
+    constexpr DoubleDouble(double hi, double lo) : hi(hi), lo(lo) {}
+    
+    /// Nearest double
+    explicit operator double() const { return hi + lo; }
+};
+
+/// s + err == a + b exactly
+inline DoubleDouble twoSum(double a, double b) {
+    double s = a + b;
+    double b_virtual = s - a;
+    double err = (a - (s - b_virtual)) + (b - b_virtual);
+    return {s, err};
+}
+
+/// twoSum for |a| >= |b|
+inline DoubleDouble quickTwoSum(double a, double b) {
+    double s = a + b;
+    return {s, b - (s - a)};
+}
+
+/// p + err == a * b exactly
+inline DoubleDouble twoProd(double a, double b) {
+    double p = a * b;
+    return {p, std::fma(a, b, -p)};
+}
+
+inline DoubleDouble operator-(const DoubleDouble& a) {
+    return {-a.hi, -a.lo};
+}
+
+inline DoubleDouble operator+(const DoubleDouble& a, const DoubleDouble& b) {
+    DoubleDouble s = twoSum(a.hi, b.hi);
+    DoubleDouble t = twoSum(a.lo, b.lo);
+    s.lo += t.hi;
+    s = quickTwoSum(s.hi, s.lo);
+    s.lo += t.lo;
+    return quickTwoSum(s.hi, s.lo);
+}
+
+inline DoubleDouble operator-(const DoubleDouble& a, const DoubleDouble& b) {
+    return a + (-b);
+}
+
+inline DoubleDouble operator*(const DoubleDouble& a, const DoubleDouble& b) {
+    DoubleDouble p = twoProd(a.hi, b.hi);
+    p.lo += a.hi * b.lo + a.lo * b.hi;
+    return quickTwoSum(p.hi, p.lo);
+}
+
+inline DoubleDouble operator/(const DoubleDouble& a, const DoubleDouble& b) {
+    // Long division: three double quotient digits
+    double q1 = a.hi / b.hi;
+    DoubleDouble r = a - DoubleDouble(q1) * b;
+    double q2 = r.hi / b.hi;
+    r = r - DoubleDouble(q2) * b;
+    double q3 = r.hi / b.hi;
+    return quickTwoSum(q1, q2) + DoubleDouble(q3);
+}
+
+inline bool operator<(const DoubleDouble& a, const DoubleDouble& b) {
+    return a.hi < b.hi || (a.hi == b.hi && a.lo < b.lo);
+}
+
+inline bool operator>(const DoubleDouble& a, const DoubleDouble& b) {
+    return b < a;
+}
+
+/// One Newton step from the double square root
+inline DoubleDouble sqrt(const DoubleDouble& a) {
+    if (!(a.hi > 0)) {
+        return DoubleDouble(std::sqrt(a.hi));
+    }
+    DoubleDouble x(std::sqrt(a.hi));
+    return x + (a - x * x) / (x * DoubleDouble(2.0));
+}
+
+// ===========================================================================
+// PRECISION RK4 PROPAGATOR
+// ===========================================================================
+
+/// RK4Propagator's step in scalar type Real, optionally with a
+/// Kahan-compensated state update
+/// PrecisionRK4Propagator<double, false> matches RK4Propagator bit for bit.
+template <typename Real, bool Compensated>
+class PrecisionRK4Propagator final : public Propagator {
+public:
+    void step(MissionState& state, double dt,
+             double thrust_mN, double isp_s,
+             double mu, double g0, int thrust_direction = 1) override {
+        if (!continues(state)) {
+            load(state);
+        }
+        
+        Real h = Real(dt);
+        Real half_h = h / Real(2);
+        Real thrust = Real(thrust_mN);
+        Real gm = Real(mu);
+        
+        // Stages as in RK4Propagator::step, on the working state
+        Real k1[3];
+        acceleration(r, v, m, thrust, gm, k1, thrust_direction);
+        
+        Real r_mid[3];
+        Real v_mid[3];
+        for (int i = 0; i < 3; i++) {
+            r_mid[i] = r[i] + v[i] * half_h;
+            v_mid[i] = v[i] + k1[i] * half_h;
+        }
+        Real k2[3];
+        acceleration(r_mid, v_mid, m, thrust, gm, k2, thrust_direction);
+        
+        Real v_mid2[3];
+        for (int i = 0; i < 3; i++) {
+            v_mid2[i] = v[i] + k2[i] * half_h;
+        }
+        Real k3[3];
+        acceleration(r_mid, v_mid2, m, thrust, gm, k3, thrust_direction);
+        
+        Real r_end[3];
+        Real v_end[3];
+        Real half_h2 = h * h / Real(2);
+        for (int i = 0; i < 3; i++) {
+            r_end[i] = r[i] + v[i] * h + k3[i] * half_h2;
+            v_end[i] = v[i] + k3[i] * h;
+        }
+        Real k4[3];
+        acceleration(r_end, v_end, m, thrust, gm, k4, thrust_direction);
+        
+        // Position first: its increment uses stage 1's velocity v
+        Real sixth_h = h / Real(6.0);
+        Real two = Real(2);
+        for (int i = 0; i < 3; i++) {
+            accumulate(r[i], r_carry[i],
+                       sixth_h * (v[i] + two * v_mid[i] + two * v_mid2[i] + v_end[i]));
+        }
+        for (int i = 0; i < 3; i++) {
+            accumulate(v[i], v_carry[i],
+                       sixth_h * (k1[i] + two * k2[i] + two * k3[i] + k4[i]));
+        }
+        accumulate(t, t_carry, h);
+        
+        if (thrust_mN > 1e-10 && isp_s > 1e-10) {
+            Real v_e = Real(isp_s) * Real(g0);
+            Real dm_dt = -thrust * Real(1e-6) / v_e;
+            accumulate(m, m_carry, dm_dt * h);
+            if (m < Real(0)) {
+                m = Real(0);
+                m_carry = Real(0);
+            }
+        }
+        
+        store(state);
+    }
+
+private:
+    /// Same branches and operation order as computeAcceleration
+    static void acceleration(const Real r_at[3], const Real v_at[3], Real mass,
+                             Real thrust, Real gm, Real a[3], int thrust_direction) {
+        using std::sqrt;
+        Real a_grav[3] = {Real(0), Real(0), Real(0)};
+        Real r_mag = sqrt(r_at[0]*r_at[0] + r_at[1]*r_at[1] + r_at[2]*r_at[2]);
+        if (!(r_mag < Real(1e-10))) {
+            Real factor = -gm / (r_mag * r_mag * r_mag);
+            for (int i = 0; i < 3; i++) {
+                a_grav[i] = factor * r_at[i];
+            }
+        }
+        
+        Real a_thrust[3] = {Real(0), Real(0), Real(0)};
+        if (!(thrust < Real(1e-10) || mass < Real(1e-10))) {
+            Real v_mag = sqrt(v_at[0]*v_at[0] + v_at[1]*v_at[1] + v_at[2]*v_at[2]);
+            if (!(v_mag < Real(1e-10))) {
+                Real a_mag = (thrust * Real(1e-6)) / mass;
+                Real factor = Real(double(thrust_direction)) * a_mag / v_mag;
+                for (int i = 0; i < 3; i++) {
+                    a_thrust[i] = factor * v_at[i];
+                }
+            }
+        }
+        
+        for (int i = 0; i < 3; i++) {
+            a[i] = a_grav[i] + a_thrust[i];
+        }
+    }
+    
+    /// sum += increment; compensated: carry holds minus the part of the
+    /// sums so far that sum could not represent
+    static void accumulate(Real& sum, Real& carry, Real increment) {
+        if constexpr (Compensated) {
+            Real y = increment - carry;
+            Real next = sum + y;
+            carry = (next - sum) - y;
+            sum = next;
+        } else {
+            (void)carry;
+            sum = sum + increment;
+        }
+    }
+    
+    /// Nearest double of sum - carry
+    static double rounded(const Real& sum, const Real& carry) {
+        if constexpr (Compensated) {
+            return static_cast<double>(sum) - static_cast<double>(carry);
+        } else {
+            (void)carry;
+            return static_cast<double>(sum);
+        }
+    }
+    
+    /// state is exactly what the previous step wrote
+    bool continues(const MissionState& state) const {
+        if (!loaded || state.m != last.m || state.t != last.t) {
+            return false;
+        }
+        for (int i = 0; i < 3; i++) {
+            if (state.r[i] != last.r[i] || state.v[i] != last.v[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    void load(const MissionState& state) {
+        for (int i = 0; i < 3; i++) {
+            r[i] = Real(state.r[i]);
+            v[i] = Real(state.v[i]);
+            r_carry[i] = Real(0);
+            v_carry[i] = Real(0);
+        }
+        m = Real(state.m);
+        t = Real(state.t);
+        m_carry = Real(0);
+        t_carry = Real(0);
+        loaded = true;
+    }
+    
+    void store(MissionState& state) {
+        for (int i = 0; i < 3; i++) {
+            state.r[i] = rounded(r[i], r_carry[i]);
+            state.v[i] = rounded(v[i], v_carry[i]);
+        }
+        state.m = rounded(m, m_carry);
+        state.t = rounded(t, t_carry);
+        last = state;
+    }
+    
+    // Working state and its Kahan carries (zero unless Compensated)
+    Real r[3] = {};
+    Real v[3] = {};
+    Real m = {};
+    Real t = {};
+    Real r_carry[3] = {};
+    Real v_carry[3] = {};
+    Real m_carry = {};
+    Real t_carry = {};
+    
+    MissionState last;       // State written by the previous step
+    bool loaded = false;
+};
+
+using FloatRK4Propagator = PrecisionRK4Propagator<float, true>;
+using CompensatedRK4Propagator = PrecisionRK4Propagator<double, true>;
+using DoubleDoubleRK4Propagator = PrecisionRK4Propagator<DoubleDouble, false>;
+
+/// True for the integration.precision names above
+inline bool isValidPrecision(const std::string& precision) {
+    return precision == "double" || precision == "float" || precision == "double_kahan" ||
+           precision == "double_double";
+}
+
+#endif // PRECISION_H
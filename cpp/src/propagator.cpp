@@ -1,6 +1,7 @@
 #include <cmath>
 #include "propagator.h"
 #include "dynamics.h"
+#include "orbital_elements.h"
 
 // ===========================================================================
 // RK4 PROPAGATOR IMPLEMENTATION
@@ -19,22 +20,25 @@ void RK4Propagator::step(MissionState& state, double dt,
                          double thrust_mN, double isp_s,
                          double mu, double g0, int thrust_direction) {
     
+    // Stage positions/velocities live in plain arrays; each stage's velocity
+    // feeds both its acceleration and the final position update, so it is
+    // not copied again.
+    
     // ===========================================================================
     // STAGE 1: Evaluate at beginning of interval
     // ===========================================================================
     
-    // k1 = acceleration at (t, r, v)
+    // k1 = acceleration at (t, r, v); stage velocity is state.v itself
     double k1[3];
-    computeAcceleration(state, thrust_mN, mu, k1, thrust_direction);
-    
-    // Velocity at current time (used for position update)
-    double v_k1[3] = {state.v[0], state.v[1], state.v[2]};
+    computeAcceleration(state.r, state.v, state.m, thrust_mN, mu, k1, thrust_direction);
+    if (perturbation) {
+        perturbation->addAcceleration(state.r, state.t, state.m, k1);
+    }
     
     // ===========================================================================
     // STAGE 2: Evaluate at midpoint (t + dt/2)
     // ===========================================================================
     
-    // Create temporary state at midpoint
     // Position: r + v*dt/2
     double r_mid[3] = {
         state.r[0] + state.v[0] * (dt / 2),
@@ -49,18 +53,19 @@ void RK4Propagator::step(MissionState& state, double dt,
         state.v[2] + k1[2] * (dt / 2)
     };
     
-    // Create temporary state for acceleration evaluation
-    MissionState state_mid;
-    state_mid.r[0] = r_mid[0]; state_mid.r[1] = r_mid[1]; state_mid.r[2] = r_mid[2];
-    state_mid.v[0] = v_mid[0]; state_mid.v[1] = v_mid[1]; state_mid.v[2] = v_mid[2];
-    state_mid.m = state.m;  // Mass doesn't change during acceleration evaluation
-    
-    // k2 = acceleration at midpoint
+    // k2 = acceleration at midpoint (mass doesn't change during the stages)
     double k2[3];
-    computeAcceleration(state_mid, thrust_mN, mu, k2, thrust_direction);
-    
-    // Velocity at midpoint
-    double v_k2[3] = {v_mid[0], v_mid[1], v_mid[2]};
+    computeAcceleration(r_mid, v_mid, state.m, thrust_mN, mu, k2, thrust_direction);
+    
+    // Perturbations depend on position, time and mass only, so stages 2
+    // and 3 share one evaluation
+    double a_mid[3] = {0, 0, 0};
+    if (perturbation) {
+        perturbation->addAcceleration(r_mid, state.t + dt / 2, state.m, a_mid);
+        for (int i = 0; i < 3; i++) {
+            k2[i] += a_mid[i];
+        }
+    }
     
     // ===========================================================================
     // STAGE 3: Evaluate at midpoint again (different velocity)
@@ -74,15 +79,14 @@ void RK4Propagator::step(MissionState& state, double dt,
         state.v[2] + k2[2] * (dt / 2)
     };
     
-    // Create temporary state
-    state_mid.v[0] = v_mid2[0]; state_mid.v[1] = v_mid2[1]; state_mid.v[2] = v_mid2[2];
-    
     // k3 = acceleration at this midpoint configuration
     double k3[3];
-    computeAcceleration(state_mid, thrust_mN, mu, k3, thrust_direction);
-    
-    // Velocity at this midpoint
-    double v_k3[3] = {v_mid2[0], v_mid2[1], v_mid2[2]};
+    computeAcceleration(r_mid, v_mid2, state.m, thrust_mN, mu, k3, thrust_direction);
+    if (perturbation) {
+        for (int i = 0; i < 3; i++) {
+            k3[i] += a_mid[i];
+        }
+    }
     
     // ===========================================================================
     // STAGE 4: Evaluate at end of interval (t + dt)
@@ -102,18 +106,12 @@ void RK4Propagator::step(MissionState& state, double dt,
         state.v[2] + k3[2] * dt
     };
     
-    // Create temporary state at end of interval
-    MissionState state_end;
-    state_end.r[0] = r_end[0]; state_end.r[1] = r_end[1]; state_end.r[2] = r_end[2];
-    state_end.v[0] = v_end[0]; state_end.v[1] = v_end[1]; state_end.v[2] = v_end[2];
-    state_end.m = state.m;
-    
     // k4 = acceleration at end of interval
     double k4[3];
-    computeAcceleration(state_end, thrust_mN, mu, k4, thrust_direction);
-    
-    // Velocity at end of interval
-    double v_k4[3] = {v_end[0], v_end[1], v_end[2]};
+    computeAcceleration(r_end, v_end, state.m, thrust_mN, mu, k4, thrust_direction);
+    if (perturbation) {
+        perturbation->addAcceleration(r_end, state.t + dt, state.m, k4);
+    }
     
     // ===========================================================================
     // COMBINE STAGES: Weighted average of 4 estimates
@@ -121,17 +119,18 @@ void RK4Propagator::step(MissionState& state, double dt,
     // RK4 formula: y(t+dt) = y(t) + (dt/6) * (k1 + 2*k2 + 2*k3 + k4)
     // Weights: [1, 2, 2, 1] / 6 = [1/6, 1/3, 1/3, 1/6]
     
+    // Update position using weighted average of velocities at 4 stages
+    // This is more accurate than just using initial velocity. Done before
+    // the velocity update because stage 1's velocity is state.v.
+    state.r[0] = state.r[0] + (dt / 6.0) * (state.v[0] + 2*v_mid[0] + 2*v_mid2[0] + v_end[0]);
+    state.r[1] = state.r[1] + (dt / 6.0) * (state.v[1] + 2*v_mid[1] + 2*v_mid2[1] + v_end[1]);
+    state.r[2] = state.r[2] + (dt / 6.0) * (state.v[2] + 2*v_mid[2] + 2*v_mid2[2] + v_end[2]);
+    
     // Update velocity
     state.v[0] = state.v[0] + (dt / 6.0) * (k1[0] + 2*k2[0] + 2*k3[0] + k4[0]);
     state.v[1] = state.v[1] + (dt / 6.0) * (k1[1] + 2*k2[1] + 2*k3[1] + k4[1]);
     state.v[2] = state.v[2] + (dt / 6.0) * (k1[2] + 2*k2[2] + 2*k3[2] + k4[2]);
     
-    // Update position using weighted average of velocities at 4 stages
-    // This is more accurate than just using initial velocity
-    state.r[0] = state.r[0] + (dt / 6.0) * (v_k1[0] + 2*v_k2[0] + 2*v_k3[0] + v_k4[0]);
-    state.r[1] = state.r[1] + (dt / 6.0) * (v_k1[1] + 2*v_k2[1] + 2*v_k3[1] + v_k4[1]);
-    state.r[2] = state.r[2] + (dt / 6.0) * (v_k1[2] + 2*v_k2[2] + 2*v_k3[2] + v_k4[2]);
-    
     // Update time
     state.t = state.t + dt;
     
@@ -150,6 +149,136 @@ void RK4Propagator::step(MissionState& state, double dt,
     }
 }
 
+// ===========================================================================
+// RK4 VARIATIONAL STEP
+// ===========================================================================
+// Differentiates the RK4 step above stage by stage. For one Jacobian
+// column (δr, δv, δm, δthrust, δisp), each stage acceleration varies as
+//
+//   δk = da_dr δr_stage + da_dv δv_stage + da_dm δm + da_dthrust δthrust
+//
+// and the stage states and the final combination are linear, so they vary
+// with the same coefficients as in step(). Mass is frozen during the
+// stages and updated once: m' = m - thrust*1e-6/(isp*g0) * dt.
+
+namespace {
+
+/// da * (δr, δv, δm, δthrust) for one stage
+void stageVariation(const AccelerationPartials& p, const double dr[3], const double dv[3],
+                    double dm, double dthrust, double dk[3]) {
+    for (int i = 0; i < 3; i++) {
+        dk[i] = p.da_dm[i] * dm + p.da_dthrust[i] * dthrust;
+        for (int j = 0; j < 3; j++) {
+            dk[i] += p.da_dr[i][j] * dr[j] + p.da_dv[i][j] * dv[j];
+        }
+    }
+}
+
+}  // namespace
+
+void RK4Propagator::stepWithSensitivity(MissionState& state, StateSensitivity& sensitivity,
+                                        double dt, double thrust_mN, double isp_s,
+                                        double mu, double g0, int thrust_direction) {
+    // Stages exactly as in step(), keeping the partials of each evaluation
+    AccelerationPartials p1, p2, p3, p4;
+    computeAccelerationPartials(state.r, state.v, state.m, thrust_mN, mu, p1, thrust_direction);
+    const double* k1 = p1.a;
+    
+    double r_mid[3] = {
+        state.r[0] + state.v[0] * (dt / 2),
+        state.r[1] + state.v[1] * (dt / 2),
+        state.r[2] + state.v[2] * (dt / 2)
+    };
+    double v_mid[3] = {
+        state.v[0] + k1[0] * (dt / 2),
+        state.v[1] + k1[1] * (dt / 2),
+        state.v[2] + k1[2] * (dt / 2)
+    };
+    computeAccelerationPartials(r_mid, v_mid, state.m, thrust_mN, mu, p2, thrust_direction);
+    const double* k2 = p2.a;
+    
+    double v_mid2[3] = {
+        state.v[0] + k2[0] * (dt / 2),
+        state.v[1] + k2[1] * (dt / 2),
+        state.v[2] + k2[2] * (dt / 2)
+    };
+    computeAccelerationPartials(r_mid, v_mid2, state.m, thrust_mN, mu, p3, thrust_direction);
+    const double* k3 = p3.a;
+    
+    double r_end[3] = {
+        state.r[0] + state.v[0] * dt + k3[0] * (dt * dt / 2),
+        state.r[1] + state.v[1] * dt + k3[1] * (dt * dt / 2),
+        state.r[2] + state.v[2] * dt + k3[2] * (dt * dt / 2)
+    };
+    double v_end[3] = {
+        state.v[0] + k3[0] * dt,
+        state.v[1] + k3[1] * dt,
+        state.v[2] + k3[2] * dt
+    };
+    computeAccelerationPartials(r_end, v_end, state.m, thrust_mN, mu, p4, thrust_direction);
+    const double* k4 = p4.a;
+    
+    // Tangent map, one Jacobian column at a time (before the state moves,
+    // since the partials were taken about the current stages)
+    bool burning = thrust_mN > 1e-10 && isp_s > 1e-10;
+    double v_e = isp_s * g0;
+    double dm_dt = burning ? -thrust_mN * 1e-6 / v_e : 0.0;
+    double flow = burning ? 1e-6 / v_e : 0.0;             // |dm/dt| per mN of thrust
+    bool clamped = burning && state.m + dm_dt * dt < 0;
+    auto& S = sensitivity.jacobian;
+    for (int j = 0; j < StateSensitivity::COLUMNS; j++) {
+        double dr[3] = {S[0][j], S[1][j], S[2][j]};
+        double dv[3] = {S[3][j], S[4][j], S[5][j]};
+        double dm = S[6][j];
+        double dthrust = (j == StateSensitivity::THRUST) ? 1.0 : 0.0;
+        double disp = (j == StateSensitivity::ISP) ? 1.0 : 0.0;
+        
+        double dk1[3], dk2[3], dk3[3], dk4[3];
+        double dr_mid[3], dv_mid[3], dv_mid2[3], dr_end[3], dv_end[3];
+        stageVariation(p1, dr, dv, dm, dthrust, dk1);
+        for (int i = 0; i < 3; i++) {
+            dr_mid[i] = dr[i] + dv[i] * (dt / 2);
+            dv_mid[i] = dv[i] + dk1[i] * (dt / 2);
+        }
+        stageVariation(p2, dr_mid, dv_mid, dm, dthrust, dk2);
+        for (int i = 0; i < 3; i++) {
+            dv_mid2[i] = dv[i] + dk2[i] * (dt / 2);
+        }
+        stageVariation(p3, dr_mid, dv_mid2, dm, dthrust, dk3);
+        for (int i = 0; i < 3; i++) {
+            dr_end[i] = dr[i] + dv[i] * dt + dk3[i] * (dt * dt / 2);
+            dv_end[i] = dv[i] + dk3[i] * dt;
+        }
+        stageVariation(p4, dr_end, dv_end, dm, dthrust, dk4);
+        
+        for (int i = 0; i < 3; i++) {
+            S[i][j] = dr[i] + (dt / 6.0) * (dv[i] + 2*dv_mid[i] + 2*dv_mid2[i] + dv_end[i]);
+            S[3 + i][j] = dv[i] + (dt / 6.0) * (dk1[i] + 2*dk2[i] + 2*dk3[i] + dk4[i]);
+        }
+        if (clamped) {
+            S[6][j] = 0;  // Mass clamped at zero
+        } else if (burning) {
+            // d/dthrust and d/disp of -thrust*1e-6/(isp*g0) * dt
+            S[6][j] = dm - flow * dt * dthrust + flow * thrust_mN / isp_s * dt * disp;
+        }
+    }
+    
+    // State update, exactly as in step()
+    state.r[0] = state.r[0] + (dt / 6.0) * (state.v[0] + 2*v_mid[0] + 2*v_mid2[0] + v_end[0]);
+    state.r[1] = state.r[1] + (dt / 6.0) * (state.v[1] + 2*v_mid[1] + 2*v_mid2[1] + v_end[1]);
+    state.r[2] = state.r[2] + (dt / 6.0) * (state.v[2] + 2*v_mid[2] + 2*v_mid2[2] + v_end[2]);
+    state.v[0] = state.v[0] + (dt / 6.0) * (k1[0] + 2*k2[0] + 2*k3[0] + k4[0]);
+    state.v[1] = state.v[1] + (dt / 6.0) * (k1[1] + 2*k2[1] + 2*k3[1] + k4[1]);
+    state.v[2] = state.v[2] + (dt / 6.0) * (k1[2] + 2*k2[2] + 2*k3[2] + k4[2]);
+    state.t = state.t + dt;
+    if (burning) {
+        state.m = state.m + dm_dt * dt;
+        if (state.m < 0) {
+            state.m = 0;
+        }
+    }
+}
+
 // ===========================================================================
 // EULER PROPAGATOR IMPLEMENTATION
 // ===========================================================================
@@ -175,6 +304,9 @@ void EulerPropagator::step(MissionState& state, double dt,
     
     double a[3];
     computeAcceleration(state, thrust_mN, mu, a, thrust_direction);
+    if (perturbation) {
+        perturbation->addAcceleration(state.r, state.t, state.m, a);
+    }
     
     // ===========================================================================
     // STEP 2: Update velocity
@@ -217,3 +349,502 @@ void EulerPropagator::step(MissionState& state, double dt,
         }
     }
 }
+
+// ===========================================================================
+// ADAPTIVE PROPAGATOR: STEP-SIZE CONTROL
+// ===========================================================================
+// Standard controller (Hairer, Nørsett & Wanner, Solving ODEs I, II.4):
+//   dt_new = dt * clamp(safety * err^(-1/(q+1)), min_factor, max_factor)
+// where q is the order of the embedded error estimate. After a rejection
+// the step is not allowed to grow on the next accepted step.
+
+namespace {
+
+constexpr double STEP_SAFETY = 0.9;
+constexpr double STEP_MIN_FACTOR = 0.2;
+constexpr double STEP_MAX_FACTOR = 10.0;
+constexpr double STEP_MIN_SIZE = 1e-3;  // seconds; below this, accept and move on
+
+/// Evaluate the S stages of an explicit Runge-Kutta tableau
+/// k[s] = f(y + dt * sum_{j<s} a[s][j] * k[j]). Only a perturbation depends
+/// on time; its stage s sees t + c_s dt with c_s the row sum of a.
+template <int S>
+void evaluateStages(const double y[7], double t, double dt, const double (&a)[S][S],
+                    double thrust_mN, double isp_s, double mu, double g0,
+                    int thrust_direction, Perturbation* perturbation, double k[S][7]) {
+    computeStateDerivative(y, thrust_mN, isp_s, mu, g0, k[0], thrust_direction);
+    if (perturbation) {
+        perturbation->addAcceleration(&y[0], t, y[6], &k[0][3]);
+    }
+    
+    double y_stage[7];
+    for (int s = 1; s < S; s++) {
+        for (int i = 0; i < 7; i++) {
+            double sum = 0;
+            for (int j = 0; j < s; j++) {
+                sum += a[s][j] * k[j][i];
+            }
+            y_stage[i] = y[i] + dt * sum;
+        }
+        computeStateDerivative(y_stage, thrust_mN, isp_s, mu, g0, k[s], thrust_direction);
+        if (perturbation) {
+            double c = 0;
+            for (int j = 0; j < s; j++) {
+                c += a[s][j];
+            }
+            perturbation->addAcceleration(&y_stage[0], t + c * dt, y_stage[6], &k[s][3]);
+        }
+    }
+}
+
+}  // namespace
+
+template <typename Pair>
+double AdaptivePropagator::controlledStep(MissionState& state, double dt_try, double& dt_next,
+                                          double thrust_mN, double isp_s,
+                                          double mu, double g0, int thrust_direction,
+                                          double dt_max) {
+    Pair& pair = static_cast<Pair&>(*this);
+    double y[7] = {state.r[0], state.r[1], state.r[2],
+                   state.v[0], state.v[1], state.v[2], state.m};
+    double y_new[7];
+    
+    double dt = dt_try;
+    if (dt_max > 0 && dt > dt_max) {
+        dt = dt_max;
+    }
+    
+    double exponent = 1.0 / (pair.errorOrder() + 1);
+    bool step_rejected = false;
+    
+    while (true) {
+        double err = pair.attemptStep(y, state.t, dt, thrust_mN, isp_s, mu, g0,
+                                      thrust_direction, y_new);
+        
+        if (err <= 1.0 || dt <= STEP_MIN_SIZE) {
+            // Accept: choose the next step from this error
+            double factor = (err > 0) ? STEP_SAFETY * std::pow(err, -exponent) : STEP_MAX_FACTOR;
+            factor = std::fmin(STEP_MAX_FACTOR, std::fmax(STEP_MIN_FACTOR, factor));
+            if (step_rejected) {
+                factor = std::fmin(factor, 1.0);
+            }
+            dt_next = dt * factor;
+            break;
+        }
+        
+        // Reject: shrink and retry (NaN/inf errors shrink by the minimum factor)
+        rejected++;
+        step_rejected = true;
+        double factor = std::isfinite(err) ? STEP_SAFETY * std::pow(err, -exponent) : STEP_MIN_FACTOR;
+        dt *= std::fmax(STEP_MIN_FACTOR, factor);
+    }
+    
+    accepted++;
+    
+    state.r[0] = y_new[0]; state.r[1] = y_new[1]; state.r[2] = y_new[2];
+    state.v[0] = y_new[3]; state.v[1] = y_new[4]; state.v[2] = y_new[5];
+    state.m = (y_new[6] < 0) ? 0 : y_new[6];
+    state.t = state.t + dt;
+    
+    return dt;
+}
+
+void AdaptivePropagator::step(MissionState& state, double dt,
+                              double thrust_mN, double isp_s,
+                              double mu, double g0, int thrust_direction) {
+    double t_end = state.t + dt;
+    double remaining = dt;
+    double h = dt;
+    
+    // Substep until the requested interval is covered
+    while (remaining > 1e-9 * dt) {
+        double h_next;
+        double taken = adaptiveStep(state, h, h_next, thrust_mN, isp_s,
+                                    mu, g0, thrust_direction, remaining);
+        remaining -= taken;
+        h = h_next;
+    }
+    
+    state.t = t_end;
+}
+
+// ===========================================================================
+// DORMAND-PRINCE 5(4) IMPLEMENTATION
+// ===========================================================================
+// 7 stages, 5th-order solution, embedded 4th-order error estimate.
+// Reference: Dormand & Prince, J. Comp. Appl. Math. 6 (1980) 19-26
+
+namespace {
+
+constexpr double DP5_A[7][7] = {
+    {0, 0, 0, 0, 0, 0, 0},
+    {1.0/5, 0, 0, 0, 0, 0, 0},
+    {3.0/40, 9.0/40, 0, 0, 0, 0, 0},
+    {44.0/45, -56.0/15, 32.0/9, 0, 0, 0, 0},
+    {19372.0/6561, -25360.0/2187, 64448.0/6561, -212.0/729, 0, 0, 0},
+    {9017.0/3168, -355.0/33, 46732.0/5247, 49.0/176, -5103.0/18656, 0, 0},
+    {35.0/384, 0, 500.0/1113, 125.0/192, -2187.0/6784, 11.0/84, 0}
+};
+
+// Error weights: 5th-order minus 4th-order solution weights
+constexpr double DP5_E[7] = {
+    71.0/57600, 0, -71.0/16695, 71.0/1920, -17253.0/339200, 22.0/525, -1.0/40
+};
+
+}  // namespace
+
+double DormandPrince54Propagator::attemptStep(const double y[7], double t, double dt,
+                                              double thrust_mN, double isp_s,
+                                              double mu, double g0, int thrust_direction,
+                                              double y_new[7]) {
+    double k[7][7];
+    evaluateStages<7>(y, t, dt, DP5_A, thrust_mN, isp_s, mu, g0, thrust_direction,
+                      perturbation, k);
+    
+    // The last stage row equals the 5th-order weights (FSAL property),
+    // so the solution is assembled from the same row
+    double err_sq = 0;
+    for (int i = 0; i < 7; i++) {
+        double sum = 0;
+        double err = 0;
+        for (int j = 0; j < 7; j++) {
+            sum += DP5_A[6][j] * k[j][i];
+            err += DP5_E[j] * k[j][i];
+        }
+        y_new[i] = y[i] + dt * sum;
+        
+        double scaled = dt * err / errorScale(y, y_new, i);
+        err_sq += scaled * scaled;
+    }
+    
+    return std::sqrt(err_sq / 7.0);
+}
+
+double DormandPrince54Propagator::adaptiveStep(MissionState& state, double dt_try,
+                                               double& dt_next, double thrust_mN, double isp_s,
+                                               double mu, double g0, int thrust_direction,
+                                               double dt_max) {
+    return controlledStep<DormandPrince54Propagator>(state, dt_try, dt_next, thrust_mN, isp_s,
+                                                     mu, g0, thrust_direction, dt_max);
+}
+
+// ===========================================================================
+// DOP853 IMPLEMENTATION
+// ===========================================================================
+// 12 stages, 8th-order solution with 5th- and 3rd-order error estimates
+// combined as in Hairer's dop853.f:
+//   err = err5² / sqrt(err5² + 0.01 * err3²)
+// Reference: Hairer, Nørsett & Wanner, Solving ODEs I, Section II.10
+
+namespace {
+
+constexpr double DOP853_A[12][12] = {
+    {0},
+    {5.26001519587677318785587544488e-2},
+    {1.97250569845378994544595329183e-2, 5.91751709536136983633785987549e-2},
+    {2.95875854768068491816892993775e-2, 0, 8.87627564304205475450678981324e-2},
+    {2.41365134159266685502369798665e-1, 0, -8.84549479328286085344864962717e-1,
+     9.24834003261792003115737966543e-1},
+    {3.7037037037037037037037037037e-2, 0, 0, 1.70828608729473871279604482173e-1,
+     1.25467687566822425016691814123e-1},
+    {3.7109375e-2, 0, 0, 1.70252211019544039314978060272e-1,
+     6.02165389804559606850219397283e-2, -1.7578125e-2},
+    {3.70920001185047927108779319836e-2, 0, 0, 1.70383925712239993810214054705e-1,
+     1.07262030446373284651809199168e-1, -1.53194377486244017527936158236e-2,
+     8.27378916381402288758473766002e-3},
+    {6.24110958716075717114429577812e-1, 0, 0, -3.36089262944694129406857109825,
+     -8.68219346841726006818189891453e-1, 2.75920996994467083049415600797e1,
+     2.01540675504778934086186788979e1, -4.34898841810699588477366255144e1},
+    {4.77662536438264365890433908527e-1, 0, 0, -2.48811461997166764192642586468,
+     -5.90290826836842996371446475743e-1, 2.12300514481811942347288949897e1,
+     1.52792336328824235832596922938e1, -3.32882109689848629194453265587e1,
+     -2.03312017085086261358222928593e-2},
+    {-9.3714243008598732571704021658e-1, 0, 0, 5.18637242884406370830023853209,
+     1.09143734899672957818500254654, -8.14978701074692612513997267357,
+     -1.85200656599969598641566180701e1, 2.27394870993505042818970056734e1,
+     2.49360555267965238987089396762, -3.0467644718982195003823669022},
+    {2.27331014751653820792359768449, 0, 0, -1.05344954667372501984066689879e1,
+     -2.00087205822486249909675718444, -1.79589318631187989172765950534e1,
+     2.79488845294199600508499808837e1, -2.85899827713502369474065508674,
+     -8.87285693353062954433549289258, 1.23605671757943030647266201528e1,
+     6.43392746015763530355970484046e-1}
+};
+
+// 8th-order solution weights
+constexpr double DOP853_B[12] = {
+    5.42937341165687622380535766363e-2, 0, 0, 0, 0,
+    4.45031289275240888144113950566, 1.89151789931450038304281599044,
+    -5.8012039600105847814672114227, 3.1116436695781989440891606237e-1,
+    -1.52160949662516078556178806805e-1, 2.01365400804030348374776537501e-1,
+    4.47106157277725905176885569043e-2
+};
+
+// 5th-order error estimate weights
+constexpr double DOP853_E5[12] = {
+    0.1312004499419488073250102996e-01, 0, 0, 0, 0,
+    -0.1225156446376204440720569753e+01, -0.4957589496572501915214079952,
+    0.1664377182454986536961530415e+01, -0.3503288487499736816886487290,
+    0.3341791187130174790297318841, 0.8192320648511571246570742613e-01,
+    -0.2235530786388629525884427845e-01
+};
+
+// 3rd-order error estimate weights (applied to stages 1, 9, 12)
+constexpr double DOP853_BHH1 = 0.244094488188976377952755905512;
+constexpr double DOP853_BHH2 = 0.733846688281611857341361741547;
+constexpr double DOP853_BHH3 = 0.220588235294117647058823529412e-01;
+
+}  // namespace
+
+double DOP853Propagator::attemptStep(const double y[7], double t, double dt,
+                                     double thrust_mN, double isp_s,
+                                     double mu, double g0, int thrust_direction,
+                                     double y_new[7]) {
+    double k[12][7];
+    evaluateStages<12>(y, t, dt, DOP853_A, thrust_mN, isp_s, mu, g0, thrust_direction,
+                       perturbation, k);
+    
+    double err5_sq = 0;
+    double err3_sq = 0;
+    for (int i = 0; i < 7; i++) {
+        double sum = 0;
+        double err5 = 0;
+        for (int j = 0; j < 12; j++) {
+            sum += DOP853_B[j] * k[j][i];
+            err5 += DOP853_E5[j] * k[j][i];
+        }
+        double err3 = sum - DOP853_BHH1 * k[0][i] - DOP853_BHH2 * k[8][i] - DOP853_BHH3 * k[11][i];
+        y_new[i] = y[i] + dt * sum;
+        
+        double scale = errorScale(y, y_new, i);
+        err5_sq += (err5 / scale) * (err5 / scale);
+        err3_sq += (err3 / scale) * (err3 / scale);
+    }
+    
+    double denominator = err5_sq + 0.01 * err3_sq;
+    if (denominator <= 0) {
+        return 0;
+    }
+    return std::fabs(dt) * err5_sq / std::sqrt(7.0 * denominator);
+}
+
+double DOP853Propagator::adaptiveStep(MissionState& state, double dt_try, double& dt_next,
+                                      double thrust_mN, double isp_s,
+                                      double mu, double g0, int thrust_direction,
+                                      double dt_max) {
+    return controlledStep<DOP853Propagator>(state, dt_try, dt_next, thrust_mN, isp_s,
+                                            mu, g0, thrust_direction, dt_max);
+}
+
+// ===========================================================================
+// ORBIT-AVERAGED PROPAGATOR IMPLEMENTATION
+// ===========================================================================
+
+namespace {
+
+/// Trapezoid nodes in true longitude for the orbit average
+constexpr int AVERAGING_NODES = 32;
+
+/// Averaged state: p, f, g, h, k and the mean longitude λ
+constexpr int AVERAGED_DIM = 6;
+
+/// Orbit-averaged rates of the averaged state under thrust/m along ±v
+/// The thrust stays in the orbit plane, so h and k do not change.
+/// @return false if x is not an ellipse
+bool averagedRates(const double x[AVERAGED_DIM], double mass, double thrust_mN, double mu,
+                   int thrust_direction, double rates[AVERAGED_DIM]) {
+    double p = x[0];
+    double f = x[1];
+    double g = x[2];
+    double e2 = f * f + g * g;
+    if (!(p > 0) || !(e2 < 1.0)) {
+        return false;
+    }
+    double a = p / (1.0 - e2);
+    
+    double a_thrust = 0;
+    if (!(thrust_mN < 1e-10 || mass < 1e-10)) {
+        a_thrust = thrust_direction * (thrust_mN * 1e-6) / mass;
+    }
+    double sqrt_p_mu = std::sqrt(p / mu);
+    double sqrt_mu_p = std::sqrt(mu * p);
+    
+    // Σ dx/dt · dt/dL over the nodes; the common 2π/N cancels in the mean
+    double sum_p = 0;
+    double sum_f = 0;
+    double sum_g = 0;
+    double sum_time = 0;
+    for (int j = 0; j < AVERAGING_NODES; j++) {
+        double L = 2.0 * 3.14159265358979323846 * j / AVERAGING_NODES;
+        double cos_L = std::cos(L);
+        double sin_L = std::sin(L);
+        double w = 1.0 + f * cos_L + g * sin_L;
+        double dt_dL = p * p / (sqrt_mu_p * w * w);
+        
+        // Radial and transverse velocity (in units of sqrt(μ/p)) give the
+        // thrust direction
+        double v_r = f * sin_L - g * cos_L;
+        double v_t = w;
+        double v_mag = std::sqrt(v_r * v_r + v_t * v_t);
+        double a_r = a_thrust * v_r / v_mag;
+        double a_t = a_thrust * v_t / v_mag;
+        
+        // Gauss variational equations in modified equinoctial elements
+        sum_p += dt_dL * (2.0 * p / w * sqrt_p_mu * a_t);
+        sum_f += dt_dL * sqrt_p_mu * (a_r * sin_L + ((w + 1.0) * cos_L + f) * a_t / w);
+        sum_g += dt_dL * sqrt_p_mu * (-a_r * cos_L + ((w + 1.0) * sin_L + g) * a_t / w);
+        sum_time += dt_dL;
+    }
+    
+    rates[0] = sum_p / sum_time;
+    rates[1] = sum_f / sum_time;
+    rates[2] = sum_g / sum_time;
+    rates[3] = 0;
+    rates[4] = 0;
+    rates[5] = std::sqrt(mu / (a * a * a));  // Mean motion
+    return true;
+}
+
+}  // namespace
+
+void AveragedPropagator::step(MissionState& state, double dt,
+                              double thrust_mN, double isp_s,
+                              double mu, double g0, int thrust_direction) {
+    double t_end = state.t + dt;
+    double remaining = dt;
+    while (remaining > 1e-9 * dt) {
+        double taken = handed_off ? 0.0 : averagedStep(state, thrust_mN, isp_s, mu, g0,
+                                                       thrust_direction, remaining);
+        if (taken == 0) {
+            taken = std::fmin(rk4_step_s, remaining);
+            rk4.step(state, taken, thrust_mN, isp_s, mu, g0, thrust_direction);
+        }
+        remaining -= taken;
+    }
+    state.t = t_end;
+}
+
+double AveragedPropagator::advance(MissionState& state, double thrust_mN, double isp_s,
+                                   double mu, double g0, int thrust_direction, double dt_max) {
+    if (!handed_off) {
+        double taken = averagedStep(state, thrust_mN, isp_s, mu, g0, thrust_direction, dt_max);
+        if (taken > 0) {
+            return taken;
+        }
+    }
+    double dt = (dt_max > 0) ? std::fmin(rk4_step_s, dt_max) : rk4_step_s;
+    rk4.step(state, dt, thrust_mN, isp_s, mu, g0, thrust_direction);
+    return dt;
+}
+
+double AveragedPropagator::averagedStep(MissionState& state, double thrust_mN, double isp_s,
+                                        double mu, double g0, int thrust_direction,
+                                        double dt_max) {
+    EquinoctialElements elements = computeEquinoctialElements(state.r, state.v, mu);
+    double x[AVERAGED_DIM] = {
+        elements.p, elements.f, elements.g, elements.h, elements.k,
+        trueToMeanLongitude(elements.L, elements.f, elements.g)
+    };
+    double e = elements.eccentricity();
+    if (!(elements.p > 0) || !(e < 1.0)) {
+        handed_off = true;
+        return 0;
+    }
+    double a = elements.p / (1.0 - e * e);
+    double dt = std::fmin(revolutions * 2.0 * 3.14159265358979323846 *
+                          std::sqrt(a * a * a / mu), dt_max);
+    
+    // Same mass flow as RK4Propagator, constant over the step
+    double mass_flow = 0;
+    if (thrust_mN > 1e-10 && isp_s > 1e-10) {
+        mass_flow = thrust_mN * 1e-6 / (isp_s * g0);
+    }
+    double mass_mid = state.m - mass_flow * (dt / 2);
+    double mass_end = state.m - mass_flow * dt;
+    
+    // RK4 on the averaged rates
+    double k1[AVERAGED_DIM];
+    double k2[AVERAGED_DIM];
+    double k3[AVERAGED_DIM];
+    double k4[AVERAGED_DIM];
+    double stage[AVERAGED_DIM];
+    bool elliptic = averagedRates(x, state.m, thrust_mN, mu, thrust_direction, k1);
+    for (int i = 0; i < AVERAGED_DIM; i++) {
+        stage[i] = x[i] + k1[i] * (dt / 2);
+    }
+    elliptic = elliptic && averagedRates(stage, mass_mid, thrust_mN, mu, thrust_direction, k2);
+    for (int i = 0; i < AVERAGED_DIM; i++) {
+        stage[i] = x[i] + k2[i] * (dt / 2);
+    }
+    elliptic = elliptic && averagedRates(stage, mass_mid, thrust_mN, mu, thrust_direction, k3);
+    for (int i = 0; i < AVERAGED_DIM; i++) {
+        stage[i] = x[i] + k3[i] * dt;
+    }
+    elliptic = elliptic && averagedRates(stage, mass_end, thrust_mN, mu, thrust_direction, k4);
+    if (!elliptic) {
+        handed_off = true;
+        return 0;
+    }
+    for (int i = 0; i < AVERAGED_DIM; i++) {
+        x[i] = x[i] + (dt / 6.0) * (k1[i] + 2*k2[i] + 2*k3[i] + k4[i]);
+    }
+    
+    // Hand off instead of taking a step into the coast zone, past the fuel
+    // cutoff or off the ellipse
+    double e_end = std::sqrt(x[1] * x[1] + x[2] * x[2]);
+    bool near_coast = false;
+    if (coast_radius_km > 0 && e_end < 1.0) {
+        near_coast = (thrust_direction > 0) ? x[0] / (1.0 - e_end) >= handoff * coast_radius_km
+                                            : x[0] / (1.0 + e_end) <= coast_radius_km / handoff;
+    }
+    if (!(x[0] > 0) || !(e_end < 1.0) || near_coast || mass_end < min_mass_kg) {
+        handed_off = true;
+        return 0;
+    }
+    
+    elements.p = x[0];
+    elements.f = x[1];
+    elements.g = x[2];
+    elements.h = x[3];
+    elements.k = x[4];
+    elements.L = meanToTrueLongitude(x[5], x[1], x[2]);
+    equinoctialToState(elements, mu, state.r, state.v);
+    state.m = mass_end;
+    state.t = state.t + dt;
+    averaged_steps++;
+    return dt;
+}
+
+// ===========================================================================
+// INTEGRATOR FACTORY
+// ===========================================================================
+
+std::unique_ptr<Propagator> createPropagator(const MissionConfig& config) {
+    const std::string& name = config.integrator;
+    if (name == "rk4") {
+        return std::make_unique<RK4Propagator>();
+    }
+    if (name == "rk45" || name == "dopri5") {
+        return std::make_unique<DormandPrince54Propagator>(config.abs_tol, config.rel_tol);
+    }
+    if (name == "dop853") {
+        return std::make_unique<DOP853Propagator>(config.abs_tol, config.rel_tol);
+    }
+    if (name == "averaged") {
+        // Without the mission's arrival radius there is no coast handoff
+        return std::make_unique<AveragedPropagator>(config.timestep_s,
+                                                    config.averaging_revolutions);
+    }
+    return std::make_unique<EulerPropagator>();
+}
+
+bool isAdaptiveIntegrator(const std::string& name) {
+    return name == "rk45" || name == "dopri5" || name == "dop853";
+}
+
+const char* getIntegratorDisplayName(const std::string& name) {
+    if (name == "rk4") return "RK4";
+    if (name == "rk45" || name == "dopri5") return "Dormand-Prince 5(4)";
+    if (name == "dop853") return "DOP853";
+    if (name == "averaged") return "Orbit-averaged equinoctial";
+    return "Euler";
+}
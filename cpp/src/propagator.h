@@ -2,9 +2,13 @@
 #define PROPAGATOR_H
 
 #include <cmath>
+#include <memory>
 #include <string>
+#include <vector>
 #include "constants.h"
 
+class PruningBound;
+
 // ===========================================================================
 // MISSION STATE STRUCT
 // ===========================================================================
@@ -37,6 +41,35 @@ struct MissionState {
     }
 };
 
+// ===========================================================================
+// STATE SENSITIVITY STRUCT
+// ===========================================================================
+// Jacobian of the state y = [rx, ry, rz, vx, vy, vz, m] with respect to
+// the initial state and the thruster parameters:
+//
+//   jacobian[i][j] = dy_i / dy0_j      j = 0..6 (the 7x7 state-transition matrix)
+//   jacobian[i][THRUST] = dy_i / d thrust_mN
+//   jacobian[i][ISP]    = dy_i / d isp_s
+//
+// Starts as [I | 0] and is carried along by RK4Propagator::stepWithSensitivity.
+
+struct StateSensitivity {
+    static constexpr int ROWS = 7;
+    static constexpr int COLUMNS = 9;
+    static constexpr int THRUST = 7;     // Column of d/d thrust_mN
+    static constexpr int ISP = 8;        // Column of d/d isp_s
+    
+    double jacobian[ROWS][COLUMNS];
+    
+    StateSensitivity() {
+        for (int i = 0; i < ROWS; i++) {
+            for (int j = 0; j < COLUMNS; j++) {
+                jacobian[i][j] = (i == j) ? 1.0 : 0.0;
+            }
+        }
+    }
+};
+
 // ===========================================================================
 // SPACECRAFT CONFIGURATION STRUCT
 // ===========================================================================
@@ -48,6 +81,31 @@ struct SpacecraftConfig {
     double initial_mass_kg = 10000;      // total spacecraft mass (kg)
 };
 
+// ===========================================================================
+// EVENT SPECIFICATION STRUCT
+// ===========================================================================
+
+/// User-defined event located during propagation (see events.h)
+struct EventSpec {
+    std::string type = "mass_below";     // "mass_below" (kg) or "radius_crossing" (km)
+    double value = 0;                    // mass limit or radius
+    bool terminal = false;               // stop the propagation at the event
+};
+
+// ===========================================================================
+// PERTURBATION SPECIFICATION STRUCT
+// ===========================================================================
+
+/// One entry of the force-model list (see force_model.h)
+struct PerturbationSpec {
+    std::string type = "third_body";     // "third_body" or "solar_radiation_pressure"
+    bool enabled = true;                 // false keeps the entry but skips it
+    CelestialBody body = CelestialBody::JUPITER;  // third_body: perturbing body
+    double phase_deg = 0;                // third_body: body longitude at t = 0 (deg)
+    double area_m2 = 20;                 // solar_radiation_pressure: sunlit area
+    double reflectivity = 1.3;           // solar_radiation_pressure: C_r (1 to 2)
+};
+
 // ===========================================================================
 // MISSION CONFIGURATION STRUCT
 // ===========================================================================
@@ -61,24 +119,78 @@ struct MissionConfig {
     SpacecraftConfig spacecraft;
     
     // Integration parameters
-    std::string integrator = "rk4";      // "rk4" or "euler"
-    double timestep_s = 10000;           // seconds
+    std::string integrator = "rk4";      // "rk4", "euler", "rk45", "dop853" or "averaged"
+    double timestep_s = 10000;           // seconds (initial step for adaptive methods)
+    std::string precision = "double";    // rk4 arithmetic: "double", "float", "double_kahan"
+                                         // or "double_double" (see precision.h)
+    
+    // Error tolerances for adaptive integrators (ignored by rk4/euler)
+    double abs_tol = 1e-6;               // absolute tolerance per state component
+    double rel_tol = 1e-9;               // relative tolerance per state component
+    
+    // Orbit averaging ("averaged" integrator, see AveragedPropagator)
+    double averaging_revolutions = 1;    // averaged step length in orbital periods
+    double averaging_handoff = 0.9;      // switch to rk4 steps within this fraction of coast
+    
+    // Variational equations (rk4 only): also propagate the StateSensitivity
+    bool compute_sensitivity = false;
     
     // Termination condition
     double max_flight_time_s = 7.884e8;  // ~25 years
     double coast_threshold = 0.999;      // coast when apoapsis >= threshold * target_radius
+    std::string coast_check = "every_step";  // "every_step" or "bracketed" (skip provably far checks)
+    
+    // Coast arc after the thrust arc ends (closed-form two-body propagation)
+    std::string coast_mode = "stop";     // "stop", "to_arrival" or "to_epoch"
+    double coast_epoch_s = 0;            // end of the coast arc for "to_epoch" (s)
+    
+    // Event location (see events.h)
+    bool locate_coast = false;           // find the coast onset inside the last step
+    std::vector<EventSpec> events;       // user events: mass_below, radius_crossing
+    
+    // Perturbations beyond solar gravity and thrust (see force_model.h)
+    std::vector<PerturbationSpec> perturbations;
+    double ephemeris_cadence_s = 86400;  // body positions sampled this often, then interpolated
 
     // Thrust direction (prograde/retrograde)
     int thrust_direction = 1;  // +1 for outward, -1 for inward
     
     // Output file
     std::string output_filename = "results/trajectory.csv";
+    int save_interval = 1;               // write every Nth step to the trajectory file
+    std::string output_format = "binary";  // "binary", "csv" or "both" (see trajectory_file.h)
+    bool background_flush = false;       // write CSV rows on a writer thread (see csv_writer.h)
+    bool async_output = false;           // format and write every file on an I/O thread (see async_sink.h)
+    double async_buffer_mb = 4;          // queued-step budget per mission for async_output
+    
+    // Checkpoint and resume (see checkpoint.h); do not change the results
+    long checkpoint_interval = 0;        // write checkpoint_file every N steps (0 = off)
+    std::string checkpoint_file;         // checkpoint path ("" = off)
+    bool resume = false;                 // continue from checkpoint_file if it matches
+    
+    // Trade-study pruning (see pruning.h): stop once this mission cannot
+    // beat the best finished one; shared by the missions of a run, not owned
+    PruningBound* pruning = nullptr;
+    
+    // propagateMissionBatch backend (see gpu_batch_propagator.h): "cpu"
+    // (SoA kernels), "lanes" (one spacecraft at a time) or "gpu"
+    std::string batch_backend = "cpu";
 };
 
 // ===========================================================================
 // PROPAGATOR BASE CLASS
 // ===========================================================================
 
+/// Acceleration added to central gravity and thrust at every stage
+/// (ForceModel in force_model.h)
+class Perturbation {
+public:
+    virtual ~Perturbation() = default;
+    
+    /// Add the perturbing acceleration (km/s²) at position r, time t and mass m to a
+    virtual void addAcceleration(const double r[3], double t, double m, double a[3]) = 0;
+};
+
 class Propagator {
 public:
     virtual ~Propagator() = default;
@@ -86,6 +198,13 @@ public:
     virtual void step(MissionState& state, double dt,
                      double thrust_mN, double isp_s,
                      double mu, double g0, int thrust_direction = 1) = 0;
+    
+    /// Add perturbation's acceleration at every stage (nullptr = none). Used
+    /// by RK4, Euler and the adaptive integrators; not owned.
+    void setPerturbation(Perturbation* model) { perturbation = model; }
+    
+protected:
+    Perturbation* perturbation = nullptr;
 };
 
 // ===========================================================================
@@ -93,18 +212,246 @@ public:
 // ===========================================================================
 
 /// 4th-order Runge-Kutta integrator
-class RK4Propagator : public Propagator {
+class RK4Propagator final : public Propagator {
+public:
+    void step(MissionState& state, double dt,
+             double thrust_mN, double isp_s,
+             double mu, double g0, int thrust_direction = 1) override;
+    
+    /// Same step, also advancing sensitivity through it
+    /// The state update matches step() bit for bit. The sensitivity is the
+    /// exact derivative of this discrete step (its tangent map), built from
+    /// the acceleration partials at the same four stage points, so it
+    /// agrees with finite differences of step() rather than of the ODE.
+    void stepWithSensitivity(MissionState& state, StateSensitivity& sensitivity, double dt,
+                             double thrust_mN, double isp_s,
+                             double mu, double g0, int thrust_direction = 1);
+};
+
+class EulerPropagator final : public Propagator {
+public:
+    void step(MissionState& state, double dt,
+             double thrust_mN, double isp_s,
+             double mu, double g0, int thrust_direction = 1) override;
+};
+
+// ===========================================================================
+// ADAPTIVE (EMBEDDED RUNGE-KUTTA) PROPAGATORS
+// ===========================================================================
+// Embedded pairs compute two solutions of different order from the same
+// stage evaluations. Their difference estimates the local error, which
+// drives the step size so that each step meets
+//
+//   |err_i| <= abs_tol + rel_tol * max(|y_i|, |y_new_i|)
+//
+// in the RMS sense over the 7 state components (r, v, m). Unlike RK4, mass
+// is integrated as part of the state, so thrust acceleration sees the
+// current mass at every stage.
+
+class AdaptivePropagator : public Propagator {
 public:
+    explicit AdaptivePropagator(double abs_tol = 1e-6, double rel_tol = 1e-9)
+        : abs_tol(abs_tol), rel_tol(rel_tol) {}
+    
+    /// Advance exactly dt, using as many error-controlled substeps as needed
+    /// Lets adaptive integrators stand in anywhere a fixed step is expected.
     void step(MissionState& state, double dt,
              double thrust_mN, double isp_s,
              double mu, double g0, int thrust_direction = 1) override;
+    
+    /// Take one accepted error-controlled step
+    ///
+    /// Tries dt_try and shrinks it until the error test passes. The state is
+    /// advanced by the accepted step, which is returned. dt_next receives
+    /// the suggested size of the following step. dt_max (> 0) caps the step,
+    /// e.g. to land exactly on max_flight_time.
+    virtual double adaptiveStep(MissionState& state, double dt_try, double& dt_next,
+                                double thrust_mN, double isp_s,
+                                double mu, double g0, int thrust_direction = 1,
+                                double dt_max = 0) = 0;
+    
+    void setTolerances(double abs_tolerance, double rel_tolerance) {
+        abs_tol = abs_tolerance;
+        rel_tol = rel_tolerance;
+    }
+    
+    long acceptedSteps() const { return accepted; }
+    long rejectedSteps() const { return rejected; }
+    void resetCounters() { accepted = 0; rejected = 0; }
+    void restoreCounters(long accepted_steps, long rejected_steps) {
+        accepted = accepted_steps;
+        rejected = rejected_steps;
+    }
+    
+protected:
+    /// adaptiveStep of the pair Pair, the final class calling it
+    ///
+    /// Pair provides the non-virtual members
+    ///   double attemptStep(y, t, dt, thrust_mN, isp_s, mu, g0,
+    ///                      thrust_direction, y_new)
+    /// (one step of size dt from y = r, v, m at time t; writes the
+    /// high-order solution to y_new and returns the scaled RMS error norm,
+    /// <= 1 meaning acceptable) and int errorOrder() (lower order of the
+    /// pair). Both are bound at compile time, so the retry loop makes no
+    /// indirect call.
+    template <typename Pair>
+    double controlledStep(MissionState& state, double dt_try, double& dt_next,
+                          double thrust_mN, double isp_s,
+                          double mu, double g0, int thrust_direction, double dt_max);
+    
+    /// Weight for the error norm of component i
+    double errorScale(const double y[7], const double y_new[7], int i) const {
+        return abs_tol + rel_tol * std::fmax(std::fabs(y[i]), std::fabs(y_new[i]));
+    }
+    
+    double abs_tol;
+    double rel_tol;
+    long accepted = 0;
+    long rejected = 0;
 };
 
-class EulerPropagator : public Propagator {
+/// Dormand-Prince 5(4) pair (the method behind MATLAB ode45 / scipy RK45)
+class DormandPrince54Propagator final : public AdaptivePropagator {
 public:
+    using AdaptivePropagator::AdaptivePropagator;
+    
+    double adaptiveStep(MissionState& state, double dt_try, double& dt_next,
+                        double thrust_mN, double isp_s,
+                        double mu, double g0, int thrust_direction = 1,
+                        double dt_max = 0) override;
+    
+private:
+    friend class AdaptivePropagator;  // controlledStep calls these directly
+    
+    double attemptStep(const double y[7], double t, double dt,
+                       double thrust_mN, double isp_s,
+                       double mu, double g0, int thrust_direction,
+                       double y_new[7]);
+    int errorOrder() const { return 4; }
+};
+
+/// Dormand-Prince 8(5,3) pair (Hairer's DOP853)
+/// 8th-order solution with a blended 5th/3rd-order error estimate; the
+/// method of choice for tight tolerances on long arcs.
+class DOP853Propagator final : public AdaptivePropagator {
+public:
+    using AdaptivePropagator::AdaptivePropagator;
+    
+    double adaptiveStep(MissionState& state, double dt_try, double& dt_next,
+                        double thrust_mN, double isp_s,
+                        double mu, double g0, int thrust_direction = 1,
+                        double dt_max = 0) override;
+    
+private:
+    friend class AdaptivePropagator;  // controlledStep calls these directly
+    
+    double attemptStep(const double y[7], double t, double dt,
+                       double thrust_mN, double isp_s,
+                       double mu, double g0, int thrust_direction,
+                       double y_new[7]);
+    int errorOrder() const { return 7; }
+};
+
+// ===========================================================================
+// ORBIT-AVERAGED PROPAGATOR
+// ===========================================================================
+// A low-thrust spiral changes its orbit little per revolution, so stepping
+// through every revolution resolves motion that the result does not need.
+// AveragedPropagator integrates the slow modified equinoctial elements
+// (p, f, g, h, k) instead, with their Gauss variational rates averaged over
+// one orbit:
+//
+//   <dx/dt> = (1/T) ∮ dx/dt(L) dL / (dL/dt)
+//
+// The acceleration is the one computeThrustAccel applies, thrust/m along
+// ±v. The orbit integral is a trapezoid rule in the true longitude L, which
+// converges spectrally for this periodic integrand. RK4 on the averaged
+// rates then takes steps of one or more orbital periods. The mean longitude
+// advances at the Keplerian mean motion. Mass flow is constant, so it is
+// integrated exactly. Each step starts from the osculating elements of the
+// incoming state, so the propagator keeps no element state of its own.
+//
+// The coast check compares the osculating apsis with the coast radius.
+// Near that radius, the short-period wobble of the real orbit matters, and
+// so does the exact step of coast onset. So once an averaged step would
+// bring the watched apsis within `handoff` of the coast radius, or the
+// mass below min_mass_kg, the propagator hands off to RK4 steps of
+// rk4_step_s for the rest of the mission. It also hands off if the orbit
+// stops being elliptic.
+
+class AveragedPropagator final : public Propagator {
+public:
+    /// @param rk4_step_s: step after the handoff (s)
+    /// @param revolutions: averaged step length in orbital periods
+    /// @param coast_radius_km: radius watched by the coast check (0 = never
+    ///        hand off on it)
+    /// @param handoff: hand off when the apoapsis reaches handoff * coast
+    ///        radius (outbound) or the periapsis coast radius / handoff
+    ///        (inbound); in (0, 1]
+    /// @param min_mass_kg: fuel cutoff of the mission loop
+    explicit AveragedPropagator(double rk4_step_s = 10000, double revolutions = 1,
+                                double coast_radius_km = 0, double handoff = 0.9,
+                                double min_mass_kg = 100)
+        : rk4_step_s(rk4_step_s), revolutions(revolutions),
+          coast_radius_km(coast_radius_km), handoff(handoff), min_mass_kg(min_mass_kg) {}
+    
+    /// Advance exactly dt: averaged steps of at most dt, RK4 steps of at
+    /// most rk4_step_s after the handoff
     void step(MissionState& state, double dt,
              double thrust_mN, double isp_s,
              double mu, double g0, int thrust_direction = 1) override;
+    
+    /// Take the propagator's own next step: one averaged step of
+    /// `revolutions` periods, or one RK4 step of rk4_step_s once handed
+    /// off; either way at most dt_max (> 0)
+    /// @return time advanced (s)
+    double advance(MissionState& state, double thrust_mN, double isp_s,
+                   double mu, double g0, int thrust_direction, double dt_max);
+    
+    bool handedOff() const { return handed_off; }
+    long averagedSteps() const { return averaged_steps; }
+    
+    /// Back to averaging, for a new mission
+    void reset() {
+        handed_off = false;
+        averaged_steps = 0;
+    }
+    
+    /// Continue from a saved handoff flag and step count (checkpoints)
+    void restore(bool was_handed_off, long averaged_step_count) {
+        handed_off = was_handed_off;
+        averaged_steps = averaged_step_count;
+    }
+    
+private:
+    /// One averaged step of at most dt_max
+    /// @return time advanced, or 0 after handing off (state untouched)
+    double averagedStep(MissionState& state, double thrust_mN, double isp_s,
+                        double mu, double g0, int thrust_direction, double dt_max);
+    
+    RK4Propagator rk4;
+    double rk4_step_s;
+    double revolutions;
+    double coast_radius_km;
+    double handoff;
+    double min_mass_kg;
+    bool handed_off = false;
+    long averaged_steps = 0;
 };
 
+// ===========================================================================
+// INTEGRATOR FACTORY
+// ===========================================================================
+
+/// Create the integrator named by config.integrator
+/// "rk4", "rk45" (alias "dopri5"), "dop853", "averaged"; anything else falls
+/// back to Euler.
+std::unique_ptr<Propagator> createPropagator(const MissionConfig& config);
+
+/// True if the named integrator controls its own step size
+bool isAdaptiveIntegrator(const std::string& name);
+
+/// Human-readable integrator name for console output
+const char* getIntegratorDisplayName(const std::string& name);
+
 #endif // PROPAGATOR_H
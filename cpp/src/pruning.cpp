@@ -0,0 +1,74 @@
+#include <limits>
+#include "pruning.h"
+
+PruningBound::PruningBound(const std::string& metric, bool coasted_only)
+    : metric_name(metric), coasted_only(coasted_only),
+      best(std::numeric_limits<double>::infinity()) {
+    if (metric == "shortest_time") {
+        metric_id = Metric::SHORTEST_TIME;
+    } else if (metric == "lowest_delta_v") {
+        metric_id = Metric::LOWEST_DELTA_V;
+    } else if (metric == "least_fuel") {
+        metric_id = Metric::LEAST_FUEL;
+    } else {
+        metric_id = Metric::MOST_EFFICIENT;
+    }
+}
+
+double PruningBound::score(double t, double total_delta_v, double mass,
+                           double initial_mass) const {
+    // Same arithmetic as missionMetricScore on the MissionResult fields
+    switch (metric_id) {
+        case Metric::SHORTEST_TIME:
+            return t / 86400.0;
+        case Metric::LOWEST_DELTA_V:
+            return total_delta_v;
+        case Metric::LEAST_FUEL:
+            return initial_mass - mass;
+        case Metric::MOST_EFFICIENT:
+        default:
+            return -(mass / initial_mass);
+    }
+}
+
+void PruningBound::offer(double mission_score) {
+    double current = best.load();
+    while (mission_score < current &&
+           !best.compare_exchange_weak(current, mission_score)) {
+    }
+}
+
+void PruningBound::finish(const MissionConfig& config, const PropagationResult& result) {
+    missions++;
+    steps += result.accepted_steps;
+    
+    if (result.pruned) {
+        pruned++;
+        pruned_steps += result.accepted_steps;
+        
+        // Budget left at the mean step so far; it would have coasted or
+        // run out of fuel sooner, so this bounds the saving from above
+        double t = result.final_state.t;
+        if (t > 0 && result.accepted_steps > 0) {
+            double remaining = config.max_flight_time_s - t;
+            steps_skipped += static_cast<long>(remaining * result.accepted_steps / t);
+        }
+        return;
+    }
+    
+    if (coasted_only && result.coast_step < 0) {
+        return;
+    }
+    offer(score(result.final_state.t, result.total_delta_v, result.final_state.m,
+                config.spacecraft.initial_mass_kg));
+}
+
+PruningStats PruningBound::stats() const {
+    PruningStats totals;
+    totals.missions = missions.load();
+    totals.pruned = pruned.load();
+    totals.steps = steps.load();
+    totals.pruned_steps = pruned_steps.load();
+    totals.steps_skipped = steps_skipped.load();
+    return totals;
+}
@@ -0,0 +1,88 @@
+#ifndef PRUNING_H
+#define PRUNING_H
+
+#include <atomic>
+#include <string>
+#include "propagator.h"
+#include "mission_propagation.h"
+
+// ===========================================================================
+// TRADE-STUDY PRUNING (--prune <metric>)
+// ===========================================================================
+// Every findBestMission metric can only get worse while a mission flies:
+// flight time, delta-V and propellant use grow, and the payload fraction
+// falls. So once a mission's running score is above the score of a
+// finished mission, it cannot become the best one. A PruningBound holds
+// the best finished score in an atomic. Missions that point at it through
+// MissionConfig::pruning stop at the first step where they are strictly
+// worse.
+//
+// The bound is only lowered by finished missions, and a mission on a par
+// with the best is never stopped. So the best mission and its result are
+// the same as without pruning, whatever the run order or thread count.
+// Only the missions that were stopped differ: their results are partial
+// (PropagationResult::pruned) and say nothing about their true outcome.
+// The saving depends on order: the sooner a good mission finishes, the
+// more of the others is cut short.
+//
+// The propagation loops check the bound and update it themselves, and
+// both propagateMission and propagateMissionBatch do so. Any number of
+// threads may share one bound.
+// ===========================================================================
+
+/// What pruning saved over one run
+struct PruningStats {
+    long missions = 0;          // Propagations that used the bound
+    long pruned = 0;            // ... of which stopped early
+    long steps = 0;             // Integration steps taken by all of them
+    long pruned_steps = 0;      // ... by the pruned ones
+    long steps_skipped = 0;     // Flight-time budget the pruned ones had left,
+                                // in steps at their own mean step (upper bound)
+};
+
+class PruningBound {
+public:
+    /// metric: a findBestMission metric (see isMissionMetric). With
+    /// coasted_only, only missions that reached coast lower the bound,
+    /// as in a sweep, whose best point must have coasted.
+    explicit PruningBound(const std::string& metric, bool coasted_only = false);
+    
+    const std::string& metric() const { return metric_name; }
+    
+    /// findBestMission score of a mission at this point of its flight
+    /// (lower is better, as in missionMetricScore)
+    double score(double t, double total_delta_v, double mass, double initial_mass) const;
+    
+    /// Whether a mission at score can no longer become the best one
+    bool prunes(double mission_score) const {
+        return mission_score > best.load(std::memory_order_relaxed);
+    }
+    
+    /// Account for a finished propagation; lowers the bound if it is a
+    /// candidate (not pruned, and coasted if coasted_only)
+    void finish(const MissionConfig& config, const PropagationResult& result);
+    
+    /// Account for a mission that finished elsewhere (a result-cache hit)
+    void offer(double mission_score);
+    
+    /// Current bound (+inf until a candidate finished)
+    double bestScore() const { return best.load(); }
+    
+    PruningStats stats() const;
+
+private:
+    enum class Metric { SHORTEST_TIME, LOWEST_DELTA_V, LEAST_FUEL, MOST_EFFICIENT };
+    
+    std::string metric_name;
+    Metric metric_id;
+    bool coasted_only;
+    
+    std::atomic<double> best;
+    std::atomic<long> missions{0};
+    std::atomic<long> pruned{0};
+    std::atomic<long> steps{0};
+    std::atomic<long> pruned_steps{0};
+    std::atomic<long> steps_skipped{0};
+};
+
+#endif // PRUNING_H
@@ -0,0 +1,291 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <thread>
+#include "result_cache.h"
+#include "force_model.h"
+
+namespace {
+
+/// First line of every entry; change when the entry layout changes
+const char* const CACHE_FORMAT = "ltmd-result-cache-1";
+
+/// Exact text form of a double
+std::string exactDouble(double value) {
+    std::ostringstream out;
+    out << std::hexfloat << value;
+    return out.str();
+}
+
+std::string hexKey(std::uint64_t key) {
+    std::ostringstream out;
+    out << std::hex << std::setw(16) << std::setfill('0') << key;
+    return out.str();
+}
+
+void writeState(std::ostream& out, const std::string& prefix, const MissionState& state) {
+    for (int i = 0; i < 3; i++) {
+        out << prefix << ".r" << i << "=" << exactDouble(state.r[i]) << "\n";
+        out << prefix << ".v" << i << "=" << exactDouble(state.v[i]) << "\n";
+    }
+    out << prefix << ".m=" << exactDouble(state.m) << "\n";
+    out << prefix << ".t=" << exactDouble(state.t) << "\n";
+}
+
+/// Field lookup over a parsed entry; ok turns false on the first missing field
+class EntryFields {
+public:
+    explicit EntryFields(const std::map<std::string, std::string>& fields) : fields(fields) {}
+    
+    std::string text(const std::string& name) {
+        auto it = fields.find(name);
+        if (it == fields.end()) {
+            ok = false;
+            return "";
+        }
+        return it->second;
+    }
+    
+    double number(const std::string& name) {
+        std::string value = text(name);
+        return value.empty() ? 0.0 : std::strtod(value.c_str(), nullptr);
+    }
+    
+    long integer(const std::string& name) {
+        std::string value = text(name);
+        return value.empty() ? 0 : std::strtol(value.c_str(), nullptr, 10);
+    }
+    
+    void state(const std::string& prefix, MissionState& state) {
+        for (int i = 0; i < 3; i++) {
+            state.r[i] = number(prefix + ".r" + std::to_string(i));
+            state.v[i] = number(prefix + ".v" + std::to_string(i));
+        }
+        state.m = number(prefix + ".m");
+        state.t = number(prefix + ".t");
+    }
+    
+    bool ok = true;
+
+private:
+    const std::map<std::string, std::string>& fields;
+};
+
+}  // namespace
+
+// ===========================================================================
+// CONFIG HASH
+// ===========================================================================
+
+std::string canonicalMissionConfig(const MissionConfig& config) {
+    // The checkpoint settings only decide where a run can be resumed from,
+    // and background_flush/async_output only which thread writes the files.
+    // compute_sensitivity leaves the results unchanged (entries do not
+    // store the Jacobian, so a hit comes back without it)
+    std::ostringstream out;
+    out << "departure_body=" << static_cast<int>(config.departure_body) << "\n"
+        << "arrival_body=" << static_cast<int>(config.arrival_body) << "\n"
+        << "spacecraft.name=" << config.spacecraft.name << "\n"
+        << "spacecraft.thrust_mN=" << exactDouble(config.spacecraft.thrust_mN) << "\n"
+        << "spacecraft.isp_s=" << exactDouble(config.spacecraft.isp_s) << "\n"
+        << "spacecraft.initial_mass_kg=" << exactDouble(config.spacecraft.initial_mass_kg) << "\n"
+        << "integrator=" << config.integrator << "\n"
+        << "timestep_s=" << exactDouble(config.timestep_s) << "\n"
+        << "abs_tol=" << exactDouble(config.abs_tol) << "\n"
+        << "rel_tol=" << exactDouble(config.rel_tol) << "\n"
+        << "max_flight_time_s=" << exactDouble(config.max_flight_time_s) << "\n"
+        << "coast_threshold=" << exactDouble(config.coast_threshold) << "\n"
+        << "coast_check=" << config.coast_check << "\n"
+        << "coast_mode=" << config.coast_mode << "\n"
+        << "coast_epoch_s=" << exactDouble(config.coast_epoch_s) << "\n"
+        << "locate_coast=" << (config.locate_coast ? 1 : 0) << "\n"
+        << "events=" << config.events.size() << "\n";
+    // Settings added later appear only where they apply, so entries
+    // written before them stay valid
+    if (config.integrator == "averaged") {
+        out << "averaging_revolutions=" << exactDouble(config.averaging_revolutions) << "\n"
+            << "averaging_handoff=" << exactDouble(config.averaging_handoff) << "\n";
+    }
+    if (config.precision != "double") {
+        out << "precision=" << config.precision << "\n";
+    }
+    if (hasPerturbations(config)) {
+        out << "ephemeris_cadence_s=" << exactDouble(config.ephemeris_cadence_s) << "\n";
+        for (const PerturbationSpec& spec : config.perturbations) {
+            if (spec.enabled) {
+                out << "perturbation=" << spec.type << "," << static_cast<int>(spec.body) << ","
+                    << exactDouble(spec.phase_deg) << "," << exactDouble(spec.area_m2) << ","
+                    << exactDouble(spec.reflectivity) << "\n";
+            }
+        }
+    }
+    for (const EventSpec& event : config.events) {
+        out << "event=" << event.type << "," << exactDouble(event.value) << ","
+            << (event.terminal ? 1 : 0) << "\n";
+    }
+    out << "thrust_direction=" << config.thrust_direction << "\n"
+        << "output_filename=" << config.output_filename << "\n"
+        << "save_interval=" << config.save_interval << "\n"
+        << "output_format=" << config.output_format << "\n";
+    return out.str();
+}
+
+std::uint64_t hashMissionConfig(const MissionConfig& config, const std::string& salt) {
+    std::string text = canonicalMissionConfig(config) +
+                       "integrator_version=" + std::to_string(INTEGRATOR_VERSION) + "\n" +
+                       "salt=" + salt + "\n";
+    
+    // FNV-1a, 64 bit
+    std::uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// ===========================================================================
+// RESULT CACHE
+// ===========================================================================
+
+ResultCache::ResultCache(const std::string& directory) : directory(directory) {}
+
+std::string ResultCache::entryPath(std::uint64_t key) const {
+    return directory + "/" + hexKey(key) + ".result";
+}
+
+bool ResultCache::lookup(std::uint64_t key, CachedMission& entry) const {
+    std::ifstream file(entryPath(key));
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    std::map<std::string, std::string> fields;
+    std::string line;
+    while (std::getline(file, line)) {
+        size_t equals = line.find('=');
+        if (equals != std::string::npos) {
+            fields[line.substr(0, equals)] = line.substr(equals + 1);
+        }
+    }
+    
+    EntryFields read(fields);
+    if (read.text("format") != CACHE_FORMAT || read.text("key") != hexKey(key)) {
+        return false;
+    }
+    
+    CachedMission loaded;
+    MissionResult& result = loaded.result;
+    result.thruster_name = read.text("mission.thruster_name");
+    result.departure_body = read.text("mission.departure_body");
+    result.arrival_body = read.text("mission.arrival_body");
+    result.flight_time_days = read.number("mission.flight_time_days");
+    result.total_delta_v_km_s = read.number("mission.total_delta_v_km_s");
+    result.propellant_consumed_kg = read.number("mission.propellant_consumed_kg");
+    result.final_mass_kg = read.number("mission.final_mass_kg");
+    result.initial_mass_kg = read.number("mission.initial_mass_kg");
+    result.final_apoapsis_km = read.number("mission.final_apoapsis_km");
+    result.final_periapsis_km = read.number("mission.final_periapsis_km");
+    result.final_eccentricity = read.number("mission.final_eccentricity");
+    result.final_semi_major_axis_km = read.number("mission.final_semi_major_axis_km");
+    
+    PropagationResult& propagation = loaded.propagation;
+    read.state("propagation.final_state", propagation.final_state);
+    read.state("propagation.coast_state", propagation.coast_state);
+    propagation.total_delta_v = read.number("propagation.total_delta_v");
+    propagation.coast_step = static_cast<int>(read.integer("propagation.coast_step"));
+    propagation.accepted_steps = read.integer("propagation.accepted_steps");
+    propagation.rejected_steps = read.integer("propagation.rejected_steps");
+    propagation.coast_arc_s = read.number("propagation.coast_arc_s");
+    propagation.arrival_reached = read.integer("propagation.arrival_reached") != 0;
+    
+    long events = read.integer("propagation.events");
+    for (long i = 0; i < events && read.ok; i++) {
+        std::string prefix = "event" + std::to_string(i);
+        MissionEvent event;
+        event.type = read.text(prefix + ".type");
+        event.terminal = read.integer(prefix + ".terminal") != 0;
+        read.state(prefix + ".state", event.state);
+        propagation.events.push_back(event);
+    }
+    
+    loaded.trajectory_path = read.text("trajectory_path");
+    if (!read.ok) {
+        return false;
+    }
+    
+    entry = loaded;
+    return true;
+}
+
+bool ResultCache::store(std::uint64_t key, const CachedMission& entry) const {
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    
+    // Unique temporary name per writer thread; rename is atomic on POSIX
+    std::string path = entryPath(key);
+    std::string temp_path = path + ".tmp" +
+                            std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    {
+        std::ofstream file(temp_path);
+        if (!file.is_open()) {
+            std::cerr << "Error: Cannot write cache entry: " << temp_path << "\n";
+            return false;
+        }
+        
+        const MissionResult& result = entry.result;
+        file << "format=" << CACHE_FORMAT << "\n"
+             << "key=" << hexKey(key) << "\n"
+             << "mission.thruster_name=" << result.thruster_name << "\n"
+             << "mission.departure_body=" << result.departure_body << "\n"
+             << "mission.arrival_body=" << result.arrival_body << "\n"
+             << "mission.flight_time_days=" << exactDouble(result.flight_time_days) << "\n"
+             << "mission.total_delta_v_km_s=" << exactDouble(result.total_delta_v_km_s) << "\n"
+             << "mission.propellant_consumed_kg=" << exactDouble(result.propellant_consumed_kg) << "\n"
+             << "mission.final_mass_kg=" << exactDouble(result.final_mass_kg) << "\n"
+             << "mission.initial_mass_kg=" << exactDouble(result.initial_mass_kg) << "\n"
+             << "mission.final_apoapsis_km=" << exactDouble(result.final_apoapsis_km) << "\n"
+             << "mission.final_periapsis_km=" << exactDouble(result.final_periapsis_km) << "\n"
+             << "mission.final_eccentricity=" << exactDouble(result.final_eccentricity) << "\n"
+             << "mission.final_semi_major_axis_km=" << exactDouble(result.final_semi_major_axis_km) << "\n";
+        
+        const PropagationResult& propagation = entry.propagation;
+        writeState(file, "propagation.final_state", propagation.final_state);
+        writeState(file, "propagation.coast_state", propagation.coast_state);
+        file << "propagation.total_delta_v=" << exactDouble(propagation.total_delta_v) << "\n"
+             << "propagation.coast_step=" << propagation.coast_step << "\n"
+             << "propagation.accepted_steps=" << propagation.accepted_steps << "\n"
+             << "propagation.rejected_steps=" << propagation.rejected_steps << "\n"
+             << "propagation.coast_arc_s=" << exactDouble(propagation.coast_arc_s) << "\n"
+             << "propagation.arrival_reached=" << (propagation.arrival_reached ? 1 : 0) << "\n"
+             << "propagation.events=" << propagation.events.size() << "\n";
+        for (size_t i = 0; i < propagation.events.size(); i++) {
+            const MissionEvent& event = propagation.events[i];
+            std::string prefix = "event" + std::to_string(i);
+            file << prefix << ".type=" << event.type << "\n"
+                 << prefix << ".terminal=" << (event.terminal ? 1 : 0) << "\n";
+            writeState(file, prefix + ".state", event.state);
+        }
+        file << "trajectory_path=" << entry.trajectory_path << "\n";
+        
+        if (!file) {
+            std::cerr << "Error: Failed writing cache entry: " << temp_path << "\n";
+            file.close();
+            std::remove(temp_path.c_str());
+            return false;
+        }
+    }
+    
+    if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+        std::cerr << "Error: Cannot move cache entry into place: " << path << "\n";
+        std::remove(temp_path.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,67 @@
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include <cstdint>
+#include <string>
+#include "propagator.h"
+#include "comparison.h"
+#include "mission_propagation.h"
+
+// ===========================================================================
+// MISSION RESULT CACHE
+// ===========================================================================
+// Content-addressed on-disk store of finished missions. The key is a
+// 64-bit FNV-1a hash of a canonical text form of the MissionConfig fields
+// (doubles in hexfloat, so any change in any bit gives a new key), the
+// trajectory output path, and INTEGRATOR_VERSION. One file per key:
+//
+//   <directory>/<16 hex digits>.result
+//
+// Entries are plain key=value text, also with hexfloat doubles, so a
+// cached result reproduces the original MissionResult bit for bit. Writes
+// go to a temporary file that is renamed over the entry, so a reader never
+// sees a partial entry even with parallel batch workers.
+// ===========================================================================
+
+/// Version of the propagation numerics baked into every cache key
+/// Bump whenever integrators, dynamics or termination logic change the
+/// results a given MissionConfig produces; old entries then stop matching.
+constexpr int INTEGRATOR_VERSION = 1;
+
+/// Canonical text form of a config (one "field=value" per line)
+/// Covers every field that can change the results, i.e. all but the
+/// checkpoint settings.
+std::string canonicalMissionConfig(const MissionConfig& config);
+
+/// Cache key of a config (salt: anything else that changes the outputs,
+/// e.g. the trajectory file path)
+std::uint64_t hashMissionConfig(const MissionConfig& config, const std::string& salt = "");
+
+/// One cached mission
+struct CachedMission {
+    MissionResult result;             // Raw outcomes (derived metrics are recomputed)
+    PropagationResult propagation;    // Final state, step counts and events
+    std::string trajectory_path;      // Trajectory file written by the run ("" = none)
+};
+
+class ResultCache {
+public:
+    /// Cache rooted at directory (created on first store)
+    explicit ResultCache(const std::string& directory);
+    
+    /// Read the entry for key
+    /// @return false if there is no valid entry for exactly this key
+    bool lookup(std::uint64_t key, CachedMission& entry) const;
+    
+    /// Write (or replace) the entry for key
+    /// @return false (with a message on std::cerr) if the entry cannot be written
+    bool store(std::uint64_t key, const CachedMission& entry) const;
+    
+    /// File holding the entry for key
+    std::string entryPath(std::uint64_t key) const;
+
+private:
+    std::string directory;
+};
+
+#endif // RESULT_CACHE_H
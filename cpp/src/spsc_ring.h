@@ -0,0 +1,89 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// ===========================================================================
+// SINGLE-PRODUCER / SINGLE-CONSUMER RING BUFFER
+// ===========================================================================
+// Fixed-capacity lock-free queue between exactly one producer thread and
+// one consumer thread. The producer owns head, the consumer owns tail;
+// each publishes its index with a release store and reads the other's
+// with an acquire load, so an element is fully written before the
+// consumer can see it and fully consumed before its slot is reused.
+//
+// The consumer reads an element in place (front) and releases its slot
+// afterwards (pop), so empty() also means the consumer has finished with
+// every element pushed so far.
+// ===========================================================================
+
+template <typename T>
+class SpscRing {
+public:
+    /// Capacity is max_elements rounded down to a power of two (at least 2)
+    explicit SpscRing(std::size_t max_elements) {
+        std::size_t capacity = 2;
+        while (capacity * 2 <= max_elements) {
+            capacity *= 2;
+        }
+        slots.resize(capacity);
+        mask = capacity - 1;
+    }
+    
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+    
+    /// Producer: append value, or return false when the ring is full
+    bool tryPush(const T& value) {
+        std::size_t current = head.load(std::memory_order_relaxed);
+        if (current - cached_tail == slots.size()) {
+            cached_tail = tail.load(std::memory_order_acquire);
+            if (current - cached_tail == slots.size()) {
+                return false;
+            }
+        }
+        slots[current & mask] = value;
+        head.store(current + 1, std::memory_order_release);
+        return true;
+    }
+    
+    /// Consumer: oldest element, or nullptr when the ring is empty
+    T* front() {
+        std::size_t current = tail.load(std::memory_order_relaxed);
+        if (current == cached_head) {
+            cached_head = head.load(std::memory_order_acquire);
+            if (current == cached_head) {
+                return nullptr;
+            }
+        }
+        return &slots[current & mask];
+    }
+    
+    /// Consumer: release the element returned by front()
+    void pop() {
+        tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+    
+    /// Either thread: no element is queued or still being consumed
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+    
+    std::size_t capacity() const { return slots.size(); }
+
+private:
+    std::vector<T> slots;
+    std::size_t mask = 0;
+    
+    // Producer and consumer indices on separate cache lines; each side
+    // keeps a stale copy of the other's index and only reloads it when
+    // the ring looks full (producer) or empty (consumer)
+    alignas(64) std::atomic<std::size_t> head{0};
+    std::size_t cached_tail = 0;
+    alignas(64) std::atomic<std::size_t> tail{0};
+    std::size_t cached_head = 0;
+};
+
+#endif // SPSC_RING_H
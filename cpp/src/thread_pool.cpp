@@ -0,0 +1,173 @@
+#include <iostream>
+#include <exception>
+#include "thread_pool.h"
+
+namespace {
+// Index of the worker running on this thread (-1 for non-pool threads)
+thread_local int tls_worker_index = -1;
+}
+
+// ===========================================================================
+// CONSTRUCTION / SHUTDOWN
+// ===========================================================================
+
+ThreadPool::ThreadPool(unsigned num_threads) {
+    unsigned count = resolveThreadCount(num_threads);
+    
+    queues.reserve(count);
+    for (unsigned i = 0; i < count; ++i) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    
+    workers.reserve(count);
+    for (unsigned i = 0; i < count; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex);
+        stopping = true;
+    }
+    wake_cv.notify_all();
+    
+    for (auto& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+unsigned ThreadPool::resolveThreadCount(unsigned requested) {
+    if (requested == 0) {
+        requested = std::thread::hardware_concurrency();
+    }
+    return requested == 0 ? 1 : requested;
+}
+
+int ThreadPool::currentWorker() {
+    return tls_worker_index;
+}
+
+// ===========================================================================
+// TASK SUBMISSION
+// ===========================================================================
+
+void ThreadPool::submit(std::function<void()> task) {
+    pending.fetch_add(1);
+    
+    // Tasks spawned by a worker stay local; external tasks are dealt out
+    unsigned target;
+    if (tls_worker_index >= 0 && static_cast<unsigned>(tls_worker_index) < queues.size()) {
+        target = static_cast<unsigned>(tls_worker_index);
+    } else {
+        target = next_queue.fetch_add(1) % queues.size();
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(queues[target]->mutex);
+        queues[target]->tasks.push_back(std::move(task));
+    }
+    
+    // Increment under wake_mutex so a worker about to sleep cannot miss it
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex);
+        queued.fetch_add(1);
+    }
+    wake_cv.notify_one();
+}
+
+void ThreadPool::waitIdle() {
+    std::unique_lock<std::mutex> lock(wake_mutex);
+    idle_cv.wait(lock, [this] { return pending.load() == 0; });
+}
+
+void ThreadPool::parallelFor(std::size_t count,
+                             const std::function<void(std::size_t)>& body) {
+    std::exception_ptr first_error;
+    std::mutex error_mutex;
+    
+    for (std::size_t i = 0; i < count; ++i) {
+        submit([&body, &first_error, &error_mutex, i] {
+            try {
+                body(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!first_error) {
+                    first_error = std::current_exception();
+                }
+            }
+        });
+    }
+    
+    waitIdle();
+    
+    if (first_error) {
+        std::rethrow_exception(first_error);
+    }
+}
+
+// ===========================================================================
+// WORKER LOOP
+// ===========================================================================
+
+bool ThreadPool::popOwn(unsigned index, std::function<void()>& task) {
+    WorkerQueue& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    task = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    return true;
+}
+
+bool ThreadPool::steal(unsigned index, std::function<void()>& task) {
+    // Visit the other deques starting with the neighbour, so thieves
+    // spread out instead of all hitting worker 0
+    std::size_t count = queues.size();
+    for (std::size_t offset = 1; offset < count; ++offset) {
+        WorkerQueue& victim = *queues[(index + offset) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(unsigned index) {
+    tls_worker_index = static_cast<int>(index);
+    std::function<void()> task;
+    
+    while (true) {
+        if (popOwn(index, task) || steal(index, task)) {
+            queued.fetch_sub(1);
+            
+            try {
+                task();
+            } catch (const std::exception& e) {
+                std::cerr << "Error: Unhandled exception in worker thread: "
+                          << e.what() << "\n";
+            } catch (...) {
+                std::cerr << "Error: Unhandled exception in worker thread\n";
+            }
+            task = nullptr;
+            
+            if (pending.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lock(wake_mutex);
+                idle_cv.notify_all();
+            }
+            continue;
+        }
+        
+        std::unique_lock<std::mutex> lock(wake_mutex);
+        wake_cv.wait(lock, [this] { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() <= 0) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,85 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ===========================================================================
+// WORK-STEALING THREAD POOL
+// ===========================================================================
+// Fixed set of worker threads, each owning a task deque.
+//
+// - A worker pops tasks from the front of its own deque.
+// - When its deque is empty it steals from the back of another worker's
+//   deque, so a worker stuck on a long Jupiter transfer does not hold up
+//   the short Venus transfers queued behind it.
+// - Tasks submitted from outside the pool are dealt round-robin across
+//   the worker deques; tasks submitted from inside a worker go to that
+//   worker's own deque.
+//
+// Each deque has its own mutex, so there is no pool-wide lock on the
+// task path.
+// ===========================================================================
+
+class ThreadPool {
+public:
+    /// Create a pool with num_threads workers (0 = hardware concurrency)
+    explicit ThreadPool(unsigned num_threads = 0);
+    
+    /// Waits for queued tasks to finish, then joins all workers
+    ~ThreadPool();
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    /// Queue a task for execution
+    void submit(std::function<void()> task);
+    
+    /// Block until every submitted task has finished
+    /// Must not be called from inside a worker thread.
+    void waitIdle();
+    
+    /// Run body(index) for index in [0, count) and wait for completion
+    /// The first exception thrown by any body is rethrown here.
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)>& body);
+    
+    /// Number of worker threads
+    unsigned size() const { return static_cast<unsigned>(workers.size()); }
+    
+    /// Index of the calling worker thread, or -1 outside the pool
+    static int currentWorker();
+    
+    /// Resolve a user-facing job count (0 = hardware concurrency, min 1)
+    static unsigned resolveThreadCount(unsigned requested);
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+    
+    void workerLoop(unsigned index);
+    bool popOwn(unsigned index, std::function<void()>& task);
+    bool steal(unsigned index, std::function<void()>& task);
+    
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+    
+    std::mutex wake_mutex;
+    std::condition_variable wake_cv;   // Workers wait here for new tasks
+    std::condition_variable idle_cv;   // waitIdle() waits here
+    
+    std::atomic<long> queued{0};       // Tasks sitting in a deque
+    std::atomic<long> pending{0};      // Tasks submitted but not finished
+    std::atomic<unsigned> next_queue{0};
+    bool stopping = false;             // Guarded by wake_mutex
+};
+
+#endif // THREAD_POOL_H
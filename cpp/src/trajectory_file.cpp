@@ -0,0 +1,398 @@
+#include <iostream>
+#include <cstring>
+#include <algorithm>
+#include <filesystem>
+#include "trajectory_file.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ===========================================================================
+// COLUMN NAMES AND HEADER HELPERS
+// ===========================================================================
+
+const char* getTrajectoryColumnName(TrajectoryColumn column) {
+    switch (column) {
+        case TrajectoryColumn::TIME:            return "time(s)";
+        case TrajectoryColumn::X:               return "x(km)";
+        case TrajectoryColumn::Y:               return "y(km)";
+        case TrajectoryColumn::Z:               return "z(km)";
+        case TrajectoryColumn::VX:              return "vx(km/s)";
+        case TrajectoryColumn::VY:              return "vy(km/s)";
+        case TrajectoryColumn::VZ:              return "vz(km/s)";
+        case TrajectoryColumn::MASS:            return "m(kg)";
+        case TrajectoryColumn::SEMI_MAJOR_AXIS: return "a(km)";
+        case TrajectoryColumn::ECCENTRICITY:    return "e";
+        case TrajectoryColumn::APOAPSIS:        return "ra(km)";
+        case TrajectoryColumn::PERIAPSIS:       return "rp(km)";
+        case TrajectoryColumn::INCLINATION:     return "i(rad)";
+        case TrajectoryColumn::RAAN:            return "Omega(rad)";
+        case TrajectoryColumn::ARG_PERIAPSIS:   return "omega(rad)";
+        case TrajectoryColumn::TRUE_ANOMALY:    return "nu(rad)";
+        default:                                return "unknown";
+    }
+}
+
+TrajectoryFileHeader makeTrajectoryHeader(const MissionConfig& config, int thrust_direction) {
+    TrajectoryFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    
+    std::memcpy(header.magic, TRAJECTORY_FILE_MAGIC, sizeof(header.magic));
+    header.version = TRAJECTORY_FILE_VERSION;
+    header.header_bytes = static_cast<std::uint32_t>(TRAJECTORY_HEADER_BYTES);
+    
+    header.departure_body = static_cast<std::int32_t>(config.departure_body);
+    header.arrival_body = static_cast<std::int32_t>(config.arrival_body);
+    header.thrust_direction = thrust_direction;
+    header.save_interval = config.save_interval;
+    header.thrust_mN = config.spacecraft.thrust_mN;
+    header.isp_s = config.spacecraft.isp_s;
+    header.initial_mass_kg = config.spacecraft.initial_mass_kg;
+    header.timestep_s = config.timestep_s;
+    header.max_flight_time_s = config.max_flight_time_s;
+    header.coast_threshold = config.coast_threshold;
+    header.mu = MU_SUN;
+    
+    // Strings are truncated to fit and always NUL-terminated
+    std::strncpy(header.integrator, config.integrator.c_str(), sizeof(header.integrator) - 1);
+    std::strncpy(header.spacecraft_name, config.spacecraft.name.c_str(),
+                 sizeof(header.spacecraft_name) - 1);
+    
+    return header;
+}
+
+std::string binaryTrajectoryPath(const std::string& csv_path) {
+    size_t last_slash = csv_path.find_last_of("/\\");
+    size_t last_dot = csv_path.find_last_of('.');
+    if (last_dot != std::string::npos &&
+        (last_slash == std::string::npos || last_dot > last_slash)) {
+        return csv_path.substr(0, last_dot) + ".bin";
+    }
+    return csv_path + ".bin";
+}
+
+// ===========================================================================
+// BINARY WRITER IMPLEMENTATION
+// ===========================================================================
+
+const std::vector<TrajectoryColumn>& BinaryTrajectorySink::columnLayout() {
+    static const std::vector<TrajectoryColumn> layout = {
+        TrajectoryColumn::TIME,
+        TrajectoryColumn::X, TrajectoryColumn::Y, TrajectoryColumn::Z,
+        TrajectoryColumn::VX, TrajectoryColumn::VY, TrajectoryColumn::VZ,
+        TrajectoryColumn::MASS,
+        TrajectoryColumn::SEMI_MAJOR_AXIS, TrajectoryColumn::ECCENTRICITY,
+        TrajectoryColumn::APOAPSIS, TrajectoryColumn::PERIAPSIS
+    };
+    return layout;
+}
+
+BinaryTrajectorySink::BinaryTrajectorySink(const std::string& filename,
+                                           const MissionConfig& config,
+                                           int thrust_direction,
+                                           std::size_t block_rows)
+    : filename(filename),
+      spill_filename(filename + ".part"),
+      header(makeTrajectoryHeader(config, thrust_direction)),
+      block_rows(block_rows == 0 ? 1 : block_rows),
+      num_columns(columnLayout().size()) {
+    
+    header.num_columns = static_cast<std::uint32_t>(num_columns);
+    for (std::size_t c = 0; c < num_columns; c++) {
+        header.columns[c] = static_cast<std::uint8_t>(columnLayout()[c]);
+    }
+    
+    // Fail early if the destination cannot be created
+    std::FILE* probe = std::fopen(filename.c_str(), "wb");
+    if (!probe) {
+        std::cerr << "Error: Cannot open trajectory file: " << filename << "\n";
+        return;
+    }
+    std::fclose(probe);
+    
+    block.resize(num_columns * this->block_rows);
+    open = true;
+}
+
+BinaryTrajectorySink::~BinaryTrajectorySink() {
+    // finish() normally cleans up; this covers propagations that never finished
+    if (spill) {
+        std::fclose(spill);
+        spill = nullptr;
+        std::remove(spill_filename.c_str());
+    }
+}
+
+void BinaryTrajectorySink::record(long, const MissionState& state,
+                                  const OrbitalElements& elements) {
+    const double values[] = {
+        state.t,
+        state.r[0], state.r[1], state.r[2],
+        state.v[0], state.v[1], state.v[2],
+        state.m,
+        elements.a, elements.e, elements.r_a, elements.r_p
+    };
+    
+    for (std::size_t c = 0; c < num_columns; c++) {
+        block[c * block_rows + block_fill] = values[c];
+    }
+    block_fill++;
+    total_rows++;
+    
+    if (block_fill == block_rows) {
+        spillBlock();
+    }
+}
+
+void BinaryTrajectorySink::spillBlock() {
+    if (!spill) {
+        spill = std::fopen(spill_filename.c_str(), "w+b");
+        if (!spill) {
+            std::cerr << "Error: Cannot open trajectory spill file: " << spill_filename << "\n";
+            open = false;
+            return;
+        }
+    }
+    std::fwrite(block.data(), sizeof(double), block.size(), spill);
+    spilled_blocks++;
+    block_fill = 0;
+}
+
+bool BinaryTrajectorySink::writeFinalFile() {
+    std::FILE* out = std::fopen(filename.c_str(), "wb");
+    if (!out) {
+        std::cerr << "Error: Cannot open trajectory file: " << filename << "\n";
+        return false;
+    }
+    
+    header.num_rows = total_rows;
+    std::fwrite(&header, sizeof(header), 1, out);
+    
+    // Transpose: column c = segment c of every spilled block, then of the
+    // partially filled in-memory block
+    std::vector<double> segment(spilled_blocks > 0 ? block_rows : 0);
+    for (std::size_t c = 0; c < num_columns; c++) {
+        for (std::size_t b = 0; b < spilled_blocks; b++) {
+            long offset = static_cast<long>((b * num_columns + c) * block_rows * sizeof(double));
+            std::fseek(spill, offset, SEEK_SET);
+            size_t read = std::fread(segment.data(), sizeof(double), block_rows, spill);
+            std::fwrite(segment.data(), sizeof(double), read, out);
+        }
+        std::fwrite(&block[c * block_rows], sizeof(double), block_fill, out);
+    }
+    
+    std::fclose(out);
+    return true;
+}
+
+void BinaryTrajectorySink::finish(long, const MissionState&, const OrbitalElements&) {
+    if (!open) {
+        return;
+    }
+    
+    writeFinalFile();
+    
+    if (spill) {
+        std::fclose(spill);
+        spill = nullptr;
+        std::remove(spill_filename.c_str());
+    }
+    open = false;
+}
+
+bool BinaryTrajectorySink::saveCheckpoint(SinkCheckpoint& checkpoint) {
+    if (!open || (spill && std::fflush(spill) != 0)) {
+        return false;
+    }
+    checkpoint.put(static_cast<std::uint64_t>(block_rows));
+    checkpoint.put(static_cast<std::uint64_t>(spilled_blocks));
+    checkpoint.put(static_cast<std::uint64_t>(block_fill));
+    checkpoint.put(total_rows);
+    for (std::size_t c = 0; c < num_columns; c++) {
+        for (std::size_t row = 0; row < block_fill; row++) {
+            checkpoint.put(block[c * block_rows + row]);
+        }
+    }
+    return true;
+}
+
+bool BinaryTrajectorySink::restoreCheckpoint(SinkCheckpoint& checkpoint) {
+    // Any failure closes the sink; the resumed run then writes no trajectory
+    std::uint64_t saved_block_rows = 0, saved_spilled = 0, saved_fill = 0, saved_rows = 0;
+    if (!open || !checkpoint.get(saved_block_rows) || !checkpoint.get(saved_spilled) ||
+        !checkpoint.get(saved_fill) || !checkpoint.get(saved_rows) ||
+        saved_block_rows != block_rows || saved_fill >= block_rows) {
+        open = false;
+        return false;
+    }
+    for (std::size_t c = 0; c < num_columns; c++) {
+        for (std::size_t row = 0; row < saved_fill; row++) {
+            if (!checkpoint.get(block[c * block_rows + row])) {
+                open = false;
+                return false;
+            }
+        }
+    }
+    
+    // Keep the spilled blocks, dropping any written after the checkpoint
+    if (spill) {
+        std::fclose(spill);
+        spill = nullptr;
+    }
+    std::error_code ec;
+    std::uintmax_t spilled_bytes = saved_spilled * num_columns * block_rows * sizeof(double);
+    if (saved_spilled > 0) {
+        std::uintmax_t size = std::filesystem::file_size(spill_filename, ec);
+        if (ec || size < spilled_bytes) {
+            std::cerr << "Error: Trajectory spill file is shorter than its checkpoint: "
+                      << spill_filename << "\n";
+            open = false;
+            return false;
+        }
+        std::filesystem::resize_file(spill_filename, spilled_bytes, ec);
+        spill = ec ? nullptr : std::fopen(spill_filename.c_str(), "r+b");
+        if (!spill) {
+            std::cerr << "Error: Cannot reopen trajectory spill file: " << spill_filename << "\n";
+            open = false;
+            return false;
+        }
+        std::fseek(spill, 0, SEEK_END);
+    } else {
+        std::filesystem::remove(spill_filename, ec);
+    }
+    
+    spilled_blocks = static_cast<std::size_t>(saved_spilled);
+    block_fill = static_cast<std::size_t>(saved_fill);
+    total_rows = saved_rows;
+    return true;
+}
+
+bool writeTrajectoryFile(const std::string& filename, TrajectoryFileHeader header,
+                         const std::vector<TrajectoryColumn>& ids,
+                         const std::vector<const double*>& columns, std::uint64_t rows) {
+    if (ids.size() != columns.size() || ids.size() > TRAJECTORY_MAX_COLUMNS) {
+        std::cerr << "Error: Invalid column layout for trajectory file: " << filename << "\n";
+        return false;
+    }
+    
+    header.num_rows = rows;
+    header.num_columns = static_cast<std::uint32_t>(ids.size());
+    std::memset(header.columns, 0, sizeof(header.columns));
+    for (std::size_t c = 0; c < ids.size(); c++) {
+        header.columns[c] = static_cast<std::uint8_t>(ids[c]);
+    }
+    
+    std::string part_filename = filename + ".part";
+    std::FILE* out = std::fopen(part_filename.c_str(), "wb");
+    if (!out) {
+        std::cerr << "Error: Cannot open trajectory file: " << part_filename << "\n";
+        return false;
+    }
+    bool written = std::fwrite(&header, sizeof(header), 1, out) == 1;
+    for (const double* column : columns) {
+        written = written && std::fwrite(column, sizeof(double), rows, out) == rows;
+    }
+    written = (std::fclose(out) == 0) && written;
+    
+    std::error_code ec;
+    if (written) {
+        std::filesystem::rename(part_filename, filename, ec);
+    }
+    if (!written || ec) {
+        std::cerr << "Error: Cannot write trajectory file: " << filename << "\n";
+        std::filesystem::remove(part_filename, ec);
+        return false;
+    }
+    return true;
+}
+
+// ===========================================================================
+// MEMORY-MAPPED READER IMPLEMENTATION
+// ===========================================================================
+
+MappedTrajectory::~MappedTrajectory() {
+    close();
+}
+
+bool MappedTrajectory::open(const std::string& filename) {
+    close();
+
+#ifdef _WIN32
+    std::cerr << "Error: Memory-mapped trajectories are not supported on this platform\n";
+    (void)filename;
+    return false;
+#else
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Error: Cannot open trajectory file: " << filename << "\n";
+        return false;
+    }
+    
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < TRAJECTORY_HEADER_BYTES) {
+        std::cerr << "Error: Trajectory file too small: " << filename << "\n";
+        ::close(fd);
+        return false;
+    }
+    
+    std::size_t file_size = static_cast<std::size_t>(info.st_size);
+    void* mapping = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);  // The mapping keeps the file alive
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Error: Cannot map trajectory file: " << filename << "\n";
+        return false;
+    }
+    
+    data = static_cast<const unsigned char*>(mapping);
+    size = file_size;
+    
+    // Validate header and size before handing out pointers
+    const TrajectoryFileHeader& hdr = header();
+    bool valid = std::memcmp(hdr.magic, TRAJECTORY_FILE_MAGIC, sizeof(hdr.magic)) == 0 &&
+                 hdr.version == TRAJECTORY_FILE_VERSION &&
+                 hdr.header_bytes >= TRAJECTORY_HEADER_BYTES &&
+                 hdr.num_columns <= static_cast<std::uint32_t>(TRAJECTORY_MAX_COLUMNS) &&
+                 hdr.header_bytes + hdr.num_rows * hdr.num_columns * sizeof(double) <= size;
+    if (!valid) {
+        std::cerr << "Error: Not a valid trajectory file: " << filename << "\n";
+        close();
+        return false;
+    }
+    
+    return true;
+#endif
+}
+
+void MappedTrajectory::close() {
+#ifndef _WIN32
+    if (data) {
+        munmap(const_cast<unsigned char*>(data), size);
+    }
+#endif
+    data = nullptr;
+    size = 0;
+}
+
+const double* MappedTrajectory::columnAt(std::uint32_t index) const {
+    if (!data || index >= columns()) {
+        return nullptr;
+    }
+    const unsigned char* base = data + header().header_bytes;
+    return reinterpret_cast<const double*>(base + index * rows() * sizeof(double));
+}
+
+const double* MappedTrajectory::column(TrajectoryColumn id) const {
+    if (!data) {
+        return nullptr;
+    }
+    for (std::uint32_t c = 0; c < columns(); c++) {
+        if (columnId(c) == id) {
+            return columnAt(c);
+        }
+    }
+    return nullptr;
+}
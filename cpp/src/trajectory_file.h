@@ -0,0 +1,197 @@
+#ifndef TRAJECTORY_FILE_H
+#define TRAJECTORY_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "propagator.h"
+#include "trajectory_sink.h"
+
+// ===========================================================================
+// BINARY COLUMNAR TRAJECTORY FORMAT (.bin)
+// ===========================================================================
+// Layout (little-endian):
+//
+//   [ 512-byte TrajectoryFileHeader ]
+//   [ column 0: num_rows doubles ]
+//   [ column 1: num_rows doubles ]
+//   ...
+//
+// Each column is contiguous, so a memory-mapped file gives zero-copy
+// arrays (SoA) for every quantity. The header records which quantity each
+// column holds (TrajectoryColumn ids) and the mission configuration that
+// produced the file.
+//
+// Python: scripts/trajectory_io.py maps the columns with numpy.memmap.
+// ===========================================================================
+
+constexpr char TRAJECTORY_FILE_MAGIC[8] = {'L', 'T', 'M', 'D', 'T', 'R', 'J', '1'};
+constexpr std::uint32_t TRAJECTORY_FILE_VERSION = 1;
+constexpr std::size_t TRAJECTORY_HEADER_BYTES = 512;
+constexpr int TRAJECTORY_MAX_COLUMNS = 32;
+
+/// Quantity stored in a column (stable ids - never renumber)
+enum class TrajectoryColumn : std::uint8_t {
+    TIME = 0,             // s
+    X = 1,                // km
+    Y = 2,
+    Z = 3,
+    VX = 4,               // km/s
+    VY = 5,
+    VZ = 6,
+    MASS = 7,             // kg
+    SEMI_MAJOR_AXIS = 8,  // km
+    ECCENTRICITY = 9,
+    APOAPSIS = 10,        // km
+    PERIAPSIS = 11,       // km
+    INCLINATION = 12,     // rad
+    RAAN = 13,            // rad
+    ARG_PERIAPSIS = 14,   // rad
+    TRUE_ANOMALY = 15     // rad
+};
+
+/// Column name, matching the CSV header where the CSV has that column
+const char* getTrajectoryColumnName(TrajectoryColumn column);
+
+struct TrajectoryFileHeader {
+    char magic[8];                   // TRAJECTORY_FILE_MAGIC
+    std::uint32_t version;           // TRAJECTORY_FILE_VERSION
+    std::uint32_t header_bytes;      // Offset of column 0
+    std::uint64_t num_rows;
+    std::uint32_t num_columns;
+    
+    // Mission configuration
+    std::int32_t departure_body;     // CelestialBody
+    std::int32_t arrival_body;       // CelestialBody
+    std::int32_t thrust_direction;
+    std::int32_t save_interval;
+    std::uint32_t reserved0;
+    double thrust_mN;
+    double isp_s;
+    double initial_mass_kg;
+    double timestep_s;
+    double max_flight_time_s;
+    double coast_threshold;
+    double mu;
+    char integrator[16];
+    char spacecraft_name[64];
+    
+    std::uint8_t columns[TRAJECTORY_MAX_COLUMNS];  // TrajectoryColumn per column
+    std::uint8_t padding[296];
+};
+
+static_assert(sizeof(TrajectoryFileHeader) == TRAJECTORY_HEADER_BYTES,
+              "TrajectoryFileHeader must stay 512 bytes");
+
+/// Header pre-filled with magic, version and the mission configuration
+/// thrust_direction is that of the transfer: +1 outbound, -1 inbound.
+TrajectoryFileHeader makeTrajectoryHeader(const MissionConfig& config, int thrust_direction);
+
+/// Binary file path for a trajectory CSV path (extension replaced by .bin)
+std::string binaryTrajectoryPath(const std::string& csv_path);
+
+// ===========================================================================
+// BINARY WRITER (TRAJECTORY SINK)
+// ===========================================================================
+// Buffers block_rows rows at a time, so memory stays bounded. Full blocks
+// are spilled to "<filename>.part"; finish() writes the header and
+// transposes the blocks into contiguous columns, then removes the spill
+// file. Trajectories that fit in one block never touch the spill file.
+// A checkpoint flushes the spill file and saves the partial block, so a
+// resumed run keeps the blocks already spilled.
+
+class BinaryTrajectorySink : public TrajectorySink {
+public:
+    BinaryTrajectorySink(const std::string& filename, const MissionConfig& config,
+                         int thrust_direction, std::size_t block_rows = 8192);
+    ~BinaryTrajectorySink() override;
+    
+    BinaryTrajectorySink(const BinaryTrajectorySink&) = delete;
+    BinaryTrajectorySink& operator=(const BinaryTrajectorySink&) = delete;
+    
+    bool isOpen() const { return open; }
+    
+    bool wantsStep(long) const override { return open; }
+    void record(long step, const MissionState& state,
+                const OrbitalElements& elements) override;
+    void finish(long step, const MissionState& final_state,
+                const OrbitalElements& elements) override;
+    bool saveCheckpoint(SinkCheckpoint& checkpoint) override;
+    bool restoreCheckpoint(SinkCheckpoint& checkpoint) override;
+    
+    /// Rows recorded so far
+    std::uint64_t rowsWritten() const { return total_rows; }
+    
+    /// Columns written by this sink, in file order
+    static const std::vector<TrajectoryColumn>& columnLayout();
+
+private:
+    void spillBlock();
+    bool writeFinalFile();
+    
+    std::string filename;
+    std::string spill_filename;
+    TrajectoryFileHeader header;
+    std::size_t block_rows;
+    std::size_t num_columns;
+    std::vector<double> block;       // Column-major: block[col * block_rows + row]
+    std::size_t block_fill = 0;
+    std::size_t spilled_blocks = 0;
+    std::uint64_t total_rows = 0;
+    std::FILE* spill = nullptr;
+    bool open = false;
+};
+
+/// Write a complete file in one pass: header, then rows doubles from each
+/// of columns (whose quantities are ids). The header's row and column
+/// fields are filled in here. The file is written as "<filename>.part" and
+/// renamed into place, so filename may be a trajectory that is currently
+/// mapped for reading.
+/// @return false (with a message on std::cerr) if the file cannot be written
+bool writeTrajectoryFile(const std::string& filename, TrajectoryFileHeader header,
+                         const std::vector<TrajectoryColumn>& ids,
+                         const std::vector<const double*>& columns, std::uint64_t rows);
+
+// ===========================================================================
+// MEMORY-MAPPED READER
+// ===========================================================================
+
+class MappedTrajectory {
+public:
+    MappedTrajectory() = default;
+    ~MappedTrajectory();
+    
+    MappedTrajectory(const MappedTrajectory&) = delete;
+    MappedTrajectory& operator=(const MappedTrajectory&) = delete;
+    
+    /// Map a trajectory file read-only; returns false (and reports on
+    /// std::cerr) if the file is missing or not a valid trajectory file
+    bool open(const std::string& filename);
+    void close();
+    bool isOpen() const { return data != nullptr; }
+    
+    const TrajectoryFileHeader& header() const {
+        return *reinterpret_cast<const TrajectoryFileHeader*>(data);
+    }
+    std::uint64_t rows() const { return header().num_rows; }
+    std::uint32_t columns() const { return header().num_columns; }
+    
+    /// Id of the quantity stored in column index
+    TrajectoryColumn columnId(std::uint32_t index) const {
+        return static_cast<TrajectoryColumn>(header().columns[index]);
+    }
+    
+    /// Zero-copy view of column index (rows() doubles)
+    const double* columnAt(std::uint32_t index) const;
+    
+    /// Zero-copy view of a quantity, or nullptr if the file lacks it
+    const double* column(TrajectoryColumn id) const;
+
+private:
+    const unsigned char* data = nullptr;
+    std::size_t size = 0;
+};
+
+#endif // TRAJECTORY_FILE_H
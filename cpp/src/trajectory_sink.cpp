@@ -0,0 +1,171 @@
+#include <iostream>
+#include <filesystem>
+#include "trajectory_sink.h"
+
+// ===========================================================================
+// DECIMATING SINK IMPLEMENTATION
+// ===========================================================================
+
+DecimatingTrajectorySink::DecimatingTrajectorySink(TrajectorySink& downstream, long interval)
+    : downstream(downstream), interval(interval < 1 ? 1 : interval) {}
+
+bool DecimatingTrajectorySink::wantsStep(long step) const {
+    return (step % interval == 0) && downstream.wantsStep(step);
+}
+
+void DecimatingTrajectorySink::record(long step, const MissionState& state,
+                                      const OrbitalElements& elements) {
+    downstream.record(step, state, elements);
+    last_forwarded = step;
+}
+
+void DecimatingTrajectorySink::finish(long step, const MissionState& final_state,
+                                      const OrbitalElements& elements) {
+    // Always end the decimated output on the final state
+    if (last_forwarded != step && downstream.wantsStep(step)) {
+        downstream.record(step, final_state, elements);
+        last_forwarded = step;
+    }
+    downstream.finish(step, final_state, elements);
+}
+
+bool DecimatingTrajectorySink::saveCheckpoint(SinkCheckpoint& checkpoint) {
+    checkpoint.put(last_forwarded);
+    return downstream.saveCheckpoint(checkpoint);
+}
+
+bool DecimatingTrajectorySink::restoreCheckpoint(SinkCheckpoint& checkpoint) {
+    return checkpoint.get(last_forwarded) && downstream.restoreCheckpoint(checkpoint);
+}
+
+// ===========================================================================
+// RING BUFFER SINK IMPLEMENTATION
+// ===========================================================================
+
+RingBufferTrajectorySink::RingBufferTrajectorySink(std::size_t capacity)
+    : buffer(capacity == 0 ? 1 : capacity) {}
+
+void RingBufferTrajectorySink::record(long step, const MissionState& state,
+                                      const OrbitalElements& elements) {
+    buffer[head] = TrajectorySample(step, state, elements);
+    head = (head + 1) % buffer.size();
+    if (count < buffer.size()) {
+        count++;
+    }
+    total++;
+}
+
+std::vector<TrajectorySample> RingBufferTrajectorySink::samples() const {
+    std::vector<TrajectorySample> ordered;
+    ordered.reserve(count);
+    
+    // Oldest sample sits at head once the buffer has wrapped
+    std::size_t start = (count < buffer.size()) ? 0 : head;
+    for (std::size_t i = 0; i < count; ++i) {
+        ordered.push_back(buffer[(start + i) % buffer.size()]);
+    }
+    return ordered;
+}
+
+// ===========================================================================
+// TEE SINK IMPLEMENTATION
+// ===========================================================================
+
+bool TeeTrajectorySink::wantsStep(long step) const {
+    return first.wantsStep(step) || second.wantsStep(step);
+}
+
+void TeeTrajectorySink::record(long step, const MissionState& state,
+                               const OrbitalElements& elements) {
+    if (first.wantsStep(step)) {
+        first.record(step, state, elements);
+    }
+    if (second.wantsStep(step)) {
+        second.record(step, state, elements);
+    }
+}
+
+void TeeTrajectorySink::finish(long step, const MissionState& final_state,
+                               const OrbitalElements& elements) {
+    first.finish(step, final_state, elements);
+    second.finish(step, final_state, elements);
+}
+
+bool TeeTrajectorySink::saveCheckpoint(SinkCheckpoint& checkpoint) {
+    return first.saveCheckpoint(checkpoint) && second.saveCheckpoint(checkpoint);
+}
+
+bool TeeTrajectorySink::restoreCheckpoint(SinkCheckpoint& checkpoint) {
+    return first.restoreCheckpoint(checkpoint) && second.restoreCheckpoint(checkpoint);
+}
+
+// ===========================================================================
+// STREAMING CSV SINK IMPLEMENTATION
+// ===========================================================================
+
+CsvTrajectorySink::CsvTrajectorySink(const std::string& filename, SinkOpenMode mode,
+                                     bool background_flush)
+    : filename(filename), file(CsvWriter::DEFAULT_BUFFER_BYTES, background_flush) {
+    if (mode == SinkOpenMode::RESUME) {
+        // Header and earlier rows are already in the file
+        file.open(filename, CsvOpenMode::APPEND);
+        return;
+    }
+    
+    if (file.open(filename)) {
+        file.write("time(s),x(km),y(km),vx(km/s),vy(km/s),r(km),v(km/s),m(kg),"
+                   "ra(km),rp(km),e,a(km)\n");
+    }
+}
+
+void CsvTrajectorySink::record(long, const MissionState& state,
+                               const OrbitalElements& elements) {
+    file.scientific(state.t, 6);
+    file.scientific(state.r[0], 6);   // x
+    file.scientific(state.r[1], 6);   // y
+    file.scientific(state.v[0], 6);   // vx
+    file.scientific(state.v[1], 6);   // vy
+    file.scientific(state.radius(), 6);
+    file.scientific(state.speed(), 6);
+    file.fixed(state.m, 2);
+    file.scientific(elements.r_a, 3);
+    file.scientific(elements.r_p, 3);
+    file.fixed(elements.e, 6);
+    file.scientific(elements.a, 3);
+    file.endRow();
+}
+
+void CsvTrajectorySink::finish(long, const MissionState&, const OrbitalElements&) {
+    file.close();
+}
+
+bool CsvTrajectorySink::saveCheckpoint(SinkCheckpoint& checkpoint) {
+    if (!file.isOpen() || !file.flush()) {
+        return false;
+    }
+    std::int64_t offset = file.position();
+    checkpoint.put(offset);
+    return offset >= 0;
+}
+
+bool CsvTrajectorySink::restoreCheckpoint(SinkCheckpoint& checkpoint) {
+    std::int64_t offset = -1;
+    if (!file.isOpen() || !checkpoint.get(offset) || offset < 0) {
+        return false;
+    }
+    
+    // Drop rows written after the checkpoint, then append from there
+    file.close();
+    std::error_code ec;
+    std::uintmax_t size = std::filesystem::file_size(filename, ec);
+    if (ec || size < static_cast<std::uintmax_t>(offset)) {
+        std::cerr << "Error: Trajectory file is shorter than its checkpoint: " << filename << "\n";
+        return false;
+    }
+    std::filesystem::resize_file(filename, static_cast<std::uintmax_t>(offset), ec);
+    if (ec) {
+        std::cerr << "Error: Cannot truncate trajectory file: " << filename << "\n";
+        return false;
+    }
+    return file.open(filename, CsvOpenMode::APPEND) && file.position() == offset;
+}
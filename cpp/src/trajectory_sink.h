@@ -0,0 +1,230 @@
+#ifndef TRAJECTORY_SINK_H
+#define TRAJECTORY_SINK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "propagator.h"
+#include "orbital_elements.h"
+#include "csv_writer.h"
+
+// ===========================================================================
+// TRAJECTORY SINKS
+// ===========================================================================
+// The propagation loop hands every step to a TrajectorySink instead of
+// storing it. Sinks decide what (if anything) to keep, so memory use is
+// bounded by the sink, not by the number of steps:
+//
+//   NullTrajectorySink        - discard everything (batch metrics only)
+//   DecimatingTrajectorySink  - forward every Nth step (output.save_interval)
+//   RingBufferTrajectorySink  - keep the last N steps in memory
+//   CsvTrajectorySink         - stream rows straight to a CSV file
+//   TeeTrajectorySink         - fan one stream out to two sinks
+//   BinaryTrajectorySink      - columnar .bin file (trajectory_file.h)
+//
+// Sinks can be chained, e.g. Decimating -> Tee -> (Binary, Csv).
+//
+// File sinks can also save their position into a propagation checkpoint
+// (checkpoint.h) and later continue from it, so a resumed run writes the
+// same bytes as an uninterrupted one.
+// ===========================================================================
+
+/// One recorded trajectory point
+struct TrajectorySample {
+    long step;
+    MissionState state;
+    OrbitalElements elements;
+    
+    TrajectorySample() : step(0) {}
+    TrajectorySample(long step, const MissionState& state, const OrbitalElements& elements)
+        : step(step), state(state), elements(elements) {}
+};
+
+/// Sink position saved in a propagation checkpoint
+/// Chained sinks append their own fields and then their downstream's, and
+/// read them back in the same order.
+struct SinkCheckpoint {
+    std::vector<unsigned char> bytes;
+    std::size_t read_offset = 0;
+    
+    template <typename T>
+    void put(const T& value) {
+        const unsigned char* data = reinterpret_cast<const unsigned char*>(&value);
+        bytes.insert(bytes.end(), data, data + sizeof(T));
+    }
+    
+    /// @return false if the saved position is too short
+    template <typename T>
+    bool get(T& value) {
+        if (read_offset + sizeof(T) > bytes.size()) {
+            return false;
+        }
+        std::memcpy(&value, bytes.data() + read_offset, sizeof(T));
+        read_offset += sizeof(T);
+        return true;
+    }
+};
+
+/// How file sinks open an existing output
+enum class SinkOpenMode {
+    CREATE,   // Start a new file
+    RESUME    // Keep the file for restoreCheckpoint()
+};
+
+class TrajectorySink {
+public:
+    virtual ~TrajectorySink() = default;
+    
+    /// Whether record() should be called for this step
+    /// Lets the propagator skip work for steps nobody will look at.
+    virtual bool wantsStep(long step) const { (void)step; return true; }
+    
+    /// Receive one propagation step
+    virtual void record(long step, const MissionState& state,
+                        const OrbitalElements& elements) = 0;
+    
+    /// Called once when propagation ends, with the final state
+    /// The final step has already been offered through wantsStep/record.
+    virtual void finish(long step, const MissionState& final_state,
+                        const OrbitalElements& elements) {
+        (void)step; (void)final_state; (void)elements;
+    }
+    
+    /// Flush recorded steps and append the position reached to checkpoint
+    /// @return false if this sink cannot be resumed (the default), which
+    ///         turns checkpointing off for the propagation
+    virtual bool saveCheckpoint(SinkCheckpoint& checkpoint) {
+        (void)checkpoint;
+        return false;
+    }
+    
+    /// Continue from a position saved by saveCheckpoint
+    /// Anything recorded after that position is discarded.
+    virtual bool restoreCheckpoint(SinkCheckpoint& checkpoint) {
+        (void)checkpoint;
+        return false;
+    }
+};
+
+// ===========================================================================
+// NULL SINK
+// ===========================================================================
+
+class NullTrajectorySink : public TrajectorySink {
+public:
+    bool wantsStep(long) const override { return false; }
+    void record(long, const MissionState&, const OrbitalElements&) override {}
+    bool saveCheckpoint(SinkCheckpoint&) override { return true; }
+    bool restoreCheckpoint(SinkCheckpoint&) override { return true; }
+};
+
+// ===========================================================================
+// DECIMATING SINK
+// ===========================================================================
+
+/// Forwards every interval-th step to a downstream sink
+/// The final state is always forwarded, so the last row of the output is
+/// the state at coast/termination regardless of the interval.
+class DecimatingTrajectorySink : public TrajectorySink {
+public:
+    DecimatingTrajectorySink(TrajectorySink& downstream, long interval);
+    
+    bool wantsStep(long step) const override;
+    void record(long step, const MissionState& state,
+                const OrbitalElements& elements) override;
+    void finish(long step, const MissionState& final_state,
+                const OrbitalElements& elements) override;
+    bool saveCheckpoint(SinkCheckpoint& checkpoint) override;
+    bool restoreCheckpoint(SinkCheckpoint& checkpoint) override;
+
+private:
+    TrajectorySink& downstream;
+    long interval;
+    long last_forwarded = -1;
+};
+
+// ===========================================================================
+// RING BUFFER SINK
+// ===========================================================================
+
+/// Keeps the most recent capacity samples in a fixed-size buffer
+class RingBufferTrajectorySink : public TrajectorySink {
+public:
+    explicit RingBufferTrajectorySink(std::size_t capacity);
+    
+    void record(long step, const MissionState& state,
+                const OrbitalElements& elements) override;
+    
+    /// Number of samples currently held (<= capacity)
+    std::size_t size() const { return count; }
+    std::size_t capacity() const { return buffer.size(); }
+    
+    /// Total samples seen, including those already overwritten
+    long totalRecorded() const { return total; }
+    
+    /// Held samples in chronological order (oldest first)
+    std::vector<TrajectorySample> samples() const;
+
+private:
+    std::vector<TrajectorySample> buffer;
+    std::size_t head = 0;   // Next slot to overwrite
+    std::size_t count = 0;
+    long total = 0;
+};
+
+// ===========================================================================
+// TEE SINK
+// ===========================================================================
+
+/// Forwards each step to both sinks (each still filters via wantsStep)
+class TeeTrajectorySink : public TrajectorySink {
+public:
+    TeeTrajectorySink(TrajectorySink& first, TrajectorySink& second)
+        : first(first), second(second) {}
+    
+    bool wantsStep(long step) const override;
+    void record(long step, const MissionState& state,
+                const OrbitalElements& elements) override;
+    void finish(long step, const MissionState& final_state,
+                const OrbitalElements& elements) override;
+    bool saveCheckpoint(SinkCheckpoint& checkpoint) override;
+    bool restoreCheckpoint(SinkCheckpoint& checkpoint) override;
+
+private:
+    TrajectorySink& first;
+    TrajectorySink& second;
+};
+
+// ===========================================================================
+// STREAMING CSV SINK
+// ===========================================================================
+
+/// Streams each step to a CSV file with the standard trajectory columns:
+/// time(s),x(km),y(km),vx(km/s),vy(km/s),r(km),v(km/s),m(kg),ra(km),rp(km),e,a(km)
+class CsvTrajectorySink : public TrajectorySink {
+public:
+    /// SinkOpenMode::RESUME opens an existing file without truncating it;
+    /// restoreCheckpoint() then cuts it back to the saved position.
+    /// background_flush moves the file writes to a writer thread (see csv_writer.h).
+    explicit CsvTrajectorySink(const std::string& filename,
+                               SinkOpenMode mode = SinkOpenMode::CREATE,
+                               bool background_flush = false);
+    
+    bool isOpen() const { return file.isOpen(); }
+    
+    bool wantsStep(long) const override { return file.isOpen(); }
+    void record(long step, const MissionState& state,
+                const OrbitalElements& elements) override;
+    void finish(long step, const MissionState& final_state,
+                const OrbitalElements& elements) override;
+    bool saveCheckpoint(SinkCheckpoint& checkpoint) override;
+    bool restoreCheckpoint(SinkCheckpoint& checkpoint) override;
+
+private:
+    std::string filename;
+    CsvWriter file;
+};
+
+#endif // TRAJECTORY_SINK_H
@@ -0,0 +1,189 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "../src/constants.h"
+#include "../src/propagator.h"
+#include "../src/mission_propagation.h"
+#include "../src/trajectory_sink.h"
+#include "test_mission_config.h"
+
+// ===========================================================================
+// ALLOCATION COUNTING
+// ===========================================================================
+
+static std::atomic<long> g_allocations{0};
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+// ===========================================================================
+// TEST FRAMEWORK HELPERS
+// ===========================================================================
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+void check(bool condition, const std::string& test_name) {
+    if (condition) {
+        std::cout << "  ✓ PASS: " << test_name << "\n";
+        tests_passed++;
+    } else {
+        std::cout << "  ✗ FAIL: " << test_name << "\n";
+        tests_failed++;
+    }
+}
+
+/// Heap allocations made by one propagateMission call
+long count_allocations(const MissionConfig& config, TrajectorySink& sink,
+                       PropagationResult& result) {
+    double r_dep = getOrbitalRadius(CelestialBody::EARTH);
+    double r_arr = getOrbitalRadius(CelestialBody::MARS);
+    
+    long before = g_allocations.load();
+    result = propagateMission(config, r_dep, r_arr, sink);
+    return g_allocations.load() - before;
+}
+
+// ===========================================================================
+// ALLOCATION TESTS
+// ===========================================================================
+
+void test_no_allocation_per_integrator() {
+    std::cout << "\nTest 1: Hot Loop - No Heap Allocation for Any Integrator\n";
+    std::cout << "--------------------------------------------\n";
+    
+    // Without event location PropagationResult::events stays empty, so
+    // returning the result allocates nothing either
+    PropagationResult result;
+    for (const char* name : {"rk4", "euler", "rk45", "dop853"}) {
+        MissionConfig config = make_test_config(10000, name);
+        NullTrajectorySink sink;
+        long allocations = count_allocations(config, sink, result);
+        std::cout << "    " << name << ": " << result.accepted_steps << " steps, "
+                  << allocations << " allocations\n";
+        check(allocations == 0, std::string(name) + " mission allocates nothing");
+    }
+}
+
+void test_no_allocation_with_sinks() {
+    std::cout << "\nTest 2: Hot Loop - In-Memory Sinks Allocate Only at Construction\n";
+    std::cout << "--------------------------------------------\n";
+    
+    MissionConfig config = make_test_config();
+    PropagationResult result;
+    
+    RingBufferTrajectorySink ring(256);
+    DecimatingTrajectorySink decimated(ring, 10);
+    long allocations = count_allocations(config, decimated, result);
+    
+    check(allocations == 0 && ring.size() == 256,
+          "Decimated ring buffer records steps without allocating");
+}
+
+void test_allocation_independent_of_steps() {
+    std::cout << "\nTest 3: Event Location - Allocations Independent of Step Count\n";
+    std::cout << "--------------------------------------------\n";
+    
+    // Event setup and the located event itself may allocate; the number of
+    // steps must not change the count
+    std::vector<long> counts;
+    for (double dt : {20000.0, 2000.0}) {
+        MissionConfig config = make_test_config();
+        config.timestep_s = dt;
+        config.locate_coast = true;
+        EventSpec spec;
+        spec.type = "radius_crossing";
+        spec.value = 1.6e8;
+        config.events.push_back(spec);
+        
+        NullTrajectorySink sink;
+        PropagationResult result;
+        long allocations = count_allocations(config, sink, result);
+        std::cout << "    dt = " << dt << " s: " << result.accepted_steps << " steps, "
+                  << allocations << " allocations\n";
+        counts.push_back(allocations);
+    }
+    
+    check(counts[0] == counts[1], "Same allocation count for 10x more steps");
+}
+
+// ===========================================================================
+// DEVIRTUALIZED PATH TESTS
+// ===========================================================================
+
+void test_template_path_matches_dispatch() {
+    std::cout << "\nTest 4: Templated Loop - Matches config.integrator Dispatch\n";
+    std::cout << "--------------------------------------------\n";
+    
+    double r_dep = getOrbitalRadius(CelestialBody::EARTH);
+    double r_arr = getOrbitalRadius(CelestialBody::MARS);
+    
+    MissionConfig config = make_test_config(10000, "dop853");
+    NullTrajectorySink sink;
+    PropagationResult dispatched = propagateMission(config, r_dep, r_arr, sink);
+    
+    DOP853Propagator integrator(config.abs_tol, config.rel_tol);
+    PropagationResult direct = propagateMission(integrator, config, r_dep, r_arr, sink);
+    
+    check(direct.final_state.t == dispatched.final_state.t &&
+          direct.final_state.r[0] == dispatched.final_state.r[0] &&
+          direct.accepted_steps == dispatched.accepted_steps,
+          "Explicit integrator instance gives the dispatched result");
+    
+    // A reused adaptive integrator reports per-mission step counts
+    PropagationResult again = propagateMission(integrator, config, r_dep, r_arr, sink);
+    check(again.accepted_steps == direct.accepted_steps,
+          "Step counters restart for every mission");
+}
+
+// ===========================================================================
+// MAIN TEST RUNNER
+// ===========================================================================
+
+int main() {
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "ALLOCATION AND HOT LOOP TEST SUITE\n";
+    std::cout << "=====================================================\n";
+    
+    test_no_allocation_per_integrator();
+    test_no_allocation_with_sinks();
+    test_allocation_independent_of_steps();
+    test_template_path_matches_dispatch();
+    
+    // Summary
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "TEST RESULTS\n";
+    std::cout << "=====================================================\n";
+    std::cout << "  Tests passed: " << tests_passed << "\n";
+    std::cout << "  Tests failed: " << tests_failed << "\n";
+    std::cout << "  Total tests:  " << (tests_passed + tests_failed) << "\n";
+    
+    if (tests_failed == 0) {
+        std::cout << "\n  ✓ ALL TESTS PASSED\n";
+        std::cout << "=====================================================\n\n";
+        return 0;
+    } else {
+        std::cout << "\n  ✗ SOME TESTS FAILED\n";
+        std::cout << "=====================================================\n\n";
+        return 1;
+    }
+}
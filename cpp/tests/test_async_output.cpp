@@ -0,0 +1,272 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <cstdio>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include "../src/constants.h"
+#include "../src/propagator.h"
+#include "../src/mission_propagation.h"
+#include "../src/trajectory_sink.h"
+#include "../src/trajectory_file.h"
+#include "../src/async_sink.h"
+#include "../src/spsc_ring.h"
+#include "test_mission_config.h"
+
+// ===========================================================================
+// TEST FRAMEWORK HELPERS
+// ===========================================================================
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+void check(bool condition, const std::string& test_name) {
+    if (condition) {
+        std::cout << "  ✓ PASS: " << test_name << "\n";
+        tests_passed++;
+    } else {
+        std::cout << "  ✗ FAIL: " << test_name << "\n";
+        tests_failed++;
+    }
+}
+
+std::string read_file(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+/// Keeps every step it sees; optionally slow, like a congested filesystem
+class RecordingSink : public TrajectorySink {
+public:
+    explicit RecordingSink(std::chrono::microseconds delay = std::chrono::microseconds(0))
+        : delay(delay) {}
+    
+    void record(long step, const MissionState&, const OrbitalElements&) override {
+        if (delay.count() > 0) {
+            std::this_thread::sleep_for(delay);
+        }
+        steps.push_back(step);
+    }
+    void finish(long step, const MissionState&, const OrbitalElements&) override {
+        finish_step = step;
+    }
+    bool saveCheckpoint(SinkCheckpoint&) override { return true; }
+    
+    std::vector<long> steps;
+    long finish_step = -1;
+
+private:
+    std::chrono::microseconds delay;
+};
+
+// ===========================================================================
+// RING BUFFER TESTS
+// ===========================================================================
+
+void test_spsc_ring_order() {
+    std::cout << "\nTest 1: SPSC Ring - Capacity and FIFO Order Across Threads\n";
+    std::cout << "--------------------------------------------\n";
+    
+    check(SpscRing<int>(100).capacity() == 64 && SpscRing<int>(1).capacity() == 2,
+          "Capacity rounds down to a power of two");
+    
+    SpscRing<long> ring(64);
+    check(ring.empty() && ring.front() == nullptr, "New ring is empty");
+    
+    const long count = 200000;
+    bool in_order = true;
+    std::thread consumer([&] {
+        for (long expected = 0; expected < count;) {
+            long* value = ring.front();
+            if (!value) {
+                std::this_thread::yield();
+                continue;
+            }
+            in_order = in_order && (*value == expected);
+            ring.pop();
+            expected++;
+        }
+    });
+    long full = 0;
+    for (long i = 0; i < count; i++) {
+        while (!ring.tryPush(i)) {
+            full++;
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+    
+    std::cout << "    Pushes that found the ring full: " << full << "\n";
+    check(in_order, "Every value arrives once, in order");
+    check(ring.empty(), "Ring empty once consumed");
+}
+
+// ===========================================================================
+// ASYNC SINK TESTS
+// ===========================================================================
+
+void test_async_output_identical() {
+    std::cout << "\nTest 2: Async Output - Same Files as Synchronous Output\n";
+    std::cout << "--------------------------------------------\n";
+    
+    MissionConfig config = make_test_config();
+    config.output_format = "both";
+    config.save_interval = 3;
+    double r_dep = getOrbitalRadius(CelestialBody::EARTH);
+    double r_arr = getOrbitalRadius(CelestialBody::MARS);
+    
+    const std::string sync_csv = "test_async_output_sync.csv";
+    const std::string async_csv = "test_async_output_async.csv";
+    PropagationResult sync_result = propagateMission(config, r_dep, r_arr, true, sync_csv);
+    config.async_output = true;
+    PropagationResult async_result = propagateMission(config, r_dep, r_arr, true, async_csv);
+    
+    std::string sync_rows = read_file(sync_csv);
+    check(!sync_rows.empty() && sync_rows == read_file(async_csv), "CSV byte-identical");
+    check(read_file(binaryTrajectoryPath(sync_csv)) == read_file(binaryTrajectoryPath(async_csv)),
+          "Binary file byte-identical");
+    check(async_result.final_state.t == sync_result.final_state.t &&
+          async_result.final_state.m == sync_result.final_state.m,
+          "Same final state");
+    
+    for (const std::string& name : {sync_csv, async_csv}) {
+        std::remove(name.c_str());
+        std::remove(binaryTrajectoryPath(name).c_str());
+    }
+}
+
+void test_backpressure_bounds_queue() {
+    std::cout << "\nTest 3: Backpressure - Slow Writer, Bounded Queue, No Lost Steps\n";
+    std::cout << "--------------------------------------------\n";
+    
+    MissionConfig config = make_test_config();
+    config.timestep_s = 100000;
+    double r_dep = getOrbitalRadius(CelestialBody::EARTH);
+    double r_arr = getOrbitalRadius(CelestialBody::MARS);
+    
+    RecordingSink reference;
+    propagateMission(config, r_dep, r_arr, reference);
+    
+    TrajectoryWriterThread writer;
+    RecordingSink slow(std::chrono::microseconds(200));
+    long waits = 0;
+    std::size_t capacity = 0;
+    {
+        AsyncTrajectorySink async_sink(slow, writer, 1);  // Smallest ring
+        capacity = async_sink.queueCapacity();
+        propagateMission(config, r_dep, r_arr, async_sink);
+        waits = async_sink.backpressureWaits();
+    }
+    
+    std::cout << "    Steps: " << slow.steps.size() << ", queue capacity: " << capacity
+              << ", backpressure waits: " << waits << "\n";
+    check(capacity == 2, "Queue holds two steps");
+    check(waits > 0, "Propagation waited for the slow writer");
+    check(!slow.steps.empty() && slow.steps == reference.steps &&
+          slow.finish_step == reference.finish_step && slow.finish_step >= 0,
+          "Every step delivered, in order, then finish");
+}
+
+void test_shared_writer_thread() {
+    std::cout << "\nTest 4: Shared I/O Thread - Two Missions, One Writer\n";
+    std::cout << "--------------------------------------------\n";
+    
+    MissionConfig mars = make_test_config();
+    mars.output_format = "csv";
+    MissionConfig venus = mars;
+    venus.arrival_body = CelestialBody::VENUS;
+    venus.thrust_direction = -1;
+    double r_earth = getOrbitalRadius(CelestialBody::EARTH);
+    
+    propagateMission(mars, r_earth, getOrbitalRadius(CelestialBody::MARS), true,
+                     "test_async_output_mars_ref.csv");
+    propagateMission(venus, r_earth, getOrbitalRadius(CelestialBody::VENUS), true,
+                     "test_async_output_venus_ref.csv");
+    
+    mars.async_output = true;
+    venus.async_output = true;
+    {
+        TrajectoryWriterThread writer;
+        std::thread first([&] {
+            propagateMission(mars, r_earth, getOrbitalRadius(CelestialBody::MARS), true,
+                             "test_async_output_mars.csv", &writer);
+        });
+        std::thread second([&] {
+            propagateMission(venus, r_earth, getOrbitalRadius(CelestialBody::VENUS), true,
+                             "test_async_output_venus.csv", &writer);
+        });
+        first.join();
+        second.join();
+    }
+    
+    check(read_file("test_async_output_mars.csv") == read_file("test_async_output_mars_ref.csv"),
+          "Mars trajectory matches its synchronous run");
+    check(read_file("test_async_output_venus.csv") == read_file("test_async_output_venus_ref.csv"),
+          "Venus trajectory matches its synchronous run");
+    
+    for (const char* name : {"test_async_output_mars.csv", "test_async_output_mars_ref.csv",
+                             "test_async_output_venus.csv", "test_async_output_venus_ref.csv"}) {
+        std::remove(name);
+    }
+}
+
+void test_checkpoint_drains_queue() {
+    std::cout << "\nTest 5: Checkpoint - Queue Drained Before the Wrapped Sink Saves\n";
+    std::cout << "--------------------------------------------\n";
+    
+    TrajectoryWriterThread writer;
+    RecordingSink recording(std::chrono::microseconds(100));
+    AsyncTrajectorySink async_sink(recording, writer);
+    
+    MissionState state;
+    OrbitalElements elements;
+    for (long step = 0; step < 50; step++) {
+        async_sink.record(step, state, elements);
+    }
+    SinkCheckpoint checkpoint;
+    bool saved = async_sink.saveCheckpoint(checkpoint);
+    check(saved && recording.steps.size() == 50, "All 50 queued steps written before saving");
+    
+    async_sink.finish(50, state, elements);
+    check(recording.finish_step == 50 && !async_sink.wantsStep(51),
+          "finish() returns after the wrapped sink finished");
+}
+
+// ===========================================================================
+// MAIN TEST RUNNER
+// ===========================================================================
+
+int main() {
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "ASYNC OUTPUT TEST SUITE\n";
+    std::cout << "=====================================================\n";
+    
+    test_spsc_ring_order();
+    test_async_output_identical();
+    test_backpressure_bounds_queue();
+    test_shared_writer_thread();
+    test_checkpoint_drains_queue();
+    
+    // Summary
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "TEST RESULTS\n";
+    std::cout << "=====================================================\n";
+    std::cout << "  Tests passed: " << tests_passed << "\n";
+    std::cout << "  Tests failed: " << tests_failed << "\n";
+    std::cout << "  Total tests:  " << (tests_passed + tests_failed) << "\n";
+    
+    if (tests_failed == 0) {
+        std::cout << "\n  ✓ ALL TESTS PASSED\n";
+        std::cout << "=====================================================\n\n";
+        return 0;
+    } else {
+        std::cout << "\n  ✗ SOME TESTS FAILED\n";
+        std::cout << "=====================================================\n\n";
+        return 1;
+    }
+}
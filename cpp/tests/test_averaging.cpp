@@ -0,0 +1,257 @@
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <string>
+#include "../src/constants.h"
+#include "../src/propagator.h"
+#include "../src/orbital_elements.h"
+#include "../src/mission_propagation.h"
+
+// ===========================================================================
+// TEST FRAMEWORK HELPERS
+// ===========================================================================
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+void check(bool condition, const std::string& test_name) {
+    if (condition) {
+        std::cout << "  ✓ PASS: " << test_name << "\n";
+        tests_passed++;
+    } else {
+        std::cout << "  ✗ FAIL: " << test_name << "\n";
+        tests_failed++;
+    }
+}
+
+double distance(const double a[3], const double b[3]) {
+    double dx = a[0] - b[0];
+    double dy = a[1] - b[1];
+    double dz = a[2] - b[2];
+    return std::sqrt(dx*dx + dy*dy + dz*dz);
+}
+
+double norm(const double a[3]) {
+    return std::sqrt(a[0]*a[0] + a[1]*a[1] + a[2]*a[2]);
+}
+
+/// Circular Earth orbit
+MissionState earth_orbit(double mass = 10000.0) {
+    return MissionState(R_EARTH, 0, 0, 0, std::sqrt(MU_SUN / R_EARTH), 0, mass, 0.0);
+}
+
+double period(const MissionState& state) {
+    OrbitalElements elements = computeOrbitalElements(state.r, state.v, MU_SUN);
+    return 2.0 * 3.14159265358979323846 * std::sqrt(elements.a * elements.a * elements.a / MU_SUN);
+}
+
+// ===========================================================================
+// EQUINOCTIAL ELEMENT TESTS
+// ===========================================================================
+
+void test_equinoctial_round_trip() {
+    std::cout << "\nTest 1: Equinoctial Elements - State Round Trip\n";
+    std::cout << "--------------------------------------------\n";
+    
+    // Inclined ellipse and an equatorial circle (singular for ω and Ω)
+    double r_inclined[3] = {1.2e8, -4.0e7, 2.5e7};
+    double v_inclined[3] = {8.0, 27.0, 4.0};
+    double r_circle[3] = {R_EARTH, 0, 0};
+    double v_circle[3] = {0, std::sqrt(MU_SUN / R_EARTH), 0};
+    
+    for (int c = 0; c < 2; c++) {
+        const double* r = c == 0 ? r_inclined : r_circle;
+        const double* v = c == 0 ? v_inclined : v_circle;
+        EquinoctialElements elements = computeEquinoctialElements(r, v, MU_SUN);
+        double r_back[3];
+        double v_back[3];
+        equinoctialToState(elements, MU_SUN, r_back, v_back);
+        std::cout << "    p=" << std::scientific << std::setprecision(4) << elements.p
+                  << " e=" << elements.eccentricity() << " tan(i/2)^2="
+                  << elements.h * elements.h + elements.k * elements.k << "\n";
+        check(distance(r, r_back) < 1e-9 * norm(r) && distance(v, v_back) < 1e-9 * norm(v),
+              c == 0 ? "Inclined ellipse: r and v recovered"
+                     : "Equatorial circle: r and v recovered");
+    }
+    
+    OrbitalElements classical = computeOrbitalElements(r_inclined, v_inclined, MU_SUN);
+    EquinoctialElements elements = computeEquinoctialElements(r_inclined, v_inclined, MU_SUN);
+    check(std::abs(elements.p - classical.a * (1 - classical.e * classical.e)) <
+              1e-9 * elements.p &&
+          std::abs(elements.eccentricity() - classical.e) < 1e-12,
+          "p and e agree with the classical elements");
+    
+    double lambda = trueToMeanLongitude(elements.L, elements.f, elements.g);
+    double L_back = meanToTrueLongitude(lambda, elements.f, elements.g);
+    check(std::abs(std::remainder(L_back - elements.L, 2 * 3.14159265358979323846)) < 1e-10,
+          "Mean longitude converts back to the true longitude");
+}
+
+// ===========================================================================
+// AVERAGED PROPAGATOR TESTS
+// ===========================================================================
+
+void test_unpowered_step_is_kepler() {
+    std::cout << "\nTest 2: Averaged Step without Thrust - Two-Body Motion\n";
+    std::cout << "--------------------------------------------\n";
+    
+    double r0[3] = {1.2e8, -4.0e7, 2.5e7};
+    double v0[3] = {8.0, 27.0, 4.0};
+    MissionState state(r0[0], r0[1], r0[2], v0[0], v0[1], v0[2], 1000.0);
+    
+    AveragedPropagator averaged(10000, 0.3);
+    double dt = averaged.advance(state, 0.0, 2750.0, MU_SUN, G0, 1, 1e12);
+    double r_kepler[3];
+    double v_kepler[3];
+    propagateKepler(r0, v0, dt, MU_SUN, r_kepler, v_kepler);
+    std::cout << "    Step " << std::fixed << std::setprecision(1) << dt / 86400.0
+              << " days, position difference " << std::scientific << std::setprecision(2)
+              << distance(state.r, r_kepler) << " km\n";
+    check(std::abs(dt - 0.3 * period(MissionState(r0[0], r0[1], r0[2],
+                                                  v0[0], v0[1], v0[2], 1000.0))) < 1e-3,
+          "Step is 0.3 periods");
+    check(distance(state.r, r_kepler) < 1e-6 * norm(r0) && state.m == 1000.0,
+          "Matches the closed-form Kepler arc, mass kept");
+    check(averaged.averagedSteps() == 1 && !averaged.handedOff(), "Counted as an averaged step");
+}
+
+void test_averaged_spiral_rate() {
+    std::cout << "\nTest 3: Averaged Rates - Circular Spiral\n";
+    std::cout << "--------------------------------------------\n";
+    
+    // Tangential thrust on a circle: da/dt = 2 a^(3/2) (T/m) / sqrt(μ),
+    // and the orbit stays circular on average (no mass flow: Isp 0)
+    MissionState state = earth_orbit();
+    double thrust_accel = 1000.0 * 1e-6 / state.m;
+    
+    AveragedPropagator averaged(10000, 0.01);
+    double dt = averaged.advance(state, 1000.0, 0.0, MU_SUN, G0, 1, 1e12);
+    OrbitalElements elements = computeOrbitalElements(state.r, state.v, MU_SUN);
+    double rate = (elements.a - R_EARTH) / dt;
+    double a_mid = 0.5 * (elements.a + R_EARTH);
+    double expected_rate = 2.0 * std::pow(a_mid, 1.5) * thrust_accel / std::sqrt(MU_SUN);
+    std::cout << "    da/dt " << std::scientific << std::setprecision(6) << rate
+              << " km/s (analytic " << expected_rate << "), e " << elements.e << "\n";
+    check(std::abs(rate - expected_rate) < 1e-4 * expected_rate, "Semi-major axis rate");
+    check(elements.e < 1e-9, "Mean eccentricity stays zero");
+    
+    // Retrograde thrust shrinks the orbit at the same rate
+    MissionState inbound = earth_orbit();
+    averaged.advance(inbound, 1000.0, 0.0, MU_SUN, G0, -1, 1e12);
+    OrbitalElements inbound_elements = computeOrbitalElements(inbound.r, inbound.v, MU_SUN);
+    double inbound_mid = 0.5 * (inbound_elements.a + R_EARTH);
+    double inbound_rate = 2.0 * std::pow(inbound_mid, 1.5) * thrust_accel / std::sqrt(MU_SUN);
+    check(std::abs((R_EARTH - inbound_elements.a) / dt - inbound_rate) < 1e-3 * inbound_rate,
+          "Retrograde thrust lowers the orbit");
+}
+
+void test_handoff() {
+    std::cout << "\nTest 4: Handoff to RK4\n";
+    std::cout << "--------------------------------------------\n";
+    
+    // A step that would reach the coast zone is not taken; RK4 takes over
+    MissionState state = earth_orbit();
+    MissionState reference = state;
+    AveragedPropagator near_coast(5000, 1, 1.02 * R_EARTH, 0.9);
+    double dt = near_coast.advance(state, 1000.0, 2750.0, MU_SUN, G0, 1, 1e12);
+    RK4Propagator rk4;
+    rk4.step(reference, 5000, 1000.0, 2750.0, MU_SUN, G0, 1);
+    check(near_coast.handedOff() && dt == 5000 && near_coast.averagedSteps() == 0,
+          "Hands off before a step into the coast zone");
+    check(distance(state.r, reference.r) == 0 && state.m == reference.m,
+          "After the handoff, steps are RK4Propagator steps");
+    double t_before = state.t;
+    dt = near_coast.advance(state, 1000.0, 2750.0, MU_SUN, G0, 1, 1234.0);
+    check(dt == 1234.0 && state.t == t_before + 1234.0, "RK4 steps stop at dt_max too");
+    
+    // Fuel cutoff inside the step
+    MissionState light = earth_orbit(150.0);
+    AveragedPropagator fuel(5000, 1);
+    fuel.advance(light, 1000.0, 2750.0, MU_SUN, G0, 1, 1e12);
+    check(fuel.handedOff(), "Hands off before the fuel cutoff");
+    
+    // step() covers exactly dt, switching midway if needed
+    MissionState exact = earth_orbit();
+    AveragedPropagator stepper(5000, 0.5, 1.3 * R_EARTH, 0.9);
+    stepper.step(exact, 4.0e7, 1000.0, 2750.0, MU_SUN, G0, 1);
+    check(exact.t == 4.0e7 && stepper.averagedSteps() > 0 && stepper.handedOff(),
+          "step() lands on t + dt across the handoff");
+    
+    stepper.reset();
+    check(!stepper.handedOff() && stepper.averagedSteps() == 0, "reset() re-enables averaging");
+}
+
+// ===========================================================================
+// MISSION TESTS
+// ===========================================================================
+
+void test_mission_against_rk4() {
+    std::cout << "\nTest 5: Earth-Jupiter Low-Power Hall - Averaged vs RK4\n";
+    std::cout << "--------------------------------------------\n";
+    
+    MissionConfig config;
+    config.spacecraft.name = "Low-Power Hall";
+    config.spacecraft.thrust_mN = 60;
+    config.spacecraft.isp_s = 1500;
+    config.arrival_body = CelestialBody::JUPITER;
+    config.timestep_s = 20000;
+    config.max_flight_time_s = 2.0e9;
+    double r_dep = getOrbitalRadius(CelestialBody::EARTH);
+    double r_arr = getOrbitalRadius(CelestialBody::JUPITER);
+    
+    PropagationResult rk4 = propagateMission(config, r_dep, r_arr, false);
+    config.integrator = "averaged";
+    PropagationResult averaged = propagateMission(config, r_dep, r_arr, false);
+    
+    double days_rk4 = rk4.coast_state.t / 86400.0;
+    double days_averaged = averaged.coast_state.t / 86400.0;
+    double propellant_rk4 = 10000 - rk4.coast_state.m;
+    double propellant_averaged = 10000 - averaged.coast_state.m;
+    std::cout << "    RK4:      " << rk4.accepted_steps << " steps, " << std::fixed
+              << std::setprecision(1) << days_rk4 << " days, " << propellant_rk4 << " kg\n"
+              << "    Averaged: " << averaged.accepted_steps << " steps ("
+              << averaged.averaged_steps << " averaged), " << days_averaged << " days, "
+              << propellant_averaged << " kg\n";
+    check(rk4.coast_step >= 0 && averaged.coast_step >= 0, "Both reach coast");
+    check(averaged.averaged_steps > 0 && averaged.accepted_steps > averaged.averaged_steps,
+          "Averaged phase followed by RK4 phase");
+    check(averaged.accepted_steps * 20 < rk4.accepted_steps, "At least 20x fewer steps");
+    check(std::abs(days_averaged - days_rk4) < 0.02 * days_rk4 &&
+          std::abs(propellant_averaged - propellant_rk4) < 0.02 * propellant_rk4,
+          "Flight time and propellant within 2%");
+    check(std::abs(averaged.total_delta_v -
+                   1500 * G0 * std::log(10000 / averaged.coast_state.m)) <
+              1e-6 * averaged.total_delta_v,
+          "Delta-V follows the rocket equation across long steps");
+}
+
+int main() {
+    std::cout << "=====================================================\n";
+    std::cout << "ORBIT-AVERAGED PROPAGATOR TEST SUITE\n";
+    std::cout << "=====================================================\n";
+    
+    test_equinoctial_round_trip();
+    test_unpowered_step_is_kepler();
+    test_averaged_spiral_rate();
+    test_handoff();
+    test_mission_against_rk4();
+    
+    // Summary
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "TEST RESULTS\n";
+    std::cout << "=====================================================\n";
+    std::cout << "  Tests passed: " << tests_passed << "\n";
+    std::cout << "  Tests failed: " << tests_failed << "\n";
+    std::cout << "  Total tests:  " << (tests_passed + tests_failed) << "\n";
+    
+    if (tests_failed == 0) {
+        std::cout << "\n  ✓ ALL TESTS PASSED\n";
+        std::cout << "=====================================================\n\n";
+        return 0;
+    } else {
+        std::cout << "\n  ✗ SOME TESTS FAILED\n";
+        std::cout << "=====================================================\n\n";
+        return 1;
+    }
+}
@@ -0,0 +1,319 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstdio>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "../src/constants.h"
+#include "../src/propagator.h"
+#include "../src/orbital_elements.h"
+#include "../src/mission_propagation.h"
+#include "../src/trajectory_file.h"
+#include "../src/batch_elements.h"
+
+// ===========================================================================
+// TEST FRAMEWORK HELPERS
+// ===========================================================================
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+void check(bool condition, const std::string& test_name) {
+    if (condition) {
+        std::cout << "  ✓ PASS: " << test_name << "\n";
+        tests_passed++;
+    } else {
+        std::cout << "  ✗ FAIL: " << test_name << "\n";
+        tests_failed++;
+    }
+}
+
+const double PI = 3.14159265358979323846;
+
+/// Owns the six state columns behind a StateColumns view
+struct StateTable {
+    std::vector<double> x, y, z, vx, vy, vz;
+    
+    void add(const double r[3], const double v[3]) {
+        x.push_back(r[0]);
+        y.push_back(r[1]);
+        z.push_back(r[2]);
+        vx.push_back(v[0]);
+        vy.push_back(v[1]);
+        vz.push_back(v[2]);
+    }
+    
+    StateColumns view() const {
+        StateColumns states;
+        states.count = x.size();
+        states.x = x.data();
+        states.y = y.data();
+        states.z = z.data();
+        states.vx = vx.data();
+        states.vy = vy.data();
+        states.vz = vz.data();
+        return states;
+    }
+};
+
+/// Heliocentric states from Venus to Jupiter distances, every orientation,
+/// plus the degenerate cases the scalar code special-cases
+StateTable make_state_table(std::size_t count) {
+    StateTable table;
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> unit(-1.0, 1.0);
+    for (std::size_t k = 0; k < count; k++) {
+        double r_mag = 1.0e8 + 7.0e8 * (0.5 + 0.5 * unit(rng));
+        double v_circ = std::sqrt(MU_SUN / r_mag);
+        double r[3] = {unit(rng), unit(rng), unit(rng)};
+        double v[3] = {unit(rng), unit(rng), unit(rng)};
+        double r_norm = std::sqrt(r[0]*r[0] + r[1]*r[1] + r[2]*r[2]);
+        double v_norm = std::sqrt(v[0]*v[0] + v[1]*v[1] + v[2]*v[2]);
+        double speed = v_circ * (0.3 + 1.3 * (0.5 + 0.5 * unit(rng)));  // Some hyperbolic
+        for (int c = 0; c < 3; c++) {
+            r[c] *= r_mag / r_norm;
+            v[c] *= speed / v_norm;
+        }
+        table.add(r, v);
+    }
+    
+    double r_eq[3] = {1.5e8, 0, 0};
+    double v_circular[3] = {0, std::sqrt(MU_SUN / 1.5e8), 0};           // Equatorial, circular
+    double v_retro[3] = {0, -0.9 * std::sqrt(MU_SUN / 1.5e8), 0};       // Equatorial, retrograde
+    double v_polar[3] = {0, 0, 1.1 * std::sqrt(MU_SUN / 1.5e8)};        // Polar
+    double v_inbound[3] = {-5.0, 20.0, 1.0};                            // r.v < 0
+    table.add(r_eq, v_circular);
+    table.add(r_eq, v_retro);
+    table.add(r_eq, v_polar);
+    table.add(r_eq, v_inbound);
+    return table;
+}
+
+/// Difference of two angles, allowing for the 0/2pi seam
+double angle_error(double a, double b) {
+    double d = std::abs(a - b);
+    return std::min(d, std::abs(d - 2 * PI));
+}
+
+// ===========================================================================
+// APPROXIMATION TESTS
+// ===========================================================================
+
+void test_fast_trig_bounds() {
+    std::cout << "\nTest 1: fastAtan2 / fastAcos - Error Bound Over the Plane\n";
+    std::cout << "--------------------------------------------\n";
+    
+    std::mt19937_64 rng(3);
+    std::uniform_real_distribution<double> unit(-1.0, 1.0);
+    double atan2_error = 0;
+    double acos_error = 0;
+    for (int k = 0; k < 1000000; k++) {
+        // Mix of magnitudes so every octant and the near-axis cases are hit
+        double y = unit(rng) * std::pow(10.0, -12.0 * (k % 4 == 0));
+        double x = unit(rng) * std::pow(10.0, -12.0 * (k % 7 == 0));
+        atan2_error = std::max(atan2_error, std::abs(fastAtan2(y, x) - std::atan2(y, x)));
+        
+        double c = unit(rng);
+        c = (k % 3 == 0) ? std::copysign(1.0 - 1e-9 * std::abs(c), c) : c;  // Near +-1
+        acos_error = std::max(acos_error, std::abs(fastAcos(c) - std::acos(c)));
+    }
+    
+    std::cout << "    Max error: atan2 " << std::scientific << std::setprecision(2)
+              << atan2_error << ", acos " << acos_error << std::fixed << "\n";
+    check(atan2_error <= FAST_ATAN2_MAX_ERROR, "fastAtan2 within its stated bound");
+    check(acos_error <= FAST_ATAN2_MAX_ERROR, "fastAcos within its stated bound");
+    
+    bool axes = fastAtan2(0, 0) == 0 && fastAtan2(0, 1) == 0 &&
+                std::abs(fastAtan2(0, -1) - PI) <= FAST_ATAN2_MAX_ERROR &&
+                std::abs(fastAtan2(1, 0) - PI / 2) <= FAST_ATAN2_MAX_ERROR &&
+                std::abs(fastAtan2(-1, 0) + PI / 2) <= FAST_ATAN2_MAX_ERROR &&
+                fastAcos(1.0) == 0 && std::abs(fastAcos(-1.0) - PI) <= FAST_ATAN2_MAX_ERROR;
+    check(axes, "Axes and the origin give the exact quadrant angles");
+}
+
+// ===========================================================================
+// BATCH CONVERSION TESTS
+// ===========================================================================
+
+void test_batch_matches_scalar() {
+    std::cout << "\nTest 2: Batch Conversion - Matches computeOrbitalElements\n";
+    std::cout << "--------------------------------------------\n";
+    
+    StateTable table = make_state_table(20000);
+    ElementArrays batch;
+    computeOrbitalElementsBatch(table.view(), MU_SUN, batch);
+    check(batch.size() == table.x.size(), "One element row per state");
+    
+    bool exact = true;
+    double worst_angle = 0;
+    for (std::size_t k = 0; k < batch.size(); k++) {
+        double r[3] = {table.x[k], table.y[k], table.z[k]};
+        double v[3] = {table.vx[k], table.vy[k], table.vz[k]};
+        OrbitalElements scalar = computeOrbitalElements(r, v, MU_SUN);
+        OrbitalElements row = batch.at(k);
+        exact = exact && row.a == scalar.a && row.e == scalar.e && row.r_p == scalar.r_p &&
+                row.r_a == scalar.r_a && row.h == scalar.h && row.E == scalar.E;
+        
+        // Near-circular orbits leave omega ill-conditioned; compare it where defined
+        worst_angle = std::max({worst_angle, angle_error(row.i, scalar.i),
+                                angle_error(row.Omega, scalar.Omega),
+                                angle_error(row.nu, scalar.nu)});
+        if (scalar.e > 1e-3) {
+            worst_angle = std::max(worst_angle, angle_error(row.omega, scalar.omega));
+        }
+    }
+    
+    std::cout << "    Worst angle difference: " << std::scientific << std::setprecision(2)
+              << worst_angle << " rad" << std::fixed << "\n";
+    check(exact, "a, e, r_p, r_a, h and E bit-identical");
+    check(worst_angle < 1e-12, "i, Omega, omega and nu agree to 1e-12 rad");
+    
+    std::size_t n = batch.size();
+    bool degenerate = batch.i[n - 4] == 0 && batch.Omega[n - 4] == 0 && batch.omega[n - 4] == 0 &&
+                      std::abs(batch.i[n - 3] - PI) < 1e-15 && batch.omega[n - 3] == 0 &&
+                      std::abs(batch.i[n - 2] - PI / 2) < 1e-15 &&
+                      batch.nu[n - 1] > PI;
+    check(degenerate, "Equatorial, retrograde, polar and inbound cases");
+}
+
+void test_batch_threads() {
+    std::cout << "\nTest 3: Batch Conversion - Thread Count Does Not Change Results\n";
+    std::cout << "--------------------------------------------\n";
+    
+    // Several chunks, the last one partial
+    StateTable table = make_state_table(200001);
+    ElementArrays serial, parallel;
+    computeOrbitalElementsBatch(table.view(), MU_SUN, serial, 1);
+    computeOrbitalElementsBatch(table.view(), MU_SUN, parallel, 3);
+    
+    bool identical = serial.size() == parallel.size();
+    for (std::size_t k = 0; identical && k < serial.size(); k++) {
+        identical = serial.a[k] == parallel.a[k] && serial.i[k] == parallel.i[k] &&
+                    serial.Omega[k] == parallel.Omega[k] && serial.omega[k] == parallel.omega[k] &&
+                    serial.nu[k] == parallel.nu[k];
+    }
+    check(identical, "3 threads give the single-thread arrays");
+    
+    ElementArrays empty;
+    computeOrbitalElementsBatch(StateColumns(), MU_SUN, empty, 3);
+    check(empty.size() == 0, "Empty input gives empty arrays");
+}
+
+// ===========================================================================
+// TRAJECTORY FILE TESTS
+// ===========================================================================
+
+void test_recompute_trajectory_file() {
+    std::cout << "\nTest 4: Trajectory File - Element Columns Added In Place\n";
+    std::cout << "--------------------------------------------\n";
+    
+    MissionConfig config;
+    config.spacecraft.thrust_mN = 1000;
+    config.spacecraft.isp_s = 2750;
+    config.spacecraft.initial_mass_kg = 10000;
+    config.integrator = "rk4";
+    config.timestep_s = 20000;
+    
+    const std::string filename = "test_batch_elements.bin";
+    {
+        BinaryTrajectorySink sink(filename, config, 1);
+        propagateMission(config, getOrbitalRadius(CelestialBody::EARTH),
+                         getOrbitalRadius(CelestialBody::MARS), sink);
+    }
+    
+    // Rewrite the file while it is still mapped, as recompute_elements does
+    bool written = false;
+    std::vector<double> x_before;
+    {
+        MappedTrajectory original;
+        if (!original.open(filename)) {
+            check(false, "Propagated trajectory maps");
+            return;
+        }
+        StateColumns states;
+        states.count = original.rows();
+        states.x = original.column(TrajectoryColumn::X);
+        states.y = original.column(TrajectoryColumn::Y);
+        states.z = original.column(TrajectoryColumn::Z);
+        states.vx = original.column(TrajectoryColumn::VX);
+        states.vy = original.column(TrajectoryColumn::VY);
+        states.vz = original.column(TrajectoryColumn::VZ);
+        x_before.assign(states.x, states.x + states.count);
+        
+        ElementArrays elements;
+        computeOrbitalElementsBatch(states, original.header().mu, elements);
+        std::vector<TrajectoryColumn> ids = {TrajectoryColumn::X, TrajectoryColumn::Y,
+                                             TrajectoryColumn::Z, TrajectoryColumn::VX,
+                                             TrajectoryColumn::VY, TrajectoryColumn::VZ,
+                                             TrajectoryColumn::INCLINATION,
+                                             TrajectoryColumn::TRUE_ANOMALY};
+        std::vector<const double*> columns = {states.x, states.y, states.z,
+                                              states.vx, states.vy, states.vz,
+                                              elements.i.data(), elements.nu.data()};
+        written = writeTrajectoryFile(filename, original.header(), ids, columns, original.rows());
+        check(x_before == std::vector<double>(states.x, states.x + states.count),
+              "Mapped original unchanged while the new file is written");
+    }
+    check(written, "writeTrajectoryFile succeeds over a mapped file");
+    
+    MappedTrajectory updated;
+    bool opened = updated.open(filename);
+    check(opened && updated.rows() == x_before.size() && updated.columns() == 8 &&
+          std::string(updated.header().spacecraft_name) == config.spacecraft.name,
+          "Rewritten file validates with the mission header");
+    
+    const double* x = opened ? updated.column(TrajectoryColumn::X) : nullptr;
+    const double* y = opened ? updated.column(TrajectoryColumn::Y) : nullptr;
+    const double* z = opened ? updated.column(TrajectoryColumn::Z) : nullptr;
+    const double* vx = opened ? updated.column(TrajectoryColumn::VX) : nullptr;
+    const double* vy = opened ? updated.column(TrajectoryColumn::VY) : nullptr;
+    const double* vz = opened ? updated.column(TrajectoryColumn::VZ) : nullptr;
+    const double* nu = opened ? updated.column(TrajectoryColumn::TRUE_ANOMALY) : nullptr;
+    bool matches = x && y && z && vx && vy && vz && nu;
+    for (std::size_t k = 0; matches && k < x_before.size(); k++) {
+        double r[3] = {x[k], y[k], z[k]};
+        double v[3] = {vx[k], vy[k], vz[k]};
+        matches = x[k] == x_before[k] &&
+                  angle_error(nu[k], computeOrbitalElements(r, v, MU_SUN).nu) < 1e-12;
+    }
+    check(matches, "State copied exactly; true anomaly matches the scalar path");
+    
+    updated.close();
+    std::remove(filename.c_str());
+}
+
+// ===========================================================================
+// MAIN TEST RUNNER
+// ===========================================================================
+
+int main() {
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "BATCH ORBITAL ELEMENTS TEST SUITE\n";
+    std::cout << "=====================================================\n";
+    
+    test_fast_trig_bounds();
+    test_batch_matches_scalar();
+    test_batch_threads();
+    test_recompute_trajectory_file();
+    
+    // Summary
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "TEST RESULTS\n";
+    std::cout << "=====================================================\n";
+    std::cout << "  Tests passed: " << tests_passed << "\n";
+    std::cout << "  Tests failed: " << tests_failed << "\n";
+    std::cout << "  Total tests:  " << (tests_passed + tests_failed) << "\n";
+    
+    if (tests_failed == 0) {
+        std::cout << "\n  ✓ ALL TESTS PASSED\n";
+        std::cout << "=====================================================\n\n";
+        return 0;
+    } else {
+        std::cout << "\n  ✗ SOME TESTS FAILED\n";
+        std::cout << "=====================================================\n\n";
+        return 1;
+    }
+}
@@ -0,0 +1,375 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <chrono>
+#include <algorithm>
+#include "../src/constants.h"
+#include "../src/propagator.h"
+#include "../src/mission_propagation.h"
+#include "../src/batch_propagator.h"
+#include "../src/gpu_batch_propagator.h"
+
+// ===========================================================================
+// TEST FRAMEWORK HELPERS
+// ===========================================================================
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+void check(bool condition, const std::string& test_name) {
+    if (condition) {
+        std::cout << "  ✓ PASS: " << test_name << "\n";
+        tests_passed++;
+    } else {
+        std::cout << "  ✗ FAIL: " << test_name << "\n";
+        tests_failed++;
+    }
+}
+
+/// Relative difference, safe for zero
+double rel_diff(double a, double b) {
+    double scale = std::max(std::abs(a), std::abs(b));
+    return scale > 0 ? std::abs(a - b) / scale : 0.0;
+}
+
+/// Mission config with a given thruster and initial mass
+MissionConfig make_config(double thrust_mN, double isp_s, double mass_kg) {
+    MissionConfig config;
+    config.spacecraft.thrust_mN = thrust_mN;
+    config.spacecraft.isp_s = isp_s;
+    config.spacecraft.initial_mass_kg = mass_kg;
+    config.integrator = "rk4";
+    config.timestep_s = 10000;
+    config.max_flight_time_s = 1.577e9;
+    return config;
+}
+
+/// Batch lane and single-mission result agree to round-off
+bool results_match(const PropagationResult& batch, const PropagationResult& single) {
+    return batch.coast_step == single.coast_step &&
+           batch.accepted_steps == single.accepted_steps &&
+           rel_diff(batch.final_state.t, single.final_state.t) < 1e-12 &&
+           rel_diff(batch.final_state.m, single.final_state.m) < 1e-12 &&
+           rel_diff(batch.final_state.radius(), single.final_state.radius()) < 1e-12 &&
+           rel_diff(batch.total_delta_v, single.total_delta_v) < 1e-12;
+}
+
+/// Every field propagateMissionBatch fills is equal bit for bit
+bool results_identical(const PropagationResult& a, const PropagationResult& b) {
+    return a.coast_step == b.coast_step && a.accepted_steps == b.accepted_steps &&
+           a.final_state.t == b.final_state.t && a.final_state.m == b.final_state.m &&
+           std::equal(a.final_state.r, a.final_state.r + 3, b.final_state.r) &&
+           std::equal(a.final_state.v, a.final_state.v + 3, b.final_state.v) &&
+           a.total_delta_v == b.total_delta_v;
+}
+
+// ===========================================================================
+// BATCH KERNEL TESTS
+// ===========================================================================
+
+void test_batch_step_matches_rk4() {
+    std::cout << "\nTest 1: Batch RK4 Step - Lanes Match RK4Propagator\n";
+    std::cout << "--------------------------------------------\n";
+    
+    // Lanes differ in orbit, thrust, ISP and mass; lane 3 is masked out
+    std::vector<MissionState> states = {
+        MissionState(1.496e8, 0, 0, 0, 29.78, 0, 10000),
+        MissionState(1.2e8, 4.0e7, 1.0e6, -8.0, 31.0, 0.1, 5000),
+        MissionState(-2.0e8, 1.0e7, 0, -1.5, -25.0, 0, 800),
+        MissionState(1.0e8, 0, 0, 0, 36.0, 0, 2000),
+        MissionState(2.279e8, -3.0e6, 0, 0.5, 24.1, 0, 10000)
+    };
+    std::vector<double> thrust = {1000, 400, 250, 1000, 0};
+    std::vector<double> isp = {2750, 3200, 4200, 2750, 3000};
+    
+    BatchState batch;
+    batch.resize(states.size());
+    for (size_t i = 0; i < states.size(); ++i) {
+        batch.setLane(i, states[i], thrust[i], isp[i]);
+    }
+    batch.active[3] = 0;
+    
+    BatchRK4Propagator batch_rk4;
+    RK4Propagator rk4;
+    double dt = 3600.0;
+    for (int s = 0; s < 10; ++s) {
+        batch_rk4.step(batch, dt, MU_SUN, G0, 1);
+        for (size_t i = 0; i < states.size(); ++i) {
+            if (i != 3) {
+                rk4.step(states[i], dt, thrust[i], isp[i], MU_SUN, G0, 1);
+            }
+        }
+    }
+    
+    double worst = 0;
+    for (size_t i = 0; i < states.size(); ++i) {
+        MissionState lane = batch.lane(i);
+        for (int k = 0; k < 3; ++k) {
+            worst = std::max(worst, rel_diff(lane.r[k], states[i].r[k]));
+            worst = std::max(worst, rel_diff(lane.v[k], states[i].v[k]));
+        }
+        worst = std::max(worst, rel_diff(lane.m, states[i].m));
+        worst = std::max(worst, rel_diff(lane.t, states[i].t));
+    }
+    std::cout << "    Worst relative lane difference: " << std::scientific
+              << std::setprecision(2) << worst << "\n";
+    
+    check(worst < 1e-14, "Active lanes follow the scalar RK4 step");
+    check(batch.t[3] == 0 && batch.m[3] == 2000 && batch.x[3] == 1.0e8,
+          "Masked lane is left untouched");
+}
+
+// ===========================================================================
+// BATCH MISSION TESTS
+// ===========================================================================
+
+void test_batch_missions_match_single() {
+    std::cout << "\nTest 2: Batch Missions - Outbound Sweep Matches propagateMission\n";
+    std::cout << "--------------------------------------------\n";
+    
+    // Four thruster presets, plus a lane that runs out of fuel before coast
+    std::vector<MissionConfig> configs = {
+        make_config(1000, 2750, 10000),
+        make_config(400, 1800, 10000),
+        make_config(250, 4200, 10000),
+        make_config(150, 3500, 10000),
+        make_config(1000, 300, 110)
+    };
+    double r_dep = getOrbitalRadius(CelestialBody::EARTH);
+    double r_arr = getOrbitalRadius(CelestialBody::MARS);
+    
+    std::vector<PropagationResult> batch = propagateMissionBatch(configs, r_dep, r_arr);
+    
+    bool all_match = batch.size() == configs.size();
+    for (size_t i = 0; all_match && i < configs.size(); ++i) {
+        PropagationResult single = propagateMission(configs[i], r_dep, r_arr);
+        std::cout << "    Lane " << i << ": " << batch[i].accepted_steps << " steps, coast step "
+                  << batch[i].coast_step << " (single: " << single.accepted_steps << ", "
+                  << single.coast_step << ")\n";
+        all_match = results_match(batch[i], single);
+    }
+    
+    check(all_match, "Every lane reproduces its single-mission result");
+    check(batch.size() == 5 && batch[4].coast_step < 0 && batch[4].final_state.m < 100,
+          "Fuel cutoff masks a lane without coasting");
+}
+
+void test_batch_inbound_and_fallback() {
+    std::cout << "\nTest 3: Batch Missions - Inbound Transfer and Mixed-Integrator Fallback\n";
+    std::cout << "--------------------------------------------\n";
+    
+    std::vector<MissionConfig> configs = {
+        make_config(1000, 2750, 10000),
+        make_config(250, 4200, 10000)
+    };
+    double r_dep = getOrbitalRadius(CelestialBody::EARTH);
+    double r_arr = getOrbitalRadius(CelestialBody::VENUS);
+    
+    std::vector<PropagationResult> batch = propagateMissionBatch(configs, r_dep, r_arr);
+    bool inbound_match = true;
+    for (size_t i = 0; i < configs.size(); ++i) {
+        inbound_match = inbound_match &&
+                        results_match(batch[i], propagateMission(configs[i], r_dep, r_arr));
+    }
+    check(inbound_match, "Inbound lanes coast on periapsis like propagateMission");
+    
+    configs[1].integrator = "euler";
+    check(!canPropagateAsBatch(configs), "Mixed integrators cannot share a batch");
+    
+    std::vector<PropagationResult> fallback = propagateMissionBatch(configs, r_dep, r_arr);
+    check(results_match(fallback[1], propagateMission(configs[1], r_dep, r_arr)),
+          "Incompatible sets fall back to per-mission propagation");
+}
+
+void test_batch_throughput() {
+    std::cout << "\nTest 4: Batch Missions - Throughput on a 64-Lane Sweep\n";
+    std::cout << "--------------------------------------------\n";
+    
+    std::vector<MissionConfig> configs;
+    for (int i = 0; i < 64; ++i) {
+        configs.push_back(make_config(800 + 10 * i, 2500 + 20 * i, 10000 - 20 * i));
+    }
+    double r_dep = getOrbitalRadius(CelestialBody::EARTH);
+    double r_arr = getOrbitalRadius(CelestialBody::MARS);
+    
+    auto start = std::chrono::steady_clock::now();
+    std::vector<PropagationResult> batch = propagateMissionBatch(configs, r_dep, r_arr);
+    auto mid = std::chrono::steady_clock::now();
+    bool all_match = true;
+    for (size_t i = 0; i < configs.size(); ++i) {
+        all_match = results_match(batch[i], propagateMission(configs[i], r_dep, r_arr)) && all_match;
+    }
+    auto end = std::chrono::steady_clock::now();
+    
+    double batch_ms = std::chrono::duration<double, std::milli>(mid - start).count();
+    double single_ms = std::chrono::duration<double, std::milli>(end - mid).count();
+    std::cout << "    Batch: " << std::fixed << std::setprecision(1) << batch_ms
+              << " ms, one at a time: " << single_ms << " ms\n";
+    
+    // Timing is informational only; correctness is what is asserted
+    check(all_match, "Sweep lanes match single-mission results");
+}
+
+void test_preset_kernels() {
+    std::cout << "\nTest 5: Registries and Preset-Specialized Kernels\n";
+    std::cout << "--------------------------------------------\n";
+    
+    static_assert(getOrbitalRadius(CelestialBody::JUPITER) == R_JUPITER,
+                  "body lookups are constant expressions");
+    static_assert(getThrusterInfo(ThrusterPreset::LOW_POWER_ION).isp_s == 4000,
+                  "thruster lookups are constant expressions");
+    
+    CelestialBody body = CelestialBody::EARTH;
+    ThrusterPreset preset = ThrusterPreset::LOW_POWER_HALL;
+    check(findBodyByName("mars", body) && body == CelestialBody::MARS &&
+          !findBodyByName("Vulcan", body) && parseBodyName("Vulcan") == CelestialBody::EARTH &&
+          std::string(getBodyName(CelestialBody::PLUTO)) == "Pluto",
+          "Body names resolve through the registry; unknown names are reported");
+    check(findThrusterByName("High-Power Ion", preset) && preset == ThrusterPreset::HIGH_POWER_ION &&
+          getThrusterInfo(preset).thrust_mN == 450 && !findThrusterByName("Warp Drive", preset),
+          "Thruster presets resolve by name");
+    
+    // Same Low-Power Ion lanes with and without a custom lane, i.e. through
+    // the preset kernels and through the per-lane kernels
+    std::vector<MissionConfig> configs;
+    for (int i = 0; i < 6; ++i) {
+        configs.push_back(make_config(250, 4000, 6000 + 1000 * i));
+    }
+    std::vector<MissionConfig> mixed = configs;
+    mixed.push_back(make_config(300, 4000, 10000));
+    double r_dep = getOrbitalRadius(CelestialBody::EARTH);
+    double r_arr = getOrbitalRadius(CelestialBody::MARS);
+    
+    auto start = std::chrono::steady_clock::now();
+    std::vector<PropagationResult> specialized = propagateMissionBatch(configs, r_dep, r_arr);
+    auto mid = std::chrono::steady_clock::now();
+    std::vector<PropagationResult> general = propagateMissionBatch(mixed, r_dep, r_arr);
+    auto end = std::chrono::steady_clock::now();
+    std::cout << "    Preset batch: " << std::fixed << std::setprecision(1)
+              << std::chrono::duration<double, std::milli>(mid - start).count()
+              << " ms, mixed batch: "
+              << std::chrono::duration<double, std::milli>(end - mid).count() << " ms\n";
+    
+    bool identical = true;
+    bool match_single = true;
+    for (size_t i = 0; i < configs.size(); ++i) {
+        identical = identical && specialized[i].accepted_steps == general[i].accepted_steps &&
+                    specialized[i].final_state.t == general[i].final_state.t &&
+                    specialized[i].final_state.m == general[i].final_state.m &&
+                    std::equal(specialized[i].final_state.r, specialized[i].final_state.r + 3,
+                               general[i].final_state.r) &&
+                    std::equal(specialized[i].final_state.v, specialized[i].final_state.v + 3,
+                               general[i].final_state.v) &&
+                    specialized[i].total_delta_v == general[i].total_delta_v;
+        match_single = match_single &&
+                       results_match(specialized[i], propagateMission(configs[i], r_dep, r_arr));
+    }
+    check(identical, "Preset kernels reproduce the per-lane kernels bit for bit");
+    check(match_single, "Preset lanes match single-mission results");
+}
+
+void test_lane_backends() {
+    std::cout << "\nTest 6: Lane Backends - One Spacecraft per Thread\n";
+    std::cout << "--------------------------------------------\n";
+    
+    // Per-lane thrusts, a preset-only set, a fuel cutoff and an inbound set
+    std::vector<MissionConfig> outbound;
+    for (int i = 0; i < 32; ++i) {
+        outbound.push_back(make_config(800 + 10 * i, 2500 + 20 * i, 10000 - 20 * i));
+    }
+    outbound.push_back(make_config(1000, 300, 110));
+    std::vector<MissionConfig> presets(4, make_config(250, 4000, 8000));
+    std::vector<MissionConfig> inbound = {make_config(1000, 2750, 10000),
+                                          make_config(250, 4200, 10000)};
+    double r_earth = getOrbitalRadius(CelestialBody::EARTH);
+    struct Case {
+        std::vector<MissionConfig>* configs;
+        double r_arr;
+    };
+    std::vector<Case> cases = {{&outbound, getOrbitalRadius(CelestialBody::MARS)},
+                               {&presets, getOrbitalRadius(CelestialBody::MARS)},
+                               {&inbound, getOrbitalRadius(CelestialBody::VENUS)}};
+    
+    bool identical = true;
+    bool dispatched = true;
+    for (const Case& c : cases) {
+        std::vector<PropagationResult> soa = propagateMissionBatch(*c.configs, r_earth, c.r_arr);
+        std::vector<PropagationResult> lanes = propagateMissionLanes(*c.configs, r_earth, c.r_arr);
+        std::vector<MissionConfig> selected = *c.configs;
+        for (MissionConfig& config : selected) {
+            config.batch_backend = "lanes";
+        }
+        std::vector<PropagationResult> through_api =
+            propagateMissionBatch(selected, r_earth, c.r_arr);
+        for (std::size_t i = 0; i < soa.size(); ++i) {
+            identical = identical && results_identical(soa[i], lanes[i]);
+            dispatched = dispatched && results_identical(soa[i], through_api[i]);
+        }
+    }
+    check(identical, "Lane kernel reproduces the SoA kernels bit for bit");
+    check(dispatched, "batch_backend \"lanes\" runs behind propagateMissionBatch");
+    
+    std::vector<MissionConfig> mixed = inbound;
+    mixed[1].batch_backend = "lanes";
+    check(!canPropagateAsBatch(mixed), "Mixed backends do not share a batch");
+    check(isBatchBackend("gpu") && !isBatchBackend("fpga"), "Backend names are validated");
+    
+    // Without a device (or a CUDA build) "gpu" falls back to the SoA kernels
+    std::cout << "    GPU backend: " << gpuBatchDescription() << "\n";
+    std::vector<MissionConfig> gpu = inbound;
+    for (MissionConfig& config : gpu) {
+        config.batch_backend = "gpu";
+    }
+    std::vector<PropagationResult> gpu_results;
+    bool ran = propagateMissionLanesGpu(gpu, r_earth, getOrbitalRadius(CelestialBody::VENUS),
+                                        gpu_results);
+    std::vector<PropagationResult> via_api =
+        propagateMissionBatch(gpu, r_earth, getOrbitalRadius(CelestialBody::VENUS));
+    std::vector<PropagationResult> soa =
+        propagateMissionBatch(inbound, r_earth, getOrbitalRadius(CelestialBody::VENUS));
+    bool same = ran == gpuBatchAvailable() && via_api.size() == soa.size();
+    for (std::size_t i = 0; same && i < soa.size(); ++i) {
+        same = results_identical(via_api[i], soa[i]) &&
+               (!ran || results_identical(gpu_results[i], soa[i]));
+    }
+    check(same, "GPU backend matches the SoA kernels, or falls back to them");
+}
+
+// ===========================================================================
+// MAIN TEST RUNNER
+// ===========================================================================
+
+int main() {
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "BATCH PROPAGATION TEST SUITE\n";
+    std::cout << "=====================================================\n";
+    
+    test_batch_step_matches_rk4();
+    test_batch_missions_match_single();
+    test_batch_inbound_and_fallback();
+    test_batch_throughput();
+    test_preset_kernels();
+    test_lane_backends();
+    
+    // Summary
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "TEST RESULTS\n";
+    std::cout << "=====================================================\n";
+    std::cout << "  Tests passed: " << tests_passed << "\n";
+    std::cout << "  Tests failed: " << tests_failed << "\n";
+    std::cout << "  Total tests:  " << (tests_passed + tests_failed) << "\n";
+    
+    if (tests_failed == 0) {
+        std::cout << "\n  ✓ ALL TESTS PASSED\n";
+        std::cout << "=====================================================\n\n";
+        return 0;
+    } else {
+        std::cout << "\n  ✗ SOME TESTS FAILED\n";
+        std::cout << "=====================================================\n\n";
+        return 1;
+    }
+}
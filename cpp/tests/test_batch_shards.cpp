@@ -0,0 +1,288 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdio>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "../src/comparison.h"
+#include "../src/batch_shards.h"
+
+// ===========================================================================
+// TEST FRAMEWORK HELPERS
+// ===========================================================================
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+void check(bool condition, const std::string& test_name) {
+    if (condition) {
+        std::cout << "  ✓ PASS: " << test_name << "\n";
+        tests_passed++;
+    } else {
+        std::cout << "  ✗ FAIL: " << test_name << "\n";
+        tests_failed++;
+    }
+}
+
+/// Mission k of a synthetic batch, with values that need all 17 digits
+MissionResult synthetic_mission(std::size_t k) {
+    static const char* thrusters[] = {"Low-Power Hall", "High-Power Hall", "Gridded Ion"};
+    MissionResult mission;
+    mission.mission_name = "mission_" + std::to_string(k);
+    mission.thruster_name = thrusters[k % 3];
+    mission.departure_body = "Earth";
+    mission.arrival_body = (k % 2 == 0) ? "Mars" : "Venus";
+    mission.flight_time_days = 200.0 + static_cast<double>(k) / 3.0;
+    mission.total_delta_v_km_s = 3.0 + std::sqrt(static_cast<double>(k + 2));
+    mission.initial_mass_kg = 2000.0;
+    mission.propellant_consumed_kg = 500.0 + static_cast<double>(k) / 7.0;
+    mission.final_mass_kg = mission.initial_mass_kg - mission.propellant_consumed_kg;
+    mission.final_apoapsis_km = 2.279e8 + static_cast<double>(k) / 11.0;
+    mission.final_periapsis_km = 2.061e8 - static_cast<double>(k) / 13.0;
+    mission.final_eccentricity = 0.05 + static_cast<double>(k) * 1e-17;
+    mission.final_semi_major_axis_km = 0.5 * (mission.final_apoapsis_km +
+                                              mission.final_periapsis_km);
+    return mission;
+}
+
+/// Every field of two results is identical (doubles bit for bit)
+bool same_mission(const MissionResult& a, const MissionResult& b) {
+    auto same = [](double x, double y) {
+        return (x == y && std::signbit(x) == std::signbit(y)) || (std::isnan(x) && std::isnan(y));
+    };
+    return a.mission_name == b.mission_name && a.thruster_name == b.thruster_name &&
+           a.departure_body == b.departure_body && a.arrival_body == b.arrival_body &&
+           same(a.flight_time_days, b.flight_time_days) &&
+           same(a.total_delta_v_km_s, b.total_delta_v_km_s) &&
+           same(a.propellant_consumed_kg, b.propellant_consumed_kg) &&
+           same(a.final_mass_kg, b.final_mass_kg) &&
+           same(a.initial_mass_kg, b.initial_mass_kg) &&
+           same(a.final_apoapsis_km, b.final_apoapsis_km) &&
+           same(a.final_periapsis_km, b.final_periapsis_km) &&
+           same(a.final_eccentricity, b.final_eccentricity) &&
+           same(a.final_semi_major_axis_km, b.final_semi_major_axis_km) &&
+           same(a.payload_fraction, b.payload_fraction) &&
+           same(a.specific_impulse_achieved, b.specific_impulse_achieved) &&
+           same(a.fuel_efficiency, b.fuel_efficiency) &&
+           same(a.transfer_efficiency, b.transfer_efficiency) &&
+           a.pruned == b.pruned;
+}
+
+std::string read_file(const std::string& path) {
+    std::ifstream file(path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+/// Run a synthetic batch of total missions as a single process
+MissionComparison full_batch(std::size_t total, bool pruned) {
+    MissionComparison comparison;
+    for (std::size_t k = 0; k < total; k++) {
+        MissionResult mission = synthetic_mission(k);
+        mission.pruned = pruned && k % 4 == 3;
+        comparison.addMission(mission);
+    }
+    comparison.computeMetrics();
+    comparison.setPruned(pruned);
+    return comparison;
+}
+
+/// Run shard spec of the synthetic batch and write its partial file
+std::string write_shard(const ShardSpec& spec, std::size_t total, bool pruned) {
+    MissionComparison full = full_batch(total, pruned);
+    std::vector<std::size_t> indices = shardMissions(spec, total);
+    MissionComparison shard;
+    for (std::size_t index : indices) {
+        shard.addMission(full.getMissions()[index]);
+    }
+    shard.setPruned(pruned);
+    std::string filename = shardFileName(".", spec);
+    writeShardCSV(filename, spec, total, indices, shard);
+    return filename;
+}
+
+// ===========================================================================
+// SHARD ASSIGNMENT TESTS
+// ===========================================================================
+
+void test_assignment() {
+    std::cout << "\nTest 1: Shards - Spec Parsing and Round-Robin Assignment\n";
+    std::cout << "--------------------------------------------\n";
+    
+    ShardSpec spec;
+    check(parseShardSpec("2/3", spec) && spec.index == 2 && spec.count == 3,
+          "\"2/3\" is shard 2 of 3");
+    std::cout << "  (warnings below are expected)\n";
+    bool rejected = true;
+    for (const char* text : {"0/3", "4/3", "2/", "/3", "a/b", "2/3x", ""}) {
+        ShardSpec bad;
+        rejected = rejected && !parseShardSpec(text, bad) && bad.index == 1 && bad.count == 1;
+    }
+    check(rejected, "Out-of-range and malformed specs are rejected");
+    
+    // Every mission lands in exactly one shard, whatever the shard count
+    bool covered = true;
+    for (unsigned count = 1; count <= 5; count++) {
+        std::vector<int> hits(11, 0);
+        for (unsigned index = 1; index <= count; index++) {
+            for (std::size_t k : shardMissions({index, count}, hits.size())) {
+                hits[k]++;
+                covered = covered && k % count == index - 1;
+            }
+        }
+        for (int h : hits) {
+            covered = covered && h == 1;
+        }
+    }
+    check(covered, "Shards partition the batch with stride N");
+    check(shardMissions({4, 4}, 3).empty(), "Shards beyond the batch size are empty");
+    check(shardFileName("../results", {2, 3}) == "../results/mission_comparison.shard-2-of-3.csv",
+          "Partial files are named after their shard");
+}
+
+// ===========================================================================
+// PARTIAL FILE TESTS
+// ===========================================================================
+
+void test_rows() {
+    std::cout << "\nTest 2: Rows - Round-Trip Precision and Malformed Input\n";
+    std::cout << "--------------------------------------------\n";
+    
+    MissionResult mission = synthetic_mission(5);
+    computeMissionMetrics(mission);
+    mission.final_eccentricity = std::numeric_limits<double>::denorm_min();
+    mission.final_periapsis_km = -0.0;
+    mission.fuel_efficiency = std::numeric_limits<double>::infinity();
+    mission.pruned = true;
+    
+    MissionResult parsed;
+    std::size_t index = 0;
+    check(parseShardRow(formatShardRow(41, mission), index, parsed) && index == 41,
+          "Rows parse back with their batch index");
+    check(same_mission(mission, parsed), "Every field survives bit for bit");
+    
+    std::string row = formatShardRow(3, synthetic_mission(3));
+    check(!parseShardRow(row + ",1", index, parsed), "Rows with an extra field are rejected");
+    std::string bad_number = row;
+    bad_number.replace(bad_number.find(",201,"), 5, ",2x1,");
+    check(!parseShardRow(bad_number, index, parsed), "Rows with a bad number are rejected");
+}
+
+// ===========================================================================
+// MERGE TESTS
+// ===========================================================================
+
+void test_merge() {
+    std::cout << "\nTest 3: Merge - Same Comparison as a Single Process\n";
+    std::cout << "--------------------------------------------\n";
+    
+    const std::size_t total = 10;
+    for (bool pruned : {false, true}) {
+        std::string label = pruned ? " (pruned run)" : "";
+        MissionComparison full = full_batch(total, pruned);
+        full.writeComparisonCSV("test_batch_shards_full.csv");
+        
+        // Shards come back in any order
+        std::vector<std::string> files = {write_shard({3, 3}, total, pruned),
+                                          write_shard({1, 3}, total, pruned),
+                                          write_shard({2, 3}, total, pruned)};
+        MissionComparison merged;
+        bool ok = mergeShards(files, merged);
+        check(ok && merged.getMissions().size() == total && merged.isPruned() == pruned,
+              "Three shards merge into the whole batch" + label);
+        
+        bool same = ok;
+        for (std::size_t k = 0; same && k < total; k++) {
+            same = same_mission(full.getMissions()[k], merged.getMissions()[k]);
+        }
+        check(same, "Merged results are in batch order, bit for bit" + label);
+        
+        merged.writeComparisonCSV("test_batch_shards_merged.csv");
+        std::string expected = read_file("test_batch_shards_full.csv");
+        check(!expected.empty() && read_file("test_batch_shards_merged.csv") == expected,
+              "Merged mission_comparison.csv is byte-identical" + label);
+        
+        for (const std::string& file : files) {
+            std::remove(file.c_str());
+        }
+    }
+    std::remove("test_batch_shards_full.csv");
+    std::remove("test_batch_shards_merged.csv");
+}
+
+void test_merge_errors() {
+    std::cout << "\nTest 4: Merge - Missing, Duplicate and Foreign Shards\n";
+    std::cout << "--------------------------------------------\n";
+    
+    const std::size_t total = 7;
+    std::string first = write_shard({1, 2}, total, false);
+    std::string second = write_shard({2, 2}, total, false);
+    std::string foreign = write_shard({2, 3}, total, false);
+    std::string other_batch = "test_batch_shards_other.csv";
+    {
+        // Shard 2 of 2, but of an 8-mission batch
+        MissionComparison shard;
+        std::vector<std::size_t> indices = shardMissions({2, 2}, 8);
+        for (std::size_t index : indices) {
+            shard.addMission(synthetic_mission(index));
+        }
+        writeShardCSV(other_batch, {2, 2}, 8, indices, shard);
+    }
+    
+    MissionComparison merged;
+    std::cout << "  (errors below are expected)\n";
+    check(mergeShards({first, second}, merged), "Both shards of a batch merge");
+    check(!mergeShards({first}, merged), "A missing shard fails the merge");
+    check(!mergeShards({first, second, second}, merged), "A shard given twice fails the merge");
+    check(!mergeShards({first, foreign}, merged), "Shards of different splits do not merge");
+    check(!mergeShards({first, other_batch}, merged), "Shards of different batches do not merge");
+    check(!mergeShards({first, "test_batch_shards_missing.csv"}, merged),
+          "An unreadable file fails the merge");
+    
+    MissionComparison too_few;
+    too_few.addMission(synthetic_mission(0));
+    check(!writeShardCSV("test_batch_shards_short.csv", {1, 2}, total,
+                         shardMissions({1, 2}, total), too_few),
+          "A shard with missing results is not written");
+    
+    for (const std::string& file : {first, second, foreign, other_batch}) {
+        std::remove(file.c_str());
+    }
+}
+
+// ===========================================================================
+// MAIN TEST RUNNER
+// ===========================================================================
+
+int main() {
+    std::cout << "=====================================================\n";
+    std::cout << "SHARDED BATCH TEST SUITE\n";
+    std::cout << "=====================================================\n";
+    
+    test_assignment();
+    test_rows();
+    test_merge();
+    test_merge_errors();
+    
+    // Summary
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "TEST RESULTS\n";
+    std::cout << "=====================================================\n";
+    std::cout << "  Tests passed: " << tests_passed << "\n";
+    std::cout << "  Tests failed: " << tests_failed << "\n";
+    std::cout << "  Total tests:  " << (tests_passed + tests_failed) << "\n";
+    
+    if (tests_failed == 0) {
+        std::cout << "\n  ✓ ALL TESTS PASSED\n";
+        std::cout << "=====================================================\n\n";
+        return 0;
+    } else {
+        std::cout << "\n  ✗ SOME TESTS FAILED\n";
+        std::cout << "=====================================================\n\n";
+        return 1;
+    }
+}
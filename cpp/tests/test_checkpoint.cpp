@@ -0,0 +1,382 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdio>
+#include <cmath>
+#include <filesystem>
+#include <vector>
+#include "../src/constants.h"
+#include "../src/propagator.h"
+#include "../src/mission_propagation.h"
+#include "../src/trajectory_sink.h"
+#include "../src/trajectory_file.h"
+#include "../src/checkpoint.h"
+#include "test_mission_config.h"
+
+// ===========================================================================
+// TEST FRAMEWORK HELPERS
+// ===========================================================================
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+void check(bool condition, const std::string& test_name) {
+    if (condition) {
+        std::cout << "  ✓ PASS: " << test_name << "\n";
+        tests_passed++;
+    } else {
+        std::cout << "  ✗ FAIL: " << test_name << "\n";
+        tests_failed++;
+    }
+}
+
+/// The shared test mission, checkpointing every 1000 steps
+MissionConfig make_checkpoint_config() {
+    MissionConfig config = make_test_config();
+    config.checkpoint_interval = 1000;
+    config.checkpoint_file = "test_checkpoint.ckpt";
+    return config;
+}
+
+bool same_state(const MissionState& a, const MissionState& b) {
+    return a.r[0] == b.r[0] && a.r[1] == b.r[1] && a.r[2] == b.r[2] &&
+           a.v[0] == b.v[0] && a.v[1] == b.v[1] && a.v[2] == b.v[2] &&
+           a.m == b.m && a.t == b.t;
+}
+
+bool same_result(const PropagationResult& a, const PropagationResult& b) {
+    bool same = same_state(a.final_state, b.final_state) &&
+                a.total_delta_v == b.total_delta_v && a.coast_step == b.coast_step &&
+                a.accepted_steps == b.accepted_steps && a.rejected_steps == b.rejected_steps &&
+                a.events.size() == b.events.size();
+    for (size_t i = 0; same && i < a.events.size(); i++) {
+        same = a.events[i].type == b.events[i].type && same_state(a.events[i].state, b.events[i].state);
+    }
+    return same;
+}
+
+std::string read_file(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+bool file_exists(const std::string& filename) {
+    return std::filesystem::exists(filename);
+}
+
+/// Copy files aside at one step, as they would be on disk if the process
+/// died there; files that do not exist yet are skipped
+class SnapshotSink : public TrajectorySink {
+public:
+    SnapshotSink(TrajectorySink& downstream, long snapshot_step,
+                 const std::vector<std::string>& files)
+        : downstream(downstream), snapshot_step(snapshot_step), files(files) {}
+    
+    bool wantsStep(long step) const override {
+        return step == snapshot_step || downstream.wantsStep(step);
+    }
+    void record(long step, const MissionState& state,
+                const OrbitalElements& elements) override {
+        if (step == snapshot_step) {
+            for (const std::string& file : files) {
+                if (file_exists(file)) {
+                    std::filesystem::copy_file(file, file + ".saved",
+                                               std::filesystem::copy_options::overwrite_existing);
+                }
+            }
+        }
+        if (downstream.wantsStep(step)) {
+            downstream.record(step, state, elements);
+        }
+    }
+    void finish(long step, const MissionState& final_state,
+                const OrbitalElements& elements) override {
+        downstream.finish(step, final_state, elements);
+    }
+    bool saveCheckpoint(SinkCheckpoint& checkpoint) override {
+        return downstream.saveCheckpoint(checkpoint);
+    }
+    bool restoreCheckpoint(SinkCheckpoint& checkpoint) override {
+        return downstream.restoreCheckpoint(checkpoint);
+    }
+
+private:
+    TrajectorySink& downstream;
+    long snapshot_step;
+    std::vector<std::string> files;
+};
+
+/// Put the snapshot back in place of the finished run's files
+void restore_snapshot(const std::vector<std::string>& files) {
+    for (const std::string& file : files) {
+        std::remove(file.c_str());
+        if (file_exists(file + ".saved")) {
+            std::filesystem::rename(file + ".saved", file);
+        }
+    }
+}
+
+// ===========================================================================
+// CHECKPOINT FILE TESTS
+// ===========================================================================
+
+void test_checkpoint_file_round_trip() {
+    std::cout << "\nTest 1: Checkpoint File - Bit-Exact Round Trip\n";
+    std::cout << "--------------------------------------------\n";
+    
+    MissionConfig config = make_checkpoint_config();
+    PropagationCheckpoint checkpoint;
+    checkpoint.config_key = checkpointKey(config);
+    checkpoint.step = 4321;
+    checkpoint.state = MissionState(1.5e8, -2.0e7, 3.0, 1.0 / 3.0, 29.7, -1e-9, 9876.5, 4.321e7);
+    checkpoint.total_delta_v = 2.0 / 3.0;
+    checkpoint.dt_next = 12345.678;
+    checkpoint.next_coast_check_t = 4.4e7;
+    checkpoint.accepted_steps = 4000;
+    checkpoint.rejected_steps = 321;
+    checkpoint.handed_off = true;
+    checkpoint.averaged_steps = 77;
+    checkpoint.events.push_back(MissionEvent("radius_crossing", checkpoint.state, false));
+    checkpoint.sink.put(std::int64_t(-1));
+    checkpoint.sink.put(0.1);
+    
+    check(writeCheckpoint(config.checkpoint_file, checkpoint), "Checkpoint written");
+    check(!file_exists(config.checkpoint_file + ".tmp"), "No temporary file left behind");
+    
+    PropagationCheckpoint loaded;
+    check(findCheckpoint(config, loaded), "Checkpoint found for its own config");
+    double sink_value = 0;
+    std::int64_t sink_offset = 0;
+    check(loaded.step == checkpoint.step && same_state(loaded.state, checkpoint.state) &&
+          loaded.total_delta_v == checkpoint.total_delta_v &&
+          loaded.dt_next == checkpoint.dt_next &&
+          loaded.next_coast_check_t == checkpoint.next_coast_check_t &&
+          loaded.accepted_steps == 4000 && loaded.rejected_steps == 321 &&
+          loaded.handed_off && loaded.averaged_steps == 77,
+          "Loop state restored bit for bit");
+    check(loaded.events.size() == 1 && loaded.events[0].type == "radius_crossing" &&
+          same_state(loaded.events[0].state, checkpoint.state),
+          "Events restored");
+    check(loaded.sink.get(sink_offset) && loaded.sink.get(sink_value) &&
+          sink_offset == -1 && sink_value == 0.1 && !loaded.sink.get(sink_value),
+          "Sink position restored, and reading past it fails");
+    
+    MissionConfig other = config;
+    other.timestep_s = 5000;
+    check(!findCheckpoint(other, loaded), "Checkpoint of another config ignored");
+    
+    // Truncated file is rejected
+    std::string contents = read_file(config.checkpoint_file);
+    std::ofstream truncated(config.checkpoint_file, std::ios::binary);
+    truncated << contents.substr(0, contents.size() - 4);
+    truncated.close();
+    check(!readCheckpoint(config.checkpoint_file, loaded), "Truncated checkpoint rejected");
+    
+    std::remove(config.checkpoint_file.c_str());
+    check(!findCheckpoint(config, loaded), "Missing checkpoint is not found");
+}
+
+// ===========================================================================
+// RESUME TESTS
+// ===========================================================================
+
+void test_resume_matches_uninterrupted_run() {
+    std::cout << "\nTest 2: Resume - Same Result and Trajectory Files as One Run\n";
+    std::cout << "--------------------------------------------\n";
+    
+    MissionConfig config = make_checkpoint_config();
+    double r_dep = getOrbitalRadius(CelestialBody::EARTH);
+    double r_arr = getOrbitalRadius(CelestialBody::MARS);
+    const std::string csv_path = "test_checkpoint_trajectory.csv";
+    const std::string bin_path = "test_checkpoint_trajectory.bin";
+    const std::string spill_path = bin_path + ".part";
+    const std::vector<std::string> files = {config.checkpoint_file, csv_path, spill_path};
+    
+    // Small blocks so the binary sink spills before and after the checkpoint
+    PropagationResult reference;
+    {
+        BinaryTrajectorySink binary(bin_path, config, 1, 64);
+        CsvTrajectorySink csv(csv_path);
+        TeeTrajectorySink tee(binary, csv);
+        DecimatingTrajectorySink decimated(tee, 3);
+        SnapshotSink snapshot(decimated, 2500, files);  // Dies 500 steps after a checkpoint
+        reference = propagateMission(config, r_dep, r_arr, snapshot);
+    }
+    check(reference.accepted_steps > 3000, "Mission runs past the snapshot");
+    check(!file_exists(config.checkpoint_file), "Finished run removes its checkpoint");
+    std::string reference_csv = read_file(csv_path);
+    std::string reference_bin = read_file(bin_path);
+    
+    restore_snapshot(files);
+    check(file_exists(config.checkpoint_file) && file_exists(spill_path),
+          "Snapshot holds a checkpoint and spilled blocks");
+    
+    PropagationResult resumed;
+    config.resume = true;
+    {
+        BinaryTrajectorySink binary(bin_path, config, 1, 64);
+        CsvTrajectorySink csv(csv_path, SinkOpenMode::RESUME);
+        TeeTrajectorySink tee(binary, csv);
+        DecimatingTrajectorySink decimated(tee, 3);
+        resumed = propagateMission(config, r_dep, r_arr, decimated);
+    }
+    check(same_result(resumed, reference), "Resumed result equals the uninterrupted run");
+    check(read_file(csv_path) == reference_csv, "CSV trajectory byte-identical");
+    check(read_file(bin_path) == reference_bin, "Binary trajectory byte-identical");
+    check(!file_exists(config.checkpoint_file) && !file_exists(spill_path),
+          "Resumed run cleans up checkpoint and spill file");
+    
+    std::remove(csv_path.c_str());
+    std::remove(bin_path.c_str());
+}
+
+void test_resume_adaptive_with_events() {
+    std::cout << "\nTest 3: Resume - Adaptive Integrator, Bracketed Check, Events\n";
+    std::cout << "--------------------------------------------\n";
+    
+    MissionConfig config = make_checkpoint_config();
+    config.integrator = "rk45";
+    config.coast_check = "bracketed";
+    config.locate_coast = true;
+    config.checkpoint_interval = 20;
+    EventSpec crossing;
+    crossing.type = "radius_crossing";
+    crossing.value = 1.8e8;
+    config.events.push_back(crossing);
+    config.output_format = "csv";
+    double r_dep = getOrbitalRadius(CelestialBody::EARTH);
+    double r_arr = getOrbitalRadius(CelestialBody::MARS);
+    const std::string csv_path = "test_checkpoint_adaptive.csv";
+    
+    // Reference without checkpoints, through the file-writing overload
+    MissionConfig plain = config;
+    plain.checkpoint_interval = 0;
+    PropagationResult reference = propagateMission(plain, r_dep, r_arr, true, csv_path);
+    std::string reference_csv = read_file(csv_path);
+    check(reference.events.size() >= 2 && reference.accepted_steps > 100,
+          "Reference run locates the crossing and coast");
+    
+    // Interrupted run (same sink chain as the overload), then resume
+    const std::vector<std::string> files = {config.checkpoint_file, csv_path};
+    {
+        CsvTrajectorySink csv(csv_path);
+        DecimatingTrajectorySink decimated(csv, config.save_interval);
+        SnapshotSink snapshot(decimated, reference.accepted_steps - 20, files);
+        propagateMission(config, r_dep, r_arr, snapshot);
+    }
+    restore_snapshot(files);
+    PropagationCheckpoint saved;
+    check(findCheckpoint(config, saved) && !saved.events.empty() && saved.rejected_steps >= 0,
+          "Checkpoint carries the events located so far");
+    
+    config.resume = true;
+    PropagationResult resumed = propagateMission(config, r_dep, r_arr, true, csv_path);
+    check(same_result(resumed, reference), "Resumed result equals a run without checkpoints");
+    check(read_file(csv_path) == reference_csv, "CSV trajectory byte-identical");
+    
+    // Nothing left to resume: the next run starts from the beginning
+    PropagationResult again = propagateMission(config, r_dep, r_arr, true, csv_path);
+    check(same_result(again, reference) && read_file(csv_path) == reference_csv,
+          "Resume without a checkpoint runs from the start");
+    
+    std::remove(csv_path.c_str());
+}
+
+void test_resume_averaged_after_handoff() {
+    std::cout << "\nTest 4: Resume - Averaged Propagator Past Its RK4 Handoff\n";
+    std::cout << "--------------------------------------------\n";
+    
+    MissionConfig config = make_checkpoint_config();
+    config.integrator = "averaged";
+    config.checkpoint_interval = 20;
+    double r_dep = getOrbitalRadius(CelestialBody::EARTH);
+    double r_arr = getOrbitalRadius(CelestialBody::MARS);
+    
+    MissionConfig plain = config;
+    plain.checkpoint_interval = 0;
+    PropagationResult reference = propagateMission(plain, r_dep, r_arr);
+    check(reference.averaged_steps > 0 && reference.accepted_steps > reference.averaged_steps + 40,
+          "Reference run hands off to RK4 well before coast");
+    
+    // Die in the RK4 tail: resuming must not go back to averaging
+    const std::vector<std::string> files = {config.checkpoint_file};
+    {
+        NullTrajectorySink null_sink;
+        SnapshotSink snapshot(null_sink, reference.accepted_steps - 10, files);
+        propagateMission(config, r_dep, r_arr, snapshot);
+    }
+    restore_snapshot(files);
+    PropagationCheckpoint saved;
+    check(findCheckpoint(config, saved) && saved.handed_off &&
+          saved.averaged_steps == reference.averaged_steps,
+          "Checkpoint records the handoff");
+    
+    config.resume = true;
+    PropagationResult resumed = propagateMission(config, r_dep, r_arr);
+    check(same_result(resumed, reference) && resumed.averaged_steps == reference.averaged_steps,
+          "Resumed result equals the uninterrupted run");
+}
+
+void test_resume_ignores_foreign_checkpoint() {
+    std::cout << "\nTest 5: Resume - Checkpoint of Another Config Is Not Used\n";
+    std::cout << "--------------------------------------------\n";
+    
+    MissionConfig config = make_checkpoint_config();
+    double r_dep = getOrbitalRadius(CelestialBody::EARTH);
+    double r_arr = getOrbitalRadius(CelestialBody::MARS);
+    
+    PropagationCheckpoint foreign;
+    foreign.config_key = checkpointKey(config) ^ 1;
+    foreign.step = 3000;
+    foreign.state = MissionState(2e8, 0, 0, 0, 20, 0, 5000, 3e7);
+    writeCheckpoint(config.checkpoint_file, foreign);
+    
+    MissionConfig plain = config;
+    plain.checkpoint_interval = 0;
+    PropagationResult reference = propagateMission(plain, r_dep, r_arr);
+    
+    config.resume = true;
+    PropagationResult resumed = propagateMission(config, r_dep, r_arr);
+    check(same_result(resumed, reference), "Mission propagated from the start");
+    check(!file_exists(config.checkpoint_file), "Stale checkpoint replaced and removed");
+}
+
+// ===========================================================================
+// MAIN TEST RUNNER
+// ===========================================================================
+
+int main() {
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "CHECKPOINT / RESUME TEST SUITE\n";
+    std::cout << "=====================================================\n";
+    
+    test_checkpoint_file_round_trip();
+    test_resume_matches_uninterrupted_run();
+    test_resume_adaptive_with_events();
+    test_resume_averaged_after_handoff();
+    test_resume_ignores_foreign_checkpoint();
+    
+    // Summary
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "TEST RESULTS\n";
+    std::cout << "=====================================================\n";
+    std::cout << "  Tests passed: " << tests_passed << "\n";
+    std::cout << "  Tests failed: " << tests_failed << "\n";
+    std::cout << "  Total tests:  " << (tests_passed + tests_failed) << "\n";
+    
+    if (tests_failed == 0) {
+        std::cout << "\n  ✓ ALL TESTS PASSED\n";
+        std::cout << "=====================================================\n\n";
+        return 0;
+    } else {
+        std::cout << "\n  ✗ SOME TESTS FAILED\n";
+        std::cout << "=====================================================\n\n";
+        return 1;
+    }
+}
@@ -0,0 +1,226 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <cstdio>
+#include <cmath>
+#include <vector>
+#include "../src/constants.h"
+#include "../src/propagator.h"
+#include "../src/mission_propagation.h"
+#include "../src/convergence_study.h"
+
+// ===========================================================================
+// TEST FRAMEWORK HELPERS
+// ===========================================================================
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+void check(bool condition, const std::string& test_name) {
+    if (condition) {
+        std::cout << "  ✓ PASS: " << test_name << "\n";
+        tests_passed++;
+    } else {
+        std::cout << "  ✗ FAIL: " << test_name << "\n";
+        tests_failed++;
+    }
+}
+
+/// Write text to a scratch file
+void write_file(const std::string& filename, const std::string& text) {
+    std::ofstream file(filename);
+    file << text;
+}
+
+std::string read_file(const std::string& filename) {
+    std::ifstream file(filename);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+/// The mission of config/convergence_test.yaml, with its coast located
+ConvergenceSpec make_test_spec() {
+    ConvergenceSpec spec;
+    spec.base.spacecraft.name = "High-Power Ion";
+    spec.base.spacecraft.thrust_mN = 450;
+    spec.base.spacecraft.isp_s = 9000;
+    spec.base.spacecraft.initial_mass_kg = 1000;
+    spec.base.max_flight_time_s = 86400000;
+    spec.base.coast_threshold = 0.99;
+    spec.base.locate_coast = true;
+    spec.timesteps = {8000, 4000, 2000, 1000};
+    return spec;
+}
+
+// ===========================================================================
+// ORDER AND EXTRAPOLATION TESTS
+// ===========================================================================
+
+void test_observed_order() {
+    std::cout << "\nTest 1: Observed Order - Exact Models, Uneven Ladders\n";
+    std::cout << "--------------------------------------------\n";
+    
+    // f(h) = 3 + 2 h^p on a ladder with ratios 2 and 2.5
+    const double h[3] = {0.1, 0.05, 0.02};
+    bool recovered = true;
+    bool extrapolated = true;
+    for (double p : {1.0, 2.5, 4.0}) {
+        double f[3];
+        for (int k = 0; k < 3; k++) {
+            f[k] = 3.0 + 2.0 * std::pow(h[k], p);
+        }
+        double order = observedOrder(h, f);
+        recovered = recovered && std::abs(order - p) < 1e-8;
+        extrapolated = extrapolated &&
+                       std::abs(richardsonExtrapolate(h[1], f[1], h[2], f[2], order) - 3.0) < 1e-12;
+    }
+    check(recovered, "Orders 1, 2.5 and 4 recovered from three levels");
+    check(extrapolated, "Richardson extrapolation removes the error term");
+    
+    const double oscillating[3] = {1.0, 1.2, 1.1};
+    const double converged[3] = {1.0, 2.0, 2.0};
+    const double unsorted[3] = {0.02, 0.05, 0.1};
+    const double rising[3] = {1.0, 2.0, 3.0};
+    check(std::isnan(observedOrder(h, oscillating)) && std::isnan(observedOrder(h, converged)),
+          "No order when the differences change sign or vanish");
+    check(std::isnan(observedOrder(unsorted, rising)), "No order unless h decreases");
+    check(richardsonExtrapolate(0.05, 1.2, 0.02, 1.1, std::nan("")) == 1.1,
+          "Without an order the reference is the finest value");
+}
+
+// ===========================================================================
+// STUDY TESTS
+// ===========================================================================
+
+void test_study() {
+    std::cout << "\nTest 2: Study - Same Runs as propagateMission, Any Jobs\n";
+    std::cout << "--------------------------------------------\n";
+    
+    ConvergenceSpec spec = make_test_spec();
+    ConvergenceResult serial = runConvergenceStudy(spec, 1);
+    ConvergenceResult parallel = runConvergenceStudy(spec, 3);
+    check(serial.methods.size() == 2 && serial.methods[0].method == "rk4" &&
+          serial.methods[1].method == "euler" && serial.methods[0].runs.size() == 4,
+          "One run per method and timestep");
+    
+    bool identical = serial.methods.size() == parallel.methods.size();
+    for (std::size_t m = 0; identical && m < serial.methods.size(); m++) {
+        for (std::size_t k = 0; k < serial.methods[m].runs.size(); k++) {
+            identical = identical &&
+                        serial.methods[m].runs[k].values == parallel.methods[m].runs[k].values &&
+                        serial.methods[m].runs[k].steps == parallel.methods[m].runs[k].steps;
+        }
+    }
+    check(identical, "Same results with 3 jobs");
+    
+    MissionConfig config = spec.base;
+    config.integrator = "euler";
+    config.timestep_s = 2000;
+    PropagationResult direct = propagateMission(config, getOrbitalRadius(CelestialBody::EARTH),
+                                                getOrbitalRadius(CelestialBody::MARS), false);
+    const ConvergenceRun& run = serial.methods[1].runs[2];
+    check(run.timestep_s == 2000 && run.coasted &&
+          run.values[0] == direct.final_state.t / 86400.0 &&
+          run.values[1] == direct.total_delta_v && run.values[2] == direct.final_state.m,
+          "Runs match a direct propagateMission bit for bit");
+    
+    // Thrust arcs hold the mass over each step, so both methods are first
+    // order here; rk4's error constant is far smaller
+    const MethodConvergence& rk4 = serial.methods[0];
+    const MethodConvergence& euler = serial.methods[1];
+    std::cout << "    Flight-time order: rk4 " << std::setprecision(3) << rk4.order[0]
+              << ", euler " << euler.order[0] << "\n";
+    check(std::abs(euler.order[0] - 1.0) < 0.1 && std::abs(euler.order[1] - 1.0) < 0.1,
+          "Euler converges at first order");
+    double euler_error = std::abs(euler.runs[3].values[0] - euler.extrapolated[0]);
+    double rk4_error = std::abs(rk4.runs[3].values[0] - rk4.extrapolated[0]);
+    check(rk4_error < 0.1 * euler_error, "RK4 error far below Euler's at the finest step");
+    check(std::abs(rk4.extrapolated[0] - euler.extrapolated[0]) < 0.01 * euler_error,
+          "Both references agree far better than the finest runs");
+}
+
+void test_spec_loader() {
+    std::cout << "\nTest 3: Spec Loader - Ladder, Methods, Results Table, Errors\n";
+    std::cout << "--------------------------------------------\n";
+    
+    const std::string filename = "test_convergence_spec.yaml";
+    write_file(filename,
+               "mission: {departure_body: Earth, arrival_body: Mars, initial_mass_kg: 1000}\n"
+               "spacecraft: {thrust_mN: 450, isp_s: 9000}\n"
+               "integration: {method: rk4, timestep_s: 1000, max_flight_time_s: 86400000}\n"
+               "propagation: {coast_threshold: 0.99}\n");
+    ConvergenceSpec defaults;
+    check(loadConvergenceFromYAML(filename, defaults) &&
+          defaults.timesteps == std::vector<double>{10000, 5000, 2000, 1000} &&
+          defaults.methods == std::vector<std::string>{"rk4", "euler"} &&
+          defaults.base.spacecraft.initial_mass_kg == 1000 &&
+          defaults.base.coast_threshold == 0.99,
+          "A plain mission file runs the default ladder");
+    
+    write_file(filename,
+               "spacecraft: {thrust_mN: 450, isp_s: 9000}\n"
+               "convergence:\n"
+               "  timesteps: [2000, 8000, 4000, 2000]\n"
+               "  methods: [euler]\n"
+               "  output: spec_convergence.csv\n");
+    ConvergenceSpec spec;
+    check(loadConvergenceFromYAML(filename, spec) &&
+          spec.timesteps == std::vector<double>{8000, 4000, 2000} &&
+          spec.methods == std::vector<std::string>{"euler"} &&
+          spec.output_filename == "spec_convergence.csv",
+          "Section read; timesteps sorted coarse to fine without repeats");
+    
+    const std::string table = "test_convergence_table.csv";
+    ConvergenceResult result = runConvergenceStudy(spec, 1);
+    check(writeConvergenceCSV(table, result) &&
+          read_file(table).rfind("Method,Kind,Timestep(s),Steps,Coasted,FlightTime(days),"
+                                 "DeltaV(km/s),FinalMass(kg),SemiMajorAxis(km),Eccentricity,"
+                                 "Periapsis(km),Apoapsis(km)\neuler,run,8000,", 0) == 0 &&
+          read_file(table).find("\neuler,extrapolated,,,,") != std::string::npos,
+          "Results table header, run and reference rows");
+    
+    write_file(filename, "convergence:\n  methods: [rk45]\n");
+    ConvergenceSpec adaptive;
+    check(!loadConvergenceFromYAML(filename, adaptive), "Adaptive methods rejected");
+    write_file(filename, "convergence:\n  timesteps: [2000, 1000, 1000]\n");
+    ConvergenceSpec short_ladder;
+    check(!loadConvergenceFromYAML(filename, short_ladder), "Fewer than three timesteps rejected");
+    
+    std::remove(filename.c_str());
+    std::remove(table.c_str());
+}
+
+// ===========================================================================
+// MAIN TEST RUNNER
+// ===========================================================================
+
+int main() {
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "CONVERGENCE STUDY TEST SUITE\n";
+    std::cout << "=====================================================\n";
+    
+    test_observed_order();
+    test_study();
+    test_spec_loader();
+    
+    // Summary
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "TEST RESULTS\n";
+    std::cout << "=====================================================\n";
+    std::cout << "  Tests passed: " << tests_passed << "\n";
+    std::cout << "  Tests failed: " << tests_failed << "\n";
+    std::cout << "  Total tests:  " << (tests_passed + tests_failed) << "\n";
+    
+    if (tests_failed == 0) {
+        std::cout << "\n  ✓ ALL TESTS PASSED\n";
+        std::cout << "=====================================================\n\n";
+        return 0;
+    } else {
+        std::cout << "\n  ✗ SOME TESTS FAILED\n";
+        std::cout << "=====================================================\n\n";
+        return 1;
+    }
+}
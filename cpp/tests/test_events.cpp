@@ -0,0 +1,240 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "../src/constants.h"
+#include "../src/propagator.h"
+#include "../src/mission_propagation.h"
+#include "../src/events.h"
+#include "test_mission_config.h"
+
+// ===========================================================================
+// TEST FRAMEWORK HELPERS
+// ===========================================================================
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+void check(bool condition, const std::string& test_name) {
+    if (condition) {
+        std::cout << "  ✓ PASS: " << test_name << "\n";
+        tests_passed++;
+    } else {
+        std::cout << "  ✗ FAIL: " << test_name << "\n";
+        tests_failed++;
+    }
+}
+
+// ===========================================================================
+// INTERPOLANT TESTS
+// ===========================================================================
+
+void test_interpolant_matches_integrator() {
+    std::cout << "\nTest 1: Step Interpolant - Matches a Shorter Integrator Step\n";
+    std::cout << "--------------------------------------------\n";
+    
+    RK4Propagator rk4;
+    MissionState start(1.496e8, 0, 0, 0, 29.78, 0, 10000);
+    MissionState end = start;
+    rk4.step(end, 20000.0, 1000, 2750, MU_SUN, G0, 1);
+    
+    StepInterpolant interpolant(start, end, 1000, MU_SUN, 1);
+    
+    double worst_r = 0;
+    double worst_v = 0;
+    for (double dt : {2500.0, 7000.0, 13000.0, 19000.0}) {
+        MissionState exact = start;
+        rk4.step(exact, dt, 1000, 2750, MU_SUN, G0, 1);
+        MissionState dense = interpolant.at(start.t + dt);
+        for (int i = 0; i < 3; i++) {
+            worst_r = std::max(worst_r, std::abs(dense.r[i] - exact.r[i]));
+            worst_v = std::max(worst_v, std::abs(dense.v[i] - exact.v[i]));
+        }
+    }
+    std::cout << "    Worst position error: " << std::scientific << std::setprecision(2)
+              << worst_r << " km, velocity error: " << worst_v << " km/s\n";
+    
+    // Both sides carry RK4's own local error (~1e-4 km for a 20000 s step)
+    check(worst_r < 1e-2 && worst_v < 1e-6, "Hermite interpolant agrees with RK4 inside the step");
+    check(interpolant.at(start.t).r[0] == start.r[0] && interpolant.at(end.t).v[1] == end.v[1],
+          "Interpolant reproduces both step ends");
+}
+
+// ===========================================================================
+// COAST EVENT TESTS
+// ===========================================================================
+
+void test_coast_event_inside_last_step() {
+    std::cout << "\nTest 2: Coast Event - Located Inside the Detecting RK4 Step\n";
+    std::cout << "--------------------------------------------\n";
+    
+    double r_dep = getOrbitalRadius(CelestialBody::EARTH);
+    double r_arr = getOrbitalRadius(CelestialBody::MARS);
+    
+    bool inside_last_step = true;
+    bool on_threshold = true;
+    for (double dt : {20000.0, 10000.0, 1000.0}) {
+        MissionConfig config = make_test_config(dt);
+        PropagationResult boundary = propagateMission(config, r_dep, r_arr);
+        config.locate_coast = true;
+        PropagationResult located = propagateMission(config, r_dep, r_arr);
+        
+        std::cout << "    dt = " << std::fixed << std::setprecision(0) << dt
+                  << " s: coast at " << std::setprecision(3) << located.final_state.t
+                  << " s (step boundary: " << boundary.final_state.t << " s)\n";
+        inside_last_step = inside_last_step &&
+                           located.coast_step == boundary.coast_step &&
+                           located.final_state.t <= boundary.final_state.t &&
+                           located.final_state.t > boundary.final_state.t - dt;
+        
+        double coast_radius = config.coast_threshold * r_arr;
+        Apsides apsides = computeApsides(located.final_state.r, located.final_state.v, MU_SUN);
+        on_threshold = on_threshold && apsides.r_a >= coast_radius &&
+                       apsides.r_a < coast_radius * (1 + 1e-9);
+    }
+    
+    check(inside_last_step, "Located coast lies inside the step that detected it");
+    check(on_threshold, "Coast state sits on the apoapsis threshold");
+}
+
+void test_coast_time_independent_of_steps() {
+    std::cout << "\nTest 3: Coast Event - Adaptive Coast Time Independent of Step Sizes\n";
+    std::cout << "--------------------------------------------\n";
+    
+    double r_dep = getOrbitalRadius(CelestialBody::EARTH);
+    double r_arr = getOrbitalRadius(CelestialBody::MARS);
+    
+    // dop853 takes steps of days; without event location the coast time is
+    // wherever the step sequence happens to land
+    std::vector<double> located_t, boundary_t;
+    bool terminal_coast = true;
+    bool same_steps = true;
+    for (double rel_tol : {1e-9, 1e-11}) {
+        MissionConfig config = make_test_config(10000);
+        config.integrator = "dop853";
+        config.rel_tol = rel_tol;
+        PropagationResult boundary = propagateMission(config, r_dep, r_arr);
+        config.locate_coast = true;
+        PropagationResult located = propagateMission(config, r_dep, r_arr);
+        
+        std::cout << "    rel_tol = " << std::scientific << std::setprecision(0) << rel_tol
+                  << ": coast at " << std::fixed << std::setprecision(3)
+                  << located.final_state.t << " s in " << located.accepted_steps
+                  << " steps (step boundary: " << boundary.final_state.t << " s)\n";
+        located_t.push_back(located.final_state.t);
+        boundary_t.push_back(boundary.final_state.t);
+        terminal_coast = terminal_coast && located.events.size() == 1 &&
+                         located.events[0].type == "coast" && located.events[0].terminal;
+        same_steps = same_steps && located.coast_step == boundary.coast_step &&
+                     located.accepted_steps == boundary.accepted_steps &&
+                     located.rejected_steps == boundary.rejected_steps;
+    }
+    
+    check(std::abs(located_t[0] - located_t[1]) < 1.0,
+          "Loose and tight tolerances agree on the coast time to < 1 s");
+    check(std::abs(located_t[0] - located_t[1]) < std::abs(boundary_t[0] - boundary_t[1]),
+          "Located coast time is steadier than step-boundary detection");
+    check(terminal_coast, "Coast reported as the terminal event");
+    check(same_steps, "Refinement probes are not counted as accepted or rejected steps");
+}
+
+// ===========================================================================
+// USER EVENT TESTS
+// ===========================================================================
+
+void test_mass_below_event() {
+    std::cout << "\nTest 4: User Event - Mass Below a Limit (Non-Terminal)\n";
+    std::cout << "--------------------------------------------\n";
+    
+    double r_dep = getOrbitalRadius(CelestialBody::EARTH);
+    double r_arr = getOrbitalRadius(CelestialBody::MARS);
+    
+    MissionConfig config = make_test_config(10000);
+    PropagationResult plain = propagateMission(config, r_dep, r_arr);
+    
+    EventSpec spec;
+    spec.type = "mass_below";
+    spec.value = 9950;
+    config.events.push_back(spec);
+    PropagationResult with_event = propagateMission(config, r_dep, r_arr);
+    
+    // Constant thrust: mass falls linearly, so the crossing time is exact
+    double mass_flow = config.spacecraft.thrust_mN * 1e-6 / (config.spacecraft.isp_s * G0);
+    double expected_t = (config.spacecraft.initial_mass_kg - spec.value) / mass_flow;
+    
+    check(with_event.events.size() == 1 && !with_event.events[0].terminal,
+          "Mass event reported once");
+    if (!with_event.events.empty()) {
+        std::cout << "    Event at " << std::fixed << std::setprecision(3)
+                  << with_event.events[0].state.t << " s (expected " << expected_t << " s)\n";
+        check(std::abs(with_event.events[0].state.t - expected_t) < 2 * EVENT_TIME_TOL_S,
+              "Event time matches the linear mass decrease");
+    }
+    check(with_event.final_state.t == plain.final_state.t &&
+          with_event.coast_step == plain.coast_step,
+          "Non-terminal event leaves the propagation unchanged");
+}
+
+void test_radius_crossing_terminal() {
+    std::cout << "\nTest 5: User Event - Terminal Radius Crossing\n";
+    std::cout << "--------------------------------------------\n";
+    
+    double r_dep = getOrbitalRadius(CelestialBody::EARTH);
+    double r_arr = getOrbitalRadius(CelestialBody::MARS);
+    
+    MissionConfig config = make_test_config(10000);
+    EventSpec spec;
+    spec.type = "radius_crossing";
+    spec.value = 1.6e8;
+    spec.terminal = true;
+    config.events.push_back(spec);
+    PropagationResult result = propagateMission(config, r_dep, r_arr);
+    
+    double radius = result.final_state.radius();
+    std::cout << "    Stopped at " << std::fixed << std::setprecision(3)
+              << result.final_state.t << " s, r = " << radius << " km\n";
+    
+    check(result.coast_step < 0, "Terminal user event ends the mission before coast");
+    check(std::abs(radius - spec.value) < 1.0, "Final radius sits on the crossing radius");
+    check(!result.events.empty() && result.events.back().terminal &&
+          result.events.back().type == "radius_crossing",
+          "Crossing reported as the terminal event");
+}
+
+// ===========================================================================
+// MAIN TEST RUNNER
+// ===========================================================================
+
+int main() {
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "EVENT LOCATION TEST SUITE\n";
+    std::cout << "=====================================================\n";
+    
+    test_interpolant_matches_integrator();
+    test_coast_event_inside_last_step();
+    test_coast_time_independent_of_steps();
+    test_mass_below_event();
+    test_radius_crossing_terminal();
+    
+    // Summary
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "TEST RESULTS\n";
+    std::cout << "=====================================================\n";
+    std::cout << "  Tests passed: " << tests_passed << "\n";
+    std::cout << "  Tests failed: " << tests_failed << "\n";
+    std::cout << "  Total tests:  " << (tests_passed + tests_failed) << "\n";
+    
+    if (tests_failed == 0) {
+        std::cout << "\n  ✓ ALL TESTS PASSED\n";
+        std::cout << "=====================================================\n\n";
+        return 0;
+    } else {
+        std::cout << "\n  ✗ SOME TESTS FAILED\n";
+        std::cout << "=====================================================\n\n";
+        return 1;
+    }
+}
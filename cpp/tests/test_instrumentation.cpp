@@ -0,0 +1,213 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdio>
+#include <thread>
+#include "../src/constants.h"
+#include "../src/propagator.h"
+#include "../src/mission_propagation.h"
+#include "../src/trajectory_sink.h"
+#include "../src/instrumentation.h"
+#include "test_mission_config.h"
+
+// Built with LTMD_ENABLE_INSTRUMENTATION (see cpp/CMakeLists.txt)
+
+// ===========================================================================
+// TEST FRAMEWORK HELPERS
+// ===========================================================================
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+void check(bool condition, const std::string& test_name) {
+    if (condition) {
+        std::cout << "  ✓ PASS: " << test_name << "\n";
+        tests_passed++;
+    } else {
+        std::cout << "  ✗ FAIL: " << test_name << "\n";
+        tests_failed++;
+    }
+}
+
+std::uint64_t calls(const ProfileCounters& profile, ProfilePhase phase) {
+    return profile.calls[static_cast<int>(phase)];
+}
+
+// ===========================================================================
+// SCOPED TIMER TESTS
+// ===========================================================================
+
+void test_scopes_count_and_time() {
+    std::cout << "\nTest 1: Scoped Timers - Calls and Time per Phase\n";
+    std::cout << "--------------------------------------------\n";
+    
+    check(instrumentationEnabled(), "Instrumentation compiled in");
+    
+    ProfileCounters before = threadProfile();
+    for (int i = 0; i < 10; i++) {
+        LTMD_PROFILE_SCOPE(COAST_CHECK);
+        LTMD_PROFILE_SCOPE(OUTPUT);  // Two scopes on different lines nest
+    }
+    {
+        LTMD_PROFILE_SCOPE(CONFIG_LOAD);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    ProfileCounters profile = threadProfile() - before;
+    
+    check(calls(profile, ProfilePhase::COAST_CHECK) == 10 &&
+          calls(profile, ProfilePhase::OUTPUT) == 10 &&
+          calls(profile, ProfilePhase::CONFIG_LOAD) == 1 &&
+          calls(profile, ProfilePhase::INTEGRATOR_STEP) == 0,
+          "Each scope counts one call of its phase");
+    check(profile.milliseconds(ProfilePhase::CONFIG_LOAD) >= 2.0,
+          "Scope time covers its block");
+    check(!profile.empty() && (before - before).empty(), "Empty only without calls");
+}
+
+void test_threads_accumulate_separately() {
+    std::cout << "\nTest 2: Per-Thread Counters - No Sharing Between Threads\n";
+    std::cout << "--------------------------------------------\n";
+    
+    ProfileCounters main_before = threadProfile();
+    ProfileCounters total_before = totalProfile();
+    
+    ProfileCounters worker_profile;
+    std::thread worker([&] {
+        for (int i = 0; i < 100; i++) {
+            LTMD_PROFILE_SCOPE(INTEGRATOR_STEP);
+        }
+        worker_profile = threadProfile();
+    });
+    worker.join();
+    
+    ProfileCounters main_profile = threadProfile() - main_before;
+    ProfileCounters total_profile = totalProfile() - total_before;
+    check(calls(worker_profile, ProfilePhase::INTEGRATOR_STEP) == 100,
+          "Worker sees its own calls");
+    check(main_profile.empty(), "Main thread counters untouched by the worker");
+    check(calls(total_profile, ProfilePhase::INTEGRATOR_STEP) == 100,
+          "Totals include threads that have finished");
+}
+
+// ===========================================================================
+// PROPAGATION PHASE TESTS
+// ===========================================================================
+
+void test_propagation_phases() {
+    std::cout << "\nTest 3: Propagation - Phase Calls Match the Loop\n";
+    std::cout << "--------------------------------------------\n";
+    
+    MissionConfig config = make_test_config();
+    double r_dep = getOrbitalRadius(CelestialBody::EARTH);
+    double r_arr = getOrbitalRadius(CelestialBody::MARS);
+    
+    ProfileCounters before = threadProfile();
+    RingBufferTrajectorySink ring(16);
+    DecimatingTrajectorySink decimated(ring, 10);
+    PropagationResult result = propagateMission(config, r_dep, r_arr, decimated);
+    ProfileCounters profile = threadProfile() - before;
+    
+    check(calls(profile, ProfilePhase::INTEGRATOR_STEP) ==
+          static_cast<std::uint64_t>(result.accepted_steps),
+          "One integrator_step per step");
+    check(calls(profile, ProfilePhase::COAST_CHECK) ==
+          static_cast<std::uint64_t>(result.accepted_steps) + 1,
+          "One coast_check per loop iteration (every_step)");
+    // The final state reaches the sink through finish(), outside the scope
+    std::uint64_t kept = static_cast<std::uint64_t>(ring.totalRecorded());
+    std::uint64_t elements = calls(profile, ProfilePhase::ORBITAL_ELEMENTS);
+    check(elements == kept || elements + 1 == kept,
+          "orbital_elements only for the steps the sink keeps");
+    check(calls(profile, ProfilePhase::OUTPUT) ==
+          calls(profile, ProfilePhase::ORBITAL_ELEMENTS) + 1,
+          "output: every kept step plus finish");
+    
+    ProfileCounters null_before = threadProfile();
+    NullTrajectorySink null_sink;
+    propagateMission(config, r_dep, r_arr, null_sink);
+    ProfileCounters null_profile = threadProfile() - null_before;
+    check(calls(null_profile, ProfilePhase::ORBITAL_ELEMENTS) == 0,
+          "No element evaluations when nothing is kept");
+}
+
+void test_chrome_trace_export() {
+    std::cout << "\nTest 4: Chrome Trace - One Complete Event per Scope\n";
+    std::cout << "--------------------------------------------\n";
+    
+    MissionConfig config = make_test_config();
+    config.timestep_s = 100000;  // Short trace
+    
+    ProfileCounters before = totalProfile();
+    setTraceEnabled(true);
+    NullTrajectorySink null_sink;
+    propagateMission(config, getOrbitalRadius(CelestialBody::EARTH),
+                     getOrbitalRadius(CelestialBody::MARS), null_sink);
+    setTraceEnabled(false);
+    ProfileCounters traced = totalProfile() - before;
+    
+    const std::string filename = "test_instrumentation_trace.json";
+    check(writeChromeTrace(filename), "Trace written");
+    
+    std::ifstream file(filename);
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    std::string json = contents.str();
+    
+    long events = 0;
+    for (size_t pos = json.find("\"ph\":\"X\""); pos != std::string::npos;
+         pos = json.find("\"ph\":\"X\"", pos + 1)) {
+        events++;
+    }
+    std::uint64_t expected = 0;
+    for (int p = 0; p < PROFILE_PHASE_COUNT; p++) {
+        expected += traced.calls[p];
+    }
+    
+    check(json.rfind("{\"traceEvents\":[", 0) == 0 &&
+          json.find("],\"displayTimeUnit\":\"ns\"}") != std::string::npos,
+          "Trace Event Format wrapper");
+    check(json.find("\"name\":\"integrator_step\"") != std::string::npos &&
+          json.find("\"name\":\"coast_check\"") != std::string::npos,
+          "Events named by phase");
+    check(events > 0 && static_cast<std::uint64_t>(events) == expected,
+          "Only scopes recorded while tracing are logged");
+    
+    std::remove(filename.c_str());
+}
+
+// ===========================================================================
+// MAIN TEST RUNNER
+// ===========================================================================
+
+int main() {
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "INSTRUMENTATION TEST SUITE\n";
+    std::cout << "=====================================================\n";
+    
+    test_scopes_count_and_time();
+    test_threads_accumulate_separately();
+    test_propagation_phases();
+    test_chrome_trace_export();
+    
+    // Summary
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "TEST RESULTS\n";
+    std::cout << "=====================================================\n";
+    std::cout << "  Tests passed: " << tests_passed << "\n";
+    std::cout << "  Tests failed: " << tests_failed << "\n";
+    std::cout << "  Total tests:  " << (tests_passed + tests_failed) << "\n";
+    
+    if (tests_failed == 0) {
+        std::cout << "\n  ✓ ALL TESTS PASSED\n";
+        std::cout << "=====================================================\n\n";
+        return 0;
+    } else {
+        std::cout << "\n  ✗ SOME TESTS FAILED\n";
+        std::cout << "=====================================================\n\n";
+        return 1;
+    }
+}
@@ -282,6 +282,135 @@ void test_orbital_elements_inclination() {
     assert_close(i_degrees, 30.0, 0.1, "Inclination = 30 degrees");
 }
 
+void test_apsides_match_orbital_elements() {
+    std::cout << "\nTest 13: Apsides - Match the Full Element Set Exactly\n";
+    std::cout << "--------------------------------------------\n";
+    
+    double mu = 1.327e11;
+    
+    // Circular, eccentric, inclined and hyperbolic states
+    double states[4][6] = {
+        {1.496e8, 0, 0, 0, 29.78, 0},
+        {1.2e8, 4.0e7, 1.0e6, -8.0, 31.0, 0.1},
+        {2.279e8, -3.0e6, 5.0e6, 0.5, 24.1, 2.0},
+        {1.496e8, 0, 0, 0, 45.0, 0}
+    };
+    const char* names[4] = {"circular", "eccentric", "inclined", "hyperbolic"};
+    
+    for (int i = 0; i < 4; ++i) {
+        OrbitalElements elements = computeOrbitalElements(states[i], states[i] + 3, mu);
+        Apsides apsides = computeApsides(states[i], states[i] + 3, mu);
+        
+        std::string name = names[i];
+        assert_close(apsides.a, elements.a, 0.0, "Semi-major axis (" + name + ")");
+        assert_close(apsides.e, elements.e, 0.0, "Eccentricity (" + name + ")");
+        assert_close(apsides.r_a, elements.r_a, 0.0, "Apoapsis (" + name + ")");
+        assert_close(apsides.r_p, elements.r_p, 0.0, "Periapsis (" + name + ")");
+    }
+}
+
+// ===========================================================================
+// ANALYTIC PROPAGATION TESTS
+// ===========================================================================
+
+void test_propagate_kepler_ellipse() {
+    std::cout << "\nTest 14: Kepler Propagation - Matches Kepler's Equation (Ellipse)\n";
+    std::cout << "--------------------------------------------\n";
+    
+    const double pi = 3.14159265358979323846;
+    double mu = 1.327e11;
+    double a = 1.5e8;
+    double e = 0.3;
+    double n = std::sqrt(mu / (a * a * a));
+    double period = 2 * pi / n;
+    
+    // Start at periapsis on the x axis
+    double r_p = a * (1 - e);
+    double r0[3] = {r_p, 0, 0};
+    double v0[3] = {0, std::sqrt(mu * (1 + e) / r_p), 0};
+    
+    for (double fraction : {0.1, 0.45, 0.8}) {
+        double dt = fraction * period;
+        double r[3], v[3];
+        bool converged = propagateKepler(r0, v0, dt, mu, r, v);
+        
+        double E = solveKeplersEquation(n * dt, e);
+        double nu = eccentricToTrueAnomaly(E, e);
+        double radius = a * (1 - e * std::cos(E));
+        double nu_actual = std::atan2(r[1], r[0]);
+        if (nu_actual < 0) nu_actual += 2 * pi;
+        
+        std::string label = std::to_string(fraction).substr(0, 4) + " period";
+        assert_close(converged ? 1.0 : 0.0, 1.0, 0.0, "Converged (" + label + ")");
+        assert_close(std::sqrt(r[0]*r[0] + r[1]*r[1]), radius, 1e-10, "Radius (" + label + ")");
+        assert_close(nu_actual, nu, 1e-10, "True anomaly (" + label + ")");
+    }
+    
+    // Whole revolutions return to the start
+    double r[3], v[3];
+    propagateKepler(r0, v0, 10.5 * period, mu, r, v);
+    assert_close(r[0], -a * (1 + e), 1e-10, "10.5 periods ends at apoapsis");
+    propagateKepler(r0, v0, period, mu, r, v);
+    assert_close(r[0], r_p, 1e-10, "One period returns to periapsis");
+}
+
+void test_propagate_kepler_hyperbola() {
+    std::cout << "\nTest 15: Kepler Propagation - Hyperbolic Arc Round Trip\n";
+    std::cout << "--------------------------------------------\n";
+    
+    double mu = 1.327e11;
+    double r0[3] = {1.496e8, 0, 0};
+    double v0[3] = {-5.0, 45.0, 1.0};
+    
+    double r[3], v[3];
+    bool converged = propagateKepler(r0, v0, 3.0e7, mu, r, v);
+    assert_close(converged ? 1.0 : 0.0, 1.0, 0.0, "Converged on a hyperbola");
+    
+    OrbitalElements before = computeOrbitalElements(r0, v0, mu);
+    OrbitalElements after = computeOrbitalElements(r, v, mu);
+    assert_close(after.E, before.E, 1e-10, "Energy conserved");
+    assert_close(after.h, before.h, 1e-10, "Angular momentum conserved");
+    
+    double r_back[3], v_back[3];
+    propagateKepler(r, v, -3.0e7, mu, r_back, v_back);
+    assert_close(r_back[0], r0[0], 1e-10, "Backward propagation returns to the start");
+    assert_close(v_back[1], v0[1], 1e-10, "Velocity restored after the round trip");
+}
+
+void test_time_to_radius() {
+    std::cout << "\nTest 16: Time to Radius - Known Anomalies\n";
+    std::cout << "--------------------------------------------\n";
+    
+    const double pi = 3.14159265358979323846;
+    double mu = 1.327e11;
+    double a = 1.5e8;
+    double e = 0.3;
+    double n = std::sqrt(mu / (a * a * a));
+    
+    double r_p = a * (1 - e);
+    double r0[3] = {r_p, 0, 0};
+    double v0[3] = {0, std::sqrt(mu * (1 + e) / r_p), 0};
+    
+    // r = a at E = π/2, so M = π/2 - e
+    assert_close(timeToRadius(r0, v0, mu, a), (pi / 2 - e) / n, 1e-10, "Periapsis to r = a");
+    assert_close(timeToRadius(r0, v0, mu, a * (1 + e)), pi / n, 1e-10, "Periapsis to apoapsis");
+    assert_close(timeToRadius(r0, v0, mu, 2 * a), -1.0, 0.0, "Radius beyond apoapsis unreachable");
+    
+    // After passing r = a outbound, the next crossing is inbound at E = 3π/2
+    double r[3], v[3];
+    propagateKepler(r0, v0, 2.0 / n, mu, r, v);
+    double t_next = timeToRadius(r, v, mu, a);
+    assert_close(t_next, (3 * pi / 2 + e - 2.0) / n, 1e-9, "Next crossing of r = a is inbound");
+    
+    // Landing on the target radius of a hyperbolic arc
+    double rh[3] = {1.496e8, 0, 0};
+    double vh[3] = {-5.0, 45.0, 1.0};
+    double t_cross = timeToRadius(rh, vh, mu, 5.0e8);
+    propagateKepler(rh, vh, t_cross, mu, r, v);
+    assert_close(std::sqrt(r[0]*r[0] + r[1]*r[1] + r[2]*r[2]), 5.0e8, 1e-10,
+                 "Hyperbolic arc lands on the target radius");
+}
+
 // ===========================================================================
 // MAIN TEST RUNNER
 // ===========================================================================
@@ -309,6 +438,12 @@ int main() {
     test_orbital_elements_circular_orbit();
     test_orbital_elements_elliptical_orbit();
     // test_orbital_elements_inclination(); For future implementation, for now, assume coplanar orbits
+    test_apsides_match_orbital_elements();
+    
+    // Analytic propagation tests
+    test_propagate_kepler_ellipse();
+    test_propagate_kepler_hyperbola();
+    test_time_to_radius();
     
     // Summary
     std::cout << "\n";
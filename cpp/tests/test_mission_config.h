@@ -0,0 +1,26 @@
+#ifndef TEST_MISSION_CONFIG_H
+#define TEST_MISSION_CONFIG_H
+
+#include <string>
+#include "../src/propagator.h"
+
+// ===========================================================================
+// SHARED TEST MISSION
+// ===========================================================================
+
+/// High-Power Hall to Mars (thousands of RK4 steps at the default timestep)
+/// The default mission of the propagation tests; change it here, not per test.
+inline MissionConfig make_test_config(double timestep_s = 10000,
+                                      const std::string& integrator = "rk4") {
+    MissionConfig config;
+    config.spacecraft.name = "High-Power Hall";
+    config.spacecraft.thrust_mN = 1000;
+    config.spacecraft.isp_s = 2750;
+    config.spacecraft.initial_mass_kg = 10000;
+    config.integrator = integrator;
+    config.timestep_s = timestep_s;
+    config.max_flight_time_s = 1.577e9;
+    return config;
+}
+
+#endif // TEST_MISSION_CONFIG_H
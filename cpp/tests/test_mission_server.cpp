@@ -0,0 +1,231 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdio>
+#include <cmath>
+#include <map>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+#include "../src/constants.h"
+#include "../src/propagator.h"
+#include "../src/mission_propagation.h"
+#include "../src/mission_server.h"
+
+// ===========================================================================
+// TEST FRAMEWORK HELPERS
+// ===========================================================================
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+void check(bool condition, const std::string& test_name) {
+    if (condition) {
+        std::cout << "  ✓ PASS: " << test_name << "\n";
+        tests_passed++;
+    } else {
+        std::cout << "  ✗ FAIL: " << test_name << "\n";
+        tests_failed++;
+    }
+}
+
+const std::string CONFIG_FILE = "test_mission_server_base.yaml";
+
+/// Base config shared by the requests (coarse step keeps the tests quick)
+void write_base_config() {
+    std::ofstream file(CONFIG_FILE);
+    file << "mission: {departure_body: Earth, arrival_body: Mars, initial_mass_kg: 10000}\n"
+            "spacecraft: {name: High-Power Hall}\n"
+            "integration: {method: rk4, timestep_s: 20000}\n";
+}
+
+/// Feed request lines to a server and parse every reply line
+std::vector<YAML::Node> serve_lines(MissionServer& server, const std::string& requests) {
+    std::istringstream in(requests);
+    std::ostringstream out;
+    server.serve(in, out);
+    
+    std::vector<YAML::Node> replies;
+    std::istringstream lines(out.str());
+    std::string line;
+    while (std::getline(lines, line)) {
+        replies.push_back(YAML::Load(line));
+    }
+    return replies;
+}
+
+std::string mission_request(const std::string& id, const std::string& fields = "") {
+    return "{\"id\": \"" + id + "\", \"config\": \"" + CONFIG_FILE + "\"" + fields + "}\n";
+}
+
+// ===========================================================================
+// REQUEST TESTS
+// ===========================================================================
+
+void test_single_request() {
+    std::cout << "\nTest 1: Mission Request - Reply Matches propagateMission\n";
+    std::cout << "--------------------------------------------\n";
+    
+    MissionServer server(1);
+    std::vector<YAML::Node> replies = serve_lines(server, mission_request("r1"));
+    check(replies.size() == 1 && replies[0]["id"].as<std::string>() == "r1" &&
+          replies[0]["status"].as<std::string>() == "ok",
+          "One reply, tagged with the request id");
+    if (replies.size() != 1) {
+        return;
+    }
+    
+    MissionConfig config;
+    config.spacecraft.name = "High-Power Hall";
+    config.spacecraft.thrust_mN = 1000;
+    config.spacecraft.isp_s = 2750;
+    config.timestep_s = 20000;
+    PropagationResult reference = propagateMission(config, getOrbitalRadius(CelestialBody::EARTH),
+                                                   getOrbitalRadius(CelestialBody::MARS), false);
+    double days = replies[0]["flight_time_days"].as<double>();
+    double propellant = replies[0]["propellant_kg"].as<double>();
+    std::cout << "    Flight time " << std::fixed << std::setprecision(3) << days
+              << " days, propellant " << propellant << " kg, latency "
+              << replies[0]["latency_ms"].as<double>() << " ms\n";
+    check(std::abs(days - reference.final_state.t / 86400.0) < 1e-9 * days &&
+          std::abs(propellant - (10000 - reference.final_state.m)) < 1e-6,
+          "Flight time and propellant match a direct propagation");
+    check(replies[0]["coasted"].as<bool>() &&
+          replies[0]["thruster"].as<std::string>() == "High-Power Hall" &&
+          replies[0]["arrival_body"].as<std::string>() == "Mars",
+          "Coast flag and mission identification");
+}
+
+void test_warm_configs_and_stats() {
+    std::cout << "\nTest 2: Warm Configs - Parsed Once, Overrides, Stats Command\n";
+    std::cout << "--------------------------------------------\n";
+    
+    MissionServer server(1);
+    std::vector<YAML::Node> replies = serve_lines(
+        server,
+        mission_request("a") +
+        mission_request("b", ", \"thruster\": \"High-Power Ion\"") +
+        mission_request("c", ", \"thruster\": \"High-Power Ion\", \"thrust_mN\": 900") +
+        "{\"command\": \"stats\"}\n");
+    check(replies.size() == 4, "Three replies and the stats record");
+    if (replies.size() != 4) {
+        return;
+    }
+    
+    check(replies[1]["thruster"].as<std::string>() == "High-Power Ion" &&
+          replies[1]["flight_time_days"].as<double>() > replies[0]["flight_time_days"].as<double>(),
+          "Thruster preset replaces the base thruster");
+    check(replies[2]["flight_time_days"].as<double>() < replies[1]["flight_time_days"].as<double>(),
+          "Numeric field overrides the preset");
+    
+    YAML::Node stats = replies[3];
+    std::cout << "    Latency p50 " << stats["latency_ms"]["p50"].as<double>() << " ms, max "
+              << stats["latency_ms"]["max"].as<double>() << " ms\n";
+    check(stats["command"].as<std::string>() == "stats" && stats["completed"].as<int>() == 3 &&
+          stats["errors"].as<int>() == 0 && stats["cached_configs"].as<int>() == 1,
+          "Stats: three requests, base config parsed once");
+    check(stats["latency_ms"]["p50"].as<double>() > 0 &&
+          stats["latency_ms"]["p50"].as<double>() <= stats["latency_ms"]["max"].as<double>(),
+          "Latency percentiles reported");
+}
+
+void test_errors_and_shutdown() {
+    std::cout << "\nTest 3: Bad Requests - Error Replies, Shutdown\n";
+    std::cout << "--------------------------------------------\n";
+    
+    MissionServer server(1);
+    std::vector<YAML::Node> replies = serve_lines(
+        server,
+        "{\"id\": \"x\", \"config\": \n"
+        "\n"
+        "{\"id\": \"missing\", \"config\": \"no_such_file.yaml\"}\n" +
+        mission_request("thruster", ", \"thruster\": \"Warp Drive\"") +
+        mission_request("body", ", \"arrival_body\": \"Vulcan\"") +
+        mission_request("step", ", \"timestep_s\": -5") +
+        "{\"command\": \"reboot\"}\n"
+        "{\"command\": \"shutdown\"}\n" +
+        mission_request("after"));
+    
+    bool all_errors = replies.size() == 6;
+    for (const YAML::Node& reply : replies) {
+        all_errors = all_errors && reply["status"].as<std::string>() == "error" &&
+                     !reply["message"].as<std::string>().empty();
+    }
+    check(all_errors, "Every bad request gets an error reply");
+    check(replies.size() == 6 && replies[1]["id"].as<std::string>() == "missing" &&
+          replies[2]["message"].as<std::string>().find("Warp Drive") != std::string::npos,
+          "Errors name the request and the problem");
+    check(server.statistics().errors == 6 && server.statistics().completed == 6,
+          "Nothing served after shutdown");
+}
+
+void test_parallel_requests() {
+    std::cout << "\nTest 4: Shared Pool - Replies Independent of Jobs\n";
+    std::cout << "--------------------------------------------\n";
+    
+    std::string requests;
+    const double thrusts[] = {600, 700, 800, 900, 1000, 1100};
+    for (int k = 0; k < 6; k++) {
+        std::ostringstream fields;
+        fields << ", \"thrust_mN\": " << thrusts[k];
+        requests += mission_request("m" + std::to_string(k), fields.str());
+    }
+    
+    MissionServer serial(1);
+    MissionServer parallel(3);
+    std::vector<YAML::Node> serial_replies = serve_lines(serial, requests);
+    std::vector<YAML::Node> parallel_replies = serve_lines(parallel, requests);
+    
+    std::map<std::string, double> serial_days;
+    for (const YAML::Node& reply : serial_replies) {
+        serial_days[reply["id"].as<std::string>()] = reply["flight_time_days"].as<double>();
+    }
+    bool same = parallel_replies.size() == 6 && serial_days.size() == 6;
+    for (const YAML::Node& reply : parallel_replies) {
+        auto found = serial_days.find(reply["id"].as<std::string>());
+        same = same && found != serial_days.end() &&
+               found->second == reply["flight_time_days"].as<double>();
+    }
+    check(same, "Six replies with 3 jobs, each equal to the serial one");
+    check(parallel.statistics().completed == 6, "All requests accounted for");
+}
+
+// ===========================================================================
+// MAIN TEST RUNNER
+// ===========================================================================
+
+int main() {
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "MISSION SERVER TEST SUITE\n";
+    std::cout << "=====================================================\n";
+    
+    write_base_config();
+    
+    test_single_request();
+    test_warm_configs_and_stats();
+    test_errors_and_shutdown();
+    test_parallel_requests();
+    
+    std::remove(CONFIG_FILE.c_str());
+    
+    // Summary
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "TEST RESULTS\n";
+    std::cout << "=====================================================\n";
+    std::cout << "  Tests passed: " << tests_passed << "\n";
+    std::cout << "  Tests failed: " << tests_failed << "\n";
+    std::cout << "  Total tests:  " << (tests_passed + tests_failed) << "\n";
+    
+    if (tests_failed == 0) {
+        std::cout << "\n  ✓ ALL TESTS PASSED\n";
+        std::cout << "=====================================================\n\n";
+        return 0;
+    } else {
+        std::cout << "\n  ✗ SOME TESTS FAILED\n";
+        std::cout << "=====================================================\n\n";
+        return 1;
+    }
+}
@@ -0,0 +1,267 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+#include "../src/constants.h"
+#include "../src/propagator.h"
+#include "../src/comparison.h"
+#include "../src/mission_summary.h"
+#include "../src/parameter_sweep.h"
+
+// ===========================================================================
+// TEST FRAMEWORK HELPERS
+// ===========================================================================
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+void check(bool condition, const std::string& test_name) {
+    if (condition) {
+        std::cout << "  ✓ PASS: " << test_name << "\n";
+        tests_passed++;
+    } else {
+        std::cout << "  ✗ FAIL: " << test_name << "\n";
+        tests_failed++;
+    }
+}
+
+/// Mission k of a synthetic batch: three thrusters, two targets
+MissionResult synthetic_mission(std::size_t k) {
+    static const char* thrusters[] = {"Low-Power Hall", "High-Power Hall", "Gridded Ion"};
+    MissionResult mission;
+    mission.mission_name = "mission_" + std::to_string(k);
+    mission.thruster_name = thrusters[k % 3];
+    mission.arrival_body = (k % 2 == 0) ? "Mars" : "Venus";
+    mission.flight_time_days = 200.0 + static_cast<double>((k * 7919) % 1000);
+    mission.total_delta_v_km_s = 3.0 + 0.001 * static_cast<double>((k * 104729) % 5000);
+    mission.propellant_consumed_kg = 500.0 + static_cast<double>(k % 1500);
+    return mission;
+}
+
+/// Every figure of two groups matches bit for bit
+bool same_group(const MissionSummary::Group& a, const MissionSummary::Group& b) {
+    bool same = a.name == b.name &&
+                a.flight_time_days.count() == b.flight_time_days.count() &&
+                a.flight_time_days.mean() == b.flight_time_days.mean() &&
+                a.flight_time_days.min() == b.flight_time_days.min() &&
+                a.delta_v_km_s.mean() == b.delta_v_km_s.mean() &&
+                a.propellant_kg.mean() == b.propellant_kg.mean() &&
+                a.flight_time_quantiles.size() == b.flight_time_quantiles.size();
+    for (std::size_t q = 0; same && q < a.flight_time_quantiles.size(); q++) {
+        same = a.flight_time_quantiles[q].value() == b.flight_time_quantiles[q].value();
+    }
+    return same;
+}
+
+bool same_summary(const MissionSummary& a, const MissionSummary& b) {
+    std::vector<const MissionSummary::Group*> at = a.thrusters();
+    std::vector<const MissionSummary::Group*> bt = b.thrusters();
+    std::vector<const MissionSummary::Group*> ag = a.targets();
+    std::vector<const MissionSummary::Group*> bg = b.targets();
+    bool same = a.missions() == b.missions() && a.excluded() == b.excluded() &&
+                at.size() == bt.size() && ag.size() == bg.size();
+    for (std::size_t i = 0; same && i < at.size(); i++) {
+        same = same_group(*at[i], *bt[i]);
+    }
+    for (std::size_t i = 0; same && i < ag.size(); i++) {
+        same = same_group(*ag[i], *bg[i]);
+    }
+    return same;
+}
+
+// ===========================================================================
+// GROUPING TESTS
+// ===========================================================================
+
+void test_groups() {
+    std::cout << "\nTest 1: Groups - Interned Keys, Figures and Pruned Missions\n";
+    std::cout << "--------------------------------------------\n";
+    
+    MissionSummary summary;
+    check(summary.thrusterId("Gridded Ion") == summary.thrusterId("Gridded Ion") &&
+          summary.thrusterId("Gridded Ion") != summary.thrusterId("High-Power Hall"),
+          "A name is interned once");
+    
+    // Direct sums over the same missions
+    std::size_t n = 600;
+    double time_sum[3] = {0, 0, 0};
+    double fastest_mars = 1e300;
+    for (std::size_t k = 0; k < n; k++) {
+        MissionResult mission = synthetic_mission(k);
+        mission.pruned = (k % 10 == 9);
+        summary.add(k, mission);
+        if (!mission.pruned) {
+            time_sum[k % 3] += mission.flight_time_days;
+            if (mission.arrival_body == "Mars") {
+                fastest_mars = std::min(fastest_mars, mission.flight_time_days);
+            }
+        }
+    }
+    
+    std::vector<const MissionSummary::Group*> thrusters = summary.thrusters();
+    std::vector<const MissionSummary::Group*> targets = summary.targets();
+    check(thrusters.size() == 3 && thrusters[0]->name == "Low-Power Hall" &&
+          thrusters[2]->name == "Gridded Ion" && targets.size() == 2 &&
+          targets[0]->name == "Mars" && targets[1]->name == "Venus",
+          "Groups keep the order of first appearance, not of interning");
+    check(summary.missions() == n && summary.excluded() == n / 10 &&
+          thrusters[0]->flight_time_days.count() + thrusters[1]->flight_time_days.count() +
+          thrusters[2]->flight_time_days.count() == n - n / 10,
+          "Pruned missions are counted but left out of the figures");
+    
+    bool means = true;
+    for (int g = 0; g < 3; g++) {
+        double direct = time_sum[g] / static_cast<double>(thrusters[g]->flight_time_days.count());
+        means = means && std::fabs(thrusters[g]->flight_time_days.mean() - direct) < 1e-9;
+    }
+    check(means, "Streamed means match direct sums");
+    check(targets[0]->flight_time_days.min() == fastest_mars, "Minimum per target is exact");
+    
+    // 10^5 uniform flight times: the streamed median is close to the exact one
+    MissionSummary large;
+    std::uint32_t thruster = large.thrusterId("Hall");
+    std::uint32_t target = large.targetId("Mars");
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t k = 0; k < 100000; k++) {
+        double u = static_cast<double>((k * 7919) % 100000) / 100000.0;
+        large.add(k, thruster, target, 100.0 + 900.0 * u, 5.0, 1000.0);
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+                         .count();
+    const MissionSummary::Group& group = *large.targets()[0];
+    std::cout << "  10^5 records in " << std::fixed << std::setprecision(1) << elapsed * 1e3
+              << " ms; p50 " << group.flight_time_quantiles[0].value() << " (exact 550.0), p95 "
+              << group.flight_time_quantiles[1].value() << " (exact 955.0)\n";
+    check(std::fabs(group.flight_time_quantiles[0].value() - 550.0) < 5.0 &&
+          std::fabs(group.flight_time_quantiles[1].value() - 955.0) < 5.0,
+          "Percentiles over 10^5 records within 5 days");
+}
+
+// ===========================================================================
+// ORDERING TESTS
+// ===========================================================================
+
+void test_ordering() {
+    std::cout << "\nTest 2: Ordering - Same Summary for Any Arrival Order\n";
+    std::cout << "--------------------------------------------\n";
+    
+    std::size_t n = 4000;
+    MissionSummary sequential;
+    for (std::size_t k = 0; k < n; k++) {
+        sequential.add(k, synthetic_mission(k));
+    }
+    
+    // Four workers, each adding a strided quarter of the indices backwards
+    MissionSummary concurrent;
+    std::vector<std::thread> workers;
+    for (std::size_t w = 0; w < 4; w++) {
+        workers.emplace_back([&concurrent, n, w]() {
+            for (std::size_t k = n - 4 + w; k < n; k -= 4) {
+                concurrent.add(k, synthetic_mission(k));
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    check(same_summary(sequential, concurrent),
+          "Concurrent out-of-order adds give the sequential summary bit for bit");
+    
+    // Through MissionComparison: parallel-style setMission equals addMission
+    MissionComparison appended;
+    MissionComparison slotted;
+    slotted.resizeMissions(n);
+    for (std::size_t k = 0; k < n; k++) {
+        appended.addMission(synthetic_mission(k));
+        slotted.setMission(n - 1 - k, synthetic_mission(n - 1 - k));
+    }
+    check(appended.findBestMission("shortest_time").mission_name ==
+          slotted.findBestMission("shortest_time").mission_name,
+          "Comparison tables filled either way agree");
+    
+    // A missing index holds the rest back until finish()
+    MissionSummary gap;
+    gap.add(0, synthetic_mission(0));
+    gap.add(2, synthetic_mission(2));
+    gap.add(3, synthetic_mission(3));
+    std::size_t before = gap.missions();
+    gap.finish();
+    check(before == 1 && gap.missions() == 3, "finish() folds records waiting behind a gap");
+}
+
+// ===========================================================================
+// SWEEP TESTS
+// ===========================================================================
+
+void test_sweep_summary() {
+    std::cout << "\nTest 3: Sweep - Workers Stream Coasted Points by Destination\n";
+    std::cout << "--------------------------------------------\n";
+    
+    ParameterSweep sweep;
+    sweep.base.spacecraft.initial_mass_kg = 10000;
+    sweep.base.timestep_s = 20000;
+    sweep.base.max_flight_time_s = 1.577e9;
+    sweep.thrust_mN = {100, 600, 800, 1000};
+    sweep.isp_s = {2750, 4000};
+    sweep.destinations = {CelestialBody::MARS, CelestialBody::VENUS};
+    
+    MissionSummary one;
+    MissionSummary two;
+    std::vector<SweepPointResult> results = runParameterSweep(sweep, 1, nullptr, &one);
+    runParameterSweep(sweep, 2, nullptr, &two);
+    
+    std::size_t coasted = 0;
+    double fastest_venus = 1e300;
+    for (const SweepPointResult& point : results) {
+        if (point.coasted) {
+            coasted++;
+            if (point.destination == CelestialBody::VENUS) {
+                fastest_venus = std::min(fastest_venus, point.flight_time_days);
+            }
+        }
+    }
+    std::vector<const MissionSummary::Group*> targets = one.targets();
+    check(one.missions() == results.size() && one.excluded() == results.size() - coasted &&
+          one.thrusters().empty(),
+          "Every point is counted; only coasted ones enter the figures");
+    check(targets.size() == 2 && targets[0]->name == "Mars" &&
+          targets[1]->flight_time_days.min() == fastest_venus,
+          "Destination groups hold the coasted points");
+    check(same_summary(one, two), "One and two workers give the same summary");
+}
+
+// ===========================================================================
+// MAIN
+// ===========================================================================
+
+int main() {
+    std::cout << "=====================================================\n";
+    std::cout << "STREAMING MISSION SUMMARY TEST SUITE\n";
+    std::cout << "=====================================================\n";
+    
+    test_groups();
+    test_ordering();
+    test_sweep_summary();
+    
+    // Summary
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "TEST RESULTS\n";
+    std::cout << "=====================================================\n";
+    std::cout << "  Tests passed: " << tests_passed << "\n";
+    std::cout << "  Tests failed: " << tests_failed << "\n";
+    std::cout << "  Total tests:  " << (tests_passed + tests_failed) << "\n";
+    
+    if (tests_failed == 0) {
+        std::cout << "\n  ✓ ALL TESTS PASSED\n";
+        std::cout << "=====================================================\n\n";
+        return 0;
+    } else {
+        std::cout << "\n  ✗ SOME TESTS FAILED\n";
+        std::cout << "=====================================================\n\n";
+        return 1;
+    }
+}
@@ -0,0 +1,321 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <cstdio>
+#include <cmath>
+#include <vector>
+#include "../src/constants.h"
+#include "../src/propagator.h"
+#include "../src/mission_propagation.h"
+#include "../src/philox.h"
+#include "../src/online_statistics.h"
+#include "../src/monte_carlo.h"
+
+// ===========================================================================
+// TEST FRAMEWORK HELPERS
+// ===========================================================================
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+void check(bool condition, const std::string& test_name) {
+    if (condition) {
+        std::cout << "  ✓ PASS: " << test_name << "\n";
+        tests_passed++;
+    } else {
+        std::cout << "  ✗ FAIL: " << test_name << "\n";
+        tests_failed++;
+    }
+}
+
+/// Write text to a scratch file
+void write_file(const std::string& filename, const std::string& text) {
+    std::ofstream file(filename);
+    file << text;
+}
+
+std::string read_file(const std::string& filename) {
+    std::ifstream file(filename);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+/// High-Power Hall to Mars with the dispersions of the example spec
+MonteCarloSpec make_test_spec() {
+    MonteCarloSpec spec;
+    spec.base.spacecraft.name = "High-Power Hall";
+    spec.base.spacecraft.thrust_mN = 1000;
+    spec.base.spacecraft.isp_s = 2750;
+    spec.base.spacecraft.initial_mass_kg = 10000;
+    spec.base.integrator = "rk4";
+    spec.base.timestep_s = 20000;
+    spec.base.max_flight_time_s = 1.577e9;
+    spec.thrust_mN = {Dispersion::Distribution::UNIFORM, 3};
+    spec.isp_s = {Dispersion::Distribution::NORMAL, 2};
+    spec.initial_mass_kg = {Dispersion::Distribution::NORMAL, 0.5};
+    spec.samples = 600;
+    return spec;
+}
+
+bool same_summary(const MetricSummary& a, const MetricSummary& b) {
+    bool same = a.statistics.count() == b.statistics.count() &&
+                a.statistics.mean() == b.statistics.mean() &&
+                a.statistics.variance() == b.statistics.variance() &&
+                a.quantiles.size() == b.quantiles.size();
+    for (std::size_t q = 0; same && q < a.quantiles.size(); q++) {
+        same = a.quantiles[q].value() == b.quantiles[q].value();
+    }
+    return same;
+}
+
+// ===========================================================================
+// RANDOM NUMBER TESTS
+// ===========================================================================
+
+void test_philox_known_answers() {
+    std::cout << "\nTest 1: Philox4x32-10 - Random123 Known-Answer Vectors\n";
+    std::cout << "--------------------------------------------\n";
+    
+    Philox4x32::Block zero = Philox4x32(0u, 0u)({0, 0, 0, 0});
+    check(zero == Philox4x32::Block{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8},
+          "Zero key and counter");
+    
+    Philox4x32::Block ones = Philox4x32(0xffffffffu, 0xffffffffu)(
+        {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff});
+    check(ones == Philox4x32::Block{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd},
+          "All-ones key and counter");
+    
+    Philox4x32::Block pi = Philox4x32(0xa4093822u, 0x299f31d0u)(
+        {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344});
+    check(pi == Philox4x32::Block{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1},
+          "Digits-of-pi key and counter");
+    
+    Philox4x32 rng(42);
+    check(rng.block(7, 1) == rng.block(7, 1) && rng.block(7, 1) != rng.block(8, 1) &&
+          rng.block(7, 1) != rng.block(7, 2) && rng.block(7, 1) != Philox4x32(43).block(7, 1),
+          "Blocks depend on stream, draw and seed only");
+}
+
+// ===========================================================================
+// ONLINE STATISTICS TESTS
+// ===========================================================================
+
+void test_running_statistics() {
+    std::cout << "\nTest 2: Welford Accumulator - Large Offset, Extremes\n";
+    std::cout << "--------------------------------------------\n";
+    
+    // Variance 1 around 1e9: the sum-of-squares formula loses every digit here
+    RunningStatistics stats;
+    check(stats.count() == 0 && stats.variance() == 0, "Empty accumulator");
+    const double values[] = {-1, 1, -1, 1, 0, 0, 2, -2};
+    for (double value : values) {
+        stats.add(1e9 + value);
+    }
+    std::cout << "    Mean - 1e9: " << std::scientific << std::setprecision(3)
+              << stats.mean() - 1e9 << ", variance: " << stats.variance() << std::fixed << "\n";
+    check(stats.count() == 8 && stats.mean() == 1e9, "Mean exact");
+    check(std::abs(stats.variance() - 12.0 / 7.0) < 1e-6, "Sample variance accurate");
+    check(stats.min() == 1e9 - 2 && stats.max() == 1e9 + 2, "Extremes tracked");
+}
+
+void test_streaming_quantiles() {
+    std::cout << "\nTest 3: P-Squared Quantiles - Exact Start, Normal Stream\n";
+    std::cout << "--------------------------------------------\n";
+    
+    StreamingQuantile median(0.5);
+    for (double value : {5.0, 1.0, 4.0}) {
+        median.add(value);
+    }
+    check(median.value() == 4.0, "Exact median of the first values");
+    
+    // 200k standard normals from Philox streams
+    Philox4x32 rng(11);
+    StreamingQuantile p05(0.05), p50(0.5), p95(0.95);
+    for (std::uint64_t i = 0; i < 100000; i++) {
+        for (double z : normalPairFromBlock(rng.block(i, 0))) {
+            p05.add(z);
+            p50.add(z);
+            p95.add(z);
+        }
+    }
+    std::cout << "    P5 " << std::setprecision(4) << p05.value() << ", P50 " << p50.value()
+              << ", P95 " << p95.value() << " (exact -1.6449, 0, 1.6449)\n";
+    check(std::abs(p50.value()) < 0.01, "Median of N(0,1) near 0");
+    check(std::abs(p05.value() + 1.6449) < 0.02 && std::abs(p95.value() - 1.6449) < 0.02,
+          "5th and 95th percentiles near -+1.645");
+}
+
+// ===========================================================================
+// SAMPLING TESTS
+// ===========================================================================
+
+void test_dispersion_sampling() {
+    std::cout << "\nTest 4: Sampling - Reproducible, Independent Dispersions\n";
+    std::cout << "--------------------------------------------\n";
+    
+    MonteCarloSpec spec = make_test_spec();
+    RunningStatistics thrust, isp;
+    bool bounded = true;
+    for (std::size_t i = 0; i < 20000; i++) {
+        MissionConfig config = spec.configAt(i);
+        thrust.add(config.spacecraft.thrust_mN);
+        isp.add(config.spacecraft.isp_s);
+        bounded = bounded && std::abs(config.spacecraft.thrust_mN - 1000) <= 30;
+    }
+    std::cout << "    Thrust " << std::setprecision(2) << thrust.mean() << " +- "
+              << thrust.stddev() << " mN, ISP " << isp.mean() << " +- " << isp.stddev() << " s\n";
+    check(bounded && std::abs(thrust.stddev() - 30 / std::sqrt(3.0)) < 0.3,
+          "Uniform thrust within +-3% with the flat-distribution spread");
+    check(std::abs(isp.mean() - 2750) < 1.5 && std::abs(isp.stddev() - 55) < 1.0,
+          "Normal ISP has the nominal mean and 2% sigma");
+    
+    MissionConfig first = spec.configAt(12345);
+    MissionConfig again = spec.configAt(12345);
+    check(first.spacecraft.thrust_mN == again.spacecraft.thrust_mN &&
+          first.spacecraft.isp_s == again.spacecraft.isp_s &&
+          first.spacecraft.initial_mass_kg == again.spacecraft.initial_mass_kg,
+          "Sample drawn again is identical");
+    
+    MonteCarloSpec fixed_mass = spec;
+    fixed_mass.initial_mass_kg = Dispersion();
+    MissionConfig other = fixed_mass.configAt(12345);
+    check(other.spacecraft.thrust_mN == first.spacecraft.thrust_mN &&
+          other.spacecraft.isp_s == first.spacecraft.isp_s &&
+          other.spacecraft.initial_mass_kg == 10000,
+          "Removing one dispersion leaves the other draws unchanged");
+}
+
+// ===========================================================================
+// MONTE CARLO RUN TESTS
+// ===========================================================================
+
+void test_monte_carlo_run() {
+    std::cout << "\nTest 5: Monte Carlo Run - Statistics Independent of Jobs\n";
+    std::cout << "--------------------------------------------\n";
+    
+    MonteCarloSpec spec = make_test_spec();
+    MonteCarloResult serial = runMonteCarlo(spec, 1);
+    MonteCarloResult parallel = runMonteCarlo(spec, 3);
+    
+    const MetricSummary* days = serial.metric("flight_time_days");
+    const MetricSummary* propellant = serial.metric("propellant_kg");
+    check(days && propellant && serial.metric("thrust_mN") && !serial.metric("unknown"),
+          "Summaries for inputs and outcomes");
+    if (!days || !propellant) {
+        return;
+    }
+    std::cout << "    Flight time " << std::setprecision(2) << days->statistics.mean() << " +- "
+              << days->statistics.stddev() << " days, propellant "
+              << propellant->statistics.mean() << " +- " << propellant->statistics.stddev()
+              << " kg, coasted " << serial.coasted << "/" << serial.samples << "\n";
+    check(serial.samples == 600 && serial.coasted == 600 && days->statistics.count() == 600,
+          "Every sample propagated and reached coast");
+    check(days->statistics.stddev() > 0 &&
+          days->quantiles[0].value() < days->quantiles[1].value() &&
+          days->quantiles[1].value() < days->quantiles[2].value(),
+          "Dispersions spread the flight time; percentiles ordered");
+    
+    bool identical = serial.coasted == parallel.coasted &&
+                     serial.metrics.size() == parallel.metrics.size();
+    for (std::size_t m = 0; identical && m < serial.metrics.size(); m++) {
+        identical = same_summary(serial.metrics[m], parallel.metrics[m]);
+    }
+    check(identical, "Same statistics with 3 jobs");
+    
+    // Without dispersions every sample is the nominal mission
+    MonteCarloSpec nominal = make_test_spec();
+    nominal.thrust_mN = Dispersion();
+    nominal.isp_s = Dispersion();
+    nominal.initial_mass_kg = Dispersion();
+    nominal.samples = 10;
+    MonteCarloResult flat = runMonteCarlo(nominal, 1);
+    PropagationResult reference = propagateMission(nominal.base,
+                                                   getOrbitalRadius(CelestialBody::EARTH),
+                                                   getOrbitalRadius(CelestialBody::MARS), false);
+    const MetricSummary* flat_days = flat.metric("flight_time_days");
+    check(flat_days && flat_days->statistics.stddev() == 0 &&
+          flat_days->statistics.mean() == reference.final_state.t / 86400.0,
+          "Zero dispersion reproduces propagateMission");
+}
+
+void test_spec_loader() {
+    std::cout << "\nTest 6: Spec Loader - Dispersions, Statistics Table, Errors\n";
+    std::cout << "--------------------------------------------\n";
+    
+    const std::string filename = "test_monte_carlo_spec.yaml";
+    write_file(filename,
+               "mission: {departure_body: Earth, arrival_body: Mars, initial_mass_kg: 8000}\n"
+               "spacecraft: {thrust_mN: 500, isp_s: 3000}\n"
+               "integration: {method: rk4, timestep_s: 20000}\n"
+               "monte_carlo:\n"
+               "  samples: 40\n"
+               "  seed: 5\n"
+               "  thrust_mN: {distribution: uniform, percent: 3}\n"
+               "  isp_s: {percent: 2}\n"
+               "  percentiles: [10, 90]\n"
+               "output: {filename: spec_results.csv}\n");
+    
+    MonteCarloSpec spec;
+    bool loaded = loadMonteCarloFromYAML(filename, spec);
+    check(loaded && spec.samples == 40 && spec.seed == 5 &&
+          spec.thrust_mN.distribution == Dispersion::Distribution::UNIFORM &&
+          spec.isp_s.distribution == Dispersion::Distribution::NORMAL && spec.isp_s.percent == 2 &&
+          spec.initial_mass_kg.distribution == Dispersion::Distribution::NONE &&
+          spec.percentiles == std::vector<double>{10, 90} &&
+          spec.output_filename == "spec_results.csv",
+          "Settings read; distribution defaults to normal");
+    
+    const std::string table = "test_monte_carlo_table.csv";
+    MonteCarloResult result = runMonteCarlo(spec, 1);
+    check(writeMonteCarloCSV(table, spec, result) &&
+          read_file(table).rfind("Metric,Count,Mean,StdDev,Min,Max,P10,P90\nthrust_mN,40,", 0) == 0,
+          "Statistics table header and first row");
+    
+    write_file(filename, "monte_carlo:\n  isp_s: {distribution: lognormal, percent: 2}\n");
+    MonteCarloSpec bad;
+    check(!loadMonteCarloFromYAML(filename, bad), "Unknown distribution rejected");
+    write_file(filename, "monte_carlo:\n  percentiles: [50, 100]\n");
+    MonteCarloSpec out_of_range;
+    check(!loadMonteCarloFromYAML(filename, out_of_range), "Percentile of 100 rejected");
+    
+    std::remove(filename.c_str());
+    std::remove(table.c_str());
+}
+
+// ===========================================================================
+// MAIN TEST RUNNER
+// ===========================================================================
+
+int main() {
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "MONTE CARLO TEST SUITE\n";
+    std::cout << "=====================================================\n";
+    
+    test_philox_known_answers();
+    test_running_statistics();
+    test_streaming_quantiles();
+    test_dispersion_sampling();
+    test_monte_carlo_run();
+    test_spec_loader();
+    
+    // Summary
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "TEST RESULTS\n";
+    std::cout << "=====================================================\n";
+    std::cout << "  Tests passed: " << tests_passed << "\n";
+    std::cout << "  Tests failed: " << tests_failed << "\n";
+    std::cout << "  Total tests:  " << (tests_passed + tests_failed) << "\n";
+    
+    if (tests_failed == 0) {
+        std::cout << "\n  ✓ ALL TESTS PASSED\n";
+        std::cout << "=====================================================\n\n";
+        return 0;
+    } else {
+        std::cout << "\n  ✗ SOME TESTS FAILED\n";
+        std::cout << "=====================================================\n\n";
+        return 1;
+    }
+}
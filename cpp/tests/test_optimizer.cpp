@@ -0,0 +1,300 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <cstdio>
+#include <cmath>
+#include <filesystem>
+#include <vector>
+#include "../src/constants.h"
+#include "../src/propagator.h"
+#include "../src/comparison.h"
+#include "../src/optimizer.h"
+
+// ===========================================================================
+// TEST FRAMEWORK HELPERS
+// ===========================================================================
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+void check(bool condition, const std::string& test_name) {
+    if (condition) {
+        std::cout << "  ✓ PASS: " << test_name << "\n";
+        tests_passed++;
+    } else {
+        std::cout << "  ✗ FAIL: " << test_name << "\n";
+        tests_failed++;
+    }
+}
+
+/// Write text to a scratch file
+void write_file(const std::string& filename, const std::string& text) {
+    std::ofstream file(filename);
+    file << text;
+}
+
+/// High-Power Hall to Mars: free thrust and ISP, 2000 kg propellant budget
+/// Fastest feasible design is full thrust at the ISP that just meets the budget.
+OptimizationSpec make_test_spec() {
+    OptimizationSpec spec;
+    spec.base.spacecraft.name = "High-Power Hall";
+    spec.base.spacecraft.thrust_mN = 1000;
+    spec.base.spacecraft.isp_s = 2750;
+    spec.base.spacecraft.initial_mass_kg = 10000;
+    spec.base.integrator = "rk4";
+    spec.base.timestep_s = 20000;
+    spec.base.max_flight_time_s = 1.577e9;
+    spec.objective = "shortest_time";
+    spec.propellant_budget_kg = 2000;
+    spec.thrust_mN = {300, 1000};
+    spec.isp_s = {1500, 4000};
+    spec.initial_mass_kg = {10000, 10000};
+    spec.starts = 3;
+    spec.max_evaluations = 60;
+    return spec;
+}
+
+bool same_result(const OptimizationResult& a, const OptimizationResult& b) {
+    if (a.starts.size() != b.starts.size() || a.best_start != b.best_start ||
+        a.evaluations != b.evaluations) {
+        return false;
+    }
+    for (std::size_t s = 0; s < a.starts.size(); s++) {
+        const OptimizationPoint& x = a.starts[s].best;
+        const OptimizationPoint& y = b.starts[s].best;
+        if (x.thrust_mN != y.thrust_mN || x.isp_s != y.isp_s || x.objective != y.objective) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ===========================================================================
+// NELDER-MEAD TESTS
+// ===========================================================================
+
+void test_nelder_mead_rosenbrock() {
+    std::cout << "\nTest 1: Nelder-Mead - Rosenbrock Valley\n";
+    std::cout << "--------------------------------------------\n";
+    
+    // Box [0,1]^2 mapped onto [-2,2]^2; minimum at (1,1), i.e. (0.75, 0.75)
+    auto rosenbrock = [](const std::vector<double>& u) {
+        double a = 4 * u[0] - 2;
+        double b = 4 * u[1] - 2;
+        return (1 - a) * (1 - a) + 100 * (b - a * a) * (b - a * a);
+    };
+    NelderMeadOptions options;
+    options.tolerance = 1e-7;
+    options.max_evaluations = 2000;
+    NelderMead search = minimizeNelderMead(rosenbrock, {0.2, 0.8}, options);
+    
+    std::cout << "    Evaluations: " << search.evaluations() << ", best f = "
+              << std::scientific << search.bestValue() << std::fixed << "\n";
+    check(search.converged(), "Converged before the evaluation limit");
+    check(std::abs(search.bestPoint()[0] - 0.75) < 1e-4 &&
+          std::abs(search.bestPoint()[1] - 0.75) < 1e-4, "Found the valley minimum");
+    check(search.pending().empty(), "No points pending once done");
+}
+
+void test_nelder_mead_bounds() {
+    std::cout << "\nTest 2: Nelder-Mead - Box Bounds and Zero Dimensions\n";
+    std::cout << "--------------------------------------------\n";
+    
+    // Unconstrained minimum at (-0.5, 0.3) lies outside the box
+    bool inside = true;
+    auto shifted = [&inside](const std::vector<double>& x) {
+        for (double xi : x) {
+            inside = inside && xi >= 0.0 && xi <= 1.0;
+        }
+        return (x[0] + 0.5) * (x[0] + 0.5) + (x[1] - 0.3) * (x[1] - 0.3);
+    };
+    NelderMeadOptions options;
+    options.tolerance = 1e-6;
+    options.max_evaluations = 500;
+    NelderMead search = minimizeNelderMead(shifted, {0.9, 0.9}, options);
+    
+    check(inside, "Every trial point inside the box");
+    check(search.bestPoint()[0] == 0.0 && std::abs(search.bestPoint()[1] - 0.3) < 1e-4,
+          "Minimum lands on the x0 = 0 face");
+    
+    options.max_evaluations = 1;
+    NelderMead capped = minimizeNelderMead(shifted, {0.9, 0.9}, options);
+    check(!capped.converged() && capped.evaluations() == 3,
+          "Evaluation limit stops after the initial simplex");
+    
+    int calls = 0;
+    NelderMead fixed = minimizeNelderMead(
+        [&calls](const std::vector<double>&) { calls++; return 42.0; }, {}, options);
+    check(calls == 1 && fixed.converged() && fixed.bestValue() == 42.0,
+          "No free parameters: a single evaluation");
+}
+
+// ===========================================================================
+// OBJECTIVE TESTS
+// ===========================================================================
+
+void test_metric_scores() {
+    std::cout << "\nTest 3: Objectives - Scores Agree with findBestMission\n";
+    std::cout << "--------------------------------------------\n";
+    
+    MissionComparison comparison;
+    const double times[] = {500, 300, 400};
+    const double fuels[] = {1200, 2500, 900};
+    for (int i = 0; i < 3; i++) {
+        MissionResult mission;
+        mission.mission_name = "mission_" + std::to_string(i);
+        mission.arrival_body = "Mars";
+        mission.flight_time_days = times[i];
+        mission.total_delta_v_km_s = 10 + i;
+        mission.initial_mass_kg = 10000;
+        mission.propellant_consumed_kg = fuels[i];
+        mission.final_mass_kg = 10000 - fuels[i];
+        comparison.addMission(mission);
+    }
+    comparison.computeMetrics();
+    
+    check(comparison.findBestMission("shortest_time").mission_name == "mission_1",
+          "shortest_time picks the fastest");
+    check(comparison.findBestMission("least_fuel").mission_name == "mission_2" &&
+          comparison.findBestMission("most_efficient").mission_name == "mission_2",
+          "least_fuel and most_efficient pick the lightest burn");
+    check(comparison.findBestMission("lowest_delta_v").mission_name == "mission_0",
+          "lowest_delta_v picks the smallest delta-V");
+    check(isMissionMetric("most_efficient") && !isMissionMetric("fastest"),
+          "Metric names validated");
+}
+
+// ===========================================================================
+// OPTIMIZER TESTS
+// ===========================================================================
+
+void test_thruster_selection() {
+    std::cout << "\nTest 4: Multi-Start Search - Fastest Design Within Budget\n";
+    std::cout << "--------------------------------------------\n";
+    
+    OptimizationSpec spec = make_test_spec();
+    OptimizationResult result = runOptimization(spec, 1);
+    const OptimizationPoint& best = result.starts[result.best_start].best;
+    
+    std::cout << "    Best: " << std::setprecision(1) << best.thrust_mN << " mN, "
+              << best.isp_s << " s ISP -> " << best.mission.flight_time_days << " days, "
+              << best.mission.propellant_consumed_kg << " kg ("
+              << result.evaluations << " evaluations, " << result.generations
+              << " generations)\n";
+    check(result.feasible && best.feasible, "Feasible design found");
+    check(best.mission.propellant_consumed_kg <= spec.propellant_budget_kg,
+          "Propellant within budget");
+    check(best.thrust_mN > 950, "Thrust driven to the upper bound");
+    check(best.mission.propellant_consumed_kg > 0.95 * spec.propellant_budget_kg,
+          "ISP driven down to the budget");
+    
+    bool best_is_minimum = true;
+    for (const OptimizationStart& start : result.starts) {
+        best_is_minimum = best_is_minimum && !(start.best.objective < best.objective);
+        best_is_minimum = best_is_minimum && start.evaluations <= spec.max_evaluations + 2;
+    }
+    check(best_is_minimum, "Overall best is the lowest objective of all starts");
+    
+    OptimizationResult parallel = runOptimization(spec, 2);
+    check(same_result(result, parallel), "Same result with 2 jobs");
+}
+
+void test_optimizer_cache() {
+    std::cout << "\nTest 5: Result Cache - Rerun Skips Every Propagation\n";
+    std::cout << "--------------------------------------------\n";
+    
+    const std::string directory = "test_optimizer_cache";
+    std::filesystem::remove_all(directory);
+    
+    OptimizationSpec spec = make_test_spec();
+    spec.max_evaluations = 30;
+    OptimizationResult uncached = runOptimization(spec, 1);
+    OptimizationResult first = runOptimization(spec, 1, directory);
+    OptimizationResult second = runOptimization(spec, 1, directory);
+    
+    std::cout << "    First run hits: " << first.cache_hits << "/" << first.evaluations
+              << ", second run hits: " << second.cache_hits << "/" << second.evaluations << "\n";
+    check(first.cache_hits < first.evaluations, "First run propagates");
+    check(second.cache_hits == second.evaluations, "Second run served from the cache");
+    check(same_result(uncached, first) && same_result(first, second),
+          "Cached results identical to propagated ones");
+    
+    std::filesystem::remove_all(directory);
+}
+
+void test_spec_loader() {
+    std::cout << "\nTest 6: Spec Loader - Ranges, Fixed Values, Errors\n";
+    std::cout << "--------------------------------------------\n";
+    
+    const std::string filename = "test_optimizer_spec.yaml";
+    write_file(filename,
+               "mission: {departure_body: Earth, arrival_body: Mars, initial_mass_kg: 8000}\n"
+               "integration: {method: rk4, timestep_s: 20000}\n"
+               "optimize:\n"
+               "  objective: least_fuel\n"
+               "  propellant_budget_kg: 1500\n"
+               "  thrust_mN: {min: 200, max: 800}\n"
+               "  isp_s: 3000\n"
+               "  starts: 4\n"
+               "  seed: 9\n"
+               "output: {filename: spec_results.csv}\n");
+    
+    OptimizationSpec spec;
+    bool loaded = loadOptimizationFromYAML(filename, spec);
+    check(loaded && spec.objective == "least_fuel" && spec.propellant_budget_kg == 1500 &&
+          spec.starts == 4 && spec.seed == 9 && spec.output_filename == "spec_results.csv",
+          "Settings read");
+    check(spec.dimensions() == 1 && spec.thrust_mN.min == 200 && spec.thrust_mN.max == 800,
+          "Thrust is the only free parameter");
+    MissionConfig config = spec.configAt({0.5});
+    check(config.spacecraft.thrust_mN == 500 && config.spacecraft.isp_s == 3000 &&
+          config.spacecraft.initial_mass_kg == 8000,
+          "Fixed ISP and base mass carried into candidates");
+    
+    write_file(filename, "optimize:\n  objective: fastest\n");
+    OptimizationSpec bad;
+    check(!loadOptimizationFromYAML(filename, bad), "Unknown objective rejected");
+    write_file(filename, "optimize:\n  thrust_mN: {min: 900, max: 100}\n");
+    OptimizationSpec inverted;
+    check(!loadOptimizationFromYAML(filename, inverted), "Inverted range rejected");
+    
+    std::remove(filename.c_str());
+}
+
+// ===========================================================================
+// MAIN TEST RUNNER
+// ===========================================================================
+
+int main() {
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "OPTIMIZER TEST SUITE\n";
+    std::cout << "=====================================================\n";
+    
+    test_nelder_mead_rosenbrock();
+    test_nelder_mead_bounds();
+    test_metric_scores();
+    test_thruster_selection();
+    test_optimizer_cache();
+    test_spec_loader();
+    
+    // Summary
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "TEST RESULTS\n";
+    std::cout << "=====================================================\n";
+    std::cout << "  Tests passed: " << tests_passed << "\n";
+    std::cout << "  Tests failed: " << tests_failed << "\n";
+    std::cout << "  Total tests:  " << (tests_passed + tests_failed) << "\n";
+    
+    if (tests_failed == 0) {
+        std::cout << "\n  ✓ ALL TESTS PASSED\n";
+        std::cout << "=====================================================\n\n";
+        return 0;
+    } else {
+        std::cout << "\n  ✗ SOME TESTS FAILED\n";
+        std::cout << "=====================================================\n\n";
+        return 1;
+    }
+}
@@ -0,0 +1,204 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <cstdio>
+#include <cmath>
+#include <vector>
+#include "../src/constants.h"
+#include "../src/propagator.h"
+#include "../src/mission_propagation.h"
+#include "../src/parameter_sweep.h"
+
+// ===========================================================================
+// TEST FRAMEWORK HELPERS
+// ===========================================================================
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+void check(bool condition, const std::string& test_name) {
+    if (condition) {
+        std::cout << "  ✓ PASS: " << test_name << "\n";
+        tests_passed++;
+    } else {
+        std::cout << "  ✗ FAIL: " << test_name << "\n";
+        tests_failed++;
+    }
+}
+
+/// Write text to a scratch file
+void write_file(const std::string& filename, const std::string& text) {
+    std::ofstream file(filename);
+    file << text;
+}
+
+/// Count data rows (excluding header) in a CSV file
+long count_csv_rows(const std::string& filename) {
+    std::ifstream file(filename);
+    std::string line;
+    long rows = -1;
+    while (std::getline(file, line)) {
+        rows++;
+    }
+    return rows;
+}
+
+/// Small High-Power Hall grid: 3 thrust x 2 ISP x 2 destinations
+ParameterSweep make_test_sweep() {
+    ParameterSweep sweep;
+    sweep.base.spacecraft.thrust_mN = 1000;
+    sweep.base.spacecraft.isp_s = 2750;
+    sweep.base.spacecraft.initial_mass_kg = 10000;
+    sweep.base.timestep_s = 20000;
+    sweep.base.max_flight_time_s = 1.577e9;
+    sweep.thrust_mN = {600, 800, 1000};
+    sweep.isp_s = {2750, 4000};
+    sweep.destinations = {CelestialBody::MARS, CelestialBody::VENUS};
+    return sweep;
+}
+
+// ===========================================================================
+// GRID EXPANSION TESTS
+// ===========================================================================
+
+void test_grid_expansion() {
+    std::cout << "\nTest 1: Grid Expansion - Index Order and Base Values\n";
+    std::cout << "--------------------------------------------\n";
+    
+    ParameterSweep sweep = make_test_sweep();
+    check(sweep.size() == 12, "Grid size is the product of the axis lengths");
+    
+    MissionConfig first = sweep.configAt(0);
+    MissionConfig second = sweep.configAt(1);
+    MissionConfig next_isp = sweep.configAt(3);
+    MissionConfig last = sweep.configAt(11);
+    
+    check(first.spacecraft.thrust_mN == 600 && second.spacecraft.thrust_mN == 800 &&
+          first.spacecraft.isp_s == second.spacecraft.isp_s,
+          "Thrust varies fastest");
+    check(next_isp.spacecraft.thrust_mN == 600 && next_isp.spacecraft.isp_s == 4000,
+          "ISP advances after a full thrust row");
+    check(first.arrival_body == CelestialBody::MARS && last.arrival_body == CelestialBody::VENUS,
+          "Destination varies slowest");
+    check(last.spacecraft.initial_mass_kg == 10000 && last.timestep_s == 20000,
+          "Unswept parameters keep the base value");
+}
+
+void test_sweep_yaml_axes() {
+    std::cout << "\nTest 2: Sweep File - Lists, Ranges and Single Values\n";
+    std::cout << "--------------------------------------------\n";
+    
+    const std::string filename = "test_parameter_sweep.yaml";
+    write_file(filename,
+               "mission:\n"
+               "  departure_body: Earth\n"
+               "  initial_mass_kg: 8000\n"
+               "integration:\n"
+               "  method: rk4\n"
+               "  timestep_s: 5000\n"
+               "sweep:\n"
+               "  thrust_mN: {start: 100, stop: 500, count: 5}\n"
+               "  isp_s: [1500, 4000]\n"
+               "  initial_mass_kg: {start: 5000, stop: 20000, step: 5000}\n"
+               "  timestep_s: 10000\n"
+               "  destination: [mars, Jupiter]\n"
+               "output:\n"
+               "  filename: trade.csv\n");
+    
+    ParameterSweep sweep;
+    bool loaded = loadSweepFromYAML(filename, sweep);
+    check(loaded, "Sweep file loads");
+    check(sweep.thrust_mN.size() == 5 && sweep.thrust_mN[1] == 200 && sweep.thrust_mN[4] == 500,
+          "count range is an inclusive linspace");
+    check(sweep.initial_mass_kg.size() == 4 && sweep.initial_mass_kg[3] == 20000,
+          "step range includes the stop value");
+    check(sweep.timestep_s.size() == 1 && sweep.timestep_s[0] == 10000,
+          "Scalar axis has one value");
+    check(sweep.destinations.size() == 2 && sweep.destinations[1] == CelestialBody::JUPITER,
+          "Destination names parsed");
+    check(sweep.size() == 80 && sweep.output_filename == "trade.csv",
+          "Grid size and output file name");
+    
+    write_file(filename, "sweep:\n  thrust_mN: {start: 100, stop: 500}\n");
+    ParameterSweep malformed;
+    check(!loadSweepFromYAML(filename, malformed), "Range without count or step rejected");
+    
+    std::remove(filename.c_str());
+}
+
+// ===========================================================================
+// SWEEP EXECUTION TESTS
+// ===========================================================================
+
+void test_sweep_matches_single_missions() {
+    std::cout << "\nTest 3: Sweep Execution - Matches Single-Mission Propagation\n";
+    std::cout << "--------------------------------------------\n";
+    
+    ParameterSweep sweep = make_test_sweep();
+    std::vector<SweepPointResult> results = runParameterSweep(sweep, 2);
+    check(results.size() == sweep.size(), "One result per grid point");
+    
+    double r_dep = getOrbitalRadius(CelestialBody::EARTH);
+    bool all_match = true;
+    for (size_t i = 0; i < results.size(); i++) {
+        MissionConfig config = sweep.configAt(i);
+        PropagationResult single = propagateMission(config, r_dep,
+                                                    getOrbitalRadius(config.arrival_body));
+        all_match = all_match &&
+                    results[i].thrust_mN == config.spacecraft.thrust_mN &&
+                    results[i].destination == config.arrival_body &&
+                    results[i].coasted == (single.coast_step >= 0) &&
+                    results[i].flight_time_days == single.final_state.t / 86400.0 &&
+                    results[i].final_mass_kg == single.final_state.m;
+    }
+    check(all_match, "Every point equals its propagateMission result, in index order");
+}
+
+void test_sweep_csv_table() {
+    std::cout << "\nTest 4: Sweep Table - One Row per Grid Point\n";
+    std::cout << "--------------------------------------------\n";
+    
+    ParameterSweep sweep = make_test_sweep();
+    std::vector<SweepPointResult> results = runParameterSweep(sweep, 1);
+    
+    const std::string filename = "test_parameter_sweep.csv";
+    check(writeSweepCSV(filename, results), "Table written");
+    check(count_csv_rows(filename) == static_cast<long>(results.size()), "Row count matches");
+    std::remove(filename.c_str());
+}
+
+// ===========================================================================
+// MAIN TEST RUNNER
+// ===========================================================================
+
+int main() {
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "PARAMETER SWEEP TEST SUITE\n";
+    std::cout << "=====================================================\n";
+    
+    test_grid_expansion();
+    test_sweep_yaml_axes();
+    test_sweep_matches_single_missions();
+    test_sweep_csv_table();
+    
+    // Summary
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "TEST RESULTS\n";
+    std::cout << "=====================================================\n";
+    std::cout << "  Tests passed: " << tests_passed << "\n";
+    std::cout << "  Tests failed: " << tests_failed << "\n";
+    std::cout << "  Total tests:  " << (tests_passed + tests_failed) << "\n";
+    
+    if (tests_failed == 0) {
+        std::cout << "\n  ✓ ALL TESTS PASSED\n";
+        std::cout << "=====================================================\n\n";
+        return 0;
+    } else {
+        std::cout << "\n  ✗ SOME TESTS FAILED\n";
+        std::cout << "=====================================================\n\n";
+        return 1;
+    }
+}
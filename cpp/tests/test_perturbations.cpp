@@ -0,0 +1,309 @@
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <string>
+#include "../src/constants.h"
+#include "../src/propagator.h"
+#include "../src/mission_propagation.h"
+#include "../src/batch_propagator.h"
+#include "../src/ephemeris.h"
+#include "../src/force_model.h"
+
+// ===========================================================================
+// TEST FRAMEWORK HELPERS
+// ===========================================================================
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+void check(bool condition, const std::string& test_name) {
+    if (condition) {
+        std::cout << "  ✓ PASS: " << test_name << "\n";
+        tests_passed++;
+    } else {
+        std::cout << "  ✗ FAIL: " << test_name << "\n";
+        tests_failed++;
+    }
+}
+
+double distance(const double a[3], const double b[3]) {
+    double dx = a[0] - b[0];
+    double dy = a[1] - b[1];
+    double dz = a[2] - b[2];
+    return std::sqrt(dx*dx + dy*dy + dz*dz);
+}
+
+bool same_state(const MissionState& a, const MissionState& b) {
+    for (int i = 0; i < 3; i++) {
+        if (a.r[i] != b.r[i] || a.v[i] != b.v[i]) {
+            return false;
+        }
+    }
+    return a.m == b.m && a.t == b.t;
+}
+
+/// Earth-Mars with the High-Power Hall thruster
+MissionConfig mars_mission() {
+    MissionConfig config;
+    config.spacecraft.thrust_mN = 1000;
+    config.spacecraft.isp_s = 2750;
+    config.timestep_s = 20000;
+    return config;
+}
+
+PerturbationSpec third_body(CelestialBody body, double phase_deg) {
+    PerturbationSpec spec;
+    spec.type = "third_body";
+    spec.body = body;
+    spec.phase_deg = phase_deg;
+    return spec;
+}
+
+PerturbationSpec solar_pressure(double area_m2) {
+    PerturbationSpec spec;
+    spec.type = "solar_radiation_pressure";
+    spec.area_m2 = area_m2;
+    return spec;
+}
+
+// ===========================================================================
+// EPHEMERIS TESTS
+// ===========================================================================
+
+void test_chebyshev_table() {
+    std::cout << "\nTest 1: Chebyshev Ephemeris - Fit and Shared Tables\n";
+    std::cout << "--------------------------------------------\n";
+    
+    double span = 3.0e8;
+    ChebyshevEphemeris mercury(CelestialBody::MERCURY, 30.0, span);
+    double max_position_error = 0;
+    double max_velocity_error = 0;
+    for (int i = 0; i <= 5000; i++) {
+        double t = span * i / 5000.0;
+        double r[3];
+        double v[3];
+        double r_exact[3];
+        double v_exact[3];
+        mercury.evaluate(t, r, v);
+        circularOrbitState(CelestialBody::MERCURY, 30.0, t, r_exact, v_exact);
+        max_position_error = std::fmax(max_position_error, distance(r, r_exact));
+        max_velocity_error = std::fmax(max_velocity_error, distance(v, v_exact));
+    }
+    std::cout << "    Mercury over " << std::fixed << std::setprecision(1) << span / 86400.0
+              << " days: position " << std::scientific << std::setprecision(2)
+              << max_position_error << " km, velocity " << max_velocity_error << " km/s\n";
+    check(max_position_error < 1e-3, "Position matches the circular orbit to 1 m");
+    check(max_velocity_error < 1e-9, "Differentiated series gives the velocity");
+    
+    std::shared_ptr<const ChebyshevEphemeris> a = sharedEphemeris(CelestialBody::JUPITER, 0, 1e8);
+    std::shared_ptr<const ChebyshevEphemeris> b = sharedEphemeris(CelestialBody::JUPITER, 0, 5e7);
+    std::shared_ptr<const ChebyshevEphemeris> other = sharedEphemeris(CelestialBody::JUPITER,
+                                                                      90, 5e7);
+    check(a == b && a != other, "One shared table per body and phase");
+    std::shared_ptr<const ChebyshevEphemeris> longer = sharedEphemeris(CelestialBody::JUPITER,
+                                                                       0, 2e8);
+    check(longer != a && longer->span() >= 2e8 && a->span() >= 1e8,
+          "A longer span replaces the table; the old one stays valid");
+}
+
+void test_sampler_cadence() {
+    std::cout << "\nTest 2: Ephemeris Sampler - Cadence and Interpolation\n";
+    std::cout << "--------------------------------------------\n";
+    
+    std::shared_ptr<const ChebyshevEphemeris> earth = sharedEphemeris(CelestialBody::EARTH, 0, 1e8);
+    EphemerisSampler daily(earth, 86400);
+    EphemerisSampler every_call(earth, 0);
+    double max_error = 0;
+    const int calls = 1000;
+    for (int i = 0; i < calls; i++) {
+        double t = 1.0e7 + 864.0 * i;    // Ten days, 1000 stage times
+        double r[3];
+        double r_table[3];
+        daily.position(t, r);
+        every_call.position(t, r_table);
+        max_error = std::fmax(max_error, distance(r, r_table));
+    }
+    std::cout << "    Table evaluations: " << daily.tableEvaluations() << " (daily), "
+              << every_call.tableEvaluations() << " (every call); interpolation error "
+              << std::scientific << std::setprecision(2) << max_error << " km\n";
+    check(daily.tableEvaluations() <= 12 && every_call.tableEvaluations() == calls,
+          "Daily cadence: one table evaluation per day");
+    check(max_error < 0.1, "Hermite interpolation within 100 m");
+    
+    // Same t, same answer, regardless of the calls before it
+    double r_forward[3];
+    double r_fresh[3];
+    daily.position(2.0e7, r_forward);
+    EphemerisSampler fresh(earth, 86400);
+    fresh.position(2.0e7, r_fresh);
+    check(distance(r_forward, r_fresh) == 0, "Result depends on t only");
+}
+
+// ===========================================================================
+// PERTURBATION MODEL TESTS
+// ===========================================================================
+
+void test_accelerations() {
+    std::cout << "\nTest 3: Third-Body and Radiation Pressure Accelerations\n";
+    std::cout << "--------------------------------------------\n";
+    
+    double mu_jupiter = getBodyInfo(CelestialBody::JUPITER).mu_km3_s2;
+    std::shared_ptr<const ChebyshevEphemeris> jupiter =
+        sharedEphemeris(CelestialBody::JUPITER, 0, 1e8);
+    ThirdBodyPerturbation third(mu_jupiter, EphemerisSampler(jupiter, 0));
+    
+    // 0.1 AU sunward of Jupiter at t = 0: direct pull plus indirect term
+    double r[3] = {R_JUPITER - 1.496e7, 0, 0};
+    double a[3] = {0, 0, 0};
+    third.addAcceleration(r, 0.0, 1000.0, a);
+    double expected = mu_jupiter / (1.496e7 * 1.496e7) - mu_jupiter / (R_JUPITER * R_JUPITER);
+    std::cout << "    Jupiter at 0.1 AU: " << std::scientific << std::setprecision(6) << a[0]
+              << " km/s² (expected " << expected << ")\n";
+    check(std::abs(a[0] - expected) < 1e-9 * expected && std::abs(a[1]) < 1e-9 * expected,
+          "Direct minus indirect term");
+    
+    // At the Sun the two terms cancel
+    double sun[3] = {0, 0, 0};
+    double a_sun[3] = {0, 0, 0};
+    third.addAcceleration(sun, 0.0, 1000.0, a_sun);
+    check(std::abs(a_sun[0]) < 1e-12 * expected, "No tidal acceleration at the Sun");
+    
+    // 20 m², C_r 1.3, 1000 kg at 1 AU: 4.56e-6 * 1.3 * 20 / 1000 m/s²
+    SolarRadiationPressure srp(20.0, 1.3);
+    double r_au[3] = {0, 1.495978707e8, 0};
+    double a_srp[3] = {0, 0, 0};
+    srp.addAcceleration(r_au, 0.0, 1000.0, a_srp);
+    double expected_srp = 4.56e-6 * 1.3 * 20.0 / 1000.0 * 1e-3;
+    check(std::abs(a_srp[1] - expected_srp) < 1e-12 * expected_srp && a_srp[0] == 0,
+          "Radiation pressure at 1 AU, away from the Sun");
+}
+
+void test_integrators_see_perturbation() {
+    std::cout << "\nTest 4: Stage Hook in RK4, Euler and DOP853\n";
+    std::cout << "--------------------------------------------\n";
+    
+    // Radial radiation pressure k / r² at constant mass is solar gravity
+    // with μ - k/m, so a perturbed coast must match an unperturbed one
+    const double mass = 1000.0;
+    SolarRadiationPressure srp(5000.0, 2.0);
+    double k_over_m;
+    {
+        double r[3] = {1.0, 0, 0};
+        double a[3] = {0, 0, 0};
+        srp.addAcceleration(r, 0.0, mass, a);
+        k_over_m = a[0];
+    }
+    double mu_reduced = MU_SUN - k_over_m;
+    
+    RK4Propagator rk4;
+    RK4Propagator rk4_plain;
+    EulerPropagator euler;
+    EulerPropagator euler_plain;
+    DOP853Propagator dop853(1e-8, 1e-12);
+    DOP853Propagator dop853_plain(1e-8, 1e-12);
+    rk4.setPerturbation(&srp);
+    euler.setPerturbation(&srp);
+    dop853.setPerturbation(&srp);
+    
+    MissionState start(R_EARTH, 0, 0, 0, 29.0, 0, mass, 0.0);
+    MissionState states[6] = {start, start, start, start, start, start};
+    MissionState unperturbed = start;
+    for (int i = 0; i < 500; i++) {
+        rk4_plain.step(unperturbed, 20000, 0, 0, MU_SUN, G0);
+        rk4.step(states[0], 20000, 0, 0, MU_SUN, G0);
+        rk4_plain.step(states[1], 20000, 0, 0, mu_reduced, G0);
+        euler.step(states[2], 20000, 0, 0, MU_SUN, G0);
+        euler_plain.step(states[3], 20000, 0, 0, mu_reduced, G0);
+    }
+    dop853.step(states[4], 1.0e7, 0, 0, MU_SUN, G0);
+    dop853_plain.step(states[5], 1.0e7, 0, 0, mu_reduced, G0);
+    std::cout << "    μ reduced by " << std::scientific << std::setprecision(3)
+              << k_over_m / MU_SUN << "; differences " << distance(states[0].r, states[1].r)
+              << ", " << distance(states[2].r, states[3].r) << ", "
+              << distance(states[4].r, states[5].r) << " km\n";
+    check(distance(states[0].r, states[1].r) < 1e-3, "RK4 applies it at every stage");
+    check(distance(states[2].r, states[3].r) < 1e-3, "Euler applies it");
+    check(distance(states[4].r, states[5].r) < 1e-2, "DOP853 applies it");
+    check(distance(states[0].r, unperturbed.r) > 1e3, "Without the hook the orbits differ");
+}
+
+// ===========================================================================
+// MISSION TESTS
+// ===========================================================================
+
+void test_missions() {
+    std::cout << "\nTest 5: Force-Model List in propagateMission\n";
+    std::cout << "--------------------------------------------\n";
+    
+    double r_dep = getOrbitalRadius(CelestialBody::EARTH);
+    double r_arr = getOrbitalRadius(CelestialBody::MARS);
+    MissionConfig config = mars_mission();
+    PropagationResult baseline = propagateMission(config, r_dep, r_arr, false);
+    
+    // Disabled entries change nothing, down to the last bit
+    config.perturbations.push_back(third_body(CelestialBody::JUPITER, 0));
+    config.perturbations.push_back(solar_pressure(20));
+    config.perturbations[0].enabled = false;
+    config.perturbations[1].enabled = false;
+    PropagationResult disabled = propagateMission(config, r_dep, r_arr, false);
+    check(same_state(disabled.final_state, baseline.final_state) &&
+          canPropagateAsBatch({config}), "Disabled entries: unchanged, batch kernel allowed");
+    
+    // Jupiter, and Earth trailing by 60 degrees (fast enough to test the cadence)
+    config.perturbations[0].enabled = true;
+    config.perturbations.push_back(third_body(CelestialBody::EARTH, -60));
+    config.ephemeris_cadence_s = 0;
+    PropagationResult exact = propagateMission(config, r_dep, r_arr, false);
+    config.ephemeris_cadence_s = 86400;
+    PropagationResult sampled = propagateMission(config, r_dep, r_arr, false);
+    PropagationResult again = propagateMission(config, r_dep, r_arr, false);
+    double shift = distance(sampled.coast_state.r, baseline.coast_state.r);
+    double cadence_error = distance(sampled.coast_state.r, exact.coast_state.r);
+    std::cout << "    Jupiter and Earth move the coast point by " << std::scientific
+              << std::setprecision(3) << shift << " km; daily sampling adds "
+              << cadence_error << " km\n";
+    check(sampled.coast_step >= 0 && shift > 1.0, "Third bodies perturb the transfer");
+    check(cadence_error < 1e-3 * shift, "Daily ephemeris sampling is accurate");
+    check(same_state(again.final_state, sampled.final_state), "Repeatable");
+    check(!canPropagateAsBatch({config}), "Perturbed missions stay off the batch kernel");
+    
+    // Radiation pressure pushes outward: an outbound spiral coasts sooner
+    MissionConfig sail = mars_mission();
+    sail.perturbations.push_back(solar_pressure(20000));
+    PropagationResult pushed = propagateMission(sail, r_dep, r_arr, false);
+    std::cout << "    Coast step: " << baseline.coast_step << " without, " << pushed.coast_step
+              << " with 20000 m² radiation pressure\n";
+    check(pushed.coast_step > 0 && pushed.coast_step < baseline.coast_step,
+          "Radiation pressure shortens the outbound thrust arc");
+}
+
+int main() {
+    std::cout << "=====================================================\n";
+    std::cout << "PERTURBATION FORCE MODEL TEST SUITE\n";
+    std::cout << "=====================================================\n";
+    
+    test_chebyshev_table();
+    test_sampler_cadence();
+    test_accelerations();
+    test_integrators_see_perturbation();
+    test_missions();
+    
+    // Summary
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "TEST RESULTS\n";
+    std::cout << "=====================================================\n";
+    std::cout << "  Tests passed: " << tests_passed << "\n";
+    std::cout << "  Tests failed: " << tests_failed << "\n";
+    std::cout << "  Total tests:  " << (tests_passed + tests_failed) << "\n";
+    
+    if (tests_failed == 0) {
+        std::cout << "\n  ✓ ALL TESTS PASSED\n";
+        std::cout << "=====================================================\n\n";
+        return 0;
+    } else {
+        std::cout << "\n  ✗ SOME TESTS FAILED\n";
+        std::cout << "=====================================================\n\n";
+        return 1;
+    }
+}
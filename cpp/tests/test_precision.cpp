@@ -0,0 +1,249 @@
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "../src/constants.h"
+#include "../src/propagator.h"
+#include "../src/mission_propagation.h"
+#include "../src/batch_propagator.h"
+#include "../src/precision.h"
+
+// ===========================================================================
+// TEST FRAMEWORK HELPERS
+// ===========================================================================
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+void check(bool condition, const std::string& test_name) {
+    if (condition) {
+        std::cout << "  ✓ PASS: " << test_name << "\n";
+        tests_passed++;
+    } else {
+        std::cout << "  ✗ FAIL: " << test_name << "\n";
+        tests_failed++;
+    }
+}
+
+/// Circular Earth orbit, High-Power Hall thruster mass
+MissionState earth_orbit() {
+    return MissionState(R_EARTH, 0, 0, 0, std::sqrt(MU_SUN / R_EARTH), 0, 10000.0, 0.0);
+}
+
+/// Take steps thrusting steps with a High-Power Hall thruster
+template <typename Integrator>
+MissionState thrust_steps(Integrator& integrator, int steps, double dt) {
+    MissionState state = earth_orbit();
+    for (int i = 0; i < steps; i++) {
+        integrator.step(state, dt, 1000.0, 2750.0, MU_SUN, G0);
+    }
+    return state;
+}
+
+double position_error(const MissionState& state, const MissionState& reference) {
+    double dx = state.r[0] - reference.r[0];
+    double dy = state.r[1] - reference.r[1];
+    double dz = state.r[2] - reference.r[2];
+    return std::sqrt(dx*dx + dy*dy + dz*dz);
+}
+
+bool same_state(const MissionState& a, const MissionState& b) {
+    for (int i = 0; i < 3; i++) {
+        if (a.r[i] != b.r[i] || a.v[i] != b.v[i]) {
+            return false;
+        }
+    }
+    return a.m == b.m && a.t == b.t;
+}
+
+// ===========================================================================
+// DOUBLE-DOUBLE ARITHMETIC TESTS
+// ===========================================================================
+
+void test_double_double_arithmetic() {
+    std::cout << "\nTest 1: Double-Double Arithmetic\n";
+    std::cout << "--------------------------------------------\n";
+    
+    DoubleDouble tiny = std::ldexp(1.0, -80);
+    DoubleDouble sum = DoubleDouble(1.0) + tiny;
+    DoubleDouble back = sum - DoubleDouble(1.0);
+    check(sum.hi == 1.0 && sum.lo == tiny.hi && back.hi == tiny.hi,
+          "1 + 2^-80 keeps the low part (lost in double)");
+    
+    DoubleDouble third = DoubleDouble(1.0) / DoubleDouble(3.0);
+    DoubleDouble one = third * DoubleDouble(3.0) - DoubleDouble(1.0);
+    std::cout << "    3 * (1/3) - 1 = " << std::scientific << std::setprecision(3)
+              << static_cast<double>(one) << "\n";
+    check(std::abs(static_cast<double>(one)) < 1e-30, "Division and product to ~1e-32");
+    
+    DoubleDouble root = sqrt(DoubleDouble(2.0));
+    DoubleDouble residual = root * root - DoubleDouble(2.0);
+    std::cout << "    sqrt(2)^2 - 2   = " << static_cast<double>(residual) << "\n";
+    check(std::abs(static_cast<double>(residual)) < 1e-30 &&
+          root.hi == std::sqrt(2.0), "Square root to ~1e-32, hi word is the double root");
+    check(DoubleDouble(1.0) < sum && sum > DoubleDouble(1.0) && !(sum < sum),
+          "Comparisons see the low word");
+}
+
+// ===========================================================================
+// PRECISION PROPAGATOR TESTS
+// ===========================================================================
+
+void test_double_matches_rk4() {
+    std::cout << "\nTest 2: Double Mode - Bit-Identical to RK4Propagator\n";
+    std::cout << "--------------------------------------------\n";
+    
+    RK4Propagator rk4;
+    PrecisionRK4Propagator<double, false> generic;
+    MissionState expected = thrust_steps(rk4, 3000, 10000.0);
+    MissionState actual = thrust_steps(generic, 3000, 10000.0);
+    check(same_state(actual, expected), "3000 thrusting steps, every component equal");
+    
+    // Retrograde and a dry spacecraft take the other branches
+    MissionState a = earth_orbit();
+    MissionState b = earth_orbit();
+    a.m = b.m = 1e-3;
+    for (int i = 0; i < 200; i++) {
+        rk4.step(a, 10000.0, 1000.0, 2750.0, MU_SUN, G0, -1);
+        generic.step(b, 10000.0, 1000.0, 2750.0, MU_SUN, G0, -1);
+    }
+    check(same_state(a, b) && a.m == 0, "Retrograde until dry (mass clamp), equal");
+}
+
+void test_compensation_and_reference() {
+    std::cout << "\nTest 3: Kahan Compensation against the Double-Double Reference\n";
+    std::cout << "--------------------------------------------\n";
+    
+    const int steps = 20000;
+    const double dt = 10000.0;
+    DoubleDoubleRK4Propagator reference_integrator;
+    PrecisionRK4Propagator<float, false> float_plain;
+    FloatRK4Propagator float_kahan;
+    RK4Propagator rk4;
+    CompensatedRK4Propagator rk4_kahan;
+    
+    MissionState reference = thrust_steps(reference_integrator, steps, dt);
+    double error_float = position_error(thrust_steps(float_plain, steps, dt), reference);
+    MissionState kahan_state = thrust_steps(float_kahan, steps, dt);
+    double error_float_kahan = position_error(kahan_state, reference);
+    double error_double = position_error(thrust_steps(rk4, steps, dt), reference);
+    double error_double_kahan = position_error(thrust_steps(rk4_kahan, steps, dt), reference);
+    
+    std::cout << "    Position error after " << steps << " steps (vs double-double):\n"
+              << std::scientific << std::setprecision(3)
+              << "      float          " << error_float << " km\n"
+              << "      float + Kahan  " << error_float_kahan << " km\n"
+              << "      double         " << error_double << " km\n"
+              << "      double + Kahan " << error_double_kahan << " km\n";
+    check(error_float_kahan < error_float / 10, "Compensation cuts float round-off >10x");
+    check(error_double_kahan < error_double, "Compensation reduces double round-off");
+    check(error_double < 1e-3 * reference.radius() * 1e-6, "Double within 1 ppb of reference");
+    check(kahan_state.t == steps * dt, "Compensated float time is exact");
+}
+
+void test_restart_from_foreign_state() {
+    std::cout << "\nTest 4: Working State Follows the MissionState\n";
+    std::cout << "--------------------------------------------\n";
+    
+    // A propagator that stepped another state starts afresh from this one
+    FloatRK4Propagator used;
+    MissionState other = earth_orbit();
+    other.r[0] *= 1.5;
+    for (int i = 0; i < 50; i++) {
+        used.step(other, 10000.0, 1000.0, 2750.0, MU_SUN, G0);
+    }
+    FloatRK4Propagator fresh;
+    MissionState a = earth_orbit();
+    MissionState b = earth_orbit();
+    for (int i = 0; i < 50; i++) {
+        used.step(a, 10000.0, 1000.0, 2750.0, MU_SUN, G0);
+        fresh.step(b, 10000.0, 1000.0, 2750.0, MU_SUN, G0);
+    }
+    check(same_state(a, b), "Switching states matches a fresh propagator");
+    
+    // Editing the state between steps is honored
+    MissionState c = earth_orbit();
+    fresh.step(c, 10000.0, 1000.0, 2750.0, MU_SUN, G0);
+    c.m = 5000.0;
+    MissionState d = c;
+    fresh.step(c, 10000.0, 1000.0, 2750.0, MU_SUN, G0);
+    FloatRK4Propagator fresh2;
+    fresh2.step(d, 10000.0, 1000.0, 2750.0, MU_SUN, G0);
+    check(same_state(c, d), "An edited state is reloaded");
+}
+
+// ===========================================================================
+// MISSION CONFIG TESTS
+// ===========================================================================
+
+void test_mission_precision_option() {
+    std::cout << "\nTest 5: integration.precision in propagateMission\n";
+    std::cout << "--------------------------------------------\n";
+    
+    MissionConfig config;
+    config.spacecraft.thrust_mN = 1000;
+    config.spacecraft.isp_s = 2750;
+    config.timestep_s = 20000;
+    double r_dep = getOrbitalRadius(CelestialBody::EARTH);
+    double r_arr = getOrbitalRadius(CelestialBody::MARS);
+    
+    PropagationResult baseline = propagateMission(config, r_dep, r_arr, false);
+    
+    config.precision = "double_double";
+    PropagationResult reference = propagateMission(config, r_dep, r_arr, false);
+    config.precision = "float";
+    PropagationResult fast = propagateMission(config, r_dep, r_arr, false);
+    
+    double rel_reference = position_error(reference.final_state, baseline.final_state) /
+                           baseline.final_state.radius();
+    double rel_fast = position_error(fast.final_state, baseline.final_state) /
+                      baseline.final_state.radius();
+    std::cout << "    Coast step: double " << baseline.coast_step << ", double-double "
+              << reference.coast_step << ", float " << fast.coast_step << "\n"
+              << "    Final position vs double: double-double " << std::scientific
+              << std::setprecision(2) << rel_reference << ", float " << rel_fast << "\n";
+    check(reference.coast_step == baseline.coast_step && rel_reference < 1e-10,
+          "Double-double reference agrees with double");
+    check(fast.coast_step == baseline.coast_step && rel_fast < 1e-5,
+          "Float with compensation agrees to float accuracy");
+    
+    config.precision = "quad";
+    PropagationResult unknown = propagateMission(config, r_dep, r_arr, false);
+    check(same_state(unknown.final_state, baseline.final_state),
+          "Unknown precision falls back to double");
+    
+    config.precision = "float";
+    check(!canPropagateAsBatch({config}), "Precision modes stay off the batch kernel");
+}
+
+int main() {
+    std::cout << "=====================================================\n";
+    std::cout << "PRECISION MODES TEST SUITE\n";
+    std::cout << "=====================================================\n";
+    
+    test_double_double_arithmetic();
+    test_double_matches_rk4();
+    test_compensation_and_reference();
+    test_restart_from_foreign_state();
+    test_mission_precision_option();
+    
+    // Summary
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "TEST RESULTS\n";
+    std::cout << "=====================================================\n";
+    std::cout << "  Tests passed: " << tests_passed << "\n";
+    std::cout << "  Tests failed: " << tests_failed << "\n";
+    std::cout << "  Total tests:  " << (tests_passed + tests_failed) << "\n";
+    
+    if (tests_failed == 0) {
+        std::cout << "\n  ✓ ALL TESTS PASSED\n";
+        std::cout << "=====================================================\n\n";
+        return 0;
+    } else {
+        std::cout << "\n  ✗ SOME TESTS FAILED\n";
+        std::cout << "=====================================================\n\n";
+        return 1;
+    }
+}
@@ -6,6 +6,7 @@
 #include "../src/propagator.h"
 #include "../src/dynamics.h"
 #include "../src/orbital_elements.h"
+#include "../src/mission_propagation.h"
 
 // ===========================================================================
 // TEST FRAMEWORK HELPERS
@@ -297,6 +298,255 @@ void test_energy_conservation_coasting() {
     }
 }
 
+// ===========================================================================
+// ADAPTIVE INTEGRATOR TESTS
+// ===========================================================================
+
+/// Coast one full circular orbit and return the position error (km)
+double coast_one_orbit_error(AdaptivePropagator& integrator) {
+    double r_earth = 1.496e8;
+    double v_circ = std::sqrt(MU_SUN / r_earth);
+    double period = 2 * 3.14159265358979323846 * std::sqrt(r_earth * r_earth * r_earth / MU_SUN);
+    
+    MissionState state(r_earth, 0, 0, 0, v_circ, 0, 10000, 0);
+    integrator.step(state, period, 0, 2750, MU_SUN, G0);
+    
+    double dx = state.r[0] - r_earth;
+    double dy = state.r[1];
+    return std::sqrt(dx*dx + dy*dy);
+}
+
+void test_adaptive_closed_orbit() {
+    std::cout << "\nTest 8: Adaptive Integrators - Closed Coasting Orbit\n";
+    std::cout << "--------------------------------------------\n";
+    
+    DormandPrince54Propagator rk45(1e-6, 1e-10);
+    DOP853Propagator dop853(1e-6, 1e-10);
+    
+    double err_rk45 = coast_one_orbit_error(rk45);
+    double err_dop853 = coast_one_orbit_error(dop853);
+    
+    std::cout << "    RK45 closure error:   " << std::scientific << err_rk45
+              << " km (" << rk45.acceptedSteps() << " accepted, "
+              << rk45.rejectedSteps() << " rejected)\n";
+    std::cout << "    DOP853 closure error: " << err_dop853
+              << " km (" << dop853.acceptedSteps() << " accepted, "
+              << dop853.rejectedSteps() << " rejected)\n";
+    
+    // Relative tolerance of 1e-10 on a 1.5e8 km orbit: well under 1000 km
+    if (err_rk45 < 1000.0 && err_dop853 < 1000.0) {
+        std::cout << "  ✓ PASS: Orbit closes to tolerance\n";
+        tests_passed++;
+    } else {
+        std::cout << "  ✗ FAIL: Orbit does not close to tolerance\n";
+        tests_failed++;
+    }
+    
+    // Higher-order pair should need fewer steps at the same tolerance
+    if (dop853.acceptedSteps() < rk45.acceptedSteps()) {
+        std::cout << "  ✓ PASS: DOP853 takes fewer steps than RK45\n";
+        tests_passed++;
+    } else {
+        std::cout << "  ✗ FAIL: DOP853 should take fewer steps than RK45\n";
+        tests_failed++;
+    }
+}
+
+void test_adaptive_tolerance_scaling() {
+    std::cout << "\nTest 9: Adaptive Integrators - Tolerance Controls Error\n";
+    std::cout << "--------------------------------------------\n";
+    
+    DormandPrince54Propagator loose(1e-3, 1e-7);
+    DormandPrince54Propagator tight(1e-6, 1e-11);
+    
+    double err_loose = coast_one_orbit_error(loose);
+    double err_tight = coast_one_orbit_error(tight);
+    
+    std::cout << "    Loose tolerance error: " << std::scientific << err_loose << " km\n";
+    std::cout << "    Tight tolerance error: " << err_tight << " km\n";
+    
+    if (err_tight < err_loose && tight.acceptedSteps() > loose.acceptedSteps()) {
+        std::cout << "  ✓ PASS: Tighter tolerance gives smaller error with more steps\n";
+        tests_passed++;
+    } else {
+        std::cout << "  ✗ FAIL: Tighter tolerance should reduce error\n";
+        tests_failed++;
+    }
+}
+
+void test_adaptive_mass_flow() {
+    std::cout << "\nTest 10: Adaptive Integrators - Mass Flow Matches Rocket Equation\n";
+    std::cout << "--------------------------------------------\n";
+    
+    double r_earth = 1.496e8;
+    double v_circ = std::sqrt(MU_SUN / r_earth);
+    MissionState state(r_earth, 0, 0, 0, v_circ, 0, 10000, 0);
+    
+    DOP853Propagator dop853;
+    double dt = 1.0e6;
+    dop853.step(state, dt, 1000, 2750, MU_SUN, G0);
+    
+    // Constant thrust: m(t) = m0 - F * t / (isp * g0)
+    double m_expected = 10000 - 1000 * 1e-6 * dt / (2750 * G0);
+    assert_close(state.m, m_expected, 1e-10, "Mass after 1e6 s of thrust");
+    assert_close(state.t, dt, 1e-12, "Fixed-interval step lands on requested time");
+}
+
+// ===========================================================================
+// VARIATIONAL EQUATION TESTS
+// ===========================================================================
+
+/// n thrusting RK4 steps from state, optionally carrying sensitivity
+MissionState rk4_steps(MissionState state, double thrust_mN, double isp_s, int n,
+                       StateSensitivity* sensitivity = nullptr) {
+    RK4Propagator rk4;
+    for (int k = 0; k < n; k++) {
+        if (sensitivity) {
+            rk4.stepWithSensitivity(state, *sensitivity, 10000, thrust_mN, isp_s, MU_SUN, G0);
+        } else {
+            rk4.step(state, 10000, thrust_mN, isp_s, MU_SUN, G0);
+        }
+    }
+    return state;
+}
+
+/// State as y = [r, v, m]
+void state_vector(const MissionState& state, double y[7]) {
+    for (int i = 0; i < 3; i++) {
+        y[i] = state.r[i];
+        y[3 + i] = state.v[i];
+    }
+    y[6] = state.m;
+}
+
+void test_rk4_sensitivity_finite_difference() {
+    std::cout << "\nTest 11: RK4 Variational Step - Jacobian vs Finite Differences\n";
+    std::cout << "--------------------------------------------\n";
+    
+    // Slightly eccentric, inclined start so no Jacobian entry is trivially zero
+    double r_earth = 1.496e8;
+    double v_circ = std::sqrt(MU_SUN / r_earth);
+    MissionState start(r_earth, 2.0e6, 1.0e6, -0.3, v_circ * 1.01, 0.2, 10000, 0);
+    const double thrust = 1000, isp = 2750;
+    const int steps = 500;  // ~58 days
+    
+    StateSensitivity sensitivity;
+    MissionState with = rk4_steps(start, thrust, isp, steps, &sensitivity);
+    MissionState without = rk4_steps(start, thrust, isp, steps);
+    bool identical = true;
+    for (int i = 0; i < 3; i++) {
+        identical = identical && with.r[i] == without.r[i] && with.v[i] == without.v[i];
+    }
+    identical = identical && with.m == without.m && with.t == without.t;
+    if (identical) {
+        std::cout << "  ✓ PASS: State bit-identical to step()\n";
+        tests_passed++;
+    } else {
+        std::cout << "  ✗ FAIL: State bit-identical to step()\n";
+        tests_failed++;
+    }
+    
+    // Central differences, one column at a time
+    const double h[StateSensitivity::COLUMNS] = {10, 10, 10, 1e-4, 1e-4, 1e-4, 1e-2, 1e-2, 1e-1};
+    const char* names[StateSensitivity::COLUMNS] = {"rx0", "ry0", "rz0", "vx0", "vy0", "vz0",
+                                                    "m0", "thrust", "isp"};
+    for (int j = 0; j < StateSensitivity::COLUMNS; j++) {
+        MissionState plus = start, minus = start;
+        double thrust_plus = thrust, thrust_minus = thrust, isp_plus = isp, isp_minus = isp;
+        if (j < 3) {
+            plus.r[j] += h[j];
+            minus.r[j] -= h[j];
+        } else if (j < 6) {
+            plus.v[j - 3] += h[j];
+            minus.v[j - 3] -= h[j];
+        } else if (j == 6) {
+            plus.m += h[j];
+            minus.m -= h[j];
+        } else if (j == StateSensitivity::THRUST) {
+            thrust_plus += h[j];
+            thrust_minus -= h[j];
+        } else {
+            isp_plus += h[j];
+            isp_minus -= h[j];
+        }
+        double y_plus[7], y_minus[7];
+        state_vector(rk4_steps(plus, thrust_plus, isp_plus, steps), y_plus);
+        state_vector(rk4_steps(minus, thrust_minus, isp_minus, steps), y_minus);
+        
+        // Worst entry relative to the largest entry of the column, per
+        // block (position, velocity, mass) so km and km/s do not mix
+        double worst = 0;
+        for (int block = 0; block < 3; block++) {
+            int first = block * 3, last = (block == 2) ? 7 : first + 3;
+            double scale = 0, error = 0;
+            for (int i = first; i < last; i++) {
+                double fd = (y_plus[i] - y_minus[i]) / (2 * h[j]);
+                scale = std::max(scale, std::abs(sensitivity.jacobian[i][j]));
+                error = std::max(error, std::abs(fd - sensitivity.jacobian[i][j]));
+            }
+            if (scale > 0) {
+                worst = std::max(worst, error / scale);
+            }
+        }
+        if (worst < 1e-5) {
+            std::cout << "  ✓ PASS: Column d/d" << names[j] << " (relative error "
+                      << std::scientific << std::setprecision(1) << worst << ")\n";
+            tests_passed++;
+        } else {
+            std::cout << "  ✗ FAIL: Column d/d" << names[j] << " (relative error "
+                      << std::scientific << std::setprecision(1) << worst << ")\n";
+            tests_failed++;
+        }
+    }
+}
+
+void test_mission_sensitivity() {
+    std::cout << "\nTest 12: Mission Sensitivity - One Pass Instead of Re-Runs\n";
+    std::cout << "--------------------------------------------\n";
+    
+    MissionConfig config;
+    config.spacecraft.thrust_mN = 1000;
+    config.spacecraft.isp_s = 2750;
+    config.spacecraft.initial_mass_kg = 10000;
+    config.timestep_s = 10000;
+    config.max_flight_time_s = 3.0e7;   // Nothing but the time limit ends the arc
+    config.coast_threshold = 10;
+    double r_dep = getOrbitalRadius(CelestialBody::EARTH);
+    double r_arr = getOrbitalRadius(CelestialBody::MARS);
+    
+    NullTrajectorySink sink;
+    PropagationResult plain = propagateMission(config, r_dep, r_arr, sink);
+    config.compute_sensitivity = true;
+    PropagationResult with = propagateMission(config, r_dep, r_arr, sink);
+    
+    if (with.has_sensitivity && !plain.has_sensitivity &&
+        with.final_state.r[0] == plain.final_state.r[0] && with.final_state.m == plain.final_state.m) {
+        std::cout << "  ✓ PASS: Same final state, Jacobian attached\n";
+        tests_passed++;
+    } else {
+        std::cout << "  ✗ FAIL: Same final state, Jacobian attached\n";
+        tests_failed++;
+    }
+    
+    // d(final x)/d(thrust) and d(final m)/d(isp) against re-runs
+    config.compute_sensitivity = false;
+    const double dT = 0.01, dI = 0.1;
+    config.spacecraft.thrust_mN = 1000 + dT;
+    double x_plus = propagateMission(config, r_dep, r_arr, sink).final_state.r[0];
+    config.spacecraft.thrust_mN = 1000 - dT;
+    double x_minus = propagateMission(config, r_dep, r_arr, sink).final_state.r[0];
+    config.spacecraft.thrust_mN = 1000;
+    config.spacecraft.isp_s = 2750 + dI;
+    double m_plus = propagateMission(config, r_dep, r_arr, sink).final_state.m;
+    config.spacecraft.isp_s = 2750 - dI;
+    double m_minus = propagateMission(config, r_dep, r_arr, sink).final_state.m;
+    
+    assert_close(with.sensitivity.jacobian[0][StateSensitivity::THRUST],
+                 (x_plus - x_minus) / (2 * dT), 1e-5, "d(final rx)/d(thrust)");
+    assert_close(with.sensitivity.jacobian[6][StateSensitivity::ISP],
+                 (m_plus - m_minus) / (2 * dI), 1e-6, "d(final mass)/d(isp)");
+}
+
 // ===========================================================================
 // MAIN TEST RUNNER
 // ===========================================================================
@@ -320,6 +570,15 @@ int main() {
     // Conservation tests
     test_energy_conservation_coasting();
     
+    // Adaptive integrator tests
+    test_adaptive_closed_orbit();
+    test_adaptive_tolerance_scaling();
+    test_adaptive_mass_flow();
+    
+    // Variational equation tests
+    test_rk4_sensitivity_finite_difference();
+    test_mission_sensitivity();
+    
     // Summary
     std::cout << "\n";
     std::cout << "=====================================================\n";
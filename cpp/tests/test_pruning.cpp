@@ -0,0 +1,363 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <cstdio>
+#include <cmath>
+#include <thread>
+#include <vector>
+#include "../src/constants.h"
+#include "../src/propagator.h"
+#include "../src/mission_propagation.h"
+#include "../src/batch_propagator.h"
+#include "../src/parameter_sweep.h"
+#include "../src/comparison.h"
+#include "../src/pruning.h"
+
+// ===========================================================================
+// TEST FRAMEWORK HELPERS
+// ===========================================================================
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+void check(bool condition, const std::string& test_name) {
+    if (condition) {
+        std::cout << "  ✓ PASS: " << test_name << "\n";
+        tests_passed++;
+    } else {
+        std::cout << "  ✗ FAIL: " << test_name << "\n";
+        tests_failed++;
+    }
+}
+
+bool same_state(const MissionState& a, const MissionState& b) {
+    for (int i = 0; i < 3; i++) {
+        if (a.r[i] != b.r[i] || a.v[i] != b.v[i]) {
+            return false;
+        }
+    }
+    return a.m == b.m && a.t == b.t;
+}
+
+bool same_result(const PropagationResult& a, const PropagationResult& b) {
+    return same_state(a.final_state, b.final_state) && a.total_delta_v == b.total_delta_v &&
+           a.coast_step == b.coast_step && a.accepted_steps == b.accepted_steps &&
+           a.pruned == b.pruned;
+}
+
+/// Earth-Mars at thrust_mN and isp_s
+MissionConfig mars_mission(double thrust_mN, double isp_s = 2750) {
+    MissionConfig config;
+    config.spacecraft.thrust_mN = thrust_mN;
+    config.spacecraft.isp_s = isp_s;
+    config.timestep_s = 20000;
+    return config;
+}
+
+double r_earth() { return getOrbitalRadius(CelestialBody::EARTH); }
+double r_mars() { return getOrbitalRadius(CelestialBody::MARS); }
+
+// ===========================================================================
+// BOUND TESTS
+// ===========================================================================
+
+void test_bound() {
+    std::cout << "\nTest 1: Bound - Scores, Strict Pruning and Concurrent Offers\n";
+    std::cout << "--------------------------------------------\n";
+    
+    // A finished mission scored both ways
+    MissionResult mission;
+    mission.flight_time_days = 123456.0 / 86400.0;
+    mission.total_delta_v_km_s = 5.25;
+    mission.initial_mass_kg = 10000;
+    mission.final_mass_kg = 8123.5;
+    mission.propellant_consumed_kg = mission.initial_mass_kg - mission.final_mass_kg;
+    computeMissionMetrics(mission);
+    
+    bool agree = true;
+    for (const char* metric : {"shortest_time", "lowest_delta_v", "least_fuel", "most_efficient"}) {
+        PruningBound bound(metric);
+        agree = agree && bound.score(123456.0, 5.25, 8123.5, 10000) ==
+                         missionMetricScore(mission, metric);
+    }
+    check(agree, "Running score equals missionMetricScore on the finished fields");
+    
+    PruningBound bound("least_fuel");
+    check(std::isinf(bound.bestScore()) && !bound.prunes(1e300),
+          "Nothing is pruned before a mission has finished");
+    bound.offer(500);
+    bound.offer(700);
+    check(bound.bestScore() == 500, "Offers only ever lower the bound");
+    check(!bound.prunes(500) && bound.prunes(500.001),
+          "A mission on a par with the best is kept; a worse one is pruned");
+    
+    // Threads racing to lower the bound leave the minimum of all offers
+    PruningBound shared("lowest_delta_v");
+    std::vector<std::thread> threads;
+    for (int k = 0; k < 4; k++) {
+        threads.emplace_back([&shared, k]() {
+            for (int i = 0; i < 20000; i++) {
+                shared.offer(1.0 + ((i * 7919 + k * 104729) % 20000));
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    check(shared.bestScore() == 1.0, "Concurrent offers leave the smallest score");
+}
+
+// ===========================================================================
+// SINGLE-MISSION TESTS
+// ===========================================================================
+
+void test_single_missions() {
+    std::cout << "\nTest 2: Missions - Best Unchanged, Worse Ones Stopped\n";
+    std::cout << "--------------------------------------------\n";
+    
+    MissionConfig fast = mars_mission(1000);
+    MissionConfig slow = mars_mission(600);
+    PropagationResult fast_ref = propagateMission(fast, r_earth(), r_mars());
+    PropagationResult slow_ref = propagateMission(slow, r_earth(), r_mars());
+    check(fast_ref.coast_step >= 0 && slow_ref.final_state.t > fast_ref.final_state.t,
+          "Reference: 1000 mN reaches coast before 600 mN");
+    
+    // Best mission first: the slower one stops one step past its flight time
+    PruningBound bound("shortest_time");
+    fast.pruning = &bound;
+    slow.pruning = &bound;
+    PropagationResult fast_run = propagateMission(fast, r_earth(), r_mars());
+    PropagationResult slow_run = propagateMission(slow, r_earth(), r_mars());
+    check(same_result(fast_run, fast_ref), "The best mission is bit-identical with pruning");
+    check(slow_run.pruned && slow_run.coast_step < 0 &&
+          slow_run.final_state.t == fast_ref.final_state.t + slow.timestep_s,
+          "The slower mission stops at the first step past the best flight time");
+    
+    PruningStats stats = bound.stats();
+    check(stats.missions == 2 && stats.pruned == 1 &&
+          stats.steps == fast_run.accepted_steps + slow_run.accepted_steps &&
+          stats.pruned_steps == slow_run.accepted_steps && stats.steps_skipped > 0,
+          "Statistics count the stopped mission and the budget it had left");
+    
+    // Best mission last: nothing can be pruned, and nothing changes
+    PruningBound reversed("shortest_time");
+    fast.pruning = &reversed;
+    slow.pruning = &reversed;
+    PropagationResult slow_first = propagateMission(slow, r_earth(), r_mars());
+    PropagationResult fast_last = propagateMission(fast, r_earth(), r_mars());
+    check(same_result(slow_first, slow_ref) && same_result(fast_last, fast_ref) &&
+          reversed.stats().pruned == 0,
+          "In the other order both missions run to the end unchanged");
+    
+    // The adaptive loop checks the same bound
+    PruningBound fuel("least_fuel");
+    MissionConfig frugal = mars_mission(1000, 4000);
+    MissionConfig thirsty = mars_mission(1000, 1500);
+    thirsty.integrator = "dop853";
+    frugal.pruning = &fuel;
+    thirsty.pruning = &fuel;
+    PropagationResult frugal_run = propagateMission(frugal, r_earth(), r_mars());
+    PropagationResult thirsty_run = propagateMission(thirsty, r_earth(), r_mars());
+    double frugal_fuel = frugal.spacecraft.initial_mass_kg - frugal_run.final_state.m;
+    double thirsty_fuel = thirsty.spacecraft.initial_mass_kg - thirsty_run.final_state.m;
+    std::cout << "  least_fuel: " << std::fixed << std::setprecision(1) << frugal_fuel
+              << " kg at 4000 s ISP; 1500 s ISP (dop853) stopped at " << thirsty_fuel
+              << " kg after " << thirsty_run.accepted_steps << " steps\n";
+    check(frugal_run.coast_step >= 0 && thirsty_run.pruned && thirsty_fuel > frugal_fuel,
+          "dop853 missions are pruned on propellant use too");
+}
+
+// ===========================================================================
+// BATCH KERNEL TESTS
+// ===========================================================================
+
+void test_batch_lanes() {
+    std::cout << "\nTest 3: Batch Kernel - Lanes Stop Once the Best Lane Finishes\n";
+    std::cout << "--------------------------------------------\n";
+    
+    std::vector<MissionConfig> configs = {mars_mission(600), mars_mission(800),
+                                          mars_mission(1000), mars_mission(700)};
+    check(canPropagateAsBatch(configs), "Unpruned set runs on the SoA kernel");
+    std::vector<PropagationResult> reference =
+        propagateMissionBatch(configs, r_earth(), r_mars());
+    
+    PruningBound bound("shortest_time");
+    for (MissionConfig& config : configs) {
+        config.pruning = &bound;
+    }
+    check(canPropagateAsBatch(configs), "A shared bound keeps the set on the SoA kernel");
+    std::vector<PropagationResult> pruned = propagateMissionBatch(configs, r_earth(), r_mars());
+    
+    // The lanes march in step: the others stop one step after 1000 mN coasts
+    bool others_stopped = true;
+    for (std::size_t i : {0, 1, 3}) {
+        others_stopped = others_stopped && pruned[i].pruned &&
+                         pruned[i].final_state.t == reference[2].final_state.t + 20000;
+    }
+    check(same_result(pruned[2], reference[2]), "The fastest lane is bit-identical");
+    check(others_stopped, "The other lanes stop the step after it coasts");
+    check(bound.stats().missions == 4 && bound.stats().pruned == 3,
+          "Every lane is counted by the bound");
+    
+    MissionConfig other = configs[0];
+    PruningBound second("shortest_time");
+    other.pruning = &second;
+    configs.push_back(other);
+    check(!canPropagateAsBatch(configs), "Lanes with different bounds do not share a batch");
+}
+
+// ===========================================================================
+// SWEEP TESTS
+// ===========================================================================
+
+/// 6 thrust x 3 ISP x 2 initial masses to Mars; low thrust at high mass
+/// runs out of fuel
+ParameterSweep make_sweep() {
+    ParameterSweep sweep;
+    sweep.base.spacecraft.initial_mass_kg = 10000;
+    sweep.base.timestep_s = 20000;
+    sweep.base.max_flight_time_s = 1.577e9;
+    sweep.thrust_mN = {300, 450, 600, 800, 1000, 1200};
+    sweep.isp_s = {1500, 2750, 4000};
+    sweep.initial_mass_kg = {5000, 20000};
+    return sweep;
+}
+
+/// Index of the coasted point with the least propellant (or size())
+std::size_t least_fuel_point(const std::vector<SweepPointResult>& results) {
+    std::size_t best = results.size();
+    for (std::size_t i = 0; i < results.size(); i++) {
+        double fuel = results[i].initial_mass_kg - results[i].final_mass_kg;
+        if (results[i].coasted &&
+            (best == results.size() ||
+             fuel < results[best].initial_mass_kg - results[best].final_mass_kg)) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+void test_sweep() {
+    std::cout << "\nTest 4: Sweep - Same Best Point on One and Two Threads\n";
+    std::cout << "--------------------------------------------\n";
+    
+    ParameterSweep sweep = make_sweep();
+    std::vector<SweepPointResult> reference = runParameterSweep(sweep, 1);
+    std::size_t best = least_fuel_point(reference);
+    
+    bool same_best = true;
+    long pruned_total = 0;
+    for (unsigned jobs : {1u, 2u}) {
+        PruningBound bound("least_fuel", true);
+        std::vector<SweepPointResult> results = runParameterSweep(sweep, jobs, &bound);
+        std::size_t found = least_fuel_point(results);
+        same_best = same_best && found == best &&
+                    results[found].final_mass_kg == reference[best].final_mass_kg &&
+                    results[found].flight_time_days == reference[best].flight_time_days;
+        
+        // Pruned points never count as coasted, and coasted ones are untouched
+        for (std::size_t i = 0; i < results.size(); i++) {
+            same_best = same_best && !(results[i].pruned && results[i].coasted) &&
+                        (results[i].pruned || results[i].final_mass_kg ==
+                                                  reference[i].final_mass_kg);
+        }
+        pruned_total += bound.stats().pruned;
+        if (jobs == 1) {
+            PruningStats stats = bound.stats();
+            std::cout << "  " << stats.pruned << " of " << stats.missions << " points pruned; "
+                      << stats.steps << " steps integrated, at most " << stats.steps_skipped
+                      << " skipped\n";
+        }
+    }
+    check(best < reference.size(), "Reference sweep has a coasted point");
+    check(same_best, "Best point and the unpruned points are unchanged");
+    check(pruned_total > 0, "Some points are pruned");
+    
+    PruningBound bound("least_fuel", true);
+    std::vector<SweepPointResult> results = runParameterSweep(sweep, 1, &bound);
+    std::string path = "test_pruning_sweep.csv";
+    writeSweepCSV(path, results, true);
+    std::ifstream file(path);
+    std::string header;
+    std::getline(file, header);
+    check(header.size() > 7 && header.compare(header.size() - 7, 7, ",Pruned") == 0,
+          "Pruned sweep tables end with a Pruned column");
+    file.close();
+    std::remove(path.c_str());
+}
+
+// ===========================================================================
+// COMPARISON TESTS
+// ===========================================================================
+
+void test_comparison() {
+    std::cout << "\nTest 5: Comparison - Pruned Rows Marked, Best Unchanged\n";
+    std::cout << "--------------------------------------------\n";
+    
+    MissionComparison comparison;
+    for (int k = 0; k < 3; k++) {
+        MissionResult mission;
+        mission.mission_name = "mission_" + std::to_string(k);
+        mission.thruster_name = "Hall";
+        mission.arrival_body = "Mars";
+        mission.initial_mass_kg = 10000;
+        mission.flight_time_days = 400 + 10 * k;
+        mission.final_mass_kg = 9000;
+        mission.propellant_consumed_kg = 1000;
+        mission.pruned = (k > 0);
+        comparison.addMission(mission);
+    }
+    comparison.computeMetrics();
+    comparison.setPruned(true);
+    check(comparison.findBestMission("shortest_time").mission_name == "mission_0",
+          "findBestMission picks the finished mission");
+    
+    std::string path = "test_pruning_comparison.csv";
+    comparison.writeComparisonCSV(path);
+    std::ifstream file(path);
+    std::string header;
+    std::string row;
+    std::getline(file, header);
+    std::getline(file, row);
+    check(header.compare(header.size() - 7, 7, ",Pruned") == 0 &&
+          row.compare(row.size() - 2, 2, ",0") == 0,
+          "Comparison CSV has a Pruned column");
+    file.close();
+    std::remove(path.c_str());
+}
+
+// ===========================================================================
+// MAIN
+// ===========================================================================
+
+int main() {
+    std::cout << "=====================================================\n";
+    std::cout << "TRADE-STUDY PRUNING TEST SUITE\n";
+    std::cout << "=====================================================\n";
+    
+    test_bound();
+    test_single_missions();
+    test_batch_lanes();
+    test_sweep();
+    test_comparison();
+    
+    // Summary
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "TEST RESULTS\n";
+    std::cout << "=====================================================\n";
+    std::cout << "  Tests passed: " << tests_passed << "\n";
+    std::cout << "  Tests failed: " << tests_failed << "\n";
+    std::cout << "  Total tests:  " << (tests_passed + tests_failed) << "\n";
+    
+    if (tests_failed == 0) {
+        std::cout << "\n  ✓ ALL TESTS PASSED\n";
+        std::cout << "=====================================================\n\n";
+        return 0;
+    } else {
+        std::cout << "\n  ✗ SOME TESTS FAILED\n";
+        std::cout << "=====================================================\n\n";
+        return 1;
+    }
+}
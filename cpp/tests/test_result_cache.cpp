@@ -0,0 +1,209 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <cstdio>
+#include <cmath>
+#include <filesystem>
+#include <vector>
+#include "../src/constants.h"
+#include "../src/propagator.h"
+#include "../src/mission_propagation.h"
+#include "../src/result_cache.h"
+#include "test_mission_config.h"
+
+// ===========================================================================
+// TEST FRAMEWORK HELPERS
+// ===========================================================================
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+void check(bool condition, const std::string& test_name) {
+    if (condition) {
+        std::cout << "  ✓ PASS: " << test_name << "\n";
+        tests_passed++;
+    } else {
+        std::cout << "  ✗ FAIL: " << test_name << "\n";
+        tests_failed++;
+    }
+}
+
+bool same_state(const MissionState& a, const MissionState& b) {
+    return a.r[0] == b.r[0] && a.r[1] == b.r[1] && a.r[2] == b.r[2] &&
+           a.v[0] == b.v[0] && a.v[1] == b.v[1] && a.v[2] == b.v[2] &&
+           a.m == b.m && a.t == b.t;
+}
+
+// ===========================================================================
+// CONFIG HASH TESTS
+// ===========================================================================
+
+void test_hash_covers_every_field() {
+    std::cout << "\nTest 1: Config Hash - Stable, and Changed by Every Field\n";
+    std::cout << "--------------------------------------------\n";
+    
+    MissionConfig config = make_test_config();
+    std::uint64_t key = hashMissionConfig(config);
+    check(key == hashMissionConfig(make_test_config()), "Equal configs hash equally");
+    check(key != hashMissionConfig(config, "other_trajectory.csv"), "Salt changes the key");
+    
+    // One modification per field; each must give a distinct key
+    std::vector<MissionConfig> variants(16, config);
+    variants[0].arrival_body = CelestialBody::JUPITER;
+    variants[1].spacecraft.name = "Low-Power Ion";
+    variants[2].spacecraft.thrust_mN = std::nextafter(1000.0, 2000.0);
+    variants[3].spacecraft.isp_s = 2751;
+    variants[4].spacecraft.initial_mass_kg = 9999;
+    variants[5].integrator = "dop853";
+    variants[6].timestep_s = 5000;
+    variants[7].rel_tol = 1e-10;
+    variants[8].max_flight_time_s = 1e9;
+    variants[9].coast_threshold = 1.0;
+    variants[10].coast_check = "bracketed";
+    variants[11].coast_mode = "to_arrival";
+    variants[12].locate_coast = true;
+    variants[13].events.push_back(EventSpec());
+    variants[14].output_format = "both";
+    variants[15].save_interval = 10;
+    
+    bool all_distinct = true;
+    std::vector<std::uint64_t> keys = {key};
+    for (const MissionConfig& variant : variants) {
+        std::uint64_t variant_key = hashMissionConfig(variant);
+        for (std::uint64_t other : keys) {
+            all_distinct = all_distinct && variant_key != other;
+        }
+        keys.push_back(variant_key);
+    }
+    check(all_distinct, "Each single-field change (down to one ulp) gives a new key");
+    
+    MissionConfig checkpointed = config;
+    checkpointed.checkpoint_interval = 1000;
+    checkpointed.checkpoint_file = "mission.ckpt";
+    checkpointed.resume = true;
+    check(hashMissionConfig(checkpointed) == key, "Checkpoint settings do not change the key");
+}
+
+// ===========================================================================
+// CACHE ENTRY TESTS
+// ===========================================================================
+
+void test_entry_round_trip() {
+    std::cout << "\nTest 2: Cache Entry - Bit-Exact Round Trip\n";
+    std::cout << "--------------------------------------------\n";
+    
+    const std::string directory = "test_result_cache_dir";
+    std::filesystem::remove_all(directory);
+    ResultCache cache(directory);
+    
+    MissionConfig config = make_test_config();
+    config.locate_coast = true;
+    double r_dep = getOrbitalRadius(CelestialBody::EARTH);
+    double r_arr = getOrbitalRadius(CelestialBody::MARS);
+    
+    CachedMission entry;
+    entry.propagation = propagateMission(config, r_dep, r_arr);
+    entry.result.thruster_name = config.spacecraft.name;
+    entry.result.departure_body = "Earth";
+    entry.result.arrival_body = "Mars";
+    entry.result.flight_time_days = entry.propagation.final_state.t / 86400.0;
+    entry.result.final_mass_kg = entry.propagation.final_state.m;
+    entry.result.final_eccentricity = 0.1 / 3.0;
+    entry.trajectory_path = "../results/test_trajectory.csv";
+    
+    std::uint64_t key = hashMissionConfig(config);
+    CachedMission missing;
+    check(!cache.lookup(key, missing), "Lookup before store misses");
+    check(cache.store(key, entry), "Entry stored");
+    
+    CachedMission loaded;
+    check(cache.lookup(key, loaded), "Lookup after store hits");
+    check(loaded.result.thruster_name == entry.result.thruster_name &&
+          loaded.result.flight_time_days == entry.result.flight_time_days &&
+          loaded.result.final_mass_kg == entry.result.final_mass_kg &&
+          loaded.result.final_eccentricity == entry.result.final_eccentricity,
+          "Mission result restored bit for bit");
+    check(same_state(loaded.propagation.final_state, entry.propagation.final_state) &&
+          loaded.propagation.coast_step == entry.propagation.coast_step &&
+          loaded.propagation.accepted_steps == entry.propagation.accepted_steps &&
+          loaded.propagation.total_delta_v == entry.propagation.total_delta_v,
+          "Propagation result restored bit for bit");
+    check(loaded.propagation.events.size() == entry.propagation.events.size() &&
+          !loaded.propagation.events.empty() &&
+          loaded.propagation.events[0].type == entry.propagation.events[0].type &&
+          same_state(loaded.propagation.events[0].state, entry.propagation.events[0].state),
+          "Located events restored");
+    check(loaded.trajectory_path == entry.trajectory_path, "Trajectory path restored");
+    
+    // No temporary files left behind
+    long files = 0;
+    for (const auto& file : std::filesystem::directory_iterator(directory)) {
+        (void)file;
+        files++;
+    }
+    check(files == 1, "Only the entry itself is on disk");
+    
+    std::filesystem::remove_all(directory);
+}
+
+void test_invalid_entries_miss() {
+    std::cout << "\nTest 3: Cache Entry - Truncated or Foreign Entries Miss\n";
+    std::cout << "--------------------------------------------\n";
+    
+    const std::string directory = "test_result_cache_dir";
+    std::filesystem::remove_all(directory);
+    ResultCache cache(directory);
+    
+    CachedMission entry;
+    std::uint64_t key = hashMissionConfig(make_test_config());
+    std::uint64_t other_key = key ^ 1;
+    cache.store(key, entry);
+    
+    // An entry copied under another key name does not match that key
+    std::filesystem::copy_file(cache.entryPath(key), cache.entryPath(other_key));
+    CachedMission loaded;
+    check(!cache.lookup(other_key, loaded), "Entry under the wrong key rejected");
+    
+    // Truncated entry (e.g. written by an older format) misses
+    std::ofstream truncated(cache.entryPath(key));
+    truncated << "format=ltmd-result-cache-1\n";
+    truncated.close();
+    check(!cache.lookup(key, loaded), "Truncated entry rejected");
+    
+    std::filesystem::remove_all(directory);
+}
+
+// ===========================================================================
+// MAIN TEST RUNNER
+// ===========================================================================
+
+int main() {
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "RESULT CACHE TEST SUITE\n";
+    std::cout << "=====================================================\n";
+    
+    test_hash_covers_every_field();
+    test_entry_round_trip();
+    test_invalid_entries_miss();
+    
+    // Summary
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "TEST RESULTS\n";
+    std::cout << "=====================================================\n";
+    std::cout << "  Tests passed: " << tests_passed << "\n";
+    std::cout << "  Tests failed: " << tests_failed << "\n";
+    std::cout << "  Total tests:  " << (tests_passed + tests_failed) << "\n";
+    
+    if (tests_failed == 0) {
+        std::cout << "\n  ✓ ALL TESTS PASSED\n";
+        std::cout << "=====================================================\n\n";
+        return 0;
+    } else {
+        std::cout << "\n  ✗ SOME TESTS FAILED\n";
+        std::cout << "=====================================================\n\n";
+        return 1;
+    }
+}
@@ -0,0 +1,542 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include "../src/constants.h"
+#include "../src/propagator.h"
+#include "../src/mission_propagation.h"
+#include "../src/trajectory_sink.h"
+#include "../src/trajectory_file.h"
+#include "../src/csv_writer.h"
+#include "test_mission_config.h"
+
+// ===========================================================================
+// TEST FRAMEWORK HELPERS
+// ===========================================================================
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+void check(bool condition, const std::string& test_name) {
+    if (condition) {
+        std::cout << "  ✓ PASS: " << test_name << "\n";
+        tests_passed++;
+    } else {
+        std::cout << "  ✗ FAIL: " << test_name << "\n";
+        tests_failed++;
+    }
+}
+
+/// Count data rows (excluding header) in a CSV file
+long count_csv_rows(const std::string& filename) {
+    std::ifstream file(filename);
+    std::string line;
+    long rows = -1;
+    while (std::getline(file, line)) {
+        rows++;
+    }
+    return rows;
+}
+
+// ===========================================================================
+// SINK TESTS
+// ===========================================================================
+
+void test_ring_buffer_keeps_latest() {
+    std::cout << "\nTest 1: Ring Buffer Sink - Keeps Latest Samples\n";
+    std::cout << "--------------------------------------------\n";
+    
+    RingBufferTrajectorySink ring(4);
+    OrbitalElements elements;
+    for (long step = 0; step < 10; step++) {
+        MissionState state(0, 0, 0, 0, 0, 0, 1000, step * 10.0);
+        ring.record(step, state, elements);
+    }
+    
+    std::vector<TrajectorySample> samples = ring.samples();
+    check(samples.size() == 4, "Ring buffer holds exactly its capacity");
+    check(ring.totalRecorded() == 10, "Ring buffer counts every recorded sample");
+    check(!samples.empty() && samples.front().step == 6 && samples.back().step == 9,
+          "Ring buffer returns the last samples oldest-first");
+}
+
+void test_decimation_matches_interval() {
+    std::cout << "\nTest 2: Decimating Sink - Honors save_interval\n";
+    std::cout << "--------------------------------------------\n";
+    
+    MissionConfig config = make_test_config();
+    double r_dep = getOrbitalRadius(CelestialBody::EARTH);
+    double r_arr = getOrbitalRadius(CelestialBody::MARS);
+    
+    RingBufferTrajectorySink every_step(100000);
+    PropagationResult full = propagateMission(config, r_dep, r_arr, every_step);
+    
+    RingBufferTrajectorySink decimated_ring(100000);
+    DecimatingTrajectorySink decimated(decimated_ring, 10);
+    PropagationResult thinned = propagateMission(config, r_dep, r_arr, decimated);
+    
+    long steps = full.accepted_steps;
+    long expected_rows = steps / 10 + 1 + (steps % 10 != 0 ? 1 : 0);
+    
+    std::cout << "    Steps: " << steps << ", decimated rows: "
+              << decimated_ring.size() << "\n";
+    
+    check(static_cast<long>(every_step.size()) == steps + 1,
+          "Undecimated sink sees every step plus the initial state");
+    check(static_cast<long>(decimated_ring.size()) == expected_rows,
+          "Decimated sink keeps every 10th step plus the final state");
+    check(!decimated_ring.samples().empty() &&
+          decimated_ring.samples().back().state.t == thinned.final_state.t,
+          "Decimated output ends on the final state");
+    check(full.final_state.t == thinned.final_state.t &&
+          full.final_state.m == thinned.final_state.m,
+          "Sink choice does not change the propagation");
+}
+
+void test_null_sink_same_result() {
+    std::cout << "\nTest 3: Null Sink - Same Result Without Output\n";
+    std::cout << "--------------------------------------------\n";
+    
+    MissionConfig config = make_test_config();
+    double r_dep = getOrbitalRadius(CelestialBody::EARTH);
+    double r_arr = getOrbitalRadius(CelestialBody::MARS);
+    
+    NullTrajectorySink null_sink;
+    PropagationResult with_null = propagateMission(config, r_dep, r_arr, null_sink);
+    PropagationResult with_default = propagateMission(config, r_dep, r_arr);
+    
+    check(with_null.final_state.t == with_default.final_state.t &&
+          with_null.total_delta_v == with_default.total_delta_v &&
+          with_null.coast_step == with_default.coast_step,
+          "Null sink and no-output overload agree");
+}
+
+void test_csv_sink_streams_rows() {
+    std::cout << "\nTest 4: CSV Sink - Streams Decimated Rows to Disk\n";
+    std::cout << "--------------------------------------------\n";
+    
+    MissionConfig config = make_test_config();
+    config.save_interval = 5;
+    config.output_format = "csv";
+    double r_dep = getOrbitalRadius(CelestialBody::EARTH);
+    double r_arr = getOrbitalRadius(CelestialBody::MARS);
+    
+    std::string filename = "test_trajectory_io_stream.csv";
+    PropagationResult result = propagateMission(config, r_dep, r_arr, true, filename);
+    
+    long steps = result.accepted_steps;
+    long expected_rows = steps / 5 + 1 + (steps % 5 != 0 ? 1 : 0);
+    long rows = count_csv_rows(filename);
+    std::cout << "    Steps: " << steps << ", CSV rows: " << rows << "\n";
+    
+    check(rows == expected_rows, "CSV holds every 5th step plus the final state");
+    std::remove(filename.c_str());
+}
+
+// ===========================================================================
+// BINARY FORMAT TESTS
+// ===========================================================================
+
+void test_binary_round_trip() {
+    std::cout << "\nTest 5: Binary Format - Spilled Blocks Round-Trip Through mmap\n";
+    std::cout << "--------------------------------------------\n";
+    
+    MissionConfig config = make_test_config();
+    double r_dep = getOrbitalRadius(CelestialBody::EARTH);
+    double r_arr = getOrbitalRadius(CelestialBody::MARS);
+    
+    // Small blocks force the spill/transpose path on a short mission
+    std::string filename = "test_trajectory_io_roundtrip.bin";
+    RingBufferTrajectorySink reference(100000);
+    long rows_written = 0;
+    {
+        BinaryTrajectorySink binary_sink(filename, config, 1, 7);
+        TeeTrajectorySink tee(binary_sink, reference);
+        propagateMission(config, r_dep, r_arr, tee);
+        rows_written = static_cast<long>(binary_sink.rowsWritten());
+    }
+    
+    MappedTrajectory mapped;
+    bool opened = mapped.open(filename);
+    check(opened, "Binary file maps and validates");
+    if (!opened) {
+        return;
+    }
+    
+    std::vector<TrajectorySample> expected = reference.samples();
+    std::cout << "    Rows: " << mapped.rows() << " (" << mapped.columns() << " columns)\n";
+    check(mapped.rows() == expected.size() &&
+          static_cast<long>(mapped.rows()) == rows_written,
+          "Row count matches recorded steps");
+    
+    const double* t = mapped.column(TrajectoryColumn::TIME);
+    const double* x = mapped.column(TrajectoryColumn::X);
+    const double* vy = mapped.column(TrajectoryColumn::VY);
+    const double* m = mapped.column(TrajectoryColumn::MASS);
+    const double* ra = mapped.column(TrajectoryColumn::APOAPSIS);
+    bool exact = t && x && vy && m && ra;
+    for (size_t i = 0; exact && i < expected.size(); ++i) {
+        exact = t[i] == expected[i].state.t &&
+                x[i] == expected[i].state.r[0] &&
+                vy[i] == expected[i].state.v[1] &&
+                m[i] == expected[i].state.m &&
+                ra[i] == expected[i].elements.r_a;
+    }
+    check(exact, "Columns are bit-exact copies of the propagated states");
+    
+    const TrajectoryFileHeader& header = mapped.header();
+    check(std::string(header.integrator) == "rk4" &&
+          std::string(header.spacecraft_name) == "High-Power Hall" &&
+          header.timestep_s == config.timestep_s &&
+          mapped.column(TrajectoryColumn::TRUE_ANOMALY) == nullptr,
+          "Header records the mission configuration and column layout");
+    
+    mapped.close();
+    std::FILE* spill = std::fopen((filename + ".part").c_str(), "rb");
+    check(spill == nullptr, "Spill file removed after finish");
+    if (spill) {
+        std::fclose(spill);
+    }
+    std::remove(filename.c_str());
+}
+
+void test_output_format_both() {
+    std::cout << "\nTest 6: Output Format - Binary Primary With CSV Export\n";
+    std::cout << "--------------------------------------------\n";
+    
+    MissionConfig config = make_test_config();
+    config.save_interval = 3;
+    config.output_format = "both";
+    double r_dep = getOrbitalRadius(CelestialBody::EARTH);
+    double r_arr = getOrbitalRadius(CelestialBody::MARS);
+    
+    std::string csv_name = "test_trajectory_io_both.csv";
+    std::string bin_name = binaryTrajectoryPath(csv_name);
+    propagateMission(config, r_dep, r_arr, true, csv_name);
+    
+    MappedTrajectory mapped;
+    bool opened = mapped.open(bin_name);
+    long csv_rows = count_csv_rows(csv_name);
+    std::cout << "    Binary rows: " << (opened ? static_cast<long>(mapped.rows()) : -1)
+              << ", CSV rows: " << csv_rows << "\n";
+    
+    check(bin_name == "test_trajectory_io_both.bin", "Binary path replaces the .csv extension");
+    check(opened && static_cast<long>(mapped.rows()) == csv_rows,
+          "Binary and CSV hold the same decimated rows");
+    check(opened && mapped.header().thrust_direction == 1, "Outbound header says prograde");
+    
+    mapped.close();
+    check(!mapped.open(csv_name), "CSV file rejected by the binary reader");
+    
+    // Earth to Venus thrusts retrograde; the header must say so
+    std::string inbound_name = "test_trajectory_io_inbound.csv";
+    std::string inbound_bin = binaryTrajectoryPath(inbound_name);
+    config.output_format = "binary";
+    config.arrival_body = CelestialBody::VENUS;
+    propagateMission(config, r_dep, getOrbitalRadius(CelestialBody::VENUS), true, inbound_name);
+    MappedTrajectory inbound;
+    check(inbound.open(inbound_bin) && inbound.header().thrust_direction == -1 &&
+          inbound.header().arrival_body == static_cast<std::int32_t>(CelestialBody::VENUS),
+          "Inbound header says retrograde");
+    inbound.close();
+    
+    std::remove(csv_name.c_str());
+    std::remove(bin_name.c_str());
+    std::remove(inbound_bin.c_str());
+}
+
+// ===========================================================================
+// COAST CHECK TESTS
+// ===========================================================================
+
+void test_bracketed_coast_check() {
+    std::cout << "\nTest 7: Bracketed Coast Check - Same Coast Step as Every-Step Check\n";
+    std::cout << "--------------------------------------------\n";
+    
+    double r_earth = getOrbitalRadius(CelestialBody::EARTH);
+    
+    // Outbound and inbound transfers, high and low thrust
+    struct Case { double thrust_mN; double isp_s; CelestialBody arrival; };
+    std::vector<Case> cases = {
+        {1000, 2750, CelestialBody::MARS},
+        {60, 1500, CelestialBody::MARS},
+        {450, 9000, CelestialBody::JUPITER},
+        {250, 4000, CelestialBody::VENUS}
+    };
+    
+    bool all_match = true;
+    for (const Case& c : cases) {
+        MissionConfig config = make_test_config();
+        config.spacecraft.thrust_mN = c.thrust_mN;
+        config.spacecraft.isp_s = c.isp_s;
+        double r_arr = getOrbitalRadius(c.arrival);
+        
+        PropagationResult every_step = propagateMission(config, r_earth, r_arr);
+        config.coast_check = "bracketed";
+        PropagationResult bracketed = propagateMission(config, r_earth, r_arr);
+        
+        std::cout << "    " << c.thrust_mN << " mN to " << getBodyName(c.arrival)
+                  << ": coast step " << every_step.coast_step
+                  << " (bracketed: " << bracketed.coast_step << ")\n";
+        all_match = all_match &&
+                    every_step.coast_step == bracketed.coast_step &&
+                    every_step.final_state.t == bracketed.final_state.t &&
+                    every_step.final_state.m == bracketed.final_state.m &&
+                    every_step.total_delta_v == bracketed.total_delta_v;
+    }
+    
+    check(all_match, "Skipped checks never delay the coast step");
+}
+
+// ===========================================================================
+// COAST ARC TESTS
+// ===========================================================================
+
+void test_coast_arc_to_arrival() {
+    std::cout << "\nTest 8: Coast Arc - Closed-Form Arc to the Arrival Radius\n";
+    std::cout << "--------------------------------------------\n";
+    
+    double r_dep = getOrbitalRadius(CelestialBody::EARTH);
+    double r_arr = getOrbitalRadius(CelestialBody::MARS);
+    
+    // Coast only once the apoapsis reaches Mars, so the arc can get there
+    MissionConfig config = make_test_config();
+    config.coast_threshold = 1.0;
+    PropagationResult stopped = propagateMission(config, r_dep, r_arr);
+    config.coast_mode = "to_arrival";
+    PropagationResult arrived = propagateMission(config, r_dep, r_arr);
+    
+    std::cout << "    Coast at " << std::fixed << std::setprecision(1)
+              << arrived.coast_state.t / 86400.0 << " days, arrival after a "
+              << arrived.coast_arc_s / 86400.0 << " day arc, r = "
+              << std::setprecision(0) << arrived.final_state.radius() << " km\n";
+    
+    check(arrived.coast_state.t == stopped.final_state.t &&
+          arrived.coast_state.r[0] == stopped.final_state.r[0] &&
+          arrived.coast_step == stopped.coast_step &&
+          arrived.total_delta_v == stopped.total_delta_v,
+          "Thrust arc unchanged by the coast mode");
+    check(arrived.arrival_reached &&
+          std::abs(arrived.final_state.radius() - r_arr) < 1e-6 * r_arr,
+          "Arc ends on the arrival radius");
+    check(arrived.final_state.m == arrived.coast_state.m,
+          "Mass constant over the coast arc");
+    
+    // Same arc integrated with unpowered RK4 steps
+    RK4Propagator rk4;
+    MissionState numeric = arrived.coast_state;
+    double t_end = arrived.final_state.t;
+    double dt = 1000;
+    long steps = 0;
+    while (numeric.t < t_end) {
+        rk4.step(numeric, std::min(dt, t_end - numeric.t), 0, config.spacecraft.isp_s,
+                 MU_SUN, G0, 1);
+        steps++;
+    }
+    double position_error = 0;
+    for (int i = 0; i < 3; i++) {
+        position_error = std::max(position_error,
+                                  std::abs(numeric.r[i] - arrived.final_state.r[i]));
+    }
+    std::cout << "    RK4 coast (" << steps << " steps) differs by "
+              << std::setprecision(3) << position_error << " km\n";
+    check(position_error < 10.0, "Closed-form arc agrees with an RK4 coast");
+    
+    // With the default threshold the orbit falls just short of Mars
+    config.coast_threshold = 0.999;
+    PropagationResult short_of = propagateMission(config, r_dep, r_arr);
+    Apsides apsides = computeApsides(short_of.coast_state.r, short_of.coast_state.v, MU_SUN);
+    check(!short_of.arrival_reached &&
+          std::abs(short_of.final_state.radius() - apsides.r_a) < 1e-6 * apsides.r_a,
+          "Orbit short of the arrival radius coasts to apoapsis");
+}
+
+void test_coast_arc_to_epoch() {
+    std::cout << "\nTest 9: Coast Arc - Arc to a Requested Epoch, One Sink Step\n";
+    std::cout << "--------------------------------------------\n";
+    
+    double r_dep = getOrbitalRadius(CelestialBody::EARTH);
+    double r_arr = getOrbitalRadius(CelestialBody::MARS);
+    
+    MissionConfig config = make_test_config();
+    config.coast_mode = "to_epoch";
+    config.coast_epoch_s = 5.0e8;
+    
+    RingBufferTrajectorySink ring(2);
+    DecimatingTrajectorySink decimated(ring, 1000);
+    PropagationResult result = propagateMission(config, r_dep, r_arr, decimated);
+    std::vector<TrajectorySample> samples = ring.samples();
+    
+    check(result.final_state.t == config.coast_epoch_s, "Arc ends at the requested epoch");
+    check(!samples.empty() && samples.back().state.t == config.coast_epoch_s &&
+          samples.back().step == result.accepted_steps + 1,
+          "Arc end recorded as one step past the thrust arc");
+    
+    // Epochs past the flight-time limit stop at the limit
+    config.coast_epoch_s = 2.0 * config.max_flight_time_s;
+    PropagationResult limited = propagateMission(config, r_dep, r_arr);
+    check(limited.final_state.t == config.max_flight_time_s,
+          "Arc stops at max_flight_time_s");
+}
+
+// ===========================================================================
+// CSV WRITER TESTS
+// ===========================================================================
+
+/// Read a whole file into a string
+std::string read_file(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+/// Values covering rounding ties, subnormals, extremes and special values
+std::vector<double> csv_test_values() {
+    std::vector<double> values = {
+        0.0, -0.0, 0.5, 1.5, 2.5, 0.125, 0.375, 9.9999995, 99.95, 1e-300, 5e-324,
+        1.7976931348623157e308, 1.496e8, -5.930006e-02, 29.78448, 10000.0, 9999.995,
+        1e21, 123456789012345678.0, INFINITY, -INFINITY, NAN
+    };
+    std::mt19937_64 rng(42);
+    for (int i = 0; i < 2000; i++) {
+        std::uint64_t bits = rng();
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        if (std::isfinite(value) && std::fabs(value) < 1e30) {
+            values.push_back(value);
+        }
+        values.push_back(std::ldexp(static_cast<double>(rng() >> 11), static_cast<int>(rng() % 80) - 60));
+    }
+    return values;
+}
+
+void write_csv_test_rows(CsvWriter& writer, const std::vector<double>& values) {
+    for (double value : values) {
+        writer.fixed(value, 2);
+        writer.fixed(value, 6);
+        writer.scientific(value, 3);
+        writer.scientific(value, 6);
+        writer.general(value, 10);
+        writer.integer(static_cast<long long>(values.size()));
+        writer.text("Mars");
+        writer.endRow();
+    }
+}
+
+void test_csv_writer_matches_iostream() {
+    std::cout << "\nTest 10: CSV Writer - Same Characters as iostream Manipulators\n";
+    std::cout << "--------------------------------------------\n";
+    
+    std::vector<double> values = csv_test_values();
+    std::ostringstream expected;
+    for (double value : values) {
+        expected << std::fixed << std::setprecision(2) << value << ","
+                 << std::setprecision(6) << value << ","
+                 << std::scientific << std::setprecision(3) << value << ","
+                 << std::setprecision(6) << value << ","
+                 << std::defaultfloat << std::setprecision(10) << value << ","
+                 << values.size() << ","
+                 << "Mars" << "\n";
+    }
+    
+    // A small buffer spills many times mid-row
+    std::string filename = "test_trajectory_io_writer.csv";
+    CsvWriter writer(1000);
+    check(writer.open(filename), "Writer opens file");
+    write_csv_test_rows(writer, values);
+    std::int64_t position = writer.position();
+    check(writer.close(), "Writer closes cleanly");
+    
+    std::string written = read_file(filename);
+    std::cout << "    Values: " << values.size() << ", bytes: " << written.size() << "\n";
+    check(written == expected.str(), "Byte-identical to fixed/scientific/defaultfloat streams");
+    check(position == static_cast<std::int64_t>(written.size()), "position() counts buffered bytes");
+    std::remove(filename.c_str());
+}
+
+void test_csv_writer_background_and_append() {
+    std::cout << "\nTest 11: CSV Writer - Background Flush and Append\n";
+    std::cout << "--------------------------------------------\n";
+    
+    std::vector<double> values = csv_test_values();
+    std::string direct_name = "test_trajectory_io_direct.csv";
+    std::string background_name = "test_trajectory_io_background.csv";
+    {
+        CsvWriter direct(1000);
+        direct.open(direct_name);
+        write_csv_test_rows(direct, values);
+    }
+    
+    CsvWriter background(1000, true);
+    background.open(background_name);
+    write_csv_test_rows(background, values);
+    check(background.flush(), "Background flush succeeds");
+    std::int64_t flushed_size = static_cast<std::int64_t>(read_file(background_name).size());
+    check(flushed_size == background.position(), "flush() leaves every row in the file");
+    background.close();
+    check(read_file(background_name) == read_file(direct_name),
+          "Background flushing writes the same file");
+    
+    // Appending continues at the end, as a resumed trajectory does
+    std::string before = read_file(direct_name);
+    CsvWriter append;
+    check(append.open(direct_name, CsvOpenMode::APPEND) &&
+          append.position() == static_cast<std::int64_t>(before.size()),
+          "Append starts at the end of the file");
+    append.fixed(1.25, 1);
+    append.endRow();
+    append.close();
+    check(read_file(direct_name) == before + "1.2\n", "Append keeps existing rows");
+    
+    std::remove(direct_name.c_str());
+    std::remove(background_name.c_str());
+}
+
+// ===========================================================================
+// MAIN TEST RUNNER
+// ===========================================================================
+
+int main() {
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "TRAJECTORY OUTPUT TEST SUITE\n";
+    std::cout << "=====================================================\n";
+    
+    test_ring_buffer_keeps_latest();
+    test_decimation_matches_interval();
+    test_null_sink_same_result();
+    test_csv_sink_streams_rows();
+    test_binary_round_trip();
+    test_output_format_both();
+    test_bracketed_coast_check();
+    test_coast_arc_to_arrival();
+    test_coast_arc_to_epoch();
+    test_csv_writer_matches_iostream();
+    test_csv_writer_background_and_append();
+    
+    // Summary
+    std::cout << "\n";
+    std::cout << "=====================================================\n";
+    std::cout << "TEST RESULTS\n";
+    std::cout << "=====================================================\n";
+    std::cout << "  Tests passed: " << tests_passed << "\n";
+    std::cout << "  Tests failed: " << tests_failed << "\n";
+    std::cout << "  Total tests:  " << (tests_passed + tests_failed) << "\n";
+    
+    if (tests_failed == 0) {
+        std::cout << "\n  ✓ ALL TESTS PASSED\n";
+        std::cout << "=====================================================\n\n";
+        return 0;
+    } else {
+        std::cout << "\n  ✗ SOME TESTS FAILED\n";
+        std::cout << "=====================================================\n\n";
+        return 1;
+    }
+}
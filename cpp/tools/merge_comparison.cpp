@@ -0,0 +1,62 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../src/batch_shards.h"
+#include "../src/comparison.h"
+
+// ===========================================================================
+// MERGE SHARDED COMPARISONS
+// ===========================================================================
+// Rebuilds mission_comparison.csv from the partial files of a sharded
+// batch (propagate_trajectory --batch <file> --shard i/N). Only the shard
+// files are read, never a trajectory, so the shards can come back from
+// different nodes with just a few kilobytes each. The result and the
+// printed summary are the same as a single-process run of the batch.
+// ===========================================================================
+
+namespace {
+
+void printUsage() {
+    std::cout << "Usage: merge_comparison [--output <file>] <shard.csv>...\n"
+              << "  Combines mission_comparison.shard-<i>-of-<N>.csv files into one\n"
+              << "  comparison (default ../results/mission_comparison.csv). Fails if\n"
+              << "  a mission is missing or the files come from different batches.\n";
+}
+
+}  // namespace
+
+// ===========================================================================
+// MAIN
+// ===========================================================================
+
+int main(int argc, char* argv[]) {
+    std::string output = "../results/mission_comparison.csv";
+    std::vector<std::string> inputs;
+    
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--output" && has_value) {
+            output = argv[++i];
+        } else if (arg.empty() || arg[0] == '-') {
+            printUsage();
+            return (arg == "--help" || arg == "-h") ? 0 : 1;
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+    if (inputs.empty()) {
+        printUsage();
+        return 1;
+    }
+    
+    MissionComparison comparison;
+    if (!mergeShards(inputs, comparison)) {
+        return 1;
+    }
+    std::cout << "Merged " << comparison.getMissions().size() << " missions from "
+              << inputs.size() << " shard file(s)\n\n";
+    comparison.printSummary();
+    comparison.writeComparisonCSV(output);
+    return 0;
+}
@@ -0,0 +1,150 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include "../src/trajectory_file.h"
+#include "../src/batch_elements.h"
+#include "../src/thread_pool.h"
+
+// ===========================================================================
+// RECOMPUTE ORBITAL ELEMENTS
+// ===========================================================================
+// Re-derives every orbital-element column of binary trajectory files from
+// their state columns with computeOrbitalElementsBatch. Files written
+// before a column existed (e.g. i, Omega, omega, nu) gain it; the state
+// columns and any other columns are copied unchanged.
+// ===========================================================================
+
+namespace {
+
+/// Element columns written to every output file, in file order
+struct ElementColumn {
+    TrajectoryColumn id;
+    const std::vector<double> ElementArrays::*values;
+};
+
+const ElementColumn ELEMENT_COLUMNS[] = {
+    {TrajectoryColumn::SEMI_MAJOR_AXIS, &ElementArrays::a},
+    {TrajectoryColumn::ECCENTRICITY,    &ElementArrays::e},
+    {TrajectoryColumn::APOAPSIS,        &ElementArrays::r_a},
+    {TrajectoryColumn::PERIAPSIS,       &ElementArrays::r_p},
+    {TrajectoryColumn::INCLINATION,     &ElementArrays::i},
+    {TrajectoryColumn::RAAN,            &ElementArrays::Omega},
+    {TrajectoryColumn::ARG_PERIAPSIS,   &ElementArrays::omega},
+    {TrajectoryColumn::TRUE_ANOMALY,    &ElementArrays::nu},
+};
+
+bool isElementColumn(TrajectoryColumn id) {
+    for (const ElementColumn& column : ELEMENT_COLUMNS) {
+        if (column.id == id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// Recompute the elements of input and write the result to output
+bool recomputeFile(const std::string& input, const std::string& output, unsigned jobs) {
+    MappedTrajectory trajectory;
+    if (!trajectory.open(input)) {
+        return false;
+    }
+    
+    StateColumns states;
+    states.count = static_cast<std::size_t>(trajectory.rows());
+    states.x = trajectory.column(TrajectoryColumn::X);
+    states.y = trajectory.column(TrajectoryColumn::Y);
+    states.z = trajectory.column(TrajectoryColumn::Z);
+    states.vx = trajectory.column(TrajectoryColumn::VX);
+    states.vy = trajectory.column(TrajectoryColumn::VY);
+    states.vz = trajectory.column(TrajectoryColumn::VZ);
+    if (states.count > 0 && (!states.x || !states.y || !states.z ||
+                             !states.vx || !states.vy || !states.vz)) {
+        std::cerr << "Error: Trajectory file has no position/velocity columns: " << input << "\n";
+        return false;
+    }
+    double mu = trajectory.header().mu;
+    if (!(mu > 0)) {
+        std::cerr << "Error: Trajectory file has no gravitational parameter: " << input << "\n";
+        return false;
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    ElementArrays elements;
+    computeOrbitalElementsBatch(states, mu, elements, jobs);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    // Other columns keep their order; the element columns follow
+    std::vector<TrajectoryColumn> ids;
+    std::vector<const double*> columns;
+    for (std::uint32_t c = 0; c < trajectory.columns(); c++) {
+        if (!isElementColumn(trajectory.columnId(c))) {
+            ids.push_back(trajectory.columnId(c));
+            columns.push_back(trajectory.columnAt(c));
+        }
+    }
+    for (const ElementColumn& column : ELEMENT_COLUMNS) {
+        ids.push_back(column.id);
+        columns.push_back((elements.*column.values).data());
+    }
+    
+    if (!writeTrajectoryFile(output, trajectory.header(), ids, columns, trajectory.rows())) {
+        return false;
+    }
+    
+    std::cout << "  " << input << ": " << states.count << " rows in " << std::fixed
+              << std::setprecision(3) << seconds * 1e3 << " ms";
+    if (seconds > 0) {
+        std::cout << " (" << std::setprecision(1) << states.count / seconds / 1e6 << " M rows/s)";
+    }
+    std::cout << " -> " << output << "\n";
+    return true;
+}
+
+void printUsage() {
+    std::cout << "Usage: recompute_elements [--jobs <n>] [--output <file>] <trajectory.bin>...\n"
+              << "  Rewrites each file in place with a, e, ra, rp, i, Omega, omega and nu\n"
+              << "  recomputed from its state columns. --output (one input only) writes\n"
+              << "  the result to another file instead.\n";
+}
+
+}  // namespace
+
+// ===========================================================================
+// MAIN
+// ===========================================================================
+
+int main(int argc, char* argv[]) {
+    unsigned jobs = 0;
+    std::string output;
+    std::vector<std::string> inputs;
+    
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--jobs" && has_value) {
+            jobs = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (arg == "--output" && has_value) {
+            output = argv[++i];
+        } else if (arg.empty() || arg[0] == '-') {
+            printUsage();
+            return (arg == "--help" || arg == "-h") ? 0 : 1;
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+    if (inputs.empty() || (!output.empty() && inputs.size() > 1)) {
+        printUsage();
+        return 1;
+    }
+    
+    std::cout << "Recomputing orbital elements on " << ThreadPool::resolveThreadCount(jobs)
+              << " thread(s)\n";
+    bool ok = true;
+    for (const std::string& input : inputs) {
+        ok = recomputeFile(input, output.empty() ? input : output, jobs) && ok;
+    }
+    return ok ? 0 : 1;
+}
@@ -1,7 +1,7 @@
 #!/usr/bin/env python3
 """
 Mission Analysis Script
-Reads trajectory and comparison CSV files and generates analysis plots
+Reads trajectory (.bin or .csv) and comparison CSV files and generates analysis plots
 """
 
 import pandas as pd
@@ -11,6 +11,7 @@ import matplotlib.pyplot as plt
 import numpy as np
 import os
 from pathlib import Path
+from trajectory_io import find_trajectory, load_trajectory
 
 # Set up matplotlib style
 plt.style.use('seaborn-v0_8-darkgrid')
@@ -50,19 +51,18 @@ class MissionAnalyzer:
             return False
     
     def load_trajectory(self, config_name):
-        """Load a single trajectory CSV"""
+        """Load a single trajectory (binary file preferred, CSV export as fallback)"""
         # Extract base name without extension
         base_name = config_name.replace('.yaml', '')
-        filename = f"{base_name}_trajectory.csv"
-        filepath = self.results_dir / filename
+        filepath = find_trajectory(self.results_dir, f"{base_name}_trajectory")
         
-        if filepath.exists():
-            df = pd.read_csv(filepath)
+        if filepath is not None:
+            df = load_trajectory(filepath)
             self.trajectories[config_name] = df
-            print(f"✓ Loaded trajectory: {filename}")
+            print(f"✓ Loaded trajectory: {filepath.name}")
             return True
         else:
-            print(f"✗ Trajectory file not found: {filepath}")
+            print(f"✗ Trajectory file not found: {self.results_dir / base_name}_trajectory.bin")
             return False
     
     def plot_flight_time_comparison(self):
@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+"""
+Benchmark Regression Check
+Compares two bench_propagation JSON reports and flags slowdowns
+
+Usage:
+    python3 scripts/compare_benchmarks.py baseline.json current.json [--threshold 10]
+
+Micro-benchmarks are compared on ns_per_op, mission and batch backend
+benchmarks on ns_per_step (and allocations_per_mission, which must not
+grow). Exits with
+status 1 when any benchmark regressed by more than the threshold (percent),
+so the check can gate a release.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load_report(path):
+    """Load a report as {(section, name): entry}"""
+    with open(path) as f:
+        report = json.load(f)
+    entries = {}
+    for section in ("micro", "macro", "backends"):
+        for entry in report.get(section, []):
+            entries[(section, entry["name"])] = entry
+    return entries
+
+
+def compare(baseline, current, threshold):
+    """Print a comparison table; returns the number of regressions"""
+    regressions = 0
+    print(f"{'Benchmark':<36}{'baseline':>12}{'current':>12}{'change':>10}")
+    for key in sorted(current):
+        section, name = key
+        if key not in baseline:
+            print(f"{name:<36}{'-':>12}{'(new)':>12}")
+            continue
+
+        metric = "ns_per_op" if section == "micro" else "ns_per_step"
+        old, new = baseline[key][metric], current[key][metric]
+        change = 100.0 * (new - old) / old if old > 0 else 0.0
+
+        flag = ""
+        if change > threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        if section == "macro":
+            old_allocs = baseline[key]["allocations_per_mission"]
+            new_allocs = current[key]["allocations_per_mission"]
+            if new_allocs > old_allocs:
+                flag += f"  allocations {old_allocs:.0f} -> {new_allocs:.0f}"
+                regressions += 1
+
+        print(f"{name:<36}{old:>12.2f}{new:>12.2f}{change:>9.1f}%{flag}")
+
+    for key in sorted(set(baseline) - set(current)):
+        print(f"{key[1]:<36}{'(removed)':>12}")
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare bench_propagation reports")
+    parser.add_argument("baseline", help="JSON report of the reference build")
+    parser.add_argument("current", help="JSON report of the build under test")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="allowed slowdown in percent (default 10)")
+    args = parser.parse_args()
+
+    regressions = compare(load_report(args.baseline), load_report(args.current),
+                          args.threshold)
+    if regressions:
+        print(f"\n{regressions} regression(s) above {args.threshold:.0f}%")
+        return 1
+    print("\nNo regressions")
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
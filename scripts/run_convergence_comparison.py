@@ -4,7 +4,7 @@ Convergence Study: RK4 vs Euler Comparison
 Demonstrates convergence behavior differences between integration methods
 
 Usage:
-    python3 scripts/run_convergence_comparison.py
+    python3 scripts/run_convergence_comparison.py [--precision double_double]
     
 This script:
 1. Runs convergence study for BOTH RK4 and Euler methods
@@ -12,10 +12,16 @@ This script:
 3. Computes relative errors vs the finest timestep for each method
 4. Generates comparative diagnostic plots showing convergence order
 5. Saves results to convergence_study/ directory with separate subdirs for each method
+
+--precision sets integration.precision for the RK4 runs. With double_double
+the runs carry no double round-off, so the errors left are truncation error
+alone; comparing against a double run shows where round-off takes over.
 """
 
+import argparse
 import subprocess
 import pandas as pd
+from trajectory_io import load_trajectory, trajectory_files
 import numpy as np
 import matplotlib.pyplot as plt
 from pathlib import Path
@@ -25,6 +31,12 @@ import shutil
 import os
 import time
 
+parser = argparse.ArgumentParser(description="RK4 vs Euler convergence study")
+parser.add_argument("--precision", default="double",
+                    choices=["double", "float", "double_kahan", "double_double"],
+                    help="RK4 state arithmetic (integration.precision)")
+args = parser.parse_args()
+
 # Configuration
 TIMESTEPS = [10000, 5000, 2000, 1000]  # seconds
 EXECUTABLE = "./build/bin/propagate_trajectory"
@@ -55,6 +67,8 @@ PLOTS_DIR.mkdir(parents=True, exist_ok=True)
 print("="*70)
 print("CONVERGENCE STUDY: RK4 vs Euler Method Comparison")
 print("="*70)
+if args.precision != "double":
+    print(f"RK4 precision: {args.precision}")
 
 # Store results for both methods
 convergence_data_by_method = {}
@@ -92,6 +106,8 @@ for method_key, method_info in METHODS.items():
         
         # Override timestep using correct YAML key: timestep_s
         config['integration']['timestep_s'] = dt
+        if method_key == 'rk4':
+            config['integration']['precision'] = args.precision
         
         # Write modified config to temp file
         temp_config = dt_dir / "config_modified.yaml"
@@ -120,10 +136,10 @@ for method_key, method_info in METHODS.items():
             print(f"✓ Propagator completed successfully")
             
             # Find trajectory CSV files
-            csv_files = list(Path("results").glob("*trajectory.csv"))
+            csv_files = trajectory_files("results")
             
             if not csv_files:
-                print(f"❌ ERROR: No CSV output found in results/")
+                print(f"❌ ERROR: No trajectory output found in results/")
                 continue
             
             # Copy all CSVs to timestep directory
@@ -135,9 +151,9 @@ for method_key, method_info in METHODS.items():
                 # Parse first trajectory file
                 if csv_file == csv_files[0]:
                     try:
-                        df = pd.read_csv(output_csv)
+                        df = load_trajectory(output_csv)
                     except Exception as e:
-                        print(f"❌ ERROR: Could not parse CSV: {e}")
+                        print(f"❌ ERROR: Could not load trajectory: {e}")
                         continue
                     
                     final_row = df.iloc[-1]
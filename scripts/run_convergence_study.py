@@ -16,6 +16,7 @@ This script:
 
 import subprocess
 import pandas as pd
+from trajectory_io import load_trajectory, trajectory_files
 import numpy as np
 import matplotlib.pyplot as plt
 from pathlib import Path
@@ -98,15 +99,15 @@ for dt in TIMESTEPS:
         
         # Find trajectory CSV files generated by the propagator
         # The propagator writes based on the config (destination + thruster_type)
-        # Look for all *trajectory.csv files in results/
-        csv_files = list(Path("results").glob("*trajectory.csv"))
+        # Look for all *trajectory.bin (or CSV export) files in results/
+        csv_files = trajectory_files("results")
         
         if not csv_files:
-            print(f"❌ ERROR: No CSV output found in results/")
-            print(f"   Expected pattern: *trajectory.csv")
+            print(f"❌ ERROR: No trajectory output found in results/")
+            print(f"   Expected pattern: *trajectory.bin or *trajectory.csv")
             continue
         
-        # Copy ALL trajectory CSVs to this timestep's directory
+        # Copy ALL trajectory files to this timestep's directory
         # (in case there are multiple - we want all of them)
         for csv_file in csv_files:
             output_csv = dt_dir / csv_file.name
@@ -117,9 +118,9 @@ for dt in TIMESTEPS:
             # (If multiple, we'll use the first one)
             if csv_file == csv_files[0]:
                 try:
-                    df = pd.read_csv(output_csv)
+                    df = load_trajectory(output_csv)
                 except Exception as e:
-                    print(f"❌ ERROR: Could not parse CSV: {e}")
+                    print(f"❌ ERROR: Could not load trajectory: {e}")
                     continue
                 
                 final_row = df.iloc[-1]
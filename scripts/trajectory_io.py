@@ -0,0 +1,125 @@
+#!/usr/bin/env python3
+"""
+Trajectory File I/O
+Loads propagator trajectories from the binary columnar format (.bin) or
+the CSV export (.csv) into pandas DataFrames with the CSV column names.
+
+Binary layout (see cpp/src/trajectory_file.h):
+    [512-byte header][column 0: num_rows doubles][column 1] ...
+
+Columns are mapped with numpy.memmap, so loading a long trajectory does
+not parse or copy the file.
+"""
+
+import struct
+from pathlib import Path
+
+import numpy as np
+import pandas as pd
+
+TRAJECTORY_FILE_MAGIC = b"LTMDTRJ1"
+TRAJECTORY_FILE_VERSION = 1
+
+# Header fields in file order (little-endian, no padding)
+_HEADER_FORMAT = "<8sIIQI iiiiI 7d 16s 64s 32s"
+_HEADER_FIELDS = [
+    "magic", "version", "header_bytes", "num_rows", "num_columns",
+    "departure_body", "arrival_body", "thrust_direction", "save_interval", "reserved0",
+    "thrust_mN", "isp_s", "initial_mass_kg", "timestep_s", "max_flight_time_s",
+    "coast_threshold", "mu",
+    "integrator", "spacecraft_name", "columns",
+]
+
+# TrajectoryColumn ids -> CSV column names
+COLUMN_NAMES = {
+    0: "time(s)",
+    1: "x(km)",
+    2: "y(km)",
+    3: "z(km)",
+    4: "vx(km/s)",
+    5: "vy(km/s)",
+    6: "vz(km/s)",
+    7: "m(kg)",
+    8: "a(km)",
+    9: "e",
+    10: "ra(km)",
+    11: "rp(km)",
+    12: "i(rad)",
+    13: "Omega(rad)",
+    14: "omega(rad)",
+    15: "nu(rad)",
+}
+
+# Column order of the CSV export
+CSV_COLUMNS = ["time(s)", "x(km)", "y(km)", "vx(km/s)", "vy(km/s)", "r(km)", "v(km/s)",
+               "m(kg)", "ra(km)", "rp(km)", "e", "a(km)"]
+
+
+def read_header(filepath):
+    """Read and validate a binary trajectory header; returns a dict"""
+    with open(filepath, "rb") as f:
+        raw = f.read(struct.calcsize(_HEADER_FORMAT))
+    if len(raw) < struct.calcsize(_HEADER_FORMAT):
+        raise ValueError(f"Trajectory file too small: {filepath}")
+
+    header = dict(zip(_HEADER_FIELDS, struct.unpack(_HEADER_FORMAT, raw)))
+    if header["magic"] != TRAJECTORY_FILE_MAGIC or header["version"] != TRAJECTORY_FILE_VERSION:
+        raise ValueError(f"Not a valid trajectory file: {filepath}")
+
+    header["integrator"] = header["integrator"].split(b"\0", 1)[0].decode()
+    header["spacecraft_name"] = header["spacecraft_name"].split(b"\0", 1)[0].decode()
+    header["columns"] = list(header["columns"][:header["num_columns"]])
+    return header
+
+
+def map_columns(filepath):
+    """Memory-map a binary trajectory; returns (header, {column name: array})"""
+    header = read_header(filepath)
+    rows, cols = header["num_rows"], header["num_columns"]
+
+    if rows == 0:
+        data = np.empty((cols, 0), dtype="<f8")
+    else:
+        data = np.memmap(filepath, dtype="<f8", mode="r",
+                         offset=header["header_bytes"], shape=(cols, rows))
+
+    columns = {COLUMN_NAMES.get(cid, f"column{cid}"): data[i]
+               for i, cid in enumerate(header["columns"])}
+    return header, columns
+
+
+def load_binary_trajectory(filepath):
+    """Load a .bin trajectory as a DataFrame with the CSV columns"""
+    _, columns = map_columns(filepath)
+
+    # Derived columns the CSV export carries
+    columns["r(km)"] = np.hypot(columns["x(km)"], columns["y(km)"])
+    columns["v(km/s)"] = np.hypot(columns["vx(km/s)"], columns["vy(km/s)"])
+
+    return pd.DataFrame({name: columns[name] for name in CSV_COLUMNS})
+
+
+def load_trajectory(filepath):
+    """Load a trajectory file (.bin or .csv) as a DataFrame"""
+    filepath = Path(filepath)
+    if filepath.suffix == ".bin":
+        return load_binary_trajectory(filepath)
+    return pd.read_csv(filepath)
+
+
+def find_trajectory(directory, base_name):
+    """Path of base_name's trajectory in directory (.bin preferred), or None"""
+    for suffix in (".bin", ".csv"):
+        candidate = Path(directory) / f"{base_name}{suffix}"
+        if candidate.exists():
+            return candidate
+    return None
+
+
+def trajectory_files(directory, pattern="*trajectory"):
+    """All trajectory files matching pattern, one per mission (.bin preferred)"""
+    found = {}
+    for suffix in (".csv", ".bin"):
+        for path in sorted(Path(directory).glob(pattern + suffix)):
+            found[path.stem] = path  # .bin overrides .csv
+    return [found[stem] for stem in sorted(found)]